@@ -337,9 +337,9 @@
 #define bid32_to_uint8_xrnint __bid32_to_uint8_xrnint
 #define bid32_to_uint8_xrninta __bid32_to_uint8_xrninta
 
-#define bid64_add Real64_Add
-#define bid64_sub Real64_Sub
-#define bid64_mul Real64_Mul
+#define bid64_add __bid64_add
+#define bid64_sub __bid64_sub
+#define bid64_mul __bid64_mul
 #define bid64_div Real64_Div
 #define bid64dq_div __bid64dq_div
 #define bid64qd_div __bid64qd_div
@@ -590,14 +590,14 @@
 #define bid128_sameQuantum __bid128_sameQuantum
 #define bid128_totalOrder __bid128_totalOrder
 #define bid128_totalOrderMag __bid128_totalOrderMag
-#define bid64_quiet_equal Real64_Eq
-#define bid64_quiet_greater Real64_Gt
-#define bid64_quiet_greater_equal Real64_Ge
+#define bid64_quiet_equal __bid64_quiet_equal
+#define bid64_quiet_greater __bid64_quiet_greater
+#define bid64_quiet_greater_equal __bid64_quiet_greater_equal
 #define bid64_quiet_greater_unordered __bid64_quiet_greater_unordered
-#define bid64_quiet_less Real64_Lt
-#define bid64_quiet_less_equal Real64_Le
+#define bid64_quiet_less __bid64_quiet_less
+#define bid64_quiet_less_equal __bid64_quiet_less_equal
 #define bid64_quiet_less_unordered __bid64_quiet_less_unordered
-#define bid64_quiet_not_equal Real64_Ne
+#define bid64_quiet_not_equal __bid64_quiet_not_equal
 #define bid64_quiet_not_greater __bid64_quiet_not_greater
 #define bid64_quiet_not_less __bid64_quiet_not_less
 #define bid64_quiet_ordered Real64_IsOrderable
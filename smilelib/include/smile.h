@@ -57,5 +57,15 @@
 #ifndef __SMILE_ENV_ENV_H__
 #include <smile/env/env.h>
 #endif
+#ifndef __SMILE_ENV_GCSTATS_H__
+#include <smile/env/gcstats.h>
+#endif
+#ifndef __SMILE_ENV_HEAPCENSUS_H__
+#include <smile/env/heapcensus.h>
+#endif
+
+#ifndef __SMILE_ENV_WEAKREF_H__
+#include <smile/env/weakref.h>
+#endif
 
 #endif
@@ -0,0 +1,47 @@
+#ifndef __SMILE_BYTESEARCH_H__
+#define __SMILE_BYTESEARCH_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// A prepared byte-string search pattern.  Preparing a pattern computes its critical
+/// factorization once, so that the same pattern can then be searched for in many texts
+/// in worst-case linear time (the Crochemore-Perrin "two-way" algorithm).  Short scans
+/// are accelerated by a SIMD filter that looks for the pattern's first and last bytes.
+/// </summary>
+typedef struct ByteSearchStruct {
+	const Byte *pattern;	// The pattern itself (not copied; it must outlive the search).
+	Int length;				// The length of the pattern, in bytes.
+
+	Int critical;			// The critical position of the forward factorization.
+	Int period;				// The period of the pattern (or a shift bound, if not periodic).
+	Bool periodic;			// Whether the pattern is exactly periodic from the critical position.
+
+	Int reverseCritical;	// The same three values, for the reversed pattern.
+	Int reversePeriod;
+	Bool reversePeriodic;
+} *ByteSearch;
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_FUNC void ByteSearch_Init(ByteSearch search, const Byte *pattern, Int length);
+SMILE_API_FUNC Int ByteSearch_Find(const ByteSearch search, const Byte *text, Int textLength, Int start);
+SMILE_API_FUNC Int ByteSearch_FindLast(const ByteSearch search, const Byte *text, Int textLength, Int start);
+SMILE_API_FUNC Int ByteSearch_FindAsciiI(const ByteSearch search, const Byte *text, Int textLength, Int start);
+SMILE_API_FUNC Int ByteSearch_FindLastAsciiI(const ByteSearch search, const Byte *text, Int textLength, Int start);
+
+SMILE_API_FUNC Int ByteSearch_IndexOf(const Byte *text, Int textLength, const Byte *pattern, Int patternLength, Int start);
+SMILE_API_FUNC Int ByteSearch_LastIndexOf(const Byte *text, Int textLength, const Byte *pattern, Int patternLength, Int start);
+SMILE_API_FUNC Int ByteSearch_IndexOfByte(const Byte *text, Int textLength, Byte ch, Int start);
+SMILE_API_FUNC Int ByteSearch_LastIndexOfByte(const Byte *text, Int textLength, Byte ch, Int start);
+SMILE_API_FUNC Int ByteSearch_IndexOfAnyByte(const Byte *text, Int textLength, const Byte *chars, Int numChars, Int start);
+SMILE_API_FUNC Int ByteSearch_IndexOfNonAscii(const Byte *text, Int textLength, Int start);
+SMILE_API_FUNC Int ByteSearch_LastIndexOfNonAscii(const Byte *text, Int textLength, Int start);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef __SMILE_CODEPAGE_H__
+#define __SMILE_CODEPAGE_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// A description of a single-byte legacy code page, as the pair of tables that convert it to and
+/// from Unicode.
+///
+/// The bulk transcoders copy runs of ASCII straight through with a SIMD scan whenever the code
+/// page leaves ASCII alone (which all of the known code pages do), and only look up the bytes and
+/// code points around them in the tables.
+/// </summary>
+typedef struct CodePageStruct {
+	Int id;							// The LEGACY_CODE_PAGE_* ID of this code page, or 0 for a custom one.
+
+	const UInt16 *toUnicode;		// The code point for each of the 256 bytes.
+	const Byte **fromUnicode;		// 256-byte pages that give the byte for each code point ('?' for none).
+	Int numFromUnicodeTables;		// How many 256-byte pages there are in 'fromUnicode'.
+
+	Bool isAsciiCompatible;			// Whether bytes and code points 0-127 map to themselves.
+} *CodePage;
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_FUNC Bool CodePage_Get(CodePage codePage, Int legacyCodePageID);
+SMILE_API_FUNC Bool CodePage_GetByName(CodePage codePage, const String name);
+SMILE_API_FUNC void CodePage_Init(CodePage codePage, const UInt16 *toUnicode, const Byte **fromUnicode, Int numFromUnicodeTables);
+
+SMILE_API_FUNC Int CodePage_MeasureUtf8(const CodePage codePage, const Byte *src, Int length);
+SMILE_API_FUNC Int CodePage_DecodeToUtf8(const CodePage codePage, const Byte *src, Int length, Byte *dest);
+SMILE_API_FUNC Int CodePage_EncodeFromUtf8(const CodePage codePage, const Byte *src, Int length, Byte *dest, Bool isFinal, Int *consumed);
+
+#endif
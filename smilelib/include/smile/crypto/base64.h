@@ -14,7 +14,68 @@
 // still fit at least nominally within the crypto library, since there's not really
 // a "data encoding" namespace elsewhere.
 
-SMILE_API_FUNC String Base64Encode(const Byte *buffer, Int length, Bool wrapLines);
-SMILE_API_FUNC Byte *Base64Decode(String text, Int *length);
+// Flags for the base-64 encoder and decoder.
+#define BASE64_WRAP_LINES	(1 << 0)	// Break the encoded text into lines of BASE64_LINE_LENGTH characters.
+#define BASE64_URL_SAFE		(1 << 1)	// Use '-' and '_' instead of '+' and '/' (RFC 4648's "base64url").
+#define BASE64_NO_PADDING	(1 << 2)	// Leave off the '=' padding at the end of the encoded text.
+
+#define BASE64_LINE_LENGTH 72
+
+/// <summary>
+/// The state of a base-64 encoding or decoding that is fed its input a piece at a time.
+/// </summary>
+typedef struct {
+	Int32 flags;
+	Int32 numPending;		// How many entries of 'pending' are in use.
+	Byte pending[4];		// Bytes (when encoding) or sextets (when decoding) not yet in a whole group.
+	Int32 lineLength;		// When encoding, how many characters are on the current line.
+	Int32 numPadding;		// When decoding, how many '=' characters have been seen.
+	Bool failed;			// When decoding, whether the input has turned out to be invalid.
+} Base64Context;
+
+SMILE_API_FUNC void Base64_EncodeInit(Base64Context *context, Int flags);
+SMILE_API_FUNC Int Base64_EncodeUpdate(Base64Context *context, const Byte *buffer, Int length, Byte *dest);
+SMILE_API_FUNC Int Base64_EncodeFinish(Base64Context *context, Byte *dest);
+
+SMILE_API_FUNC void Base64_DecodeInit(Base64Context *context, Int flags);
+SMILE_API_FUNC Int Base64_DecodeUpdate(Base64Context *context, const Byte *text, Int length, Byte *dest);
+SMILE_API_FUNC Int Base64_DecodeFinish(Base64Context *context, Byte *dest);
+
+SMILE_API_FUNC String Base64Encode(const Byte *buffer, Int length, Int flags);
+SMILE_API_FUNC Byte *Base64Decode(const Byte *text, Int textLength, Int flags, Int *length);
+
+/// <summary>
+/// Calculate exactly how long the base-64 encoding of the given number of bytes is.
+/// </summary>
+Inline Int Base64_GetEncodedLength(Int length, Int flags)
+{
+	Int numChars = (flags & BASE64_NO_PADDING)
+		? length / 3 * 4 + (length % 3 ? length % 3 + 1 : 0)
+		: (length + 2) / 3 * 4;
+
+	if (flags & BASE64_WRAP_LINES)
+		numChars += (numChars + BASE64_LINE_LENGTH - 1) / BASE64_LINE_LENGTH;
+
+	return numChars;
+}
+
+/// <summary>
+/// Calculate the most bytes that Base64_EncodeUpdate() and Base64_EncodeFinish() can write
+/// together when given the given number of bytes, whatever was left over from earlier updates.
+/// </summary>
+Inline Int Base64_GetMaxEncodedLength(Int length)
+{
+	Int numChars = ((length + 2) / 3 + 1) * 4;
+	return numChars + numChars / BASE64_LINE_LENGTH + 2;
+}
+
+/// <summary>
+/// Calculate the most bytes that Base64_DecodeUpdate() and Base64_DecodeFinish() can write
+/// together when given the given number of characters, whatever was left over from earlier updates.
+/// </summary>
+Inline Int Base64_GetMaxDecodedLength(Int length)
+{
+	return (length + 3) / 4 * 3;
+}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef __SMILE_CRYPTO_HEX_H__
+#define __SMILE_CRYPTO_HEX_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+// Like base-64, hexadecimal isn't really cryptography, but it lives here for the same
+// reasons base-64 does (see base64.h).
+
+/// <summary>
+/// The state of a hexadecimal decoding that is fed its input a piece at a time.  (Encoding
+/// needs no state, since every byte encodes on its own:  Just call Hex_Encode() on each piece.)
+/// </summary>
+typedef struct {
+	Byte pending;			// The high nibble of a byte whose low nibble hasn't been seen yet.
+	Bool hasPending;		// Whether 'pending' is in use.
+	Bool failed;			// Whether the input has turned out to be invalid.
+} HexContext;
+
+SMILE_API_FUNC void Hex_Encode(const Byte *buffer, Int length, Byte *dest, Bool lowercase);
+
+SMILE_API_FUNC void Hex_DecodeInit(HexContext *context);
+SMILE_API_FUNC Int Hex_DecodeUpdate(HexContext *context, const Byte *text, Int length, Byte *dest);
+SMILE_API_FUNC Bool Hex_DecodeFinish(HexContext *context);
+
+SMILE_API_FUNC String HexEncode(const Byte *buffer, Int length, Bool lowercase);
+SMILE_API_FUNC Byte *HexDecode(const Byte *text, Int textLength, Int *length);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+
+#ifndef __SMILE_ENV_GCSTATS_H__
+#define __SMILE_ENV_GCSTATS_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// The number of distinct kinds that allocation counts are kept for (one per SMILE_KIND_* value).
+/// </summary>
+#define GCSTATS_NUM_KINDS 256
+
+/// <summary>
+/// A snapshot of the garbage collector's and the allocator's telemetry.  Counts and pause
+/// times are accumulated from the last call to GcStats_Reset() (or from when telemetry was
+/// first enabled); the heap figures are as of the moment the snapshot was taken.  Pause times
+/// cover only the collections run through GcStats_Collect(), which are the only ones whose end
+/// can be observed; collections that Boehm starts on its own are counted but not timed.
+/// </summary>
+typedef struct GcStatsStruct {
+	UInt64 allocationCounts[GCSTATS_NUM_KINDS];	// Number of objects allocated, by SMILE_KIND_*.
+	UInt64 allocationBytes[GCSTATS_NUM_KINDS];	// Number of bytes allocated, by SMILE_KIND_*.
+	UInt64 totalAllocationCount;	// Sum of all of the allocationCounts[].
+	UInt64 totalAllocationBytes;	// Sum of all of the allocationBytes[].
+
+	UInt64 numCollections;			// Number of collection cycles the GC has run.
+	UInt64 numTimedCollections;		// Number of those that were run (and timed) by GcStats_Collect().
+	UInt64 totalPauseTicks;			// Total time spent in timed collections, in ticks.
+	UInt64 maxPauseTicks;			// Longest single timed collection, in ticks.
+
+	UInt64 heapSize;				// Current size of the GC's heap, in bytes.
+	UInt64 freeBytes;				// Bytes in the heap that are known to be free.
+	UInt64 liveBytes;				// Estimate of live (reachable or not-yet-collected) bytes.
+	UInt64 bytesSinceGc;			// Bytes allocated since the last collection.
+} *GcStats;
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_DATA Bool GcStats_Enabled;
+
+SMILE_API_FUNC void GcStats_Enable(Bool enable);
+SMILE_API_FUNC void GcStats_Reset(void);
+SMILE_API_FUNC void GcStats_Get(GcStats stats);
+SMILE_API_FUNC void GcStats_Collect(void);
+SMILE_API_FUNC String GcStats_ToString(GcStats stats);
+
+SMILE_API_FUNC void GcStats_RecordAllocationInternal(Int kind, Int size);
+
+//-------------------------------------------------------------------------------------------------
+//  Inline parts of the implementation
+
+/// <summary>
+/// Record that an object of the given kind and size was just allocated.  When telemetry is
+/// turned off, this costs a single test of a global flag; and if SMILE_NO_GC_STATS is defined,
+/// the call is compiled out entirely.
+/// </summary>
+/// <param name="__kind__">The SMILE_KIND_* of the new object (any flag bits are ignored).</param>
+/// <param name="__size__">The size of the new object, in bytes.</param>
+#ifdef SMILE_NO_GC_STATS
+#	define GCSTATS_RECORD_ALLOCATION(__kind__, __size__) ((void)0)
+#else
+#	define GCSTATS_RECORD_ALLOCATION(__kind__, __size__) \
+		(GcStats_Enabled ? GcStats_RecordAllocationInternal((__kind__), (__size__)) : (void)0)
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+
+#ifndef __SMILE_ENV_HEAPCENSUS_H__
+#define __SMILE_ENV_HEAPCENSUS_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+#ifndef __SMILE_ENV_SYMBOLTABLE_H__
+#include <smile/env/symboltable.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// The default number of "top retainers" to include in a census report.
+/// </summary>
+#define HEAPCENSUS_DEFAULT_RETAINERS 20
+
+/// <summary>
+/// One group of objects in a heap census.  Objects are grouped by their kind, except for user
+/// objects, which are grouped by the name of their "class" (the nearest named object in their
+/// base chain, including themselves).
+/// </summary>
+typedef struct HeapCensusGroupStruct {
+	String name;				// The name of this group, like "List" or "Object:Point".
+	UInt64 count;				// The number of reachable objects in this group.
+	UInt64 shallowBytes;		// The sum of the sizes of the objects themselves.
+	UInt64 retainedBytes;		// The bytes that would be freed if every object in this group were freed.
+} *HeapCensusGroup;
+
+/// <summary>
+/// One of the "top retainers" in a heap census:  A single object that, by itself, keeps a
+/// large part of the heap alive.  Formally, this is an object that dominates many bytes in
+/// the reference graph; every path from the roots to those bytes goes through it.
+/// </summary>
+typedef struct HeapCensusRetainerStruct {
+	String name;				// The name of the retainer's group, or of the root it represents.
+	String path;				// A short description of how the retainer is reached from the roots.
+	UInt64 retainedCount;		// The number of objects this retainer keeps alive (including itself).
+	UInt64 retainedBytes;		// The bytes this retainer keeps alive (including itself).
+} *HeapCensusRetainer;
+
+/// <summary>
+/// The result of walking the heap:  Totals, the per-root and per-group breakdown (sorted by name, so that
+/// two censuses can be compared line by line), and the largest retainers (sorted by size).
+/// </summary>
+typedef struct HeapCensusStruct {
+	UInt64 totalCount;			// The number of reachable objects.
+	UInt64 totalBytes;			// The total size of all reachable objects.
+
+	Int numRoots;
+	struct HeapCensusRetainerStruct *roots;	// What each kind of root keeps alive by itself.
+
+	Int numGroups;
+	struct HeapCensusGroupStruct *groups;
+
+	Int numRetainers;
+	struct HeapCensusRetainerStruct *retainers;
+} *HeapCensus;
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_FUNC HeapCensus HeapCensus_Take(Int maxRetainers);
+SMILE_API_FUNC HeapCensusGroup HeapCensus_FindGroup(HeapCensus census, String name);
+SMILE_API_FUNC String HeapCensus_ToString(HeapCensus census);
+SMILE_API_FUNC Bool HeapCensus_WriteToFile(HeapCensus census, String filename);
+
+SMILE_API_FUNC Int HeapCensus_CollectSymbols(SymbolTable symbolTable);
+
+#endif
@@ -13,7 +13,7 @@ struct KnownBasesStruct {
 	SmileUserObject   Object;
 	SmileUserObject     Number;
 	SmileUserObject       IntegerBase;
-	SmileUserObject         Byte, Integer16, Integer32, Integer64, Integer128;
+	SmileUserObject         Byte, Integer16, Integer32, Integer64, Integer128, BigInt;
 	SmileUserObject       RealBase;
 	SmileUserObject         Real32, Real64, Real128;
 	SmileUserObject       FloatBase;
@@ -60,9 +60,13 @@ struct KnownBasesStruct {
 	SmileUserObject     Symbol;
 	SmileUserObject     Exception;
 	SmileUserObject     Timestamp;
+	SmileUserObject     Gc;
 	SmileUserObject     Handle;
 	SmileUserObject       Regex;
 	SmileUserObject       RegexMatch;
+	SmileUserObject       StringBuilder;
+	SmileUserObject       WeakRef;
+	SmileUserObject       WeakMap;
 };
 
 extern void KnownBases_Preload(struct KnownBasesStruct *knownBases);
@@ -171,9 +171,9 @@ typedef struct KnownSymbolsStruct {
 	//------------------------------------------
 
 	// Typename symbols.
-	Symbol Actor_, Array_, ArrayBase_, Bool_, BoolArray_, Char_, CharRange_, Closure, Enumerable_, Exception_, Facade_, FacadeProper_, Fn_, Handle_;
+	Symbol Actor_, Array_, ArrayBase_, Bool_, BoolArray_, Char_, CharRange_, Closure, Enumerable_, Exception_, Facade_, FacadeProper_, Fn_, FoldSearch_, Gc_, Handle_;
 	Symbol List_, Map_, MapBase_, MathException, Null_, Object_, Program_, Random_, Range_;
-	Symbol Regex_, RegexMatch_, String_, StringArray_, StringMap_, Symbol_, SymbolArray_, SymbolMap_, Timestamp_, Uni_, UniRange_, UserObject_;
+	Symbol Regex_, RegexMatch_, String_, StringArray_, StringBuilder_, StringMap_, Symbol_, SymbolArray_, SymbolMap_, Timestamp_, Uni_, UniRange_, UserObject_, WeakMap_, WeakRef_;
 
 	// Numeric typename symbols.
 	Symbol Number_, NumericArray_, NumericRange_, NumericMap_;
@@ -185,6 +185,7 @@ typedef struct KnownSymbolsStruct {
 	Symbol Integer32_, Integer32Array_, Integer32Range_, Integer32Map_;
 	Symbol Integer64_, Integer64Array_, Integer64Range_, Integer64Map_;
 	Symbol Integer128_, Integer128Array_, Integer128Range_, Integer128Map_;
+	Symbol BigInt_;
 
 	// Real typename symbols.
 	Symbol Real_, RealBase_, RealArrayBase_, RealRange_, RealRangeBase_, RealMap_, RealMapBase_;
@@ -216,12 +217,12 @@ typedef struct KnownSymbolsStruct {
 	Symbol d, day, days, day_of_year, decompose, default_, diacritic_q, digit_q, div, divide_by_zero, does_not_understand;
 	Symbol each, end, ends_with, ends_with_i, escape, eval, even_q, exit, exp, extend_object, extend_where_new;
 	Symbol facade, false_, filename, filename_mode, first, flags;
-	Symbol float32_, float32_range, float64_, float64_range, float128_;
+	Symbol float32_, float32_array, float32_range, float64_, float64_array, float64_range, float128_;
 	Symbol floor, fn, fold, from_seed;
 	Symbol get_object_security, get_property;
 	Symbol handle, handle_kind, has_property, hash, hex_string, hex_string_pretty, hour, hours, html_decode, html_encode, hyphenize;
 	Symbol id, in_, include, index_of, index_of_i, int_, int16_, int32_, int64_, int_lg;
-	Symbol integer16_, integer16_range, integer32_, integer32_range, integer64_, integer64_range, integer128_;
+	Symbol integer16_, integer16_range, integer32_, integer32_array, integer32_range, integer64_, integer64_array, integer64_range, integer128_;
 	Symbol join;
 	Symbol keys, kind;
 	Symbol last_index_of, last_index_of_i, latin1_to_utf8, leap_year_, left, length, letter, letter_q;
@@ -23,13 +23,36 @@
 /// <summary>
 /// The internal implementation of the Smile shared symbol table.
 /// </summary>
+/// <remarks>
+/// Most symbols are permanent, but symbols made from runtime data (like by String.to-symbol)
+/// are collectable:  A sweep (see HeapCensus_CollectSymbols()) marks every collectable symbol
+/// that can still be found in the heap, and then reclaims the rest, so that their names and IDs
+/// can be reused.  Any symbol that is requested through SymbolTable_GetSymbol() or
+/// SymbolTable_GetSymbolC() (which is how the parser, the compiler, and C code get their
+/// symbols) is pinned, and becomes permanent.
+/// </remarks>
 struct SymbolTableInt {
-	String *symbolNames;	// This is the set of known symbols, in registration order.
+	String *symbolNames;	// This is the set of known symbols, in registration order (NULL for reclaimed IDs).
 	Int count;	// The number of registered symbols.
 	Int max;	// The current maximum size of the symbol arrays.
 	StringIntDict symbolLookup;	// A lookup table for finding symbol IDs by their names, quickly.
+
+	Byte *symbolFlags;	// The SYMBOL_FLAG_* bits for each symbol, in atomic memory.
+	Int32 *freeSymbols;	// Reclaimed symbol IDs, ready to be reused, in atomic memory.
+	Int numFreeSymbols;	// The number of IDs in the freeSymbols array.
+	Int maxFreeSymbols;	// The current maximum size of the freeSymbols array.
+	Int numCollectable;	// The number of live collectable symbols.
+	Int sweepThreshold;	// How many collectable symbols there must be before a sweep is requested.
 };
 
+#define SYMBOL_FLAG_COLLECTABLE	(1 << 0)	// This symbol may be reclaimed if nothing refers to it.
+#define SYMBOL_FLAG_MARKED		(1 << 1)	// This symbol was found during the current sweep.
+
+/// <summary>
+/// The smallest number of collectable symbols that will trigger an automatic sweep.
+/// </summary>
+#define SYMBOLTABLE_MIN_SWEEP_THRESHOLD	16384
+
 //-------------------------------------------------------------------------------------------------
 //  Public type declarations
 
@@ -51,9 +74,51 @@ SMILE_API_FUNC Symbol SymbolTable_GetSymbolNoCreateC(SymbolTable symbolTable, co
 SMILE_API_FUNC String SymbolTable_GetName(SymbolTable symbolTable, Symbol symbol);
 SMILE_API_FUNC const char *SymbolTable_GetNameC(SymbolTable symbolTable, Symbol symbol);
 
+SMILE_API_FUNC Symbol SymbolTable_GetCollectableSymbol(SymbolTable symbolTable, String name);
+SMILE_API_FUNC void SymbolTable_Pin(SymbolTable symbolTable, Symbol symbol);
+SMILE_API_FUNC void SymbolTable_BeginSweep(SymbolTable symbolTable);
+SMILE_API_FUNC Int SymbolTable_EndSweep(SymbolTable symbolTable);
+
 //-------------------------------------------------------------------------------------------------
 //  Inline parts of the implementation.
 
+/// <summary>
+/// Determine whether the given symbol is collectable (i.e., whether it was made from runtime data,
+/// and has not been pinned since).
+/// </summary>
+/// <param name="symbolTable">The symbol table in which the symbol exists.</param>
+/// <param name="symbol">The symbol to test.</param>
+/// <returns>True if the symbol is collectable, False if it is permanent or is not a valid symbol.</returns>
+Inline Bool SymbolTable_IsCollectable(SymbolTable symbolTable, Symbol symbol)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+	return (Int)symbol > 0 && (Int)symbol < table->count && (table->symbolFlags[symbol] & SYMBOL_FLAG_COLLECTABLE);
+}
+
+/// <summary>
+/// During a sweep, record that the given symbol is still in use.  This may be called with
+/// any value at all (even garbage), since anything that isn't a collectable symbol is ignored.
+/// </summary>
+/// <param name="symbolTable">The symbol table being swept.</param>
+/// <param name="symbol">The symbol that is still in use.</param>
+Inline void SymbolTable_MarkSymbol(SymbolTable symbolTable, Symbol symbol)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+	if ((Int)symbol > 0 && (Int)symbol < table->count)
+		table->symbolFlags[symbol] |= SYMBOL_FLAG_MARKED;
+}
+
+/// <summary>
+/// Determine whether enough collectable symbols have piled up that a sweep would be worthwhile.
+/// </summary>
+/// <param name="symbolTable">The symbol table to test.</param>
+/// <returns>True if the symbol table should be swept.</returns>
+Inline Bool SymbolTable_NeedsSweep(SymbolTable symbolTable)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+	return table->numCollectable >= table->sweepThreshold;
+}
+
 /// <summary>
 /// Add a known-new symbol to a known-large-enough symbol table.  This is unsafe in the general
 /// case, but safe during the initialization of the symbol table initially.
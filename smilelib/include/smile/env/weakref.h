@@ -0,0 +1,108 @@
+
+#ifndef __SMILE_ENV_WEAKREF_H__
+#define __SMILE_ENV_WEAKREF_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+#ifndef __SMILE_SMILETYPES_PREDECL_H__
+#include <smile/smiletypes/predecl.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// A weak reference:  A reference to an object that does not keep that object alive.  When
+/// the collector frees the target, 'target' is cleared to NULL.  This structure lives in atomic
+/// (unscanned) memory, so that the collector can't see the pointer it holds.
+/// </summary>
+typedef struct WeakRefStruct {
+	SmileObject target;			// The referenced object, or NULL if it has been collected.
+} *WeakRef;
+
+/// <summary>
+/// A weak-keyed map:  An identity-keyed hash table whose keys are held weakly and whose values
+/// are held strongly.  When a key is collected, its entry silently disappears from the map.
+/// </summary>
+/// <remarks>
+/// This is not a true ephemeron table:  Boehm has no ephemerons, so a value that refers (directly
+/// or indirectly) back to its own key will keep that key alive, and the entry will never expire.
+/// </remarks>
+typedef struct WeakMapStruct {
+	Int count;					// The number of live entries (including any expired-but-unpurged ones).
+	Int numUsed;				// The number of slots that are in use or have been deleted.
+	Int mask;					// The number of slots, minus one (always a power of two, minus one).
+	PtrInt gcNo;				// The collection number when expired entries were last purged.
+	Byte *states;				// The state of each slot (WEAKMAP_SLOT_*), in atomic memory.
+	SmileObject *keys;			// The keys, in atomic memory, each registered as a disappearing link.
+	SmileObject *values;		// The values, in ordinary (scanned) memory.
+} *WeakMap;
+
+/// <summary>
+/// The states of each slot in a WeakMap.  A slot that is LIVE but whose key is NULL has expired:
+/// its key was collected, and it will be turned into a DELETED slot at the next purge.
+/// </summary>
+#define WEAKMAP_SLOT_EMPTY		0
+#define WEAKMAP_SLOT_LIVE		1
+#define WEAKMAP_SLOT_DELETED	2
+
+/// <summary>
+/// A request to invoke a script function after an object has been collected.  While the object
+/// is alive, 'obj' is NULL and the record hangs off of the object's GC finalizer; once the object
+/// is unreachable, the finalizer fills in 'obj' and moves the record to the pending queue, where
+/// it waits for OnCollect_Dequeue() to hand it back out at a safe point.  Every record is also
+/// on a list of all records that have not yet been dequeued, so that OnCollect_ForEach() can find
+/// the objects and functions that may yet be called upon.
+/// </summary>
+typedef struct OnCollectRecordStruct {
+	struct OnCollectRecordStruct *next;	// The next record for the same object, or in the pending queue.
+	struct OnCollectRecordStruct *prevLive, *nextLive;	// The neighbors of this record in the list of all records.
+	SmileFunction fn;			// The function to invoke.
+	SmileObject obj;			// The collected object (NULL until it has been collected).
+	PtrInt hiddenObj;			// The watched object, hidden from the collector.
+} *OnCollectRecord;
+
+/// <summary>
+/// A callback for OnCollect_ForEach():  This is given each not-yet-invoked callback function,
+/// and the object it watches.
+/// </summary>
+typedef void (*OnCollectForEachFunc)(SmileFunction fn, SmileObject obj, void *param);
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_DATA Int OnCollect_PendingCount;
+
+SMILE_API_FUNC Bool Weak_IsCollectable(SmileObject obj);
+
+SMILE_API_FUNC WeakRef WeakRef_Create(SmileObject target);
+
+SMILE_API_FUNC WeakMap WeakMap_Create(Int initialSize);
+SMILE_API_FUNC Bool WeakMap_TryGetValue(WeakMap weakMap, SmileObject key, SmileObject *value);
+SMILE_API_FUNC void WeakMap_Set(WeakMap weakMap, SmileObject key, SmileObject value);
+SMILE_API_FUNC Bool WeakMap_Remove(WeakMap weakMap, SmileObject key);
+SMILE_API_FUNC void WeakMap_Clear(WeakMap weakMap);
+SMILE_API_FUNC Int WeakMap_Count(WeakMap weakMap);
+
+SMILE_API_FUNC Bool OnCollect_Register(SmileObject obj, SmileFunction fn);
+SMILE_API_FUNC OnCollectRecord OnCollect_Dequeue(void);
+SMILE_API_FUNC Int OnCollect_NumPending(void);
+SMILE_API_FUNC void OnCollect_RunPending(void);
+SMILE_API_FUNC void OnCollect_ForEach(OnCollectForEachFunc func, void *param);
+
+//-------------------------------------------------------------------------------------------------
+//  Inline parts of the implementation
+
+/// <summary>
+/// Get the target of a weak reference.
+/// </summary>
+/// <param name="weakRef">The weak reference to read.</param>
+/// <returns>The referenced object, or NULL if it has been collected.</returns>
+Inline SmileObject WeakRef_Get(WeakRef weakRef)
+{
+	return weakRef->target;
+}
+
+#endif
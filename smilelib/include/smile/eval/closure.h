@@ -164,6 +164,7 @@ SMILE_API_FUNC String ClosureInfo_StringifyVariableNames(ClosureInfo closureInfo
 SMILE_API_FUNC Closure Closure_CreateGlobal(ClosureInfo info, Closure parent);
 SMILE_API_FUNC Closure Closure_CreateLocal(ClosureInfo info, Closure parent,
 	Closure returnClosure, ByteCodeSegment returnSegment, Int returnPc);
+SMILE_API_FUNC Closure Closure_CreateCaptured(ClosureInfo captureInfo, Closure closure, const Int32 *captureSources);
 SMILE_API_FUNC ClosureStateMachine Closure_CreateStateMachine(StateMachine stateMachineStart, StateMachine stateMachineBody,
 	Closure returnClosure, ByteCodeSegment returnSegment, Int returnPc);
 
@@ -79,6 +79,11 @@ typedef struct CompilerFunctionStruct {
 	struct TillContinuationInfoStruct **tillInfos;	// The till-continuation-info objects collected during the compile.
 	Int numTillInfos;						// The number of till-continuation-info objects collected.
 	Int maxTillInfos;						// The maximum number of till-continuation-info objects in the array.
+
+	struct CompiledLocalSymbolStruct **captures;	// The outer variables this function captures, in capture order.
+	Int32 *captureSources;					// Where each captured variable comes from (see Closure_CreateCaptured).
+	Int numCaptures;						// The number of captured variables.
+	Int maxCaptures;						// The maximum number of captured variables in the arrays.
 } *CompilerFunction;
 
 typedef struct CompileScopeStruct {
@@ -96,9 +101,25 @@ typedef struct CompiledLocalSymbolStruct {
 	Bool wasReadDeep;						// Whether this variable has been read from in a child function's closure.
 	Bool wasWritten;						// Whether this variable has been written to.
 	Bool wasWrittenDeep;					// Whether this variable has been written to in a child function's closure.
+	Bool inCell;							// Whether this variable is boxed in a Cell so that closures can share it.
 	CompileScope scope;						// The scope that contains this symbol.
+	SmileList inlineSetArgs;				// The [$set] that is this variable's only assignment, if it assigns a literal [$fn].
+	struct InlineFnInfoStruct *inlineFn;	// The small literal [$fn] this variable is known to hold (NULL if none).
 } *CompiledLocalSymbol;
 
+/// <summary>
+/// This describes a small, non-recursive literal [$fn] whose body may be compiled directly
+/// into its call sites (or into a loop) instead of being called through a closure.
+/// </summary>
+typedef struct InlineFnInfoStruct {
+	Symbol *params;							// The names of the function's parameters (all simple symbols).
+	Int numParams;							// The number of parameters.
+	SmileObject body;						// The function's body.
+	Symbol *symbols;						// Every symbol the body mentions (other than its parameters).
+	CompiledLocalSymbol *bindings;			// What each of those symbols resolved to where the function was declared.
+	Int numSymbols;							// The number of symbols (and bindings).
+} *InlineFnInfo;
+
 typedef struct TillContinuationInfoStruct {
 	Int tillIndex;							// The index of this till-info in the compiler's collection of till-info objects.
 	UserFunctionInfo userFunctionInfo;		// The user function this till object belongs to.
@@ -189,6 +210,8 @@ SMILE_API_FUNC CompiledLocalSymbol CompileScope_DefineSymbol(CompileScope scope,
 SMILE_API_FUNC CompiledLocalSymbol CompileScope_FindSymbol(CompileScope compileScope, Symbol symbol);
 SMILE_API_FUNC CompiledLocalSymbol CompileScope_FindSymbolHere(CompileScope compileScope, Symbol symbol);
 SMILE_API_FUNC ClosureInfo Compiler_SetupClosureInfoForCompilerFunction(Compiler compiler, CompilerFunction compilerFunction);
+SMILE_API_FUNC ClosureInfo Compiler_SetupCaptureInfoForCompilerFunction(Compiler compiler, CompilerFunction compilerFunction);
+SMILE_API_FUNC Int CompilerFunction_CaptureVariable(CompilerFunction compilerFunction, CompiledLocalSymbol localSymbol);
 SMILE_API_FUNC void Compiler_ResolveTillBranchTargets(TillContinuationInfo *tillInfos, Int numTillInfos);
 
 //-------------------------------------------------------------------------------------------------
@@ -45,6 +45,15 @@ extern CompiledBlock Compiler_CompileIndex(Compiler compiler, SmileList args, Co
 extern CompiledBlock Compiler_CompileAnd(Compiler compiler, SmileList args, CompileFlags compileFlags);
 extern CompiledBlock Compiler_CompileOr(Compiler compiler, SmileList args, CompileFlags compileFlags);
 
+extern void Compiler_FindInlinableAssignments(Compiler compiler, CompileScope scope, SmileList body);
+extern void Compiler_NoteInlinableAssignment(Compiler compiler, SmileList setArgs, Symbol symbol, SmileObject value);
+extern CompiledBlock Compiler_TryCompileInlineCall(Compiler compiler, SmileList list, CompileFlags compileFlags);
+extern CompiledBlock Compiler_TryCompileInlineLoop(Compiler compiler, SmileList dotArgs, SmileList args, CompileFlags compileFlags);
+extern Int Compiler_CountAssignments(SmileObject expr, Symbol symbol);
+
+extern void Compiler_FindCellVariables(Compiler compiler, CompileScope scope, SmileList args);
+extern void Compiler_FindCellArguments(Compiler compiler, CompileScope scope, SmileObject body);
+
 extern Bool Compiler_ValidateDotArgs(Compiler compiler, SmileList dotArgs);
 extern Bool Compiler_ValidateIndexArgs(Compiler compiler, SmileList indexArgs);
 
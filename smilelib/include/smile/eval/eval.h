@@ -50,6 +50,7 @@ struct EvalStateStruct {
 	ByteCodeSegment segment;
 	ByteCode byteCode;
 	EscapeContinuation exceptionContinuation;
+	struct EvalStateStruct *outer;	// The evaluation that was suspended before this one, if any.
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -60,6 +61,7 @@ SMILE_API_FUNC EvalResult EvalResult_Create(Int kind);
 SMILE_API_FUNC EvalResult Eval_Run(UserFunctionInfo function);
 SMILE_API_FUNC EvalResult Eval_Continue(void);
 SMILE_API_FUNC ClosureStateMachine Eval_BeginStateMachine(StateMachine stateMachineStart, StateMachine stateMachineBody);
+SMILE_API_FUNC ClosureStateMachine Eval_BeginDetachedStateMachine(StateMachine stateMachineStart, StateMachine stateMachineBody);
 
 SMILE_API_FUNC void Eval_GetCurrentBreakpointInfo(Closure *closure, CompiledTables *compiledTables, ByteCodeSegment *segment, ByteCode *byteCode);
 
@@ -74,6 +76,7 @@ Inline EscapeContinuation EscapeContinuation_Create(Int escapeKind)
 
 SMILE_API_FUNC void Eval_BeforeRecurse(struct EvalStateStruct *evalState);
 SMILE_API_FUNC void Eval_AfterRecurse(struct EvalStateStruct *evalState);
+SMILE_API_FUNC struct EvalStateStruct *Eval_GetSuspendedState(void);
 
 #endif
 
@@ -70,19 +70,19 @@ enum Opcode {
 	Op_LdLoc	= 0x30,		// +1 | int32, int32	; Load the indexed local variable in the given relative-indexed scope onto the work stack.
 	Op_StLoc	= 0x31,		//  0 | int32, int32	; Store the value of the stack top into the indexed local variable in the given relative-indexed scope.
 	Op_StpLoc	= 0x32,		// -1 | int32, int32	; Store and pop the value of the stack top into the indexed local variable in the given relative-indexed scope.
-	Op_33		= 0x33,
+	Op_LdCell	= 0x33,		// -1, +1				; Replace the Cell on the stack top with the value it holds.
 	Op_LdArg	= 0x34,		// +1 | int32, int32	; Load the value of the given function's argument onto the work stack.  (function index, arg index)
 	Op_StArg	= 0x35,		//  0 | int32, int32	; Store the value of the stack top into the given function's argument.  (function index, arg index)
 	Op_StpArg	= 0x36,		// -1 | int32, int32	; Store and pop the value of the stack top into the given function's argument.  (function index, arg index)
-	Op_37		= 0x37,
+	Op_StCell	= 0x37,		// -1					; Store the value (top-2) into the Cell on the stack top (top-1), and pop the Cell.
 	Op_LdX		= 0x38,		// +1 | int32			; Load the value of the given named variable (global) onto the work stack.
 	Op_StX		= 0x39,		//  0 | int32			; Store the value of the stack top into the given named variable (global).
 	Op_StpX		= 0x3A,		// -1 | int32			; Store and pop the value of the stack top into the given named variable (global).
-	Op_3B		= 0x3B,
+	Op_StpCell	= 0x3B,		// -2					; Store the value (top-2) into the Cell on the stack top (top-1), and pop both.
 	Op_NullLoc0 = 0x3C,		//  0 | int32			; Store a null in the given local variable in scope 0
 	Op_NullArg0 = 0x3D,		//  0 | int32			; Store a null in the given argument in scope 0
 	Op_NullX	= 0x3E,		//  0 | int32			; Store a null in the given global named variable (global).
-	Op_3F		= 0x3F,
+	Op_NullCell0 = 0x3F,	//  0 | int32			; Store a null in the Cell in the given local variable in scope 0 (creating the Cell if needed)
 
 	Op_LdArg0	= 0x40,		// +1 | int32			; Load the current function's argument (by index) onto the work stack.
 	Op_LdArg1	= 0x41,		// +1 | int32			; Load the parent function's argument (by index) onto the work stack.
@@ -140,9 +140,9 @@ enum Opcode {
 	Op_StpProp	= 0x72,		// -2 | int32			; Store and pop the stack top into the given property of the given object.
 	Op_73		= 0x73,		
 	Op_LdMember	= 0x74,		// -2, +1				; Call 'get-member', passing member (top-1) and object (top-2).
-	Op_StMember	= 0x75,		// -3, +1				; Call 'set-member', passing value (top-1), member (top-2), and object (top-3).  Results in the stack top value.
+	Op_StMember	= 0x75,		// -3, +2				; Call 'set-member', passing value (top-1), member (top-2), and object (top-3).  Leaves the value, and the call's result above it.
 							// ; Warning: Op_StMember MUST ALWAYS be preceded by an otherwise-unnecessary Op_LdNull instruction!
-	Op_StpMember = 0x76,	// -3					; Call 'set-member', passing value (top-1), member (top-2), and object (top-3).  Pops the stack top value.
+	Op_StpMember = 0x76,	// -3, +1				; Call 'set-member', passing value (top-1), member (top-2), and object (top-3).  Leaves only the call's result.
 	Op_77		= 0x77,		
 	Op_78		= 0x78,		
 	Op_79		= 0x79,		
@@ -156,11 +156,11 @@ enum Opcode {
 	Op_Cons		= 0x80,		// -2, +1				; Create a new List object from the given a/d values on the work stack.
 	Op_Car		= 0x81,		// -1, +1				; Retrieve the 'a' property from the List on the stack top (UNDEFINED if not a List or Null).
 	Op_Cdr		= 0x82,		// -1, +1				; Retrieve the 'd' property from the List on the stack top (UNDEFINED if not a List or Null).
-	Op_83		= 0x83,		
-	Op_84		= 0x84,
-	Op_85		= 0x85,
-	Op_86		= 0x86,
-	Op_87		= 0x87,		
+	Op_ChkMet	= 0x83,		// -2, +1 | int32, int32	; Push true if the object (top-2) is of kind 'a' and its method 'b' is still the function on the stack top (top-1).
+	Op_ForInit	= 0x84,		// -1 | int32			; Pop an Integer64Range, and initialize the loop locals 'n'...'n+2' (current, end, step) from it.
+	Op_ForNext	= 0x85,		//  0 | label, int32	; If the loop in locals 'n'...'n+2' is done, branch to label; else copy current to local 'n+3' and step it.
+	Op_ListNext	= 0x86,		//  0 | label, int32	; If the List in local 'n' is exhausted, branch to label; else copy its 'a' to local 'n+1' and advance it.
+	Op_NewCell	= 0x87,		// -1, +1				; Replace the value on the stack top with a new Cell that holds it.
 	Op_NewFn	= 0x88,		// +1 | int32			; Push a new function instance that comes from the given compiled function (by function table index).
 	Op_NewObj	= 0x89,		// -(n*2+1), +1 | int32	; Create a new object from the 'n' property decls and base object on the work stack.
 	Op_8A		= 0x8A,		
@@ -0,0 +1,50 @@
+#ifndef __SMILE_FOLDSEARCH_H__
+#define __SMILE_FOLDSEARCH_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+#ifndef __SMILE_BYTESEARCH_H__
+#include <smile/bytesearch.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// A prepared case-insensitive search pattern.  Preparing a pattern case-folds it once, so that
+/// it can then be searched for in many texts without folding it again at every position.
+///
+/// A match is any run of exactly as many bytes as the original pattern whose case-folded form
+/// equals the pattern's case-folded form (the same rule String_CompareRangeI() applies).  Where
+/// both the pattern and the text are ASCII, the search runs a SIMD case-insensitive byte search;
+/// wherever the text isn't ASCII, it falls back to comparing full Unicode case folds.
+/// </summary>
+typedef struct FoldSearchStruct {
+	String pattern;				// The original pattern.
+	String folded;				// The pattern, fully case-folded.
+	Int length;					// The pattern's length in bytes, which is also the length of every match.
+
+	const Int32 *codePoints;	// The code points of the case-folded pattern.
+	Int numCodePoints;			// How many code points there are in the case-folded pattern.
+
+	Bool isAscii;				// Whether the pattern is entirely ASCII (and its folded form is just lowercase).
+	struct ByteSearchStruct asciiSearch;	// For ASCII patterns, a prepared search for the folded bytes.
+} *FoldSearch;
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_FUNC FoldSearch FoldSearch_Create(const String pattern);
+SMILE_API_FUNC Bool FoldSearch_MatchesAt(const FoldSearch search, const String str, Int index);
+SMILE_API_FUNC Int FoldSearch_Find(const FoldSearch search, const String str, Int start);
+SMILE_API_FUNC Int FoldSearch_FindLast(const FoldSearch search, const String str, Int start);
+SMILE_API_FUNC Int FoldSearch_CountOf(const FoldSearch search, const String str, Int start);
+SMILE_API_FUNC String FoldSearch_Replace(const FoldSearch search, const String str, const String replacement, Int limit);
+
+#endif
@@ -40,6 +40,10 @@ SMILE_INTERNAL_DATA extern const Int UnicodeTables_CanonicalCombiningClassByteCo
 
 SMILE_INTERNAL_FUNC extern Int32 Unicode_Compose(Int32 a, Int32 b, Int32 c, Int32 d);
 
+// Nonzero for each code point that Unicode_Compose() may merge into the code point before it.
+SMILE_INTERNAL_DATA extern const Byte *UnicodeTables_ComposeQuickCheckTable[];
+SMILE_INTERNAL_DATA extern const Int UnicodeTables_ComposeQuickCheckTableCount;
+
 //---------------------------------------------------------------------------
 // Legacy IBM code pages.
 
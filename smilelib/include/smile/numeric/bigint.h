@@ -0,0 +1,104 @@
+#ifndef __SMILE_NUMERIC_BIGINT_H__
+#define __SMILE_NUMERIC_BIGINT_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Type declarations.
+
+/// <summary>
+/// An arbitrary-precision integer, in sign-magnitude form.  The magnitude is an array of 32-bit
+/// limbs, least-significant limb first, and never has leading zero limbs, so zero is always a
+/// sign of 0 and a length of 0.  BigInts are immutable once they have been created.
+/// </summary>
+typedef struct BigIntStruct {
+	Int32 sign;			// -1 for negative values, +1 for positive values, or 0 for zero.
+	Int32 length;		// The number of limbs in the magnitude.
+	UInt32 limbs[1];	// The magnitude (actually 'length' limbs long, not just one).
+} *BigInt;
+
+//-------------------------------------------------------------------------------------------------
+// Tuning thresholds, in limbs.
+//
+// Multiplication uses schoolbook below the Karatsuba threshold, Karatsuba up to the Toom-3
+// threshold, and Toom-3 above that.  Division uses Knuth's Algorithm D unless the divisor is at
+// least as long as the Burnikel-Ziegler threshold, and the quotient will be at least as long as
+// the Burnikel-Ziegler offset.  Radix conversion splits recursively above its threshold.
+
+#define BIGINT_KARATSUBA_THRESHOLD		48
+#define BIGINT_TOOM3_THRESHOLD			160
+#define BIGINT_BURNIKEL_ZIEGLER_THRESHOLD	64
+#define BIGINT_BURNIKEL_ZIEGLER_OFFSET	32
+#define BIGINT_RADIX_CONVERSION_THRESHOLD	24
+
+//-------------------------------------------------------------------------------------------------
+// Predefined constants.
+
+SMILE_API_DATA BigInt BigInt_Zero;
+SMILE_API_DATA BigInt BigInt_One;
+
+//-------------------------------------------------------------------------------------------------
+// External functions.
+
+SMILE_API_FUNC BigInt BigInt_FromInt64(Int64 value);
+SMILE_API_FUNC BigInt BigInt_FromUInt64(UInt64 value);
+SMILE_API_FUNC Bool BigInt_FromFloat64(Float64 value, BigInt *result);
+SMILE_API_FUNC Bool BigInt_FromReal64(Real64 value, BigInt *result);
+
+SMILE_API_FUNC Bool BigInt_FitsInInt64(BigInt x);
+SMILE_API_FUNC Int64 BigInt_ToInt64(BigInt x);
+SMILE_API_FUNC Float64 BigInt_ToFloat64(BigInt x);
+SMILE_API_FUNC Real64 BigInt_ToReal64(BigInt x);
+
+SMILE_API_FUNC Bool BigInt_TryParse(const Byte *text, Int length, Int radix, BigInt *result);
+SMILE_API_FUNC String BigInt_ToString(BigInt x, Int radix);
+
+SMILE_API_FUNC Int BigInt_Compare(BigInt a, BigInt b);
+SMILE_API_FUNC UInt32 BigInt_Hash(BigInt x);
+SMILE_API_FUNC Int64 BigInt_BitLength(BigInt x);
+
+SMILE_API_FUNC BigInt BigInt_Add(BigInt a, BigInt b);
+SMILE_API_FUNC BigInt BigInt_Sub(BigInt a, BigInt b);
+SMILE_API_FUNC BigInt BigInt_Mul(BigInt a, BigInt b);
+SMILE_API_FUNC Bool BigInt_DivRem(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder);
+SMILE_API_FUNC Bool BigInt_DivMod(BigInt a, BigInt b, BigInt *quotient, BigInt *modulus);
+SMILE_API_FUNC BigInt BigInt_Neg(BigInt x);
+SMILE_API_FUNC BigInt BigInt_Abs(BigInt x);
+
+SMILE_API_FUNC BigInt BigInt_ShiftLeft(BigInt x, Int64 count);
+SMILE_API_FUNC BigInt BigInt_ShiftRight(BigInt x, Int64 count);
+
+SMILE_API_FUNC BigInt BigInt_Pow(BigInt x, UInt64 exponent);
+SMILE_API_FUNC Bool BigInt_ModPow(BigInt x, BigInt exponent, BigInt modulus, BigInt *result);
+SMILE_API_FUNC BigInt BigInt_Gcd(BigInt a, BigInt b);
+SMILE_API_FUNC Bool BigInt_Sqrt(BigInt x, BigInt *result);
+
+//-------------------------------------------------------------------------------------------------
+// Inline functions.
+
+Inline Bool BigInt_IsZero(BigInt x)
+{
+	return x->sign == 0;
+}
+
+Inline Bool BigInt_IsNeg(BigInt x)
+{
+	return x->sign < 0;
+}
+
+Inline Bool BigInt_IsOdd(BigInt x)
+{
+	return x->length > 0 && (x->limbs[0] & 1);
+}
+
+Inline Bool BigInt_Eq(BigInt a, BigInt b)
+{
+	return BigInt_Compare(a, b) == 0;
+}
+
+#endif
@@ -20,9 +20,19 @@
 #define FLOAT_KIND_POS_SNAN		4
 #define FLOAT_KIND_NEG_SNAN		(0x80 | FLOAT_KIND_POS_SNAN)
 
+#define FLOAT64_MAX_SHORTEST_DIGITS	17
+#define FLOAT32_MAX_SHORTEST_DIGITS	9
+
+SMILE_API_FUNC Int Float64_ToShortestDigits(Float64 float64, Byte *digits, Int *decimalPoint);
 SMILE_API_FUNC String Float64_ToFixedString(Float64 float64, Int minIntDigits, Int maxFracDigits, Bool forceSign);
-SMILE_API_FUNC String Float64_ToExpString(Float64 float64, Int minFracDigits, Bool forceSign);
+SMILE_API_FUNC String Float64_ToExpString(Float64 float64, Int maxFracDigits, Bool forceSign);
 SMILE_API_FUNC String Float64_ToStringEx(Float64 float64, Int minIntDigits, Int maxFracDigits, Bool forceSign);
+
+SMILE_API_FUNC Int Float32_ToShortestDigits(Float32 float32, Byte *digits, Int *decimalPoint);
+SMILE_API_FUNC String Float32_ToFixedString(Float32 float32, Int minIntDigits, Int maxFracDigits, Bool forceSign);
+SMILE_API_FUNC String Float32_ToExpString(Float32 float32, Int maxFracDigits, Bool forceSign);
+SMILE_API_FUNC String Float32_ToStringEx(Float32 float32, Int minIntDigits, Int maxFracDigits, Bool forceSign);
+
 SMILE_API_FUNC Int Float64_GetKind(Float64 float64);
 SMILE_API_FUNC Int Float32_GetKind(Float32 float32);
 
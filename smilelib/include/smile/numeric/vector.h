@@ -0,0 +1,66 @@
+#ifndef __SMILE_NUMERIC_VECTOR_H__
+#define __SMILE_NUMERIC_VECTOR_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Instruction sets.
+//
+//  The vector kernels below are plain C loops, written so that the compiler can vectorize them.
+//  Where the compiler supports it, each kernel is compiled twice, once for the baseline CPU and
+//  once for AVX2, and the faster one is picked at runtime.  The results are bit-identical either
+//  way:  Integer arithmetic wraps, and reductions always use the same eight-lane order.
+
+#define VECTOR_ISA_PORTABLE	0
+#define VECTOR_ISA_AVX2	1
+
+#if (SMILE_COMPILER == SMILE_COMPILER_GCC || SMILE_COMPILER == SMILE_COMPILER_CLANG) && SMILE_CPU == SMILE_CPU_X64
+	#define VECTOR_HAS_AVX2 1
+#else
+	#define VECTOR_HAS_AVX2 0
+#endif
+
+SMILE_API_FUNC Int Vector_GetIsa(void);
+SMILE_API_FUNC Bool Vector_SetIsa(Int isa);
+
+//-------------------------------------------------------------------------------------------------
+//  Comparison operators, for the CompareScalar kernels.
+
+#define VECTOR_CMP_EQ	0
+#define VECTOR_CMP_NE	1
+#define VECTOR_CMP_LT	2
+#define VECTOR_CMP_LE	3
+#define VECTOR_CMP_GT	4
+#define VECTOR_CMP_GE	5
+
+//-------------------------------------------------------------------------------------------------
+//  Kernels.
+//
+//  'dest' may be the same as 'a' or 'b', but must not otherwise overlap them.  Min() and Max()
+//  require count > 0, and skip NaNs; Gather() does not check its indices.
+
+#define DECLARE_VECTOR_KERNELS(__type__, __acc__) \
+	SMILE_API_FUNC void __type__##Vector_Add(__type__ *dest, const __type__ *a, const __type__ *b, Int count); \
+	SMILE_API_FUNC void __type__##Vector_Sub(__type__ *dest, const __type__ *a, const __type__ *b, Int count); \
+	SMILE_API_FUNC void __type__##Vector_Mul(__type__ *dest, const __type__ *a, const __type__ *b, Int count); \
+	SMILE_API_FUNC void __type__##Vector_AddScalar(__type__ *dest, const __type__ *a, __type__ scalar, Int count); \
+	SMILE_API_FUNC void __type__##Vector_SubScalar(__type__ *dest, const __type__ *a, __type__ scalar, Int count); \
+	SMILE_API_FUNC void __type__##Vector_MulScalar(__type__ *dest, const __type__ *a, __type__ scalar, Int count); \
+	SMILE_API_FUNC __acc__ __type__##Vector_Sum(const __type__ *a, Int count); \
+	SMILE_API_FUNC __acc__ __type__##Vector_Dot(const __type__ *a, const __type__ *b, Int count); \
+	SMILE_API_FUNC __type__ __type__##Vector_Min(const __type__ *a, Int count); \
+	SMILE_API_FUNC __type__ __type__##Vector_Max(const __type__ *a, Int count); \
+	SMILE_API_FUNC void __type__##Vector_CompareScalar(Byte *mask, const __type__ *a, __type__ scalar, Int count, Int op); \
+	SMILE_API_FUNC void __type__##Vector_Gather(__type__ *dest, const __type__ *a, const Int64 *indices, Int count)
+
+DECLARE_VECTOR_KERNELS(Byte, Int64);
+DECLARE_VECTOR_KERNELS(Int32, Int64);
+DECLARE_VECTOR_KERNELS(Int64, Int64);
+DECLARE_VECTOR_KERNELS(Float32, Float64);
+DECLARE_VECTOR_KERNELS(Float64, Float64);
+
+#undef DECLARE_VECTOR_KERNELS
+
+#endif
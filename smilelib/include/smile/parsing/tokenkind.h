@@ -27,6 +27,7 @@ enum TokenKind {
 	TOKEN_INTEGER32,
 	TOKEN_INTEGER64,
 	TOKEN_INTEGER128,
+	TOKEN_BIGINT,
 	TOKEN_REAL32,
 	TOKEN_REAL64,
 	TOKEN_REAL128,
@@ -53,6 +53,7 @@ typedef enum {
 	SMILE_KIND_STRING				= 0x25,
 		
 	// Opaque handles.	
+	SMILE_KIND_CELL					= 0x29,
 	SMILE_KIND_TILL_CONTINUATION	= 0x2A,
 	SMILE_KIND_HANDLE				= 0x2B,
 	SMILE_KIND_CLOSURE				= 0x2C,
@@ -83,6 +84,10 @@ typedef enum {
 
 	// Raw buffer types.
 	SMILE_KIND_BYTEARRAY			= 0x50,
+	SMILE_KIND_INTEGER32ARRAY		= 0x52,
+	SMILE_KIND_INTEGER64ARRAY		= 0x53,
+	SMILE_KIND_FLOAT32ARRAY			= 0x56,
+	SMILE_KIND_FLOAT64ARRAY			= 0x57,
 		
 	// Types used for parsing.	
 	SMILE_KIND_SYNTAX				= 0xF0,
@@ -108,6 +113,11 @@ typedef enum {
 	// Miscellaneous flags.	
 		
 	SMILE_FLAG_EXTERNAL_FUNCTION	= (1 << 12),
+	SMILE_FLAG_STRING_SLICE			= (1 << 13),
+	SMILE_FLAG_STRING_UNSCANNED		= (1 << 14),	// A heap string whose text hasn't been scanned yet.
+	SMILE_FLAG_STRING_SCANNED		= (1 << 15),	// A string whose text has been scanned, with the results below.
+	SMILE_FLAG_STRING_ASCII			= (1 << 16),	// The string's text is entirely 7-bit ASCII.
+	SMILE_FLAG_STRING_UTF8			= (1 << 17),	// The string's text is valid UTF-8.
 
 } SmileKind;
 
@@ -0,0 +1,39 @@
+#ifndef __SMILE_SMILETYPES_NUMERIC_SMILEBIGINT_H__
+#define __SMILE_SMILETYPES_NUMERIC_SMILEBIGINT_H__
+
+#ifndef __SMILE_SMILETYPES_PREDECL_H__
+#include <smile/smiletypes/predecl.h>
+#endif
+
+#ifndef __SMILE_SMILETYPES_SMILEOBJECT_H__
+#include <smile/smiletypes/smileobject.h>
+#endif
+
+#ifndef __SMILE_NUMERIC_BIGINT_H__
+#include <smile/numeric/bigint.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Type declarations
+
+struct SmileBigIntInt {
+	DECLARE_BASE_OBJECT_PROPERTIES;
+	BigInt value;
+};
+
+//-------------------------------------------------------------------------------------------------
+//  Public interface
+
+SMILE_API_DATA SmileVTable SmileBigInt_VTable;
+
+SMILE_API_FUNC SmileBigInt SmileBigInt_Create(BigInt value);
+
+//-------------------------------------------------------------------------------------------------
+//  Inline operations
+
+Inline SmileBigInt SmileBigInt_FromInt64(Int64 value)
+{
+	return SmileBigInt_Create(BigInt_FromInt64(value));
+}
+
+#endif
@@ -24,6 +24,7 @@ typedef struct SmileByteInt *SmileByte;
 typedef struct SmileInteger16Int *SmileInteger16;
 typedef struct SmileInteger32Int *SmileInteger32;
 typedef struct SmileInteger64Int *SmileInteger64;
+typedef struct SmileBigIntInt *SmileBigInt;
 typedef struct SmileTimestampInt *SmileTimestamp;
 
 typedef struct SmileUnboxedByteInt *SmileUnboxedByte;
@@ -66,6 +67,10 @@ typedef struct SmileNonterminalInt *SmileNonterminal;
 typedef struct SmileLoanwordInt *SmileLoanword;
 
 typedef struct SmileByteArrayInt *SmileByteArray;
+typedef struct SmileInteger32ArrayInt *SmileInteger32Array;
+typedef struct SmileInteger64ArrayInt *SmileInteger64Array;
+typedef struct SmileFloat32ArrayInt *SmileFloat32Array;
+typedef struct SmileFloat64ArrayInt *SmileFloat64Array;
 
 typedef struct EvalResultStruct *EvalResult;
 typedef struct ClosureInfoStruct *ClosureInfo;
@@ -79,6 +84,7 @@ typedef struct ParseMessageStruct *ParseMessage;
 typedef struct ParseDeclStruct *ParseDecl;
 
 typedef struct SmileTillContinuationInt *SmileTillContinuation;
+typedef struct SmileCellInt *SmileCell;
 
 typedef struct ModuleInfoStruct *ModuleInfo;
 
@@ -0,0 +1,32 @@
+#ifndef __SMILE_SMILETYPES_RAW_SMILEFLOAT64ARRAY_H__
+#define __SMILE_SMILETYPES_RAW_SMILEFLOAT64ARRAY_H__
+
+#ifndef __SMILE_SMILETYPES_PREDECL_H__
+#include <smile/smiletypes/predecl.h>
+#endif
+
+#ifndef __SMILE_SMILETYPES_SMILEOBJECT_H__
+#include <smile/smiletypes/smileobject.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Type declarations
+
+struct SmileFloat64ArrayInt {
+	DECLARE_BASE_OBJECT_PROPERTIES;
+	SmileObject securityKey;
+	Int length;
+	Float64 *data;
+	SmileByteArray byteArray;	// The ByteArray this is a view of, or NULL if the array owns its data.
+};
+
+//-------------------------------------------------------------------------------------------------
+//  Public interface
+
+SMILE_API_DATA SmileVTable SmileFloat64Array_VTable;
+
+SMILE_API_FUNC SmileFloat64Array SmileFloat64Array_Create(Int length, Bool writable);
+SMILE_API_FUNC SmileFloat64Array SmileFloat64Array_CreateView(SmileByteArray byteArray, Int offset, Int length);
+SMILE_API_FUNC SmileByteArray SmileFloat64Array_ToByteArray(SmileFloat64Array array);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef __SMILE_SMILETYPES_RAW_SMILEINTEGER64ARRAY_H__
+#define __SMILE_SMILETYPES_RAW_SMILEINTEGER64ARRAY_H__
+
+#ifndef __SMILE_SMILETYPES_PREDECL_H__
+#include <smile/smiletypes/predecl.h>
+#endif
+
+#ifndef __SMILE_SMILETYPES_SMILEOBJECT_H__
+#include <smile/smiletypes/smileobject.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Type declarations
+
+struct SmileInteger64ArrayInt {
+	DECLARE_BASE_OBJECT_PROPERTIES;
+	SmileObject securityKey;
+	Int length;
+	Int64 *data;
+	SmileByteArray byteArray;	// The ByteArray this is a view of, or NULL if the array owns its data.
+};
+
+//-------------------------------------------------------------------------------------------------
+//  Public interface
+
+SMILE_API_DATA SmileVTable SmileInteger64Array_VTable;
+
+SMILE_API_FUNC SmileInteger64Array SmileInteger64Array_Create(Int length, Bool writable);
+SMILE_API_FUNC SmileInteger64Array SmileInteger64Array_CreateView(SmileByteArray byteArray, Int offset, Int length);
+SMILE_API_FUNC SmileByteArray SmileInteger64Array_ToByteArray(SmileInteger64Array array);
+
+#endif
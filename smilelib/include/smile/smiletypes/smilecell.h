@@ -0,0 +1,95 @@
+
+#ifndef __SMILE_SMILETYPES_CELL_H__
+#define __SMILE_SMILETYPES_CELL_H__
+
+#ifndef __SMILE_SMILETYPES_PREDECL_H__
+#include <smile/smiletypes/predecl.h>
+#endif
+
+#ifndef __SMILE_SMILETYPES_SMILEOBJECT_H__
+#include <smile/smiletypes/smileobject.h>
+#endif
+
+#ifdef SMILE_PACKED_ARGS
+#ifndef __SMILE_SMILETYPES_SMILEPACKEDARG_H__
+#include <smile/smiletypes/smilepackedarg.h>
+#endif
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Type declarations
+
+/// <summary>
+/// A Cell holds the value of a single local variable that is both captured by a nested function
+/// and assigned after it has been captured.  Functions capture their variables by copying them
+/// when they are instantiated, so a variable like that instead lives in a Cell, and the declaring
+/// function and every function that captures it share that same Cell.  Cells are never visible to
+/// user code:  The compiler always emits LdCell/StCell to reach through them.
+///
+/// When built with SMILE_PACKED_ARGS, the value is stored as an 8-byte SmilePackedArg instead of
+/// a 16-byte SmileArg, which shrinks each Cell from a 48-byte GC block to a 32-byte one.  Always
+/// use SmileCell_GetValue() and SmileCell_SetValue() to reach the value.
+/// </summary>
+struct SmileCellInt {
+	DECLARE_BASE_OBJECT_PROPERTIES;
+
+#ifdef SMILE_PACKED_ARGS
+	SmilePackedArg value;			// The current value of the variable, packed.
+#else
+	SmileArg value;					// The current value of the variable.
+#endif
+};
+
+//-------------------------------------------------------------------------------------------------
+//  Public interface
+
+SMILE_API_DATA SmileVTable SmileCell_VTable;
+
+SMILE_API_FUNC SmileCell SmileCell_Create(SmileArg value);
+
+//-------------------------------------------------------------------------------------------------
+//  Inline operations
+
+#ifdef SMILE_PACKED_ARGS
+
+Inline SmileArg SmileCell_GetValue(SmileCell cell)
+{
+	return SmilePackedArg_Unpack(cell->value);
+}
+
+Inline void SmileCell_SetValue(SmileCell cell, SmileArg value)
+{
+	cell->value = SmilePackedArg_Pack(value);
+}
+
+/// <summary>
+/// Get the object the cell refers to, if its value is a pointer, or NULL if it holds an unboxed value.
+/// </summary>
+Inline SmileObject SmileCell_GetReferencedObject(SmileCell cell)
+{
+	return SmilePackedArg_IsObject(cell->value) ? SmilePackedArg_GetObject(cell->value) : NULL;
+}
+
+#else
+
+Inline SmileArg SmileCell_GetValue(SmileCell cell)
+{
+	return cell->value;
+}
+
+Inline void SmileCell_SetValue(SmileCell cell, SmileArg value)
+{
+	cell->value = value;
+}
+
+/// <summary>
+/// Get the object the cell refers to, if its value is a pointer, or NULL if it holds an unboxed value.
+/// </summary>
+Inline SmileObject SmileCell_GetReferencedObject(SmileCell cell)
+{
+	return SMILE_KIND(cell->value.obj) > SMILE_KIND_UNBOXED_MAX ? cell->value.obj : NULL;
+}
+
+#endif
+
+#endif
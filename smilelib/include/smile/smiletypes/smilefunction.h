@@ -27,6 +27,8 @@
 #define ARG_CHECK_TYPES	(1 << 3)
 #define ARG_STATE_MACHINE	(1 << 4)	// This is a special "state machine" function.
 #define ARG_MODE_RAW	(1 << 5)	// This function accesses the call stack directly, and has no frame. (Use with caution!)
+#define ARG_PURE	(1 << 6)	// This function has no side effects and never calls back into Smile code.
+#define ARG_DIRECT_CALL	(1 << 7)	// Computed:  This function is pure and fully typed, so the interpreter may call it directly.
 
 /// <summary>
 /// This macro knows how to declare a function that is externally-callable by a Smile program.
@@ -93,6 +95,8 @@ typedef struct UserFunctionInfoStruct {
 	SmileObject body;	// The original body of this function
 		
 	struct ClosureInfoStruct closureInfo;	// The ClosureInfo that describes this function's stack behavior. 
+	ClosureInfo captureInfo;	// Describes the variables this function captures from its declaring function (NULL if none).
+	Int32 *captureSources;	// Where each captured variable is copied from when the function is instantiated.
 		
 	ByteCodeSegment byteCodeSegment;	// The byte-code instructions that describe this function's compiled body.
 
@@ -130,6 +134,39 @@ Inline Bool SmileFunction_IsBuiltIn(SmileFunction fn)
 	return (fn->kind & SMILE_FLAG_EXTERNAL_FUNCTION) != 0;
 }
 
+/// <summary>
+/// Determine whether the given external function can be invoked directly on the given arguments,
+/// without going through its vtable.  This succeeds only for functions marked ARG_DIRECT_CALL,
+/// and only when the arguments satisfy the function's declared arity and type checks; callers
+/// that get back false should use the normal call path, which will report any errors.
+/// </summary>
+/// <param name="fn">The function to test (which must be an external function).</param>
+/// <param name="argc">The number of arguments that would be passed.</param>
+/// <param name="argv">The arguments that would be passed.</param>
+/// <returns>True if the function's C code can be called directly with these arguments.</returns>
+Inline Bool SmileFunction_CanCallDirectly(SmileFunction fn, Int argc, SmileArg *argv)
+{
+	ExternalFunctionInfo info = &fn->u.externalFunctionInfo;
+	const Byte *typeChecks;
+	Int i, check, lastCheck;
+
+	if (!(info->argCheckFlags & ARG_DIRECT_CALL))
+		return False;
+
+	if (argc < info->minArgs || ((info->argCheckFlags & ARG_CHECK_EXACT) && argc != info->minArgs))
+		return False;
+
+	typeChecks = info->argTypeChecks;
+	lastCheck = info->numArgsToTypeCheck - 1;
+	for (i = 0; i < argc; i++) {
+		check = (i < lastCheck ? i : lastCheck) * 2;
+		if ((argv[i].obj->kind & typeChecks[check]) != typeChecks[check + 1])
+			return False;
+	}
+
+	return True;
+}
+
 Inline void SmileFunction_GetArgCounts(SmileFunction fn, Int *minArgs, Int *maxArgs)
 {
 	if (SmileFunction_IsBuiltIn(fn)) {
@@ -354,6 +354,7 @@ SMILE_API_FUNC void SmileObject_StringifyToStringBuilder(StringBuilder stringBui
 
 SMILE_API_FUNC Bool SmileObject_DeepCompare(SmileObject self, SmileObject other);
 SMILE_API_FUNC Bool SmileArg_DeepCompare(SmileArg self, SmileArg other);
+SMILE_API_FUNC Bool SmileArg_TryCompare(SmileArg a, SmileArg b, Int *cmp);
 
 SMILE_API_FUNC Bool SmileObject_RecursiveEquals(SmileObject a, SmileObject b);
 
@@ -0,0 +1,152 @@
+
+#ifndef __SMILE_SMILETYPES_SMILEPACKEDARG_H__
+#define __SMILE_SMILETYPES_SMILEPACKEDARG_H__
+
+#ifndef __SMILE_SMILETYPES_PREDECL_H__
+#include <smile/smiletypes/predecl.h>
+#endif
+
+#ifndef __SMILE_SMILETYPES_SMILEOBJECT_H__
+#include <smile/smiletypes/smileobject.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Type declarations
+
+/// <summary>
+/// A SmilePackedArg is an 8-byte, NaN-boxed encoding of a SmileArg, for places that need to store
+/// many values compactly.  A SmileArg is a 16-byte {obj, unboxed} pair; a packed arg carries the
+/// same information in a single 64-bit word, using the top 16 bits as a tag:
+///
+///   0x0000 xxxx xxxx xxxx    A pointer to a SmileObject, stored as-is (so the GC can see it).
+///   0x0002 .. 0xFFFD         A Float64, with 2^49 added to its bits (all NaNs are canonicalized).
+///   0xFFFE 00kk vvvv vvvv    A 32-bit scalar whose unboxed kind is 'kk' and whose bits are 'v'.
+///   0xFFFF xxxx xxxx xxxx    An Integer64 that fits in 48 signed bits.
+///
+/// The 32-bit scalars are Byte, Integer16, Integer32, Bool, Float32, Symbol, Real32, Char, and Uni.
+/// Anything that doesn't fit (Integer64s outside 48 bits, Real64s) falls back to a pointer to a
+/// boxed object, and is unboxed again when unpacked.  This encoding assumes that user-space
+/// pointers fit in 48 bits, which is true on every platform Smile currently supports.
+/// </summary>
+typedef UInt64 SmilePackedArg;
+
+#define SMILE_PACKED_TAG_SHIFT	48
+#define SMILE_PACKED_TAG_SCALAR	0xFFFEULL
+#define SMILE_PACKED_TAG_INT48	0xFFFFULL
+#define SMILE_PACKED_DOUBLE_OFFSET	(1ULL << 49)
+#define SMILE_PACKED_CANONICAL_NAN	0x7FF8000000000000ULL
+
+#define SMILE_PACKED_INT48_MIN	(-((Int64)1 << 47))
+#define SMILE_PACKED_INT48_MAX	(((Int64)1 << 47) - 1)
+
+//-------------------------------------------------------------------------------------------------
+//  Public interface
+
+SMILE_API_FUNC SmilePackedArg SmilePackedArg_Pack(SmileArg arg);
+SMILE_API_FUNC SmileArg SmilePackedArg_Unpack(SmilePackedArg packed);
+SMILE_API_FUNC SmilePackedArg SmilePackedArg_FromInt64(Int64 value);
+
+//-------------------------------------------------------------------------------------------------
+//  Inline operations
+
+/// <summary>
+/// Get the tag (the top 16 bits) of a packed arg.
+/// </summary>
+#define SmilePackedArg_Tag(__packed__) \
+	((UInt32)((__packed__) >> SMILE_PACKED_TAG_SHIFT))
+
+Inline Bool SmilePackedArg_IsObject(SmilePackedArg packed)
+{
+	return SmilePackedArg_Tag(packed) == 0;
+}
+
+Inline Bool SmilePackedArg_IsFloat64(SmilePackedArg packed)
+{
+	UInt32 tag = SmilePackedArg_Tag(packed);
+	return tag >= 0x0002 && tag <= 0xFFFD;
+}
+
+Inline Bool SmilePackedArg_IsInt48(SmilePackedArg packed)
+{
+	return SmilePackedArg_Tag(packed) == SMILE_PACKED_TAG_INT48;
+}
+
+Inline Bool SmilePackedArg_IsScalar(SmilePackedArg packed)
+{
+	return SmilePackedArg_Tag(packed) == SMILE_PACKED_TAG_SCALAR;
+}
+
+/// <summary>
+/// Get the SMILE_KIND of the value in a packed arg.  This is the same kind that SMILE_KIND()
+/// would report for the 'obj' of the unpacked SmileArg, so kind checks written against
+/// SmileArgs work unchanged against packed args.
+/// </summary>
+Inline UInt32 SmilePackedArg_Kind(SmilePackedArg packed)
+{
+	switch (SmilePackedArg_Tag(packed)) {
+		case 0:
+			return SMILE_KIND((SmileObject)(PtrInt)packed);
+		case SMILE_PACKED_TAG_SCALAR:
+			return (UInt32)(packed >> 32) & 0xFF;
+		case SMILE_PACKED_TAG_INT48:
+			return SMILE_KIND_UNBOXED_INTEGER64;
+		default:
+			return SMILE_KIND_UNBOXED_FLOAT64;
+	}
+}
+
+#define SMILE_PACKED_KIND(__packed__) \
+	(SmilePackedArg_Kind(__packed__))
+
+Inline SmilePackedArg SmilePackedArg_FromObject(SmileObject obj)
+{
+	return (SmilePackedArg)(PtrInt)obj;
+}
+
+Inline SmilePackedArg SmilePackedArg_FromScalar(UInt32 kind, UInt32 bits)
+{
+	return (SMILE_PACKED_TAG_SCALAR << SMILE_PACKED_TAG_SHIFT) | ((UInt64)kind << 32) | bits;
+}
+
+Inline SmilePackedArg SmilePackedArg_FromFloat64(Float64 value)
+{
+	union { Float64 f; UInt64 u; } bits;
+	bits.f = value;
+	if (value != value)
+		bits.u = SMILE_PACKED_CANONICAL_NAN;
+	return bits.u + SMILE_PACKED_DOUBLE_OFFSET;
+}
+
+Inline SmilePackedArg SmilePackedArg_FromInt32(Int32 value)
+{
+	return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_INTEGER32, (UInt32)value);
+}
+
+Inline SmilePackedArg SmilePackedArg_FromBool(Bool value)
+{
+	return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_BOOL, value ? 1 : 0);
+}
+
+Inline SmileObject SmilePackedArg_GetObject(SmilePackedArg packed)
+{
+	return (SmileObject)(PtrInt)packed;
+}
+
+Inline Float64 SmilePackedArg_GetFloat64(SmilePackedArg packed)
+{
+	union { Float64 f; UInt64 u; } bits;
+	bits.u = packed - SMILE_PACKED_DOUBLE_OFFSET;
+	return bits.f;
+}
+
+Inline Int64 SmilePackedArg_GetInt48(SmilePackedArg packed)
+{
+	return (Int64)(packed << 16) >> 16;
+}
+
+Inline UInt32 SmilePackedArg_GetScalarBits(SmilePackedArg packed)
+{
+	return (UInt32)packed;
+}
+
+#endif
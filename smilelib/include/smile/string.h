@@ -48,6 +48,25 @@ struct StringStruct {
 	} _opaque;
 };
 
+/// <summary>
+/// A slice is a String whose text is a range of some other String's text, rather than a copy
+/// of it.  Slices have SMILE_FLAG_STRING_SLICE set in their kind, and are otherwise exactly like
+/// any other String:  All of the String_*() functions work transparently on them.  A slice always
+/// points into a flat String, never into another slice, and holds a reference to that String so
+/// that its text stays alive.
+/// </summary>
+struct StringSliceStruct {
+	UInt32 kind;	// SMILE_KIND_STRING | SMILE_FLAG_STRING_SLICE
+	struct SmileVTableInt *vtable;	// The same virtual table as any other String.
+	struct SmileObjectInt *base;	// The same base object as any other String.
+
+	struct {
+		Int length;	// The length of the slice, in bytes (in the same place as a flat String's length).
+		const Byte *text;	// The start of the slice's text, within the parent's text (not nul-terminated).
+		String parent;	// The flat String whose text this slice refers to.
+	} _opaque;
+};
+
 /// <summary>
 /// Options for use in String_Split().
 /// </summary>
@@ -152,6 +171,9 @@ SMILE_API_FUNC Int String_Compare(const String a, const String b);
 SMILE_API_FUNC Int String_CompareRange(const String a, Int astart, Int alength, const String b, Int bstart, Int blength);
 
 SMILE_API_FUNC String String_SubstringAt(const String str, Int start);
+SMILE_API_FUNC String String_Compact(const String str);
+SMILE_API_FUNC const char *String_SliceToC(const String str);
+SMILE_API_FUNC UInt32 String_ScanText(const String str);
 SMILE_API_FUNC String String_Substring(const String str, Int start, Int length);
 SMILE_API_FUNC String String_SubstringByRange(const String str, Int64 start, Int64 end, Int64 step);
 SMILE_API_FUNC String String_Concat(const String str, const String other);
@@ -465,39 +487,78 @@ SMILE_API_DATA struct String_VTableInt String_VTableData;
 // Foreign reference to String's base object so that we can statically instantiate strings.
 SMILE_API_DATA struct SmileUserObjectInt String_BaseObjectStruct;
 
+/// <summary>
+/// Retrieve a pointer to the underlying byte array in the string.  Note that strings
+/// are immutable, so you should *not* change any data found at this pointer or you
+/// risk dangerous side-effects!  The bytes may legally contain nul (zero) values within
+/// them; you should use String_Length() to get the actual length of the string.  Unless
+/// the string is a slice, the bytes will also be nul-terminated (but use String_ToC() if
+/// you need a C-compatible string).
+/// </summary>
+/// <param name="str">The string to obtain the raw bytes of.</param>
+/// <returns>The raw bytes of the string.</returns>
+Inline const Byte *String_GetBytes(const String str)
+{
+	return (str->kind & SMILE_FLAG_STRING_SLICE) ? ((const struct StringSliceStruct *)str)->_opaque.text : str->_opaque.text;
+}
+
 /// <summary>
 /// Retrieve a byte from the string at the given index.  The index must
 /// be valid, or you may read past the end of the string.
 /// </summary>
-/// <param name="__str__">The string to read one byte from.</param>
-/// <param name="__index__">The index within that string of the byte to read.</param>
+/// <param name="str">The string to read one byte from.</param>
+/// <param name="index">The index within that string of the byte to read.</param>
 /// <returns>The byte at the given index.</returns>
-#define String_At(__str__, __index__) \
-	((const Byte)(__str__)->_opaque.text[(__index__)])
+Inline Byte String_At(const String str, Int index)
+{
+	return String_GetBytes(str)[index];
+}
 
 /// <summary>
-/// Retrieve a pointer to the underlying byte array in the string.  Note that strings
-/// are immutable, so you should *not* change any data found at this pointer or you
-/// risk dangerous side-effects!  The bytes will be nul-terminated (a C-compatible string),
-/// but may legally contain nul (zero) values within them; you should use String_Length()
-/// to get the actual length of the string.
+/// Determine whether the given string is a slice of another string's text.
 /// </summary>
-/// <param name="__str__">The string to obtain the raw bytes of.</param>
-/// <returns>The raw bytes of the string.</returns>
-#define String_GetBytes(__str__) \
-	((const Byte *)(__str__)->_opaque.text)
+#define String_IsSlice(__str__) \
+	(((__str__)->kind & SMILE_FLAG_STRING_SLICE) != 0)
 
 /// <summary>
-/// Retrieve a pointer to the underlying byte array in the string.  Note that strings
-/// are immutable, so you should *not* change any data found at this pointer or you
+/// Determine whether the given string's text is entirely 7-bit ASCII.  The answer is cached in
+/// the string after the first time it's asked (for strings on the heap), so this is usually
+/// just a test of a flag.
+/// </summary>
+/// <param name="str">The string to test.</param>
+/// <returns>True if every byte of the string is less than 128, False otherwise.</returns>
+Inline Bool String_IsAscii(const String str)
+{
+	UInt32 flags = (str->kind & SMILE_FLAG_STRING_SCANNED) ? str->kind : String_ScanText(str);
+	return (flags & SMILE_FLAG_STRING_ASCII) != 0;
+}
+
+/// <summary>
+/// Determine whether the given string's text is valid UTF-8.  The answer is cached in the
+/// string after the first time it's asked (for strings on the heap), so this is usually
+/// just a test of a flag.
+/// </summary>
+/// <param name="str">The string to test.</param>
+/// <returns>True if the string is valid UTF-8, False otherwise.</returns>
+Inline Bool String_IsValidUtf8(const String str)
+{
+	UInt32 flags = (str->kind & SMILE_FLAG_STRING_SCANNED) ? str->kind : String_ScanText(str);
+	return (flags & SMILE_FLAG_STRING_UTF8) != 0;
+}
+
+/// <summary>
+/// Retrieve a pointer to the underlying byte array in the string, as a C-style string.  Note
+/// that strings are immutable, so you should *not* change any data found at this pointer or you
 /// risk dangerous side-effects!  The bytes will be nul-terminated (a C-compatible string),
 /// but may legally contain nul (zero) values within them; you should use String_Length()
 /// to get the actual length of the string.
 /// </summary>
-/// <param name="__str__">The string to obtain the raw bytes of.</param>
+/// <param name="str">The string to obtain the raw bytes of.</param>
 /// <returns>The raw bytes of the string.</returns>
-#define String_ToC(__str__) \
-	((const char *)(__str__)->_opaque.text)
+Inline const char *String_ToC(const String str)
+{
+	return String_IsSlice(str) ? String_SliceToC(str) : (const char *)str->_opaque.text;
+}
 
 /// <summary>
 /// Get the length of the given string, in bytes.
@@ -535,7 +596,7 @@ Inline Bool String_IsNullOrEmpty(const String str)
 /// <returns>A reasonably-unique hash value for that string.</returns>
 Inline UInt32 String_Hash(const String str)
 {
-	return Smile_Hash(str->_opaque.text, String_Length(str));
+	return Smile_Hash(String_GetBytes(str), String_Length(str));
 }
 
 /// <summary>
@@ -556,7 +617,7 @@ Inline UInt32 String_HashInternal(const Byte *text, Int length)
 /// <returns>A reasonably-unique hash value for that string.</returns>
 Inline UInt64 String_Hash64(const String str)
 {
-	return Smile_Hash64(str->_opaque.text, String_Length(str));
+	return Smile_Hash64(String_GetBytes(str), String_Length(str));
 }
 
 /// <summary>
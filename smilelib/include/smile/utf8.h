@@ -0,0 +1,64 @@
+#ifndef __SMILE_UTF8_H__
+#define __SMILE_UTF8_H__
+
+#ifndef __SMILE_TYPES_H__
+#include <smile/types.h>
+#endif
+
+#ifndef __SMILE_STRING_H__
+#include <smile/string.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//  Public type declarations
+
+/// <summary>
+/// How many code points lie between adjacent breadcrumbs in a Utf8Index.
+/// </summary>
+#define UTF8INDEX_STRIDE 64
+
+/// <summary>
+/// A sparse index from code-point positions in a string to byte offsets ("breadcrumbs").  The
+/// index records the byte offset of every UTF8INDEX_STRIDE'th code point, so finding any code
+/// point takes one table lookup and a short scan, and finding which code point contains a given
+/// byte takes a binary search and a short scan.
+///
+/// Code points are counted as UTF-8 lead bytes (every byte that is not a continuation byte),
+/// which is exact for valid UTF-8.
+/// </summary>
+typedef struct Utf8IndexStruct {
+	String str;				// The indexed string.
+	Int numCodePoints;		// How many code points the string contains.
+
+	const Int *offsets;		// offsets[i] is the byte offset of code point i * UTF8INDEX_STRIDE.
+	Int numOffsets;			// How many breadcrumbs there are (always at least one).
+} *Utf8Index;
+
+//-------------------------------------------------------------------------------------------------
+//  External parts of the implementation
+
+SMILE_API_FUNC Int Utf8_FindInvalid(const Byte *text, Int length, Int start);
+SMILE_API_FUNC Int Utf8_CountCodePoints(const Byte *text, Int length);
+SMILE_API_FUNC Int Utf8_SkipCodePoints(const Byte *text, Int length, Int start, Int count);
+
+SMILE_API_FUNC Utf8Index Utf8Index_Create(const String str);
+SMILE_API_FUNC Utf8Index Utf8Index_Get(const String str);
+SMILE_API_FUNC Int Utf8Index_GetByteOffset(const Utf8Index index, Int codePointIndex);
+SMILE_API_FUNC Int Utf8Index_GetCodePointIndex(const Utf8Index index, Int byteOffset);
+
+//-------------------------------------------------------------------------------------------------
+//  Inline parts of the implementation
+
+/// <summary>
+/// Determine whether the given text is entirely valid UTF-8:  No stray or missing continuation
+/// bytes, no overlong encodings, no surrogates, and nothing above U+10FFFF.
+/// </summary>
+/// <param name="text">The text to validate.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <returns>True if the text is valid UTF-8, False if it is not.</returns>
+Inline Bool Utf8_IsValid(const Byte *text, Int length)
+{
+	return Utf8_FindInvalid(text, length, 0) >= length;
+}
+
+#endif
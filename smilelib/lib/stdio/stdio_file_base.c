@@ -1818,7 +1818,7 @@ static String CreateTempName(String prefix)
 	// in them by the time we're done.  That's not modern crypto-secure, but it's more
 	// than enough to prevent accidental collisions (and it was acceptably crypto-secure
 	// back in the '90s!).
-	randomChars = Base64Encode(hash, 15, False);
+	randomChars = Base64Encode(hash, 15, 0);
 
 	// Mutate the string in-place, since we can always be sure it was allocated uniquely
 	// by Base64Encode().  We strip out problematic characters, so that the result only
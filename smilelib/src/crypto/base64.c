@@ -16,12 +16,17 @@
 //---------------------------------------------------------------------------------------
 
 #include <smile/gc.h>
+#include <smile/mem.h>
 #include <smile/string.h>
-#include <smile/stringbuilder.h>
 #include <smile/crypto/base64.h>
+#include <smile/numeric/vector.h>
+
+#if VECTOR_HAS_AVX2
+	#include <immintrin.h>
+#endif
 
 /*
- * This code is derived from:
+ * The scalar code is derived from:
  *
  * Base64 encoding/decoding (RFC1341)
  * Copyright (c) 2005-2011, Jouni Malinen <j@w1.fi>
@@ -31,138 +36,522 @@
  *
  * It's basically Jouni's code, but with some slight revisions to allow the
  * return types to match what Smile prefers, and to use GC buffers instead of malloc.
+ *
+ * The AVX2 code uses the techniques of Wojciech Muła and Daniel Lemire, "Faster Base64
+ * Encoding and Decoding Using AVX2 Instructions" (ACM TOW, 2018).
  */
 
-static const unsigned char base64_table[65] =
+static const Byte _standardAlphabet[65] =
 	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const Byte _urlSafeAlphabet[65] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 
-/// <summary>Base-64 encode the given buffer of data.</summary>
-/// <param name="src">Data to be encoded.</param>
-/// <param name="len">Length of the data to be encoded.</param>
-/// <returns>Allocated String of encoded data.</returns>
-String Base64Encode(const Byte *src, Int len, Bool wrapLines)
+// What each character means when decoding:  Either its value (0-63), or one of these.
+#define DECODE_PAD		0x40	// '=', which pads out the last group.
+#define DECODE_SKIP		0x41	// Whitespace, which is ignored.
+#define DECODE_INVALID	0xFF	// Anything else, which isn't allowed.
+
+static const Byte _standardDecodeTable[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x41, 0x41, 0x41, 0x41, 0x41, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x41, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const Byte _urlSafeDecodeTable[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x41, 0x41, 0x41, 0x41, 0x41, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x41, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+#define ALPHABET(__flags__) ((__flags__) & BASE64_URL_SAFE ? _urlSafeAlphabet : _standardAlphabet)
+#define DECODE_TABLE(__flags__) ((__flags__) & BASE64_URL_SAFE ? _urlSafeDecodeTable : _standardDecodeTable)
+
+//-------------------------------------------------------------------------------------------------
+//  Bulk encoding and decoding of whole groups.
+
+#if VECTOR_HAS_AVX2
+
+/// <summary>
+/// Find which bytes lie in the given range (bytes above 127 never do).
+/// </summary>
+__attribute__((target("avx2")))
+Inline __m256i InRangeAvx2(__m256i v, char low, char high)
 {
-	String result;
-	Byte *out, *pos;
-	const Byte *end, *in;
-	Int olen;
-	Int line_len;
-
-	olen = len * 4 / 3 + 4;		// 3-byte blocks to 4-byte
-	if (wrapLines)
-		olen += olen / 72;			// line feeds
-	olen++;						// nul termination
-	if (olen < len)
-		Smile_Abort_OutOfMemory();	// integer overflow
-	result = String_CreateInternal(olen);
-	out = (Byte *)String_GetBytes(result);
-	if (out == NULL)
-		return NULL;
+	return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(low - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), v));
+}
+
+/// <summary>
+/// Encode groups of three bytes, 24 bytes at a time.
+/// </summary>
+/// <returns>How many groups were encoded, which may be fewer than requested.</returns>
+__attribute__((target("avx2")))
+static Int EncodeGroupsAvx2(const Byte *src, Int numGroups, Byte *dest, Int flags)
+{
+	Int i, length = numGroups * 3;
+	__m256i in, indices, lookup;
+
+	// Spread each lane's four groups into four 32-bit words, as bytes [b1, b0, b2, b1].
+	const __m256i spread = _mm256_setr_epi8(
+		1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+		1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+	// What to add to each sextet, by class:  A-Z, a-z, nine classes of 0-9, 62, and 63.
+	const char offset62 = (flags & BASE64_URL_SAFE) ? '-' - 62 : '+' - 62;
+	const char offset63 = (flags & BASE64_URL_SAFE) ? '_' - 63 : '/' - 63;
+	const __m256i offsets = _mm256_setr_epi8(
+		'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '0' - 52, offset62, offset63, 0, 0,
+		'A', 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '0' - 52, offset62, offset63, 0, 0);
+
+	// Each iteration reads 28 bytes (two overlapping 16-byte loads), but only encodes 24.
+	for (i = 0; i + 28 <= length; i += 24, dest += 32) {
+		in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(src + i))),
+			_mm_loadu_si128((const __m128i *)(src + i + 12)), 1);
+		in = _mm256_shuffle_epi8(in, spread);
+
+		// Move each sextet into its own byte.
+		indices = _mm256_or_si256(
+			_mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040)),
+			_mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010)));
+
+		// Classify each sextet (0 for A-Z, 1 for a-z, 2-11 for 0-9, 12 for 62, and 13 for 63),
+		// and add that class's offset to turn it into its character.
+		lookup = _mm256_sub_epi8(_mm256_subs_epu8(indices, _mm256_set1_epi8(51)),
+			_mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+		_mm256_storeu_si256((__m256i *)dest, _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, lookup)));
+	}
+
+	return i / 3;
+}
+
+/// <summary>
+/// Decode groups of four characters, 32 characters at a time, stopping at the first block that
+/// contains anything other than the alphabet (whitespace, padding, or invalid characters).
+/// </summary>
+/// <returns>How many characters were decoded, which is always a multiple of 32.</returns>
+__attribute__((target("avx2")))
+static Int DecodeGroupsAvx2(const Byte *text, Int length, Byte *dest, Int flags)
+{
+	Int i;
+	__m256i in, is62, is63, upper, lower, digit, offset;
+
+	const __m256i char62 = _mm256_set1_epi8((flags & BASE64_URL_SAFE) ? '-' : '+');
+	const __m256i char63 = _mm256_set1_epi8((flags & BASE64_URL_SAFE) ? '_' : '/');
+	const __m256i offset62 = _mm256_set1_epi8((flags & BASE64_URL_SAFE) ? 62 - '-' : 62 - '+');
+	const __m256i offset63 = _mm256_set1_epi8((flags & BASE64_URL_SAFE) ? 63 - '_' : 63 - '/');
+
+	// Pack each lane's 12 decoded bytes together, and then the two lanes' bytes together.
+	const __m256i pack = _mm256_setr_epi8(
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+		2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const __m256i merge = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+	for (i = 0; i + 32 <= length; i += 32, dest += 24) {
+		in = _mm256_loadu_si256((const __m256i *)(text + i));
+
+		upper = InRangeAvx2(in, 'A', 'Z');
+		lower = InRangeAvx2(in, 'a', 'z');
+		digit = InRangeAvx2(in, '0', '9');
+		is62 = _mm256_cmpeq_epi8(in, char62);
+		is63 = _mm256_cmpeq_epi8(in, char63);
+
+		if ((UInt32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(upper, lower),
+			_mm256_or_si256(digit, _mm256_or_si256(is62, is63)))) != 0xFFFFFFFF)
+			break;
+
+		// Turn each character into its sextet.
+		offset = _mm256_or_si256(
+			_mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+			_mm256_or_si256(_mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')),
+				_mm256_or_si256(_mm256_and_si256(is62, offset62), _mm256_and_si256(is63, offset63))));
+		in = _mm256_add_epi8(in, offset);
+
+		// Merge each four sextets into three bytes, and pack those bytes together.
+		in = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+		in = _mm256_madd_epi16(in, _mm256_set1_epi32(0x00011000));
+		in = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(in, pack), merge);
+
+		_mm_storeu_si128((__m128i *)dest, _mm256_castsi256_si128(in));
+		_mm_storel_epi64((__m128i *)(dest + 16), _mm256_extracti128_si256(in, 1));
+	}
+
+	return i;
+}
+
+#endif
+
+/// <summary>
+/// Encode groups of three bytes as groups of four characters.
+/// </summary>
+/// <returns>How many characters were written.</returns>
+static Int EncodeGroups(const Byte *src, Int numGroups, Byte *dest, Int flags)
+{
+	const Byte *alphabet = ALPHABET(flags);
+	Int i = 0;
+
+#if VECTOR_HAS_AVX2
+	if (numGroups >= 10 && Vector_GetIsa() == VECTOR_ISA_AVX2)
+		i = EncodeGroupsAvx2(src, numGroups, dest, flags);
+#endif
+
+	for (src += i * 3, dest += i * 4; i < numGroups; i++, src += 3, dest += 4) {
+		dest[0] = alphabet[src[0] >> 2];
+		dest[1] = alphabet[((src[0] & 0x03) << 4) | (src[1] >> 4)];
+		dest[2] = alphabet[((src[1] & 0x0F) << 2) | (src[2] >> 6)];
+		dest[3] = alphabet[src[2] & 0x3F];
+	}
+
+	return numGroups * 4;
+}
+
+/// <summary>
+/// Decode groups of four characters as groups of three bytes, stopping at the first group that
+/// contains anything other than the alphabet (whitespace, padding, or invalid characters).
+/// </summary>
+/// <returns>How many characters were decoded, which is always a multiple of 4.</returns>
+static Int DecodeGroups(const Byte *text, Int length, Byte *dest, Int flags)
+{
+	const Byte *table = DECODE_TABLE(flags);
+	Int i = 0;
+	UInt32 a, b, c, d;
+
+#if VECTOR_HAS_AVX2
+	if (length >= 32 && Vector_GetIsa() == VECTOR_ISA_AVX2) {
+		i = DecodeGroupsAvx2(text, length, dest, flags);
+		dest += i / 4 * 3;
+	}
+#endif
+
+	for (; i + 4 <= length; i += 4, dest += 3) {
+		a = table[text[i]];
+		b = table[text[i + 1]];
+		c = table[text[i + 2]];
+		d = table[text[i + 3]];
+		if ((a | b | c | d) & 0xC0)
+			break;
+
+		dest[0] = (Byte)((a << 2) | (b >> 4));
+		dest[1] = (Byte)((b << 4) | (c >> 2));
+		dest[2] = (Byte)((c << 6) | d);
+	}
+
+	return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Streaming encoding.
+
+/// <summary>
+/// Begin base-64 encoding data that will be provided a piece at a time.
+/// </summary>
+/// <param name="context">The encoding state to initialize.</param>
+/// <param name="flags">Any combination of BASE64_WRAP_LINES, BASE64_URL_SAFE, and BASE64_NO_PADDING.</param>
+void Base64_EncodeInit(Base64Context *context, Int flags)
+{
+	MemZero(context, sizeof(Base64Context));
+	context->flags = (Int32)flags;
+}
+
+/// <summary>
+/// Encode groups of three bytes, breaking lines as they fill up, if the context wants that.
+/// </summary>
+/// <returns>How many characters were written.</returns>
+static Int EncodeGroupsInLines(Base64Context *context, const Byte *src, Int numGroups, Byte *dest)
+{
+	Byte *start = dest;
+	Int count;
+
+	if (!(context->flags & BASE64_WRAP_LINES))
+		return EncodeGroups(src, numGroups, dest, context->flags);
+
+	while (numGroups > 0) {
+		count = (BASE64_LINE_LENGTH - context->lineLength) / 4;
+		if (count > numGroups)
+			count = numGroups;
 
-	end = src + len;
-	in = src;
-	pos = out;
-	line_len = 0;
-	while (end - in >= 3) {
-		*pos++ = base64_table[in[0] >> 2];
-		*pos++ = base64_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
-		*pos++ = base64_table[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
-		*pos++ = base64_table[in[2] & 0x3f];
-		in += 3;
-		line_len += 4;
-		if (wrapLines && line_len >= 72) {
-			*pos++ = '\n';
-			line_len = 0;
+		dest += EncodeGroups(src, count, dest, context->flags);
+		src += count * 3;
+		numGroups -= count;
+
+		context->lineLength += (Int32)count * 4;
+		if (context->lineLength >= BASE64_LINE_LENGTH) {
+			*dest++ = '\n';
+			context->lineLength = 0;
 		}
 	}
 
-	if (end - in) {
-		*pos++ = base64_table[in[0] >> 2];
-		if (end - in == 1) {
-			*pos++ = base64_table[(in[0] & 0x03) << 4];
-			*pos++ = '=';
+	return dest - start;
+}
+
+/// <summary>
+/// Base-64 encode the next piece of the data.  Any bytes at the end that don't make up a
+/// whole group of three are held in the context until the next update (or the finish).
+/// </summary>
+/// <param name="context">The encoding state.</param>
+/// <param name="buffer">The next piece of the data to encode.</param>
+/// <param name="length">The length of that piece of data.</param>
+/// <param name="dest">Where to write the encoded text, which must have room for at least
+/// Base64_GetMaxEncodedLength(length) characters.</param>
+/// <returns>How many characters were written.</returns>
+Int Base64_EncodeUpdate(Base64Context *context, const Byte *buffer, Int length, Byte *dest)
+{
+	Byte *start = dest;
+	Int numGroups;
+
+	// Finish the group left over from the last update, if there is one.
+	if (context->numPending > 0) {
+		while (context->numPending < 3 && length > 0) {
+			context->pending[context->numPending++] = *buffer++;
+			length--;
+		}
+		if (context->numPending < 3)
+			return 0;
+
+		dest += EncodeGroupsInLines(context, context->pending, 1, dest);
+		context->numPending = 0;
+	}
+
+	numGroups = length / 3;
+	dest += EncodeGroupsInLines(context, buffer, numGroups, dest);
+
+	// Keep whatever's left for next time.
+	context->numPending = (Int32)(length - numGroups * 3);
+	MemCpy(context->pending, buffer + numGroups * 3, context->numPending);
+
+	return dest - start;
+}
+
+/// <summary>
+/// Finish base-64 encoding, writing out the last partial group (with padding) and the
+/// last newline, if there are any.
+/// </summary>
+/// <param name="context">The encoding state.</param>
+/// <param name="dest">Where to write the encoded text, which must have room for at least
+/// six characters.</param>
+/// <returns>How many characters were written.</returns>
+Int Base64_EncodeFinish(Base64Context *context, Byte *dest)
+{
+	const Byte *alphabet = ALPHABET(context->flags);
+	const Byte *pending = context->pending;
+	Byte *start = dest;
+
+	if (context->numPending > 0) {
+		*dest++ = alphabet[pending[0] >> 2];
+		if (context->numPending == 1) {
+			*dest++ = alphabet[(pending[0] & 0x03) << 4];
+			if (!(context->flags & BASE64_NO_PADDING))
+				*dest++ = '=';
 		}
 		else {
-			*pos++ = base64_table[((in[0] & 0x03) << 4) |
-				(in[1] >> 4)];
-			*pos++ = base64_table[(in[1] & 0x0f) << 2];
+			*dest++ = alphabet[((pending[0] & 0x03) << 4) | (pending[1] >> 4)];
+			*dest++ = alphabet[(pending[1] & 0x0F) << 2];
 		}
-		*pos++ = '=';
-		line_len += 4;
+		if (!(context->flags & BASE64_NO_PADDING))
+			*dest++ = '=';
+
+		context->lineLength += 4;
+		context->numPending = 0;
 	}
 
-	if (wrapLines && line_len)
-		*pos++ = '\n';
+	if ((context->flags & BASE64_WRAP_LINES) && context->lineLength > 0) {
+		*dest++ = '\n';
+		context->lineLength = 0;
+	}
 
-	*pos = '\0';
+	return dest - start;
+}
 
-	// We likely over-allocated, so set the string's length to the correct count.
-	result->_opaque.length = (Int)(pos - out);
+//-------------------------------------------------------------------------------------------------
+//  Streaming decoding.
 
-	return result;
+/// <summary>
+/// Begin base-64 decoding text that will be provided a piece at a time.
+/// </summary>
+/// <param name="context">The decoding state to initialize.</param>
+/// <param name="flags">BASE64_URL_SAFE to decode the URL-safe alphabet; any other flags are ignored.</param>
+void Base64_DecodeInit(Base64Context *context, Int flags)
+{
+	MemZero(context, sizeof(Base64Context));
+	context->flags = (Int32)flags;
 }
 
-/// <summary>Base-64 decode the given string of encoded data.</summary>
-/// <param name="text">Data to be decoded.</param>
-/// <param name="out_len">This will be set to the number of bytes decoded.</param>
-/// <returns>Allocated buffer of decoded data, or NULL if the input is invalid.</returns>
-Byte *Base64Decode(String text, Int *out_len)
+/// <summary>
+/// Base-64 decode the next piece of the text.  Whitespace is ignored, and the '=' padding
+/// is optional; but any other character outside the alphabet, or anything after the padding,
+/// makes the text invalid.  Any characters at the end that don't make up a whole group of
+/// four are held in the context until the next update (or the finish).
+/// </summary>
+/// <param name="context">The decoding state.</param>
+/// <param name="text">The next piece of the text to decode.</param>
+/// <param name="length">The length of that piece of text.</param>
+/// <param name="dest">Where to write the decoded bytes, which must have room for at least
+/// Base64_GetMaxDecodedLength(length) bytes.</param>
+/// <returns>How many bytes were written, or -1 if the text is invalid.</returns>
+Int Base64_DecodeUpdate(Base64Context *context, const Byte *text, Int length, Byte *dest)
 {
-	Byte dtable[256], *out, *pos, block[4], tmp;
-	Int i, count, olen;
-	Int pad = 0;
-
-	const Byte *src = String_GetBytes(text);
-	Int len = String_Length(text);
-
-	MemSet(dtable, 0x80, 256);
-	for (i = 0; i < sizeof(base64_table) - 1; i++)
-		dtable[base64_table[i]] = (Byte)i;
-	dtable['='] = 0;
-
-	count = 0;
-	for (i = 0; i < len; i++) {
-		if (dtable[src[i]] != 0x80)
-			count++;
-	}
+	const Byte *table = DECODE_TABLE(context->flags);
+	Byte *pending = context->pending;
+	Byte *start = dest;
+	Int i, numDecoded;
+	Byte value;
 
-	if (count == 0 || count % 4)
-		return NULL;
+	if (context->failed)
+		return -1;
 
-	olen = count / 4 * 3;
-	pos = out = GC_MALLOC_ATOMIC(olen);
-	if (out == NULL)
-		Smile_Abort_OutOfMemory();
+	for (i = 0; i < length; ) {
+
+		// Between groups, decode as much as possible in bulk.
+		if (context->numPending == 0 && context->numPadding == 0) {
+			numDecoded = DecodeGroups(text + i, length - i, dest, context->flags);
+			i += numDecoded;
+			dest += numDecoded / 4 * 3;
+			if (i >= length) break;
+		}
+
+		// Then decode one character at a time until the next group boundary.
+		do {
+			value = table[text[i++]];
 
-	count = 0;
-	for (i = 0; i < len; i++) {
-		tmp = dtable[src[i]];
-		if (tmp == 0x80)
-			continue;
-
-		if (src[i] == '=')
-			pad++;
-		block[count] = tmp;
-		count++;
-		if (count == 4) {
-			*pos++ = (block[0] << 2) | (block[1] >> 4);
-			*pos++ = (block[1] << 4) | (block[2] >> 2);
-			*pos++ = (block[2] << 6) | block[3];
-			count = 0;
-			if (pad) {
-				if (pad == 1)
-					pos--;
-				else if (pad == 2)
-					pos -= 2;
-				else {
-					// Invalid padding.
-					return NULL;
+			if (value < 64) {
+				if (context->numPadding > 0)
+					goto invalid;
+				pending[context->numPending++] = value;
+				if (context->numPending == 4) {
+					*dest++ = (Byte)((pending[0] << 2) | (pending[1] >> 4));
+					*dest++ = (Byte)((pending[1] << 4) | (pending[2] >> 2));
+					*dest++ = (Byte)((pending[2] << 6) | pending[3]);
+					context->numPending = 0;
 				}
-				break;
 			}
-		}
+			else if (value == DECODE_PAD) {
+				// Padding can only fill out the third and fourth characters of a group.
+				if (context->numPending < 2)
+					goto invalid;
+				if (context->numPending + ++context->numPadding == 4) {
+					*dest++ = (Byte)((pending[0] << 2) | (pending[1] >> 4));
+					if (context->numPending == 3)
+						*dest++ = (Byte)((pending[1] << 4) | (pending[2] >> 2));
+					context->numPending = 0;
+				}
+			}
+			else if (value != DECODE_SKIP)
+				goto invalid;
+		} while (i < length && context->numPending > 0);
 	}
 
-	*out_len = (Int)(pos - out);
-	return out;
+	return dest - start;
+
+invalid:
+	context->failed = True;
+	return -1;
+}
+
+/// <summary>
+/// Finish base-64 decoding, writing out the last group if it was left unpadded.
+/// </summary>
+/// <param name="context">The decoding state.</param>
+/// <param name="dest">Where to write the decoded bytes, which must have room for at least
+/// two bytes.</param>
+/// <returns>How many bytes were written, or -1 if the text is invalid.</returns>
+Int Base64_DecodeFinish(Base64Context *context, Byte *dest)
+{
+	const Byte *pending = context->pending;
+	Int count = 0;
+
+	if (context->failed)
+		return -1;
+
+	// A group may leave off its padding, but it can't be only one character, or have only part
+	// of its padding.
+	if (context->numPending == 1 || (context->numPending > 0 && context->numPadding > 0)) {
+		context->failed = True;
+		return -1;
+	}
+
+	if (context->numPending >= 2)
+		dest[count++] = (Byte)((pending[0] << 2) | (pending[1] >> 4));
+	if (context->numPending == 3)
+		dest[count++] = (Byte)((pending[1] << 4) | (pending[2] >> 2));
+
+	context->numPending = 0;
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Whole-buffer encoding and decoding.
+
+/// <summary>Base-64 encode the given buffer of data.</summary>
+/// <param name="buffer">Data to be encoded.</param>
+/// <param name="length">Length of the data to be encoded.</param>
+/// <param name="flags">Any combination of BASE64_WRAP_LINES, BASE64_URL_SAFE, and BASE64_NO_PADDING.</param>
+/// <returns>Allocated String of encoded data.</returns>
+String Base64Encode(const Byte *buffer, Int length, Int flags)
+{
+	Base64Context context;
+	String result;
+	Byte *dest;
+	Int size;
+
+	result = String_CreateInternal(Base64_GetEncodedLength(length, flags));
+	if (String_IsNullOrEmpty(result))
+		return result;
+	dest = (Byte *)String_GetBytes(result);
+
+	Base64_EncodeInit(&context, flags);
+	size = Base64_EncodeUpdate(&context, buffer, length, dest);
+	Base64_EncodeFinish(&context, dest + size);
+
+	return result;
+}
+
+/// <summary>Base-64 decode the given encoded text.</summary>
+/// <param name="text">Text to be decoded.</param>
+/// <param name="textLength">Length of the text to be decoded.</param>
+/// <param name="flags">BASE64_URL_SAFE to decode the URL-safe alphabet.</param>
+/// <param name="length">This will be set to the number of bytes decoded.</param>
+/// <returns>Allocated buffer of decoded data, or NULL if the input is invalid.</returns>
+Byte *Base64Decode(const Byte *text, Int textLength, Int flags, Int *length)
+{
+	Base64Context context;
+	Byte *result;
+	Int size, tailSize;
+
+	result = GC_MALLOC_BYTES(Base64_GetMaxDecodedLength(textLength));
+	if (result == NULL)
+		Smile_Abort_OutOfMemory();
+
+	Base64_DecodeInit(&context, flags);
+	if ((size = Base64_DecodeUpdate(&context, text, textLength, result)) < 0
+		|| (tailSize = Base64_DecodeFinish(&context, result + size)) < 0)
+		return NULL;
+
+	*length = size + tailSize;
+	return result;
 }
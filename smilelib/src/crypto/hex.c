@@ -0,0 +1,303 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/gc.h>
+#include <smile/mem.h>
+#include <smile/string.h>
+#include <smile/crypto/hex.h>
+#include <smile/numeric/vector.h>
+
+#if VECTOR_HAS_AVX2
+	#include <immintrin.h>
+#endif
+
+static const Byte _uppercaseDigits[16] = "0123456789ABCDEF";
+static const Byte _lowercaseDigits[16] = "0123456789abcdef";
+
+// What each character means when decoding:  Either its value (0-15), or one of these.
+#define DECODE_SKIP		0x10	// Whitespace, which is ignored.
+#define DECODE_INVALID	0xFF	// Anything else, which isn't allowed.
+
+static const Byte _decodeTable[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x10, 0x10, 0x10, 0x10, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+//-------------------------------------------------------------------------------------------------
+//  Bulk encoding and decoding.
+
+#if VECTOR_HAS_AVX2
+
+/// <summary>
+/// Find which bytes lie in the given range (bytes above 127 never do).
+/// </summary>
+__attribute__((target("avx2")))
+Inline __m256i InRangeAvx2(__m256i v, char low, char high)
+{
+	return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(low - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), v));
+}
+
+/// <summary>
+/// Encode bytes as hex digits, 32 bytes at a time.
+/// </summary>
+/// <returns>How many bytes were encoded, which is always a multiple of 32.</returns>
+__attribute__((target("avx2")))
+static Int EncodeAvx2(const Byte *buffer, Int length, Byte *dest, const Byte *digits)
+{
+	Int i;
+	__m256i in, high, low, first, second;
+
+	const __m256i lookup = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)digits));
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+	for (i = 0; i + 32 <= length; i += 32, dest += 64) {
+		in = _mm256_loadu_si256((const __m256i *)(buffer + i));
+		high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+		low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(in, nibble));
+
+		// Interleave the digits; each lane holds a quarter of the output, so put the lanes in order.
+		first = _mm256_unpacklo_epi8(high, low);
+		second = _mm256_unpackhi_epi8(high, low);
+		_mm256_storeu_si256((__m256i *)dest, _mm256_permute2x128_si256(first, second, 0x20));
+		_mm256_storeu_si256((__m256i *)(dest + 32), _mm256_permute2x128_si256(first, second, 0x31));
+	}
+
+	return i;
+}
+
+/// <summary>
+/// Turn 32 hex digits into their values, or report that they aren't all hex digits.
+/// </summary>
+__attribute__((target("avx2")))
+Inline Bool DecodeDigitsAvx2(__m256i in, __m256i *values)
+{
+	__m256i digit, letter, folded;
+
+	folded = _mm256_or_si256(in, _mm256_set1_epi8(0x20));
+	digit = InRangeAvx2(in, '0', '9');
+	letter = InRangeAvx2(folded, 'a', 'f');
+
+	if ((UInt32)_mm256_movemask_epi8(_mm256_or_si256(digit, letter)) != 0xFFFFFFFF)
+		return False;
+
+	*values = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(in, _mm256_set1_epi8('0'))),
+		_mm256_and_si256(letter, _mm256_sub_epi8(folded, _mm256_set1_epi8('a' - 10))));
+	return True;
+}
+
+/// <summary>
+/// Decode hex digits, 64 digits at a time, stopping at the first block that contains anything
+/// other than hex digits.
+/// </summary>
+/// <returns>How many digits were decoded, which is always a multiple of 64.</returns>
+__attribute__((target("avx2")))
+static Int DecodeAvx2(const Byte *text, Int length, Byte *dest)
+{
+	Int i;
+	__m256i first, second;
+
+	for (i = 0; i + 64 <= length; i += 64, dest += 32) {
+		if (!DecodeDigitsAvx2(_mm256_loadu_si256((const __m256i *)(text + i)), &first)
+			|| !DecodeDigitsAvx2(_mm256_loadu_si256((const __m256i *)(text + i + 32)), &second))
+			break;
+
+		// Merge each pair of nibbles into a 16-bit word, and pack the words back into bytes.
+		first = _mm256_maddubs_epi16(first, _mm256_set1_epi16(0x0110));
+		second = _mm256_maddubs_epi16(second, _mm256_set1_epi16(0x0110));
+		_mm256_storeu_si256((__m256i *)dest, _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8));
+	}
+
+	return i;
+}
+
+#endif
+
+/// <summary>
+/// Decode pairs of hex digits, stopping at the first pair that contains anything other than
+/// hex digits.
+/// </summary>
+/// <returns>How many digits were decoded, which is always a multiple of 2.</returns>
+static Int DecodePairs(const Byte *text, Int length, Byte *dest)
+{
+	Int i = 0;
+	Byte high, low;
+
+#if VECTOR_HAS_AVX2
+	if (length >= 64 && Vector_GetIsa() == VECTOR_ISA_AVX2) {
+		i = DecodeAvx2(text, length, dest);
+		dest += i / 2;
+	}
+#endif
+
+	for (; i + 2 <= length; i += 2) {
+		high = _decodeTable[text[i]];
+		low = _decodeTable[text[i + 1]];
+		if ((high | low) & 0xF0)
+			break;
+		*dest++ = (Byte)((high << 4) | low);
+	}
+
+	return i;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Streaming encoding and decoding.
+
+/// <summary>
+/// Hex-encode the given data, two digits per byte.
+/// </summary>
+/// <param name="buffer">The data to encode.</param>
+/// <param name="length">The length of the data.</param>
+/// <param name="dest">Where to write the digits, which must have room for length * 2 of them.</param>
+/// <param name="lowercase">Whether to write 'a' through 'f' instead of 'A' through 'F'.</param>
+void Hex_Encode(const Byte *buffer, Int length, Byte *dest, Bool lowercase)
+{
+	const Byte *digits = lowercase ? _lowercaseDigits : _uppercaseDigits;
+	Int i = 0;
+
+#if VECTOR_HAS_AVX2
+	if (length >= 32 && Vector_GetIsa() == VECTOR_ISA_AVX2)
+		i = EncodeAvx2(buffer, length, dest, digits);
+#endif
+
+	for (dest += i * 2; i < length; i++) {
+		*dest++ = digits[buffer[i] >> 4];
+		*dest++ = digits[buffer[i] & 0xF];
+	}
+}
+
+/// <summary>
+/// Begin hex-decoding text that will be provided a piece at a time.
+/// </summary>
+/// <param name="context">The decoding state to initialize.</param>
+void Hex_DecodeInit(HexContext *context)
+{
+	MemZero(context, sizeof(HexContext));
+}
+
+/// <summary>
+/// Hex-decode the next piece of the text.  Digits may be in either case, and whitespace is
+/// ignored, but anything else makes the text invalid.
+/// </summary>
+/// <param name="context">The decoding state.</param>
+/// <param name="text">The next piece of the text to decode.</param>
+/// <param name="length">The length of that piece of text.</param>
+/// <param name="dest">Where to write the decoded bytes, which must have room for at least
+/// (length + 1) / 2 bytes.</param>
+/// <returns>How many bytes were written, or -1 if the text is invalid.</returns>
+Int Hex_DecodeUpdate(HexContext *context, const Byte *text, Int length, Byte *dest)
+{
+	Byte *start = dest;
+	Int i, numDecoded;
+	Byte value;
+
+	if (context->failed)
+		return -1;
+
+	for (i = 0; i < length; ) {
+
+		// Between bytes, decode as much as possible in bulk.
+		if (!context->hasPending) {
+			numDecoded = DecodePairs(text + i, length - i, dest);
+			i += numDecoded;
+			dest += numDecoded / 2;
+			if (i >= length) break;
+		}
+
+		value = _decodeTable[text[i++]];
+		if (value < 16) {
+			if (context->hasPending)
+				*dest++ = (Byte)((context->pending << 4) | value);
+			else
+				context->pending = value;
+			context->hasPending = !context->hasPending;
+		}
+		else if (value != DECODE_SKIP) {
+			context->failed = True;
+			return -1;
+		}
+	}
+
+	return dest - start;
+}
+
+/// <summary>
+/// Finish hex-decoding, checking that the text didn't end halfway through a byte.
+/// </summary>
+/// <param name="context">The decoding state.</param>
+/// <returns>True if the text was valid, False if it was not.</returns>
+Bool Hex_DecodeFinish(HexContext *context)
+{
+	if (context->hasPending)
+		context->failed = True;
+	return !context->failed;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Whole-buffer encoding and decoding.
+
+/// <summary>Hex-encode the given buffer of data.</summary>
+/// <param name="buffer">Data to be encoded.</param>
+/// <param name="length">Length of the data to be encoded.</param>
+/// <param name="lowercase">Whether to write 'a' through 'f' instead of 'A' through 'F'.</param>
+/// <returns>Allocated String of encoded data.</returns>
+String HexEncode(const Byte *buffer, Int length, Bool lowercase)
+{
+	String result = String_CreateInternal(length * 2);
+
+	if (length > 0)
+		Hex_Encode(buffer, length, (Byte *)String_GetBytes(result), lowercase);
+
+	return result;
+}
+
+/// <summary>Hex-decode the given encoded text.</summary>
+/// <param name="text">Text to be decoded.</param>
+/// <param name="textLength">Length of the text to be decoded.</param>
+/// <param name="length">This will be set to the number of bytes decoded.</param>
+/// <returns>Allocated buffer of decoded data, or NULL if the input is invalid.</returns>
+Byte *HexDecode(const Byte *text, Int textLength, Int *length)
+{
+	HexContext context;
+	Byte *result;
+	Int size;
+
+	result = GC_MALLOC_BYTES((textLength + 1) / 2);
+	if (result == NULL)
+		Smile_Abort_OutOfMemory();
+
+	Hex_DecodeInit(&context);
+	if ((size = Hex_DecodeUpdate(&context, text, textLength, result)) < 0 || !Hex_DecodeFinish(&context))
+		return NULL;
+
+	*length = size;
+	return result;
+}
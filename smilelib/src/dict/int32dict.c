@@ -25,6 +25,11 @@
 //-------------------------------------------------------------------------------------------------
 //  Private functions
 
+// The node heap is described to the GC precisely, so it only scans the words that can hold pointers.
+DECLARE_GC_DESCRIPTOR(struct Int32DictNode, Int32DictNode_GCDescriptor, {
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct Int32DictNode, value));
+})
+
 static void Int32DictInt_Resize(struct Int32DictInt *self, Int32 newLen)
 {
 	struct Int32DictNode *newHeap, *oldHeap;
@@ -40,7 +45,7 @@ static void Int32DictInt_Resize(struct Int32DictInt *self, Int32 newLen)
 	if ((PtrInt)newLen > PtrIntMax / sizeof(struct Int32DictNode)) Smile_Abort_OutOfMemory();
 	newBuckets = GC_MALLOC_RAW_ARRAY(Int32, newLen);
 	if (newBuckets == NULL) Smile_Abort_OutOfMemory();
-	newHeap = GC_MALLOC_STRUCT_ARRAY(struct Int32DictNode, newLen);
+	newHeap = GC_MALLOC_TYPED_ARRAY(struct Int32DictNode, newLen, Int32DictNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	// The new buckets start out empty.  This runs in O(n) time.
@@ -161,7 +166,7 @@ Int32Dict Int32Dict_Clone(Int32Dict intDict, Int32Dict_ValueCloner valueCloner,
 
 	MemCpy(buckets, oldIntDict->buckets, sizeof(Int32) * newSize);
 
-	newIntDict->heap = newHeap = GC_MALLOC_STRUCT_ARRAY(struct Int32DictNode, newSize);
+	newIntDict->heap = newHeap = GC_MALLOC_TYPED_ARRAY(struct Int32DictNode, newSize, Int32DictNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	oldHeap = oldIntDict->heap;
@@ -367,7 +372,7 @@ void Int32Dict_ClearWithSize(Int32Dict intDict, Int32 newSize)
 
 	self->buckets = buckets = GC_MALLOC_RAW_ARRAY(Int32, newSize);
 	if (buckets == NULL) Smile_Abort_OutOfMemory();
-	self->heap = heap = GC_MALLOC_STRUCT_ARRAY(struct Int32DictNode, newSize);
+	self->heap = heap = GC_MALLOC_TYPED_ARRAY(struct Int32DictNode, newSize, Int32DictNode_GCDescriptor());
 	if (heap == NULL) Smile_Abort_OutOfMemory();
 	self->firstFree = 0;
 	self->count = 0;
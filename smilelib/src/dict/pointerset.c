@@ -25,6 +25,11 @@
 //-------------------------------------------------------------------------------------------------
 //  Private functions
 
+// The node heap is described to the GC precisely, so it only scans the words that can hold pointers.
+DECLARE_GC_DESCRIPTOR(struct PointerSetNode, PointerSetNode_GCDescriptor, {
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct PointerSetNode, key));
+})
+
 static void PointerSetInt_Resize(struct PointerSetInt *self, Int32 newLen)
 {
 	struct PointerSetNode *newHeap, *oldHeap;
@@ -40,7 +45,7 @@ static void PointerSetInt_Resize(struct PointerSetInt *self, Int32 newLen)
 	if ((PtrInt)newLen > PtrIntMax / sizeof(struct PointerSetNode)) Smile_Abort_OutOfMemory();
 	newBuckets = GC_MALLOC_RAW_ARRAY(Int32, newLen);
 	if (newBuckets == NULL) Smile_Abort_OutOfMemory();
-	newHeap = GC_MALLOC_STRUCT_ARRAY(struct PointerSetNode, newLen);
+	newHeap = GC_MALLOC_TYPED_ARRAY(struct PointerSetNode, newLen, PointerSetNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	// The new buckets start out empty.  This runs in O(n) time.
@@ -156,7 +161,7 @@ PointerSet PointerSet_Clone(PointerSet pointerSet, PointerSet_KeyCloner keyClone
 
 	MemCpy(buckets, oldIntDict->buckets, sizeof(Int32) * newSize);
 
-	newIntDict->heap = newHeap = GC_MALLOC_STRUCT_ARRAY(struct PointerSetNode, newSize);
+	newIntDict->heap = newHeap = GC_MALLOC_TYPED_ARRAY(struct PointerSetNode, newSize, PointerSetNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	oldHeap = oldIntDict->heap;
@@ -281,7 +286,7 @@ void PointerSet_ClearWithSize(PointerSet pointerSet, Int32 newSize)
 
 	self->buckets = buckets = GC_MALLOC_RAW_ARRAY(Int32, newSize);
 	if (buckets == NULL) Smile_Abort_OutOfMemory();
-	self->heap = heap = GC_MALLOC_STRUCT_ARRAY(struct PointerSetNode, newSize);
+	self->heap = heap = GC_MALLOC_TYPED_ARRAY(struct PointerSetNode, newSize, PointerSetNode_GCDescriptor());
 	if (heap == NULL) Smile_Abort_OutOfMemory();
 	self->firstFree = 0;
 	self->count = 0;
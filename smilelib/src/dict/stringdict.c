@@ -25,6 +25,12 @@
 //-------------------------------------------------------------------------------------------------
 //  Private functions
 
+// The node heap is described to the GC precisely, so it only scans the words that can hold pointers.
+DECLARE_GC_DESCRIPTOR(struct StringDictNode, StringDictNode_GCDescriptor, {
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct StringDictNode, key));
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct StringDictNode, value));
+})
+
 static void StringDictInt_Resize(struct StringDictInt *self, Int newLen)
 {
 	struct StringDictNode *newHeap, *oldHeap;
@@ -40,7 +46,7 @@ static void StringDictInt_Resize(struct StringDictInt *self, Int newLen)
 	if ((PtrInt)newLen > PtrIntMax / sizeof(struct StringDictNode)) Smile_Abort_OutOfMemory();
 	newBuckets = GC_MALLOC_RAW_ARRAY(Int, newLen);
 	if (newBuckets == NULL) Smile_Abort_OutOfMemory();
-	newHeap = GC_MALLOC_STRUCT_ARRAY(struct StringDictNode, newLen);
+	newHeap = GC_MALLOC_TYPED_ARRAY(struct StringDictNode, newLen, StringDictNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	// The new buckets start out empty.  This runs in O(n) time.
@@ -169,7 +175,7 @@ StringDict StringDict_Clone(StringDict stringDict, StringDict_ValueCloner valueC
 
 	MemCpy(buckets, oldStringDict->buckets, sizeof(Int) * newSize);
 
-	newStringDict->heap = newHeap = GC_MALLOC_STRUCT_ARRAY(struct StringDictNode, newSize);
+	newStringDict->heap = newHeap = GC_MALLOC_TYPED_ARRAY(struct StringDictNode, newSize, StringDictNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	oldHeap = oldStringDict->heap;
@@ -341,7 +347,7 @@ void StringDict_ClearWithSize(StringDict stringDict, Int newSize)
 
 	self->buckets = buckets = GC_MALLOC_RAW_ARRAY(Int, newSize);
 	if (buckets == NULL) Smile_Abort_OutOfMemory();
-	self->heap = heap = GC_MALLOC_STRUCT_ARRAY(struct StringDictNode, newSize);
+	self->heap = heap = GC_MALLOC_TYPED_ARRAY(struct StringDictNode, newSize, StringDictNode_GCDescriptor());
 	if (heap == NULL) Smile_Abort_OutOfMemory();
 	self->firstFree = 0;
 	self->count = 0;
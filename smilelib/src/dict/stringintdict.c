@@ -25,6 +25,11 @@
 //-------------------------------------------------------------------------------------------------
 //  Private functions
 
+// The node heap is described to the GC precisely, so it only scans the words that can hold pointers.
+DECLARE_GC_DESCRIPTOR(struct StringIntDictNode, StringIntDictNode_GCDescriptor, {
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct StringIntDictNode, key));
+})
+
 static void StringIntDictInt_Resize(struct StringIntDictInt *self, Int newLen)
 {
 	struct StringIntDictNode *newHeap, *oldHeap;
@@ -40,7 +45,7 @@ static void StringIntDictInt_Resize(struct StringIntDictInt *self, Int newLen)
 	if ((PtrInt)newLen > PtrIntMax / sizeof(struct StringIntDictNode)) Smile_Abort_OutOfMemory();
 	newBuckets = GC_MALLOC_RAW_ARRAY(Int, newLen);
 	if (newBuckets == NULL) Smile_Abort_OutOfMemory();
-	newHeap = GC_MALLOC_STRUCT_ARRAY(struct StringIntDictNode, newLen);
+	newHeap = GC_MALLOC_TYPED_ARRAY(struct StringIntDictNode, newLen, StringIntDictNode_GCDescriptor());
 	if (newHeap == NULL) Smile_Abort_OutOfMemory();
 
 	// The new buckets start out empty.  This runs in O(n) time.
@@ -224,7 +229,7 @@ Int *StringIntDict_GetValues(StringIntDict stringDict)
 
 	self = (struct StringIntDictInt *)stringDict;
 
-	values = GC_MALLOC_STRUCT_ARRAY(Int, self->count);
+	values = GC_MALLOC_RAW_ARRAY(Int, self->count);
 	if (values == NULL) Smile_Abort_OutOfMemory();
 
 	buckets = self->buckets;
@@ -268,7 +273,7 @@ void StringIntDict_ClearWithSize(StringIntDict stringDict, Int newSize)
 
 	self->buckets = buckets = GC_MALLOC_RAW_ARRAY(Int, newSize);
 	if (buckets == NULL) Smile_Abort_OutOfMemory();
-	self->heap = heap = GC_MALLOC_STRUCT_ARRAY(struct StringIntDictNode, newSize);
+	self->heap = heap = GC_MALLOC_TYPED_ARRAY(struct StringIntDictNode, newSize, StringIntDictNode_GCDescriptor());
 	if (heap == NULL) Smile_Abort_OutOfMemory();
 	self->firstFree = 0;
 	self->count = 0;
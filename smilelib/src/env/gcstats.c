@@ -0,0 +1,178 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/types.h>
+#include <smile/gc.h>
+#include <smile/stringbuilder.h>
+#include <smile/env/gcstats.h>
+#include <smile/smiletypes/smileobject.h>
+
+/// <summary>
+/// Whether allocation telemetry is currently being collected.  Read this through the
+/// GCSTATS_RECORD_ALLOCATION() macro; change it only through GcStats_Enable().
+/// </summary>
+Bool GcStats_Enabled = False;
+
+// Allocation counters, by kind.
+static UInt64 _allocationCounts[GCSTATS_NUM_KINDS];
+static UInt64 _allocationBytes[GCSTATS_NUM_KINDS];
+
+// Collection counters.
+static GC_word _baseGcNo;
+static UInt64 _numTimedCollections;
+static UInt64 _totalPauseTicks;
+static UInt64 _maxPauseTicks;
+
+//-------------------------------------------------------------------------------------------------
+// Public interface.
+
+/// <summary>
+/// Turn allocation and collection telemetry on or off.  When it is off, nothing is counted.
+/// Turning it on for the first time resets all of the counters.
+/// </summary>
+/// <param name="enable">True to start collecting telemetry, False to stop.</param>
+void GcStats_Enable(Bool enable)
+{
+	static Bool everEnabled = False;
+
+	if (enable == GcStats_Enabled) return;
+
+	if (enable) {
+		if (!everEnabled) {
+			GcStats_Reset();
+			everEnabled = True;
+		}
+		GcStats_Enabled = True;
+	}
+	else {
+		GcStats_Enabled = False;
+	}
+}
+
+/// <summary>
+/// Reset all of the telemetry counters to zero.
+/// </summary>
+void GcStats_Reset(void)
+{
+	MemZero(_allocationCounts, sizeof(_allocationCounts));
+	MemZero(_allocationBytes, sizeof(_allocationBytes));
+
+	_baseGcNo = GC_get_gc_no();
+	_numTimedCollections = 0;
+	_totalPauseTicks = 0;
+	_maxPauseTicks = 0;
+}
+
+/// <summary>
+/// Record the allocation of a single object.  Call this via GCSTATS_RECORD_ALLOCATION(), which
+/// avoids the call entirely when telemetry is disabled.
+/// </summary>
+/// <param name="kind">The SMILE_KIND_* of the new object (any flag bits are ignored).</param>
+/// <param name="size">The size of the new object, in bytes.</param>
+void GcStats_RecordAllocationInternal(Int kind, Int size)
+{
+	kind &= SMILE_KIND_MASK;
+	_allocationCounts[kind]++;
+	_allocationBytes[kind] += (UInt64)size;
+}
+
+/// <summary>
+/// Run a full garbage collection.  This is equivalent to GC_gcollect(), but when telemetry is
+/// enabled, the collection's pause is timed and included in the pause totals.
+/// </summary>
+/// <remarks>
+/// Only these collections are timed.  Boehm tells us when a collection starts but not when it
+/// ends, so the collections it runs on its own during allocation are counted, but their pauses
+/// can't be measured without also measuring some arbitrary amount of the program after them.
+/// </remarks>
+void GcStats_Collect(void)
+{
+	UInt64 start, pause;
+
+	if (!GcStats_Enabled) {
+		GC_gcollect();
+		return;
+	}
+
+	start = Smile_GetTicks();
+	GC_gcollect();
+	pause = Smile_GetTicks() - start;
+
+	_numTimedCollections++;
+	_totalPauseTicks += pause;
+	if (pause > _maxPauseTicks)
+		_maxPauseTicks = pause;
+}
+
+/// <summary>
+/// Take a snapshot of the current telemetry.
+/// </summary>
+/// <param name="stats">The structure to fill in with the current telemetry.</param>
+void GcStats_Get(GcStats stats)
+{
+	Int i;
+
+	MemCpy(stats->allocationCounts, _allocationCounts, sizeof(_allocationCounts));
+	MemCpy(stats->allocationBytes, _allocationBytes, sizeof(_allocationBytes));
+
+	stats->totalAllocationCount = 0;
+	stats->totalAllocationBytes = 0;
+	for (i = 0; i < GCSTATS_NUM_KINDS; i++) {
+		stats->totalAllocationCount += _allocationCounts[i];
+		stats->totalAllocationBytes += _allocationBytes[i];
+	}
+
+	stats->numCollections = (UInt64)(GC_get_gc_no() - _baseGcNo);
+	stats->numTimedCollections = _numTimedCollections;
+	stats->totalPauseTicks = _totalPauseTicks;
+	stats->maxPauseTicks = _maxPauseTicks;
+
+	stats->heapSize = (UInt64)GC_get_heap_size();
+	stats->freeBytes = (UInt64)GC_get_free_bytes();
+	stats->liveBytes = stats->heapSize > stats->freeBytes ? stats->heapSize - stats->freeBytes : 0;
+	stats->bytesSinceGc = (UInt64)GC_get_bytes_since_gc();
+}
+
+/// <summary>
+/// Format a snapshot of the telemetry as a human-readable multi-line report.
+/// </summary>
+/// <param name="stats">The telemetry snapshot to format.</param>
+/// <returns>The report, as a String.</returns>
+String GcStats_ToString(GcStats stats)
+{
+	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 1024);
+	Int i;
+
+	INIT_INLINE_STRINGBUILDER(stringBuilder);
+
+	StringBuilder_AppendFormat(stringBuilder, "GC collections:    %lu\n", stats->numCollections);
+	StringBuilder_AppendFormat(stringBuilder, "GC pause total:    %lu ms (%lu timed collections)\n",
+		Smile_TicksToMilliseconds(stats->totalPauseTicks), stats->numTimedCollections);
+	StringBuilder_AppendFormat(stringBuilder, "GC pause max:      %lu ms\n", Smile_TicksToMilliseconds(stats->maxPauseTicks));
+	StringBuilder_AppendFormat(stringBuilder, "Heap size:         %lu bytes\n", stats->heapSize);
+	StringBuilder_AppendFormat(stringBuilder, "Live heap (est.):  %lu bytes\n", stats->liveBytes);
+	StringBuilder_AppendFormat(stringBuilder, "Allocated:         %lu objects, %lu bytes\n",
+		stats->totalAllocationCount, stats->totalAllocationBytes);
+
+	for (i = 0; i < GCSTATS_NUM_KINDS; i++) {
+		if (!stats->allocationCounts[i]) continue;
+		StringBuilder_AppendFormat(stringBuilder, "  %S: %lu objects, %lu bytes\n",
+			SmileKind_GetName(i), stats->allocationCounts[i], stats->allocationBytes[i]);
+	}
+
+	return StringBuilder_ToString(stringBuilder);
+}
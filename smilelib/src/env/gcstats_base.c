@@ -0,0 +1,342 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/env/gcstats.h>
+#include <smile/env/heapcensus.h>
+#include <smile/env/weakref.h>
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/smilefunction.h>
+#include <smile/smiletypes/base.h>
+#include <smile/eval/eval.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+// All of these may be invoked either as [Gc.foo] or as [foo Gc], so the 'Gc' object itself
+// may or may not be present as the first argument; none of them need it.
+
+//-------------------------------------------------------------------------------------------------
+// Control
+
+SMILE_EXTERNAL_FUNCTION(Enable)
+{
+	GcStats_Enable(True);
+	return SmileArg_From(NullObject);
+}
+
+SMILE_EXTERNAL_FUNCTION(Disable)
+{
+	GcStats_Enable(False);
+	return SmileArg_From(NullObject);
+}
+
+SMILE_EXTERNAL_FUNCTION(IsEnabled)
+{
+	return SmileUnboxedBool_From(GcStats_Enabled);
+}
+
+SMILE_EXTERNAL_FUNCTION(Reset)
+{
+	GcStats_Reset();
+	return SmileArg_From(NullObject);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Collection callbacks
+
+typedef struct FinalizeInfoStruct {
+	Int count;
+	Bool returnCount;
+} *FinalizeInfo;
+
+/// <summary>
+/// Invoke each pending on-collect callback in turn, without recursing on the C stack.  Callbacks
+/// that become pending while this is running (say, because a callback allocates enough to cause
+/// another collection) are run too.
+/// </summary>
+static Int FinalizeStateMachine(ClosureStateMachine closure)
+{
+	FinalizeInfo finalizeInfo = (FinalizeInfo)closure->state;
+	OnCollectRecord record;
+	Int minArgs, maxArgs;
+
+	Closure_Pop(closure);	// Pop the previous return value.
+
+	if ((record = OnCollect_Dequeue()) == NULL) {
+		if (finalizeInfo->returnCount)
+			Closure_PushUnboxedInt64(closure, finalizeInfo->count);
+		else
+			Closure_PushBoxed(closure, NullObject);
+		return -1;
+	}
+
+	finalizeInfo->count++;
+
+	SmileFunction_GetArgCounts(record->fn, &minArgs, &maxArgs);
+	Closure_PushBoxed(closure, record->fn);
+	if (maxArgs < 1)
+		return 0;
+	Closure_PushBoxed(closure, record->obj);
+	return 1;
+}
+
+static SmileArg StartFinalizing(Bool returnCount)
+{
+	ClosureStateMachine closure = Eval_BeginStateMachine(FinalizeStateMachine, FinalizeStateMachine);
+	FinalizeInfo finalizeInfo = (FinalizeInfo)closure->state;
+
+	finalizeInfo->count = 0;
+	finalizeInfo->returnCount = returnCount;
+
+	Closure_PushBoxed(closure, NullObject);	// Initial "return" value.
+
+	return (SmileArg){ NULL };	// We have to return something, but this value will be ignored.
+}
+
+/// <summary>
+/// Run every pending on-collect callback now, in a nested evaluation.  The interpreter calls this
+/// from its safe points (backward branches, and the end of an evaluation), so that callbacks run
+/// even if the program never calls [Gc.collect] or [Gc.finalize].  If a callback throws, the
+/// exception propagates from here.
+/// </summary>
+void OnCollect_RunPending(void)
+{
+	static Bool running = False;
+	struct EvalStateStruct evalState;
+	ClosureStateMachine closure;
+	FinalizeInfo finalizeInfo;
+	EvalResult evalResult;
+
+	// The outer run will pick up anything that becomes pending while it is running.
+	if (running) return;
+	running = True;
+
+	Eval_BeforeRecurse(&evalState);
+
+	closure = Eval_BeginDetachedStateMachine(FinalizeStateMachine, FinalizeStateMachine);
+	finalizeInfo = (FinalizeInfo)closure->state;
+	finalizeInfo->count = 0;
+	finalizeInfo->returnCount = False;
+	Closure_PushBoxed(closure, NullObject);	// Initial "return" value.
+
+	evalResult = Eval_Continue();
+
+	Eval_AfterRecurse(&evalState);
+	running = False;
+
+	if (evalResult->evalResultKind == EVAL_RESULT_EXCEPTION)
+		Smile_Throw(evalResult->exception);
+}
+
+/// <summary>
+/// [Gc.on-collect obj fn] arranges for [fn obj] to be called once 'obj' has become unreachable.
+/// The call doesn't happen inside the collector; it happens at the interpreter's next safe point,
+/// or the next time [Gc.collect] or [Gc.finalize] is invoked.  Returns 'obj'.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(OnCollect)
+{
+	SmileObject obj = argv[argc - 2].obj;
+	SmileObject fn = argv[argc - 1].obj;
+
+	if (SMILE_KIND(fn) != SMILE_KIND_FUNCTION) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_FromC("The last argument to 'Gc.on-collect' must be a function."));
+	}
+	if (SMILE_KIND(obj) <= SMILE_KIND_UNBOXED_MAX || !OnCollect_Register(obj, (SmileFunction)fn)) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_FromC("'Gc.on-collect' requires a collectable object that has no native finalizer of its own."));
+	}
+
+	return argv[argc - 2];
+}
+
+/// <summary>
+/// [Gc.finalize] runs any pending on-collect callbacks, and returns how many it ran.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(Finalize)
+{
+	return StartFinalizing(True);
+}
+
+/// <summary>
+/// [Gc.pending-finalizers] returns the number of on-collect callbacks waiting to be run.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(PendingFinalizers)
+{
+	return SmileUnboxedInteger64_From((Int64)OnCollect_NumPending());
+}
+
+/// <summary>
+/// [Gc.collect] runs a full collection, and then runs any on-collect callbacks for the
+/// objects it freed.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(Collect)
+{
+	GcStats_Collect();
+	return StartFinalizing(False);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Telemetry
+//
+// The pause figures only include the collections run by [Gc.collect]; see
+// GcStats_Collect() for why the collector's own collections can't be timed.
+
+SMILE_EXTERNAL_FUNCTION(Collections)
+{
+	struct GcStatsStruct stats;
+	GcStats_Get(&stats);
+	return SmileUnboxedInteger64_From((Int64)stats.numCollections);
+}
+
+SMILE_EXTERNAL_FUNCTION(PauseMs)
+{
+	struct GcStatsStruct stats;
+	GcStats_Get(&stats);
+	return SmileUnboxedInteger64_From((Int64)Smile_TicksToMilliseconds(stats.totalPauseTicks));
+}
+
+SMILE_EXTERNAL_FUNCTION(MaxPauseMs)
+{
+	struct GcStatsStruct stats;
+	GcStats_Get(&stats);
+	return SmileUnboxedInteger64_From((Int64)Smile_TicksToMilliseconds(stats.maxPauseTicks));
+}
+
+SMILE_EXTERNAL_FUNCTION(HeapSize)
+{
+	struct GcStatsStruct stats;
+	GcStats_Get(&stats);
+	return SmileUnboxedInteger64_From((Int64)stats.heapSize);
+}
+
+SMILE_EXTERNAL_FUNCTION(LiveBytes)
+{
+	struct GcStatsStruct stats;
+	GcStats_Get(&stats);
+	return SmileUnboxedInteger64_From((Int64)stats.liveBytes);
+}
+
+/// <summary>
+/// [Gc.allocations] returns the total number of objects allocated; [Gc.allocations "List"]
+/// returns the number allocated of just the named kind.
+/// </summary>
+static Int64 CountAllocations(Int argc, SmileArg *argv, Bool bytes)
+{
+	struct GcStatsStruct stats;
+	String kindName;
+	Int i;
+
+	GcStats_Get(&stats);
+
+	if (argc < 1 || SMILE_KIND(argv[argc - 1].obj) != SMILE_KIND_STRING)
+		return (Int64)(bytes ? stats.totalAllocationBytes : stats.totalAllocationCount);
+
+	kindName = (String)argv[argc - 1].obj;
+	for (i = 0; i < GCSTATS_NUM_KINDS; i++) {
+		if (String_Equals(SmileKind_GetName(i), kindName))
+			return (Int64)(bytes ? stats.allocationBytes[i] : stats.allocationCounts[i]);
+	}
+
+	return 0;
+}
+
+SMILE_EXTERNAL_FUNCTION(Allocations)
+{
+	return SmileUnboxedInteger64_From(CountAllocations(argc, argv, False));
+}
+
+SMILE_EXTERNAL_FUNCTION(AllocatedBytes)
+{
+	return SmileUnboxedInteger64_From(CountAllocations(argc, argv, True));
+}
+
+SMILE_EXTERNAL_FUNCTION(Report)
+{
+	struct GcStatsStruct stats;
+	GcStats_Get(&stats);
+	return SmileArg_From((SmileObject)GcStats_ToString(&stats));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Heap census
+
+/// <summary>
+/// [Gc.census] walks the heap and returns the census report as a string; [Gc.census "file"]
+/// writes the report to the given file instead, and returns whether that succeeded.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(Census)
+{
+	HeapCensus census = HeapCensus_Take(HEAPCENSUS_DEFAULT_RETAINERS);
+
+	if (argc < 1 || SMILE_KIND(argv[argc - 1].obj) != SMILE_KIND_STRING)
+		return SmileArg_From((SmileObject)HeapCensus_ToString(census));
+
+	return SmileUnboxedBool_From(HeapCensus_WriteToFile(census, (String)argv[argc - 1].obj));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Symbols
+
+/// <summary>
+/// [Gc.collect-symbols] sweeps the symbol table now, rather than waiting for enough collectable
+/// symbols to pile up, and returns how many symbols were reclaimed.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(CollectSymbols)
+{
+	return SmileUnboxedInteger64_From(HeapCensus_CollectSymbols(Smile_SymbolTable));
+}
+
+/// <summary>
+/// [Gc.collectable-symbols] returns how many symbols in the symbol table could be reclaimed
+/// by a sweep, if nothing referred to them.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(CollectableSymbols)
+{
+	return SmileUnboxedInteger64_From(((struct SymbolTableInt *)Smile_SymbolTable)->numCollectable);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void GcStats_Setup(SmileUserObject base)
+{
+	SetupFunction("enable", Enable, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("disable", Disable, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("enabled?", IsEnabled, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("reset", Reset, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("collect", Collect, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_STATE_MACHINE, 0, 1, 0, NULL);
+
+	SetupFunction("collections", Collections, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("pause-ms", PauseMs, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("max-pause-ms", MaxPauseMs, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("heap-size", HeapSize, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("live-bytes", LiveBytes, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("allocations", Allocations, NULL, "gc kind", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 2, 0, NULL);
+	SetupFunction("allocated-bytes", AllocatedBytes, NULL, "gc kind", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 2, 0, NULL);
+	SetupFunction("report", Report, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+
+	SetupFunction("on-collect", OnCollect, NULL, "gc obj fn", ARG_CHECK_MIN | ARG_CHECK_MAX, 2, 3, 0, NULL);
+	SetupFunction("finalize", Finalize, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_STATE_MACHINE, 0, 1, 0, NULL);
+	SetupFunction("pending-finalizers", PendingFinalizers, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+
+	SetupFunction("census", Census, NULL, "gc filename", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 2, 0, NULL);
+
+	SetupFunction("collect-symbols", CollectSymbols, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+	SetupFunction("collectable-symbols", CollectableSymbols, NULL, "gc", ARG_CHECK_MIN | ARG_CHECK_MAX, 0, 1, 0, NULL);
+}
@@ -53,6 +53,7 @@ void Smile_InitCommonGlobals(ClosureInfo globalClosureInfo)
 	DeclareCommonGlobal(Smile_KnownSymbols.Integer32_,			Smile_KnownBases.Integer32);
 	DeclareCommonGlobal(Smile_KnownSymbols.Integer64_,			Smile_KnownBases.Integer64);
 	DeclareCommonGlobal(Smile_KnownSymbols.Integer_,			Smile_KnownBases.Integer64);
+	DeclareCommonGlobal(Smile_KnownSymbols.BigInt_,				Smile_KnownBases.BigInt);
 
 	DeclareCommonGlobal(Smile_KnownSymbols.RealBase_,			Smile_KnownBases.RealBase);
 	DeclareCommonGlobal(Smile_KnownSymbols.Real32_,				Smile_KnownBases.Real32);
@@ -76,8 +77,12 @@ void Smile_InitCommonGlobals(ClosureInfo globalClosureInfo)
 	DeclareCommonGlobal(Smile_KnownSymbols.Symbol_,				Smile_KnownBases.Symbol);
 	DeclareCommonGlobal(Smile_KnownSymbols.Exception_,			Smile_KnownBases.Exception);
 	DeclareCommonGlobal(Smile_KnownSymbols.Timestamp_,			Smile_KnownBases.Timestamp);
+	DeclareCommonGlobal(Smile_KnownSymbols.Gc_,					Smile_KnownBases.Gc);
 	DeclareCommonGlobal(Smile_KnownSymbols.Regex_,				Smile_KnownBases.Regex);
 	DeclareCommonGlobal(Smile_KnownSymbols.RegexMatch_,			Smile_KnownBases.RegexMatch);
+	DeclareCommonGlobal(Smile_KnownSymbols.StringBuilder_,		Smile_KnownBases.StringBuilder);
+	DeclareCommonGlobal(Smile_KnownSymbols.WeakRef_,			Smile_KnownBases.WeakRef);
+	DeclareCommonGlobal(Smile_KnownSymbols.WeakMap_,			Smile_KnownBases.WeakMap);
 
 	DeclareCommonGlobal(Smile_KnownSymbols.Range_,				Smile_KnownBases.Range);
 	DeclareCommonGlobal(Smile_KnownSymbols.CharRange_,			Smile_KnownBases.CharRange);
@@ -97,6 +102,10 @@ void Smile_InitCommonGlobals(ClosureInfo globalClosureInfo)
 	DeclareCommonGlobal(Smile_KnownSymbols.FloatRangeBase_,		Smile_KnownBases.FloatRangeBase);
 
 	DeclareCommonGlobal(Smile_KnownSymbols.ByteArray_,			Smile_KnownBases.ByteArray);
+	DeclareCommonGlobal(Smile_KnownSymbols.Integer32Array_,		Smile_KnownBases.Integer32Array);
+	DeclareCommonGlobal(Smile_KnownSymbols.Integer64Array_,		Smile_KnownBases.Integer64Array);
+	DeclareCommonGlobal(Smile_KnownSymbols.Float32Array_,		Smile_KnownBases.Float32Array);
+	DeclareCommonGlobal(Smile_KnownSymbols.Float64Array_,		Smile_KnownBases.Float64Array);
 
 	DeclareCommonGlobal(Smile_KnownSymbols.true_,				Smile_KnownObjects.TrueObj);
 	DeclareCommonGlobal(Smile_KnownSymbols.false_,				Smile_KnownObjects.FalseObj);
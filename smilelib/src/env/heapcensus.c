@@ -0,0 +1,1233 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <smile/types.h>
+#include <smile/gc.h>
+#include <smile/stringbuilder.h>
+#include <smile/dict/int32dict.h>
+#include <smile/dict/vardict.h>
+#include <smile/dict/stringintdict.h>
+#include <smile/env/env.h>
+#include <smile/env/heapcensus.h>
+#include <smile/env/modules.h>
+#include <smile/env/symboltable.h>
+#include <smile/env/knownsymbols.h>
+#include <smile/env/weakref.h>
+#include <smile/eval/closure.h>
+#include <smile/eval/eval.h>
+#include <smile/parsing/parsemessage.h>
+#include <smile/regex.h>
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilefunction.h>
+#include <smile/smiletypes/smilecell.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/smiletypes/smilehandle.h>
+#include <smile/smiletypes/smiletillcontinuation.h>
+#include <smile/smiletypes/smilesyntax.h>
+#include <smile/smiletypes/smileloanword.h>
+#include <smile/smiletypes/raw/smilebytearray.h>
+#include <smile/smiletypes/raw/smileinteger32array.h>
+#include <smile/smiletypes/raw/smileinteger64array.h>
+#include <smile/smiletypes/raw/smilefloat32array.h>
+#include <smile/smiletypes/raw/smilefloat64array.h>
+
+extern Closure _closure;
+
+//-------------------------------------------------------------------------------------------------
+// The census is taken in three passes:
+//
+//   1. Walk the reference graph depth-first from a virtual root, whose children are the real
+//      roots (the global variables, the loaded modules, the known objects and bases, the
+//      symbol table, the current closure chain and any suspended ones, and the functions and
+//      objects waiting on on-collect callbacks).  This records every reachable object once,
+//      along with its outgoing edges and its place in the DFS spanning tree.
+//
+//   2. Compute the immediate dominator of every node (the one node that every path from the
+//      roots to it must pass through last).  An object's retained size is then the sum of the
+//      sizes of every object it dominates.
+//
+//   3. Summarize the nodes by group, and pick out the largest individual retainers.
+//
+// None of the census's own bookkeeping contains pointers the collector needs to see (every
+// object it records is reachable from the roots anyway), so it's all allocated as atomic data.
+//
+// The symbol table's sweep (HeapCensus_CollectSymbols) reuses pass 1 to find every symbol that
+// the heap still refers to.  Symbols are plain integers, and not all of the heap has type
+// information, so the sweep is more cautious than the census:  It follows weak references as
+// though they were strong, and it scans state machines' private state (and every block reached
+// from it) conservatively, treating each word as a possible pointer and each 32-bit half-word
+// as a possible symbol.  Keeping a symbol too long is harmless; reclaiming one too soon is not.
+
+#define NODE_ROOT			0	// The virtual root, whose children are the root categories.
+#define NODE_ROOT_GLOBALS	1	// The global variables.
+#define NODE_ROOT_MODULES	2	// The loaded modules.
+#define NODE_ROOT_KNOWN		3	// The known objects and known bases.
+#define NODE_ROOT_SYMBOLS	4	// The names in the symbol table.
+#define NODE_ROOT_STACK		5	// The current closure and everything it can return to, and any suspended evaluations.
+#define NODE_ROOT_FINALIZERS	6	// The callbacks registered by Gc.on-collect, and their objects.
+#define NODE_NUM_ROOTS		7
+#define NODE_OBJECT			7	// A SmileObject.
+#define NODE_CLOSURE		8	// A Closure.
+#define NODE_BLOCK			9	// A GC block of unknown type (only found when sweeping symbols).
+
+#define MAX_PATH_SEGMENTS	8
+
+static const char *_rootNames[] = {
+	"<root>", "<globals>", "<modules>", "<known>", "<symbols>", "<stack>", "<finalizers>",
+};
+
+typedef struct CensusNodeStruct {
+	void *ptr;					// The object (or closure) this node represents.
+	Int32 type;					// What kind of node this is (one of the NODE_* values).
+	Int32 group;				// Which group this node belongs to (-1 for the root nodes).
+	Int32 firstEdge;			// The index of this node's first outgoing edge.
+	Int32 numEdges;				// The number of outgoing edges.
+	Int32 parent;				// The node this one was first discovered from.
+	Symbol label;				// The name of the variable or property this node was discovered through, if any.
+	Int32 preorder;				// This node's DFS preorder number.
+	Int32 treeParent;			// This node's parent in the DFS spanning tree.
+	Int32 idom;					// This node's immediate dominator.
+	UInt64 shallowBytes;		// The size of this node's object.
+	UInt64 retainedBytes;		// The size of everything this node dominates, including itself.
+	UInt64 retainedCount;		// The number of nodes this node dominates, including itself.
+} *CensusNode;
+
+typedef struct CensusStruct {
+	CensusNode nodes;
+	Int32 numNodes, maxNodes;
+
+	Int32 *edges;
+	Int32 numEdges, maxEdges;
+
+	Int32 *table;				// Open-addressed hash table of node indexes, keyed by pointer.
+	Int32 tableMask;
+
+	SymbolTable symbolTable;	// When sweeping, the symbol table whose symbols are marked as they're found.
+
+	Int32 current;				// The node whose edges are being enumerated.
+
+	Int32 kindGroups[256];		// Group indexes for each SMILE_KIND (-1 if not yet assigned).
+	struct Int32DictInt classGroups;	// Group indexes for user objects, keyed by class-name symbol.
+	StringIntDict groupNames;	// Group indexes, keyed by name.
+	struct HeapCensusGroupStruct *groups;
+	Int32 numGroups, maxGroups;
+} *Census;
+
+//-------------------------------------------------------------------------------------------------
+// Groups.
+
+static Int32 AddGroup(Census census, String name)
+{
+	Int index;
+
+	if (StringIntDict_TryGetValue(census->groupNames, name, &index))
+		return (Int32)index;
+
+	if (census->numGroups >= census->maxGroups) {
+		Int32 newMax = census->maxGroups * 2;
+		struct HeapCensusGroupStruct *newGroups = GC_MALLOC_STRUCT_ARRAY(struct HeapCensusGroupStruct, newMax);
+		if (newGroups == NULL)
+			Smile_Abort_OutOfMemory();
+		MemCpy(newGroups, census->groups, sizeof(struct HeapCensusGroupStruct) * census->numGroups);
+		census->groups = newGroups;
+		census->maxGroups = newMax;
+	}
+
+	index = census->numGroups++;
+	census->groups[index].name = name;
+	census->groups[index].count = 0;
+	census->groups[index].shallowBytes = 0;
+	census->groups[index].retainedBytes = 0;
+
+	StringIntDict_Add(census->groupNames, name, index);
+	return (Int32)index;
+}
+
+/// <summary>
+/// User objects are grouped by their "class," which is the nearest object in their base
+/// chain (including themselves) that has a name.
+/// </summary>
+static Int32 GetUserObjectGroup(Census census, SmileUserObject userObject)
+{
+	SmileObject obj = (SmileObject)userObject;
+	Symbol className = 0;
+	void *value;
+	Int depth;
+
+	for (depth = 0; depth < 64 && obj != NULL && SMILE_KIND(obj) == SMILE_KIND_USEROBJECT; depth++) {
+		if (((SmileUserObject)obj)->name) {
+			className = ((SmileUserObject)obj)->name;
+			break;
+		}
+		obj = obj->base;
+	}
+
+	if (Int32Dict_TryGetValue((Int32Dict)&census->classGroups, className, &value))
+		return (Int32)(PtrInt)value;
+
+	{
+		Int32 group = AddGroup(census, className
+			? String_Concat(String_FromC("Object:"), SymbolTable_GetName(Smile_SymbolTable, className))
+			: String_FromC("Object"));
+		Int32Dict_Add((Int32Dict)&census->classGroups, className, (void *)(PtrInt)group);
+		return group;
+	}
+}
+
+static Int32 GetGroup(Census census, Int32 type, void *ptr)
+{
+	Int kind;
+
+	if (type == NODE_CLOSURE)
+		kind = SMILE_KIND_CLOSURE;
+	else {
+		kind = SMILE_KIND((SmileObject)ptr);
+		if (kind == SMILE_KIND_USEROBJECT)
+			return GetUserObjectGroup(census, (SmileUserObject)ptr);
+	}
+
+	if (census->kindGroups[kind] < 0)
+		census->kindGroups[kind] = AddGroup(census, SmileKind_GetName(kind));
+	return census->kindGroups[kind];
+}
+
+//-------------------------------------------------------------------------------------------------
+// Nodes and edges.
+
+/// <summary>
+/// The size of the GC block at the given address, or zero if it isn't the start of a GC block
+/// (static objects and interior pointers don't count against the heap).
+/// </summary>
+Inline UInt64 BlockSize(const void *ptr)
+{
+	return ptr != NULL && GC_base((void *)ptr) == ptr ? (UInt64)GC_size((void *)ptr) : 0;
+}
+
+static UInt64 GetShallowSize(Int32 type, void *ptr)
+{
+	UInt64 size = BlockSize(ptr);
+	SmileObject obj = (SmileObject)ptr;
+
+	if (type != NODE_OBJECT) return size;
+
+	// Several kinds of object keep their data in separate blocks that belong to them alone.
+	switch (SMILE_KIND(obj)) {
+
+		case SMILE_KIND_USEROBJECT:
+			size += BlockSize(((SmileUserObject)obj)->dict.buckets) + BlockSize(((SmileUserObject)obj)->dict.heap);
+			break;
+
+		case SMILE_KIND_BYTEARRAY:
+			size += BlockSize(((SmileByteArray)obj)->data);
+			break;
+
+		// A view's elements belong to its ByteArray, so count them only once, there.
+		case SMILE_KIND_INTEGER32ARRAY:
+			if (((SmileInteger32Array)obj)->byteArray == NULL)
+				size += BlockSize(((SmileInteger32Array)obj)->data);
+			break;
+		case SMILE_KIND_INTEGER64ARRAY:
+			if (((SmileInteger64Array)obj)->byteArray == NULL)
+				size += BlockSize(((SmileInteger64Array)obj)->data);
+			break;
+		case SMILE_KIND_FLOAT32ARRAY:
+			if (((SmileFloat32Array)obj)->byteArray == NULL)
+				size += BlockSize(((SmileFloat32Array)obj)->data);
+			break;
+		case SMILE_KIND_FLOAT64ARRAY:
+			if (((SmileFloat64Array)obj)->byteArray == NULL)
+				size += BlockSize(((SmileFloat64Array)obj)->data);
+			break;
+
+		case SMILE_KIND_NONTERMINAL:
+			size += BlockSize(((SmileNonterminal)obj)->withSymbols);
+			break;
+
+		case SMILE_KIND_HANDLE:
+			size += BlockSize(((SmileHandle)obj)->ptr);
+			if (((SmileHandle)obj)->handleKind == Smile_KnownSymbols.WeakMap_) {
+				WeakMap weakMap = (WeakMap)((SmileHandle)obj)->ptr;
+				size += BlockSize(weakMap->states) + BlockSize(weakMap->keys) + BlockSize(weakMap->values);
+			}
+			break;
+	}
+
+	return size;
+}
+
+Inline UInt32 HashPointer(const void *ptr)
+{
+	UInt64 value = (UInt64)(PtrInt)ptr;
+	value = (value >> 3) * 0x9E3779B97F4A7C15ULL;
+	return (UInt32)(value >> 32);
+}
+
+static void GrowTable(Census census)
+{
+	Int32 newMask = census->tableMask * 2 + 1;
+	Int32 *newTable = GC_MALLOC_RAW_ARRAY(Int32, newMask + 1);
+	Int32 i, slot;
+
+	if (newTable == NULL)
+		Smile_Abort_OutOfMemory();
+	MemSet(newTable, 0xFF, sizeof(Int32) * (newMask + 1));
+
+	for (i = 0; i < census->numNodes; i++) {
+		if (census->nodes[i].ptr == NULL) continue;
+		slot = (Int32)(HashPointer(census->nodes[i].ptr) & newMask);
+		while (newTable[slot] >= 0)
+			slot = (slot + 1) & newMask;
+		newTable[slot] = i;
+	}
+
+	census->table = newTable;
+	census->tableMask = newMask;
+}
+
+static Int32 CreateNode(Census census, Int32 type, void *ptr)
+{
+	CensusNode node;
+	Int32 index;
+
+	if (census->numNodes >= census->maxNodes) {
+		Int32 newMax = census->maxNodes * 2;
+		CensusNode newNodes = GC_MALLOC_RAW_ARRAY(struct CensusNodeStruct, newMax);
+		if (newNodes == NULL)
+			Smile_Abort_OutOfMemory();
+		MemCpy(newNodes, census->nodes, sizeof(struct CensusNodeStruct) * census->numNodes);
+		census->nodes = newNodes;
+		census->maxNodes = newMax;
+	}
+
+	index = census->numNodes++;
+	node = &census->nodes[index];
+	node->ptr = ptr;
+	node->type = type;
+	node->group = type >= NODE_NUM_ROOTS && census->symbolTable == NULL ? GetGroup(census, type, ptr) : -1;
+	node->firstEdge = 0;
+	node->numEdges = 0;
+	node->parent = census->current;
+	node->label = 0;
+	node->preorder = -1;
+	node->treeParent = -1;
+	node->idom = -1;
+	node->shallowBytes = type >= NODE_NUM_ROOTS && census->symbolTable == NULL ? GetShallowSize(type, ptr) : 0;
+	node->retainedBytes = 0;
+	node->retainedCount = 0;
+	return index;
+}
+
+static void AppendEdge(Census census, Int32 target)
+{
+	if (census->numEdges >= census->maxEdges) {
+		Int32 newMax = census->maxEdges * 2;
+		Int32 *newEdges = GC_MALLOC_RAW_ARRAY(Int32, newMax);
+		if (newEdges == NULL)
+			Smile_Abort_OutOfMemory();
+		MemCpy(newEdges, census->edges, sizeof(Int32) * census->numEdges);
+		census->edges = newEdges;
+		census->maxEdges = newMax;
+	}
+
+	census->edges[census->numEdges++] = target;
+	census->nodes[census->current].numEdges++;
+}
+
+/// <summary>
+/// Add an edge from the current node to the given object or closure, creating a node for it
+/// if this is the first time it has been seen.
+/// </summary>
+static void AddEdge(Census census, Int32 type, void *ptr, Symbol label)
+{
+	Int32 slot, index;
+
+	if (ptr == NULL) return;
+
+	// Unboxed values aren't heap objects; they just borrow a static object for their kind.
+	if (type == NODE_OBJECT && (SMILE_KIND((SmileObject)ptr) & SMILE_KIND_MASK) <= SMILE_KIND_UNBOXED_MAX)
+		return;
+
+	// A word of unknown type is only worth following if it's exactly the start of a GC block.
+	if (type == NODE_BLOCK && BlockSize(ptr) == 0)
+		return;
+
+	slot = (Int32)(HashPointer(ptr) & census->tableMask);
+	while ((index = census->table[slot]) >= 0) {
+		if (census->nodes[index].ptr == ptr) {
+			AppendEdge(census, index);
+			return;
+		}
+		slot = (slot + 1) & census->tableMask;
+	}
+
+	index = CreateNode(census, type, ptr);
+	census->nodes[index].label = label;
+	census->table[slot] = index;
+	AppendEdge(census, index);
+
+	if (census->numNodes * 2 > census->tableMask)
+		GrowTable(census);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Symbol marking (only when sweeping the symbol table).
+
+Inline void MarkSymbol(Census census, Symbol symbol)
+{
+	if (census->symbolTable != NULL)
+		SymbolTable_MarkSymbol(census->symbolTable, symbol);
+}
+
+/// <summary>
+/// Conservatively mark every 32-bit half-word in the given memory as a symbol.
+/// </summary>
+static void MarkSymbolsInMemory(Census census, const void *ptr, Int size)
+{
+	const Int32 *words = (const Int32 *)ptr;
+	Int i, count = size / sizeof(Int32);
+
+	for (i = 0; i < count; i++)
+		SymbolTable_MarkSymbol(census->symbolTable, (Symbol)words[i]);
+}
+
+static void MarkObjectSymbols(Census census, SmileObject obj)
+{
+	SmileArg value;
+
+	switch (SMILE_KIND(obj)) {
+
+		case SMILE_KIND_SYMBOL:
+			MarkSymbol(census, ((SmileSymbol)obj)->symbol);
+			break;
+
+		case SMILE_KIND_USEROBJECT:
+			// The property names are marked as the properties are enumerated.
+			MarkSymbol(census, ((SmileUserObject)obj)->name);
+			break;
+
+		case SMILE_KIND_CELL:
+			value = SmileCell_GetValue((SmileCell)obj);
+			if (SMILE_KIND(value.obj) == SMILE_KIND_UNBOXED_SYMBOL)
+				MarkSymbol(census, value.unboxed.symbol);
+			break;
+
+		case SMILE_KIND_SYNTAX:
+		case SMILE_KIND_NONTERMINAL:
+		case SMILE_KIND_LOANWORD:
+		case SMILE_KIND_PARSEDECL:
+			// The parser's objects are rare, and full of symbols; just scan them.
+			MarkSymbolsInMemory(census, obj, (Int)BlockSize(obj));
+			break;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Edge enumeration.
+
+static Bool AddVarInfoEdge(VarInfo varInfo, void *param)
+{
+	MarkSymbol((Census)param, varInfo->symbol);
+	AddEdge((Census)param, NODE_OBJECT, varInfo->value, varInfo->symbol);
+	return True;
+}
+
+static Bool AddPropertyEdge(Int32 key, void *value, void *param)
+{
+	MarkSymbol((Census)param, (Symbol)key);
+	AddEdge((Census)param, NODE_OBJECT, value, (Symbol)key);
+	return True;
+}
+
+static void AddArgEdge(Census census, SmileArg *arg, Symbol label)
+{
+	if (arg->obj != NULL && SMILE_KIND(arg->obj) == SMILE_KIND_UNBOXED_SYMBOL)
+		MarkSymbol(census, arg->unboxed.symbol);
+	else
+		AddEdge(census, NODE_OBJECT, arg->obj, label);
+}
+
+/// <summary>
+/// Follow every word in a block of unknown type that might be a pointer to another block,
+/// and mark every half-word that might be a symbol.
+/// </summary>
+static void AddBlockEdges(Census census, void *ptr)
+{
+	PtrInt *words = (PtrInt *)ptr;
+	Int i, size = (Int)BlockSize(ptr);
+
+	MarkSymbolsInMemory(census, ptr, size);
+
+	for (i = 0; i < size / (Int)sizeof(PtrInt); i++)
+		AddEdge(census, NODE_BLOCK, (void *)words[i], 0);
+}
+
+/// <summary>
+/// State machines have no ClosureInfo:  They keep up to 16 ordinary variables inline, and then
+/// some private state that only their own C code knows the shape of.
+/// </summary>
+static void AddStateMachineEdges(Census census, ClosureStateMachine closure)
+{
+	Int i, count;
+	PtrInt *words;
+
+	count = closure->stackTop != NULL ? closure->stackTop - closure->variables : 0;
+	if (count < 0) count = 0;
+	if (count > 16) count = 16;
+
+	for (i = 0; i < count; i++)
+		AddArgEdge(census, &closure->variables[i], 0);
+
+	if (census->symbolTable == NULL) return;
+
+	MarkSymbolsInMemory(census, closure->state, sizeof(closure->state));
+
+	words = (PtrInt *)closure->state;
+	for (i = 0; i < (Int)(sizeof(closure->state) / sizeof(PtrInt)); i++)
+		AddEdge(census, NODE_BLOCK, (void *)words[i], 0);
+}
+
+static void AddClosureEdges(Census census, Closure closure)
+{
+	ClosureInfo closureInfo = closure->closureInfo;
+	Int i, count, max;
+
+	AddEdge(census, NODE_CLOSURE, closure->parent, 0);
+	AddEdge(census, NODE_CLOSURE, closure->global, 0);
+	AddEdge(census, NODE_CLOSURE, closure->returnClosure, 0);
+
+	if (closureInfo == NULL) {
+		AddStateMachineEdges(census, (ClosureStateMachine)closure);
+		return;
+	}
+
+	if (closureInfo->kind == CLOSURE_KIND_GLOBAL) {
+		// Global closures keep their variables in their info's dictionary.
+		if (closureInfo->variableDictionary != NULL)
+			VarDict_ForEach(closureInfo->variableDictionary, AddVarInfoEdge, census);
+		return;
+	}
+
+	// Local closures keep their variables, and then their temporaries, inline.
+	max = closureInfo->numVariables + closureInfo->tempSize;
+	count = closure->stackTop != NULL ? closure->stackTop - closure->variables : closureInfo->numVariables;
+	if (count < 0) count = 0;
+	if (count > max) count = max;
+
+	for (i = 0; i < count; i++) {
+		AddArgEdge(census, &closure->variables[i],
+			i < closureInfo->numVariables && closureInfo->variableNames != NULL ? closureInfo->variableNames[i] : 0);
+	}
+}
+
+static void AddHandleEdges(Census census, SmileHandle handle)
+{
+	Symbol handleKind = handle->handleKind;
+	Int i;
+
+	if (handle->ptr == NULL) return;
+
+	// Handles are opaque, so we can only follow the ones whose data we know the shape of.
+	// Weak references (and a weak map's keys) deliberately don't count as edges in a census,
+	// but a sweep must follow them, since their targets may still be handed back to scripts.
+	if (handleKind == Smile_KnownSymbols.Regex_) {
+		Regex regex = (Regex)handle->ptr;
+		AddEdge(census, NODE_OBJECT, regex->pattern, 0);
+		AddEdge(census, NODE_OBJECT, regex->flags, 0);
+	}
+	else if (handleKind == Smile_KnownSymbols.RegexMatch_) {
+		RegexMatch match = (RegexMatch)handle->ptr;
+		AddEdge(census, NODE_OBJECT, match->input, 0);
+		AddEdge(census, NODE_OBJECT, match->errorMessage, 0);
+	}
+	else if (handleKind == Smile_KnownSymbols.WeakMap_) {
+		WeakMap weakMap = (WeakMap)handle->ptr;
+		for (i = 0; i <= weakMap->mask; i++) {
+			if (weakMap->states[i] == WEAKMAP_SLOT_LIVE && weakMap->keys[i] != NULL) {
+				if (census->symbolTable != NULL)
+					AddEdge(census, NODE_OBJECT, weakMap->keys[i], 0);
+				AddEdge(census, NODE_OBJECT, weakMap->values[i], 0);
+			}
+		}
+	}
+	else if (census->symbolTable != NULL) {
+		AddEdge(census, NODE_BLOCK, handle->ptr, 0);
+	}
+}
+
+static void AddObjectEdges(Census census, SmileObject obj)
+{
+	if (census->symbolTable != NULL)
+		MarkObjectSymbols(census, obj);
+
+	AddEdge(census, NODE_OBJECT, obj->base, 0);
+
+	switch (SMILE_KIND(obj)) {
+
+		case SMILE_KIND_LIST:
+			AddEdge(census, NODE_OBJECT, ((SmileList)obj)->a, 0);
+			AddEdge(census, NODE_OBJECT, ((SmileList)obj)->d, 0);
+			break;
+
+		case SMILE_KIND_USEROBJECT:
+			AddEdge(census, NODE_OBJECT, ((SmileUserObject)obj)->securityKey, 0);
+			Int32Dict_ForEach((Int32Dict)&((SmileUserObject)obj)->dict, AddPropertyEdge, census);
+			break;
+
+		case SMILE_KIND_FUNCTION:
+			if (!SmileFunction_IsBuiltIn((SmileFunction)obj))
+				AddEdge(census, NODE_CLOSURE, ((SmileFunction)obj)->u.u.declaringClosure, 0);
+			break;
+
+		case SMILE_KIND_CELL:
+			AddEdge(census, NODE_OBJECT, SmileCell_GetReferencedObject((SmileCell)obj), 0);
+			break;
+
+		case SMILE_KIND_TILL_CONTINUATION:
+			AddEdge(census, NODE_CLOSURE, ((SmileTillContinuation)obj)->closure, 0);
+			break;
+
+		case SMILE_KIND_HANDLE:
+			AddHandleEdges(census, (SmileHandle)obj);
+			break;
+
+		case SMILE_KIND_BYTEARRAY:
+			AddEdge(census, NODE_OBJECT, ((SmileByteArray)obj)->securityKey, 0);
+			break;
+
+		case SMILE_KIND_INTEGER32ARRAY:
+			AddEdge(census, NODE_OBJECT, ((SmileInteger32Array)obj)->securityKey, 0);
+			AddEdge(census, NODE_OBJECT, ((SmileInteger32Array)obj)->byteArray, 0);
+			break;
+
+		case SMILE_KIND_INTEGER64ARRAY:
+			AddEdge(census, NODE_OBJECT, ((SmileInteger64Array)obj)->securityKey, 0);
+			AddEdge(census, NODE_OBJECT, ((SmileInteger64Array)obj)->byteArray, 0);
+			break;
+
+		case SMILE_KIND_FLOAT32ARRAY:
+			AddEdge(census, NODE_OBJECT, ((SmileFloat32Array)obj)->securityKey, 0);
+			AddEdge(census, NODE_OBJECT, ((SmileFloat32Array)obj)->byteArray, 0);
+			break;
+
+		case SMILE_KIND_FLOAT64ARRAY:
+			AddEdge(census, NODE_OBJECT, ((SmileFloat64Array)obj)->securityKey, 0);
+			AddEdge(census, NODE_OBJECT, ((SmileFloat64Array)obj)->byteArray, 0);
+			break;
+
+		case SMILE_KIND_SYNTAX:
+			AddEdge(census, NODE_OBJECT, ((SmileSyntax)obj)->pattern, 0);
+			AddEdge(census, NODE_OBJECT, ((SmileSyntax)obj)->replacement, 0);
+			break;
+
+		case SMILE_KIND_LOANWORD:
+			AddEdge(census, NODE_OBJECT, ((SmileLoanword)obj)->replacement, 0);
+			break;
+
+		case SMILE_KIND_PARSEMESSAGE:
+			AddEdge(census, NODE_OBJECT, ((ParseMessage)obj)->message, 0);
+			break;
+	}
+}
+
+static void AddOnCollectEdges(SmileFunction fn, SmileObject obj, void *param)
+{
+	AddEdge((Census)param, NODE_OBJECT, (SmileObject)fn, 0);
+	AddEdge((Census)param, NODE_OBJECT, obj, 0);
+}
+
+static void AddRootEdges(Census census, Int32 type)
+{
+	struct EvalStateStruct *evalState;
+	ClosureInfo globalClosureInfo;
+	ModuleInfo *modules;
+	SmileObject *words;
+	Int i, count;
+
+	switch (type) {
+
+		case NODE_ROOT:
+			for (i = NODE_ROOT_GLOBALS; i < NODE_NUM_ROOTS; i++)
+				AppendEdge(census, CreateNode(census, (Int32)i, NULL));
+			break;
+
+		case NODE_ROOT_STACK:
+			AddEdge(census, NODE_CLOSURE, _closure, 0);
+			for (evalState = Eval_GetSuspendedState(); evalState != NULL; evalState = evalState->outer)
+				AddEdge(census, NODE_CLOSURE, evalState->closure, 0);
+			break;
+
+		case NODE_ROOT_FINALIZERS:
+			OnCollect_ForEach(AddOnCollectEdges, census);
+			break;
+
+		case NODE_ROOT_GLOBALS:
+			globalClosureInfo = Smile_GetGlobalClosureInfo();
+			if (globalClosureInfo != NULL && globalClosureInfo->variableDictionary != NULL)
+				VarDict_ForEach(globalClosureInfo->variableDictionary, AddVarInfoEdge, census);
+			break;
+
+		case NODE_ROOT_MODULES:
+			count = ModuleInfo_GetAllModules(&modules);
+			for (i = 0; i < count; i++) {
+				if (modules[i] == NULL) continue;
+				AddEdge(census, NODE_OBJECT, modules[i]->name, 0);
+				AddEdge(census, NODE_OBJECT, modules[i]->expr, 0);
+				AddEdge(census, NODE_CLOSURE, modules[i]->closure, 0);
+				if (modules[i]->exportDict != NULL)
+					VarDict_ForEach(modules[i]->exportDict, AddVarInfoEdge, census);
+			}
+			break;
+
+		case NODE_ROOT_KNOWN:
+			// Both of these structs consist of nothing but object pointers.
+			words = (SmileObject *)&Smile_KnownObjects;
+			count = sizeof(Smile_KnownObjects) / sizeof(SmileObject);
+			for (i = 0; i < count; i++)
+				AddEdge(census, NODE_OBJECT, words[i], 0);
+			words = (SmileObject *)&Smile_KnownBases;
+			count = sizeof(Smile_KnownBases) / sizeof(SmileObject);
+			for (i = 0; i < count; i++)
+				AddEdge(census, NODE_OBJECT, words[i], 0);
+			break;
+
+		case NODE_ROOT_SYMBOLS:
+			if (Smile_SymbolTable != NULL) {
+				struct SymbolTableInt *symbolTable = (struct SymbolTableInt *)Smile_SymbolTable;
+				for (i = 1; i < symbolTable->count; i++)
+					AddEdge(census, NODE_OBJECT, symbolTable->symbolNames[i], 0);
+			}
+			break;
+	}
+}
+
+static void AddEdges(Census census, Int32 index)
+{
+	CensusNode node = &census->nodes[index];
+
+	census->current = index;
+	node->firstEdge = census->numEdges;
+
+	switch (node->type) {
+		case NODE_OBJECT:
+			AddObjectEdges(census, (SmileObject)node->ptr);
+			break;
+		case NODE_CLOSURE:
+			AddClosureEdges(census, (Closure)node->ptr);
+			break;
+		case NODE_BLOCK:
+			AddBlockEdges(census, node->ptr);
+			break;
+		default:
+			AddRootEdges(census, node->type);
+			break;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Pass 1: Walk the graph.
+
+static void Walk(Census census)
+{
+	Int32 *stack, *cursors;
+	Int32 sp, maxStack, index, edge, target, preorder;
+
+	maxStack = 1024;
+	stack = GC_MALLOC_RAW_ARRAY(Int32, maxStack);
+	cursors = GC_MALLOC_RAW_ARRAY(Int32, maxStack);
+	if (stack == NULL || cursors == NULL)
+		Smile_Abort_OutOfMemory();
+
+	census->current = 0;
+	CreateNode(census, NODE_ROOT, NULL);
+	census->nodes[0].parent = -1;
+	census->nodes[0].preorder = 0;
+	census->nodes[0].treeParent = -1;
+
+	AddEdges(census, 0);
+	stack[0] = 0;
+	cursors[0] = 0;
+	sp = 1;
+	preorder = 1;
+
+	while (sp > 0) {
+		index = stack[sp - 1];
+		edge = cursors[sp - 1];
+
+		if (edge >= census->nodes[index].numEdges) {
+			sp--;
+			continue;
+		}
+
+		cursors[sp - 1]++;
+		target = census->edges[census->nodes[index].firstEdge + edge];
+		if (census->nodes[target].preorder >= 0)
+			continue;
+
+		// Number the target, and then enumerate its own edges.
+		census->nodes[target].preorder = preorder++;
+		census->nodes[target].treeParent = index;
+		AddEdges(census, target);
+
+		if (sp >= maxStack) {
+			Int32 newMax = maxStack * 2;
+			Int32 *newStack = GC_MALLOC_RAW_ARRAY(Int32, newMax);
+			Int32 *newCursors = GC_MALLOC_RAW_ARRAY(Int32, newMax);
+			if (newStack == NULL || newCursors == NULL)
+				Smile_Abort_OutOfMemory();
+			MemCpy(newStack, stack, sizeof(Int32) * sp);
+			MemCpy(newCursors, cursors, sizeof(Int32) * sp);
+			stack = newStack;
+			cursors = newCursors;
+			maxStack = newMax;
+		}
+		stack[sp] = target;
+		cursors[sp] = 0;
+		sp++;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Pass 2: Dominators and retained sizes.
+//
+// This is the "Semi-NCA" algorithm:  Semidominators are found as in Lengauer and Tarjan's
+// algorithm (with simple path compression), and then each node's immediate dominator is the
+// nearest common ancestor of its DFS-tree parent and its semidominator in the dominator tree
+// built so far.  Everything below works on preorder numbers, not node indexes.
+
+static Int32 Eval(Int32 v, Int32 *ancestor, Int32 *label, Int32 *semi, Int32 *stack)
+{
+	Int32 sp, x, a;
+
+	if (ancestor[v] < 0)
+		return v;
+
+	// Compress the path from v to the root of its tree in the forest, from the top down.
+	sp = 0;
+	for (x = v; ancestor[ancestor[x]] >= 0; x = ancestor[x])
+		stack[sp++] = x;
+	while (sp > 0) {
+		x = stack[--sp];
+		a = ancestor[x];
+		if (semi[label[a]] < semi[label[x]])
+			label[x] = label[a];
+		ancestor[x] = ancestor[a];
+	}
+
+	return label[v];
+}
+
+static void ComputeDominators(Census census)
+{
+	CensusNode nodes = census->nodes;
+	Int32 numNodes = census->numNodes;
+	Int32 *order, *parent, *semi, *label, *ancestor, *idom, *stack, *predStart, *preds;
+	Int32 i, j, v, w, u;
+
+	order = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	parent = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	semi = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	label = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	ancestor = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	idom = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	stack = GC_MALLOC_RAW_ARRAY(Int32, numNodes);
+	predStart = GC_MALLOC_RAW_ARRAY(Int32, numNodes + 1);
+	preds = GC_MALLOC_RAW_ARRAY(Int32, census->numEdges > 0 ? census->numEdges : 1);
+	if (order == NULL || parent == NULL || semi == NULL || label == NULL || ancestor == NULL
+		|| idom == NULL || stack == NULL || predStart == NULL || preds == NULL)
+		Smile_Abort_OutOfMemory();
+
+	for (i = 0; i < numNodes; i++)
+		order[nodes[i].preorder] = i;
+	for (v = 0; v < numNodes; v++) {
+		i = nodes[order[v]].treeParent;
+		parent[v] = i >= 0 ? nodes[i].preorder : -1;
+		semi[v] = v;
+		label[v] = v;
+		ancestor[v] = -1;
+	}
+
+	// Invert the edges, so that each node can find its predecessors.
+	MemZero(predStart, sizeof(Int32) * (numNodes + 1));
+	for (i = 0; i < census->numEdges; i++)
+		predStart[nodes[census->edges[i]].preorder + 1]++;
+	for (v = 0; v < numNodes; v++)
+		predStart[v + 1] += predStart[v];
+	for (i = 0; i < numNodes; i++) {
+		for (j = 0; j < nodes[i].numEdges; j++) {
+			w = nodes[census->edges[nodes[i].firstEdge + j]].preorder;
+			preds[predStart[w]++] = nodes[i].preorder;
+		}
+	}
+	for (v = numNodes; v > 0; v--)
+		predStart[v] = predStart[v - 1];
+	predStart[0] = 0;
+
+	// Find the semidominators, in reverse preorder.
+	for (w = numNodes - 1; w > 0; w--) {
+		for (j = predStart[w]; j < predStart[w + 1]; j++) {
+			u = Eval(preds[j], ancestor, label, semi, stack);
+			if (semi[u] < semi[w])
+				semi[w] = semi[u];
+		}
+		ancestor[w] = parent[w];
+	}
+
+	// Find the immediate dominators, in preorder.
+	idom[0] = 0;
+	for (w = 1; w < numNodes; w++) {
+		idom[w] = parent[w];
+		while (idom[w] > semi[w])
+			idom[w] = idom[idom[w]];
+	}
+
+	// A node's dominator always precedes it in preorder, so one backward pass accumulates
+	// everything each node dominates.
+	for (w = numNodes - 1; w > 0; w--) {
+		CensusNode node = &nodes[order[w]];
+		CensusNode dominator = &nodes[order[idom[w]]];
+
+		node->idom = order[idom[w]];
+		node->retainedBytes += node->shallowBytes;
+		node->retainedCount += node->type >= NODE_NUM_ROOTS ? 1 : 0;
+		dominator->retainedBytes += node->retainedBytes;
+		dominator->retainedCount += node->retainedCount;
+	}
+	nodes[0].idom = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Pass 3: Summarize.
+
+static String GetNodeName(Census census, Int32 index)
+{
+	CensusNode node = &census->nodes[index];
+	return node->type < NODE_NUM_ROOTS ? String_FromC(_rootNames[node->type]) : census->groups[node->group].name;
+}
+
+/// <summary>
+/// Describe how a node was found from the roots, like "<globals>.cache.items".  Nodes reached
+/// through a named variable or property are shown by that name; others are shown by group.
+/// </summary>
+static String GetNodePath(Census census, Int32 index)
+{
+	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	String segments[MAX_PATH_SEGMENTS];
+	Int numSegments = 0;
+	Bool truncated = False;
+	CensusNode node;
+
+	INIT_INLINE_STRINGBUILDER(stringBuilder);
+
+	while (index > 0) {
+		if (numSegments >= MAX_PATH_SEGMENTS) {
+			truncated = True;
+			break;
+		}
+		node = &census->nodes[index];
+		segments[numSegments++] = node->label ? SymbolTable_GetName(Smile_SymbolTable, node->label)
+			: node->type < NODE_NUM_ROOTS ? GetNodeName(census, index)
+			: String_Format("(%S)", GetNodeName(census, index));
+		index = node->parent;
+	}
+
+	if (truncated)
+		StringBuilder_AppendC(stringBuilder, "..", 0, 2);
+	while (numSegments > 0) {
+		numSegments--;
+		if (StringBuilder_GetLength(stringBuilder) > 0)
+			StringBuilder_AppendByte(stringBuilder, '.');
+		StringBuilder_AppendString(stringBuilder, segments[numSegments]);
+	}
+
+	return StringBuilder_ToString(stringBuilder);
+}
+
+/// <summary>
+/// Whether the given node is at the top of a dominator subtree of its group; that is, whether
+/// it is dominated by something other than another member of the same group.  For example,
+/// in a long list, only the first cell is a group head, since it dominates all of the others.
+/// </summary>
+Inline Bool IsGroupHead(Census census, Int32 index)
+{
+	CensusNode node = &census->nodes[index];
+	CensusNode idom = &census->nodes[node->idom];
+	return idom->type < NODE_NUM_ROOTS || idom->group != node->group;
+}
+
+static int GroupComparer(const void *a, const void *b)
+{
+	return (int)String_Compare(((HeapCensusGroup)a)->name, ((HeapCensusGroup)b)->name);
+}
+
+static void SummarizeGroups(Census census, HeapCensus result)
+{
+	CensusNode nodes = census->nodes;
+	CensusNode node;
+	HeapCensusGroup group;
+	Int32 i;
+
+	for (i = 0; i < census->numNodes; i++) {
+		node = &nodes[i];
+		if (node->type < NODE_NUM_ROOTS) continue;
+
+		group = &census->groups[node->group];
+		group->count++;
+		group->shallowBytes += node->shallowBytes;
+
+		// Only count retained sizes at the top of each group's dominator subtrees, so nothing
+		// is counted twice.
+		if (IsGroupHead(census, i))
+			group->retainedBytes += node->retainedBytes;
+
+		result->totalCount++;
+		result->totalBytes += node->shallowBytes;
+	}
+
+	result->numGroups = census->numGroups;
+	result->groups = census->groups;
+}
+
+static void SummarizeRetainers(Census census, HeapCensus result, Int maxRetainers)
+{
+	CensusNode nodes = census->nodes;
+	Int32 *top;
+	Int32 numTop, i, j;
+
+	// Each root category is reported as a retainer of whatever only it can reach.
+	result->numRoots = NODE_NUM_ROOTS - 1;
+	result->roots = GC_MALLOC_STRUCT_ARRAY(struct HeapCensusRetainerStruct, result->numRoots);
+	if (result->roots == NULL)
+		Smile_Abort_OutOfMemory();
+	for (i = 1; i < census->numNodes && nodes[i].type < NODE_NUM_ROOTS; i++) {
+		HeapCensusRetainer root = &result->roots[nodes[i].type - 1];
+		root->name = GetNodeName(census, i);
+		root->path = root->name;
+		root->retainedCount = nodes[i].retainedCount;
+		root->retainedBytes = nodes[i].retainedBytes;
+	}
+
+	// Select the largest individual retainers, using a simple insertion into a short list.
+	// Only group heads are considered, so that a long chain of objects of the same kind (like
+	// the cells of a list) is reported once, and not once for every link.
+	if (maxRetainers < 0) maxRetainers = 0;
+	top = GC_MALLOC_RAW_ARRAY(Int32, maxRetainers + 1);
+	if (top == NULL)
+		Smile_Abort_OutOfMemory();
+	numTop = 0;
+
+	for (i = 0; i < census->numNodes; i++) {
+		if (nodes[i].type < NODE_NUM_ROOTS || !IsGroupHead(census, i)) continue;
+		if (numTop >= maxRetainers && (numTop == 0 || nodes[i].retainedBytes <= nodes[top[numTop - 1]].retainedBytes))
+			continue;
+
+		for (j = numTop; j > 0 && nodes[top[j - 1]].retainedBytes < nodes[i].retainedBytes; j--)
+			top[j] = top[j - 1];
+		top[j] = i;
+		if (numTop < maxRetainers) numTop++;
+	}
+
+	result->numRetainers = numTop;
+	result->retainers = GC_MALLOC_STRUCT_ARRAY(struct HeapCensusRetainerStruct, numTop > 0 ? numTop : 1);
+	if (result->retainers == NULL)
+		Smile_Abort_OutOfMemory();
+	for (i = 0; i < numTop; i++) {
+		HeapCensusRetainer retainer = &result->retainers[i];
+		retainer->name = GetNodeName(census, top[i]);
+		retainer->path = GetNodePath(census, top[i]);
+		retainer->retainedCount = nodes[top[i]].retainedCount;
+		retainer->retainedBytes = nodes[top[i]].retainedBytes;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public interface.
+
+static void InitCensus(Census census, SymbolTable symbolTable)
+{
+	Int i;
+
+	census->symbolTable = symbolTable;
+
+	census->maxNodes = 4096;
+	census->nodes = GC_MALLOC_RAW_ARRAY(struct CensusNodeStruct, census->maxNodes);
+	census->numNodes = 0;
+
+	census->maxEdges = 8192;
+	census->edges = GC_MALLOC_RAW_ARRAY(Int32, census->maxEdges);
+	census->numEdges = 0;
+
+	census->tableMask = 8191;
+	census->table = GC_MALLOC_RAW_ARRAY(Int32, census->tableMask + 1);
+
+	census->maxGroups = 64;
+	census->groups = GC_MALLOC_STRUCT_ARRAY(struct HeapCensusGroupStruct, census->maxGroups);
+	census->numGroups = 0;
+
+	if (census->nodes == NULL || census->edges == NULL || census->table == NULL || census->groups == NULL)
+		Smile_Abort_OutOfMemory();
+
+	MemSet(census->table, 0xFF, sizeof(Int32) * (census->tableMask + 1));
+	for (i = 0; i < 256; i++)
+		census->kindGroups[i] = -1;
+	Int32Dict_ClearWithSize((Int32Dict)&census->classGroups, 16);
+	census->groupNames = StringIntDict_Create();
+}
+
+/// <summary>
+/// Take a census of the heap:  Find every object that is reachable from the roots, and work
+/// out how many bytes each group of objects (and each of the largest individual objects)
+/// keeps alive.  This is a stop-the-world operation, and it uses a few dozen bytes of
+/// temporary memory per live object, so it is meant for diagnostics, not for routine use.
+/// </summary>
+/// <param name="maxRetainers">The maximum number of "top retainers" to report.</param>
+/// <returns>The census results.</returns>
+HeapCensus HeapCensus_Take(Int maxRetainers)
+{
+	struct CensusStruct censusStruct;
+	Census census = &censusStruct;
+	HeapCensus result;
+
+	InitCensus(census, NULL);
+	Walk(census);
+	ComputeDominators(census);
+
+	result = GC_MALLOC_STRUCT(struct HeapCensusStruct);
+	if (result == NULL)
+		Smile_Abort_OutOfMemory();
+	result->totalCount = 0;
+	result->totalBytes = 0;
+
+	SummarizeGroups(census, result);
+	SummarizeRetainers(census, result, maxRetainers);
+
+	// Sort the groups only at the end, since the nodes refer to them by index.
+	qsort(result->groups, result->numGroups, sizeof(struct HeapCensusGroupStruct), GroupComparer);
+
+	return result;
+}
+
+/// <summary>
+/// Sweep the symbol table:  Find every collectable symbol that is still referred to from
+/// anywhere in the heap, and reclaim the rest.  This walks the same graph a census does (but
+/// more cautiously; see above), so it costs about as much as a census's first pass.  It must
+/// only be called from a point where no C code is holding onto a collectable symbol that it
+/// hasn't stored in the heap, like from one of the interpreter's safe points.
+/// </summary>
+/// <param name="symbolTable">The symbol table to sweep.</param>
+/// <returns>The number of symbols that were reclaimed.</returns>
+Int HeapCensus_CollectSymbols(SymbolTable symbolTable)
+{
+	struct CensusStruct censusStruct;
+	Census census = &censusStruct;
+	Int numPending, attempt;
+
+	// The walk allocates, and allocating can run finalizers, which can hand an object that we
+	// didn't see (because it was unreachable) back to the on-collect queue.  If that happens,
+	// walk again; if it keeps happening, give up, and leave the sweep for another time.
+	for (attempt = 0; attempt < 4; attempt++) {
+		numPending = OnCollect_PendingCount;
+
+		SymbolTable_BeginSweep(symbolTable);
+		InitCensus(census, symbolTable);
+		Walk(census);
+
+		if (OnCollect_PendingCount == numPending)
+			return SymbolTable_EndSweep(symbolTable);
+	}
+
+	return 0;
+}
+
+/// <summary>
+/// Find the group in a census with the given name, like "List" or "Object:Point".
+/// </summary>
+/// <returns>The group, or NULL if the census found no objects in that group.</returns>
+HeapCensusGroup HeapCensus_FindGroup(HeapCensus census, String name)
+{
+	Int i;
+
+	for (i = 0; i < census->numGroups; i++) {
+		if (String_Equals(census->groups[i].name, name))
+			return &census->groups[i];
+	}
+	return NULL;
+}
+
+/// <summary>
+/// Format a census as text.  The format is one record per line, with tab-separated fields,
+/// and groups sorted by name, so that the output of two censuses can be compared with an
+/// ordinary line-based diff tool:
+///
+///   # Smile heap census v1
+///   total     count   bytes
+///   root      name    retained-count  retained-bytes
+///   group     name    count   shallow-bytes   retained-bytes
+///   retainer  name    retained-count  retained-bytes  path
+/// </summary>
+String HeapCensus_ToString(HeapCensus census)
+{
+	StringBuilder stringBuilder = StringBuilder_Create();
+	Int i;
+
+	StringBuilder_AppendC(stringBuilder, "# Smile heap census v1\n", 0, 23);
+	StringBuilder_AppendFormat(stringBuilder, "total\t%lu\t%lu\n", census->totalCount, census->totalBytes);
+
+	for (i = 0; i < census->numRoots; i++) {
+		HeapCensusRetainer root = &census->roots[i];
+		StringBuilder_AppendFormat(stringBuilder, "root\t%S\t%lu\t%lu\n",
+			root->name, root->retainedCount, root->retainedBytes);
+	}
+
+	for (i = 0; i < census->numGroups; i++) {
+		HeapCensusGroup group = &census->groups[i];
+		if (!group->count) continue;
+		StringBuilder_AppendFormat(stringBuilder, "group\t%S\t%lu\t%lu\t%lu\n",
+			group->name, group->count, group->shallowBytes, group->retainedBytes);
+	}
+
+	for (i = 0; i < census->numRetainers; i++) {
+		HeapCensusRetainer retainer = &census->retainers[i];
+		StringBuilder_AppendFormat(stringBuilder, "retainer\t%S\t%lu\t%lu\t%S\n",
+			retainer->name, retainer->retainedCount, retainer->retainedBytes, retainer->path);
+	}
+
+	return StringBuilder_ToString(stringBuilder);
+}
+
+/// <summary>
+/// Write a census to the given file, in the format produced by HeapCensus_ToString().
+/// </summary>
+/// <returns>True if the file was written successfully, False if it could not be.</returns>
+Bool HeapCensus_WriteToFile(HeapCensus census, String filename)
+{
+	String text = HeapCensus_ToString(census);
+	FILE *fp;
+	Bool result;
+
+	if ((fp = fopen(String_ToC(filename), "wb")) == NULL)
+		return False;
+
+	result = fwrite(String_GetBytes(text), 1, String_Length(text), fp) == (size_t)String_Length(text);
+	result = (fclose(fp) == 0) && result;
+
+	return result;
+}
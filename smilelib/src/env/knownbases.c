@@ -40,6 +40,7 @@ static void SetupNumericTypes(struct KnownBasesStruct *knownBases)
 	knownBases->Integer32 = SmileUserObject_Create((SmileObject)knownBases->IntegerBase, Smile_KnownSymbols.Integer32_);
 	knownBases->Integer64 = SmileUserObject_Create((SmileObject)knownBases->IntegerBase, Smile_KnownSymbols.Integer64_);
 	knownBases->Integer128 = SmileUserObject_Create((SmileObject)knownBases->IntegerBase, Smile_KnownSymbols.Integer128_);
+	knownBases->BigInt = SmileUserObject_Create((SmileObject)knownBases->IntegerBase, Smile_KnownSymbols.BigInt_);
 
 	knownBases->RealBase = SmileUserObject_Create((SmileObject)knownBases->Number, Smile_KnownSymbols.RealBase_);
 
@@ -186,10 +187,14 @@ static void SetupMiscTypes(struct KnownBasesStruct *knownBases)
 	knownBases->Symbol = SmileUserObject_Create((SmileObject)knownBases->Object, Smile_KnownSymbols.Symbol_);
 	knownBases->Exception = SmileUserObject_Create((SmileObject)knownBases->Object, Smile_KnownSymbols.Exception_);
 	knownBases->Timestamp = SmileUserObject_Create((SmileObject)knownBases->Object, Smile_KnownSymbols.Timestamp_);
+	knownBases->Gc = SmileUserObject_Create((SmileObject)knownBases->Object, Smile_KnownSymbols.Gc_);
 	knownBases->Handle = SmileUserObject_Create((SmileObject)knownBases->Object, Smile_KnownSymbols.Handle_);
 
 	knownBases->Regex = SmileUserObject_Create((SmileObject)knownBases->Handle, Smile_KnownSymbols.Regex_);
 	knownBases->RegexMatch = SmileUserObject_Create((SmileObject)knownBases->Handle, Smile_KnownSymbols.RegexMatch_);
+	knownBases->StringBuilder = SmileUserObject_Create((SmileObject)knownBases->Handle, Smile_KnownSymbols.StringBuilder_);
+	knownBases->WeakRef = SmileUserObject_Create((SmileObject)knownBases->Handle, Smile_KnownSymbols.WeakRef_);
+	knownBases->WeakMap = SmileUserObject_Create((SmileObject)knownBases->Handle, Smile_KnownSymbols.WeakMap_);
 }
 
 void KnownBases_Preload(struct KnownBasesStruct *knownBases)
@@ -207,9 +212,14 @@ void KnownBases_Preload(struct KnownBasesStruct *knownBases)
 
 extern void SmileByte_Setup(SmileUserObject base);
 extern void SmileByteArray_Setup(SmileUserObject base);
+extern void SmileInteger32Array_Setup(SmileUserObject base);
+extern void SmileInteger64Array_Setup(SmileUserObject base);
+extern void SmileFloat32Array_Setup(SmileUserObject base);
+extern void SmileFloat64Array_Setup(SmileUserObject base);
 extern void SmileInteger16_Setup(SmileUserObject base);
 extern void SmileInteger32_Setup(SmileUserObject base);
 extern void SmileInteger64_Setup(SmileUserObject base);
+extern void SmileBigInt_Setup(SmileUserObject base);
 extern void SmileReal32_Setup(SmileUserObject base);
 extern void SmileReal64_Setup(SmileUserObject base);
 extern void SmileFloat32_Setup(SmileUserObject base);
@@ -238,15 +248,24 @@ extern void SmileSymbol_Setup(SmileUserObject base);
 
 extern void SmileRegex_Setup(SmileUserObject base);
 extern void SmileRegexMatch_Setup(SmileUserObject base);
+extern void SmileStringBuilder_Setup(SmileUserObject base);
+extern void WeakRef_Setup(SmileUserObject base);
+extern void WeakMap_Setup(SmileUserObject base);
 extern void SmileTimestamp_Setup(SmileUserObject base);
+extern void GcStats_Setup(SmileUserObject base);
 
 void KnownBases_Setup(struct KnownBasesStruct *knownBases)
 {
 	SmileByte_Setup(knownBases->Byte);
 	SmileByteArray_Setup(knownBases->ByteArray);
+	SmileInteger32Array_Setup(knownBases->Integer32Array);
+	SmileInteger64Array_Setup(knownBases->Integer64Array);
+	SmileFloat32Array_Setup(knownBases->Float32Array);
+	SmileFloat64Array_Setup(knownBases->Float64Array);
 	SmileInteger16_Setup(knownBases->Integer16);
 	SmileInteger32_Setup(knownBases->Integer32);
 	SmileInteger64_Setup(knownBases->Integer64);
+	SmileBigInt_Setup(knownBases->BigInt);
 	SmileReal32_Setup(knownBases->Real32);
 	SmileReal64_Setup(knownBases->Real64);
 	SmileFloat32_Setup(knownBases->Float32);
@@ -273,10 +292,14 @@ void KnownBases_Setup(struct KnownBasesStruct *knownBases)
 	SmileUni_Setup(knownBases->Uni);
 	SmileSymbol_Setup(knownBases->Symbol);
 	SmileTimestamp_Setup(knownBases->Timestamp);
+	GcStats_Setup(knownBases->Gc);
 
 	SmileUnboxedBool_Instance->base = (SmileObject)knownBases->Bool;
 	SmileUnboxedSymbol_Instance->base = (SmileObject)knownBases->Symbol;
 
 	SmileRegex_Setup(knownBases->Regex);
 	SmileRegexMatch_Setup(knownBases->RegexMatch);
+	SmileStringBuilder_Setup(knownBases->StringBuilder);
+	WeakRef_Setup(knownBases->WeakRef);
+	WeakMap_Setup(knownBases->WeakMap);
 }
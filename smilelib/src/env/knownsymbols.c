@@ -274,6 +274,8 @@ STATIC_STRING(Exception_, "Exception");
 STATIC_STRING(Facade_, "Facade");
 STATIC_STRING(FacadeProper_, "Fa" "\xC3\xA7" "ade");
 STATIC_STRING(Fn_, "Fn");
+STATIC_STRING(FoldSearch_, "FoldSearch");
+STATIC_STRING(Gc_, "Gc");
 STATIC_STRING(Handle_, "Handle");
 STATIC_STRING(List_, "List");
 STATIC_STRING(Map_, "Map");
@@ -288,6 +290,7 @@ STATIC_STRING(Regex_, "Regex");
 STATIC_STRING(RegexMatch_, "RegexMatch");
 STATIC_STRING(String_, "String");
 STATIC_STRING(StringArray_, "StringArray");
+STATIC_STRING(StringBuilder_, "StringBuilder");
 STATIC_STRING(StringMap_, "StringMap");
 STATIC_STRING(Symbol_, "Symbol");
 STATIC_STRING(SymbolArray_, "SymbolArray");
@@ -296,6 +299,8 @@ STATIC_STRING(Timestamp_, "Timestamp");
 STATIC_STRING(Uni_, "Uni");
 STATIC_STRING(UniRange_, "UniRange");
 STATIC_STRING(UserObject_, "UserObject");
+STATIC_STRING(WeakMap_, "WeakMap");
+STATIC_STRING(WeakRef_, "WeakRef");
 
 STATIC_STRING(Number_, "Number");
 STATIC_STRING(NumericArray_, "NumericArray");
@@ -329,6 +334,7 @@ STATIC_STRING(Integer128_, "Integer128");
 STATIC_STRING(Integer128Array_, "Integer128Array");
 STATIC_STRING(Integer128Range_, "Integer128Range");
 STATIC_STRING(Integer128Map_, "Integer128Map");
+STATIC_STRING(BigInt_, "BigInt");
 
 STATIC_STRING(Real_, "Real");
 STATIC_STRING(RealBase_, "RealBase");
@@ -385,6 +391,8 @@ static void KnownSymbolsInt_PreloadTypenames(SymbolTable symbolTable, KnownSymbo
 	knownSymbols->Facade_ = SymbolTableInt_AddFast(symbolTable, Facade_);
 	knownSymbols->FacadeProper_ = SymbolTableInt_AddFast(symbolTable, FacadeProper_);
 	knownSymbols->Fn_ = SymbolTableInt_AddFast(symbolTable, Fn_);
+	knownSymbols->FoldSearch_ = SymbolTableInt_AddFast(symbolTable, FoldSearch_);
+	knownSymbols->Gc_ = SymbolTableInt_AddFast(symbolTable, Gc_);
 	knownSymbols->Handle_ = SymbolTableInt_AddFast(symbolTable, Handle_);
 	knownSymbols->List_ = SymbolTableInt_AddFast(symbolTable, List_);
 	knownSymbols->Map_ = SymbolTableInt_AddFast(symbolTable, Map_);
@@ -399,6 +407,7 @@ static void KnownSymbolsInt_PreloadTypenames(SymbolTable symbolTable, KnownSymbo
 	knownSymbols->RegexMatch_ = SymbolTableInt_AddFast(symbolTable, RegexMatch_);
 	knownSymbols->String_ = SymbolTableInt_AddFast(symbolTable, String_);
 	knownSymbols->StringArray_ = SymbolTableInt_AddFast(symbolTable, StringArray_);
+	knownSymbols->StringBuilder_ = SymbolTableInt_AddFast(symbolTable, StringBuilder_);
 	knownSymbols->StringMap_ = SymbolTableInt_AddFast(symbolTable, StringMap_);
 	knownSymbols->Symbol_ = SymbolTableInt_AddFast(symbolTable, Symbol_);
 	knownSymbols->SymbolArray_ = SymbolTableInt_AddFast(symbolTable, SymbolArray_);
@@ -407,6 +416,8 @@ static void KnownSymbolsInt_PreloadTypenames(SymbolTable symbolTable, KnownSymbo
 	knownSymbols->Uni_ = SymbolTableInt_AddFast(symbolTable, Uni_);
 	knownSymbols->UniRange_ = SymbolTableInt_AddFast(symbolTable, UniRange_);
 	knownSymbols->UserObject_ = SymbolTableInt_AddFast(symbolTable, UserObject_);
+	knownSymbols->WeakMap_ = SymbolTableInt_AddFast(symbolTable, WeakMap_);
+	knownSymbols->WeakRef_ = SymbolTableInt_AddFast(symbolTable, WeakRef_);
 
 	knownSymbols->Number_ = SymbolTableInt_AddFast(symbolTable, Number_);
 	knownSymbols->NumericArray_ = SymbolTableInt_AddFast(symbolTable, NumericArray_);
@@ -440,6 +451,7 @@ static void KnownSymbolsInt_PreloadTypenames(SymbolTable symbolTable, KnownSymbo
 	knownSymbols->Integer128Array_ = SymbolTableInt_AddFast(symbolTable, Integer128Array_);
 	knownSymbols->Integer128Range_ = SymbolTableInt_AddFast(symbolTable, Integer128Range_);
 	knownSymbols->Integer128Map_ = SymbolTableInt_AddFast(symbolTable, Integer128Map_);
+	knownSymbols->BigInt_ = SymbolTableInt_AddFast(symbolTable, BigInt_);
 
 	knownSymbols->Real_ = SymbolTableInt_AddFast(symbolTable, Real_);
 	knownSymbols->RealBase_ = SymbolTableInt_AddFast(symbolTable, RealBase_);
@@ -653,8 +665,10 @@ STATIC_STRING(filename_mode, "filename-mode");
 STATIC_STRING(first, "first");
 STATIC_STRING(flags, "flags");
 STATIC_STRING(float32_, "float32");
+STATIC_STRING(float32_array, "float32-array");
 STATIC_STRING(float32_range, "float64-range");
 STATIC_STRING(float64_, "float64");
+STATIC_STRING(float64_array, "float64-array");
 STATIC_STRING(float64_range, "float64-range");
 STATIC_STRING(float128_, "float128");
 STATIC_STRING(floor_, "floor");
@@ -687,8 +701,10 @@ STATIC_STRING(int_lg, "int-lg");
 STATIC_STRING(integer16_, "integer16");
 STATIC_STRING(integer16_range, "integer16-range");
 STATIC_STRING(integer32_, "integer32");
+STATIC_STRING(integer32_array, "integer32-array");
 STATIC_STRING(integer32_range, "integer32-range");
 STATIC_STRING(integer64_, "integer64");
+STATIC_STRING(integer64_array, "integer64-array");
 STATIC_STRING(integer64_range, "integer64-range");
 STATIC_STRING(integer128_, "integer128");
 STATIC_STRING(last_index_of, "last-index-of");
@@ -986,8 +1002,10 @@ static void KnownSymbolsInt_PreloadGeneralSymbols(SymbolTable symbolTable, Known
 	knownSymbols->flags = SymbolTableInt_AddFast(symbolTable, flags);
 	knownSymbols->floor = SymbolTableInt_AddFast(symbolTable, floor_);
 	knownSymbols->float32_ = SymbolTableInt_AddFast(symbolTable, float32_);
+	knownSymbols->float32_array = SymbolTableInt_AddFast(symbolTable, float32_array);
 	knownSymbols->float32_range = SymbolTableInt_AddFast(symbolTable, float32_range);
 	knownSymbols->float64_ = SymbolTableInt_AddFast(symbolTable, float64_);
+	knownSymbols->float64_array = SymbolTableInt_AddFast(symbolTable, float64_array);
 	knownSymbols->float64_range = SymbolTableInt_AddFast(symbolTable, float64_range);
 	knownSymbols->float128_ = SymbolTableInt_AddFast(symbolTable, float128_);
 	knownSymbols->fold = SymbolTableInt_AddFast(symbolTable, fold);
@@ -1019,8 +1037,10 @@ static void KnownSymbolsInt_PreloadGeneralSymbols(SymbolTable symbolTable, Known
 	knownSymbols->integer16_ = SymbolTableInt_AddFast(symbolTable, integer16_);
 	knownSymbols->integer16_range = SymbolTableInt_AddFast(symbolTable, integer16_range);
 	knownSymbols->integer32_ = SymbolTableInt_AddFast(symbolTable, integer32_);
+	knownSymbols->integer32_array = SymbolTableInt_AddFast(symbolTable, integer32_array);
 	knownSymbols->integer32_range = SymbolTableInt_AddFast(symbolTable, integer32_range);
 	knownSymbols->integer64_ = SymbolTableInt_AddFast(symbolTable, integer64_);
+	knownSymbols->integer64_array = SymbolTableInt_AddFast(symbolTable, integer64_array);
 	knownSymbols->integer64_range = SymbolTableInt_AddFast(symbolTable, integer64_range);
 	knownSymbols->integer128_ = SymbolTableInt_AddFast(symbolTable, integer128_);
 	knownSymbols->last_index_of = SymbolTableInt_AddFast(symbolTable, last_index_of);
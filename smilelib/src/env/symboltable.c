@@ -25,30 +25,63 @@
 /// </summary>
 /// <param name="symbolTable">The symbol table to which the new symbol should be added.</param>
 /// <param name="name">The name of the new symbol, which must not already exist in the symbol table.</param>
+/// <param name="flags">The initial SYMBOL_FLAG_* bits for the new symbol.</param>
 /// <returns>The new symbol.</returns>
-static Symbol SymbolTableInt_AddSymbol(SymbolTable symbolTable, String name)
+static Symbol SymbolTableInt_AddSymbol(SymbolTable symbolTable, String name, Byte flags)
 {
 	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
 	Symbol symbol;
 	String *newNames;
+	Byte *newFlags;
 	Int newMax;
 
-	// If we've run out of space for symbols, make more.
-	if (table->count >= table->max) {
-		newMax = table->max * 2;
-		newNames = GC_MALLOC_STRUCT_ARRAY(String, newMax);
-		MemCpy(newNames, table->symbolNames, sizeof(String) * table->count);
-		table->symbolNames = newNames;
-		table->max = newMax;
+	// Symbol names live as long as the symbol table, so they shouldn't pin down any larger text.
+	name = String_Compact(name);
+
+	if (table->numFreeSymbols > 0) {
+		// Reuse a reclaimed symbol ID, if there is one.
+		symbol = (Symbol)table->freeSymbols[--table->numFreeSymbols];
+	}
+	else {
+		// If we've run out of space for symbols, make more.
+		if (table->count >= table->max) {
+			newMax = table->max * 2;
+			newNames = GC_MALLOC_STRUCT_ARRAY(String, newMax);
+			if (newNames == NULL) Smile_Abort_OutOfMemory();
+			MemCpy(newNames, table->symbolNames, sizeof(String) * table->count);
+			newFlags = GC_MALLOC_RAW_ARRAY(Byte, newMax);
+			if (newFlags == NULL) Smile_Abort_OutOfMemory();
+			MemCpy(newFlags, table->symbolFlags, table->count);
+			MemZero(newFlags + table->count, newMax - table->count);
+			table->symbolNames = newNames;
+			table->symbolFlags = newFlags;
+			table->max = newMax;
+		}
+		symbol = (Symbol)table->count++;
 	}
 
 	// Add the symbol to the table, and return it.
-	table->symbolNames[symbol = (Symbol)table->count++] = name;
+	table->symbolNames[symbol] = name;
+	table->symbolFlags[symbol] = flags;
 	StringIntDict_Add(table->symbolLookup, name, symbol);
 
+	if (flags & SYMBOL_FLAG_COLLECTABLE)
+		table->numCollectable++;
+
 	return symbol;
 }
 
+/// <summary>
+/// Make the given symbol permanent, if it was collectable.
+/// </summary>
+Inline void SymbolTableInt_Pin(struct SymbolTableInt *table, Symbol symbol)
+{
+	if (table->symbolFlags[symbol] & SYMBOL_FLAG_COLLECTABLE) {
+		table->symbolFlags[symbol] &= ~SYMBOL_FLAG_COLLECTABLE;
+		table->numCollectable--;
+	}
+}
+
 //-------------------------------------------------------------------------------------------------
 //  Public API
 
@@ -66,6 +99,10 @@ SymbolTable SymbolTable_Create(void)
 	table->symbolNames = GC_MALLOC_STRUCT_ARRAY(String, 1024);
 	if (table->symbolNames == NULL) Smile_Abort_OutOfMemory();
 
+	table->symbolFlags = GC_MALLOC_RAW_ARRAY(Byte, 1024);
+	if (table->symbolFlags == NULL) Smile_Abort_OutOfMemory();
+	MemZero(table->symbolFlags, 1024);
+
 	// Symbol zero is always preallocated as the empty string.
 	table->symbolNames[0] = String_Empty;
 
@@ -74,6 +111,12 @@ SymbolTable SymbolTable_Create(void)
 
 	table->symbolLookup = StringIntDict_CreateWithSize(1024);
 
+	table->freeSymbols = NULL;
+	table->numFreeSymbols = 0;
+	table->maxFreeSymbols = 0;
+	table->numCollectable = 0;
+	table->sweepThreshold = SYMBOLTABLE_MIN_SWEEP_THRESHOLD;
+
 	return (SymbolTable)table;
 }
 
@@ -83,13 +126,16 @@ SymbolTable SymbolTable_Create(void)
 /// <param name="symbolTable">The symbol table in which the symbol will exist.</param>
 /// <param name="name">The name of the symbol to find or create.</param>
 /// <returns>The symbol, a preexisting value if it already was found in the symbol table,
-/// or a new value if it did not already exist in the table.</returns>
+/// or a new value if it did not already exist in the table.  The symbol is always permanent:
+/// If it was collectable, it will be pinned.</returns>
 Symbol SymbolTable_GetSymbol(SymbolTable symbolTable, String name)
 {
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
 	Symbol symbol;
-	if ((symbol = (Symbol)StringIntDict_GetValue(((struct SymbolTableInt *)symbolTable)->symbolLookup, name)) == 0)
-		return SymbolTableInt_AddSymbol(symbolTable, name);
+	if ((symbol = (Symbol)StringIntDict_GetValue(table->symbolLookup, name)) == 0)
+		return SymbolTableInt_AddSymbol(symbolTable, name, 0);
 
+	SymbolTableInt_Pin(table, symbol);
 	return symbol;
 }
 
@@ -99,13 +145,16 @@ Symbol SymbolTable_GetSymbol(SymbolTable symbolTable, String name)
 /// <param name="symbolTable">The symbol table in which the symbol will exist.</param>
 /// <param name="name">The name of the symbol to find or create, expressed as a C nul-terminated string.</param>
 /// <returns>The symbol, a preexisting value if it already was found in the symbol table,
-/// or a new value if it did not already exist in the table.</returns>
+/// or a new value if it did not already exist in the table.  The symbol is always permanent:
+/// If it was collectable, it will be pinned.</returns>
 Symbol SymbolTable_GetSymbolC(SymbolTable symbolTable, const char *name)
 {
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
 	Symbol symbol;
-	if ((symbol = (Symbol)StringIntDict_GetValueC(((struct SymbolTableInt *)symbolTable)->symbolLookup, name)) == 0)
-		return SymbolTableInt_AddSymbol(symbolTable, String_FromC(name));
+	if ((symbol = (Symbol)StringIntDict_GetValueC(table->symbolLookup, name)) == 0)
+		return SymbolTableInt_AddSymbol(symbolTable, String_FromC(name), 0);
 
+	SymbolTableInt_Pin(table, symbol);
 	return symbol;
 }
 
@@ -158,5 +207,108 @@ String SymbolTable_GetName(SymbolTable symbolTable, Symbol symbol)
 const char *SymbolTable_GetNameC(SymbolTable symbolTable, Symbol symbol)
 {
 	String string = SymbolTable_GetName(symbolTable, symbol);
-	return (string != NULL ? (const char *)string->_opaque.text : NULL);
+	return (string != NULL ? String_ToC(string) : NULL);
+}
+
+/// <summary>
+/// Find or create in the given symbol table a symbol that matches the given name.  If the
+/// symbol does not already exist, it will be created as a collectable symbol, which may be
+/// reclaimed by a later sweep once nothing refers to it anymore.  This is intended for symbols
+/// made from runtime data, like by String.to-symbol.
+/// </summary>
+/// <param name="symbolTable">The symbol table in which the symbol will exist.</param>
+/// <param name="name">The name of the symbol to find or create.</param>
+/// <returns>The symbol, a preexisting value if it already was found in the symbol table
+/// (whether permanent or collectable), or a new collectable value if it did not already exist.</returns>
+Symbol SymbolTable_GetCollectableSymbol(SymbolTable symbolTable, String name)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+	Symbol symbol;
+	if ((symbol = (Symbol)StringIntDict_GetValue(table->symbolLookup, name)) == 0)
+		return SymbolTableInt_AddSymbol(symbolTable, name, SYMBOL_FLAG_COLLECTABLE);
+
+	return symbol;
+}
+
+/// <summary>
+/// Make the given symbol permanent, so that no sweep will ever reclaim it.  This does nothing
+/// if the symbol is already permanent.
+/// </summary>
+/// <param name="symbolTable">The symbol table in which the symbol exists.</param>
+/// <param name="symbol">The symbol to pin.</param>
+void SymbolTable_Pin(SymbolTable symbolTable, Symbol symbol)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+
+	if ((Int)symbol <= 0 || (Int)symbol >= table->count)
+		return;
+
+	SymbolTableInt_Pin(table, symbol);
+}
+
+/// <summary>
+/// Begin a sweep of the symbol table:  This clears the marks on all symbols.  After this,
+/// call SymbolTable_MarkSymbol() for every symbol that is still in use, and then call
+/// SymbolTable_EndSweep() to reclaim the collectable symbols that were not marked.  No
+/// collectable symbols may be created between the start and the end of the sweep.
+/// </summary>
+/// <param name="symbolTable">The symbol table to sweep.</param>
+void SymbolTable_BeginSweep(SymbolTable symbolTable)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+	Byte *flags = table->symbolFlags;
+	Int i, count = table->count;
+
+	for (i = 0; i < count; i++)
+		flags[i] &= ~SYMBOL_FLAG_MARKED;
+}
+
+/// <summary>
+/// End a sweep of the symbol table:  Every collectable symbol that was not marked since the
+/// call to SymbolTable_BeginSweep() is removed from the table, and its ID is made available
+/// for reuse.
+/// </summary>
+/// <param name="symbolTable">The symbol table being swept.</param>
+/// <returns>The number of symbols that were reclaimed.</returns>
+Int SymbolTable_EndSweep(SymbolTable symbolTable)
+{
+	struct SymbolTableInt *table = (struct SymbolTableInt *)symbolTable;
+	Byte *flags = table->symbolFlags;
+	Int i, count = table->count, numReclaimed = 0;
+	Int32 *newFreeSymbols;
+	Int newMax;
+
+	for (i = 1; i < count; i++) {
+		if ((flags[i] & (SYMBOL_FLAG_COLLECTABLE | SYMBOL_FLAG_MARKED)) != SYMBOL_FLAG_COLLECTABLE)
+			continue;
+
+		// Make room for the reclaimed ID in the free list.
+		if (table->numFreeSymbols >= table->maxFreeSymbols) {
+			newMax = table->maxFreeSymbols > 0 ? table->maxFreeSymbols * 2 : 256;
+			newFreeSymbols = GC_MALLOC_RAW_ARRAY(Int32, newMax);
+			if (newFreeSymbols == NULL) Smile_Abort_OutOfMemory();
+			if (table->numFreeSymbols > 0)
+				MemCpy(newFreeSymbols, table->freeSymbols, sizeof(Int32) * table->numFreeSymbols);
+			table->freeSymbols = newFreeSymbols;
+			table->maxFreeSymbols = newMax;
+		}
+
+		// Forget the symbol, and remember its ID for reuse.
+		StringIntDict_Remove(table->symbolLookup, table->symbolNames[i]);
+		table->symbolNames[i] = NULL;
+		flags[i] = 0;
+		table->freeSymbols[table->numFreeSymbols++] = (Int32)i;
+		numReclaimed++;
+	}
+
+	for (i = 0; i < count; i++)
+		flags[i] &= ~SYMBOL_FLAG_MARKED;
+
+	// Don't ask for another sweep until the survivors have doubled.
+	table->numCollectable -= numReclaimed;
+	table->sweepThreshold = table->numCollectable * 2;
+	if (table->sweepThreshold < SYMBOLTABLE_MIN_SWEEP_THRESHOLD)
+		table->sweepThreshold = SYMBOLTABLE_MIN_SWEEP_THRESHOLD;
+
+	return numReclaimed;
 }
@@ -0,0 +1,460 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/types.h>
+#include <smile/gc.h>
+#include <smile/crypto/dicthash.h>
+#include <smile/env/weakref.h>
+#include <smile/smiletypes/smileobject.h>
+
+//-------------------------------------------------------------------------------------------------
+// Common helpers.
+
+/// <summary>
+/// Determine whether an object can be tracked weakly:  Only objects that were allocated on the
+/// GC heap can ever be collected, so only they can have disappearing links or finalizers.  Static
+/// objects (like the known objects and static strings) live forever, and unboxed values have no
+/// identity at all.
+/// </summary>
+/// <param name="obj">The object to test.</param>
+/// <returns>True if the object lives on the GC heap (and may someday be collected), False otherwise.</returns>
+Bool Weak_IsCollectable(SmileObject obj)
+{
+	return obj != NULL && GC_base(obj) == (void *)obj;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Weak references.
+
+/// <summary>
+/// Create a new weak reference to the given object.  If the object is not collectable (see
+/// Weak_IsCollectable()), the reference will simply never be cleared.
+/// </summary>
+/// <param name="target">The object to refer to.</param>
+/// <returns>The new weak reference.</returns>
+WeakRef WeakRef_Create(SmileObject target)
+{
+	WeakRef weakRef = (WeakRef)GC_MALLOC_ATOMIC(sizeof(struct WeakRefStruct));
+	if (weakRef == NULL) Smile_Abort_OutOfMemory();
+
+	weakRef->target = target;
+
+	if (Weak_IsCollectable(target))
+		GC_general_register_disappearing_link((void **)&weakRef->target, target);
+
+	return weakRef;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Weak-keyed maps.
+//
+// These are open-addressed (linear-probing) hash tables keyed by object identity.  The keys live
+// in their own atomic array, and each key's slot is registered with the collector as a
+// disappearing link, so the collector both ignores the keys when marking and clears them when
+// they die.  A LIVE slot whose key has been cleared is "expired"; expired slots are converted
+// to DELETED slots (and their values released) lazily, the first time the map is touched after
+// a collection.  Links are unregistered explicitly whenever a key leaves its slot; when an
+// entire keys array is dropped, the collector removes its now-dangling links on its own.
+
+static void WeakMap_Allocate(WeakMap weakMap, Int size)
+{
+	weakMap->states = (Byte *)GC_MALLOC_ATOMIC(size);
+	weakMap->keys = (SmileObject *)GC_MALLOC_ATOMIC(sizeof(SmileObject) * size);
+	weakMap->values = (SmileObject *)GC_MALLOC(sizeof(SmileObject) * size);
+	if (weakMap->states == NULL || weakMap->keys == NULL || weakMap->values == NULL)
+		Smile_Abort_OutOfMemory();
+
+	MemZero(weakMap->states, size);
+	MemZero(weakMap->keys, sizeof(SmileObject) * size);
+
+	weakMap->mask = size - 1;
+	weakMap->count = 0;
+	weakMap->numUsed = 0;
+	weakMap->gcNo = (PtrInt)GC_get_gc_no();
+}
+
+/// <summary>
+/// Create a new, empty weak-keyed map.
+/// </summary>
+/// <param name="initialSize">How many entries the map should be able to hold before it needs to grow.</param>
+/// <returns>The new map.</returns>
+WeakMap WeakMap_Create(Int initialSize)
+{
+	WeakMap weakMap;
+	Int size;
+
+	weakMap = GC_MALLOC_STRUCT(struct WeakMapStruct);
+	if (weakMap == NULL) Smile_Abort_OutOfMemory();
+
+	for (size = 16; size * 3 < initialSize * 4; size <<= 1) ;
+
+	WeakMap_Allocate(weakMap, size);
+
+	return weakMap;
+}
+
+/// <summary>
+/// If there has been a collection since the last time we looked, turn any expired entries
+/// into deleted entries, releasing their values.
+/// </summary>
+static void WeakMap_Purge(WeakMap weakMap)
+{
+	PtrInt gcNo = (PtrInt)GC_get_gc_no();
+	Byte *states;
+	SmileObject *keys, *values;
+	Int i, size;
+
+	if (gcNo == weakMap->gcNo) return;
+	weakMap->gcNo = gcNo;
+
+	states = weakMap->states;
+	keys = weakMap->keys;
+	values = weakMap->values;
+	size = weakMap->mask + 1;
+
+	for (i = 0; i < size; i++) {
+		if (states[i] == WEAKMAP_SLOT_LIVE && keys[i] == NULL) {
+			states[i] = WEAKMAP_SLOT_DELETED;
+			values[i] = NULL;
+			weakMap->count--;
+		}
+	}
+}
+
+/// <summary>
+/// Find the slot that holds the given key, or -1 if the key is not in the map.
+/// </summary>
+static Int WeakMap_Find(WeakMap weakMap, SmileObject key)
+{
+	Byte *states = weakMap->states;
+	SmileObject *keys = weakMap->keys;
+	Int mask = weakMap->mask;
+	Int i = (Int)Smile_ApplyHashOracle((UInt64)(PtrInt)key) & mask;
+
+	for (;;) {
+		switch (states[i]) {
+			case WEAKMAP_SLOT_EMPTY:
+				return -1;
+			case WEAKMAP_SLOT_LIVE:
+				if (keys[i] == key) return i;
+				break;
+		}
+		i = (i + 1) & mask;
+	}
+}
+
+/// <summary>
+/// Store a key/value pair into a slot, registering the key's link if the key is collectable.
+/// </summary>
+static void WeakMap_StoreInSlot(WeakMap weakMap, Int i, SmileObject key, SmileObject value)
+{
+	if (weakMap->states[i] == WEAKMAP_SLOT_EMPTY)
+		weakMap->numUsed++;
+
+	weakMap->states[i] = WEAKMAP_SLOT_LIVE;
+	weakMap->keys[i] = key;
+	weakMap->values[i] = value;
+	weakMap->count++;
+
+	if (Weak_IsCollectable(key))
+		GC_general_register_disappearing_link((void **)&weakMap->keys[i], key);
+}
+
+/// <summary>
+/// Rebuild the map's table with room for at least twice as many live entries as it has now,
+/// dropping any deleted or expired slots along the way.
+/// </summary>
+static void WeakMap_Rehash(WeakMap weakMap)
+{
+	Byte *oldStates = weakMap->states;
+	SmileObject *oldKeys = weakMap->keys;
+	SmileObject *oldValues = weakMap->values;
+	Int oldSize = weakMap->mask + 1;
+	Int i, j, newSize;
+	SmileObject key;
+
+	for (newSize = 16; newSize * 3 < weakMap->count * 8; newSize <<= 1) ;
+
+	WeakMap_Allocate(weakMap, newSize);
+
+	for (i = 0; i < oldSize; i++) {
+		if (oldStates[i] != WEAKMAP_SLOT_LIVE || (key = oldKeys[i]) == NULL) continue;
+
+		GC_unregister_disappearing_link((void **)&oldKeys[i]);
+
+		j = (Int)Smile_ApplyHashOracle((UInt64)(PtrInt)key) & weakMap->mask;
+		while (weakMap->states[j] != WEAKMAP_SLOT_EMPTY)
+			j = (j + 1) & weakMap->mask;
+
+		WeakMap_StoreInSlot(weakMap, j, key, oldValues[i]);
+	}
+}
+
+/// <summary>
+/// Look up a key in a weak-keyed map.
+/// </summary>
+/// <param name="weakMap">The map to search.</param>
+/// <param name="key">The key to find (compared by identity).</param>
+/// <param name="value">If the key is found, this is set to its value.</param>
+/// <returns>True if the key was found, False if it was not.</returns>
+Bool WeakMap_TryGetValue(WeakMap weakMap, SmileObject key, SmileObject *value)
+{
+	Int i;
+
+	WeakMap_Purge(weakMap);
+
+	if ((i = WeakMap_Find(weakMap, key)) < 0)
+		return False;
+
+	*value = weakMap->values[i];
+	return True;
+}
+
+/// <summary>
+/// Add or replace an entry in a weak-keyed map.
+/// </summary>
+/// <param name="weakMap">The map to update.</param>
+/// <param name="key">The key (compared by identity), which will be held weakly.</param>
+/// <param name="value">The value, which will be held strongly for as long as the key is alive.</param>
+void WeakMap_Set(WeakMap weakMap, SmileObject key, SmileObject value)
+{
+	Int i, mask;
+	Byte *states;
+
+	WeakMap_Purge(weakMap);
+
+	if ((i = WeakMap_Find(weakMap, key)) >= 0) {
+		weakMap->values[i] = value;
+		return;
+	}
+
+	if ((weakMap->numUsed + 1) * 4 > (weakMap->mask + 1) * 3)
+		WeakMap_Rehash(weakMap);
+
+	// Find the first slot on the key's probe sequence that doesn't hold a live key.
+	states = weakMap->states;
+	mask = weakMap->mask;
+	i = (Int)Smile_ApplyHashOracle((UInt64)(PtrInt)key) & mask;
+	while (states[i] == WEAKMAP_SLOT_LIVE && weakMap->keys[i] != NULL)
+		i = (i + 1) & mask;
+
+	if (states[i] == WEAKMAP_SLOT_LIVE)
+		weakMap->count--;	// Reusing an expired slot whose key the collector has already unlinked.
+
+	WeakMap_StoreInSlot(weakMap, i, key, value);
+}
+
+/// <summary>
+/// Remove an entry from a weak-keyed map.
+/// </summary>
+/// <param name="weakMap">The map to update.</param>
+/// <param name="key">The key of the entry to remove (compared by identity).</param>
+/// <returns>True if the key was found and removed, False if it was not in the map.</returns>
+Bool WeakMap_Remove(WeakMap weakMap, SmileObject key)
+{
+	Int i;
+
+	WeakMap_Purge(weakMap);
+
+	if ((i = WeakMap_Find(weakMap, key)) < 0)
+		return False;
+
+	GC_unregister_disappearing_link((void **)&weakMap->keys[i]);
+
+	weakMap->states[i] = WEAKMAP_SLOT_DELETED;
+	weakMap->keys[i] = NULL;
+	weakMap->values[i] = NULL;
+	weakMap->count--;
+
+	return True;
+}
+
+/// <summary>
+/// Remove every entry from a weak-keyed map.
+/// </summary>
+/// <param name="weakMap">The map to empty.</param>
+void WeakMap_Clear(WeakMap weakMap)
+{
+	Int i, size = weakMap->mask + 1;
+
+	for (i = 0; i < size; i++) {
+		if (weakMap->states[i] == WEAKMAP_SLOT_LIVE && weakMap->keys[i] != NULL)
+			GC_unregister_disappearing_link((void **)&weakMap->keys[i]);
+	}
+
+	WeakMap_Allocate(weakMap, 16);
+}
+
+/// <summary>
+/// Count the live entries in a weak-keyed map.
+/// </summary>
+/// <param name="weakMap">The map to count.</param>
+/// <returns>The number of entries whose keys have not (yet) been collected.</returns>
+Int WeakMap_Count(WeakMap weakMap)
+{
+	WeakMap_Purge(weakMap);
+	return weakMap->count;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Collection callbacks.
+//
+// Boehm runs finalizers from inside the allocator, at whatever point some allocation happens to
+// trigger them, which is no place to run script code.  So the finalizer we register does nothing
+// but move the object's callback records onto a queue; the callbacks are actually invoked later,
+// by OnCollect_RunPending(), which the interpreter calls from its safe points.  The records
+// are the finalizer's client data, which the collector treats as reachable, so each callback
+// stays alive exactly as long as it is needed.
+
+static OnCollectRecord _pendingHead, _pendingTail;
+static OnCollectRecord _liveHead;
+
+/// <summary>
+/// The number of callbacks in the pending queue.  The interpreter polls this at its safe points,
+/// and calls OnCollect_RunPending() when it is nonzero.
+/// </summary>
+Int OnCollect_PendingCount;
+
+static void GC_CALLBACK OnCollect_Finalize(void *obj, void *clientData)
+{
+	OnCollectRecord record, next;
+
+	for (record = (OnCollectRecord)clientData; record != NULL; record = next) {
+		next = record->next;
+
+		record->obj = (SmileObject)obj;
+		record->next = NULL;
+
+		if (_pendingTail != NULL)
+			_pendingTail->next = record;
+		else
+			_pendingHead = record;
+		_pendingTail = record;
+		OnCollect_PendingCount++;
+	}
+}
+
+/// <summary>
+/// Arrange for a function to be invoked with an object after that object becomes unreachable.
+/// The object is resurrected for the duration of the call, and freed for good afterward.  An
+/// object may have any number of callbacks.  Note that if the function itself refers to the
+/// object, the object will never become unreachable, and the callback will never run.
+/// </summary>
+/// <param name="obj">The object to watch.</param>
+/// <param name="fn">The function to invoke, with the object as its only argument.</param>
+/// <returns>True if the callback was registered; False if the object is not collectable or
+/// already has some other (native) finalizer, like a handle does.</returns>
+Bool OnCollect_Register(SmileObject obj, SmileFunction fn)
+{
+	OnCollectRecord record;
+	GC_finalization_proc oldProc;
+	void *oldClientData;
+
+	if (!Weak_IsCollectable(obj))
+		return False;
+
+	record = GC_MALLOC_STRUCT(struct OnCollectRecordStruct);
+	if (record == NULL) Smile_Abort_OutOfMemory();
+
+	record->fn = fn;
+	record->obj = NULL;
+	record->next = NULL;
+	record->hiddenObj = (PtrInt)GC_HIDE_POINTER(obj);
+
+	GC_register_finalizer_ignore_self(obj, OnCollect_Finalize, record, &oldProc, &oldClientData);
+
+	if (oldProc == OnCollect_Finalize) {
+		// Chain onto the callbacks already registered for this object.
+		record->next = (OnCollectRecord)oldClientData;
+	}
+	else if (oldProc != NULL) {
+		// Someone else owns this object's finalizer; put theirs back.
+		GC_register_finalizer(obj, oldProc, oldClientData, NULL, NULL);
+		return False;
+	}
+
+	record->prevLive = NULL;
+	record->nextLive = _liveHead;
+	if (_liveHead != NULL)
+		_liveHead->prevLive = record;
+	_liveHead = record;
+
+	return True;
+}
+
+/// <summary>
+/// Take the next pending collection callback off of the queue.  This first runs any finalizers
+/// the collector has queued up, so that callbacks for objects freed by a collection that just
+/// finished will be available immediately.
+/// </summary>
+/// <returns>The next callback to invoke (with its 'obj' filled in), or NULL if there are none.</returns>
+OnCollectRecord OnCollect_Dequeue(void)
+{
+	OnCollectRecord record;
+
+	if (_pendingHead == NULL && GC_should_invoke_finalizers())
+		GC_invoke_finalizers();
+
+	if ((record = _pendingHead) == NULL)
+		return NULL;
+
+	if ((_pendingHead = record->next) == NULL)
+		_pendingTail = NULL;
+	record->next = NULL;
+	OnCollect_PendingCount--;
+
+	// Once it's been handed out, the record is the caller's responsibility.
+	if (record->prevLive != NULL)
+		record->prevLive->nextLive = record->nextLive;
+	else
+		_liveHead = record->nextLive;
+	if (record->nextLive != NULL)
+		record->nextLive->prevLive = record->prevLive;
+	record->prevLive = record->nextLive = NULL;
+
+	return record;
+}
+
+/// <summary>
+/// Get the number of collection callbacks that are waiting to be invoked.
+/// </summary>
+/// <returns>The number of callbacks in the pending queue.</returns>
+Int OnCollect_NumPending(void)
+{
+	if (GC_should_invoke_finalizers())
+		GC_invoke_finalizers();
+
+	return OnCollect_PendingCount;
+}
+
+/// <summary>
+/// Enumerate every collection callback that has not yet been dequeued, whether its object is
+/// still alive or has already been collected.  Each callback's object is passed along with it;
+/// objects that are still alive are found through a hidden pointer, so the collector does not
+/// consider them reachable, but they must be treated as reachable by anything that needs to know
+/// what script code might see later on (like the symbol table's sweep).
+/// </summary>
+/// <param name="func">The function to call for each callback.</param>
+/// <param name="param">A parameter to pass to that function.</param>
+void OnCollect_ForEach(OnCollectForEachFunc func, void *param)
+{
+	OnCollectRecord record;
+
+	for (record = _liveHead; record != NULL; record = record->nextLive) {
+		func(record->fn, record->obj != NULL ? record->obj : (SmileObject)GC_REVEAL_POINTER(record->hiddenObj), param);
+	}
+}
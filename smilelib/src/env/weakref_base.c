@@ -0,0 +1,266 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/string.h>
+#include <smile/env/weakref.h>
+#include <smile/smiletypes/base.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilehandle.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+static Byte _handleChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_HANDLE,
+	0, 0,
+	0, 0,
+};
+
+static Byte _handleComparisonChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_HANDLE,
+	0, 0,
+};
+
+//-------------------------------------------------------------------------------------------------
+// Argument helpers
+
+static SmileHandle GetHandleOfKind(SmileArg arg, Symbol handleKind, const char *methodName)
+{
+	SmileHandle handle = (SmileHandle)arg.obj;
+
+	if (SMILE_KIND(handle) != SMILE_KIND_HANDLE || handle->handleKind != handleKind) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_Format("'%s' requires a %S as its first argument.", methodName,
+				SymbolTable_GetName(Smile_SymbolTable, handleKind)));
+	}
+
+	return handle;
+}
+
+static SmileObject GetWeakTarget(SmileArg arg, const char *methodName)
+{
+	if (SMILE_KIND(arg.obj) <= SMILE_KIND_UNBOXED_MAX) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_Format("'%s' can only refer weakly to objects, not to unboxed values like numbers or Booleans.", methodName));
+	}
+
+	return arg.obj;
+}
+
+static SmileArg ReturnObjectOrNull(SmileObject obj)
+{
+	return obj != NULL ? SmileArg_Unbox(obj) : SmileArg_From(NullObject);
+}
+
+//-------------------------------------------------------------------------------------------------
+// WeakRef
+
+static Bool WeakRef_ToBool(SmileHandle handle, SmileUnboxedData unboxedData)
+{
+	return WeakRef_Get((WeakRef)handle->ptr) != NULL;
+}
+
+static struct SmileHandleMethodsStruct WeakRefMethods = {
+	.toBool = WeakRef_ToBool,
+};
+
+/// <summary>
+/// [WeakRef.of obj] creates a reference to 'obj' that does not keep it alive.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakRefOf)
+{
+	SmileObject target;
+	Int argi = 0;
+
+	if (argi < argc - 1 && argv[argi].obj == param)
+		argi++;
+
+	target = GetWeakTarget(argv[argi], "WeakRef.of");
+
+	return SmileArg_From((SmileObject)SmileHandle_Create((SmileObject)Smile_KnownBases.WeakRef,
+		&WeakRefMethods, Smile_KnownSymbols.WeakRef_, WeakRef_Create(target)));
+}
+
+/// <summary>
+/// [ref.get] returns the referenced object, or null if it has been collected.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakRefGet)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakRef_, "WeakRef.get");
+	return ReturnObjectOrNull(WeakRef_Get((WeakRef)handle->ptr));
+}
+
+/// <summary>
+/// [ref.alive?] returns true if the referenced object has not been collected.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakRefIsAlive)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakRef_, "WeakRef.alive?");
+	return SmileUnboxedBool_From(WeakRef_Get((WeakRef)handle->ptr) != NULL);
+}
+
+//-------------------------------------------------------------------------------------------------
+// WeakMap
+
+static String WeakMap_ToString(SmileHandle handle, SmileUnboxedData unboxedData)
+{
+	return String_Format("WeakMap (%ld entries)", (Int64)WeakMap_Count((WeakMap)handle->ptr));
+}
+
+static struct SmileHandleMethodsStruct WeakMapMethods = {
+	.toString = WeakMap_ToString,
+};
+
+/// <summary>
+/// [WeakMap.of] creates an empty weak-keyed map; [WeakMap.of n] sizes it for 'n' entries.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapOf)
+{
+	Int initialSize = 0;
+	Int argi = 0;
+
+	if (argi < argc && argv[argi].obj == param)
+		argi++;
+	if (argi < argc) {
+		if (SMILE_KIND(argv[argi].obj) != SMILE_KIND_UNBOXED_INTEGER64) {
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_FromC("The optional argument to 'WeakMap.of' must be an integer size."));
+		}
+		initialSize = (Int)argv[argi].unboxed.i64;
+	}
+
+	return SmileArg_From((SmileObject)SmileHandle_Create((SmileObject)Smile_KnownBases.WeakMap,
+		&WeakMapMethods, Smile_KnownSymbols.WeakMap_, WeakMap_Create(initialSize)));
+}
+
+/// <summary>
+/// [map.get key] returns the value stored for 'key', or null (or [map.get key default] returns
+/// 'default') if there is no such key.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapGet)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakMap_, "WeakMap.get");
+	SmileObject key = GetWeakTarget(argv[1], "WeakMap.get");
+	SmileObject value;
+
+	if (WeakMap_TryGetValue((WeakMap)handle->ptr, key, &value))
+		return ReturnObjectOrNull(value);
+
+	return argc > 2 ? argv[2] : SmileArg_From(NullObject);
+}
+
+/// <summary>
+/// [map.set key value] stores 'value' for 'key', and returns 'value'.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapSet)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakMap_, "WeakMap.set");
+	SmileObject key = GetWeakTarget(argv[1], "WeakMap.set");
+
+	WeakMap_Set((WeakMap)handle->ptr, key, SmileArg_Box(argv[2]));
+
+	return argv[2];
+}
+
+/// <summary>
+/// [map.has? key] returns true if there is a value stored for 'key'.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapHas)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakMap_, "WeakMap.has?");
+	SmileObject key = GetWeakTarget(argv[1], "WeakMap.has?");
+	SmileObject value;
+
+	return SmileUnboxedBool_From(WeakMap_TryGetValue((WeakMap)handle->ptr, key, &value));
+}
+
+/// <summary>
+/// [map.remove key] removes the entry for 'key', and returns true if there was one.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapRemove)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakMap_, "WeakMap.remove");
+	SmileObject key = GetWeakTarget(argv[1], "WeakMap.remove");
+
+	return SmileUnboxedBool_From(WeakMap_Remove((WeakMap)handle->ptr, key));
+}
+
+/// <summary>
+/// [map.clear] removes every entry from the map.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapClear)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakMap_, "WeakMap.clear");
+
+	WeakMap_Clear((WeakMap)handle->ptr);
+
+	return argv[0];
+}
+
+/// <summary>
+/// [map.count] returns the number of entries whose keys are still alive.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(WeakMapCount)
+{
+	SmileHandle handle = GetHandleOfKind(argv[0], Smile_KnownSymbols.WeakMap_, "WeakMap.count");
+	return SmileUnboxedInteger64_From((Int64)WeakMap_Count((WeakMap)handle->ptr));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Shared comparison methods
+
+SMILE_EXTERNAL_FUNCTION(Eq)
+{
+	SmileHandle a = (SmileHandle)argv[0].obj, b = (SmileHandle)argv[1].obj;
+	return SmileUnboxedBool_From(SMILE_KIND(b) == SMILE_KIND_HANDLE && a->ptr == b->ptr);
+}
+
+SMILE_EXTERNAL_FUNCTION(Ne)
+{
+	SmileHandle a = (SmileHandle)argv[0].obj, b = (SmileHandle)argv[1].obj;
+	return SmileUnboxedBool_From(SMILE_KIND(b) != SMILE_KIND_HANDLE || a->ptr != b->ptr);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void WeakRef_Setup(SmileUserObject base)
+{
+	SetupFunction("of", WeakRefOf, base, "target", ARG_CHECK_MIN | ARG_CHECK_MAX, 1, 2, 0, NULL);
+
+	SetupFunction("get", WeakRefGet, NULL, "ref", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+	SetupFunction("alive?", WeakRefIsAlive, NULL, "ref", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+
+	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _handleComparisonChecks);
+	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _handleComparisonChecks);
+}
+
+void WeakMap_Setup(SmileUserObject base)
+{
+	SetupFunction("of", WeakMapOf, base, "size", ARG_CHECK_MAX, 0, 2, 0, NULL);
+
+	SetupFunction("get", WeakMapGet, NULL, "map key default", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 2, 3, 3, _handleChecks);
+	SetupFunction("set", WeakMapSet, NULL, "map key value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 3, 3, 3, _handleChecks);
+	SetupFunction("has?", WeakMapHas, NULL, "map key", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _handleChecks);
+	SetupFunction("remove", WeakMapRemove, NULL, "map key", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _handleChecks);
+	SetupFunction("clear", WeakMapClear, NULL, "map", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+	SetupFunction("count", WeakMapCount, NULL, "map", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+
+	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _handleComparisonChecks);
+	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _handleComparisonChecks);
+}
@@ -376,6 +376,7 @@ static String ByteCode_OperandsToString(ByteCodeSegment segment, ByteCode byteCo
 			symbol = GetSymbolForLocalVariable(closureInfo, (Int32)byteCode->opcode & 7, (Int32)byteCode->u.index);
 			return String_Format("`%S (%hd)", SymbolTable_GetName(Smile_SymbolTable, symbol), (Int32)byteCode->u.index);
 		case Op_NullLoc0:
+		case Op_NullCell0:
 			symbol = GetSymbolForLocalVariable(closureInfo, 0, (Int32)byteCode->u.index);
 			return String_Format("`%S (%hd)", SymbolTable_GetName(Smile_SymbolTable, symbol), (Int32)byteCode->u.index);
 
@@ -388,6 +389,13 @@ static String ByteCode_OperandsToString(ByteCodeSegment segment, ByteCode byteCo
 			return String_Format("%hd, %hd", byteCode->u.i2.a, byteCode->u.i2.b);
 
 		// 80-8F
+		case Op_ChkMet:
+			return String_Format("0x%02X, `%S (%hd)", byteCode->u.i2.a, SymbolTable_GetName(Smile_SymbolTable, (Symbol)byteCode->u.i2.b), byteCode->u.i2.b);
+		case Op_ForInit:
+			return String_Format("%hd", byteCode->u.int32);
+		case Op_ForNext:
+		case Op_ListNext:
+			return String_Format(byteCode->u.i2.a < 0 ? "L%hd, %hd" : ">L%hd, %hd", address + byteCode->u.i2.a, byteCode->u.i2.b);
 		case Op_Try:
 			return String_Format(byteCode->u.i2.a < 0 ? "L%hd, %hd" : ">L%hd, %hd", address + byteCode->u.i2.a, byteCode->u.i2.b);
 		
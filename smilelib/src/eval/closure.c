@@ -17,6 +17,63 @@
 
 #include <smile/eval/closure.h>
 #include <smile/stringbuilder.h>
+#include <smile/env/gcstats.h>
+
+// Closures are described to the GC precisely, so that it scans only their pointer fields and the
+// 'obj' half of each variable, and never the unboxed data (which can look like anything).  Closures
+// vary in size, so we build one descriptor per variable count, on demand, up to this limit; larger
+// closures are rare, and are simply scanned conservatively.
+#define MAX_DESCRIBED_CLOSURE_VARIABLES 255
+
+#define CLOSURE_HEADER_SIZE (offsetof(struct ClosureStruct, variables))
+
+static GC_descr _closureDescriptors[MAX_DESCRIBED_CLOSURE_VARIABLES + 1];
+static Bool _closureDescriptorsBuilt[MAX_DESCRIBED_CLOSURE_VARIABLES + 1];
+
+static GC_descr GetClosureDescriptor(Int numVariables)
+{
+	GC_word bitmap[(CLOSURE_HEADER_SIZE / sizeof(GC_word) + (MAX_DESCRIBED_CLOSURE_VARIABLES + 1) * sizeof(SmileArg) / sizeof(GC_word)
+		+ GC_WORDSZ - 1) / GC_WORDSZ];
+	Int i;
+
+	if (_closureDescriptorsBuilt[numVariables])
+		return _closureDescriptors[numVariables];
+
+	MemZero(bitmap, sizeof(bitmap));
+
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct ClosureStruct, parent));
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct ClosureStruct, global));
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct ClosureStruct, closureInfo));
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct ClosureStruct, returnClosure));
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct ClosureStruct, returnSegment));
+	GC_set_bit(bitmap, GC_WORD_OFFSET(struct ClosureStruct, unwindInfo));
+
+	for (i = 0; i < numVariables; i++) {
+		GC_set_bit(bitmap, (CLOSURE_HEADER_SIZE + i * sizeof(SmileArg) + offsetof(SmileArg, obj)) / sizeof(GC_word));
+	}
+
+	_closureDescriptors[numVariables] = GC_make_descriptor(bitmap, (CLOSURE_HEADER_SIZE + numVariables * sizeof(SmileArg)) / sizeof(GC_word));
+	_closureDescriptorsBuilt[numVariables] = True;
+
+	return _closureDescriptors[numVariables];
+}
+
+static Closure AllocateClosure(Int numVariables)
+{
+	Int closureSize = CLOSURE_HEADER_SIZE + sizeof(SmileArg) * numVariables;
+	Closure closure;
+
+	if (numVariables <= MAX_DESCRIBED_CLOSURE_VARIABLES)
+		closure = (Closure)GC_MALLOC_EXPLICITLY_TYPED(closureSize, GetClosureDescriptor(numVariables));
+	else
+		closure = (Closure)GC_MALLOC(closureSize);
+
+	if (closure == NULL)
+		Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_CLOSURE, closureSize);
+
+	return closure;
+}
 
 /// <summary>
 /// Create a new ClosureInfo struct, which contains metadata about a closure.
@@ -66,9 +123,7 @@ String ClosureInfo_StringifyVariableNames(ClosureInfo closureInfo)
 
 Closure Closure_CreateGlobal(ClosureInfo closureInfo, Closure parent)
 {
-	Closure closure = (Closure)GC_MALLOC(sizeof(struct ClosureStruct) - sizeof(SmileArg));
-	if (closure == NULL)
-		Smile_Abort_OutOfMemory();
+	Closure closure = AllocateClosure(0);
 
 	closure->closureInfo = closureInfo;
 	closure->parent = parent;
@@ -89,12 +144,7 @@ Closure Closure_CreateGlobal(ClosureInfo closureInfo, Closure parent)
 Closure Closure_CreateLocal(ClosureInfo closureInfo, Closure parent,
 	Closure returnClosure, ByteCodeSegment returnSegment, Int returnPc)
 {
-	const Int variablesStart = offsetof(struct ClosureStruct, variables);
-	Int closureSize = variablesStart + sizeof(SmileArg) * ((Int)closureInfo->numVariables + (Int)closureInfo->tempSize);
-
-	Closure closure = (Closure)GC_MALLOC(closureSize);
-	if (closure == NULL)
-		Smile_Abort_OutOfMemory();
+	Closure closure = AllocateClosure((Int)closureInfo->numVariables + (Int)closureInfo->tempSize);
 
 	closure->closureInfo = closureInfo;
 	closure->parent = parent;
@@ -112,6 +162,30 @@ Closure Closure_CreateLocal(ClosureInfo closureInfo, Closure parent,
 	return closure;
 }
 
+/// <summary>
+/// Create the closure that holds a new function instance's captured variables, copying each of
+/// them out of the closure that is instantiating the function.
+/// </summary>
+/// <param name="captureInfo">Metadata that describes the captured variables (all locals, no args or temps).</param>
+/// <param name="closure">The closure that is instantiating the function.</param>
+/// <param name="captureSources">Where to find each captured variable:  A nonnegative source is an
+/// index into the instantiating closure's own variables (its args followed by its locals); a negative
+/// source is ~index into the instantiating closure's own captured variables.</param>
+/// <returns>The new closure, whose parent is the instantiating closure's global closure, so that
+/// none of the instantiating closure's other state is kept alive by it.</returns>
+Closure Closure_CreateCaptured(ClosureInfo captureInfo, Closure closure, const Int32 *captureSources)
+{
+	Closure captured = Closure_CreateLocal(captureInfo, closure->global, NULL, NULL, 0);
+	Int i, numVariables = captureInfo->numVariables;
+
+	for (i = 0; i < numVariables; i++) {
+		Int32 source = captureSources[i];
+		captured->locals[i] = source >= 0 ? closure->variables[source] : closure->parent->locals[~source];
+	}
+
+	return captured;
+}
+
 ClosureStateMachine Closure_CreateStateMachine(StateMachine stateMachineStart, StateMachine stateMachineBody,
 	Closure returnClosure, ByteCodeSegment returnSegment, Int returnPc)
 {
@@ -252,6 +252,12 @@ CompilerFunction Compiler_BeginFunction(Compiler compiler, SmileList args, Smile
 	newFunction->numTillInfos = 0;
 	newFunction->maxTillInfos = 0;
 
+	// This function doesn't capture any outer variables (yet).
+	newFunction->captures = NULL;
+	newFunction->captureSources = NULL;
+	newFunction->numCaptures = 0;
+	newFunction->maxCaptures = 0;
+
 	// Set up the ClosureInfo object that will eventually describe how this function's variables will behave.
 	closureInfo = ClosureInfo_Create(newFunction->parent != NULL ? newFunction->parent->closureInfo : compiler->compiledTables->globalClosureInfo,
 		CLOSURE_KIND_LOCAL);
@@ -319,12 +325,69 @@ CompiledLocalSymbol CompileScope_DefineSymbol(CompileScope scope, Symbol symbol,
 	localSymbol->wasReadDeep = False;
 	localSymbol->wasWritten = False;
 	localSymbol->wasWrittenDeep = False;
+	localSymbol->inCell = False;
+	localSymbol->inlineSetArgs = NULL;
+	localSymbol->inlineFn = NULL;
 
 	Int32Dict_SetValue(scope->symbolDict, symbol, localSymbol);
 
 	return localSymbol;
 }
 
+/// <summary>
+/// Capture an outer variable into the given function, so that the function's instances will carry
+/// their own copy of it (or of the Cell that holds it).  Every function between the given function
+/// and the variable's owner captures it too, since each function can only copy from its direct parent.
+/// </summary>
+/// <param name="compilerFunction">The function that needs access to the outer variable.</param>
+/// <param name="localSymbol">The outer variable, which must be an argument or local of an ancestor function.</param>
+/// <returns>The index of the variable among the function's captured variables (for use with LdLoc1).</returns>
+Int CompilerFunction_CaptureVariable(CompilerFunction compilerFunction, CompiledLocalSymbol localSymbol)
+{
+	CompilerFunction owner = localSymbol->scope->function;
+	Int32 source;
+	Int i;
+
+	// Figure out where the parent function will find this variable when it instantiates us.
+	if (compilerFunction->parent == owner)
+		source = (Int32)(localSymbol->kind == PARSEDECL_ARGUMENT ? localSymbol->index : owner->numArgs + localSymbol->index);
+	else
+		source = ~(Int32)CompilerFunction_CaptureVariable(compilerFunction->parent, localSymbol);
+
+	// If we already captured it, reuse that.
+	for (i = 0; i < compilerFunction->numCaptures; i++) {
+		if (compilerFunction->captureSources[i] == source)
+			return i;
+	}
+
+	// Do we have enough space to add it?  If not, reallocate.
+	if (compilerFunction->numCaptures >= compilerFunction->maxCaptures) {
+		CompiledLocalSymbol *newCaptures;
+		Int32 *newCaptureSources;
+		Int newMax;
+
+		newMax = compilerFunction->maxCaptures * 2;
+		if (newMax < 4) newMax = 4;
+		newCaptures = GC_MALLOC_STRUCT_ARRAY(CompiledLocalSymbol, newMax);
+		newCaptureSources = GC_MALLOC_RAW_ARRAY(Int32, newMax);
+		if (newCaptures == NULL || newCaptureSources == NULL)
+			Smile_Abort_OutOfMemory();
+		if (compilerFunction->numCaptures > 0) {
+			MemCpy(newCaptures, compilerFunction->captures, sizeof(CompiledLocalSymbol) * compilerFunction->numCaptures);
+			MemCpy(newCaptureSources, compilerFunction->captureSources, sizeof(Int32) * compilerFunction->numCaptures);
+		}
+		compilerFunction->captures = newCaptures;
+		compilerFunction->captureSources = newCaptureSources;
+		compilerFunction->maxCaptures = newMax;
+	}
+
+	i = compilerFunction->numCaptures++;
+	compilerFunction->captures[i] = localSymbol;
+	compilerFunction->captureSources[i] = source;
+
+	return i;
+}
+
 CompiledLocalSymbol CompileScope_FindSymbol(CompileScope compileScope, Symbol symbol)
 {
 	CompiledLocalSymbol localSymbol;
@@ -472,7 +535,7 @@ Int Compiler_AddObject(Compiler compiler, SmileObject obj)
 		if (newObjects == NULL)
 			Smile_Abort_OutOfMemory();
 		if (compiledTables->numObjects > 0)
-			MemCpy(newObjects, compiledTables->objects, compiledTables->numObjects);
+			MemCpy(newObjects, compiledTables->objects, sizeof(SmileObject) * compiledTables->numObjects);
 		compiledTables->objects = newObjects;
 		compiledTables->maxObjects = newMax;
 	}
@@ -564,6 +627,47 @@ UserFunctionInfo Compiler_CompileGlobalExpressionInCurrentScope(Compiler compile
 	return userFunctionInfo;
 }
 
+/// <summary>
+/// Prepare the ClosureInfo object that describes the variables a function captures from its
+/// parent, which is the layout of the closure that Op_NewFn creates for each function instance.
+/// </summary>
+/// <param name="compilerFunction">The compiled function whose captured variables should be described.</param>
+/// <returns>The captured variables, as a ClosureInfo object, or NULL if the function captures nothing.</returns>
+ClosureInfo Compiler_SetupCaptureInfoForCompilerFunction(Compiler compiler, CompilerFunction compilerFunction)
+{
+	ClosureInfo captureInfo;
+	Symbol *variableNames;
+	struct VarInfoStruct varInfo;
+	Int i;
+
+	if (compilerFunction->numCaptures == 0)
+		return NULL;
+	if (compilerFunction->numCaptures > Int16Max / 2)
+		Smile_Abort_FatalError("Function cannot be compiled because it captures too many variables (> 16383).");
+
+	captureInfo = ClosureInfo_Create(Compiler_GetGlobalClosureInfo(compiler), CLOSURE_KIND_LOCAL);
+	captureInfo->numVariables = (Int16)compilerFunction->numCaptures;
+
+	variableNames = (Symbol *)GC_MALLOC_ATOMIC(sizeof(Symbol) * compilerFunction->numCaptures);
+	if (variableNames == NULL)
+		Smile_Abort_OutOfMemory();
+	captureInfo->variableNames = variableNames;
+
+	for (i = 0; i < compilerFunction->numCaptures; i++) {
+		Symbol symbol = compilerFunction->captures[i]->symbol;
+
+		varInfo.kind = VAR_KIND_VAR;
+		varInfo.offset = (Int32)i;
+		varInfo.symbol = symbol;
+		varInfo.value = NullObject;
+		VarDict_SetValue(captureInfo->variableDictionary, symbol, &varInfo);
+
+		variableNames[i] = symbol;
+	}
+
+	return captureInfo;
+}
+
 /// <summary>
 /// Prepare a ClosureInfo object, which is the compact runtime equivalent of a CompilerFunction.
 /// </summary>
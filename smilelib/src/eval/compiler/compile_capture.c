@@ -0,0 +1,164 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/eval/compiler.h>
+#include <smile/eval/compiler_internal.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/parsing/internal/parsedecl.h>
+
+/// <summary>
+/// Determine whether the given symbol is mentioned anywhere inside a nested [$fn] within the
+/// given expression, which means that the function will need to capture it.  This is conservative:
+/// It doesn't care whether the nested function declares its own variable with the same name.
+/// </summary>
+/// <param name="expr">The expression to search.</param>
+/// <param name="symbol">The symbol to search for.</param>
+/// <param name="inFn">Whether the expression is already inside a nested [$fn].</param>
+/// <returns>True if the symbol is mentioned inside a nested [$fn], False if it is not.</returns>
+static Bool IsCapturedIn(SmileObject expr, Symbol symbol, Bool inFn)
+{
+	SmileList list;
+
+	switch (SMILE_KIND(expr)) {
+		case SMILE_KIND_SYMBOL:
+			return inFn && ((SmileSymbol)expr)->symbol == symbol;
+
+		case SMILE_KIND_LIST:
+			list = (SmileList)expr;
+			if (SMILE_KIND(list->a) == SMILE_KIND_SYMBOL && SMILE_KIND(list->d) == SMILE_KIND_LIST) {
+				Symbol head = ((SmileSymbol)list->a)->symbol;
+				if (head == SMILE_SPECIAL_SYMBOL__QUOTE)
+					return False;
+				if (head == SMILE_SPECIAL_SYMBOL__DOT)
+					return IsCapturedIn(((SmileList)list->d)->a, symbol, inFn);
+				if (head == SMILE_SPECIAL_SYMBOL__FN)
+					inFn = True;
+			}
+			for (; SMILE_KIND(list) == SMILE_KIND_LIST; list = (SmileList)list->d) {
+				if (IsCapturedIn(list->a, symbol, inFn))
+					return True;
+			}
+			return False;
+
+		default:
+			return False;
+	}
+}
+
+/// <summary>
+/// If the given statement is [$set symbol value] (possibly wrapped in a one-statement [$progn]),
+/// return True.
+/// </summary>
+static Bool IsSimpleAssignmentTo(SmileObject stmt, Symbol symbol)
+{
+	SmileList list = (SmileList)stmt;
+
+	// Declarations are usually wrapped in a one-statement [$progn].
+	if (SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__PROGN, stmt)
+		&& SMILE_KIND(list->d) == SMILE_KIND_LIST && SMILE_KIND(((SmileList)list->d)->d) == SMILE_KIND_NULL)
+		list = (SmileList)((SmileList)list->d)->a;
+
+	return SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__SET, (SmileObject)list)
+		&& SMILE_KIND(list->d) == SMILE_KIND_LIST
+		&& SMILE_KIND(((SmileList)list->d)->a) == SMILE_KIND_SYMBOL
+		&& ((SmileSymbol)((SmileList)list->d)->a)->symbol == symbol;
+}
+
+/// <summary>
+/// Decide whether a local variable of a [$scope] can be captured by copying its value into each
+/// nested function, or whether it must be boxed in a Cell that the nested functions share.
+/// Copying is safe if the variable is never assigned after any function can have captured it:
+/// That's true if it is never assigned at all, or if it is assigned exactly once, by a top-level
+/// statement of a scope that runs exactly once per call, before any statement that captures it.
+/// </summary>
+static Bool NeedsCell(Symbol symbol, SmileList body, Bool runsOncePerCall)
+{
+	SmileList statements;
+	Int numAssignments;
+
+	if (!IsCapturedIn((SmileObject)body, symbol, False))
+		return False;
+
+	numAssignments = Compiler_CountAssignments((SmileObject)body, symbol);
+	if (numAssignments == 0)
+		return False;
+	if (numAssignments > 1 || !runsOncePerCall)
+		return True;
+
+	for (statements = body; SMILE_KIND(statements) == SMILE_KIND_LIST; statements = (SmileList)statements->d) {
+		if (IsCapturedIn(statements->a, symbol, False))
+			return True;
+		if (IsSimpleAssignmentTo(statements->a, symbol))
+			return False;
+	}
+
+	return True;
+}
+
+/// <summary>
+/// Look for local variables in a newly-declared [$scope] that nested functions capture and that
+/// may change after they do, and mark them as living in Cells, so that every function sees (and
+/// can make) the same changes.  All other captured variables are simply copied into the closures
+/// that capture them.
+/// </summary>
+/// <param name="compiler">The compiler.</param>
+/// <param name="scope">The [$scope] whose variables have just been declared.</param>
+/// <param name="args">The [$scope]'s arguments, i.e., ([vars...] statements...).</param>
+void Compiler_FindCellVariables(Compiler compiler, CompileScope scope, SmileList args)
+{
+	SmileObject functionBody = compiler->currentFunction->body;
+	SmileList body = (SmileList)args->d;
+	Int32DictKeyValuePair *pairs;
+	Bool runsOncePerCall;
+	Int i, count;
+
+	// Only the [$scope] that is the function's entire body is certain to run exactly once per call;
+	// any other scope might be inside a loop, and then its "one" assignment would happen repeatedly.
+	runsOncePerCall = (SMILE_KIND(functionBody) == SMILE_KIND_LIST && ((SmileList)functionBody)->d == (SmileObject)args);
+
+	pairs = Int32Dict_GetAll(scope->symbolDict);
+	count = Int32Dict_Count(scope->symbolDict);
+	for (i = 0; i < count; i++) {
+		CompiledLocalSymbol localSymbol = (CompiledLocalSymbol)pairs[i].value;
+		localSymbol->inCell = NeedsCell(localSymbol->symbol, body, runsOncePerCall);
+	}
+}
+
+/// <summary>
+/// Look for arguments of a newly-declared function that nested functions capture and that the
+/// function assigns, and mark them as living in Cells.  (Arguments that are never assigned can
+/// always be copied.)
+/// </summary>
+/// <param name="compiler">The compiler.</param>
+/// <param name="scope">The function's scope, in which its arguments have just been declared.</param>
+/// <param name="body">The function's body.</param>
+void Compiler_FindCellArguments(Compiler compiler, CompileScope scope, SmileObject body)
+{
+	Int32DictKeyValuePair *pairs;
+	Int i, count;
+
+	UNUSED(compiler);
+
+	pairs = Int32Dict_GetAll(scope->symbolDict);
+	count = Int32Dict_Count(scope->symbolDict);
+	for (i = 0; i < count; i++) {
+		CompiledLocalSymbol localSymbol = (CompiledLocalSymbol)pairs[i].value;
+		localSymbol->inCell = IsCapturedIn(body, localSymbol->symbol, False)
+			&& Compiler_CountAssignments(body, localSymbol->symbol) > 0;
+	}
+}
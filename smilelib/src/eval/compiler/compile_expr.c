@@ -26,6 +26,7 @@
 #include <smile/smiletypes/numeric/smileinteger16.h>
 #include <smile/smiletypes/numeric/smileinteger32.h>
 #include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
 #include <smile/smiletypes/numeric/smilefloat32.h>
 #include <smile/smiletypes/numeric/smilefloat64.h>
 #include <smile/smiletypes/numeric/smilereal32.h>
@@ -131,7 +132,7 @@ CompiledBlock Compiler_CompileExpr(Compiler compiler, SmileObject expr, CompileF
 		case SMILE_KIND_INTEGER128:
 			Smile_Abort_FatalError("Integer128 is not yet supported.");
 		case SMILE_KIND_BIGINT:
-			Smile_Abort_FatalError("BigInt is not yet supported.");
+			COMPILE_PRIMITIVE_EXPR(Op_LdObj, index = Compiler_AddObject(compiler, expr));
 
 		// Real constants evaluate to themselves.
 		case SMILE_KIND_REAL32:
@@ -228,6 +229,12 @@ CompiledBlock Compiler_CompileExpr(Compiler compiler, SmileObject expr, CompileF
 				// arguments (after they have been evaluated).
 				default:
 				defaultListForm:
+					// Calls to small, known, non-recursive functions get their bodies compiled in place.
+					if ((compiledBlock = Compiler_TryCompileInlineCall(compiler, list, compileFlags)) != NULL) {
+						compiler->currentFunction->currentSourceLocation = oldSourceLocation;
+						return compiledBlock;
+					}
+
 					compiledBlock = CompiledBlock_Create();
 
 					// Resolve each element of the list.  The first element will become the function,
@@ -74,6 +74,16 @@ CompiledBlock Compiler_CompileFn(Compiler compiler, SmileList args, CompileFlags
 		CompileScope_DefineSymbol(scope, name, PARSEDECL_ARGUMENT, i);
 	}
 
+	// Any arguments that nested functions must share rather than copy get moved into Cells first.
+	Compiler_FindCellArguments(compiler, scope, functionBody);
+	for (i = 0; i < userFunctionInfo->numArgs; i++) {
+		if (((CompiledLocalSymbol)Int32Dict_GetValue(scope->symbolDict, userFunctionInfo->args[i].name))->inCell) {
+			EMIT1(Op_LdArg0, +1, index = (Int32)i);
+			EMIT0(Op_NewCell, 0);
+			EMIT1(Op_StpArg0, -1, index = (Int32)i);
+		}
+	}
+
 	// Compile the body.
 	Compiler_SetSourceLocationFromList(compiler, (SmileList)args->d);
 	childBlock = Compiler_CompileExpr(compiler, functionBody, compileFlags & ~COMPILE_FLAG_NORESULT);
@@ -93,8 +103,12 @@ CompiledBlock Compiler_CompileFn(Compiler compiler, SmileList args, CompileFlags
 	userFunctionInfo->byteCodeSegment = byteCodeSegment;
 	compilerFunction->stackSize = compiledBlock->maxStackDepth;
 
-	// Make a suitable closure decriptor for it, and an actual function object.
+	// Make a suitable closure decriptor for it, and an actual function object.  Each instance
+	// of the function gets a closure of its captured variables, which will be its parent.
 	closureInfo = Compiler_SetupClosureInfoForCompilerFunction(compiler, compilerFunction);
+	userFunctionInfo->captureInfo = Compiler_SetupCaptureInfoForCompilerFunction(compiler, compilerFunction);
+	userFunctionInfo->captureSources = compilerFunction->captureSources;
+	closureInfo->parent = userFunctionInfo->captureInfo != NULL ? userFunctionInfo->captureInfo : closureInfo->global;
 	MemCpy(&userFunctionInfo->closureInfo, closureInfo, sizeof(struct ClosureInfoStruct));
 
 	Compiler_RevertSourceLocation(compiler, oldSourceLocation);
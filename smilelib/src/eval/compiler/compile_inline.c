@@ -0,0 +1,581 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/eval/compiler.h>
+#include <smile/eval/compiler_internal.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/smilefunction.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/parsing/parsemessage.h>
+#include <smile/parsing/internal/parsedecl.h>
+#include <smile/parsing/internal/parsescope.h>
+
+// How big (in atoms and list cells) a function's body may be and still be inlined at a call site.
+#define INLINE_CALL_MAX_SIZE 64
+
+// How big (in atoms and list cells) a literal function's body may be and still be expanded into a loop.
+// Loops are allowed to be bigger, since their bodies are copied once per loop, not once per call.
+#define INLINE_LOOP_MAX_SIZE 256
+
+typedef struct InlineScanStruct {
+	Int budget;
+	Symbol *symbols;
+	Int numSymbols, maxSymbols;
+} *InlineScan;
+
+static void InlineScan_AddSymbol(InlineScan scan, Symbol symbol)
+{
+	Int i;
+	Symbol *newSymbols;
+
+	for (i = 0; i < scan->numSymbols; i++) {
+		if (scan->symbols[i] == symbol)
+			return;
+	}
+
+	if (scan->numSymbols >= scan->maxSymbols) {
+		scan->maxSymbols = scan->maxSymbols ? scan->maxSymbols * 2 : 16;
+		newSymbols = (Symbol *)GC_MALLOC_ATOMIC(sizeof(Symbol) * scan->maxSymbols);
+		if (newSymbols == NULL)
+			Smile_Abort_OutOfMemory();
+		if (scan->numSymbols > 0)
+			MemCpy(newSymbols, scan->symbols, sizeof(Symbol) * scan->numSymbols);
+		scan->symbols = newSymbols;
+	}
+
+	scan->symbols[scan->numSymbols++] = symbol;
+}
+
+/// <summary>
+/// Walk the body of a would-be inlined function, collecting every symbol it mentions, and
+/// making sure that it is small enough and contains nothing that behaves differently once it
+/// is no longer inside its own function.  That means no nested [$fn] (which might capture
+/// the parameters), no [$return] (which would return from the wrong function), and no
+/// [$till] or [$catch] (which would need to unwind through the missing closure).
+/// </summary>
+/// <returns>True if the body can be inlined, False if it cannot.</returns>
+static Bool InlineScan_Walk(InlineScan scan, SmileObject expr)
+{
+	SmileList list;
+	Symbol symbol;
+
+	if (--scan->budget < 0)
+		return False;
+
+	switch (SMILE_KIND(expr)) {
+		case SMILE_KIND_SYMBOL:
+			InlineScan_AddSymbol(scan, ((SmileSymbol)expr)->symbol);
+			return True;
+
+		case SMILE_KIND_LIST:
+			list = (SmileList)expr;
+			if (SMILE_KIND(list->a) == SMILE_KIND_SYMBOL) {
+				symbol = ((SmileSymbol)list->a)->symbol;
+				switch (symbol) {
+					case SMILE_SPECIAL_SYMBOL__FN:
+					case SMILE_SPECIAL_SYMBOL__RETURN:
+					case SMILE_SPECIAL_SYMBOL__TILL:
+					case SMILE_SPECIAL_SYMBOL__CATCH:
+					case SMILE_SPECIAL_SYMBOL__INCLUDE:
+						return False;
+
+					case SMILE_SPECIAL_SYMBOL__QUOTE:
+						return True;
+
+					case SMILE_SPECIAL_SYMBOL__DOT:
+						// Only the object is evaluated; the method name is not a variable.
+						return SMILE_KIND(list->d) != SMILE_KIND_LIST
+							|| InlineScan_Walk(scan, ((SmileList)list->d)->a);
+				}
+			}
+			for (; SMILE_KIND(list) == SMILE_KIND_LIST; list = (SmileList)list->d) {
+				if (!InlineScan_Walk(scan, list->a))
+					return False;
+			}
+			return SMILE_KIND(list) == SMILE_KIND_NULL;
+
+		default:
+			return True;
+	}
+}
+
+/// <summary>
+/// Decide whether the given [$fn] form is small and simple enough to be inlined, and if so,
+/// collect the information needed to inline it, including the current bindings of all of
+/// the symbols its body mentions.
+/// </summary>
+/// <param name="compiler">The compiler, whose current scope is where the function is declared.</param>
+/// <param name="fnArgs">The [$fn] form's arguments, i.e., ([args...] body).</param>
+/// <param name="maxSize">The maximum size of the body, in atoms and list cells.</param>
+/// <param name="selfName">The name the function is being assigned to, if any, so that
+/// recursive functions can be excluded.</param>
+/// <returns>The inlining information for the function, or NULL if it cannot be inlined.</returns>
+static InlineFnInfo Compiler_AnalyzeInlineFn(Compiler compiler, SmileList fnArgs, Int maxSize, Symbol selfName)
+{
+	struct InlineScanStruct scan;
+	SmileList params, temp;
+	InlineFnInfo info;
+	Int numParams, i, j, dest;
+
+	// Must be of the form [$fn [args...] body], where each arg is a plain symbol.
+	if (SMILE_KIND(fnArgs) != SMILE_KIND_LIST
+		|| (SMILE_KIND(fnArgs->a) != SMILE_KIND_LIST && SMILE_KIND(fnArgs->a) != SMILE_KIND_NULL)
+		|| SMILE_KIND(fnArgs->d) != SMILE_KIND_LIST || SMILE_KIND(((SmileList)fnArgs->d)->d) != SMILE_KIND_NULL)
+		return NULL;
+
+	params = (SmileList)fnArgs->a;
+	numParams = 0;
+	for (temp = params; SMILE_KIND(temp) == SMILE_KIND_LIST; temp = (SmileList)temp->d) {
+		if (SMILE_KIND(temp->a) != SMILE_KIND_SYMBOL)
+			return NULL;
+		numParams++;
+	}
+	if (SMILE_KIND(temp) != SMILE_KIND_NULL)
+		return NULL;
+
+	// Walk the body, making sure it's small and simple enough.
+	MemZero(&scan, sizeof(struct InlineScanStruct));
+	scan.budget = maxSize;
+	if (!InlineScan_Walk(&scan, ((SmileList)fnArgs->d)->a))
+		return NULL;
+
+	info = GC_MALLOC_STRUCT(struct InlineFnInfoStruct);
+	if (info == NULL)
+		Smile_Abort_OutOfMemory();
+
+	info->params = (Symbol *)GC_MALLOC_ATOMIC(sizeof(Symbol) * (numParams > 0 ? numParams : 1));
+	if (info->params == NULL)
+		Smile_Abort_OutOfMemory();
+	for (i = 0, temp = params; i < numParams; i++, temp = (SmileList)temp->d) {
+		info->params[i] = ((SmileSymbol)temp->a)->symbol;
+	}
+	info->numParams = numParams;
+	info->body = ((SmileList)fnArgs->d)->a;
+
+	// Record how every other symbol resolves here, so that call sites can make sure they
+	// see the same variables.  Recursive functions and till-flags disqualify the function.
+	info->symbols = (Symbol *)GC_MALLOC_ATOMIC(sizeof(Symbol) * (scan.numSymbols > 0 ? scan.numSymbols : 1));
+	info->bindings = (CompiledLocalSymbol *)GC_MALLOC(sizeof(CompiledLocalSymbol) * (scan.numSymbols > 0 ? scan.numSymbols : 1));
+	if (info->symbols == NULL || info->bindings == NULL)
+		Smile_Abort_OutOfMemory();
+
+	for (i = 0, dest = 0; i < scan.numSymbols; i++) {
+		for (j = 0; j < numParams; j++) {
+			if (info->params[j] == scan.symbols[i])
+				break;
+		}
+		if (j < numParams) continue;
+
+		if (scan.symbols[i] == selfName)
+			return NULL;
+
+		info->symbols[dest] = scan.symbols[i];
+		info->bindings[dest] = CompileScope_FindSymbol(compiler->currentScope, scan.symbols[i]);
+		if (info->bindings[dest] != NULL && info->bindings[dest]->kind == PARSEDECL_TILL)
+			return NULL;
+		dest++;
+	}
+	info->numSymbols = dest;
+
+	return info;
+}
+
+/// <summary>
+/// Make sure that every symbol the inlined function mentions resolves to exactly the same
+/// thing here as it did where the function was declared.
+/// </summary>
+static Bool Compiler_InlineBindingsMatch(Compiler compiler, InlineFnInfo info)
+{
+	Int i;
+
+	for (i = 0; i < info->numSymbols; i++) {
+		if (CompileScope_FindSymbol(compiler->currentScope, info->symbols[i]) != info->bindings[i])
+			return False;
+	}
+
+	return True;
+}
+
+/// <summary>
+/// Count how many times the given symbol is assigned by [$set] or [$opset] anywhere within
+/// the given expression (including inside nested functions).
+/// </summary>
+Int Compiler_CountAssignments(SmileObject expr, Symbol symbol)
+{
+	SmileList list;
+	Int count = 0;
+
+	if (SMILE_KIND(expr) != SMILE_KIND_LIST)
+		return 0;
+
+	list = (SmileList)expr;
+	if (SMILE_KIND(list->a) == SMILE_KIND_SYMBOL && SMILE_KIND(list->d) == SMILE_KIND_LIST) {
+		Symbol head = ((SmileSymbol)list->a)->symbol;
+		SmileList rest = (SmileList)list->d;
+
+		if (head == SMILE_SPECIAL_SYMBOL__QUOTE)
+			return 0;
+		if (head == SMILE_SPECIAL_SYMBOL__OPSET && SMILE_KIND(rest->d) == SMILE_KIND_LIST)
+			rest = (SmileList)rest->d;
+		if ((head == SMILE_SPECIAL_SYMBOL__SET || head == SMILE_SPECIAL_SYMBOL__OPSET)
+			&& SMILE_KIND(rest->a) == SMILE_KIND_SYMBOL && ((SmileSymbol)rest->a)->symbol == symbol)
+			count++;
+	}
+
+	for (; SMILE_KIND(list) == SMILE_KIND_LIST; list = (SmileList)list->d) {
+		count += Compiler_CountAssignments(list->a, symbol);
+	}
+
+	return count;
+}
+
+/// <summary>
+/// Look for variables in a newly-declared [$scope] that are assigned a literal [$fn] exactly
+/// once, as a top-level statement of that scope, and never assigned anywhere else.  Once that
+/// assignment has been compiled, everything after it can safely treat the variable as
+/// holding that exact function, which lets calls to it be inlined.
+/// </summary>
+/// <param name="compiler">The compiler.</param>
+/// <param name="scope">The [$scope] whose variables have just been declared.</param>
+/// <param name="body">The statements in the body of the [$scope].</param>
+void Compiler_FindInlinableAssignments(Compiler compiler, CompileScope scope, SmileList body)
+{
+	SmileList statements, stmt, setArgs;
+	CompiledLocalSymbol localSymbol;
+	Symbol symbol;
+
+	UNUSED(compiler);
+
+	for (statements = body; SMILE_KIND(statements) == SMILE_KIND_LIST; statements = (SmileList)statements->d) {
+		stmt = (SmileList)statements->a;
+
+		// Declarations are usually wrapped in a one-statement [$progn].
+		if (SMILE_KIND(stmt) == SMILE_KIND_LIST && SMILE_KIND(stmt->a) == SMILE_KIND_SYMBOL
+			&& ((SmileSymbol)stmt->a)->symbol == SMILE_SPECIAL_SYMBOL__PROGN
+			&& SMILE_KIND(stmt->d) == SMILE_KIND_LIST && SMILE_KIND(((SmileList)stmt->d)->d) == SMILE_KIND_NULL)
+			stmt = (SmileList)((SmileList)stmt->d)->a;
+
+		// We want exactly [$set symbol [$fn ...]].
+		if (SMILE_KIND(stmt) != SMILE_KIND_LIST || SMILE_KIND(stmt->a) != SMILE_KIND_SYMBOL
+			|| ((SmileSymbol)stmt->a)->symbol != SMILE_SPECIAL_SYMBOL__SET)
+			continue;
+		setArgs = (SmileList)stmt->d;
+		if (SMILE_KIND(setArgs) != SMILE_KIND_LIST || SMILE_KIND(setArgs->a) != SMILE_KIND_SYMBOL
+			|| SMILE_KIND(setArgs->d) != SMILE_KIND_LIST
+			|| !SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__FN, ((SmileList)setArgs->d)->a))
+			continue;
+
+		symbol = ((SmileSymbol)setArgs->a)->symbol;
+		localSymbol = CompileScope_FindSymbolHere(scope, symbol);
+		if (localSymbol == NULL
+			|| (localSymbol->kind != PARSEDECL_VARIABLE && localSymbol->kind != PARSEDECL_SETONCECONST))
+			continue;
+
+		if (Compiler_CountAssignments((SmileObject)body, symbol) == 1)
+			localSymbol->inlineSetArgs = setArgs;
+	}
+}
+
+/// <summary>
+/// Called after compiling [$set symbol value]:  If this is the one assignment found by
+/// Compiler_FindInlinableAssignments(), record the function so that subsequent calls to it
+/// can be inlined.
+/// </summary>
+void Compiler_NoteInlinableAssignment(Compiler compiler, SmileList setArgs, Symbol symbol, SmileObject value)
+{
+	CompiledLocalSymbol localSymbol = CompileScope_FindSymbol(compiler->currentScope, symbol);
+
+	if (localSymbol == NULL || localSymbol->inlineSetArgs != setArgs || localSymbol->inlineFn != NULL)
+		return;
+
+	localSymbol->inlineFn = Compiler_AnalyzeInlineFn(compiler, (SmileList)((SmileList)value)->d, INLINE_CALL_MAX_SIZE, symbol);
+}
+
+/// <summary>
+/// Compile the body of an inlined function, binding its parameters to new locals in a new
+/// scope.  If 'paramIndexes' is non-NULL, the parameters use those (already-allocated) local
+/// variables; otherwise, new locals are allocated for them, and their values are popped off
+/// the stack (last parameter on top).
+/// </summary>
+static CompiledBlock Compiler_CompileInlineBody(Compiler compiler, InlineFnInfo info, Int *paramIndexes, CompileFlags compileFlags)
+{
+	CompileScope scope;
+	CompiledBlock compiledBlock, bodyBlock;
+	IntermediateInstruction instr;
+	Int i, localIndex;
+
+	compiledBlock = CompiledBlock_Create();
+	scope = Compiler_BeginScope(compiler, PARSESCOPE_SCOPEDECL);
+
+	if (paramIndexes != NULL) {
+		for (i = 0; i < info->numParams; i++) {
+			CompileScope_DefineSymbol(scope, info->params[i], PARSEDECL_VARIABLE, paramIndexes[i]);
+		}
+	}
+	else {
+		for (i = 0; i < info->numParams; i++) {
+			localIndex = CompilerFunction_AddLocal(compiler->currentFunction, info->params[i]);
+			CompileScope_DefineSymbol(scope, info->params[i], PARSEDECL_VARIABLE, localIndex);
+		}
+		for (i = info->numParams - 1; i >= 0; i--) {
+			EMIT1(Op_StpLoc0, -1, index = ((CompiledLocalSymbol)Int32Dict_GetValue(scope->symbolDict, info->params[i]))->index);
+		}
+	}
+
+	bodyBlock = Compiler_CompileExpr(compiler, info->body, compileFlags);
+	Compiler_MakeStackMatchCompileFlags(compiler, bodyBlock, compileFlags);
+	CompiledBlock_AppendChild(compiledBlock, bodyBlock);
+
+	Compiler_EndScope(compiler);
+
+	return compiledBlock;
+}
+
+/// <summary>
+/// Try to compile the call [f args...] by inlining f's body, if f is either a literal [$fn]
+/// or a variable known to hold a small literal [$fn].
+/// </summary>
+/// <returns>The compiled call, or NULL if it cannot be inlined (and must be compiled normally).</returns>
+CompiledBlock Compiler_TryCompileInlineCall(Compiler compiler, SmileList list, CompileFlags compileFlags)
+{
+	InlineFnInfo info;
+	CompiledLocalSymbol localSymbol;
+	CompiledBlock compiledBlock, argBlock;
+	SmileList temp;
+	Int numArgs;
+
+	numArgs = SmileList_Length((SmileList)list->d);
+	if (numArgs < 0)
+		return NULL;
+
+	if (SMILE_KIND(list->a) == SMILE_KIND_SYMBOL) {
+		localSymbol = CompileScope_FindSymbol(compiler->currentScope, ((SmileSymbol)list->a)->symbol);
+		if (localSymbol == NULL || (info = localSymbol->inlineFn) == NULL
+			|| !Compiler_InlineBindingsMatch(compiler, info))
+			return NULL;
+	}
+	else if (SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__FN, list->a)) {
+		info = Compiler_AnalyzeInlineFn(compiler, (SmileList)((SmileList)list->a)->d, INLINE_CALL_MAX_SIZE, 0);
+		if (info == NULL)
+			return NULL;
+	}
+	else return NULL;
+
+	if (info->numParams != numArgs)
+		return NULL;
+
+	// Evaluate the arguments in order, in the caller's scope.
+	compiledBlock = CompiledBlock_Create();
+	for (temp = (SmileList)list->d; SMILE_KIND(temp) == SMILE_KIND_LIST; temp = (SmileList)temp->d) {
+		Compiler_SetSourceLocationFromList(compiler, temp);
+		argBlock = Compiler_CompileExpr(compiler, temp->a, compileFlags & ~COMPILE_FLAG_NORESULT);
+		Compiler_EmitRequireResult(compiler, argBlock);
+		CompiledBlock_AppendChild(compiledBlock, argBlock);
+	}
+
+	// Then bind them to the parameters, and evaluate the body in place of the call.
+	CompiledBlock_AppendChild(compiledBlock, Compiler_CompileInlineBody(compiler, info, NULL, compileFlags));
+
+	return compiledBlock;
+}
+
+/// <summary>
+/// Find the built-in method with the given name on the given base object, as it exists right
+/// now, at compile time.  If the method has already been replaced with something that isn't
+/// the original built-in, this returns NULL.
+/// </summary>
+static SmileFunction FindBuiltInMethod(SmileObject base, Symbol symbol)
+{
+	SmileFunction function = (SmileFunction)SMILE_VCALL1(base, getProperty, symbol);
+
+	if (SMILE_KIND(function) != SMILE_KIND_FUNCTION || !SmileFunction_IsBuiltIn(function)
+		|| !String_Equals(function->u.externalFunctionInfo.name, SymbolTable_GetName(Smile_SymbolTable, symbol)))
+		return NULL;
+
+	return function;
+}
+
+/// <summary>
+/// Emit one specialized copy of the loop:  Check that the receiver (in 'receiverIndex') is of
+/// the given kind, and still uses the given built-in method; if it does, iterate it directly,
+/// running the function's body in place; and if it doesn't, branch to 'failLabel'.
+/// </summary>
+static CompiledBlock Compiler_CompileInlineLoopForKind(Compiler compiler, InlineFnInfo info, Symbol symbol,
+	Int kind, SmileFunction builtIn, Int receiverIndex, IntermediateInstruction failLabel, IntermediateInstruction endLabel)
+{
+	CompiledBlock compiledBlock, bodyBlock;
+	IntermediateInstruction instr, topLabel, doneLabel, nextInstr;
+	Int loopIndex, headIndex = 0, tailIndex = 0, paramIndex;
+	Bool isMap = (symbol == Smile_KnownSymbols.map);
+
+	compiledBlock = CompiledBlock_Create();
+	topLabel = IntermediateInstruction_Create(Op_Label);
+	doneLabel = IntermediateInstruction_Create(Op_Label);
+
+	// Guard:  Is this the kind of object we expected, with its original method?
+	EMIT1(Op_LdLoc0, +1, index = receiverIndex);
+	EMIT1(Op_LdObj, +1, index = Compiler_AddObject(compiler, (SmileObject)builtIn));
+	EMIT2(Op_ChkMet, -1, i2.a = (Int32)kind, i2.b = (Int32)symbol);
+	instr = EMIT0(Op_Bf, -1);
+	instr->p.branchTarget = failLabel;
+
+	// Allocate the loop's hidden state, which sits immediately before the parameter variable.
+	if (kind == SMILE_KIND_LIST) {
+		loopIndex = CompilerFunction_AddLocal(compiler->currentFunction, 0);
+		EMIT1(Op_LdLoc0, +1, index = receiverIndex);
+		EMIT1(Op_StpLoc0, -1, index = loopIndex);
+	}
+	else {
+		loopIndex = CompilerFunction_AddLocal(compiler->currentFunction, 0);
+		CompilerFunction_AddLocal(compiler->currentFunction, 0);
+		CompilerFunction_AddLocal(compiler->currentFunction, 0);
+		EMIT1(Op_LdLoc0, +1, index = receiverIndex);
+		EMIT1(Op_ForInit, -1, index = loopIndex);
+	}
+	paramIndex = CompilerFunction_AddLocal(compiler->currentFunction, info->params[0]);
+
+	// A 'map' collects its results after a sentinel head cell.
+	if (isMap) {
+		headIndex = CompilerFunction_AddLocal(compiler->currentFunction, 0);
+		tailIndex = CompilerFunction_AddLocal(compiler->currentFunction, 0);
+		EMIT0(Op_LdNull, +1);
+		EMIT0(Op_LdNull, +1);
+		EMIT0(Op_Cons, -1);
+		EMIT1(Op_StLoc0, 0, index = headIndex);
+		EMIT1(Op_StpLoc0, -1, index = tailIndex);
+	}
+
+	// The loop itself.
+	CompiledBlock_AttachInstruction(compiledBlock, compiledBlock->last, topLabel);
+	nextInstr = EMIT2(kind == SMILE_KIND_LIST ? Op_ListNext : Op_ForNext, 0, i2.a = 0, i2.b = (Int32)loopIndex);
+	nextInstr->p.branchTarget = doneLabel;
+
+	if (isMap) {
+		EMIT1(Op_LdLoc0, +1, index = tailIndex);
+		bodyBlock = Compiler_CompileInlineBody(compiler, info, &paramIndex, 0);
+		CompiledBlock_AppendChild(compiledBlock, bodyBlock);
+		EMIT0(Op_LdNull, +1);
+		EMIT0(Op_Cons, -1);
+		EMIT1(Op_StProp, -1, symbol = Smile_KnownSymbols.d);
+		EMIT1(Op_StpLoc0, -1, index = tailIndex);
+	}
+	else {
+		bodyBlock = Compiler_CompileInlineBody(compiler, info, &paramIndex, COMPILE_FLAG_NORESULT);
+		CompiledBlock_AppendChild(compiledBlock, bodyBlock);
+	}
+
+	instr = EMIT0(Op_Jmp, 0);
+	instr->p.branchTarget = topLabel;
+
+	// Done:  'each' results in the receiver; 'map' results in the collected list.
+	CompiledBlock_AttachInstruction(compiledBlock, compiledBlock->last, doneLabel);
+	if (isMap) {
+		EMIT1(Op_LdLoc0, +1, index = headIndex);
+		EMIT0(Op_Cdr, 0);
+	}
+	else {
+		EMIT1(Op_LdLoc0, +1, index = receiverIndex);
+	}
+	instr = EMIT0(Op_Jmp, 0);
+	instr->p.branchTarget = endLabel;
+
+	return compiledBlock;
+}
+
+/// <summary>
+/// Try to compile [obj.each |x| ...] or [obj.map |x| ...] as a direct bytecode loop, when
+/// the function is a small literal [$fn] of one argument.  Since the type of 'obj' can't be
+/// known until runtime, this emits a guarded loop specialized for Lists (and/or Integer64
+/// Ranges), followed by an ordinary method call that is used if the guards fail.
+/// </summary>
+/// <returns>The compiled loop, or NULL if this call cannot be inlined (and must be compiled normally).</returns>
+CompiledBlock Compiler_TryCompileInlineLoop(Compiler compiler, SmileList dotArgs, SmileList args, CompileFlags compileFlags)
+{
+	Symbol symbol;
+	SmileObject receiver;
+	InlineFnInfo info;
+	SmileFunction listMethod, rangeMethod;
+	CompiledBlock compiledBlock, childBlock;
+	IntermediateInstruction instr, failLabel, endLabel;
+	Int receiverIndex, i, baselineStackDelta;
+	Bool isRange, isList;
+
+	symbol = ((SmileSymbol)LIST_SECOND(dotArgs))->symbol;
+	if (symbol != Smile_KnownSymbols.each && symbol != Smile_KnownSymbols.map)
+		return NULL;
+
+	// Must be exactly one argument, which is a literal [$fn [x] ...].
+	if (SMILE_KIND(args) != SMILE_KIND_LIST || SMILE_KIND(args->d) != SMILE_KIND_NULL
+		|| !SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__FN, args->a))
+		return NULL;
+	info = Compiler_AnalyzeInlineFn(compiler, (SmileList)((SmileList)args->a)->d, INLINE_LOOP_MAX_SIZE, 0);
+	if (info == NULL || info->numParams != 1)
+		return NULL;
+
+	// Figure out which kinds of loops are worth emitting.  A literal range can only be a range,
+	// and a quoted list can only be a list; anything else gets both.
+	receiver = LIST_FIRST(dotArgs);
+	isRange = SMILE_KIND(receiver) == SMILE_KIND_LIST && SMILE_KIND(((SmileList)receiver)->a) == SMILE_KIND_LIST
+		&& SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__DOT, ((SmileList)receiver)->a)
+		&& SMILE_KIND(LIST_SECOND((SmileList)((SmileList)receiver)->a)) == SMILE_KIND_SYMBOL
+		&& ((SmileSymbol)LIST_SECOND((SmileList)((SmileList)receiver)->a))->symbol == Smile_KnownSymbols.range_to;
+	isList = SmileObject_IsCallToSymbol(SMILE_SPECIAL_SYMBOL__QUOTE, receiver);
+
+	listMethod = !isRange ? FindBuiltInMethod((SmileObject)Smile_KnownBases.List, symbol) : NULL;
+	rangeMethod = !isList ? FindBuiltInMethod((SmileObject)Smile_KnownBases.Integer64Range, symbol) : NULL;
+	if (listMethod == NULL && rangeMethod == NULL)
+		return NULL;
+
+	compiledBlock = CompiledBlock_Create();
+	endLabel = IntermediateInstruction_Create(Op_Label);
+
+	// Evaluate the receiver exactly once, and keep it in a hidden local.
+	Compiler_SetSourceLocationFromList(compiler, dotArgs);
+	childBlock = Compiler_CompileExpr(compiler, receiver, compileFlags & ~COMPILE_FLAG_NORESULT);
+	Compiler_EmitRequireResult(compiler, childBlock);
+	CompiledBlock_AppendChild(compiledBlock, childBlock);
+	receiverIndex = CompilerFunction_AddLocal(compiler->currentFunction, 0);
+	EMIT1(Op_StpLoc0, -1, index = receiverIndex);
+
+	// Each specialized loop leaves one result on the stack and jumps to the end, so the stack
+	// is reset back to the baseline between them.
+	baselineStackDelta = compiledBlock->finalStackDelta;
+	for (i = 0; i < 2; i++) {
+		SmileFunction method = (i == 0 ? listMethod : rangeMethod);
+		if (method == NULL) continue;
+
+		failLabel = IntermediateInstruction_Create(Op_Label);
+		childBlock = Compiler_CompileInlineLoopForKind(compiler, info, symbol,
+			i == 0 ? SMILE_KIND_LIST : SMILE_KIND_INTEGER64RANGE, method, receiverIndex, failLabel, endLabel);
+		CompiledBlock_AppendChild(compiledBlock, childBlock);
+		compiledBlock->finalStackDelta = baselineStackDelta;
+		CompiledBlock_AttachInstruction(compiledBlock, compiledBlock->last, failLabel);
+	}
+
+	// Fallback:  Just call the method normally.
+	EMIT1(Op_LdLoc0, +1, index = receiverIndex);
+	Compiler_SetSourceLocationFromList(compiler, args);
+	childBlock = Compiler_CompileExpr(compiler, args->a, compileFlags & ~COMPILE_FLAG_NORESULT);
+	CompiledBlock_AppendChild(compiledBlock, childBlock);
+	EMIT1(Op_Met1, -2 + 1, symbol = symbol);
+
+	CompiledBlock_AttachInstruction(compiledBlock, compiledBlock->last, endLabel);
+
+	Compiler_PopIfNecessary(compiler, compiledBlock, compileFlags);
+
+	return compiledBlock;
+}
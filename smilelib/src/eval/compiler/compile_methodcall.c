@@ -46,6 +46,12 @@ CompiledBlock Compiler_CompileMethodCall(Compiler compiler, SmileList dotArgs, S
 		return CompiledBlock_CreateError();
 	}
 
+	// Calls like [obj.each |x| ...] with a small literal function may be expanded into a direct loop.
+	if (length == 1 && (compiledBlock = Compiler_TryCompileInlineLoop(compiler, dotArgs, args, compileFlags)) != NULL) {
+		Compiler_RevertSourceLocation(compiler, oldSourceLocation);
+		return compiledBlock;
+	}
+
 	compiledBlock = CompiledBlock_Create();
 
 	// Evaluate the left side of the pair (the object to invoke).
@@ -140,13 +140,15 @@ Inline CompiledBlock Compiler_CompileOpEqualsMember(Compiler compiler,
 	// Apply the operator.
 	EMIT1(Op_Met1, -2 + 1, symbol = op);
 
-	// Store the result.
+	// Store the result, discarding whatever the 'set-member' call itself returns.
 	if (compileFlags & COMPILE_FLAG_NORESULT) {
-		EMIT0(Op_StpMember, -3);
+		EMIT0(Op_StpMember, -2);
+		EMIT0(Op_Pop1, -1);
 	}
 	else {
 		EMIT0(Op_LdNull, +1);
 		EMIT0(Op_StMember, -2);
+		EMIT0(Op_Pop1, -1);
 	}
 	return compiledBlock;
 }
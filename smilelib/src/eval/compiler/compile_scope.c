@@ -128,6 +128,8 @@ CompiledBlock Compiler_CompileScope(Compiler compiler, SmileList args, CompileFl
 	SmileList scopeVars, temp;
 	Int numScopeVars, localIndex;
 	CompiledBlock compiledBlock, initBlock;
+	IntermediateInstruction instr;
+	CompiledLocalSymbol localSymbol;
 	Symbol symbol;
 	Int declKind;
 
@@ -164,6 +166,18 @@ CompiledBlock Compiler_CompileScope(Compiler compiler, SmileList args, CompileFl
 		return CompiledBlock_CreateError();
 	}
 
+	// Find any locals that nested functions must share rather than copy, and make their
+	// initializations create the Cells they will live in.
+	Compiler_FindCellVariables(compiler, scope, args);
+	for (instr = initBlock->first; instr != NULL; instr = instr->next) {
+		localSymbol = CompileScope_FindSymbolHere(scope, compiler->currentFunction->localNames[instr->u.index]);
+		if (localSymbol != NULL && localSymbol->inCell)
+			instr->opcode = Op_NullCell0;
+	}
+
+	// Find any locals that will only ever hold one small function, so calls to them can be inlined.
+	Compiler_FindInlinableAssignments(compiler, scope, (SmileList)args->d);
+
 	// Compile the rest of the [scope] as though it was just a [progn].
 	Compiler_SetSourceLocationFromList(compiler, args);
 	compiledBlock = Compiler_CompileProgN(compiler, (SmileList)args->d, compileFlags);
@@ -42,6 +42,7 @@ Inline CompiledBlock Compiler_CompileSetSymbol(Compiler compiler, SmileList args
 	// Store it, leaving a duplicate on the stack.
 	Compiler_SetSourceLocationFromList(compiler, args);
 	Compiler_CompileStoreVariable(compiler, symbol->symbol, compileFlags, compiledBlock);
+	Compiler_NoteInlinableAssignment(compiler, args, symbol->symbol, value);
 	Compiler_RevertSourceLocation(compiler, oldSourceLocation);
 
 	return compiledBlock;
@@ -119,13 +120,16 @@ Inline CompiledBlock Compiler_CompileSetMember(Compiler compiler, SmileList args
 
 	Compiler_SetSourceLocationFromList(compiler, args);
 
+	// The 'set-member' call always pushes its own return value, which we then discard.
 	if (compileFlags & COMPILE_FLAG_NORESULT) {
-		EMIT0(Op_StpMember, -3);
+		EMIT0(Op_StpMember, -2);
+		EMIT0(Op_Pop1, -1);
 		return compiledBlock;
 	}
 	else {
 		EMIT0(Op_LdNull, +1);
 		EMIT0(Op_StMember, -2);
+		EMIT0(Op_Pop1, -1);
 		return compiledBlock;
 	}
 }
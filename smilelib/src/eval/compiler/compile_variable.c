@@ -80,23 +80,28 @@ Inline void Compiler_CompileStoreGlobalVariable(Compiler compiler, Symbol symbol
 }
 
 /// <summary>
-/// Compile a variable load to an argument of a function, either this function, or one of its ancestors.
+/// Compile a variable load from an argument or local variable of a function, either this function,
+/// or one of its ancestors.  An ancestor's variables are reached through this function's captured
+/// variables, which are copied into the function instance when it is created; and a variable that
+/// is boxed in a Cell is unwrapped after it is loaded.
 /// </summary>
-Inline CompiledBlock Compiler_CompileLoadArgument(Compiler compiler, CompiledLocalSymbol localSymbol, CompileFlags compileFlags)
+Inline CompiledBlock Compiler_CompileLoadFunctionVariable(Compiler compiler, CompiledLocalSymbol localSymbol, Int loadOpcode, CompileFlags compileFlags)
 {
 	IntermediateInstruction instr;
 	Int functionDepth = compiler->currentFunction->functionDepth - localSymbol->scope->function->functionDepth;
 	CompiledBlock compiledBlock = CompiledBlock_Create();
 
 	if (!(compileFlags & COMPILE_FLAG_NORESULT)) {
-		if (functionDepth <= 7) {
-			localSymbol->wasReadDeep = True;
-			EMIT1(Op_LdArg0 + functionDepth, +1, index = localSymbol->index);
+		if (functionDepth == 0) {
+			localSymbol->wasRead = True;
+			EMIT1(loadOpcode, +1, index = localSymbol->index);
 		}
 		else {
-			if (functionDepth == 0) localSymbol->wasRead = True;
-			else localSymbol->wasReadDeep = True;
-			EMIT2(Op_LdArg, +1, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
+			localSymbol->wasReadDeep = True;
+			EMIT1(Op_LdLoc1, +1, index = CompilerFunction_CaptureVariable(compiler->currentFunction, localSymbol));
+		}
+		if (localSymbol->inCell) {
+			EMIT0(Op_LdCell, 0);
 		}
 	}
 
@@ -104,90 +109,48 @@ Inline CompiledBlock Compiler_CompileLoadArgument(Compiler compiler, CompiledLoc
 }
 
 /// <summary>
-/// Compile a variable store to an argument of a function, either this function, or one of its ancestors.
+/// Compile a variable store to an argument or local variable of a function, either this function,
+/// or one of its ancestors.  Captured copies can't be assigned, so a store from a nested function
+/// is only possible for a variable that is boxed in a Cell, which both functions share.
 /// </summary>
-Inline void Compiler_CompileStoreArgument(Compiler compiler, CompiledLocalSymbol localSymbol, CompileFlags compileFlags, CompiledBlock compiledBlock)
+Inline void Compiler_CompileStoreFunctionVariable(Compiler compiler, CompiledLocalSymbol localSymbol,
+	Int loadOpcode, Int storeOpcode, Int storePopOpcode, CompileFlags compileFlags, CompiledBlock compiledBlock)
 {
 	IntermediateInstruction instr;
 	Int functionDepth = compiler->currentFunction->functionDepth - localSymbol->scope->function->functionDepth;
 
-	if (functionDepth <= 7) {
-		if (compileFlags & COMPILE_FLAG_NORESULT) {
-			if (functionDepth == 0) localSymbol->wasWritten = True;
-			else localSymbol->wasWrittenDeep = True;
-			EMIT1(Op_StpArg0 + functionDepth, -1, index = localSymbol->index);
-		}
-		else {
-			if (functionDepth == 0) localSymbol->wasWritten = True;
-			else localSymbol->wasWrittenDeep = True;
-			EMIT1(Op_StArg0 + functionDepth, 0, index = localSymbol->index);
+	if (functionDepth == 0) {
+		localSymbol->wasWritten = True;
+		if (localSymbol->inCell) {
+			EMIT1(loadOpcode, +1, index = localSymbol->index);
 		}
-	}
-	else {
-		if (compileFlags & COMPILE_FLAG_NORESULT) {
-			localSymbol->wasWrittenDeep = True;
-			EMIT2(Op_StpArg, -1, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
+		else if (compileFlags & COMPILE_FLAG_NORESULT) {
+			EMIT1(storePopOpcode, -1, index = localSymbol->index);
+			return;
 		}
 		else {
-			localSymbol->wasWrittenDeep = True;
-			EMIT2(Op_StArg, 0, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
+			EMIT1(storeOpcode, 0, index = localSymbol->index);
+			return;
 		}
 	}
-}
-
-/// <summary>
-/// Compile a variable load to a local variable of a function, either this function, or one of its ancestors.
-/// </summary>
-Inline CompiledBlock Compiler_CompileLoadLocalVariable(Compiler compiler, CompiledLocalSymbol localSymbol, CompileFlags compileFlags)
-{
-	IntermediateInstruction instr;
-	Int functionDepth = compiler->currentFunction->functionDepth - localSymbol->scope->function->functionDepth;
-	CompiledBlock compiledBlock = CompiledBlock_Create();
-
-	if (!(compileFlags & COMPILE_FLAG_NORESULT)) {
-		if (functionDepth <= 7) {
-			localSymbol->wasReadDeep = True;
-			EMIT1(Op_LdLoc0 + functionDepth, +1, index = localSymbol->index);
-		}
-		else {
-			if (functionDepth == 0) localSymbol->wasRead = True;
-			else localSymbol->wasReadDeep = True;
-			EMIT2(Op_LdLoc, +1, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
+	else {
+		localSymbol->wasWrittenDeep = True;
+		if (!localSymbol->inCell) {
+			Compiler_AddMessage(compiler, ParseMessage_Create(PARSEMESSAGE_ERROR, NULL,
+				String_Format("Cannot assign to captured variable \"%S\":  Fatal internal error.",
+					SymbolTable_GetName(Smile_SymbolTable, localSymbol->symbol))));
+			compiledBlock->blockFlags |= BLOCK_FLAG_ERROR;
+			return;
 		}
+		EMIT1(Op_LdLoc1, +1, index = CompilerFunction_CaptureVariable(compiler->currentFunction, localSymbol));
 	}
 
-	return compiledBlock;
-}
-
-/// <summary>
-/// Compile a variable store to a local variable of a function, either this function, or one of its ancestors.
-/// </summary>
-Inline void Compiler_CompileStoreLocalVariable(Compiler compiler, CompiledLocalSymbol localSymbol, CompileFlags compileFlags, CompiledBlock compiledBlock)
-{
-	IntermediateInstruction instr;
-	Int functionDepth = compiler->currentFunction->functionDepth - localSymbol->scope->function->functionDepth;
-
-	if (functionDepth <= 7) {
-		if (compileFlags & COMPILE_FLAG_NORESULT) {
-			if (functionDepth == 0) localSymbol->wasWritten = True;
-			else localSymbol->wasWrittenDeep = True;
-			EMIT1(Op_StpLoc0 + functionDepth, -1, index = localSymbol->index);
-		}
-		else {
-			if (functionDepth == 0) localSymbol->wasWritten = True;
-			else localSymbol->wasWrittenDeep = True;
-			EMIT1(Op_StLoc0 + functionDepth, 0, index = localSymbol->index);
-		}
+	// The Cell is now on the stack just above the value, so store through it.
+	if (compileFlags & COMPILE_FLAG_NORESULT) {
+		EMIT0(Op_StpCell, -2);
 	}
 	else {
-		if (compileFlags & COMPILE_FLAG_NORESULT) {
-			localSymbol->wasWrittenDeep = True;
-			EMIT2(Op_StpLoc, -1, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
-		}
-		else {
-			localSymbol->wasWrittenDeep = True;
-			EMIT2(Op_StLoc, 0, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
-		}
+		EMIT0(Op_StCell, -1);
 	}
 }
 
@@ -219,14 +182,10 @@ Inline CompiledBlock Compiler_CompileTillFlag(Compiler compiler, CompiledLocalSy
 	else {
 		// General case:  We need to use the till loop's escape continuation, since
 		// we're inside a nested function.  First, load the escape continuation itself
-		// onto the stack.  (Every flag will reference the same escape continuation, so
-		// the "simple" way of loading a local variable still works.)
-		if (functionDepth <= 7) {
-			EMIT1(Op_LdLoc0 + functionDepth, +1, int32 = (Int32)localSymbol->index);
-		}
-		else {
-			EMIT2(Op_LdLoc, +1, i2.a = (Int32)functionDepth, i2.b = (Int32)localSymbol->index);
-		}
+		// onto the stack.  (Every flag will reference the same escape continuation, which
+		// is stored before any function in the loop body can be created, so it can be
+		// captured like any other variable that never changes.)
+		EMIT1(Op_LdLoc1, +1, index = CompilerFunction_CaptureVariable(compiler->currentFunction, localSymbol));
 		localSymbol->wasReadDeep = True;
 
 		// Now emit the special "till-escape" instruction to invoke the continuation.
@@ -256,12 +215,12 @@ CompiledBlock Compiler_CompileLoadVariable(Compiler compiler, Symbol symbol, Com
 
 	switch (localSymbol->kind) {
 		case PARSEDECL_ARGUMENT:
-			return Compiler_CompileLoadArgument(compiler, localSymbol, compileFlags);
+			return Compiler_CompileLoadFunctionVariable(compiler, localSymbol, Op_LdArg0, compileFlags);
 
 		case PARSEDECL_VARIABLE:
 		case PARSEDECL_CONST:
 		case PARSEDECL_AUTO:
-			return Compiler_CompileLoadLocalVariable(compiler, localSymbol, compileFlags);
+			return Compiler_CompileLoadFunctionVariable(compiler, localSymbol, Op_LdLoc0, compileFlags);
 
 		case PARSEDECL_TILL:
 			return Compiler_CompileTillFlag(compiler, localSymbol, compileFlags);
@@ -297,20 +256,20 @@ void Compiler_CompileStoreVariable(Compiler compiler, Symbol symbol, CompileFlag
 
 	switch (localSymbol->kind) {
 		case PARSEDECL_ARGUMENT:
-			Compiler_CompileStoreArgument(compiler, localSymbol, compileFlags, compiledBlock);
+			Compiler_CompileStoreFunctionVariable(compiler, localSymbol, Op_LdArg0, Op_StArg0, Op_StpArg0, compileFlags, compiledBlock);
 			break;
 
 		case PARSEDECL_VARIABLE:
-			Compiler_CompileStoreLocalVariable(compiler, localSymbol, compileFlags, compiledBlock);
+			Compiler_CompileStoreFunctionVariable(compiler, localSymbol, Op_LdLoc0, Op_StLoc0, Op_StpLoc0, compileFlags, compiledBlock);
 			break;
 
 		case PARSEDECL_SETONCECONST:
-			Compiler_CompileStoreLocalVariable(compiler, localSymbol, compileFlags, compiledBlock);
+			Compiler_CompileStoreFunctionVariable(compiler, localSymbol, Op_LdLoc0, Op_StLoc0, Op_StpLoc0, compileFlags, compiledBlock);
 			localSymbol->kind = PARSEDECL_CONST;
 			break;
 
 		case PARSEDECL_SETONCEAUTO:
-			Compiler_CompileStoreLocalVariable(compiler, localSymbol, compileFlags, compiledBlock);
+			Compiler_CompileStoreFunctionVariable(compiler, localSymbol, Op_LdLoc0, Op_StLoc0, Op_StpLoc0, compileFlags, compiledBlock);
 			localSymbol->kind = PARSEDECL_AUTO;
 			break;
 
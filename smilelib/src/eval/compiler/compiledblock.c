@@ -330,6 +330,13 @@ void CompiledBlock_ResolveBranches(CompiledBlock compiledBlock)
 					? ((Int)instr->p.branchTarget->instructionAddress - (Int)instr->instructionAddress) : 0;
 				break;
 
+			case Op_ForNext:
+			case Op_ListNext:
+				// Loop-stepping instructions keep their branch offset in 'a', next to their local index in 'b'.
+				instr->u.i2.a = instr->p.branchTarget != NULL
+					? (Int32)((Int)instr->p.branchTarget->instructionAddress - (Int)instr->instructionAddress) : 0;
+				break;
+
 			case Op_NewTill:
 				// Till loops need to have all of their branch indexes filled in.
 				// TODO: FIXME: DO THIS.
@@ -25,6 +25,7 @@
 #include <smile/smiletypes/smilefunction.h>
 #include <smile/smiletypes/smileuserobject.h>
 #include <smile/smiletypes/smiletillcontinuation.h>
+#include <smile/smiletypes/smilecell.h>
 #include <smile/smiletypes/text/smilesymbol.h>
 #include <smile/smiletypes/text/smilechar.h>
 #include <smile/smiletypes/text/smileuni.h>
@@ -36,7 +37,10 @@
 #include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/numeric/smilefloat32.h>
 #include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/range/smileinteger64range.h>
 #include <smile/env/modules.h>
+#include <smile/env/weakref.h>
+#include <smile/env/heapcensus.h>
 
 #if ENABLE_INSTRUCTION_TRACING
 #include <stdio.h>
@@ -51,6 +55,8 @@ ByteCode _byteCode;
 
 EscapeContinuation _exceptionContinuation;
 
+static struct EvalStateStruct *_suspendedState;
+
 static Bool Eval_RunCore(void);
 static Bool Is(SmileArg descendant, SmileArg ancestor);
 static void InitModule(ModuleInfo moduleInfo);
@@ -81,6 +87,8 @@ void Eval_BeforeRecurse(struct EvalStateStruct *evalState)
 	evalState->closure = _closure;
 	evalState->byteCode = _byteCode;
 	evalState->exceptionContinuation = _exceptionContinuation;
+	evalState->outer = _suspendedState;
+	_suspendedState = evalState;
 }
 
 void Eval_AfterRecurse(struct EvalStateStruct *evalState)
@@ -90,6 +98,18 @@ void Eval_AfterRecurse(struct EvalStateStruct *evalState)
 	_closure = evalState->closure;
 	_byteCode = evalState->byteCode;
 	_exceptionContinuation = evalState->exceptionContinuation;
+	_suspendedState = evalState->outer;
+}
+
+/// <summary>
+/// Get the most recent evaluation that was suspended by Eval_BeforeRecurse() and has not yet
+/// been resumed by Eval_AfterRecurse().  Its 'outer' link leads to the one suspended before it,
+/// and so on.  Anything that needs to find all of the live closures must look at these too.
+/// </summary>
+/// <returns>The most recently suspended evaluation, or NULL if the current one is the outermost.</returns>
+struct EvalStateStruct *Eval_GetSuspendedState(void)
+{
+	return _suspendedState;
 }
 
 EvalResult Eval_Run(UserFunctionInfo functionInfo)
@@ -106,6 +126,20 @@ EvalResult Eval_Run(UserFunctionInfo functionInfo)
 	return Eval_Continue();
 }
 
+/// <summary>
+/// Begin a state machine that isn't being called by any Smile code, so that the next call to
+/// Eval_Continue() runs it to completion and then stops, rather than returning to a caller.
+/// Save the current evaluation with Eval_BeforeRecurse() before calling this, and restore it
+/// with Eval_AfterRecurse() once Eval_Continue() is done.
+/// </summary>
+ClosureStateMachine Eval_BeginDetachedStateMachine(StateMachine stateMachineStart, StateMachine stateMachineBody)
+{
+	_closure = NULL;
+	_exceptionContinuation = EscapeContinuation_Create(ESCAPE_KIND_EXCEPTION);
+
+	return Eval_BeginStateMachine(stateMachineStart, stateMachineBody);
+}
+
 EvalResult Eval_Continue(void)
 {
 	EvalResult evalResult;
@@ -122,6 +156,10 @@ EvalResult Eval_Continue(void)
 			evalResult->closure = _closure;
 			evalResult->value = SmileArg_Box(Closure_Pop(_closure));
 
+			// Returning from the evaluation is a safe point too.
+			if (OnCollect_PendingCount)
+				OnCollect_RunPending();
+
 			_exceptionContinuation->isValid = False;
 			return evalResult;
 		}
@@ -156,6 +194,23 @@ static void SMILE_NO_RETURN ThrowUnknownMethodError(Symbol name)
 	if (SMILE_KIND(target) != SMILE_KIND_FUNCTION) \
 		ThrowUnknownMethodError(__name__); \
 	SMILE_VCALL2(target, call, __argc__, 0);
+
+// Call a method, but if it resolves to a pure, fully-typed external function whose signature
+// accepts the arguments already on the stack, invoke its C code directly, skipping both the
+// vtable's generic argument checks and the register reload (pure functions can't change them).
+#define SMILE_CALL_METHOD_DIRECT(__obj__, __name__, __argc__) \
+	target = SMILE_GET_PROPERTY(__obj__, __name__); \
+	if (SMILE_KIND(target) != SMILE_KIND_FUNCTION) \
+		ThrowUnknownMethodError(__name__); \
+	if (SmileFunction_IsBuiltIn((SmileFunction)target) \
+		&& SmileFunction_CanCallDirectly((SmileFunction)target, __argc__, closure->stackTop - __argc__)) { \
+		ExternalFunctionInfo info = &((SmileFunction)target)->u.externalFunctionInfo; \
+		closure->stackTop -= __argc__; \
+		arg = info->externalFunction(__argc__, closure->stackTop, info->param); \
+		*closure->stackTop++ = arg; \
+		goto next; \
+	} \
+	SMILE_VCALL2(target, call, __argc__, 0);
 	
 // Ensure that we've stored any of eval's core registers in the global state, so that they can be
 // safely mutated or recorded by external actors.
@@ -166,6 +221,34 @@ static void SMILE_NO_RETURN ThrowUnknownMethodError(Symbol name)
 #define LOAD_REGISTERS \
 	(closure = _closure, byteCode = _byteCode)
 
+// Backward branches are safe points, where any pending on-collect callbacks get to run, and where
+// the symbol table gets swept once enough collectable symbols have piled up:  Every loop passes
+// through one, so a long-running loop can't starve either of them forever.
+#define SAFE_POINT \
+	if (Eval_IsSafePointWorkPending()) { \
+		STORE_REGISTERS; \
+		Eval_RunSafePoint(); \
+		LOAD_REGISTERS; \
+	}
+
+/// <summary>
+/// Determine whether there's anything for a safe point to do.  The symbol table is only swept
+/// from the outermost evaluation, since a suspended one may have symbols in C variables.
+/// </summary>
+Inline Bool Eval_IsSafePointWorkPending(void)
+{
+	return OnCollect_PendingCount || (_suspendedState == NULL && SymbolTable_NeedsSweep(Smile_SymbolTable));
+}
+
+static void Eval_RunSafePoint(void)
+{
+	if (OnCollect_PendingCount)
+		OnCollect_RunPending();
+
+	if (_suspendedState == NULL && SymbolTable_NeedsSweep(Smile_SymbolTable))
+		HeapCensus_CollectSymbols(Smile_SymbolTable);
+}
+
 static Bool Eval_RunCore(void)
 {
 	// We prefer keeping these pointers in registers, because they're used by nearly every instruction.
@@ -371,6 +454,11 @@ next:
 			byteCode++;
 			goto next;
 
+		case Op_LdCell:
+			Closure_SetTop(closure, SmileCell_GetValue((SmileCell)Closure_GetTop(closure).obj));
+			byteCode++;
+			goto next;
+
 		case Op_LdArg:
 			Closure_Push(closure, Closure_GetArgumentInScope(closure, byteCode->u.i2.a, byteCode->u.i2.b));
 			byteCode++;
@@ -386,8 +474,14 @@ next:
 			byteCode++;
 			goto next;
 
+		case Op_StCell:
+			target = Closure_Pop(closure).obj;
+			SmileCell_SetValue((SmileCell)target, Closure_GetTop(closure));
+			byteCode++;
+			goto next;
+
 		//-------------------------------------------------------
-		// 38-3B: Global (eXternal) variable instructions
+		// 38-3B: Global (eXternal) variable instructions (and StpCell)
 
 		case Op_LdX:
 			Closure_UnboxAndPush(closure, Closure_GetGlobalVariable(closure, byteCode->u.symbol));
@@ -404,6 +498,12 @@ next:
 			byteCode++;
 			goto next;
 
+		case Op_StpCell:
+			target = Closure_Pop(closure).obj;
+			SmileCell_SetValue((SmileCell)target, Closure_Pop(closure));
+			byteCode++;
+			goto next;
+
 		//-------------------------------------------------------
 		// 3C-3F: Optimized nulling instructions
 
@@ -420,6 +520,17 @@ next:
 			byteCode++;
 			goto next;
 
+		case Op_NullCell0:
+			// The first time through, the local is still zeroed, so it gets a new Cell; after
+			// that, the Cell is reused, so closures that captured it keep seeing this variable.
+			target = Closure_GetLocalVariableInScope0(closure, byteCode->u.index).obj;
+			if (target == NULL)
+				Closure_SetLocalVariableInScope0(closure, byteCode->u.index, SmileArg_From((SmileObject)SmileCell_Create(SmileArg_From(NullObject))));
+			else
+				SmileCell_SetValue((SmileCell)target, SmileArg_From(NullObject));
+			byteCode++;
+			goto next;
+
 		//-------------------------------------------------------
 		// 40-4F: Optimized local-variable/argument load instructions
 		
@@ -723,7 +834,7 @@ next:
 		case Op_Cdr:
 			target = Closure_GetTop(closure).obj;
 			if (SMILE_KIND(target) == SMILE_KIND_LIST) {
-				value = ((SmileList)target)->a;
+				value = ((SmileList)target)->d;
 			}
 			else {
 				value = NullObject;
@@ -732,8 +843,89 @@ next:
 			byteCode++;
 			goto next;
 
+		case Op_ChkMet:
+			// Guard for a loop the compiler inlined:  The object must be of the expected kind
+			// (lists also permit null), and its method must not have been rebound since compile time.
+			// A kind mismatch or a missing method fails the guard outright, whatever was expected.
+			target = Closure_GetTemp(closure, 1).obj;
+			if (SMILE_KIND(target) == byteCode->u.i2.a
+				|| (byteCode->u.i2.a == SMILE_KIND_LIST && SMILE_KIND(target) == SMILE_KIND_NULL)) {
+				STORE_REGISTERS;
+				value = SMILE_VCALL1(target, getProperty, (Symbol)byteCode->u.i2.b);
+				LOAD_REGISTERS;
+			}
+			else value = NULL;
+			arg = Closure_Pop(closure);
+			Closure_SetTop(closure, SmileUnboxedBool_From(value != NULL && value == arg.obj));
+			byteCode++;
+			goto next;
+
+		case Op_ForInit:
+			{
+				SmileInteger64Range range = (SmileInteger64Range)Closure_Pop(closure).obj;
+				SmileArg *loopVars = &Closure_GetLocalVariableInScope0(closure, byteCode->u.index);
+				Bool up = range->end >= range->start;
+				Bool done = up ? range->stepping <= 0 : range->stepping >= 0;
+
+				// A step of zero means the loop is done (a real zero step never iterates anyway).
+				loopVars[0] = SmileUnboxedInteger64_From(range->start);
+				loopVars[1] = SmileUnboxedInteger64_From(range->end);
+				loopVars[2] = SmileUnboxedInteger64_From(done ? 0 : range->stepping);
+			}
+			byteCode++;
+			goto next;
+
+		case Op_ForNext:
+			{
+				SmileArg *loopVars = &Closure_GetLocalVariableInScope0(closure, byteCode->u.i2.b);
+				Int64 current = loopVars[0].unboxed.i64, end = loopVars[1].unboxed.i64, step = loopVars[2].unboxed.i64;
+
+				if (step == 0) {
+					byteCode += byteCode->u.i2.a;
+					goto next;
+				}
+
+				// Hand out the current value, and then move to the next one, using the exact same
+				// end-of-range test as Integer64Range.each, so that overflow behaves identically.
+				loopVars[3] = loopVars[0];
+				if (step > 0 ? end - step >= current : end - step <= current)
+					loopVars[0].unboxed.i64 = current + step;
+				else loopVars[2].unboxed.i64 = 0;
+			}
+			byteCode++;
+			goto next;
+
+		case Op_ListNext:
+			{
+				SmileArg *loopVars = &Closure_GetLocalVariableInScope0(closure, byteCode->u.i2.b);
+				SmileList list = (SmileList)loopVars[0].obj;
+
+				if (SMILE_KIND(list) != SMILE_KIND_LIST) {
+					byteCode += byteCode->u.i2.a;
+					goto next;
+				}
+
+				loopVars[1] = SmileArg_Unbox(list->a);
+				loopVars[0].obj = list->d;
+			}
+			byteCode++;
+			goto next;
+
+		case Op_NewCell:
+			Closure_SetTop(closure, SmileArg_From((SmileObject)SmileCell_Create(Closure_GetTop(closure))));
+			byteCode++;
+			goto next;
+
 		case Op_NewFn:
-			value = (SmileObject)SmileFunction_CreateUserFunction(_compiledTables->userFunctions[byteCode->u.index], closure);
+			{
+				// A function only keeps the variables it actually captured, copied into a small
+				// closure of their own; if it captured nothing, it only needs the globals.
+				UserFunctionInfo userFunctionInfo = _compiledTables->userFunctions[byteCode->u.index];
+				value = (SmileObject)SmileFunction_CreateUserFunction(userFunctionInfo,
+					userFunctionInfo->captureInfo != NULL
+						? Closure_CreateCaptured(userFunctionInfo->captureInfo, closure, userFunctionInfo->captureSources)
+						: closure->global);
+			}
 			Closure_PushBoxed(closure, value);
 			byteCode++;
 			goto next;
@@ -864,7 +1056,7 @@ next:
 			target = Closure_GetTemp(closure, 0).obj;	// Get the target object
 			byteCode++;	
 			STORE_REGISTERS;	
-			SMILE_CALL_METHOD(target, byteCode[-1].u.symbol, 1);
+			SMILE_CALL_METHOD_DIRECT(target, byteCode[-1].u.symbol, 1);
 			LOAD_REGISTERS;
 			goto next;
 
@@ -872,7 +1064,7 @@ next:
 			target = Closure_GetTemp(closure, 1).obj;	// Get the target object
 			byteCode++;	
 			STORE_REGISTERS;	
-			SMILE_CALL_METHOD(target, byteCode[-1].u.symbol, 2);
+			SMILE_CALL_METHOD_DIRECT(target, byteCode[-1].u.symbol, 2);
 			LOAD_REGISTERS;
 			goto next;
 
@@ -880,7 +1072,7 @@ next:
 			target = Closure_GetTemp(closure, 2).obj;	// Get the target object
 			byteCode++;	
 			STORE_REGISTERS;
-			SMILE_CALL_METHOD(target, byteCode[-1].u.symbol, 3);
+			SMILE_CALL_METHOD_DIRECT(target, byteCode[-1].u.symbol, 3);
 			LOAD_REGISTERS;
 			goto next;
 
@@ -946,6 +1138,10 @@ next:
 		// B0-BF: Flow control
 		
 		case Op_Jmp:
+		take_branch:
+			if (byteCode->u.index <= 0) {
+				SAFE_POINT;
+			}
 			byteCode += byteCode->u.index;
 			goto next;
 
@@ -953,7 +1149,7 @@ next:
 			arg = Closure_Pop(closure);
 			if (SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_BOOL) {
 				if (arg.unboxed.b) {
-					byteCode += byteCode->u.index;
+					goto take_branch;
 				}
 				else {
 					byteCode++;
@@ -963,7 +1159,7 @@ next:
 				STORE_REGISTERS;
 				if (SMILE_VCALL1(arg.obj, toBool, arg.unboxed)) {
 					LOAD_REGISTERS;
-					byteCode += byteCode->u.index;
+					goto take_branch;
 				}
 				else {
 					byteCode++;
@@ -978,7 +1174,7 @@ next:
 					byteCode++;
 				}
 				else {
-					byteCode += byteCode->u.index;
+					goto take_branch;
 				}
 			}
 			else {
@@ -988,7 +1184,7 @@ next:
 					byteCode++;
 				}
 				else {
-					byteCode += byteCode->u.index;
+					goto take_branch;
 				}
 			}
 			goto next;
@@ -1295,9 +1491,8 @@ next:
 		case Op_04: case Op_08: case Op_0C: case Op_0D: case Op_0E:
 		case Op_1D: case Op_1E: case Op_1F:
 		case Op_20: case Op_25: case Op_26: case Op_27: case Op_28: case Op_2D: case Op_2E: case Op_2F:
-		case Op_33: case Op_37: case Op_3B: case Op_3F:
 		case Op_73: case Op_77: case Op_78: case Op_79: case Op_7A: case Op_7B: case Op_7C: case Op_7D: case Op_7E:
-		case Op_83: case Op_87: case Op_8A:
+		case Op_8A:
 		case Op_B3:
 		case Op_C6:
 		case Op_D3: case Op_D7:
@@ -0,0 +1,1493 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+
+#include <smile/gc.h>
+#include <smile/mem.h>
+#include <smile/crypto/dicthash.h>
+#include <smile/numeric/bigint.h>
+#include <smile/numeric/real64.h>
+#include <smile/numeric/realshared.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants and allocation.
+
+static struct BigIntStruct _zero = { 0, 0, { 0 } };
+static struct BigIntStruct _one = { +1, 1, { 1 } };
+
+BigInt BigInt_Zero = &_zero;
+BigInt BigInt_One = &_one;
+
+static const char _digitChars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+#define Min(a, b) ((a) < (b) ? (a) : (b))
+#define Max(a, b) ((a) > (b) ? (a) : (b))
+
+/// <summary>
+/// Allocate a new BigInt with room for the given number of limbs.  The limbs are NOT
+/// initialized, and the result is positive until Normalize() says otherwise.
+/// </summary>
+static BigInt Alloc(Int length)
+{
+	BigInt x = (BigInt)GC_MALLOC_ATOMIC(sizeof(struct BigIntStruct) + sizeof(UInt32) * (length > 0 ? length - 1 : 0));
+	if (x == NULL) Smile_Abort_OutOfMemory();
+	x->sign = +1;
+	x->length = (Int32)length;
+	return x;
+}
+
+/// <summary>
+/// Trim any leading zero limbs from a freshly-computed BigInt, and assign its sign
+/// (or make it zero, if there's nothing left).
+/// </summary>
+static BigInt Normalize(BigInt x, Int sign)
+{
+	Int length = x->length;
+
+	while (length > 0 && x->limbs[length - 1] == 0)
+		length--;
+
+	if (length == 0)
+		return BigInt_Zero;
+
+	x->length = (Int32)length;
+	x->sign = (Int32)sign;
+	return x;
+}
+
+/// <summary>
+/// Get a BigInt whose magnitude matches x, with the given sign (copying x if its sign differs).
+/// </summary>
+static BigInt WithSign(BigInt x, Int sign)
+{
+	BigInt result;
+
+	if (x->sign == 0 || x->sign == sign)
+		return x;
+
+	result = Alloc(x->length);
+	MemCpy(result->limbs, x->limbs, sizeof(UInt32) * x->length);
+	result->sign = (Int32)sign;
+	return result;
+}
+
+/// <summary>
+/// Extract limbs [start, start+count) of the magnitude of x, as a nonnegative BigInt.
+/// </summary>
+static BigInt Slice(BigInt x, Int start, Int count)
+{
+	BigInt result;
+
+	if (start >= x->length || count <= 0)
+		return BigInt_Zero;
+	if (start + count > x->length)
+		count = x->length - start;
+
+	result = Alloc(count);
+	MemCpy(result->limbs, x->limbs + start, sizeof(UInt32) * count);
+	return Normalize(result, +1);
+}
+
+/// <summary>
+/// Multiply x by 2^(32*count), preserving its sign.
+/// </summary>
+static BigInt ShiftLimbsLeft(BigInt x, Int count)
+{
+	BigInt result;
+
+	if (x->sign == 0 || count == 0)
+		return x;
+
+	result = Alloc(x->length + count);
+	MemZero(result->limbs, sizeof(UInt32) * count);
+	MemCpy(result->limbs + count, x->limbs, sizeof(UInt32) * x->length);
+	result->sign = x->sign;
+	return result;
+}
+
+/// <summary>
+/// Divide the magnitude of x by 2^(32*count), discarding the remainder.
+/// </summary>
+Inline BigInt ShiftLimbsRight(BigInt x, Int count)
+{
+	return Slice(x, count, x->length - count);
+}
+
+/// <summary>
+/// Compute hi * 2^(32*k) + lo, where hi is nonnegative and 0 <= lo < 2^(32*k).
+/// </summary>
+static BigInt JoinLimbs(BigInt hi, BigInt lo, Int k)
+{
+	BigInt result;
+
+	if (hi->sign == 0)
+		return lo;
+
+	result = Alloc(k + hi->length);
+	MemCpy(result->limbs, lo->limbs, sizeof(UInt32) * lo->length);
+	MemZero(result->limbs + lo->length, sizeof(UInt32) * (k - lo->length));
+	MemCpy(result->limbs + k, hi->limbs, sizeof(UInt32) * hi->length);
+	return Normalize(result, +1);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Magnitude primitives, which operate on raw limb arrays.
+
+static Int MagCompare(const UInt32 *a, Int alen, const UInt32 *b, Int blen)
+{
+	if (alen != blen)
+		return alen < blen ? -1 : +1;
+
+	while (alen-- > 0) {
+		if (a[alen] != b[alen])
+			return a[alen] < b[alen] ? -1 : +1;
+	}
+
+	return 0;
+}
+
+/// <summary>
+/// dest[0..alen] = a + b, where alen >= blen.  The destination must have room for alen + 1 limbs.
+/// </summary>
+static void MagAdd(UInt32 *dest, const UInt32 *a, Int alen, const UInt32 *b, Int blen)
+{
+	UInt64 carry = 0;
+	Int i;
+
+	for (i = 0; i < blen; i++) {
+		carry += (UInt64)a[i] + b[i];
+		dest[i] = (UInt32)carry;
+		carry >>= 32;
+	}
+	for (; i < alen; i++) {
+		carry += a[i];
+		dest[i] = (UInt32)carry;
+		carry >>= 32;
+	}
+	dest[i] = (UInt32)carry;
+}
+
+/// <summary>
+/// dest[0..alen) = a - b, where a >= b.
+/// </summary>
+static void MagSub(UInt32 *dest, const UInt32 *a, Int alen, const UInt32 *b, Int blen)
+{
+	Int64 diff, borrow = 0;
+	Int i;
+
+	for (i = 0; i < blen; i++) {
+		diff = (Int64)a[i] - b[i] - borrow;
+		dest[i] = (UInt32)diff;
+		borrow = diff < 0;
+	}
+	for (; i < alen; i++) {
+		diff = (Int64)a[i] - borrow;
+		dest[i] = (UInt32)diff;
+		borrow = diff < 0;
+	}
+}
+
+/// <summary>
+/// dest[0..alen+blen) = a * b, by the classic O(n*m) method.  The destination must not overlap
+/// either input.
+/// </summary>
+static void MagMulSchoolbook(UInt32 *dest, const UInt32 *a, Int alen, const UInt32 *b, Int blen)
+{
+	UInt64 ai, carry;
+	Int i, j;
+
+	MemZero(dest, sizeof(UInt32) * (alen + blen));
+
+	for (i = 0; i < alen; i++) {
+		if ((ai = a[i]) == 0) continue;
+		carry = 0;
+		for (j = 0; j < blen; j++) {
+			carry += ai * b[j] + dest[i + j];
+			dest[i + j] = (UInt32)carry;
+			carry >>= 32;
+		}
+		dest[i + blen] = (UInt32)carry;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Construction and conversion.
+
+BigInt BigInt_FromUInt64(UInt64 value)
+{
+	BigInt result;
+
+	if (value == 0)
+		return BigInt_Zero;
+
+	result = Alloc(2);
+	result->limbs[0] = (UInt32)value;
+	result->limbs[1] = (UInt32)(value >> 32);
+	return Normalize(result, +1);
+}
+
+BigInt BigInt_FromInt64(Int64 value)
+{
+	BigInt result;
+
+	if (value >= 0)
+		return BigInt_FromUInt64((UInt64)value);
+
+	result = BigInt_FromUInt64((UInt64)0 - (UInt64)value);
+	result->sign = -1;
+	return result;
+}
+
+/// <summary>
+/// Determine whether the given BigInt can be represented exactly as an Int64.
+/// </summary>
+Bool BigInt_FitsInInt64(BigInt x)
+{
+	UInt64 magnitude;
+
+	if (x->length > 2)
+		return False;
+
+	magnitude = x->length == 0 ? 0
+		: x->length == 1 ? x->limbs[0]
+		: ((UInt64)x->limbs[1] << 32) | x->limbs[0];
+
+	return x->sign < 0 ? magnitude <= (UInt64)1 << 63 : magnitude < (UInt64)1 << 63;
+}
+
+/// <summary>
+/// Convert the given BigInt to an Int64, keeping only its low 64 bits (in two's-complement
+/// form) if it is too large to fit.
+/// </summary>
+Int64 BigInt_ToInt64(BigInt x)
+{
+	UInt64 magnitude;
+
+	magnitude = x->length == 0 ? 0
+		: x->length == 1 ? x->limbs[0]
+		: ((UInt64)x->limbs[1] << 32) | x->limbs[0];
+
+	return x->sign < 0 ? (Int64)((UInt64)0 - magnitude) : (Int64)magnitude;
+}
+
+/// <summary>
+/// Convert the given BigInt to the nearest Float64 (rounding half-to-even), or to infinity
+/// if it is too large for a Float64.
+/// </summary>
+Float64 BigInt_ToFloat64(BigInt x)
+{
+	UInt64 top;
+	Int64 bitLength;
+	Int shift, limb, bit, i;
+	Bool sticky;
+	Float64 result;
+
+	if (x->length <= 2) {
+		top = x->length == 0 ? 0 : x->length == 1 ? x->limbs[0] : ((UInt64)x->limbs[1] << 32) | x->limbs[0];
+		result = (Float64)top;
+		return x->sign < 0 ? -result : result;
+	}
+
+	// Collect the top 64 bits of the magnitude, and fold all of the bits below them into a
+	// single "sticky" bit so that the conversion to double rounds correctly.
+	bitLength = BigInt_BitLength(x);
+	shift = (Int)(bitLength - 64);
+	limb = shift / 32;
+	bit = shift % 32;
+
+	top = ((UInt64)x->limbs[limb + 1] << 32) | x->limbs[limb];
+	if (bit > 0) {
+		top = (top >> bit) | ((UInt64)x->limbs[limb + 2] << (64 - bit));
+	}
+
+	sticky = bit > 0 && (x->limbs[limb] & ((1U << bit) - 1)) != 0;
+	for (i = 0; i < limb && !sticky; i++) {
+		if (x->limbs[i] != 0) sticky = True;
+	}
+	if (sticky) top |= 1;
+
+	result = ldexp((Float64)top, shift);
+	return x->sign < 0 ? -result : result;
+}
+
+/// <summary>
+/// Convert the given Float64 to a BigInt, truncating any fractional part toward zero.
+/// This fails for infinities and NaNs.
+/// </summary>
+Bool BigInt_FromFloat64(Float64 value, BigInt *result)
+{
+	Float64 mantissa;
+	int exponent;
+	BigInt x;
+
+	if (value != value || value - value != 0.0) {
+		*result = BigInt_Zero;
+		return False;
+	}
+
+	if (value > -1.0 && value < 1.0) {
+		*result = BigInt_Zero;
+		return True;
+	}
+
+	// Split the value into a 53-bit integer and a power of two, both exact.
+	mantissa = frexp(value < 0 ? -value : value, &exponent);
+	x = BigInt_FromUInt64((UInt64)ldexp(mantissa, 53));
+	exponent -= 53;
+
+	x = exponent >= 0 ? BigInt_ShiftLeft(x, exponent) : BigInt_ShiftRight(x, -exponent);
+	*result = value < 0 ? BigInt_Neg(x) : x;
+	return True;
+}
+
+/// <summary>
+/// Convert the given BigInt to the nearest Real64, or to infinity if it is too large.
+/// </summary>
+Real64 BigInt_ToReal64(BigInt x)
+{
+	Byte buffer[64];
+	String digits;
+	const Byte *text;
+	Int length, i, dest;
+	Bool sticky;
+	Real64 result;
+
+	if (BigInt_FitsInInt64(x))
+		return Real64_FromInt64(BigInt_ToInt64(x));
+
+	// Real64 holds only sixteen decimal digits, so we keep the first seventeen digits, plus a
+	// "sticky" eighteenth digit that records whether anything nonzero came after them; that's
+	// enough for the decimal parser to round exactly as if it had seen all the digits.
+	digits = BigInt_ToString(BigInt_Abs(x), 10);
+	text = String_GetBytes(digits);
+	length = String_Length(digits);
+
+	dest = 0;
+	if (x->sign < 0)
+		buffer[dest++] = '-';
+	MemCpy(buffer + dest, text, 17);
+	dest += 17;
+
+	sticky = False;
+	for (i = 17; i < length; i++) {
+		if (text[i] != '0') {
+			sticky = True;
+			break;
+		}
+	}
+	buffer[dest++] = sticky ? '1' : '0';
+
+	dest += sprintf((char *)buffer + dest, "e%d", (int)(length - 18));
+
+	Real64_TryParseInternal(buffer, dest, &result);
+	return result;
+}
+
+/// <summary>
+/// Convert the given Real64 to a BigInt, truncating any fractional part toward zero.
+/// This fails for infinities and NaNs.
+/// </summary>
+Bool BigInt_FromReal64(Real64 value, BigInt *result)
+{
+	Byte buffer[64];
+	Int32 length, exponent, kind;
+	BigInt x;
+
+	length = Real64_Decompose(buffer, &exponent, &kind, value);
+
+	if ((kind & ~0x80) != REAL_KIND_POS_NUM && (kind & ~0x80) != REAL_KIND_POS_ZERO) {
+		*result = BigInt_Zero;
+		return False;
+	}
+
+	if (exponent < 0) {
+		// Drop the fractional digits.
+		length += exponent;
+		if (length <= 0) {
+			*result = BigInt_Zero;
+			return True;
+		}
+		exponent = 0;
+	}
+
+	BigInt_TryParse(buffer, length, 10, &x);
+	if (exponent > 0)
+		x = BigInt_Mul(x, BigInt_Pow(BigInt_FromUInt64(10), exponent));
+
+	*result = (kind & 0x80) ? BigInt_Neg(x) : x;
+	return True;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Comparison and hashing.
+
+Int BigInt_Compare(BigInt a, BigInt b)
+{
+	Int cmp;
+
+	if (a->sign != b->sign)
+		return a->sign < b->sign ? -1 : +1;
+
+	cmp = MagCompare(a->limbs, a->length, b->limbs, b->length);
+	return a->sign < 0 ? -cmp : cmp;
+}
+
+/// <summary>
+/// Hash the given BigInt.  Values that fit in an Int64 hash the same way an Int64 does.
+/// </summary>
+UInt32 BigInt_Hash(BigInt x)
+{
+	UInt64 hash;
+	Int i;
+
+	if (BigInt_FitsInInt64(x))
+		return Smile_ApplyHashOracle((UInt64)BigInt_ToInt64(x));
+
+	hash = (UInt64)x->sign;
+	for (i = 0; i < x->length; i++) {
+		hash = (hash * 31) ^ x->limbs[i];
+	}
+	return Smile_ApplyHashOracle(hash);
+}
+
+/// <summary>
+/// Get the number of bits in the magnitude of x (zero for zero).
+/// </summary>
+Int64 BigInt_BitLength(BigInt x)
+{
+	if (x->length == 0)
+		return 0;
+
+	return (Int64)(x->length - 1) * 32 + (32 - UInt32_CountLeadingZeros(x->limbs[x->length - 1]));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Addition and subtraction.
+
+/// <summary>
+/// Compute |a| + |b|, and give it the requested sign.
+/// </summary>
+static BigInt AddMagnitudes(BigInt a, BigInt b, Int sign)
+{
+	BigInt result, temp;
+
+	if (a->length < b->length) {
+		temp = a, a = b, b = temp;
+	}
+
+	result = Alloc(a->length + 1);
+	MagAdd(result->limbs, a->limbs, a->length, b->limbs, b->length);
+	return Normalize(result, sign);
+}
+
+/// <summary>
+/// Compute |a| - |b|, where |a| >= |b|, and give it the requested sign.
+/// </summary>
+static BigInt SubMagnitudes(BigInt a, BigInt b, Int sign)
+{
+	BigInt result;
+
+	result = Alloc(a->length);
+	MagSub(result->limbs, a->limbs, a->length, b->limbs, b->length);
+	return Normalize(result, sign);
+}
+
+BigInt BigInt_Add(BigInt a, BigInt b)
+{
+	Int cmp;
+
+	if (b->sign == 0) return a;
+	if (a->sign == 0) return b;
+
+	if (a->sign == b->sign)
+		return AddMagnitudes(a, b, a->sign);
+
+	cmp = MagCompare(a->limbs, a->length, b->limbs, b->length);
+	if (cmp == 0) return BigInt_Zero;
+	return cmp > 0 ? SubMagnitudes(a, b, a->sign) : SubMagnitudes(b, a, b->sign);
+}
+
+BigInt BigInt_Sub(BigInt a, BigInt b)
+{
+	Int cmp;
+
+	if (b->sign == 0) return a;
+	if (a->sign == 0) return BigInt_Neg(b);
+
+	if (a->sign != b->sign)
+		return AddMagnitudes(a, b, a->sign);
+
+	cmp = MagCompare(a->limbs, a->length, b->limbs, b->length);
+	if (cmp == 0) return BigInt_Zero;
+	return cmp > 0 ? SubMagnitudes(a, b, a->sign) : SubMagnitudes(b, a, -a->sign);
+}
+
+BigInt BigInt_Neg(BigInt x)
+{
+	return WithSign(x, -x->sign);
+}
+
+BigInt BigInt_Abs(BigInt x)
+{
+	return WithSign(x, +1);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Multiplication.
+
+static BigInt MulMagnitudes(BigInt a, BigInt b);
+
+static BigInt MulSchoolbook(BigInt a, BigInt b)
+{
+	BigInt result = Alloc(a->length + b->length);
+	MagMulSchoolbook(result->limbs, a->limbs, a->length, b->limbs, b->length);
+	return Normalize(result, +1);
+}
+
+/// <summary>
+/// Multiply |a| * |b| when one is much longer than the other, by cutting the longer one into
+/// pieces the size of the shorter one, so that each partial product is balanced.
+/// </summary>
+static BigInt MulUnbalanced(BigInt longer, BigInt shorter)
+{
+	BigInt result = BigInt_Zero, piece;
+	Int offset, size = shorter->length;
+
+	for (offset = 0; offset < longer->length; offset += size) {
+		piece = Slice(longer, offset, size);
+		result = BigInt_Add(result, ShiftLimbsLeft(MulMagnitudes(piece, shorter), offset));
+	}
+
+	return result;
+}
+
+/// <summary>
+/// Multiply |a| * |b| by Karatsuba's method:  Split each into halves, and form the
+/// product from three half-size products instead of four.
+/// </summary>
+static BigInt MulKaratsuba(BigInt a, BigInt b)
+{
+	Int half = (Max(a->length, b->length) + 1) / 2;
+	BigInt al, ah, bl, bh, p1, p2, p3, middle;
+
+	al = Slice(a, 0, half);
+	ah = ShiftLimbsRight(a, half);
+	bl = Slice(b, 0, half);
+	bh = ShiftLimbsRight(b, half);
+
+	p1 = MulMagnitudes(ah, bh);
+	p2 = MulMagnitudes(al, bl);
+	p3 = MulMagnitudes(AddMagnitudes(ah, al, +1), AddMagnitudes(bh, bl, +1));
+
+	middle = BigInt_Sub(BigInt_Sub(p3, p1), p2);
+
+	return BigInt_Add(BigInt_Add(ShiftLimbsLeft(p1, half * 2), ShiftLimbsLeft(middle, half)), p2);
+}
+
+/// <summary>
+/// Multiply two signed values, using the fastest available method.
+/// </summary>
+static BigInt MulSigned(BigInt a, BigInt b)
+{
+	BigInt result = MulMagnitudes(a, b);
+	return a->sign * b->sign < 0 ? BigInt_Neg(result) : result;
+}
+
+/// <summary>
+/// Divide a signed value by 3, when it is known to be an exact multiple of 3.
+/// </summary>
+static BigInt DivideExactlyBy3(BigInt x)
+{
+	BigInt result;
+	UInt64 rem = 0;
+	Int i;
+
+	if (x->sign == 0)
+		return x;
+
+	result = Alloc(x->length);
+	for (i = x->length - 1; i >= 0; i--) {
+		rem = (rem << 32) | x->limbs[i];
+		result->limbs[i] = (UInt32)(rem / 3);
+		rem %= 3;
+	}
+	return Normalize(result, x->sign);
+}
+
+/// <summary>
+/// Multiply |a| * |b| by the Toom-Cook 3-way method:  Split each into thirds, evaluate the
+/// resulting polynomials at 0, 1, -1, 2, and infinity, multiply pointwise, and interpolate
+/// (using Bodrato's sequence), forming the product from five third-size products instead
+/// of nine.
+/// </summary>
+static BigInt MulToom3(BigInt a, BigInt b)
+{
+	Int k = (Max(a->length, b->length) + 2) / 3;
+	BigInt a0, a1, a2, b0, b1, b2;
+	BigInt v0, v1, v2, vm1, vinf, t1, t2, tm1, da1, db1, result;
+
+	a0 = Slice(a, 0, k);
+	a1 = Slice(a, k, k);
+	a2 = ShiftLimbsRight(a, k * 2);
+	b0 = Slice(b, 0, k);
+	b1 = Slice(b, k, k);
+	b2 = ShiftLimbsRight(b, k * 2);
+
+	// Evaluation and pointwise multiplication.
+	v0 = MulMagnitudes(a0, b0);
+	da1 = BigInt_Add(a2, a0);
+	db1 = BigInt_Add(b2, b0);
+	vm1 = MulSigned(BigInt_Sub(da1, a1), BigInt_Sub(db1, b1));
+	da1 = BigInt_Add(da1, a1);
+	db1 = BigInt_Add(db1, b1);
+	v1 = MulMagnitudes(da1, db1);
+	v2 = MulSigned(BigInt_Sub(BigInt_ShiftLeft(BigInt_Add(da1, a2), 1), a0),
+		BigInt_Sub(BigInt_ShiftLeft(BigInt_Add(db1, b2), 1), b0));
+	vinf = MulMagnitudes(a2, b2);
+
+	// Interpolation.  The divisions here are all exact.
+	t2 = DivideExactlyBy3(BigInt_Sub(v2, vm1));
+	tm1 = BigInt_ShiftRight(BigInt_Sub(v1, vm1), 1);
+	t1 = BigInt_Sub(v1, v0);
+	t2 = BigInt_ShiftRight(BigInt_Sub(t2, t1), 1);
+	t1 = BigInt_Sub(BigInt_Sub(t1, tm1), vinf);
+	t2 = BigInt_Sub(t2, BigInt_ShiftLeft(vinf, 1));
+	tm1 = BigInt_Sub(tm1, t2);
+
+	// Recomposition.
+	result = BigInt_Add(ShiftLimbsLeft(vinf, k), t2);
+	result = BigInt_Add(ShiftLimbsLeft(result, k), t1);
+	result = BigInt_Add(ShiftLimbsLeft(result, k), tm1);
+	result = BigInt_Add(ShiftLimbsLeft(result, k), v0);
+	return result;
+}
+
+/// <summary>
+/// Multiply |a| * |b|, choosing the multiplication algorithm by the operands' sizes.
+/// </summary>
+static BigInt MulMagnitudes(BigInt a, BigInt b)
+{
+	Int shorter, longer;
+
+	if (a->sign == 0 || b->sign == 0)
+		return BigInt_Zero;
+
+	shorter = Min(a->length, b->length);
+	longer = Max(a->length, b->length);
+
+	if (shorter < BIGINT_KARATSUBA_THRESHOLD)
+		return MulSchoolbook(a, b);
+
+	if (longer >= shorter * 2)
+		return a->length > b->length ? MulUnbalanced(a, b) : MulUnbalanced(b, a);
+
+	if (shorter < BIGINT_TOOM3_THRESHOLD)
+		return MulKaratsuba(a, b);
+
+	return MulToom3(a, b);
+}
+
+BigInt BigInt_Mul(BigInt a, BigInt b)
+{
+	return MulSigned(a, b);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Division.
+
+/// <summary>
+/// Divide |x| by a single limb, returning the quotient (as a nonnegative value) and remainder.
+/// </summary>
+static BigInt DivRemSmall(BigInt x, UInt32 divisor, UInt32 *remainder)
+{
+	BigInt quotient;
+	UInt64 rem = 0;
+	Int i;
+
+	quotient = Alloc(x->length);
+	for (i = x->length - 1; i >= 0; i--) {
+		rem = (rem << 32) | x->limbs[i];
+		quotient->limbs[i] = (UInt32)(rem / divisor);
+		rem %= divisor;
+	}
+
+	*remainder = (UInt32)rem;
+	return Normalize(quotient, +1);
+}
+
+/// <summary>
+/// Divide |a| by |b| using Knuth's Algorithm D (TAOCP vol. 2, 4.3.1), where |a| >= |b| and
+/// |b| has at least two limbs.  Both results are nonnegative.
+/// </summary>
+static void DivRemKnuth(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	Int m = a->length, n = b->length;
+	Int s, i, j;
+	UInt32 *un, *vn;
+	UInt64 num, qhat, rhat, p, carry;
+	Int64 t, k;
+	BigInt q, r;
+
+	un = GC_MALLOC_RAW_ARRAY(UInt32, m + 1);
+	vn = GC_MALLOC_RAW_ARRAY(UInt32, n);
+	if (un == NULL || vn == NULL) Smile_Abort_OutOfMemory();
+
+	q = Alloc(m - n + 1);
+	r = Alloc(n);
+
+	// Normalize, so that the top bit of the divisor is set.
+	s = (Int)UInt32_CountLeadingZeros(b->limbs[n - 1]);
+	if (s > 0) {
+		for (i = n - 1; i > 0; i--)
+			vn[i] = (b->limbs[i] << s) | (b->limbs[i - 1] >> (32 - s));
+		vn[0] = b->limbs[0] << s;
+
+		un[m] = a->limbs[m - 1] >> (32 - s);
+		for (i = m - 1; i > 0; i--)
+			un[i] = (a->limbs[i] << s) | (a->limbs[i - 1] >> (32 - s));
+		un[0] = a->limbs[0] << s;
+	}
+	else {
+		MemCpy(vn, b->limbs, sizeof(UInt32) * n);
+		MemCpy(un, a->limbs, sizeof(UInt32) * m);
+		un[m] = 0;
+	}
+
+	for (j = m - n; j >= 0; j--) {
+
+		// Estimate the next quotient limb, which will be at most one too large.
+		num = ((UInt64)un[j + n] << 32) | un[j + n - 1];
+		qhat = num / vn[n - 1];
+		rhat = num - qhat * vn[n - 1];
+		while (qhat >= ((UInt64)1 << 32) || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+			qhat--;
+			rhat += vn[n - 1];
+			if (rhat >= ((UInt64)1 << 32)) break;
+		}
+
+		// Multiply and subtract.
+		k = 0;
+		for (i = 0; i < n; i++) {
+			p = qhat * vn[i];
+			t = (Int64)un[i + j] - k - (Int64)(p & 0xFFFFFFFF);
+			un[i + j] = (UInt32)t;
+			k = (Int64)(p >> 32) - (t >> 32);
+		}
+		t = (Int64)un[j + n] - k;
+		un[j + n] = (UInt32)t;
+
+		q->limbs[j] = (UInt32)qhat;
+
+		// If we subtracted too much, add one divisor back.
+		if (t < 0) {
+			q->limbs[j]--;
+			carry = 0;
+			for (i = 0; i < n; i++) {
+				carry += (UInt64)un[i + j] + vn[i];
+				un[i + j] = (UInt32)carry;
+				carry >>= 32;
+			}
+			un[j + n] += (UInt32)carry;
+		}
+	}
+
+	// Unnormalize the remainder.
+	if (s > 0) {
+		for (i = 0; i < n; i++)
+			r->limbs[i] = (un[i] >> s) | (un[i + 1] << (32 - s));
+	}
+	else {
+		MemCpy(r->limbs, un, sizeof(UInt32) * n);
+	}
+
+	*quotient = Normalize(q, +1);
+	*remainder = Normalize(r, +1);
+}
+
+/// <summary>
+/// Divide |a| by |b| without using Burnikel-Ziegler, for its base case.
+/// </summary>
+static void DivRemBasic(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	UInt32 rem;
+
+	if (MagCompare(a->limbs, a->length, b->limbs, b->length) < 0) {
+		*quotient = BigInt_Zero;
+		*remainder = BigInt_Abs(a);
+	}
+	else if (b->length == 1) {
+		*quotient = DivRemSmall(a, b->limbs[0], &rem);
+		*remainder = BigInt_FromUInt64(rem);
+	}
+	else {
+		DivRemKnuth(a, b, quotient, remainder);
+	}
+}
+
+static void Divide3n2n(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder);
+
+/// <summary>
+/// Burnikel-Ziegler "2n/1n" division:  Divide a by b, where b has n limbs with its top bit set,
+/// and a < b * 2^(32*n).
+/// </summary>
+static void Divide2n1n(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	Int n = b->length, half;
+	BigInt q1, q2, r1;
+
+	if ((n & 1) != 0 || n < BIGINT_BURNIKEL_ZIEGLER_THRESHOLD) {
+		DivRemBasic(a, b, quotient, remainder);
+		return;
+	}
+
+	half = n / 2;
+
+	Divide3n2n(ShiftLimbsRight(a, half), b, &q1, &r1);
+	Divide3n2n(JoinLimbs(r1, Slice(a, 0, half), half), b, &q2, remainder);
+
+	*quotient = JoinLimbs(q1, q2, half);
+}
+
+/// <summary>
+/// Burnikel-Ziegler "3n/2n" division:  Divide a by b, where b has 2n limbs with its top bit set,
+/// and a < b * 2^(32*n).
+/// </summary>
+static void Divide3n2n(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	Int n = b->length / 2;
+	BigInt a12, a3, b1, b2, q, r1, d, r;
+
+	a12 = ShiftLimbsRight(a, n);
+	a3 = Slice(a, 0, n);
+	b1 = ShiftLimbsRight(b, n);
+	b2 = Slice(b, 0, n);
+
+	if (MagCompare(a12->limbs + Min(n, a12->length), Max(a12->length - n, 0), b1->limbs, b1->length) < 0) {
+		Divide2n1n(a12, b1, &q, &r1);
+		d = MulMagnitudes(q, b2);
+	}
+	else {
+		// The top of a equals b1, so the quotient limb-block is all ones.
+		q = BigInt_Sub(ShiftLimbsLeft(BigInt_One, n), BigInt_One);
+		r1 = BigInt_Add(BigInt_Sub(a12, ShiftLimbsLeft(b1, n)), b1);
+		d = BigInt_Sub(ShiftLimbsLeft(b2, n), b2);
+	}
+
+	// The estimate may be a little too large; correct it.
+	r = BigInt_Sub(JoinLimbs(r1, a3, n), d);
+	while (r->sign < 0) {
+		r = BigInt_Add(r, b);
+		q = BigInt_Sub(q, BigInt_One);
+	}
+
+	*quotient = q;
+	*remainder = r;
+}
+
+/// <summary>
+/// Divide |a| by |b| using the recursive method of Burnikel and Ziegler ("Fast Recursive
+/// Division," 1998), which divides in terms of multiplications, and is therefore
+/// subquadratic when multiplication is.
+/// </summary>
+static void DivRemBurnikelZiegler(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	Int s = b->length, m, j, n, t, i, start, end;
+	Int64 sigma;
+	BigInt aShifted, bShifted, z, qi, ri, q;
+
+	// Choose a block size n that is a multiple of a power of two (so that it can be halved
+	// repeatedly), and shift both values so that the divisor is exactly n limbs with its
+	// top bit set.
+	for (m = 1; m <= s / BIGINT_BURNIKEL_ZIEGLER_THRESHOLD; m <<= 1) ;
+	j = (s + m - 1) / m;
+	n = j * m;
+	sigma = (Int64)n * 32 - BigInt_BitLength(b);
+	if (sigma < 0) sigma = 0;
+
+	bShifted = BigInt_ShiftLeft(BigInt_Abs(b), sigma);
+	aShifted = BigInt_ShiftLeft(BigInt_Abs(a), sigma);
+
+	// Split the dividend into t blocks of n limbs each, with room for one more bit at the top.
+	t = (Int)((BigInt_BitLength(aShifted) + (Int64)n * 32) / ((Int64)n * 32));
+	if (t < 2) t = 2;
+
+	q = Alloc(t * n);
+	MemZero(q->limbs, sizeof(UInt32) * t * n);
+
+	// Start with the top two blocks, and then divide each successive block, carrying the
+	// remainder down into the next one.
+	z = JoinLimbs(ShiftLimbsRight(aShifted, (t - 1) * n), Slice(aShifted, (t - 2) * n, n), n);
+
+	for (i = t - 2; ; i--) {
+		Divide2n1n(z, bShifted, &qi, &ri);
+		MemCpy(q->limbs + i * n, qi->limbs, sizeof(UInt32) * qi->length);
+		if (i == 0) break;
+		start = (i - 1) * n;
+		end = start + n;
+		z = JoinLimbs(ri, Slice(aShifted, start, end - start), n);
+	}
+
+	*quotient = Normalize(q, +1);
+	*remainder = BigInt_ShiftRight(ri, sigma);
+}
+
+/// <summary>
+/// Divide |a| by |b|, where b is nonzero, choosing the division algorithm by the operands' sizes.
+/// Both results are nonnegative.
+/// </summary>
+static void DivRemMagnitudes(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	if (b->length >= BIGINT_BURNIKEL_ZIEGLER_THRESHOLD
+		&& a->length - b->length >= BIGINT_BURNIKEL_ZIEGLER_OFFSET)
+		DivRemBurnikelZiegler(a, b, quotient, remainder);
+	else
+		DivRemBasic(a, b, quotient, remainder);
+}
+
+/// <summary>
+/// Divide a by b, rounding the quotient toward zero, so that the remainder has the sign of a.
+/// </summary>
+/// <returns>True on success, or False if b is zero.</returns>
+Bool BigInt_DivRem(BigInt a, BigInt b, BigInt *quotient, BigInt *remainder)
+{
+	BigInt q, r;
+
+	if (b->sign == 0) {
+		*quotient = *remainder = BigInt_Zero;
+		return False;
+	}
+
+	DivRemMagnitudes(a, b, &q, &r);
+
+	*quotient = WithSign(q, a->sign * b->sign);
+	*remainder = WithSign(r, a->sign);
+	return True;
+}
+
+/// <summary>
+/// Divide a by b, rounding the quotient toward negative infinity, so that the modulus has
+/// the sign of b.
+/// </summary>
+/// <returns>True on success, or False if b is zero.</returns>
+Bool BigInt_DivMod(BigInt a, BigInt b, BigInt *quotient, BigInt *modulus)
+{
+	BigInt q, r;
+
+	if (!BigInt_DivRem(a, b, &q, &r)) {
+		*quotient = *modulus = BigInt_Zero;
+		return False;
+	}
+
+	if (r->sign != 0 && r->sign != b->sign) {
+		q = BigInt_Sub(q, BigInt_One);
+		r = BigInt_Add(r, b);
+	}
+
+	*quotient = q;
+	*modulus = r;
+	return True;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Shifts.
+
+/// <summary>
+/// Shift x left by the given number of bits (or right, if the count is negative).
+/// </summary>
+BigInt BigInt_ShiftLeft(BigInt x, Int64 count)
+{
+	BigInt result;
+	Int limbShift, bitShift, i;
+
+	if (count < 0)
+		return BigInt_ShiftRight(x, -count);
+	if (x->sign == 0 || count == 0)
+		return x;
+
+	limbShift = (Int)(count / 32);
+	bitShift = (Int)(count % 32);
+
+	result = Alloc(x->length + limbShift + 1);
+	MemZero(result->limbs, sizeof(UInt32) * limbShift);
+
+	if (bitShift == 0) {
+		MemCpy(result->limbs + limbShift, x->limbs, sizeof(UInt32) * x->length);
+		result->limbs[x->length + limbShift] = 0;
+	}
+	else {
+		result->limbs[limbShift] = x->limbs[0] << bitShift;
+		for (i = 1; i < x->length; i++)
+			result->limbs[i + limbShift] = (x->limbs[i] << bitShift) | (x->limbs[i - 1] >> (32 - bitShift));
+		result->limbs[x->length + limbShift] = x->limbs[x->length - 1] >> (32 - bitShift);
+	}
+
+	return Normalize(result, x->sign);
+}
+
+/// <summary>
+/// Shift x right by the given number of bits (or left, if the count is negative).  Like an
+/// arithmetic shift on a two's-complement value, this rounds toward negative infinity.
+/// </summary>
+BigInt BigInt_ShiftRight(BigInt x, Int64 count)
+{
+	BigInt result;
+	Int limbShift, bitShift, length, i;
+	Bool lostBits;
+
+	if (count < 0)
+		return BigInt_ShiftLeft(x, -count);
+	if (x->sign == 0 || count == 0)
+		return x;
+
+	if (count >= BigInt_BitLength(x))
+		return x->sign < 0 ? BigInt_FromInt64(-1) : BigInt_Zero;
+
+	limbShift = (Int)(count / 32);
+	bitShift = (Int)(count % 32);
+	length = x->length - limbShift;
+
+	result = Alloc(length);
+	if (bitShift == 0) {
+		MemCpy(result->limbs, x->limbs + limbShift, sizeof(UInt32) * length);
+	}
+	else {
+		for (i = 0; i < length - 1; i++)
+			result->limbs[i] = (x->limbs[i + limbShift] >> bitShift) | (x->limbs[i + limbShift + 1] << (32 - bitShift));
+		result->limbs[length - 1] = x->limbs[x->length - 1] >> bitShift;
+	}
+	result = Normalize(result, x->sign);
+
+	if (x->sign < 0) {
+		lostBits = bitShift > 0 && (x->limbs[limbShift] & ((1U << bitShift) - 1)) != 0;
+		for (i = 0; i < limbShift && !lostBits; i++) {
+			if (x->limbs[i] != 0) lostBits = True;
+		}
+		if (lostBits)
+			result = BigInt_Sub(result, BigInt_One);
+	}
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Powers, roots, and number theory.
+
+/// <summary>
+/// Raise x to the given power, by repeated squaring.
+/// </summary>
+BigInt BigInt_Pow(BigInt x, UInt64 exponent)
+{
+	BigInt result = BigInt_One;
+
+	while (exponent != 0) {
+		if (exponent & 1)
+			result = BigInt_Mul(result, x);
+		exponent >>= 1;
+		if (exponent != 0)
+			x = BigInt_Mul(x, x);
+	}
+
+	return result;
+}
+
+/// <summary>
+/// Compute (x ^ exponent) mod modulus, reducing after every step so that the intermediate
+/// values never grow beyond twice the size of the modulus.  Like BigInt_DivMod(), the result
+/// has the sign of the modulus.
+/// </summary>
+/// <returns>True on success, or False if the modulus is zero or the exponent is negative.</returns>
+Bool BigInt_ModPow(BigInt x, BigInt exponent, BigInt modulus, BigInt *result)
+{
+	BigInt m, value, q;
+	Int64 bit;
+
+	if (modulus->sign == 0 || exponent->sign < 0) {
+		*result = BigInt_Zero;
+		return False;
+	}
+
+	m = BigInt_Abs(modulus);
+	if (m->length == 1 && m->limbs[0] == 1) {
+		*result = BigInt_Zero;
+		return True;
+	}
+
+	BigInt_DivMod(x, m, &q, &x);
+
+	// Left-to-right binary exponentiation.
+	value = BigInt_One;
+	for (bit = BigInt_BitLength(exponent) - 1; bit >= 0; bit--) {
+		DivRemMagnitudes(BigInt_Mul(value, value), m, &q, &value);
+		if (exponent->limbs[bit / 32] & (1U << (bit % 32)))
+			DivRemMagnitudes(BigInt_Mul(value, x), m, &q, &value);
+	}
+
+	if (modulus->sign < 0 && value->sign != 0)
+		value = BigInt_Add(value, modulus);
+
+	*result = value;
+	return True;
+}
+
+/// <summary>
+/// Compute the greatest common divisor of two 64-bit values, by Stein's binary method.
+/// </summary>
+static UInt64 BinaryGcd(UInt64 a, UInt64 b)
+{
+	Int shift;
+
+	if (a == 0) return b;
+	if (b == 0) return a;
+
+	shift = (Int)UInt64_CountTrailingZeros(a | b);
+	a >>= UInt64_CountTrailingZeros(a);
+
+	do {
+		b >>= UInt64_CountTrailingZeros(b);
+		if (a > b) {
+			UInt64 temp = a;
+			a = b;
+			b = temp;
+		}
+		b -= a;
+	} while (b != 0);
+
+	return a << shift;
+}
+
+/// <summary>
+/// Compute the (nonnegative) greatest common divisor of a and b, using Euclid's algorithm
+/// until the values are small enough for the binary method.
+/// </summary>
+BigInt BigInt_Gcd(BigInt a, BigInt b)
+{
+	BigInt q, r;
+
+	a = BigInt_Abs(a);
+	b = BigInt_Abs(b);
+
+	while (b->sign != 0) {
+		if (a->length <= 2 && b->length <= 2)
+			return BigInt_FromUInt64(BinaryGcd((UInt64)BigInt_ToInt64(a), (UInt64)BigInt_ToInt64(b)));
+
+		DivRemMagnitudes(a, b, &q, &r);
+		a = b;
+		b = r;
+	}
+
+	return a;
+}
+
+/// <summary>
+/// Compute the integer square root of x (the largest value whose square is no more than x),
+/// by Newton's method.
+/// </summary>
+/// <returns>True on success, or False if x is negative.</returns>
+Bool BigInt_Sqrt(BigInt x, BigInt *result)
+{
+	BigInt guess, next, q, r;
+
+	if (x->sign <= 0) {
+		*result = BigInt_Zero;
+		return x->sign == 0;
+	}
+
+	// Start from a power of two that is known to be at least as large as the root, so that
+	// the iteration descends monotonically to the answer.
+	guess = BigInt_ShiftLeft(BigInt_One, (BigInt_BitLength(x) + 1) / 2);
+
+	for (;;) {
+		DivRemMagnitudes(x, guess, &q, &r);
+		next = BigInt_ShiftRight(BigInt_Add(guess, q), 1);
+		if (BigInt_Compare(next, guess) >= 0) break;
+		guess = next;
+	}
+
+	*result = guess;
+	return True;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Radix conversion.
+
+/// <summary>
+/// A cache of radix^(2^i), for the divide-and-conquer radix conversions.
+/// </summary>
+typedef struct RadixPowersStruct {
+	Int radix;
+	Int count;
+	BigInt powers[64];
+} *RadixPowers;
+
+static BigInt GetRadixPower(RadixPowers cache, Int n)
+{
+	if (cache->count == 0) {
+		cache->powers[0] = BigInt_FromUInt64((UInt64)cache->radix);
+		cache->count = 1;
+	}
+
+	while (cache->count <= n) {
+		cache->powers[cache->count] = BigInt_Mul(cache->powers[cache->count - 1], cache->powers[cache->count - 1]);
+		cache->count++;
+	}
+
+	return cache->powers[n];
+}
+
+/// <summary>
+/// Determine how many digits in the given radix fit in a single limb, and the value of
+/// radix^(that many digits).
+/// </summary>
+static Int DigitsPerLimb(Int radix, UInt32 *chunk)
+{
+	UInt64 value = (UInt64)radix;
+	Int digits = 1;
+
+	while (value * (UInt64)radix <= 0xFFFFFFFFULL) {
+		value *= (UInt64)radix;
+		digits++;
+	}
+
+	*chunk = (UInt32)value;
+	return digits;
+}
+
+/// <summary>
+/// Write exactly 'width' digits of the nonnegative value x into dest, zero-padded on the
+/// left, by repeated division by the largest power of the radix that fits in a limb.
+/// </summary>
+static void ToStringSmall(BigInt x, Int radix, Byte *dest, Int width)
+{
+	UInt32 *temp, chunk, rem;
+	UInt64 value;
+	Int length, digitsPerLimb, pos, i;
+
+	digitsPerLimb = DigitsPerLimb(radix, &chunk);
+
+	length = x->length;
+	temp = GC_MALLOC_RAW_ARRAY(UInt32, length > 0 ? length : 1);
+	if (temp == NULL) Smile_Abort_OutOfMemory();
+	MemCpy(temp, x->limbs, sizeof(UInt32) * length);
+
+	pos = width;
+	while (length > 0 && pos > 0) {
+		value = 0;
+		for (i = length - 1; i >= 0; i--) {
+			value = (value << 32) | temp[i];
+			temp[i] = (UInt32)(value / chunk);
+			value %= chunk;
+		}
+		while (length > 0 && temp[length - 1] == 0)
+			length--;
+
+		rem = (UInt32)value;
+		for (i = 0; i < digitsPerLimb && pos > 0; i++) {
+			dest[--pos] = _digitChars[rem % radix];
+			rem /= (UInt32)radix;
+		}
+	}
+
+	while (pos > 0)
+		dest[--pos] = '0';
+}
+
+/// <summary>
+/// Write exactly 'width' digits of the nonnegative value x into dest, zero-padded on the
+/// left, where x < radix^width.  Large values are split in half around radix^(2^n) and each
+/// half is converted recursively, which is subquadratic when division is.
+/// </summary>
+static void ToStringRecursive(BigInt x, RadixPowers cache, Byte *dest, Int width)
+{
+	Float64 digitsEstimate;
+	Int n, k;
+	BigInt q, r;
+
+	if (x->length <= BIGINT_RADIX_CONVERSION_THRESHOLD) {
+		ToStringSmall(x, cache->radix, dest, width);
+		return;
+	}
+
+	// Pick the power of the radix closest to the square root of x.
+	digitsEstimate = (Float64)BigInt_BitLength(x) * 0.6931471805599453 / log((Float64)cache->radix);
+	n = (Int)floor(log(digitsEstimate / 2.0) / 0.6931471805599453);
+	if (n < 0) n = 0;
+	k = (Int)1 << n;
+
+	DivRemMagnitudes(x, GetRadixPower(cache, n), &q, &r);
+
+	ToStringRecursive(r, cache, dest + width - k, k);
+	ToStringRecursive(q, cache, dest, width - k);
+}
+
+/// <summary>
+/// Convert x to a string in the given radix (2 to 36), with a leading '-' if it is negative.
+/// Digits above 9 are written as lowercase letters.
+/// </summary>
+String BigInt_ToString(BigInt x, Int radix)
+{
+	struct RadixPowersStruct cache;
+	Byte *buffer, *start;
+	Int width;
+	String result;
+	Byte *dest;
+
+	if (radix < 2 || radix > 36)
+		return NULL;
+	if (x->sign == 0)
+		return String_Create((const Byte *)"0", 1);
+
+	// Compute an upper bound on the number of digits, and write that many (with leading zeros).
+	width = (Int)((Float64)BigInt_BitLength(x) * 0.6931471805599453 / log((Float64)radix)) + 2;
+	buffer = GC_MALLOC_BYTES(width);
+	if (buffer == NULL) Smile_Abort_OutOfMemory();
+
+	cache.radix = radix;
+	cache.count = 0;
+	ToStringRecursive(BigInt_Abs(x), &cache, buffer, width);
+
+	for (start = buffer; start < buffer + width - 1 && *start == '0'; start++) ;
+
+	result = String_CreateInternal((buffer + width - start) + (x->sign < 0));
+	dest = (Byte *)String_GetBytes(result);
+	if (x->sign < 0)
+		*dest++ = '-';
+	MemCpy(dest, start, buffer + width - start);
+
+	return result;
+}
+
+/// <summary>
+/// Convert a sequence of digit values (not characters) to a nonnegative BigInt, by repeated
+/// multiply-and-add of one limb's worth of digits at a time.
+/// </summary>
+static BigInt ParseSmall(const Byte *digits, Int length, Int radix)
+{
+	BigInt result;
+	UInt32 chunk, value, multiplier;
+	UInt64 carry;
+	Int digitsPerLimb, size, take, i, j;
+
+	digitsPerLimb = DigitsPerLimb(radix, &chunk);
+
+	result = Alloc(length / digitsPerLimb + 2);
+	size = 0;
+
+	// The first chunk is whatever is left over, so that all of the rest are full chunks.
+	take = length % digitsPerLimb;
+	if (take == 0) take = digitsPerLimb;
+
+	for (i = 0; i < length; i += take, take = digitsPerLimb) {
+		value = 0;
+		multiplier = 1;
+		for (j = 0; j < take; j++) {
+			value = value * (UInt32)radix + digits[i + j];
+			multiplier *= (UInt32)radix;
+		}
+
+		carry = value;
+		for (j = 0; j < size; j++) {
+			carry += (UInt64)result->limbs[j] * multiplier;
+			result->limbs[j] = (UInt32)carry;
+			carry >>= 32;
+		}
+		if (carry != 0)
+			result->limbs[size++] = (UInt32)carry;
+	}
+
+	result->length = (Int32)size;
+	return Normalize(result, +1);
+}
+
+/// <summary>
+/// Convert a sequence of digit values (not characters) to a nonnegative BigInt.  Long
+/// sequences are split into a high part and a low part of 2^n digits, which are converted
+/// recursively and recombined as high * radix^(2^n) + low, which is subquadratic when
+/// multiplication is.
+/// </summary>
+static BigInt ParseRecursive(const Byte *digits, Int length, RadixPowers cache)
+{
+	UInt32 chunk;
+	Int n, k;
+	BigInt hi, lo;
+
+	if (length <= BIGINT_RADIX_CONVERSION_THRESHOLD * DigitsPerLimb(cache->radix, &chunk))
+		return ParseSmall(digits, length, cache->radix);
+
+	for (n = 0, k = 1; k * 2 < length; n++, k *= 2) ;
+
+	hi = ParseRecursive(digits, length - k, cache);
+	lo = ParseRecursive(digits + length - k, k, cache);
+
+	return BigInt_Add(BigInt_Mul(hi, GetRadixPower(cache, n)), lo);
+}
+
+/// <summary>
+/// Parse a BigInt from text.  This skips leading and trailing whitespace, and accepts an
+/// optional initial '+' or '-'.  Like String_ParseInteger(), apostrophe ('), quote ("), and
+/// underscore (_) are ignored between digits, and digits are recognized in [0-9a-zA-Z],
+/// depending on the radix.
+/// </summary>
+/// <returns>True if the text was a valid integer in the given radix, False if not.</returns>
+Bool BigInt_TryParse(const Byte *text, Int length, Int radix, BigInt *result)
+{
+	struct RadixPowersStruct cache;
+	const Byte *src = text, *end = text + length;
+	Byte *digits, ch, digit;
+	Int numDigits;
+	Bool neg = False;
+	BigInt value;
+
+	*result = BigInt_Zero;
+
+	if (radix < 2 || radix > 36)
+		return False;
+
+	while (src < end && *src <= 32) src++;
+	while (end > src && end[-1] <= 32) end--;
+
+	if (src < end && (*src == '+' || *src == '-')) {
+		neg = (*src == '-');
+		src++;
+	}
+
+	digits = GC_MALLOC_BYTES(end - src + 1);
+	if (digits == NULL) Smile_Abort_OutOfMemory();
+
+	numDigits = 0;
+	for (; src < end; src++) {
+		ch = *src;
+		if (ch == '\'' || ch == '\"' || ch == '_') continue;
+		else if (ch >= '0' && ch <= '9') digit = ch - '0';
+		else if (ch >= 'a' && ch <= 'z') digit = ch - 'a' + 10;
+		else if (ch >= 'A' && ch <= 'Z') digit = ch - 'A' + 10;
+		else return False;
+		if (digit >= radix) return False;
+		digits[numDigits++] = digit;
+	}
+
+	if (numDigits == 0)
+		return False;
+
+	cache.radix = radix;
+	cache.count = 0;
+	value = ParseRecursive(digits, numDigits, &cache);
+
+	*result = neg ? BigInt_Neg(value) : value;
+	return True;
+}
@@ -16,10 +16,9 @@
 //---------------------------------------------------------------------------------------
 
 #include <smile/numeric/float64.h>
-#include <smile/stringbuilder.h>
+#include <smile/numeric/bigint.h>
 #include <smile/internal/staticstring.h>
 
-#include <stdio.h>
 #include <math.h>
 
 STATIC_STRING(Float_String_Zero, "0.0");
@@ -134,17 +133,466 @@ Int Float64_GetKind(Float64 float64)
 	return sign ? FLOAT_KIND_NEG_NUM : FLOAT_KIND_POS_NUM;
 }
 
-String Float64_ToFixedString(Float64 value, Int minIntDigits, Int maxFracDigits, Bool forceSign)
+//-------------------------------------------------------------------------------------------------
+//  Shortest round-trip digit generation.
+//
+//  Floats are converted to decimal using Grisu3 (Loitsch, "Printing Floating-Point Numbers
+//  Quickly and Accurately with Integers", PLDI 2010), which works entirely in 64-bit integer
+//  arithmetic and produces the shortest correctly-rounded digit string for about 99.5% of all
+//  inputs.  For the remainder, Grisu3 knows that it can't be sure of its answer, and we fall
+//  back on the exact (but much slower) BigInt-based algorithm of Steele & White and Burger &
+//  Dybvig.  Neither one depends on the C library or on the current locale.
+
+/// <summary>
+/// A finite, nonzero binary float, decomposed into an integer mantissa and a binary exponent,
+/// so that its value is exactly mantissa * 2^exponent.
+/// </summary>
+typedef struct {
+	UInt64 mantissa;	// The significand, including the hidden bit (if any).
+	Int exponent;		// The binary exponent.
+	Bool lowerBoundaryIsCloser;	// True if the next-lower float is closer than the next-higher float.
+} BinaryFloat;
+
+/// <summary>
+/// A "do-it-yourself" floating-point number, with a full 64-bit significand:  f * 2^e.
+/// </summary>
+typedef struct {
+	UInt64 f;
+	Int e;
+} DiyFp;
+
+/// <summary>
+/// Cached powers of ten, from 10^-348 to 10^340 in steps of 10^8, each normalized to a full
+/// 64-bit significand and correctly rounded.
+/// </summary>
+static const struct {
+	UInt64 significand;
+	Int16 binaryExponent;
+	Int16 decimalExponent;
+} _cachedPowers[] = {
+	{ 0xFA8FD5A0081C0288ULL, -1220, -348 },
+	{ 0xBAAEE17FA23EBF76ULL, -1193, -340 },
+	{ 0x8B16FB203055AC76ULL, -1166, -332 },
+	{ 0xCF42894A5DCE35EAULL, -1140, -324 },
+	{ 0x9A6BB0AA55653B2DULL, -1113, -316 },
+	{ 0xE61ACF033D1A45DFULL, -1087, -308 },
+	{ 0xAB70FE17C79AC6CAULL, -1060, -300 },
+	{ 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+	{ 0xBE5691EF416BD60CULL, -1007, -284 },
+	{ 0x8DD01FAD907FFC3CULL, -980, -276 },
+	{ 0xD3515C2831559A83ULL, -954, -268 },
+	{ 0x9D71AC8FADA6C9B5ULL, -927, -260 },
+	{ 0xEA9C227723EE8BCBULL, -901, -252 },
+	{ 0xAECC49914078536DULL, -874, -244 },
+	{ 0x823C12795DB6CE57ULL, -847, -236 },
+	{ 0xC21094364DFB5637ULL, -821, -228 },
+	{ 0x9096EA6F3848984FULL, -794, -220 },
+	{ 0xD77485CB25823AC7ULL, -768, -212 },
+	{ 0xA086CFCD97BF97F4ULL, -741, -204 },
+	{ 0xEF340A98172AACE5ULL, -715, -196 },
+	{ 0xB23867FB2A35B28EULL, -688, -188 },
+	{ 0x84C8D4DFD2C63F3BULL, -661, -180 },
+	{ 0xC5DD44271AD3CDBAULL, -635, -172 },
+	{ 0x936B9FCEBB25C996ULL, -608, -164 },
+	{ 0xDBAC6C247D62A584ULL, -582, -156 },
+	{ 0xA3AB66580D5FDAF6ULL, -555, -148 },
+	{ 0xF3E2F893DEC3F126ULL, -529, -140 },
+	{ 0xB5B5ADA8AAFF80B8ULL, -502, -132 },
+	{ 0x87625F056C7C4A8BULL, -475, -124 },
+	{ 0xC9BCFF6034C13053ULL, -449, -116 },
+	{ 0x964E858C91BA2655ULL, -422, -108 },
+	{ 0xDFF9772470297EBDULL, -396, -100 },
+	{ 0xA6DFBD9FB8E5B88FULL, -369, -92 },
+	{ 0xF8A95FCF88747D94ULL, -343, -84 },
+	{ 0xB94470938FA89BCFULL, -316, -76 },
+	{ 0x8A08F0F8BF0F156BULL, -289, -68 },
+	{ 0xCDB02555653131B6ULL, -263, -60 },
+	{ 0x993FE2C6D07B7FACULL, -236, -52 },
+	{ 0xE45C10C42A2B3B06ULL, -210, -44 },
+	{ 0xAA242499697392D3ULL, -183, -36 },
+	{ 0xFD87B5F28300CA0EULL, -157, -28 },
+	{ 0xBCE5086492111AEBULL, -130, -20 },
+	{ 0x8CBCCC096F5088CCULL, -103, -12 },
+	{ 0xD1B71758E219652CULL, -77, -4 },
+	{ 0x9C40000000000000ULL, -50, 4 },
+	{ 0xE8D4A51000000000ULL, -24, 12 },
+	{ 0xAD78EBC5AC620000ULL, 3, 20 },
+	{ 0x813F3978F8940984ULL, 30, 28 },
+	{ 0xC097CE7BC90715B3ULL, 56, 36 },
+	{ 0x8F7E32CE7BEA5C70ULL, 83, 44 },
+	{ 0xD5D238A4ABE98068ULL, 109, 52 },
+	{ 0x9F4F2726179A2245ULL, 136, 60 },
+	{ 0xED63A231D4C4FB27ULL, 162, 68 },
+	{ 0xB0DE65388CC8ADA8ULL, 189, 76 },
+	{ 0x83C7088E1AAB65DBULL, 216, 84 },
+	{ 0xC45D1DF942711D9AULL, 242, 92 },
+	{ 0x924D692CA61BE758ULL, 269, 100 },
+	{ 0xDA01EE641A708DEAULL, 295, 108 },
+	{ 0xA26DA3999AEF774AULL, 322, 116 },
+	{ 0xF209787BB47D6B85ULL, 348, 124 },
+	{ 0xB454E4A179DD1877ULL, 375, 132 },
+	{ 0x865B86925B9BC5C2ULL, 402, 140 },
+	{ 0xC83553C5C8965D3DULL, 428, 148 },
+	{ 0x952AB45CFA97A0B3ULL, 455, 156 },
+	{ 0xDE469FBD99A05FE3ULL, 481, 164 },
+	{ 0xA59BC234DB398C25ULL, 508, 172 },
+	{ 0xF6C69A72A3989F5CULL, 534, 180 },
+	{ 0xB7DCBF5354E9BECEULL, 561, 188 },
+	{ 0x88FCF317F22241E2ULL, 588, 196 },
+	{ 0xCC20CE9BD35C78A5ULL, 614, 204 },
+	{ 0x98165AF37B2153DFULL, 641, 212 },
+	{ 0xE2A0B5DC971F303AULL, 667, 220 },
+	{ 0xA8D9D1535CE3B396ULL, 694, 228 },
+	{ 0xFB9B7CD9A4A7443CULL, 720, 236 },
+	{ 0xBB764C4CA7A44410ULL, 747, 244 },
+	{ 0x8BAB8EEFB6409C1AULL, 774, 252 },
+	{ 0xD01FEF10A657842CULL, 800, 260 },
+	{ 0x9B10A4E5E9913129ULL, 827, 268 },
+	{ 0xE7109BFBA19C0C9DULL, 853, 276 },
+	{ 0xAC2820D9623BF429ULL, 880, 284 },
+	{ 0x80444B5E7AA7CF85ULL, 907, 292 },
+	{ 0xBF21E44003ACDD2DULL, 933, 300 },
+	{ 0x8E679C2F5E44FF8FULL, 960, 308 },
+	{ 0xD433179D9C8CB841ULL, 986, 316 },
+	{ 0x9E19DB92B4E31BA9ULL, 1013, 324 },
+	{ 0xEB96BF6EBADF77D9ULL, 1039, 332 },
+	{ 0xAF87023B9BF0EE6BULL, 1066, 340 },
+};
+
+#define CACHED_POWERS_OFFSET 348
+#define CACHED_POWERS_DECIMAL_STEP 8
+#define GRISU_MIN_TARGET_EXPONENT -60
+#define GRISU_MAX_TARGET_EXPONENT -32
+
+static void DecomposeFloat64(Float64 float64, BinaryFloat *binaryFloat)
+{
+	UInt64 bits = *(UInt64 *)&float64;
+	UInt64 fraction = bits & ((1ULL << 52) - 1);
+	Int biasedExponent = (Int)((bits >> 52) & 0x7FF);
+
+	if (biasedExponent == 0) {
+		binaryFloat->mantissa = fraction;
+		binaryFloat->exponent = 1 - 1075;
+	}
+	else {
+		binaryFloat->mantissa = fraction | (1ULL << 52);
+		binaryFloat->exponent = biasedExponent - 1075;
+	}
+	binaryFloat->lowerBoundaryIsCloser = (fraction == 0 && biasedExponent > 1);
+}
+
+static void DecomposeFloat32(Float32 float32, BinaryFloat *binaryFloat)
+{
+	UInt32 bits = *(UInt32 *)&float32;
+	UInt32 fraction = bits & ((1U << 23) - 1);
+	Int biasedExponent = (Int)((bits >> 23) & 0xFF);
+
+	if (biasedExponent == 0) {
+		binaryFloat->mantissa = fraction;
+		binaryFloat->exponent = 1 - 150;
+	}
+	else {
+		binaryFloat->mantissa = fraction | (1U << 23);
+		binaryFloat->exponent = biasedExponent - 150;
+	}
+	binaryFloat->lowerBoundaryIsCloser = (fraction == 0 && biasedExponent > 1);
+}
+
+Inline DiyFp DiyFp_Normalize(UInt64 f, Int e)
+{
+	DiyFp result;
+	Int shift = (Int)UInt64_CountLeadingZeros(f);
+	result.f = f << shift;
+	result.e = e - shift;
+	return result;
+}
+
+/// <summary>
+/// Multiply two DiyFps, keeping the upper (rounded) 64 bits of the 128-bit product.
+/// </summary>
+static DiyFp DiyFp_Multiply(DiyFp x, DiyFp y)
+{
+	DiyFp result;
+	UInt64 a = x.f >> 32, b = x.f & 0xFFFFFFFF;
+	UInt64 c = y.f >> 32, d = y.f & 0xFFFFFFFF;
+	UInt64 ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+	UInt64 mid = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF) + (1U << 31);
+
+	result.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+	result.e = x.e + y.e + 64;
+	return result;
+}
+
+/// <summary>
+/// Find a cached power of ten c = 10^decimalExponent such that multiplying a normalized
+/// DiyFp with binary exponent 'e' by c yields a binary exponent in the Grisu target range.
+/// </summary>
+static DiyFp GetCachedPower(Int e, Int *decimalExponent)
+{
+	DiyFp result;
+	Int minExponent = GRISU_MIN_TARGET_EXPONENT - (e + 64);
+	Int k = (Int)ceil((minExponent + 63) * 0.30102999566398114);
+	Int index = (CACHED_POWERS_OFFSET + k - 1) / CACHED_POWERS_DECIMAL_STEP + 1;
+
+	result.f = _cachedPowers[index].significand;
+	result.e = _cachedPowers[index].binaryExponent;
+	*decimalExponent = _cachedPowers[index].decimalExponent;
+	return result;
+}
+
+/// <summary>
+/// Nudge the last generated digit toward 'w' as far as is safe, and then decide whether the
+/// result is provably both the shortest and the closest.  This is Grisu3's "round and weed" step;
+/// all quantities are in units of the scaled representation.
+/// </summary>
+static Bool RoundWeed(Byte *buffer, Int length, UInt64 distanceTooHighW, UInt64 unsafeInterval,
+	UInt64 rest, UInt64 tenKappa, UInt64 unit)
+{
+	UInt64 smallDistance = distanceTooHighW - unit;
+	UInt64 bigDistance = distanceTooHighW + unit;
+
+	while (rest < smallDistance
+		&& unsafeInterval - rest >= tenKappa
+		&& (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance)) {
+		buffer[length - 1]--;
+		rest += tenKappa;
+	}
+
+	if (rest < bigDistance
+		&& unsafeInterval - rest >= tenKappa
+		&& (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+		return False;
+
+	return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+/// <summary>
+/// Generate the digits of the shortest number in (low, high), as close to w as possible.
+/// </summary>
+static Bool DigitGen(DiyFp low, DiyFp w, DiyFp high, Byte *buffer, Int *length, Int *kappa)
+{
+	UInt64 unit = 1;
+	UInt64 tooLow = low.f - unit;
+	UInt64 tooHigh = high.f + unit;
+	UInt64 unsafeInterval = tooHigh - tooLow;
+	Int shift = -w.e;
+	UInt64 one = 1ULL << shift;
+	UInt32 integrals = (UInt32)(tooHigh >> shift);
+	UInt64 fractionals = tooHigh & (one - 1);
+	UInt32 divisor = 1;
+	UInt64 rest;
+	Int digit;
+
+	*kappa = 1;
+	while ((UInt64)divisor * 10 <= integrals) {
+		divisor *= 10;
+		(*kappa)++;
+	}
+	*length = 0;
+
+	// Generate the integral digits.
+	while (*kappa > 0) {
+		digit = integrals / divisor;
+		buffer[(*length)++] = (Byte)('0' + digit);
+		integrals %= divisor;
+		(*kappa)--;
+		rest = ((UInt64)integrals << shift) + fractionals;
+		if (rest < unsafeInterval)
+			return RoundWeed(buffer, *length, tooHigh - w.f, unsafeInterval, rest, (UInt64)divisor << shift, unit);
+		divisor /= 10;
+	}
+
+	// Generate the fractional digits.
+	for (;;) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafeInterval *= 10;
+		digit = (Int)(fractionals >> shift);
+		buffer[(*length)++] = (Byte)('0' + digit);
+		fractionals &= one - 1;
+		(*kappa)--;
+		if (fractionals < unsafeInterval)
+			return RoundWeed(buffer, *length, (tooHigh - w.f) * unit, unsafeInterval, fractionals, one, unit);
+	}
+}
+
+/// <summary>
+/// Try to generate the shortest digits of the given float using Grisu3.  This fails (returns
+/// False) for the roughly 0.5% of inputs where 64 bits of precision aren't enough to be sure.
+/// </summary>
+static Bool Grisu3(const BinaryFloat *binaryFloat, Byte *buffer, Int *length, Int *decimalPoint)
+{
+	DiyFp w, plus, minus, tenMk;
+	Int mk, kappa;
+	UInt64 f = binaryFloat->mantissa;
+	Int e = binaryFloat->exponent;
+
+	w = DiyFp_Normalize(f, e);
+	plus = DiyFp_Normalize((f << 1) + 1, e - 1);
+	if (binaryFloat->lowerBoundaryIsCloser) {
+		minus.f = (f << 2) - 1;
+		minus.e = e - 2;
+	}
+	else {
+		minus.f = (f << 1) - 1;
+		minus.e = e - 1;
+	}
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+
+	tenMk = GetCachedPower(w.e, &mk);
+
+	if (!DigitGen(DiyFp_Multiply(minus, tenMk), DiyFp_Multiply(w, tenMk), DiyFp_Multiply(plus, tenMk),
+		buffer, length, &kappa))
+		return False;
+
+	*decimalPoint = *length + kappa - mk;
+	return True;
+}
+
+/// <summary>
+/// Generate the shortest digits of the given float exactly, using BigInts.  This always
+/// succeeds, and treats the rounding boundaries as inclusive when the mantissa is even, just
+/// as round-half-even parsing does.
+/// </summary>
+static Int ExactShortestDigits(const BinaryFloat *binaryFloat, Byte *buffer, Int *decimalPoint)
+{
+	BigInt r, s, mPlus, mMinus, digit, ten = BigInt_FromInt64(10);
+	Bool inclusive = !(binaryFloat->mantissa & 1);
+	Int shift = binaryFloat->lowerBoundaryIsCloser ? 2 : 1;
+	Int e = binaryFloat->exponent;
+	Int k, length = 0, cmp, d;
+	Bool low, high;
+
+	// Set up v = r/s, where the gaps to the neighboring floats are mPlus/s and mMinus/s (doubled,
+	// so that the halfway points are integers too).
+	r = BigInt_ShiftLeft(BigInt_FromUInt64(binaryFloat->mantissa), (e > 0 ? e : 0) + shift);
+	s = BigInt_ShiftLeft(BigInt_One, (e < 0 ? -e : 0) + shift);
+	mMinus = BigInt_ShiftLeft(BigInt_One, e > 0 ? e : 0);
+	mPlus = binaryFloat->lowerBoundaryIsCloser ? BigInt_ShiftLeft(mMinus, 1) : mMinus;
+
+	// Estimate k = ceil(log10(v)), which may be low by one or two, and then scale by 10^k.
+	k = (Int)ceil((e + 63 - (Int)UInt64_CountLeadingZeros(binaryFloat->mantissa)) * 0.30102999566398114 - 1e-10);
+	if (k >= 0)
+		s = BigInt_Mul(s, BigInt_Pow(ten, (UInt64)k));
+	else {
+		BigInt scale = BigInt_Pow(ten, (UInt64)-k);
+		r = BigInt_Mul(r, scale);
+		mPlus = BigInt_Mul(mPlus, scale);
+		mMinus = BigInt_Mul(mMinus, scale);
+	}
+	for (;;) {
+		cmp = BigInt_Compare(BigInt_Add(r, mPlus), s);
+		if (inclusive ? cmp < 0 : cmp <= 0) break;
+		s = BigInt_Mul(s, ten);
+		k++;
+	}
+
+	// Generate digits until the remainder is within the rounding interval.
+	for (;;) {
+		r = BigInt_Mul(r, ten);
+		mPlus = BigInt_Mul(mPlus, ten);
+		mMinus = BigInt_Mul(mMinus, ten);
+		BigInt_DivRem(r, s, &digit, &r);
+		d = (Int)BigInt_ToInt64(digit);
+
+		cmp = BigInt_Compare(r, mMinus);
+		low = inclusive ? cmp <= 0 : cmp < 0;
+		cmp = BigInt_Compare(BigInt_Add(r, mPlus), s);
+		high = inclusive ? cmp >= 0 : cmp > 0;
+
+		if (!low && !high) {
+			buffer[length++] = (Byte)('0' + d);
+			continue;
+		}
+
+		if (low && high) {
+			cmp = BigInt_Compare(BigInt_ShiftLeft(r, 1), s);
+			if (cmp > 0 || (cmp == 0 && (d & 1))) d++;
+		}
+		else if (high) d++;
+
+		buffer[length++] = (Byte)('0' + d);
+		break;
+	}
+
+	*decimalPoint = k;
+	return length;
+}
+
+static Int ShortestDigits(const BinaryFloat *binaryFloat, Byte *buffer, Int *decimalPoint)
+{
+	Int length;
+
+	if (Grisu3(binaryFloat, buffer, &length, decimalPoint))
+		return length;
+
+	return ExactShortestDigits(binaryFloat, buffer, decimalPoint);
+}
+
+/// <summary>
+/// Compute the shortest decimal digit string that will parse back to exactly the given value.
+/// </summary>
+/// <param name="float64">The value to convert, which must be finite and nonzero.  Its sign is ignored.</param>
+/// <param name="digits">A buffer that will receive the ASCII digits, which must be at least
+/// FLOAT64_MAX_SHORTEST_DIGITS bytes long.  It is not nul-terminated.</param>
+/// <param name="decimalPoint">This will be set to the position of the decimal point relative to
+/// the start of the digits, so that the value is 0.digits * 10^decimalPoint.</param>
+/// <returns>The number of digits generated, which will never have trailing zeros.</returns>
+Int Float64_ToShortestDigits(Float64 float64, Byte *digits, Int *decimalPoint)
 {
-	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
-	char numberBuffer[256];
-	char *start = numberBuffer;
-	char *dot, *end;
-	Int kind;
-	Int digitsPrinted;
+	BinaryFloat binaryFloat;
+	DecomposeFloat64(float64, &binaryFloat);
+	return ShortestDigits(&binaryFloat, digits, decimalPoint);
+}
+
+/// <summary>
+/// Compute the shortest decimal digit string that will parse back to exactly the given value,
+/// when parsed as a Float32.  This is the same as Float64_ToShortestDigits(), but uses the
+/// (much wider) Float32 rounding interval, so that 0.1f yields "1" rather than "100000001490116".
+/// </summary>
+Int Float32_ToShortestDigits(Float32 float32, Byte *digits, Int *decimalPoint)
+{
+	BinaryFloat binaryFloat;
+	DecomposeFloat32(float32, &binaryFloat);
+	return ShortestDigits(&binaryFloat, digits, decimalPoint);
+}
+
+//-------------------------------------------------------------------------------------------------
+//  String formatting.
+
+/// <summary>
+/// Exactly round mantissa * 2^exponent * 10^scale to the nearest integer (ties to even), and
+/// return its decimal digits.  This is used only when the caller has limited the number of
+/// digits to fewer than the shortest round-trip form needs.
+/// </summary>
+static String RoundScaledExact(const BinaryFloat *binaryFloat, Int scale)
+{
+	BigInt n = BigInt_FromUInt64(binaryFloat->mantissa);
+	BigInt d = BigInt_One;
+	BigInt ten = BigInt_FromInt64(10), q, r;
+	Int cmp;
+
+	if (scale > 0) n = BigInt_Mul(n, BigInt_Pow(ten, (UInt64)scale));
+	else if (scale < 0) d = BigInt_Pow(ten, (UInt64)-scale);
+
+	if (binaryFloat->exponent > 0) n = BigInt_ShiftLeft(n, binaryFloat->exponent);
+	else if (binaryFloat->exponent < 0) d = BigInt_ShiftLeft(d, -binaryFloat->exponent);
 
-	kind = Float64_GetKind(value);
+	BigInt_DivRem(n, d, &q, &r);
+	cmp = BigInt_Compare(BigInt_ShiftLeft(r, 1), d);
+	if (cmp > 0 || (cmp == 0 && BigInt_IsOdd(q)))
+		q = BigInt_Add(q, BigInt_One);
 
+	return BigInt_ToString(q, 10);
+}
+
+/// <summary>
+/// Return the fixed string for a special value (infinity or NaN), or NULL if the kind is an
+/// ordinary number or zero.
+/// </summary>
+static String SpecialFloatString(Int kind, Bool forceSign)
+{
 	switch (kind) {
 		case FLOAT_KIND_POS_INF:
 			return forceSign ? Float_String_PosInf : Float_String_Inf;
@@ -158,122 +606,257 @@ String Float64_ToFixedString(Float64 value, Int minIntDigits, Int maxFracDigits,
 			return forceSign ? Float_String_PosSNaN : Float_String_SNaN;
 		case FLOAT_KIND_NEG_SNAN:
 			return Float_String_NegSNaN;
-		case FLOAT_KIND_POS_ZERO:
-		case FLOAT_KIND_POS_NUM:
-			if (forceSign) *start++ = '+';
-			break;
-		case FLOAT_KIND_NEG_ZERO:
-		case FLOAT_KIND_NEG_NUM:
-			*start++ = '-';
-			value = -value;
-			break;
+		default:
+			return NULL;
+	}
+}
+
+/// <summary>
+/// Strip trailing zeros from a digit string that contains at least one nonzero digit.
+/// </summary>
+Inline Int TrimTrailingZeros(const Byte *digits, Int length)
+{
+	while (length > 1 && digits[length - 1] == '0') length--;
+	return length;
+}
+
+/// <summary>
+/// Format the given digits (whose value is 0.digits * 10^decimalPoint) in fixed-point form, writing
+/// directly into a new string of exactly the right length.
+/// </summary>
+static String FormatFixed(const Byte *digits, Int length, Int decimalPoint, Bool negative, Bool forceSign, Int minIntDigits)
+{
+	Int numIntDigits = decimalPoint > 0 ? decimalPoint : 1;
+	Int intWidth = numIntDigits > minIntDigits ? numIntDigits : minIntDigits;
+	Int numFracDigits = decimalPoint >= length ? 1 : length - decimalPoint;
+	Bool hasSign = negative || forceSign;
+	String str = String_CreateInternal(hasSign + intWidth + 1 + numFracDigits);
+	Byte *dest = str->_opaque.text;
+	Int i;
+
+	if (hasSign) *dest++ = negative ? '-' : '+';
+	for (i = numIntDigits; i < intWidth; i++) *dest++ = '0';
+
+	if (decimalPoint <= 0)
+		*dest++ = '0';
+	else {
+		for (i = 0; i < decimalPoint; i++)
+			*dest++ = i < length ? digits[i] : '0';
+	}
+
+	*dest++ = '.';
+
+	if (decimalPoint >= length)
+		*dest++ = '0';
+	else {
+		for (i = decimalPoint; i < 0; i++) *dest++ = '0';
+		for (i = decimalPoint > 0 ? decimalPoint : 0; i < length; i++) *dest++ = digits[i];
+	}
+
+	return str;
+}
+
+/// <summary>
+/// Format the given digits (whose value is 0.digits * 10^decimalPoint) in exponential form,
+/// like "1.25e+7", writing directly into a new string of exactly the right length.
+/// </summary>
+static String FormatExp(const Byte *digits, Int length, Int decimalPoint, Bool negative, Bool forceSign)
+{
+	Int exponent = decimalPoint - 1;
+	UInt64 absExponent = exponent < 0 ? (UInt64)-exponent : (UInt64)exponent;
+	Int numExpDigits = absExponent >= 100 ? 3 : absExponent >= 10 ? 2 : 1;
+	Bool hasSign = negative || forceSign;
+	String str = String_CreateInternal(hasSign + 1 + (length > 1 ? length : 0) + 2 + numExpDigits);
+	Byte *dest = str->_opaque.text;
+	Int i;
+
+	if (hasSign) *dest++ = negative ? '-' : '+';
+
+	*dest++ = digits[0];
+	if (length > 1) {
+		*dest++ = '.';
+		for (i = 1; i < length; i++) *dest++ = digits[i];
+	}
+
+	*dest++ = 'e';
+	*dest++ = exponent < 0 ? '-' : '+';
+	for (i = numExpDigits; i > 0; i--) {
+		dest[i - 1] = (Byte)('0' + absExponent % 10);
+		absExponent /= 10;
+	}
+
+	return str;
+}
+
+static String BinaryFloatToFixedString(const BinaryFloat *binaryFloat, Bool isZero, Bool negative, Int minIntDigits, Int maxFracDigits, Bool forceSign)
+{
+	Byte buffer[32];
+	const Byte *digits = buffer;
+	Int length, decimalPoint;
+	String rounded;
+
+	if (isZero) {
+		buffer[0] = '0';
+		return FormatFixed(buffer, 1, 1, negative, forceSign, minIntDigits);
 	}
 
-	// Use sprintf to actually format the number (safely).
-	if (maxFracDigits < 1) maxFracDigits = 1;
-	snprintf(start, numberBuffer + sizeof(numberBuffer) - start, "%.*f",
-		(Int32)maxFracDigits, value);
-	numberBuffer[sizeof(numberBuffer) - 1] = '\0';
-
-	// Trim any trailing zeros, but ensure that there's always one digit after the decimal point.
-	end = start + strlen(start);
-	while (end > start && end[-1] == '0') end--;
-	if (end == start) end++;
-	else if (end[-1] == '.') {
-		*end++ = '0';
+	length = ShortestDigits(binaryFloat, buffer, &decimalPoint);
+
+	if (maxFracDigits > 0 && length - decimalPoint > maxFracDigits) {
+		// The shortest form has too many fractional digits, so round the exact value instead.
+		rounded = RoundScaledExact(binaryFloat, maxFracDigits);
+		digits = String_GetBytes(rounded);
+		length = String_Length(rounded);
+		decimalPoint = length - maxFracDigits;
+		if (length == 1 && digits[0] == '0')
+			decimalPoint = 1;
+		length = TrimTrailingZeros(digits, length);
 	}
-	*end = '\0';
 
-	// Find out where the decimal point ended up.
-	dot = strchr(start, '.');
+	return FormatFixed(digits, length, decimalPoint, negative, forceSign, minIntDigits);
+}
 
-	// If we printed enough digits before the decimal point to satisfy
-	// 'minIntDigits', then we're done.
-	digitsPrinted = (dot == NULL ? strlen(start) : dot - start);
-	if (digitsPrinted >= minIntDigits)
-		return String_FromC(numberBuffer);
+static String BinaryFloatToExpString(const BinaryFloat *binaryFloat, Bool isZero, Bool negative, Int maxFracDigits, Bool forceSign)
+{
+	Byte buffer[32];
+	const Byte *digits = buffer;
+	Int length, decimalPoint, maxDigits;
+	String rounded;
+
+	if (isZero) {
+		buffer[0] = '0';
+		return FormatExp(buffer, 1, 1, negative, forceSign);
+	}
 
-	// Padding is required.  So first, make a place to put the padding.
-	INIT_INLINE_STRINGBUILDER(stringBuilder);
+	length = ShortestDigits(binaryFloat, buffer, &decimalPoint);
+
+	maxDigits = maxFracDigits + 1;
+	if (maxFracDigits > 0 && length > maxDigits) {
+		// The shortest form has too many significant digits, so round the exact value instead.
+		rounded = RoundScaledExact(binaryFloat, maxDigits - decimalPoint);
+		digits = String_GetBytes(rounded);
+		length = String_Length(rounded);
+		if (length > maxDigits)
+			decimalPoint++;
+		length = TrimTrailingZeros(digits, length);
+	}
 
-	// Copy into the StringBuilder anything before the 'start' position.
-	if (start > numberBuffer)
-		StringBuilder_Append(stringBuilder, (const Byte *)numberBuffer, 0, start - numberBuffer);
+	return FormatExp(digits, length, decimalPoint, negative, forceSign);
+}
 
-	// Now add the padding.
-	StringBuilder_AppendRepeat(stringBuilder, '0', minIntDigits - (dot - start));
+/// <summary>
+/// Convert a Float64 to a string in fixed-point form, like "123.456".
+/// </summary>
+/// <param name="value">The value to convert.</param>
+/// <param name="minIntDigits">The minimum number of digits before the decimal point (padded with zeros).</param>
+/// <param name="maxFracDigits">The maximum number of digits after the decimal point, or zero (or
+/// less) to print exactly as many as are needed for the result to round-trip.</param>
+/// <param name="forceSign">Whether to include a '+' sign on nonnegative values.</param>
+/// <returns>The formatted string, which always has at least one digit after the decimal point.</returns>
+String Float64_ToFixedString(Float64 value, Int minIntDigits, Int maxFracDigits, Bool forceSign)
+{
+	Int kind = Float64_GetKind(value);
+	String special = SpecialFloatString(kind, forceSign);
+	BinaryFloat binaryFloat;
 
-	// Finally, add the rest of the number.
-	StringBuilder_Append(stringBuilder, (Byte *)start, 0, strlen(start));
+	if (special != NULL) return special;
 
-	// All done.
-	return StringBuilder_ToString(stringBuilder);
+	DecomposeFloat64(value, &binaryFloat);
+	return BinaryFloatToFixedString(&binaryFloat, !(kind & ~0x80), (kind & 0x80) != 0, minIntDigits, maxFracDigits, forceSign);
 }
 
+/// <summary>
+/// Convert a Float64 to a string in exponential form, like "1.23456e+78".
+/// </summary>
+/// <param name="value">The value to convert.</param>
+/// <param name="maxFracDigits">The maximum number of digits after the decimal point, or zero (or
+/// less) to print exactly as many as are needed for the result to round-trip.</param>
+/// <param name="forceSign">Whether to include a '+' sign on nonnegative values.</param>
+/// <returns>The formatted string.</returns>
 String Float64_ToExpString(Float64 value, Int maxFracDigits, Bool forceSign)
 {
-	char numberBuffer[256];
-	char *start = numberBuffer;
-	Int kind;
+	Int kind = Float64_GetKind(value);
+	String special = SpecialFloatString(kind, forceSign);
+	BinaryFloat binaryFloat;
 
-	kind = Float64_GetKind(value);
+	if (special != NULL) return special;
 
-	switch (kind) {
-	case FLOAT_KIND_POS_INF:
-		return forceSign ? Float_String_PosInf : Float_String_Inf;
-	case FLOAT_KIND_NEG_INF:
-		return Float_String_NegInf;
-	case FLOAT_KIND_POS_QNAN:
-		return forceSign ? Float_String_PosNaN : Float_String_NaN;
-	case FLOAT_KIND_NEG_QNAN:
-		return Float_String_NegNaN;
-	case FLOAT_KIND_POS_SNAN:
-		return forceSign ? Float_String_PosSNaN : Float_String_SNaN;
-	case FLOAT_KIND_NEG_SNAN:
-		return Float_String_NegSNaN;
-	case FLOAT_KIND_POS_ZERO:
-	case FLOAT_KIND_POS_NUM:
-		if (forceSign) *start++ = '+';
-		break;
-	case FLOAT_KIND_NEG_ZERO:
-	case FLOAT_KIND_NEG_NUM:
-		*start++ = '-';
-		value = -value;
-		break;
-	}
+	DecomposeFloat64(value, &binaryFloat);
+	return BinaryFloatToExpString(&binaryFloat, !(kind & ~0x80), (kind & 0x80) != 0, maxFracDigits, forceSign);
+}
+
+String Float32_ToFixedString(Float32 value, Int minIntDigits, Int maxFracDigits, Bool forceSign)
+{
+	Int kind = Float32_GetKind(value);
+	String special = SpecialFloatString(kind, forceSign);
+	BinaryFloat binaryFloat;
 
-	// Now use sprintf to actually format the number.
-	snprintf(start, numberBuffer + sizeof(numberBuffer) - start, "%.*e",
-		(maxFracDigits > Int32Max ? Int32Max : (Int32)maxFracDigits), value);
-	numberBuffer[sizeof(numberBuffer) - 1] = '\0';
+	if (special != NULL) return special;
 
-	// And we're done.
-	return String_FromC(numberBuffer);
+	DecomposeFloat32(value, &binaryFloat);
+	return BinaryFloatToFixedString(&binaryFloat, !(kind & ~0x80), (kind & 0x80) != 0, minIntDigits, maxFracDigits, forceSign);
 }
 
+String Float32_ToExpString(Float32 value, Int maxFracDigits, Bool forceSign)
+{
+	Int kind = Float32_GetKind(value);
+	String special = SpecialFloatString(kind, forceSign);
+	BinaryFloat binaryFloat;
+
+	if (special != NULL) return special;
+
+	DecomposeFloat32(value, &binaryFloat);
+	return BinaryFloatToExpString(&binaryFloat, !(kind & ~0x80), (kind & 0x80) != 0, maxFracDigits, forceSign);
+}
+
+static String ZeroString(Int kind, Bool forceSign)
+{
+	if (forceSign) {
+		if (kind == FLOAT_KIND_POS_ZERO)
+			return Float_String_PosZero;
+		if (kind == FLOAT_KIND_NEG_ZERO)
+			return Float_String_NegZero;
+	}
+	return Float_String_Zero;
+}
+
+/// <summary>
+/// Convert a Float64 to a string, in fixed-point form for moderate values and in exponential
+/// form for very large or very small values.  By default (if maxFracDigits is zero or less),
+/// this prints the shortest string that parses back to exactly the same value.
+/// </summary>
 String Float64_ToStringEx(Float64 float64, Int minIntDigits, Int maxFracDigits, Bool forceSign)
 {
-	Int kind;
 	Float64 absValue = fabs(float64);
 
-	if (absValue == 0.0) {
-		if (forceSign) {
-			kind = Float64_GetKind(float64);
-			if (kind == FLOAT_KIND_POS_ZERO)
-				return Float_String_PosZero;
-			if (kind == FLOAT_KIND_NEG_ZERO)
-				return Float_String_NegZero;
-		}
-		return Float_String_Zero;
-	}
+	if (absValue == 0.0)
+		return ZeroString(Float64_GetKind(float64), forceSign);
 
 	if (absValue > 1000000000.0 || absValue < 0.00001) {
 		// Very large (1'000'000'000 or larger), or very small (smaller than 0.00001), so
 		// print in exponential notation.
-		return Float64_ToExpString(float64, (Int32)maxFracDigits, forceSign);
+		return Float64_ToExpString(float64, maxFracDigits, forceSign);
 	}
 	else {
 		// Moderate range:  In (1'000'000'000, 0.00001], so print it as a traditional decimal string.
-		return Float64_ToFixedString(float64, (Int32)minIntDigits, (Int32)maxFracDigits, forceSign);
+		return Float64_ToFixedString(float64, minIntDigits, maxFracDigits, forceSign);
 	}
 }
+
+/// <summary>
+/// Convert a Float32 to a string, in fixed-point form for moderate values and in exponential
+/// form for very large or very small values.  By default (if maxFracDigits is zero or less),
+/// this prints the shortest string that parses back to exactly the same Float32 value.
+/// </summary>
+String Float32_ToStringEx(Float32 float32, Int minIntDigits, Int maxFracDigits, Bool forceSign)
+{
+	Float32 absValue = (Float32)fabs(float32);
+
+	if (absValue == 0.0f)
+		return ZeroString(Float32_GetKind(float32), forceSign);
+
+	if (absValue > 1000000000.0f || absValue < 0.00001f)
+		return Float32_ToExpString(float32, maxFracDigits, forceSign);
+	else
+		return Float32_ToFixedString(float32, minIntDigits, maxFracDigits, forceSign);
+}
@@ -17,6 +17,7 @@
 
 #include <smile/numeric/realshared.h>
 #include <smile/numeric/real64.h>
+#include <smile/numeric/int128.h>
 #include <smile/stringbuilder.h>
 
 extern String Real_ToFixedString(Byte *buffer, Int32 len, Int32 exp, Int32 kind, Int minIntDigits, Int minFracDigits, Bool forceSign);
@@ -27,6 +28,17 @@ extern SMILE_THREAD_LOCAL UInt32 Real_Flags;
 
 extern Real64 Real64_FromRawCString(const char *str);
 
+// The full BID implementations, which the fast paths below fall back on.
+extern Real64 __bid64_add(Real64 a, Real64 b);
+extern Real64 __bid64_sub(Real64 a, Real64 b);
+extern Real64 __bid64_mul(Real64 a, Real64 b);
+extern int __bid64_quiet_equal(Real64 a, Real64 b);
+extern int __bid64_quiet_not_equal(Real64 a, Real64 b);
+extern int __bid64_quiet_less(Real64 a, Real64 b);
+extern int __bid64_quiet_greater(Real64 a, Real64 b);
+extern int __bid64_quiet_less_equal(Real64 a, Real64 b);
+extern int __bid64_quiet_greater_equal(Real64 a, Real64 b);
+
 Real64 Real64_NegNaN =		{ 0xFC00000000000000ULL };
 Real64 Real64_NegInf =		{ 0xF800000000000000ULL };
 Real64 Real64_NegSixteen =	{ 0xB1C0000000000010ULL };
@@ -250,6 +262,215 @@ SMILE_API_FUNC Real64 Real64_Mod(Real64 a, Real64 b)
 	return mod;
 }
 
+//-------------------------------------------------------------------------------------------------
+//  Binary-integer fast paths.
+//
+//  Most Real64 values in real programs have short coefficients and a handful of distinct
+//  exponents (money amounts, counts, measurements with a fixed number of places).  For those,
+//  addition, multiplication, and comparison are exact, and can be performed with ordinary
+//  64-bit integer arithmetic on the coefficients.  An exact result is the same under every
+//  rounding mode and raises no exception flags, so as long as we encode it the way IEEE 754-2008
+//  says to (with the "preferred" exponent), it is bit-identical to what the BID library would
+//  have produced.  Anything that might round, overflow, or involve a special value goes through
+//  the full BID implementation instead.
+
+#define REAL64_SIGN_BIT 0x8000000000000000ULL
+#define REAL64_STEERING_BITS 0x6000000000000000ULL
+#define REAL64_SMALL_COEFFICIENT_MASK 0x001FFFFFFFFFFFFFULL
+#define REAL64_LARGE_COEFFICIENT_MASK 0x0007FFFFFFFFFFFFULL
+#define REAL64_MAX_COEFFICIENT 9999999999999999ULL
+#define REAL64_MAX_BIASED_EXPONENT 767
+#define REAL64_EXPONENT_BIAS 398
+
+static const UInt64 _powersOfTen[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+	100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+	10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+/// <summary>
+/// Unpack a finite Real64 whose coefficient uses the "small" encoding (any coefficient below
+/// 2^53, which covers nearly every value that isn't already at full precision).
+/// </summary>
+/// <returns>True if the value was unpacked; False if it is infinite, NaN, or has a 16-digit
+/// coefficient in the "large" encoding.</returns>
+Inline Bool Real64_UnpackSmall(Real64 real64, UInt64 *coefficient, Int32 *exponent)
+{
+	if ((real64.value & REAL64_STEERING_BITS) == REAL64_STEERING_BITS)
+		return False;
+
+	*coefficient = real64.value & REAL64_SMALL_COEFFICIENT_MASK;
+	*exponent = (Int32)((real64.value >> 53) & 0x3FF);
+	return True;
+}
+
+/// <summary>
+/// Pack a sign, a biased exponent, and a coefficient of at most 16 digits into a Real64,
+/// using whichever coefficient encoding fits.
+/// </summary>
+Inline Real64 Real64_Pack(UInt64 sign, Int32 exponent, UInt64 coefficient)
+{
+	Real64 result;
+
+	if (coefficient <= REAL64_SMALL_COEFFICIENT_MASK)
+		result.value = sign | ((UInt64)exponent << 53) | coefficient;
+	else
+		result.value = sign | REAL64_STEERING_BITS | ((UInt64)exponent << 51) | (coefficient & REAL64_LARGE_COEFFICIENT_MASK);
+
+	return result;
+}
+
+/// <summary>
+/// Rescale whichever coefficient has the larger exponent so that both share the smaller
+/// exponent, which is the exponent IEEE 754 prefers for an exact sum.
+/// </summary>
+/// <returns>True if the coefficients could be aligned without exceeding 'limit'.</returns>
+Inline Bool Real64_AlignCoefficients(UInt64 *ca, Int32 *ea, UInt64 *cb, Int32 *eb, UInt64 limit)
+{
+	Int32 diff = *ea - *eb;
+
+	if (diff > 0) {
+		if (diff > 19 || *ca > limit / _powersOfTen[diff]) return False;
+		*ca *= _powersOfTen[diff];
+		*ea = *eb;
+	}
+	else if (diff < 0) {
+		diff = -diff;
+		if (diff > 19 || *cb > limit / _powersOfTen[diff]) return False;
+		*cb *= _powersOfTen[diff];
+		*eb = *ea;
+	}
+
+	return True;
+}
+
+/// <summary>
+/// Compare two Real64s with integer arithmetic, if both are finite and their coefficients
+/// can be aligned to a common exponent within 64 bits.
+/// </summary>
+/// <returns>True if the comparison was performed, in which case 'result' is -1, 0, or +1.</returns>
+static Bool Real64_FastCompare(Real64 a, Real64 b, Int *result)
+{
+	UInt64 ca, cb;
+	Int32 ea, eb;
+	Bool negA, negB;
+
+	if (!Real64_UnpackSmall(a, &ca, &ea) || !Real64_UnpackSmall(b, &cb, &eb))
+		return False;
+
+	// Zero compares equal to zero at any exponent (and with either sign), so only nonzero
+	// coefficients need to be aligned.
+	if (ca != 0 && cb != 0 && !Real64_AlignCoefficients(&ca, &ea, &cb, &eb, UInt64Max))
+		return False;
+
+	negA = ca != 0 && (a.value & REAL64_SIGN_BIT);
+	negB = cb != 0 && (b.value & REAL64_SIGN_BIT);
+
+	if (negA != negB)
+		*result = negA ? -1 : +1;
+	else if (ca == cb)
+		*result = 0;
+	else
+		*result = (ca < cb) != negA ? -1 : +1;
+
+	return True;
+}
+
+SMILE_API_FUNC Real64 Real64_Add(Real64 a, Real64 b)
+{
+	UInt64 ca, cb, coefficient, sign;
+	Int32 ea, eb;
+
+	if (Real64_UnpackSmall(a, &ca, &ea) && Real64_UnpackSmall(b, &cb, &eb)
+		&& Real64_AlignCoefficients(&ca, &ea, &cb, &eb, REAL64_MAX_COEFFICIENT)) {
+
+		if ((a.value ^ b.value) & REAL64_SIGN_BIT) {
+			// Opposite signs.  An exact zero here takes its sign from the rounding mode,
+			// so we leave that case to the full implementation.
+			if (ca > cb) {
+				coefficient = ca - cb;
+				sign = a.value & REAL64_SIGN_BIT;
+				return Real64_Pack(sign, ea, coefficient);
+			}
+			else if (cb > ca) {
+				coefficient = cb - ca;
+				sign = b.value & REAL64_SIGN_BIT;
+				return Real64_Pack(sign, ea, coefficient);
+			}
+		}
+		else {
+			coefficient = ca + cb;
+			if (coefficient <= REAL64_MAX_COEFFICIENT)
+				return Real64_Pack(a.value & REAL64_SIGN_BIT, ea, coefficient);
+		}
+	}
+
+	return __bid64_add(a, b);
+}
+
+SMILE_API_FUNC Real64 Real64_Sub(Real64 a, Real64 b)
+{
+	// For any non-NaN 'b', BID's subtraction is exactly addition of the negation.
+	if ((b.value & REAL64_STEERING_BITS) != REAL64_STEERING_BITS) {
+		b.value ^= REAL64_SIGN_BIT;
+		return Real64_Add(a, b);
+	}
+
+	return __bid64_sub(a, b);
+}
+
+SMILE_API_FUNC Real64 Real64_Mul(Real64 a, Real64 b)
+{
+	UInt64 ca, cb, lo, hi;
+	Int32 ea, eb, exponent;
+
+	if (Real64_UnpackSmall(a, &ca, &ea) && Real64_UnpackSmall(b, &cb, &eb)) {
+		exponent = ea + eb - REAL64_EXPONENT_BIAS;
+		UInt64_MulExtended128(ca, cb, &lo, &hi);
+		if (hi == 0 && lo <= REAL64_MAX_COEFFICIENT && exponent >= 0 && exponent <= REAL64_MAX_BIASED_EXPONENT)
+			return Real64_Pack((a.value ^ b.value) & REAL64_SIGN_BIT, exponent, lo);
+	}
+
+	return __bid64_mul(a, b);
+}
+
+SMILE_API_FUNC Bool Real64_Eq(Real64 a, Real64 b)
+{
+	Int cmp;
+	return Real64_FastCompare(a, b, &cmp) ? cmp == 0 : (Bool)__bid64_quiet_equal(a, b);
+}
+
+SMILE_API_FUNC Bool Real64_Ne(Real64 a, Real64 b)
+{
+	Int cmp;
+	return Real64_FastCompare(a, b, &cmp) ? cmp != 0 : (Bool)__bid64_quiet_not_equal(a, b);
+}
+
+SMILE_API_FUNC Bool Real64_Lt(Real64 a, Real64 b)
+{
+	Int cmp;
+	return Real64_FastCompare(a, b, &cmp) ? cmp < 0 : (Bool)__bid64_quiet_less(a, b);
+}
+
+SMILE_API_FUNC Bool Real64_Gt(Real64 a, Real64 b)
+{
+	Int cmp;
+	return Real64_FastCompare(a, b, &cmp) ? cmp > 0 : (Bool)__bid64_quiet_greater(a, b);
+}
+
+SMILE_API_FUNC Bool Real64_Le(Real64 a, Real64 b)
+{
+	Int cmp;
+	return Real64_FastCompare(a, b, &cmp) ? cmp <= 0 : (Bool)__bid64_quiet_less_equal(a, b);
+}
+
+SMILE_API_FUNC Bool Real64_Ge(Real64 a, Real64 b)
+{
+	Int cmp;
+	return Real64_FastCompare(a, b, &cmp) ? cmp >= 0 : (Bool)__bid64_quiet_greater_equal(a, b);
+}
+
 // Possible fast classifications for the sort-comparison code below.
 #define POS 0
 #define NEG 1
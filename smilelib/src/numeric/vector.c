@@ -0,0 +1,247 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/types.h>
+#include <smile/numeric/vector.h>
+
+#include <math.h>
+
+#define KERNEL_NAME(__type__, __name__, __isa__) KERNEL_NAME2(__type__, __name__, __isa__)
+#define KERNEL_NAME2(__type__, __name__, __isa__) __type__##Vector_##__name__##_##__isa__
+#define PUBLIC_NAME(__type__, __name__) PUBLIC_NAME2(__type__, __name__)
+#define PUBLIC_NAME2(__type__, __name__) __type__##Vector_##__name__
+
+//-------------------------------------------------------------------------------------------------
+//  Instruction-set selection.
+
+static Int _vectorIsa = -1;
+
+/// <summary>
+/// Find out which instruction set this CPU supports, and select it.
+/// </summary>
+static Int Vector_DetectIsa(void)
+{
+#if VECTOR_HAS_AVX2
+	__builtin_cpu_init();
+	_vectorIsa = __builtin_cpu_supports("avx2") ? VECTOR_ISA_AVX2 : VECTOR_ISA_PORTABLE;
+#else
+	_vectorIsa = VECTOR_ISA_PORTABLE;
+#endif
+	return _vectorIsa;
+}
+
+#define CURRENT_ISA (_vectorIsa >= 0 ? _vectorIsa : Vector_DetectIsa())
+
+/// <summary>
+/// Get the instruction set that the vector kernels are currently using.
+/// </summary>
+/// <returns>One of the VECTOR_ISA_* constants.</returns>
+Int Vector_GetIsa(void)
+{
+	return CURRENT_ISA;
+}
+
+/// <summary>
+/// Force the vector kernels to use the given instruction set.  This is mainly useful
+/// for testing, to check that every instruction set produces the same results.
+/// </summary>
+/// <param name="isa">One of the VECTOR_ISA_* constants.</param>
+/// <returns>True if the instruction set was selected, or False if this CPU (or this
+/// build) does not support it.</returns>
+Bool Vector_SetIsa(Int isa)
+{
+	switch (isa) {
+		case VECTOR_ISA_PORTABLE:
+			_vectorIsa = VECTOR_ISA_PORTABLE;
+			return True;
+
+		case VECTOR_ISA_AVX2:
+#if VECTOR_HAS_AVX2
+			__builtin_cpu_init();
+			if (!__builtin_cpu_supports("avx2"))
+				return False;
+			_vectorIsa = VECTOR_ISA_AVX2;
+			return True;
+#else
+			return False;
+#endif
+
+		default:
+			return False;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Kernels, for each element type and each instruction set.
+
+#define VECTOR_TYPE Byte
+#define VECTOR_MATH UInt32
+#define VECTOR_ACC Int64
+#define VECTOR_ACCMATH UInt64
+#define VECTOR_MIN ByteMax
+#define VECTOR_MAX 0
+
+#define VECTOR_ISA Portable
+#define VECTOR_TARGET
+#include "vector_kernels.inc"
+#undef VECTOR_ISA
+#undef VECTOR_TARGET
+
+#if VECTOR_HAS_AVX2
+	#define VECTOR_ISA Avx2
+	#define VECTOR_TARGET __attribute__((target("avx2")))
+	#include "vector_kernels.inc"
+	#undef VECTOR_ISA
+	#undef VECTOR_TARGET
+#endif
+
+#include "vector_dispatch.inc"
+
+#undef VECTOR_TYPE
+#undef VECTOR_MATH
+#undef VECTOR_ACC
+#undef VECTOR_ACCMATH
+#undef VECTOR_MIN
+#undef VECTOR_MAX
+
+//-------------------------------------------------------------------------------------------------
+
+#define VECTOR_TYPE Int32
+#define VECTOR_MATH UInt32
+#define VECTOR_ACC Int64
+#define VECTOR_ACCMATH UInt64
+#define VECTOR_MIN Int32Max
+#define VECTOR_MAX Int32Min
+
+#define VECTOR_ISA Portable
+#define VECTOR_TARGET
+#include "vector_kernels.inc"
+#undef VECTOR_ISA
+#undef VECTOR_TARGET
+
+#if VECTOR_HAS_AVX2
+	#define VECTOR_ISA Avx2
+	#define VECTOR_TARGET __attribute__((target("avx2")))
+	#include "vector_kernels.inc"
+	#undef VECTOR_ISA
+	#undef VECTOR_TARGET
+#endif
+
+#include "vector_dispatch.inc"
+
+#undef VECTOR_TYPE
+#undef VECTOR_MATH
+#undef VECTOR_ACC
+#undef VECTOR_ACCMATH
+#undef VECTOR_MIN
+#undef VECTOR_MAX
+
+//-------------------------------------------------------------------------------------------------
+
+#define VECTOR_TYPE Int64
+#define VECTOR_MATH UInt64
+#define VECTOR_ACC Int64
+#define VECTOR_ACCMATH UInt64
+#define VECTOR_MIN Int64Max
+#define VECTOR_MAX Int64Min
+
+#define VECTOR_ISA Portable
+#define VECTOR_TARGET
+#include "vector_kernels.inc"
+#undef VECTOR_ISA
+#undef VECTOR_TARGET
+
+#if VECTOR_HAS_AVX2
+	#define VECTOR_ISA Avx2
+	#define VECTOR_TARGET __attribute__((target("avx2")))
+	#include "vector_kernels.inc"
+	#undef VECTOR_ISA
+	#undef VECTOR_TARGET
+#endif
+
+#include "vector_dispatch.inc"
+
+#undef VECTOR_TYPE
+#undef VECTOR_MATH
+#undef VECTOR_ACC
+#undef VECTOR_ACCMATH
+#undef VECTOR_MIN
+#undef VECTOR_MAX
+
+//-------------------------------------------------------------------------------------------------
+
+#define VECTOR_TYPE Float32
+#define VECTOR_MATH Float32
+#define VECTOR_ACC Float64
+#define VECTOR_ACCMATH Float64
+#define VECTOR_MIN HUGE_VALF
+#define VECTOR_MAX (-HUGE_VALF)
+
+#define VECTOR_ISA Portable
+#define VECTOR_TARGET
+#include "vector_kernels.inc"
+#undef VECTOR_ISA
+#undef VECTOR_TARGET
+
+#if VECTOR_HAS_AVX2
+	#define VECTOR_ISA Avx2
+	#define VECTOR_TARGET __attribute__((target("avx2")))
+	#include "vector_kernels.inc"
+	#undef VECTOR_ISA
+	#undef VECTOR_TARGET
+#endif
+
+#include "vector_dispatch.inc"
+
+#undef VECTOR_TYPE
+#undef VECTOR_MATH
+#undef VECTOR_ACC
+#undef VECTOR_ACCMATH
+#undef VECTOR_MIN
+#undef VECTOR_MAX
+
+//-------------------------------------------------------------------------------------------------
+
+#define VECTOR_TYPE Float64
+#define VECTOR_MATH Float64
+#define VECTOR_ACC Float64
+#define VECTOR_ACCMATH Float64
+#define VECTOR_MIN HUGE_VAL
+#define VECTOR_MAX (-HUGE_VAL)
+
+#define VECTOR_ISA Portable
+#define VECTOR_TARGET
+#include "vector_kernels.inc"
+#undef VECTOR_ISA
+#undef VECTOR_TARGET
+
+#if VECTOR_HAS_AVX2
+	#define VECTOR_ISA Avx2
+	#define VECTOR_TARGET __attribute__((target("avx2")))
+	#include "vector_kernels.inc"
+	#undef VECTOR_ISA
+	#undef VECTOR_TARGET
+#endif
+
+#include "vector_dispatch.inc"
+
+#undef VECTOR_TYPE
+#undef VECTOR_MATH
+#undef VECTOR_ACC
+#undef VECTOR_ACCMATH
+#undef VECTOR_MIN
+#undef VECTOR_MAX
@@ -15,15 +15,8 @@
 //  limitations under the License.
 //---------------------------------------------------------------------------------------
 
-#include <stdlib.h>		// For strtod().
-
-// TODO: Ideally shouldn't rely on the (possibly-buggy) native implementation of
-// strtod() and instead should use our own infinite-precision conversion routine
-// to ensure consistency across platforms.  strtod() is fine on newer versions of
-// GCC/Linux, but has at least a one-ULP inaccuracy on just about every other
-// compiler/OS (and is notably inconsistent between different versions of VC++).
-
 #include <smile/numeric/real.h>
+#include <smile/numeric/bigint.h>
 #include <smile/parsing/lexer.h>
 #include <smile/parsing/tokenkind.h>
 #include <smile/parsing/identkind.h>
@@ -194,6 +187,44 @@ Inline Int ProcessIntegerValue(Lexer lexer, UInt64 value, String text, String su
 	}
 }
 
+/// <summary>
+/// Determine whether the digits just consumed are followed by an 'n' suffix, which makes
+/// them a BigInt.  This doesn't consume anything.
+/// </summary>
+Inline Bool HasBigIntSuffix(Lexer lexer)
+{
+	const Byte *src = lexer->src;
+	const Byte *end = lexer->end;
+
+	return src < end && (*src == 'n' || *src == 'N')
+		&& (src + 1 >= end || !IsAlphanumeric(src[1]));
+}
+
+Inline Bool IsBigIntSuffix(String suffix)
+{
+	return suffix != NULL && String_Length(suffix) == 1
+		&& (String_GetBytes(suffix)[0] == 'n' || String_GetBytes(suffix)[0] == 'N');
+}
+
+/// <summary>
+/// Finish an integer that has an 'n' suffix, by reparsing its digits as a BigInt.  Unlike
+/// the other integer types, this has no size limit, so the digits are reparsed from the
+/// source text rather than taken from the (possibly-overflowed) 64-bit value.
+/// </summary>
+static Int ProcessBigIntValue(Lexer lexer, const Byte *digits, const Byte *digitsEnd, Int radix, String text, String errorMessage)
+{
+	BigInt value;
+
+	if (!BigInt_TryParse(digits, digitsEnd - digits, radix, &value)) {
+		lexer->token->text = errorMessage;
+		return (lexer->token->kind = TOKEN_ERROR);
+	}
+
+	lexer->token->data.ptr = value;
+	lexer->token->text = text;
+	return (lexer->token->kind = TOKEN_BIGINT);
+}
+
 static Bool ParseDecimalInteger(Lexer lexer, UInt64 *result)
 {
 	const Byte *src = lexer->src;
@@ -386,7 +417,6 @@ Int Lexer_ParseReal(Lexer lexer)
 	const Byte *start;
 	Byte ch;
 	Token token = lexer->token;
-	const Byte *digits;
 	String digitString, suffix;
 	const Byte *suffixText;
 	Float64 float64;
@@ -446,7 +476,6 @@ Int Lexer_ParseReal(Lexer lexer)
 
 	// Extract out the raw text of the number.
 	digitString = StringBuilder_ToString(digitBuilder);
-	digits = String_GetBytes(digitString);
 
 	// Get any trailing type identifiers.
 	suffix = CollectAlphanumericSuffix(lexer);
@@ -471,7 +500,7 @@ Int Lexer_ParseReal(Lexer lexer)
 	else if (suffixText[0] == 'F' || suffixText[0] == 'f') {
 		if (suffixText[1] == '\0') {
 			// Float64.
-			float64 = strtod((char *)digits, NULL);
+			String_ParseFloat(digitString, 10, &float64);
 			token->data.float64 = float64;
 			token->text = digitString;
 			return END_TOKEN(TOKEN_FLOAT64);
@@ -508,7 +537,7 @@ Int Lexer_ParseReal(Lexer lexer)
 		}
 		else if ((suffixText[1] == 'F' || suffixText[1] == 'f') && suffixText[2] == '\0') {
 			// Float32.
-			float64 = strtod((char *)digits, NULL);
+			String_ParseFloat(digitString, 10, &float64);
 			token->data.float32 = (Float32)float64;
 			token->text = digitString;
 			return END_TOKEN(TOKEN_FLOAT32);
@@ -552,7 +581,7 @@ Int Lexer_ParseZero(Lexer lexer)
 		else {
 			// This is a hexadecimal integer.
 			lexer->src = src;
-			if (!ParseHexadecimalInteger(lexer, &value)) {
+			if (!ParseHexadecimalInteger(lexer, &value) && !HasBigIntSuffix(lexer)) {
 				lexer->token->text = IllegalHexadecimalIntegerMessage;
 				return END_TOKEN(TOKEN_ERROR);
 			}
@@ -564,6 +593,8 @@ Int Lexer_ParseZero(Lexer lexer)
 				return END_TOKEN(TOKEN_ERROR);
 			}
 			END_TOKEN(TOKEN_INTEGER64);
+			if (IsBigIntSuffix(suffix))
+				return ProcessBigIntValue(lexer, start + 2, digitsEnd, 16, String_Create(start, digitsEnd - start), IllegalHexadecimalIntegerMessage);
 			return ProcessIntegerValue(lexer, value, String_Create(start, digitsEnd - start), suffix);
 		}
 	}
@@ -572,7 +603,7 @@ Int Lexer_ParseZero(Lexer lexer)
 		lexer->src = start;
 		if (!ParseOctalInteger(lexer, &value)) {
 			src = lexer->src;
-			if (!(src < lexer->end && *src == '.' && (src + 1 >= lexer->end || src[1] != '.'))) {
+			if (!(src < lexer->end && *src == '.' && (src + 1 >= lexer->end || src[1] != '.')) && !HasBigIntSuffix(lexer)) {
 				lexer->token->text = IllegalOctalIntegerMessage;
 				return END_TOKEN(TOKEN_ERROR);
 			}
@@ -592,6 +623,8 @@ Int Lexer_ParseZero(Lexer lexer)
 				return END_TOKEN(TOKEN_ERROR);
 			}
 			END_TOKEN(TOKEN_INTEGER64);
+			if (IsBigIntSuffix(suffix))
+				return ProcessBigIntValue(lexer, start, digitsEnd, 8, String_Create(start, digitsEnd - start), IllegalOctalIntegerMessage);
 			return ProcessIntegerValue(lexer, value, String_Create(start, digitsEnd - start), suffix);
 		}
 	}
@@ -612,7 +645,7 @@ Int Lexer_ParseDigit(Lexer lexer)
 	lexer->src = start;
 	if (!ParseDecimalInteger(lexer, &value)) {
 		src = lexer->src;
-		if (!(src < lexer->end && *src == '.' && (src + 1 >= lexer->end || src[1] != '.'))) {
+		if (!(src < lexer->end && *src == '.' && (src + 1 >= lexer->end || src[1] != '.')) && !HasBigIntSuffix(lexer)) {
 			lexer->token->text = IllegalDecimalIntegerMessage;
 			return END_TOKEN(TOKEN_ERROR);
 		}
@@ -629,6 +662,8 @@ Int Lexer_ParseDigit(Lexer lexer)
 		src = lexer->src;	// END_TOKEN needs the correct 'src' value.
 		if (!EnsureEndOfNumber(lexer)) return END_TOKEN(TOKEN_ERROR);
 		END_TOKEN(TOKEN_INTEGER64);
+		if (IsBigIntSuffix(suffix))
+			return ProcessBigIntValue(lexer, start, digitsEnd, 10, String_Create(start, digitsEnd - start), IllegalDecimalIntegerMessage);
 		return ProcessIntegerValue(lexer, value, String_Create(start, digitsEnd - start), suffix);
 	}
 }
@@ -39,6 +39,7 @@ STATIC_STRING(TokenString_Integer16, "int16");
 STATIC_STRING(TokenString_Integer32, "int32");
 STATIC_STRING(TokenString_Integer64, "int64");
 STATIC_STRING(TokenString_Integer128, "int128");
+STATIC_STRING(TokenString_BigInt, "bigint");
 STATIC_STRING(TokenString_Real32, "real32");
 STATIC_STRING(TokenString_Real64, "real64");
 STATIC_STRING(TokenString_Real128, "real128");
@@ -112,6 +113,7 @@ SMILE_API_FUNC String TokenKind_ToString(Int tokenKind)
 		case TOKEN_INTEGER32: return TokenString_Integer32;
 		case TOKEN_INTEGER64: return TokenString_Integer64;
 		case TOKEN_INTEGER128: return TokenString_Integer128;
+		case TOKEN_BIGINT: return TokenString_BigInt;
 		case TOKEN_REAL32: return TokenString_Real32;
 		case TOKEN_REAL64: return TokenString_Real64;
 		case TOKEN_REAL128: return TokenString_Real128;
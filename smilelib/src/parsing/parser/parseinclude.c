@@ -27,6 +27,7 @@
 #include <smile/parsing/internal/parsescope.h>
 #include <smile/internal/staticstring.h>
 #include <smile/stringbuilder.h>
+#include <smile/utf8.h>
 #include <smile/smiletypes/numeric/smileinteger64.h>
 #include <smile/smiletypes/smilesyntax.h>
 
@@ -285,6 +286,7 @@ ParseError Parser_DefaultIncludeLoader(const String fullPath, const LexerPositio
 {
 	FILE *fp;
 	StringBuilder stringBuilder;
+	String text;
 	Byte *buffer;
 	size_t readLength;
 	ParseError parseError;
@@ -316,8 +318,19 @@ ParseError Parser_DefaultIncludeLoader(const String fullPath, const LexerPositio
 	// Cleanup.
 	fclose(fp);
 
+	// Source files must be UTF-8.  Checking that runs at memory speed, and it gives a much
+	// clearer error than the lexer would give for the first malformed character it found.
+	text = StringBuilder_ToString(stringBuilder);
+	if (!String_IsValidUtf8(text)) {
+		parseError = ParseMessage_Create(PARSEMESSAGE_ERROR, position,
+			String_Format("\"%s\" is not valid UTF-8 (at byte %ld).", String_ToC(fullPath),
+				(Int64)Utf8_FindInvalid(String_GetBytes(text), String_Length(text), 0)));
+		*result = NULL;
+		return parseError;
+	}
+
 	// Return the file we read.
-	*result = StringBuilder_ToString(stringBuilder);
+	*result = text;
 	return NULL;
 }
 
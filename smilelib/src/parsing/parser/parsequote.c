@@ -21,6 +21,7 @@
 #include <smile/smiletypes/numeric/smileinteger16.h>
 #include <smile/smiletypes/numeric/smileinteger32.h>
 #include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
 #include <smile/smiletypes/numeric/smilereal32.h>
 #include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/numeric/smilefloat32.h>
@@ -219,6 +220,9 @@ TemplateResult Parser_ParseRawListTerm(Parser parser, Int modeFlags)
 		case TOKEN_INTEGER64:
 			return TEMPLATE_RESULT(EXPR_RESULT(SmileInteger64_Create(token->data.int64)), TemplateKind_None);
 
+		case TOKEN_BIGINT:
+			return TEMPLATE_RESULT(EXPR_RESULT(SmileBigInt_Create((BigInt)token->data.ptr)), TemplateKind_None);
+
 		case TOKEN_REAL32:
 			return TEMPLATE_RESULT(EXPR_RESULT(SmileReal32_Create(token->data.real32)), TemplateKind_None);
 
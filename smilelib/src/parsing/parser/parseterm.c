@@ -21,6 +21,7 @@
 #include <smile/smiletypes/numeric/smileinteger16.h>
 #include <smile/smiletypes/numeric/smileinteger32.h>
 #include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
 #include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/numeric/smilereal32.h>
 #include <smile/smiletypes/numeric/smilefloat64.h>
@@ -131,6 +132,9 @@ ParseResult Parser_ParseTerm(Parser parser, Int modeFlags, Token firstUnaryToken
 	case TOKEN_INTEGER64:
 		return EXPR_RESULT(SmileInteger64_Create(token->data.int64));
 
+	case TOKEN_BIGINT:
+		return EXPR_RESULT(SmileBigInt_Create((BigInt)token->data.ptr));
+
 	case TOKEN_REAL64:
 		return EXPR_RESULT(SmileReal64_Create(token->data.real64));
 
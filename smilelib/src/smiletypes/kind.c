@@ -51,6 +51,7 @@ STATIC_STRING(Primitive_, "Primitive");
 STATIC_STRING(UserObject_, "Object");
 STATIC_STRING(String_, "String");
 
+STATIC_STRING(Cell_, "Cell");
 STATIC_STRING(TillContinuation_, "TillContinuation");
 STATIC_STRING(Handle_, "Handle");
 STATIC_STRING(Closure_, "Closure");
@@ -67,6 +68,10 @@ STATIC_STRING(BigReal_, "BigReal");
 STATIC_STRING(Timestamp_, "Timestamp");
 
 STATIC_STRING(ByteArray_, "ByteArray");
+STATIC_STRING(Integer32Array_, "Integer32Array");
+STATIC_STRING(Integer64Array_, "Integer64Array");
+STATIC_STRING(Float32Array_, "Float32Array");
+STATIC_STRING(Float64Array_, "Float64Array");
 
 STATIC_STRING(Syntax_, "Syntax");
 STATIC_STRING(Nonterminal_, "Nonterminal");
@@ -110,6 +115,7 @@ String SmileKind_GetName(Int kind)
 		case SMILE_KIND_USEROBJECT: return UserObject_;
 		case SMILE_KIND_STRING: return String_;
 
+		case SMILE_KIND_CELL: return Cell_;
 		case SMILE_KIND_TILL_CONTINUATION: return TillContinuation_;
 		case SMILE_KIND_HANDLE: return Handle_;
 		case SMILE_KIND_CLOSURE: return Closure_;
@@ -128,6 +134,10 @@ String SmileKind_GetName(Int kind)
 
 		// Raw buffer types.
 		case SMILE_KIND_BYTEARRAY: return ByteArray_;
+		case SMILE_KIND_INTEGER32ARRAY: return Integer32Array_;
+		case SMILE_KIND_INTEGER64ARRAY: return Integer64Array_;
+		case SMILE_KIND_FLOAT32ARRAY: return Float32Array_;
+		case SMILE_KIND_FLOAT64ARRAY: return Float64Array_;
 
 		// Types used for parsing.	
 		case SMILE_KIND_SYNTAX: return Syntax_;
@@ -209,6 +219,10 @@ Symbol SmileKind_GetTypeOf(Int smileKind)
 
 		// Raw buffer types.
 		case SMILE_KIND_BYTEARRAY: return Smile_KnownSymbols.byte_array;
+		case SMILE_KIND_INTEGER32ARRAY: return Smile_KnownSymbols.integer32_array;
+		case SMILE_KIND_INTEGER64ARRAY: return Smile_KnownSymbols.integer64_array;
+		case SMILE_KIND_FLOAT32ARRAY: return Smile_KnownSymbols.float32_array;
+		case SMILE_KIND_FLOAT64ARRAY: return Smile_KnownSymbols.float64_array;
 
 		// Types used for parsing.	
 		case SMILE_KIND_SYNTAX: return Smile_KnownSymbols.syntax;
@@ -87,8 +87,8 @@ OutputTemplate(\@floatBaseTemplate, \%float64Substitutions, "smilefloat64_base.g
 	"ToBool" => "unboxedData.f32 != 0.0f",
 	"ToBoolArg" => "argv[0].unboxed.f32 != 0.0f",
 	"ToInt" => "SmileUnboxedInteger64_From((Int64)argv[0].unboxed.f32)",
-	"ToStringBase10" => "Float64_ToStringEx((Float64)unboxedData.f32, 0, 0, False)",
-	"ToStringArg" => "Float64_ToStringEx((Float64)argv[0].unboxed.f32, 0, 0, False)",
+	"ToStringBase10" => "Float32_ToStringEx(unboxedData.f32, 0, 0, False)",
+	"ToStringArg" => "Float32_ToStringEx(argv[0].unboxed.f32, 0, 0, False)",
 	"HashAlgorithm" => "Smile_ApplyHashOracle(*(UInt32 *)&obj->value)",
 	"RandomAlgorithm" => "Random_Float32(Random_Shared)",
 	"Zero" => "0.0f",
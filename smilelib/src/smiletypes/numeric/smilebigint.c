@@ -0,0 +1,59 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
+#include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+SMILE_EASY_OBJECT_VTABLE(SmileBigInt);
+
+/// <summary>
+/// Wrap a BigInt in a Smile object.  BigInt objects are always boxed.
+/// </summary>
+/// <param name="value">The (immutable) BigInt value to wrap.</param>
+/// <returns>A new SmileBigInt object that holds the given value.</returns>
+SmileBigInt SmileBigInt_Create(BigInt value)
+{
+	// This can't be MALLOC_ATOMIC, since it points to the limbs of the value.
+	SmileBigInt smileBigInt = GC_MALLOC_STRUCT(struct SmileBigIntInt);
+	if (smileBigInt == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_BIGINT, sizeof(struct SmileBigIntInt));
+	smileBigInt->base = (SmileObject)Smile_KnownBases.BigInt;
+	smileBigInt->kind = SMILE_KIND_BIGINT;
+	smileBigInt->vtable = SmileBigInt_VTable;
+	smileBigInt->value = value;
+	return smileBigInt;
+}
+
+static UInt32 SmileBigInt_Hash(SmileBigInt obj)
+{
+	return BigInt_Hash(obj->value);
+}
+
+SMILE_EASY_OBJECT_READONLY_SECURITY(SmileBigInt)
+SMILE_EASY_OBJECT_NO_CALL(SmileBigInt, "A BigInt object")
+SMILE_EASY_OBJECT_NO_SOURCE(SmileBigInt)
+SMILE_EASY_OBJECT_NO_PROPERTIES(SmileBigInt)
+SMILE_EASY_OBJECT_NO_UNBOX(SmileBigInt)
+
+SMILE_EASY_OBJECT_COMPARE(SmileBigInt, SMILE_KIND_BIGINT, BigInt_Eq(a->value, b->value))
+SMILE_EASY_OBJECT_DEEP_COMPARE(SmileBigInt, SMILE_KIND_BIGINT, BigInt_Eq(a->value, b->value))
+SMILE_EASY_OBJECT_TOBOOL(SmileBigInt, !BigInt_IsZero(obj->value))
+SMILE_EASY_OBJECT_TOSTRING(SmileBigInt, BigInt_ToString(obj->value, 10))
@@ -0,0 +1,622 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/numeric/smilebyte.h>
+#include <smile/smiletypes/numeric/smileinteger16.h>
+#include <smile/smiletypes/numeric/smileinteger32.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilereal64.h>
+#include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
+#include <smile/smiletypes/smilefunction.h>
+#include <smile/smiletypes/base.h>
+#include <smile/internal/staticstring.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+// Only the first argument is required to be a BigInt; the rest may be any integer type.
+static Byte _bigIntChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_BIGINT,
+	0, 0,
+};
+
+typedef struct MathInfoStruct {
+	Bool isLoud;
+} *MathInfo;
+
+static struct MathInfoStruct _loudMath[] = { True };
+static struct MathInfoStruct _quietMath[] = { False };
+
+STATIC_STRING(_divideByZero, "Divide by zero error");
+STATIC_STRING(_negativeSqrt, "Square root of negative number");
+STATIC_STRING(_negativeExponent, "Exponent of 'BigInt.modpow' must not be negative");
+
+STATIC_STRING(_invalidTypeError, "Arguments to 'BigInt.%s' must be integers");
+STATIC_STRING(_shiftTypeError, "Shift count for 'BigInt.%s' must be of type 'Integer64'");
+
+STATIC_STRING(_stringTypeError, "Second argument to 'string' must be of type 'Integer64'.");
+STATIC_STRING(_numericBaseError, "Valid numeric base must be in the range of 2..36");
+STATIC_STRING(_parseArguments, "Illegal arguments to 'parse' function");
+
+/// <summary>
+/// Get the value of an argument to a BigInt method as a BigInt.  BigInt methods accept any
+/// integer type as an argument, so smaller integers are promoted here.
+/// </summary>
+static BigInt ArgToBigInt(SmileArg arg, const char *methodName)
+{
+	switch (SMILE_KIND(arg.obj)) {
+		case SMILE_KIND_BIGINT:
+			return ((SmileBigInt)arg.obj)->value;
+		case SMILE_KIND_UNBOXED_INTEGER64:
+			return BigInt_FromInt64(arg.unboxed.i64);
+		case SMILE_KIND_UNBOXED_INTEGER32:
+			return BigInt_FromInt64(arg.unboxed.i32);
+		case SMILE_KIND_UNBOXED_INTEGER16:
+			return BigInt_FromInt64(arg.unboxed.i16);
+		case SMILE_KIND_UNBOXED_BYTE:
+			return BigInt_FromInt64(arg.unboxed.i8);
+		default:
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_FormatString(_invalidTypeError, methodName));
+			return BigInt_Zero;
+	}
+}
+
+Inline SmileArg BigIntArg(BigInt value)
+{
+	return SmileArg_From((SmileObject)SmileBigInt_Create(value));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Generic type conversion
+
+SMILE_EXTERNAL_FUNCTION(ToBool)
+{
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_BIGINT)
+		return SmileUnboxedBool_From(!BigInt_IsZero(((SmileBigInt)argv[0].obj)->value));
+
+	return SmileUnboxedBool_From(True);
+}
+
+SMILE_EXTERNAL_FUNCTION(ToInt)
+{
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_BIGINT)
+		return SmileUnboxedInteger64_From(BigInt_ToInt64(((SmileBigInt)argv[0].obj)->value));
+
+	return SmileUnboxedInteger64_From(0);
+}
+
+SMILE_EXTERNAL_FUNCTION(ToString)
+{
+	Int numericBase;
+	STATIC_STRING(bigInt, "BigInt");
+
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_BIGINT) {
+		if (argc == 2) {
+			if (SMILE_KIND(argv[1].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error, _stringTypeError);
+			numericBase = (Int)argv[1].unboxed.i64;
+			if (numericBase < 2 || numericBase > 36)
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error, _numericBaseError);
+		}
+		else numericBase = 10;
+
+		return SmileArg_From((SmileObject)BigInt_ToString(((SmileBigInt)argv[0].obj)->value, numericBase));
+	}
+
+	return SmileArg_From((SmileObject)bigInt);
+}
+
+SMILE_EXTERNAL_FUNCTION(Hash)
+{
+	SmileBigInt obj = (SmileBigInt)argv[0].obj;
+
+	if (SMILE_KIND(obj) == SMILE_KIND_BIGINT)
+		return SmileUnboxedInteger64_From(BigInt_Hash(obj->value));
+
+	return SmileUnboxedInteger64_From(Smile_ApplyHashOracle((UInt64)(PtrInt)obj));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Specialized type conversion
+
+SMILE_EXTERNAL_FUNCTION(ToInt64)
+{
+	return SmileUnboxedInteger64_From(BigInt_ToInt64(((SmileBigInt)argv[0].obj)->value));
+}
+
+SMILE_EXTERNAL_FUNCTION(ToReal64)
+{
+	return SmileUnboxedReal64_From(BigInt_ToReal64(((SmileBigInt)argv[0].obj)->value));
+}
+
+SMILE_EXTERNAL_FUNCTION(ToFloat64)
+{
+	return SmileUnboxedFloat64_From(BigInt_ToFloat64(((SmileBigInt)argv[0].obj)->value));
+}
+
+SMILE_EXTERNAL_FUNCTION(FitsInInt64)
+{
+	return SmileUnboxedBool_From(BigInt_FitsInInt64(((SmileBigInt)argv[0].obj)->value));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Parsing
+
+static SmileArg ParseWithBase(SmileObject obj, Int64 numericBase)
+{
+	String str = (String)obj;
+	BigInt value;
+
+	if (numericBase < 2 || numericBase > 36)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _numericBaseError);
+	if (!BigInt_TryParse(String_GetBytes(str), String_Length(str), (Int)numericBase, &value))
+		return SmileArg_From(NullObject);
+
+	return BigIntArg(value);
+}
+
+SMILE_EXTERNAL_FUNCTION(Parse)
+{
+	switch (argc) {
+
+		case 1:
+			// The form [parse string].
+			if (SMILE_KIND(argv[0].obj) != SMILE_KIND_STRING)
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error, _parseArguments);
+			return ParseWithBase(argv[0].obj, 10);
+
+		case 2:
+			// Either the form [parse string base] or [obj.parse string].
+			if (SMILE_KIND(argv[0].obj) == SMILE_KIND_STRING && SMILE_KIND(argv[1].obj) == SMILE_KIND_UNBOXED_INTEGER64)
+				return ParseWithBase(argv[0].obj, argv[1].unboxed.i64);
+			else if (SMILE_KIND(argv[1].obj) == SMILE_KIND_STRING)
+				return ParseWithBase(argv[1].obj, 10);
+			else
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error, _parseArguments);
+
+		case 3:
+			// The form [obj.parse string base].
+			if (SMILE_KIND(argv[1].obj) != SMILE_KIND_STRING || SMILE_KIND(argv[2].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error, _parseArguments);
+			return ParseWithBase(argv[1].obj, argv[2].unboxed.i64);
+	}
+
+	return SmileArg_From(NullObject);	// Can't get here, but the compiler doesn't know that.
+}
+
+//-------------------------------------------------------------------------------------------------
+// Arithmetic operators
+
+SMILE_EXTERNAL_FUNCTION(Plus)
+{
+	BigInt x;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "+");
+	for (i = 1; i < argc; i++) {
+		x = BigInt_Add(x, ArgToBigInt(argv[i], "+"));
+	}
+	return BigIntArg(x);
+}
+
+SMILE_EXTERNAL_FUNCTION(Minus)
+{
+	BigInt x;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "-");
+	if (argc == 1)
+		return BigIntArg(BigInt_Neg(x));
+
+	for (i = 1; i < argc; i++) {
+		x = BigInt_Sub(x, ArgToBigInt(argv[i], "-"));
+	}
+	return BigIntArg(x);
+}
+
+SMILE_EXTERNAL_FUNCTION(Star)
+{
+	BigInt x;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "*");
+	for (i = 1; i < argc; i++) {
+		x = BigInt_Mul(x, ArgToBigInt(argv[i], "*"));
+	}
+	return BigIntArg(x);
+}
+
+/// <summary>
+/// Deal with division-by-zero.
+/// </summary>
+/// <param name="param">A pointer to a MathInfo struct that describes how to handle divide-by-zero.</param>
+/// <returns>0 if this is a quiet divide-by-zero, or a thrown exception if this is supposed to be an error.</returns>
+static SmileArg DivideByZero(void *param)
+{
+	MathInfo mathInfo = (MathInfo)param;
+
+	if (mathInfo->isLoud)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _divideByZero);
+
+	return BigIntArg(BigInt_Zero);
+}
+
+SMILE_EXTERNAL_FUNCTION(Slash)
+{
+	BigInt x, q, r;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "/");
+	for (i = 1; i < argc; i++) {
+		if (!BigInt_DivMod(x, ArgToBigInt(argv[i], "/"), &q, &r))
+			return DivideByZero(param);
+		x = q;
+	}
+	return BigIntArg(x);
+}
+
+SMILE_EXTERNAL_FUNCTION(Div)
+{
+	BigInt x, q, r;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "div");
+	for (i = 1; i < argc; i++) {
+		if (!BigInt_DivRem(x, ArgToBigInt(argv[i], "div"), &q, &r))
+			return DivideByZero(param);
+		x = q;
+	}
+	return BigIntArg(x);
+}
+
+SMILE_EXTERNAL_FUNCTION(Mod)
+{
+	BigInt q, r;
+
+	if (!BigInt_DivMod(ArgToBigInt(argv[0], "mod"), ArgToBigInt(argv[1], "mod"), &q, &r))
+		return DivideByZero(param);
+
+	return BigIntArg(r);
+}
+
+SMILE_EXTERNAL_FUNCTION(Rem)
+{
+	BigInt q, r;
+
+	if (!BigInt_DivRem(ArgToBigInt(argv[0], "rem"), ArgToBigInt(argv[1], "rem"), &q, &r))
+		return DivideByZero(param);
+
+	return BigIntArg(r);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Arithmetic extensions
+
+SMILE_EXTERNAL_FUNCTION(Sign)
+{
+	return SmileUnboxedInteger64_From(((SmileBigInt)argv[0].obj)->value->sign);
+}
+
+SMILE_EXTERNAL_FUNCTION(Abs)
+{
+	BigInt value = ((SmileBigInt)argv[0].obj)->value;
+
+	return BigInt_IsNeg(value) ? BigIntArg(BigInt_Abs(value)) : argv[0];
+}
+
+SMILE_EXTERNAL_FUNCTION(Min)
+{
+	BigInt x, y;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "min");
+	for (i = 1; i < argc; i++) {
+		y = ArgToBigInt(argv[i], "min");
+		if (BigInt_Compare(y, x) < 0) x = y;
+	}
+	return BigIntArg(x);
+}
+
+SMILE_EXTERNAL_FUNCTION(Max)
+{
+	BigInt x, y;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "max");
+	for (i = 1; i < argc; i++) {
+		y = ArgToBigInt(argv[i], "max");
+		if (BigInt_Compare(y, x) > 0) x = y;
+	}
+	return BigIntArg(x);
+}
+
+/// <summary>
+/// Raise x to an integer power.  As with the other integer types, negative powers round
+/// toward zero, so they are zero unless x is 1 or -1.
+/// </summary>
+static BigInt IntPower(BigInt x, BigInt exponent)
+{
+	if (BigInt_IsNeg(exponent)) {
+		if (x->length == 1 && x->limbs[0] == 1)
+			return BigInt_IsOdd(exponent) ? x : BigInt_One;
+		return BigInt_Zero;
+	}
+
+	return BigInt_Pow(x, (UInt64)BigInt_ToInt64(exponent));
+}
+
+SMILE_EXTERNAL_FUNCTION(Power)
+{
+	BigInt x;
+	Int i;
+
+	x = ArgToBigInt(argv[0], "^");
+	for (i = 1; i < argc; i++) {
+		x = IntPower(x, ArgToBigInt(argv[i], "^"));
+	}
+	return BigIntArg(x);
+}
+
+SMILE_EXTERNAL_FUNCTION(ModPow)
+{
+	BigInt exponent, modulus, result;
+
+	exponent = ArgToBigInt(argv[1], "modpow");
+	modulus = ArgToBigInt(argv[2], "modpow");
+
+	if (BigInt_IsNeg(exponent))
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _negativeExponent);
+	if (!BigInt_ModPow(ArgToBigInt(argv[0], "modpow"), exponent, modulus, &result))
+		return DivideByZero(param);
+
+	return BigIntArg(result);
+}
+
+SMILE_EXTERNAL_FUNCTION(Sqrt)
+{
+	BigInt result;
+
+	if (!BigInt_Sqrt(((SmileBigInt)argv[0].obj)->value, &result)) {
+		MathInfo mathInfo = (MathInfo)param;
+		if (mathInfo->isLoud)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, _negativeSqrt);
+	}
+
+	return BigIntArg(result);
+}
+
+SMILE_EXTERNAL_FUNCTION(Gcd)
+{
+	return BigIntArg(BigInt_Gcd(ArgToBigInt(argv[0], "gcd"), ArgToBigInt(argv[1], "gcd")));
+}
+
+SMILE_EXTERNAL_FUNCTION(Lcm)
+{
+	BigInt a, b, gcd, q, r;
+
+	a = ArgToBigInt(argv[0], "lcm");
+	b = ArgToBigInt(argv[1], "lcm");
+	if (BigInt_IsZero(a) || BigInt_IsZero(b))
+		return BigIntArg(BigInt_Zero);
+
+	gcd = BigInt_Gcd(a, b);
+	BigInt_DivRem(BigInt_Abs(a), gcd, &q, &r);
+	return BigIntArg(BigInt_Mul(q, BigInt_Abs(b)));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Bit operations
+
+SMILE_EXTERNAL_FUNCTION(ShiftLeft)
+{
+	if (SMILE_KIND(argv[1].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FormatString(_shiftTypeError, "<<"));
+
+	return BigIntArg(BigInt_ShiftLeft(((SmileBigInt)argv[0].obj)->value, argv[1].unboxed.i64));
+}
+
+SMILE_EXTERNAL_FUNCTION(ShiftRight)
+{
+	if (SMILE_KIND(argv[1].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FormatString(_shiftTypeError, ">>"));
+
+	return BigIntArg(BigInt_ShiftRight(((SmileBigInt)argv[0].obj)->value, argv[1].unboxed.i64));
+}
+
+SMILE_EXTERNAL_FUNCTION(BitLength)
+{
+	return SmileUnboxedInteger64_From(BigInt_BitLength(((SmileBigInt)argv[0].obj)->value));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Comparisons
+
+/// <summary>
+/// Compare a BigInt against another argument, which may be any integer type.  This
+/// returns False if the other argument is not an integer at all.
+/// </summary>
+static Bool TryCompare(SmileArg a, SmileArg b, Int *cmp)
+{
+	switch (SMILE_KIND(b.obj)) {
+		case SMILE_KIND_BIGINT:
+		case SMILE_KIND_UNBOXED_INTEGER64:
+		case SMILE_KIND_UNBOXED_INTEGER32:
+		case SMILE_KIND_UNBOXED_INTEGER16:
+		case SMILE_KIND_UNBOXED_BYTE:
+			*cmp = BigInt_Compare(((SmileBigInt)a.obj)->value, ArgToBigInt(b, "compare"));
+			return True;
+		default:
+			*cmp = 0;
+			return False;
+	}
+}
+
+SMILE_EXTERNAL_FUNCTION(Eq)
+{
+	Int cmp;
+	return SmileUnboxedBool_From(TryCompare(argv[0], argv[1], &cmp) && cmp == 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(Ne)
+{
+	Int cmp;
+	return SmileUnboxedBool_From(!TryCompare(argv[0], argv[1], &cmp) || cmp != 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(Lt)
+{
+	return SmileUnboxedBool_From(BigInt_Compare(((SmileBigInt)argv[0].obj)->value, ArgToBigInt(argv[1], "<")) < 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(Gt)
+{
+	return SmileUnboxedBool_From(BigInt_Compare(((SmileBigInt)argv[0].obj)->value, ArgToBigInt(argv[1], ">")) > 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(Le)
+{
+	return SmileUnboxedBool_From(BigInt_Compare(((SmileBigInt)argv[0].obj)->value, ArgToBigInt(argv[1], "<=")) <= 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(Ge)
+{
+	return SmileUnboxedBool_From(BigInt_Compare(((SmileBigInt)argv[0].obj)->value, ArgToBigInt(argv[1], ">=")) >= 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(Compare)
+{
+	return SmileUnboxedInteger64_From(BigInt_Compare(((SmileBigInt)argv[0].obj)->value, ArgToBigInt(argv[1], "compare")));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+enum {
+	ZERO_TEST,
+	ONE_TEST,
+	NONZERO_TEST,
+	POS_TEST,
+	NONPOS_TEST,
+	NEG_TEST,
+	NONNEG_TEST,
+	ODD_TEST,
+	EVEN_TEST,
+};
+
+SMILE_EXTERNAL_FUNCTION(ValueTest)
+{
+	BigInt value = ((SmileBigInt)argv[0].obj)->value;
+
+	switch ((PtrInt)param) {
+		case ZERO_TEST:
+			return SmileUnboxedBool_From(value->sign == 0);
+		case ONE_TEST:
+			return SmileUnboxedBool_From(BigInt_Eq(value, BigInt_One));
+		case NONZERO_TEST:
+			return SmileUnboxedBool_From(value->sign != 0);
+		case POS_TEST:
+			return SmileUnboxedBool_From(value->sign > 0);
+		case NONPOS_TEST:
+			return SmileUnboxedBool_From(value->sign <= 0);
+		case NEG_TEST:
+			return SmileUnboxedBool_From(value->sign < 0);
+		case NONNEG_TEST:
+			return SmileUnboxedBool_From(value->sign >= 0);
+		case ODD_TEST:
+			return SmileUnboxedBool_From(BigInt_IsOdd(value));
+		case EVEN_TEST:
+			return SmileUnboxedBool_From(!BigInt_IsOdd(value));
+		default:
+			return SmileArg_From(NullObject);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SmileBigInt_Setup(SmileUserObject base)
+{
+	SetupFunction("bool", ToBool, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("int", ToInt, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("string", ToString, NULL, "value", ARG_CHECK_MIN | ARG_CHECK_MAX, 1, 2, 0, NULL);
+	SetupFunction("hash", Hash, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+
+	SetupFunction("int64", ToInt64, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("float64", ToFloat64, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("float", ToFloat64, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("real64", ToReal64, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("real", ToReal64, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("int64?", FitsInInt64, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+
+	SetupFunction("parse", Parse, NULL, "value", ARG_CHECK_MIN | ARG_CHECK_MAX, 1, 3, 0, NULL);
+
+	SetupFunction("+", Plus, NULL, "augend addend", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 1, 0, 2, _bigIntChecks);
+	SetupFunction("-", Minus, NULL, "minuend subtrahend", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 1, 0, 2, _bigIntChecks);
+	SetupFunction("*", Star, NULL, "multiplier multiplicand", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 2, 0, 2, _bigIntChecks);
+
+	SetupFunction("/", Slash, &_quietMath, "dividend divisor", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 2, 0, 2, _bigIntChecks);
+	SetupFunction("/!", Slash, &_loudMath, "dividend divisor", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 2, 0, 2, _bigIntChecks);
+	SetupFunction("div", Div, &_quietMath, "dividend divisor", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 2, 0, 2, _bigIntChecks);
+	SetupFunction("div!", Div, &_loudMath, "dividend divisor", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 2, 0, 2, _bigIntChecks);
+	SetupFunction("mod", Mod, &_quietMath, "dividend divisor", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("mod!", Mod, &_loudMath, "dividend divisor", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("rem", Rem, &_quietMath, "dividend divisor", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("rem!", Rem, &_loudMath, "dividend divisor", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+
+	SetupFunction("sign", Sign, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("abs", Abs, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("min", Min, NULL, "x y", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 1, 0, 2, _bigIntChecks);
+	SetupFunction("max", Max, NULL, "x y", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 1, 0, 2, _bigIntChecks);
+
+	SetupFunction("^", Power, NULL, "x y", ARG_CHECK_MIN | ARG_CHECK_TYPES | ARG_PURE, 1, 0, 2, _bigIntChecks);
+	SetupFunction("modpow", ModPow, &_quietMath, "x exponent modulus", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 3, 3, 2, _bigIntChecks);
+	SetupFunction("modpow!", ModPow, &_loudMath, "x exponent modulus", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 3, 3, 2, _bigIntChecks);
+	SetupFunction("sqrt", Sqrt, &_quietMath, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("sqrt!", Sqrt, &_loudMath, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("gcd", Gcd, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("lcm", Lcm, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+
+	SetupFunction("<<", ShiftLeft, NULL, "value count", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction(">>", ShiftRight, NULL, "value count", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("bit-length", BitLength, NULL, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+
+	SetupFunction("odd?", ValueTest, (void *)ODD_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("even?", ValueTest, (void *)EVEN_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("zero?", ValueTest, (void *)ZERO_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("one?", ValueTest, (void *)ONE_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("nonzero?", ValueTest, (void *)NONZERO_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupFunction("positive?", ValueTest, (void *)POS_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupSynonym("positive?", "pos?");
+	SetupFunction("nonpositive?", ValueTest, (void *)NONPOS_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupSynonym("nonpositive?", "nonpos?");
+	SetupFunction("negative?", ValueTest, (void *)NEG_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupSynonym("negative?", "neg?");
+	SetupFunction("nonnegative?", ValueTest, (void *)NONNEG_TEST, "value", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 2, _bigIntChecks);
+	SetupSynonym("nonnegative?", "nonneg?");
+
+	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+
+	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _bigIntChecks);
+	SetupSynonym("compare", "cmp");
+}
@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smilebyte.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -41,6 +42,7 @@ SmileByte SmileByte_CreateInternal(Byte value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileByte smileInt = (SmileByte)GC_MALLOC_ATOMIC(sizeof(struct SmileByteInt));
 	if (smileInt == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_BYTE, sizeof(struct SmileByteInt));
 	smileInt->base = (SmileObject)Smile_KnownBases.Byte;
 	smileInt->kind = SMILE_KIND_BYTE;
 	smileInt->vtable = SmileByte_VTable;
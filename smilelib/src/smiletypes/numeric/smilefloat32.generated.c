@@ -23,6 +23,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smilefloat32.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -42,6 +43,7 @@ SmileFloat32 SmileFloat32_Create(Float32 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileFloat32 smileFloat = (SmileFloat32)GC_MALLOC_ATOMIC(sizeof(struct SmileFloat32Int));
 	if (smileFloat == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_FLOAT32, sizeof(struct SmileFloat32Int));
 	smileFloat->base = (SmileObject)Smile_KnownBases.Float32;
 	smileFloat->kind = SMILE_KIND_FLOAT32;
 	smileFloat->vtable = SmileFloat32_VTable;
@@ -60,7 +62,7 @@ SMILE_EASY_OBJECT_NO_SOURCE(SmileFloat32)
 SMILE_EASY_OBJECT_NO_PROPERTIES(SmileFloat32)
 
 SMILE_EASY_OBJECT_TOBOOL(SmileFloat32, unboxedData.f32 != 0.0f)
-SMILE_EASY_OBJECT_TOSTRING(SmileFloat32, Float64_ToStringEx((Float64)unboxedData.f32, 0, 0, False))
+SMILE_EASY_OBJECT_TOSTRING(SmileFloat32, Float32_ToStringEx(unboxedData.f32, 0, 0, False))
 
 static Bool SmileFloat32_CompareEqual(SmileFloat32 a, SmileUnboxedData aData, SmileObject b, SmileUnboxedData bData)
 {
@@ -107,7 +109,7 @@ SMILE_EASY_OBJECT_NO_PROPERTIES(SmileUnboxedFloat32)
 
 SMILE_EASY_OBJECT_HASH(SmileUnboxedFloat32, 0)
 SMILE_EASY_OBJECT_TOBOOL(SmileUnboxedFloat32, unboxedData.f32 != 0.0f)
-SMILE_EASY_OBJECT_TOSTRING(SmileUnboxedFloat32, Float64_ToStringEx((Float64)unboxedData.f32, 0, 0, False))
+SMILE_EASY_OBJECT_TOSTRING(SmileUnboxedFloat32, Float32_ToStringEx(unboxedData.f32, 0, 0, False))
 
 static Bool SmileUnboxedFloat32_CompareEqual(SmileUnboxedFloat32 a, SmileUnboxedData aData, SmileObject b, SmileUnboxedData bData)
 {
@@ -23,6 +23,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smilefloat64.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -42,6 +43,7 @@ SmileFloat64 SmileFloat64_Create(Float64 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileFloat64 smileFloat = (SmileFloat64)GC_MALLOC_ATOMIC(sizeof(struct SmileFloat64Int));
 	if (smileFloat == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_FLOAT64, sizeof(struct SmileFloat64Int));
 	smileFloat->base = (SmileObject)Smile_KnownBases.Float64;
 	smileFloat->kind = SMILE_KIND_FLOAT64;
 	smileFloat->vtable = SmileFloat64_VTable;
@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smileinteger16.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -41,6 +42,7 @@ SmileInteger16 SmileInteger16_CreateInternal(Int16 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileInteger16 smileInt = (SmileInteger16)GC_MALLOC_ATOMIC(sizeof(struct SmileInteger16Int));
 	if (smileInt == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_INTEGER16, sizeof(struct SmileInteger16Int));
 	smileInt->base = (SmileObject)Smile_KnownBases.Integer16;
 	smileInt->kind = SMILE_KIND_INTEGER16;
 	smileInt->vtable = SmileInteger16_VTable;
@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smileinteger32.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -41,6 +42,7 @@ SmileInteger32 SmileInteger32_CreateInternal(Int32 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileInteger32 smileInt = (SmileInteger32)GC_MALLOC_ATOMIC(sizeof(struct SmileInteger32Int));
 	if (smileInt == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_INTEGER32, sizeof(struct SmileInteger32Int));
 	smileInt->base = (SmileObject)Smile_KnownBases.Integer32;
 	smileInt->kind = SMILE_KIND_INTEGER32;
 	smileInt->vtable = SmileInteger32_VTable;
@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smileinteger64.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -41,6 +42,7 @@ SmileInteger64 SmileInteger64_CreateInternal(Int64 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileInteger64 smileInt = (SmileInteger64)GC_MALLOC_ATOMIC(sizeof(struct SmileInteger64Int));
 	if (smileInt == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_INTEGER64, sizeof(struct SmileInteger64Int));
 	smileInt->base = (SmileObject)Smile_KnownBases.Integer64;
 	smileInt->kind = SMILE_KIND_INTEGER64;
 	smileInt->vtable = SmileInteger64_VTable;
@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smilereal32.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -41,6 +42,7 @@ SmileReal32 SmileReal32_Create(Real32 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileReal32 smileReal = (SmileReal32)GC_MALLOC_ATOMIC(sizeof(struct SmileReal32Int));
 	if (smileReal == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_REAL32, sizeof(struct SmileReal32Int));
 	smileReal->base = (SmileObject)Smile_KnownBases.Real32;
 	smileReal->kind = SMILE_KIND_REAL32;
 	smileReal->vtable = SmileReal32_VTable;
@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -41,6 +42,7 @@ SmileReal64 SmileReal64_Create(Real64 value)
 	// We MALLOC_ATOMIC here because the base is a known pointer that will never be collected.
 	SmileReal64 smileReal = (SmileReal64)GC_MALLOC_ATOMIC(sizeof(struct SmileReal64Int));
 	if (smileReal == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_REAL64, sizeof(struct SmileReal64Int));
 	smileReal->base = (SmileObject)Smile_KnownBases.Real64;
 	smileReal->kind = SMILE_KIND_REAL64;
 	smileReal->vtable = SmileReal64_VTable;
@@ -23,6 +23,7 @@
 #include <smile/smiletypes/easyobject.h>
 #include <smile/smiletypes/smilelist.h>
 #include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/env/gcstats.h>
 
 //-------------------------------------------------------------------------------------------------
 // Definitions, and static data.
@@ -69,8 +70,9 @@ SMILE_EASY_OBJECT_VTABLE(SmileTimestamp);
 /// <returns>A new SmileTimestamp object that represents the given seconds/nanos tuple.</returns>
 SmileTimestamp SmileTimestamp_Create(Int64 seconds, UInt32 nanos)
 {
-	SmileTimestamp timestamp = GC_MALLOC_STRUCT(struct SmileTimestampInt);
+	SmileTimestamp timestamp = (SmileTimestamp)GC_MALLOC_ATOMIC(sizeof(struct SmileTimestampInt));
 	if (timestamp == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_TIMESTAMP, sizeof(struct SmileTimestampInt));
 	timestamp->base = (SmileObject)Smile_KnownBases.Timestamp;
 	timestamp->kind = SMILE_KIND_TIMESTAMP;
 	timestamp->vtable = SmileTimestamp_VTable;
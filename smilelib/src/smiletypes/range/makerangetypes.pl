@@ -91,6 +91,8 @@ EOI
 	"include" => "<smile/smiletypes/numeric/smileinteger64.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "1",
+	"Numeric" => "1",
+	"Integral" => "1",
 	"Modulus" => "a % b",
 
 	"ToInt32" => "(Int32)(obj->end - obj->start)",
@@ -131,6 +133,8 @@ OutputTemplate(\@rangeBaseTemplate, \%int64Substitutions, "smileinteger64range_b
 	"include" => "<smile/smiletypes/numeric/smileinteger32.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "1",
+	"Numeric" => "1",
+	"Integral" => "1",
 	"Modulus" => "a % b",
 
 	"ToInt32" => "(obj->end - obj->start)",
@@ -171,6 +175,8 @@ OutputTemplate(\@rangeBaseTemplate, \%int32Substitutions, "smileinteger32range_b
 	"include" => "<smile/smiletypes/numeric/smileinteger16.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "1",
+	"Numeric" => "1",
+	"Integral" => "1",
 	"Modulus" => "a % b",
 
 	"ToInt32" => "(obj->end - obj->start)",
@@ -211,6 +217,8 @@ OutputTemplate(\@rangeBaseTemplate, \%int16Substitutions, "smileinteger16range_b
 	"include" => "<smile/smiletypes/numeric/smilebyte.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "1",
+	"Numeric" => "1",
+	"Integral" => "1",
 	"Modulus" => "a % b",
 
 	"ToInt32" => "((Int32)obj->end - (Int32)obj->start)",
@@ -263,6 +271,8 @@ EOI
 	"include" => "<smile/smiletypes/text/smilechar.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "0",
+	"Numeric" => "0",
+	"Integral" => "1",
 	"Modulus" => "a % b",
 
 	"ToInt32" => "((Int32)obj->end - (Int32)obj->start)",
@@ -310,6 +320,8 @@ EOI
 	"include" => "<smile/smiletypes/text/smileuni.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "0",
+	"Numeric" => "0",
+	"Integral" => "1",
 	"Modulus" => "a % b",
 
 	"ToInt32" => "((Int32)obj->end - (Int32)obj->start)",
@@ -362,6 +374,8 @@ EOI
 	"include" => "<smile/smiletypes/numeric/smilefloat32.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "0",
+	"Numeric" => "1",
+	"Integral" => "0",
 	"Modulus" => "fmodf(a, b)",
 
 	"ToInt32" => "(Int32)(obj->end - obj->start)",
@@ -402,6 +416,8 @@ OutputTemplate(\@rangeBaseTemplate, \%float32Substitutions, "smilefloat32range_b
 	"include" => "<smile/smiletypes/numeric/smilefloat64.h>",
 	"length" => "self->end > self->start ? self->end - self->start + 1 : self->start - self->end + 1",
 	"OtherBases" => "0",
+	"Numeric" => "1",
+	"Integral" => "0",
 	"Modulus" => "fmod(a, b)",
 
 	"ToInt32" => "(Int32)(obj->end - obj->start)",
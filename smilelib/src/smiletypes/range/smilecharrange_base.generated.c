@@ -63,6 +63,12 @@ static Byte _findChecks[] = {
 	0, 0,
 };
 
+static Byte _foldChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_CHARRANGE,
+	0, 0,
+	SMILE_KIND_MASK, SMILE_KIND_FUNCTION,
+};
+
 static Byte _charChecks[] = {
 	SMILE_KIND_MASK, SMILE_KIND_CHARRANGE,
 	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_CHAR,
@@ -943,6 +949,318 @@ SMILE_EXTERNAL_FUNCTION(All)
 	return (SmileArg) { NULL };	// We have to return something, but this value will be ignored.
 }
 
+//-------------------------------------------------------------------------------------------------
+// Reductions
+
+/// <summary>
+/// Find out whether this range describes no values at all, which happens when its stepping
+/// points away from its end.
+/// </summary>
+Inline Bool IsEmptyRange(SmileCharRange range)
+{
+	return range->end >= range->start ? range->stepping <= 0 : range->stepping >= 0;
+}
+
+#if 1
+
+/// <summary>
+/// Count how many steps it takes to get from the start of a nonempty range to its last value.
+/// </summary>
+static UInt64 GetLastIndex(SmileCharRange range)
+{
+	UInt64 span = range->end >= range->start
+		? (UInt64)(Byte)((Byte)range->end - (Byte)range->start)
+		: (UInt64)(Byte)((Byte)range->start - (Byte)range->end);
+	UInt64 stride = range->stepping > 0 ? (UInt64)range->stepping : (UInt64)0 - (UInt64)range->stepping;
+	return span / stride;
+}
+
+/// <summary>
+/// Get the last value that iterating a nonempty range would produce, which may fall short of its end.
+/// </summary>
+static Byte GetLastValue(SmileCharRange range)
+{
+	return (Byte)((UInt64)(Int64)range->start + GetLastIndex(range) * (UInt64)(Int64)range->stepping);
+}
+
+#else
+
+/// <summary>
+/// Get the last value that iterating a nonempty range would produce, which may fall short of its end.
+/// This steps through the range exactly as 'each' does, so it matches 'each' even when the steps round.
+/// </summary>
+static Byte GetLastValue(SmileCharRange range)
+{
+	Byte current = range->start;
+
+	if (range->end >= range->start) {
+		while ((Int64)range->end - range->stepping >= (Int64)current)
+			current = (Byte)((Int64)current + range->stepping);
+	}
+	else {
+		while ((Int64)range->end - range->stepping <= (Int64)current)
+			current = (Byte)((Int64)current + range->stepping);
+	}
+	return current;
+}
+
+#endif
+
+#if 0
+
+SMILE_EXTERNAL_FUNCTION(Sum)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return SmileUnboxedChar_From(0);
+
+#if 1
+	{
+		// Use the closed form, n*start + stepping*(m*(m+1)/2) for m = n - 1, in wraparound math,
+		// which is exactly what adding up the values one at a time with '+' would produce.
+		UInt64 m = GetLastIndex(range);
+		UInt64 triangle = (m & 1) ? m * (m / 2 + 1) : (m / 2) * (m + 1);
+		UInt64 sum = (m + 1) * (UInt64)(Int64)range->start + triangle * (UInt64)(Int64)range->stepping;
+		return SmileUnboxedChar_From((Byte)sum);
+	}
+#else
+	{
+		Byte current = range->start, sum = range->start;
+
+		if (range->end >= range->start) {
+			while ((Int64)range->end - range->stepping >= (Int64)current) {
+				current = (Byte)((Int64)current + range->stepping);
+				sum += current;
+			}
+		}
+		else {
+			while ((Int64)range->end - range->stepping <= (Int64)current) {
+				current = (Byte)((Int64)current + range->stepping);
+				sum += current;
+			}
+		}
+		return SmileUnboxedChar_From(sum);
+	}
+#endif
+}
+
+SMILE_EXTERNAL_FUNCTION(Product)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return SmileUnboxedChar_From(1);
+
+#if 1
+	{
+		// Multiply in wraparound math; once the product wraps to zero, it stays there.
+		UInt64 m = GetLastIndex(range), i;
+		UInt64 current = (UInt64)(Int64)range->start, step = (UInt64)(Int64)range->stepping;
+		UInt64 product = current;
+
+		for (i = 0; i < m && (Byte)product != 0; i++) {
+			current += step;
+			product *= current;
+		}
+		return SmileUnboxedChar_From((Byte)product);
+	}
+#else
+	{
+		Byte current = range->start, product = range->start;
+
+		if (range->end >= range->start) {
+			while ((Int64)range->end - range->stepping >= (Int64)current) {
+				current = (Byte)((Int64)current + range->stepping);
+				product *= current;
+			}
+		}
+		else {
+			while ((Int64)range->end - range->stepping <= (Int64)current) {
+				current = (Byte)((Int64)current + range->stepping);
+				product *= current;
+			}
+		}
+		return SmileUnboxedChar_From(product);
+	}
+#endif
+}
+
+#endif
+
+SMILE_EXTERNAL_FUNCTION(Min)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return SmileArg_From(NullObject);
+
+	// The values are monotonic, so the least is always at one end or the other.
+	return SmileUnboxedChar_From(range->end >= range->start ? range->start : GetLastValue(range));
+}
+
+SMILE_EXTERNAL_FUNCTION(Max)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return SmileArg_From(NullObject);
+
+	return SmileUnboxedChar_From(range->end >= range->start ? GetLastValue(range) : range->start);
+}
+
+typedef enum {
+	ReduceMode_MinBy,
+	ReduceMode_MaxBy,
+	ReduceMode_Fold,
+} ReduceMode;
+
+typedef struct ReduceInfoStruct {
+	SmileCharRange range;
+	SmileFunction function;
+	SmileArg acc;
+	SmileArg bestKey;
+	Byte current;
+	Byte mode;
+	Bool done;
+	Bool up;
+	Bool hasKey;
+} *ReduceInfo;
+
+static Int ReduceStart(ClosureStateMachine closure)
+{
+	register ReduceInfo loopInfo = (ReduceInfo)closure->state;
+
+	//---------- begin first for-loop iteration ----------
+
+	// Condition: If we've run out of values, we're done.
+	if (loopInfo->done) {
+		Closure_Push(closure, loopInfo->acc);
+		return -1;
+	}
+
+	// Body: Set up to call the user's function with the next value.
+	Closure_PushBoxed(closure, loopInfo->function);
+	if (loopInfo->mode == ReduceMode_Fold) {
+		Closure_Push(closure, loopInfo->acc);
+		Closure_PushUnboxedChar(closure, loopInfo->current);
+		return 2;
+	}
+	Closure_PushUnboxedChar(closure, loopInfo->current);
+	return 1;
+}
+
+static Int ReduceBody(ClosureStateMachine closure)
+{
+	register ReduceInfo loopInfo = (ReduceInfo)closure->state;
+	SmileCharRange range = loopInfo->range;
+	Int cmp;
+
+	// Body: Fold the result of the user's function into the accumulator.
+	SmileArg fnResult = Closure_Pop(closure);
+
+	if (loopInfo->mode == ReduceMode_Fold) {
+		loopInfo->acc = fnResult;
+	}
+	else if (!loopInfo->hasKey) {
+		loopInfo->bestKey = fnResult;
+		loopInfo->hasKey = True;
+	}
+	else {
+		if (!SmileArg_TryCompare(fnResult, loopInfo->bestKey, &cmp))
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_Format("Cannot continue '%s': Keys must be numbers, characters, or strings, all of the same type.",
+					loopInfo->mode == ReduceMode_MinBy ? "min-by" : "max-by"));
+		if (loopInfo->mode == ReduceMode_MinBy ? cmp < 0 : cmp > 0) {
+			loopInfo->bestKey = fnResult;
+			loopInfo->acc = SmileUnboxedChar_From(loopInfo->current);
+		}
+	}
+
+	// Next: Move the iterator to the next item.
+	if (loopInfo->up) {
+		if ((Int64)range->end - range->stepping >= (Int64)loopInfo->current)
+			loopInfo->current = (Byte)((Int64)loopInfo->current + range->stepping);
+		else loopInfo->done = True;
+	}
+	else {
+		if ((Int64)range->end - range->stepping <= (Int64)loopInfo->current)
+			loopInfo->current = (Byte)((Int64)loopInfo->current + range->stepping);
+		else loopInfo->done = True;
+	}
+
+	//---------- end previous for-loop iteration ----------
+
+	return ReduceStart(closure);
+}
+
+static SmileArg BeginReduce(SmileCharRange range, SmileFunction function, SmileArg acc, Byte mode, Bool skipFirst)
+{
+	// We use Eval's state-machine construct to avoid recursing deeper on the C stack.
+	ClosureStateMachine closure = Eval_BeginStateMachine(ReduceStart, ReduceBody);
+	ReduceInfo loopInfo = (ReduceInfo)closure->state;
+
+	loopInfo->range = range;
+	loopInfo->function = function;
+	loopInfo->acc = acc;
+	loopInfo->bestKey = SmileArg_From(NullObject);
+	loopInfo->current = range->start;
+	loopInfo->mode = mode;
+	loopInfo->up = range->end >= range->start;
+	loopInfo->done = IsEmptyRange(range);
+	loopInfo->hasKey = False;
+
+	if (skipFirst && !loopInfo->done) {
+		if (loopInfo->up ? (Int64)range->end - range->stepping >= (Int64)loopInfo->current
+			: (Int64)range->end - range->stepping <= (Int64)loopInfo->current)
+			loopInfo->current = (Byte)((Int64)loopInfo->current + range->stepping);
+		else loopInfo->done = True;
+	}
+
+	return (SmileArg){ NULL };	// We have to return something, but this value will be ignored.
+}
+
+SMILE_EXTERNAL_FUNCTION(MinBy)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(range, (SmileFunction)argv[1].obj, SmileUnboxedChar_From(range->start), ReduceMode_MinBy, False);
+}
+
+SMILE_EXTERNAL_FUNCTION(MaxBy)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(range, (SmileFunction)argv[1].obj, SmileUnboxedChar_From(range->start), ReduceMode_MaxBy, False);
+}
+
+SMILE_EXTERNAL_FUNCTION(Fold)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	if (IsEmptyRange(range))
+		return argv[1];
+
+	return BeginReduce(range, (SmileFunction)argv[2].obj, argv[1], ReduceMode_Fold, False);
+}
+
+SMILE_EXTERNAL_FUNCTION(Reduce)
+{
+	SmileCharRange range = (SmileCharRange)argv[0].obj;
+
+	// Reducing starts with the first value, so an empty range has nothing to reduce.
+	if (IsEmptyRange(range))
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(range, (SmileFunction)argv[1].obj, SmileUnboxedChar_From(range->start), ReduceMode_Fold, True);
+}
+
 //-------------------------------------------------------------------------------------------------
 
 void SmileCharRange_Setup(SmileUserObject base)
@@ -974,4 +1292,15 @@ void SmileCharRange_Setup(SmileUserObject base)
 	SetupFunction("any?", Any, NULL, "range fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _findChecks);
 	SetupFunction("all?", All, NULL, "range fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _findChecks);
 	SetupSynonym("any?", "contains?");
+
+#if 0
+	SetupFunction("sum", Sum, NULL, "range", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("product", Product, NULL, "range", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+#endif
+	SetupFunction("min", Min, NULL, "range", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("max", Max, NULL, "range", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("min-by", MinBy, NULL, "range fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+	SetupFunction("max-by", MaxBy, NULL, "range fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+	SetupFunction("fold", Fold, NULL, "range init fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 3, 3, 3, _foldChecks);
+	SetupFunction("reduce", Reduce, NULL, "range fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
 }
@@ -0,0 +1,133 @@
+
+sub LoadTemplate {
+	my $templateFileName = $_[0];
+
+	open (my $file, '<:encoding(UTF-8)', $templateFileName)
+		or die "Could not open file '$templateFileName' for reading";
+
+	@lines = ();
+	while (my $line = <$file>) {
+		chomp $line;
+		push @lines, $line;
+	}
+
+	close $file;
+
+	return @lines;
+}
+
+sub OutputTemplate {
+	my @template = @{$_[0]};
+	my %substitutions = %{$_[1]};
+	my $outputFileName = $_[2];
+
+	print "$outputFileName\n";
+	open (my $file, '>encoding(UTF-8)', $outputFileName)
+		or die "Could not open file '$outputFileName' for writing";
+
+	print $file "// ===================================================\n";
+	print $file "//   WARNING: THIS IS A GENERATED FILE. DO NOT EDIT!\n";
+	print $file "// ===================================================\n\n";
+
+	foreach $line (@template) {
+		foreach $templateVariableName (keys %substitutions) {
+			$replacement = $substitutions{$templateVariableName};
+			$needle = quotemeta "%$templateVariableName%";
+			$line =~ s/$needle/$replacement/g;
+		}
+		print $file "$line\n";
+	}
+
+	close $file;
+}
+
+#--------------------------------------------------------------------------------------------
+
+@arrayTemplate = LoadTemplate("smilenumericarray.template");
+@arrayBaseTemplate = LoadTemplate("smilenumericarray_base.template");
+
+#--------------------------------------------------------------------------------------------
+
+%int32Substitutions = (
+	"type" => "integer32",
+	"Type" => "Integer32",
+	"TYPE" => "INTEGER32",
+	"RawType" => "Int32",
+	"VecType" => "Int32",
+	"ElementType" => "Integer32",
+	"TypeName" => "An Integer32",
+
+	"include" => "smileinteger32",
+	"accinclude" => "smileinteger64",
+	"UnboxedFrom" => "SmileUnboxedInteger32_From",
+	"AccFrom" => "SmileUnboxedInteger64_From",
+	"ElementToString" => "String_CreateFromInteger(array->data[i], 10, False)",
+);
+
+OutputTemplate(\@arrayTemplate, \%int32Substitutions, "smileinteger32array.generated.c");
+OutputTemplate(\@arrayBaseTemplate, \%int32Substitutions, "smileinteger32array_base.generated.c");
+
+#--------------------------------------------------------------------------------------------
+
+%int64Substitutions = (
+	"type" => "integer64",
+	"Type" => "Integer64",
+	"TYPE" => "INTEGER64",
+	"RawType" => "Int64",
+	"VecType" => "Int64",
+	"ElementType" => "Integer64",
+	"TypeName" => "An Integer64",
+
+	"include" => "smileinteger64",
+	"accinclude" => "smileinteger64",
+	"UnboxedFrom" => "SmileUnboxedInteger64_From",
+	"AccFrom" => "SmileUnboxedInteger64_From",
+	"ElementToString" => "String_CreateFromInteger(array->data[i], 10, False)",
+);
+
+OutputTemplate(\@arrayTemplate, \%int64Substitutions, "smileinteger64array.generated.c");
+OutputTemplate(\@arrayBaseTemplate, \%int64Substitutions, "smileinteger64array_base.generated.c");
+
+#--------------------------------------------------------------------------------------------
+
+%float32Substitutions = (
+	"type" => "float32",
+	"Type" => "Float32",
+	"TYPE" => "FLOAT32",
+	"RawType" => "Float32",
+	"VecType" => "Float32",
+	"ElementType" => "Float32",
+	"TypeName" => "A Float32",
+
+	"include" => "smilefloat32",
+	"accinclude" => "smilefloat64",
+	"UnboxedFrom" => "SmileUnboxedFloat32_From",
+	"AccFrom" => "SmileUnboxedFloat64_From",
+	"ElementToString" => "Float32_ToStringEx(array->data[i], 0, 0, False)",
+);
+
+OutputTemplate(\@arrayTemplate, \%float32Substitutions, "smilefloat32array.generated.c");
+OutputTemplate(\@arrayBaseTemplate, \%float32Substitutions, "smilefloat32array_base.generated.c");
+
+#--------------------------------------------------------------------------------------------
+
+%float64Substitutions = (
+	"type" => "float64",
+	"Type" => "Float64",
+	"TYPE" => "FLOAT64",
+	"RawType" => "Float64",
+	"VecType" => "Float64",
+	"ElementType" => "Float64",
+	"TypeName" => "A Float64",
+
+	"include" => "smilefloat64",
+	"accinclude" => "smilefloat64",
+	"UnboxedFrom" => "SmileUnboxedFloat64_From",
+	"AccFrom" => "SmileUnboxedFloat64_From",
+	"ElementToString" => "Float64_ToStringEx(array->data[i], 0, 0, False)",
+);
+
+OutputTemplate(\@arrayTemplate, \%float64Substitutions, "smilefloat64array.generated.c");
+OutputTemplate(\@arrayBaseTemplate, \%float64Substitutions, "smilefloat64array_base.generated.c");
+
+#--------------------------------------------------------------------------------------------
@@ -17,7 +17,11 @@
 
 #include <smile/string.h>
 #include <smile/stringbuilder.h>
+#include <smile/bytesearch.h>
+#include <smile/utf8.h>
+#include <smile/codepage.h>
 #include <smile/eval/eval.h>
+#include <smile/numeric/vector.h>
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/smileuserobject.h>
 #include <smile/smiletypes/smilebool.h>
@@ -31,6 +35,8 @@
 #include <smile/smiletypes/base.h>
 #include <smile/internal/staticstring.h>
 #include <smile/crypto/hash.h>
+#include <smile/crypto/base64.h>
+#include <smile/crypto/hex.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
@@ -45,11 +51,36 @@ static Byte _hashChecks[] = {
 	SMILE_KIND_MASK, SMILE_KIND_INTEGER64RANGE,
 };
 
+static Byte _codePageChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_BYTEARRAY,
+	SMILE_KIND_MASK, SMILE_KIND_STRING,
+	SMILE_KIND_MASK, SMILE_KIND_INTEGER64RANGE,
+};
+
+static Byte _codecChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_BYTEARRAY,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_SYMBOL,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_SYMBOL,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_SYMBOL,
+};
+
 static Byte _eachChecks[] = {
 	SMILE_KIND_MASK, SMILE_KIND_BYTEARRAY,
 	SMILE_KIND_MASK, SMILE_KIND_FUNCTION,
 };
 
+static Byte _indexOfChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_BYTEARRAY,
+	0, 0,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_INTEGER64,
+};
+
+static Byte _foldChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_BYTEARRAY,
+	0, 0,
+	SMILE_KIND_MASK, SMILE_KIND_FUNCTION,
+};
+
 //-------------------------------------------------------------------------------------------------
 // Generic type conversion
 
@@ -759,38 +790,328 @@ SMILE_EXTERNAL_FUNCTION(Count)
 }
 
 //-------------------------------------------------------------------------------------------------
+// Reductions.  Sums and products widen each byte to an Integer64, and wrap on overflow just
+// like Integer64 arithmetic; 'min' and 'max' return Bytes.
 
-static Bool SetupForHashing(Int argc, SmileArg *argv,
-	SmileByteArray *returnByteArray, Int64 *returnStart, Int64 *returnLength)
+SMILE_EXTERNAL_FUNCTION(Sum)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	return SmileUnboxedInteger64_From(ByteVector_Sum(byteArray->data, byteArray->length));
+}
+
+SMILE_EXTERNAL_FUNCTION(Product)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	const Byte *ptr = byteArray->data, *end = ptr + byteArray->length;
+	UInt64 product = 1;
+
+	// Once the product reaches zero, it stays there, so there's no point in reading further.
+	for (; ptr < end && product != 0; ptr++)
+		product *= *ptr;
+
+	return SmileUnboxedInteger64_From((Int64)product);
+}
+
+SMILE_EXTERNAL_FUNCTION(Min)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	if (byteArray->length <= 0)
+		return SmileArg_From(NullObject);
+
+	return SmileUnboxedByte_From(ByteVector_Min(byteArray->data, byteArray->length));
+}
+
+SMILE_EXTERNAL_FUNCTION(Max)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	if (byteArray->length <= 0)
+		return SmileArg_From(NullObject);
+
+	return SmileUnboxedByte_From(ByteVector_Max(byteArray->data, byteArray->length));
+}
+
+typedef enum {
+	ReduceMode_MinBy,
+	ReduceMode_MaxBy,
+	ReduceMode_Fold,
+} ReduceMode;
+
+typedef struct ReduceInfoStruct {
+	const Byte *ptr, *end;
+	SmileFunction function;
+	SmileArg acc;
+	SmileArg bestKey;
+	Byte mode;
+	Bool hasKey;
+} *ReduceInfo;
+
+static Int ReduceStart(ClosureStateMachine closure)
+{
+	register ReduceInfo loopInfo = (ReduceInfo)closure->state;
+
+	//---------- begin first for-loop iteration ----------
+
+	// Condition: If we've run out of bytes, we're done.
+	if (loopInfo->ptr >= loopInfo->end) {
+		Closure_Push(closure, loopInfo->acc);
+		return -1;
+	}
+
+	// Body: Set up to call the user's function with the next byte.
+	Closure_PushBoxed(closure, loopInfo->function);
+	if (loopInfo->mode == ReduceMode_Fold) {
+		Closure_Push(closure, loopInfo->acc);
+		Closure_PushUnboxedByte(closure, *loopInfo->ptr);
+		return 2;
+	}
+	Closure_PushUnboxedByte(closure, *loopInfo->ptr);
+	return 1;
+}
+
+static Int ReduceBody(ClosureStateMachine closure)
+{
+	register ReduceInfo loopInfo = (ReduceInfo)closure->state;
+	Int cmp;
+
+	// Body: Fold the result of the user's function into the accumulator.
+	SmileArg fnResult = Closure_Pop(closure);
+
+	if (loopInfo->mode == ReduceMode_Fold) {
+		loopInfo->acc = fnResult;
+	}
+	else if (!loopInfo->hasKey) {
+		loopInfo->bestKey = fnResult;
+		loopInfo->hasKey = True;
+	}
+	else {
+		if (!SmileArg_TryCompare(fnResult, loopInfo->bestKey, &cmp))
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_Format("Cannot continue '%s': Keys must be numbers, characters, or strings, all of the same type.",
+					loopInfo->mode == ReduceMode_MinBy ? "min-by" : "max-by"));
+		if (loopInfo->mode == ReduceMode_MinBy ? cmp < 0 : cmp > 0) {
+			loopInfo->bestKey = fnResult;
+			loopInfo->acc = SmileUnboxedByte_From(*loopInfo->ptr);
+		}
+	}
+
+	// Next: Move the iterator to the next byte.
+	loopInfo->ptr++;
+
+	//---------- end previous for-loop iteration ----------
+
+	return ReduceStart(closure);
+}
+
+static SmileArg BeginReduce(const Byte *ptr, const Byte *end, SmileFunction function, SmileArg acc, Byte mode)
+{
+	// We use Eval's state-machine construct to avoid recursing deeper on the C stack.
+	ClosureStateMachine closure = Eval_BeginStateMachine(ReduceStart, ReduceBody);
+	ReduceInfo reduceInfo = (ReduceInfo)closure->state;
+
+	reduceInfo->ptr = ptr;
+	reduceInfo->end = end;
+	reduceInfo->function = function;
+	reduceInfo->acc = acc;
+	reduceInfo->bestKey = SmileArg_From(NullObject);
+	reduceInfo->mode = mode;
+	reduceInfo->hasKey = False;
+
+	return (SmileArg){ NULL };	// We have to return something, but this value will be ignored.
+}
+
+SMILE_EXTERNAL_FUNCTION(MinBy)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	if (byteArray->length <= 0)
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(byteArray->data, byteArray->data + byteArray->length, (SmileFunction)argv[1].obj,
+		SmileUnboxedByte_From(byteArray->data[0]), ReduceMode_MinBy);
+}
+
+SMILE_EXTERNAL_FUNCTION(MaxBy)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	if (byteArray->length <= 0)
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(byteArray->data, byteArray->data + byteArray->length, (SmileFunction)argv[1].obj,
+		SmileUnboxedByte_From(byteArray->data[0]), ReduceMode_MaxBy);
+}
+
+SMILE_EXTERNAL_FUNCTION(Fold)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	if (byteArray->length <= 0)
+		return argv[1];
+
+	return BeginReduce(byteArray->data, byteArray->data + byteArray->length, (SmileFunction)argv[2].obj,
+		argv[1], ReduceMode_Fold);
+}
+
+SMILE_EXTERNAL_FUNCTION(Reduce)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	// Reducing starts with the first byte, so an empty array has nothing to reduce.
+	if (byteArray->length <= 0)
+		return SmileArg_From(NullObject);
+	if (byteArray->length == 1)
+		return SmileUnboxedByte_From(byteArray->data[0]);
+
+	return BeginReduce(byteArray->data + 1, byteArray->data + byteArray->length, (SmileFunction)argv[1].obj,
+		SmileUnboxedByte_From(byteArray->data[0]), ReduceMode_Fold);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Searching
+
+Inline void DecodeSearchPattern(SmileArg arg, const Byte **pattern, Int *length, Byte *buffer, const char *methodName)
+{
+	switch (SMILE_KIND(arg.obj)) {
+		case SMILE_KIND_BYTEARRAY:
+			*pattern = ((SmileByteArray)arg.obj)->data;
+			*length = ((SmileByteArray)arg.obj)->length;
+			break;
+		case SMILE_KIND_STRING:
+			*pattern = String_GetBytes((String)arg.obj);
+			*length = String_Length((String)arg.obj);
+			break;
+		case SMILE_KIND_UNBOXED_BYTE:
+			*buffer = arg.unboxed.i8;
+			*pattern = buffer;
+			*length = 1;
+			break;
+		default:
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_Format("The pattern to 'ByteArray.%s' must be a ByteArray, String, or Byte.", methodName));
+	}
+}
+
+SMILE_EXTERNAL_FUNCTION(IndexOf)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	Int64 startIndex = argc > 2 ? argv[2].unboxed.i64 : 0;
+	const Byte *pattern;
+	Int length, result;
+	Byte buffer;
+
+	DecodeSearchPattern(argv[1], &pattern, &length, &buffer, "index-of");
+
+	if (startIndex < 0 || startIndex > byteArray->length)
+		return SmileArg_From(NullObject);
+
+	result = ByteSearch_IndexOf(byteArray->data, byteArray->length, pattern, length, (Int)startIndex);
+	return result >= 0 ? SmileUnboxedInteger64_From(result) : SmileArg_From(NullObject);
+}
+
+SMILE_EXTERNAL_FUNCTION(LastIndexOf)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	Int64 startIndex = argc > 2 ? argv[2].unboxed.i64 : byteArray->length;
+	const Byte *pattern;
+	Int length, result;
+	Byte buffer;
+
+	DecodeSearchPattern(argv[1], &pattern, &length, &buffer, "last-index-of");
+
+	if (startIndex < 0)
+		return SmileArg_From(NullObject);
+
+	result = ByteSearch_LastIndexOf(byteArray->data, byteArray->length, pattern, length,
+		startIndex < byteArray->length ? (Int)startIndex : byteArray->length);
+	return result >= 0 ? SmileUnboxedInteger64_From(result) : SmileArg_From(NullObject);
+}
+
+SMILE_EXTERNAL_FUNCTION(Contains)
 {
-	Int64 start, length;
 	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	const Byte *pattern;
+	Int length;
+	Byte buffer;
+
+	DecodeSearchPattern(argv[1], &pattern, &length, &buffer, "contains?");
+
+	return SmileUnboxedBool_From(ByteSearch_IndexOf(byteArray->data, byteArray->length, pattern, length, 0) >= 0);
+}
+
+SMILE_EXTERNAL_FUNCTION(CountOf)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	struct ByteSearchStruct search;
+	const Byte *pattern;
+	Int length, index, count;
+	Byte buffer;
 
-	if (argc > 1) {
+	DecodeSearchPattern(argv[1], &pattern, &length, &buffer, "count-of");
+
+	if (length == 0)
+		return SmileUnboxedInteger64_From(0);
+
+	ByteSearch_Init(&search, pattern, length);
+	for (count = 0, index = 0; (index = ByteSearch_Find(&search, byteArray->data, byteArray->length, index)) >= 0; index += length)
+		count++;
+
+	return SmileUnboxedInteger64_From(count);
+}
+
+SMILE_EXTERNAL_FUNCTION(IsAscii)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	return SmileUnboxedBool_From(ByteSearch_IndexOfNonAscii(byteArray->data, byteArray->length, 0) >= byteArray->length);
+}
+
+SMILE_EXTERNAL_FUNCTION(IsUtf8)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	return SmileUnboxedBool_From(Utf8_IsValid(byteArray->data, byteArray->length));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+static Bool ClipToRange(SmileByteArray byteArray, SmileInteger64Range range, Int64 *returnStart, Int64 *returnLength)
+{
+	Int64 start, length;
+
+	if (range != NULL) {
 		Int64 end;
-		start = ((SmileInteger64Range)argv[1].obj)->start;
-		end = ((SmileInteger64Range)argv[1].obj)->end;
+		start = range->start;
+		end = range->end;
 		if (end < start) length = 0;
 		else length = end - start + 1;
 		if (start < 0) {
 			length += start;
 			start = 0;
 		}
-		if (length > start - byteArray->length)
-			length = start - byteArray->length;
+		if (length > byteArray->length - start)
+			length = byteArray->length - start;
 	}
 	else {
 		start = 0;
 		length = byteArray->length;
 	}
 
-	*returnByteArray = byteArray;
 	*returnStart = start;
 	*returnLength = length;
 
 	return length > 0;
 }
 
+static Bool SetupForHashing(Int argc, SmileArg *argv,
+	SmileByteArray *returnByteArray, Int64 *returnStart, Int64 *returnLength)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+
+	*returnByteArray = byteArray;
+
+	return ClipToRange(byteArray, argc > 1 ? (SmileInteger64Range)argv[1].obj : NULL, returnStart, returnLength);
+}
+
 SMILE_EXTERNAL_FUNCTION(MakeCrc32)
 {
 	UInt32 crc32;
@@ -931,33 +1252,123 @@ SMILE_EXTERNAL_FUNCTION(MakeSha3_512)
 	return SmileArg_From((SmileObject)result);
 }
 
-static const Byte _hexTable[] = {
-	'0', '1', '2', '3', '4', '5', '6', '7',
-	'8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
-};
-
 SMILE_EXTERNAL_FUNCTION(HexString)
 {
 	Int64 start, length;
 	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
-	const Byte *src;
-	Byte *dest;
-	String result;
 
 	if (!SetupForHashing(argc, argv, &byteArray, &start, &length))
 		return SmileUnboxedInteger32_From(0);
 
-	result = String_CreateInternal((Int)length * 2);
-	dest = (Byte *)String_GetBytes(result);
-	src = byteArray->data + (Int)start;
+	return SmileArg_From((SmileObject)HexEncode(byteArray->data + (Int)start, (Int)length, False));
+}
+
+//-------------------------------------------------------------------------------------------------
 
-	for (; length > 0; length--) {
-		Byte b = *src++;
-		*dest++ = _hexTable[b >> 4];
-		*dest++ = _hexTable[b & 0xF];
+static struct {
+	Symbol urlSafe;
+	Symbol wrapLines;
+	Symbol noPadding;
+	Symbol lowercase;
+} _codecSymbols;
+
+// The 'lowercase option of hex-encode, which sits above the BASE64_* flags so they can share a parser.
+#define LOWERCASE_OPTION (1 << 8)
+
+/// <summary>
+/// Collect the option symbols passed to a base-64 or hex method (after the byte array itself)
+/// into a set of flags, complaining about any that the method doesn't know.
+/// </summary>
+static Int GetCodecOptions(Int argc, SmileArg *argv, Int allowedFlags, const char *methodName)
+{
+	Int flags = 0, flag, i;
+	Symbol symbol;
+
+	for (i = 1; i < argc; i++) {
+		symbol = argv[i].unboxed.symbol;
+		if (symbol == _codecSymbols.urlSafe)
+			flag = BASE64_URL_SAFE;
+		else if (symbol == _codecSymbols.wrapLines)
+			flag = BASE64_WRAP_LINES;
+		else if (symbol == _codecSymbols.noPadding)
+			flag = BASE64_NO_PADDING;
+		else if (symbol == _codecSymbols.lowercase)
+			flag = LOWERCASE_OPTION;
+		else flag = 0;
+
+		if (!(flag & allowedFlags)) {
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_Format("%s: Unknown option \"%S\"", methodName, SymbolTable_GetName(Smile_SymbolTable, symbol)));
+		}
+		flags |= flag;
 	}
 
-	*dest = '\0';
+	return flags;
+}
+
+SMILE_EXTERNAL_FUNCTION(ToBase64)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	Int flags = GetCodecOptions(argc, argv, BASE64_URL_SAFE | BASE64_WRAP_LINES | BASE64_NO_PADDING, "base64-encode");
+
+	return SmileArg_From((SmileObject)Base64Encode(byteArray->data, byteArray->length, flags));
+}
+
+SMILE_EXTERNAL_FUNCTION(FromBase64)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	Int flags = GetCodecOptions(argc, argv, BASE64_URL_SAFE, "base64-decode");
+	Byte *result;
+	Int length;
+
+	if ((result = Base64Decode(byteArray->data, byteArray->length, flags, &length)) == NULL)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FromC("Invalid base-64 text passed to 'ByteArray.base64-decode'."));
+
+	return SmileArg_From((SmileObject)SmileByteArray_CreateInternal((SmileObject)Smile_KnownBases.ByteArray, result, length, True));
+}
+
+SMILE_EXTERNAL_FUNCTION(ToHex)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	Int flags = GetCodecOptions(argc, argv, LOWERCASE_OPTION, "hex-encode");
+
+	return SmileArg_From((SmileObject)HexEncode(byteArray->data, byteArray->length, (flags & LOWERCASE_OPTION) != 0));
+}
+
+SMILE_EXTERNAL_FUNCTION(FromHex)
+{
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	Byte *result;
+	Int length;
+
+	if ((result = HexDecode(byteArray->data, byteArray->length, &length)) == NULL)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FromC("Invalid hex text passed to 'ByteArray.hex-decode'."));
+
+	return SmileArg_From((SmileObject)SmileByteArray_CreateInternal((SmileObject)Smile_KnownBases.ByteArray, result, length, True));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+SMILE_EXTERNAL_FUNCTION(DecodeCodePage)
+{
+	struct CodePageStruct codePage;
+	Int64 start, length;
+	SmileByteArray byteArray = (SmileByteArray)argv[0].obj;
+	String result;
+	Int size;
+
+	if (!CodePage_GetByName(&codePage, (String)argv[1].obj))
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_Format("Unknown code page \"%S\" passed to 'ByteArray.decode-code-page'.", (String)argv[1].obj));
+
+	if (!ClipToRange(byteArray, argc > 2 ? (SmileInteger64Range)argv[2].obj : NULL, &start, &length))
+		return SmileArg_From((SmileObject)String_Empty);
+
+	// Each byte converts on its own, so a file read in chunks can be converted a chunk at a time.
+	size = CodePage_MeasureUtf8(&codePage, byteArray->data + (Int)start, (Int)length);
+	result = String_CreateInternal(size);
+	CodePage_DecodeToUtf8(&codePage, byteArray->data + (Int)start, (Int)length, (Byte *)String_GetBytes(result));
+	((Byte *)String_GetBytes(result))[size] = '\0';
 
 	return SmileArg_From((SmileObject)result);
 }
@@ -966,6 +1377,11 @@ SMILE_EXTERNAL_FUNCTION(HexString)
 
 void SmileByteArray_Setup(SmileUserObject base)
 {
+	_codecSymbols.urlSafe = SymbolTable_GetSymbolC(Smile_SymbolTable, "url-safe");
+	_codecSymbols.wrapLines = SymbolTable_GetSymbolC(Smile_SymbolTable, "wrap-lines");
+	_codecSymbols.noPadding = SymbolTable_GetSymbolC(Smile_SymbolTable, "no-padding");
+	_codecSymbols.lowercase = SymbolTable_GetSymbolC(Smile_SymbolTable, "lowercase");
+
 	SetupFunction("of-size", OfSize, (void *)base, "count value", 0, 0, 0, 0, NULL);
 
 	SetupFunction("bool", ToBool, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
@@ -981,6 +1397,22 @@ void SmileByteArray_Setup(SmileUserObject base)
 	SetupFunction("where", Where, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
 	SetupFunction("count", Count, NULL, "byte-array", ARG_STATE_MACHINE, 0, 0, 0, NULL);
 
+	SetupFunction("sum", Sum, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _byteArrayChecks);
+	SetupFunction("product", Product, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _byteArrayChecks);
+	SetupFunction("min", Min, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _byteArrayChecks);
+	SetupFunction("max", Max, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _byteArrayChecks);
+	SetupFunction("min-by", MinBy, NULL, "byte-array fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+	SetupFunction("max-by", MaxBy, NULL, "byte-array fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+	SetupFunction("fold", Fold, NULL, "byte-array init fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 3, 3, 3, _foldChecks);
+	SetupFunction("reduce", Reduce, NULL, "byte-array fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+
+	SetupFunction("index-of", IndexOf, NULL, "byte-array pattern start", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES | ARG_PURE, 2, 3, 3, _indexOfChecks);
+	SetupFunction("last-index-of", LastIndexOf, NULL, "byte-array pattern start", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES | ARG_PURE, 2, 3, 3, _indexOfChecks);
+	SetupFunction("contains?", Contains, NULL, "byte-array pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("count-of", CountOf, NULL, "byte-array pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("ascii?", IsAscii, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _byteArrayChecks);
+	SetupFunction("utf8?", IsUtf8, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _byteArrayChecks);
+
 	SetupFunction("crc32", MakeCrc32, NULL, "byte-array range", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hashChecks);
 	SetupFunction("md5", MakeMd5, NULL, "byte-array range", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hashChecks);
 	SetupFunction("sha1", MakeSha1, NULL, "byte-array range", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hashChecks);
@@ -993,4 +1425,9 @@ void SmileByteArray_Setup(SmileUserObject base)
 	SetupFunction("sha3x512", MakeSha3_512, NULL, "byte-array range", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hashChecks);
 
 	SetupFunction("hex-string", HexString, NULL, "byte-array range", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hashChecks);
+	SetupFunction("hex-encode", ToHex, NULL, "byte-array options", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _codecChecks);
+	SetupFunction("hex-decode", FromHex, NULL, "byte-array", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _codecChecks);
+	SetupFunction("base64-encode", ToBase64, NULL, "byte-array options", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 4, 4, _codecChecks);
+	SetupFunction("base64-decode", FromBase64, NULL, "byte-array options", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _codecChecks);
+	SetupFunction("decode-code-page", DecodeCodePage, NULL, "byte-array code-page range", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 2, 3, 3, _codePageChecks);
 }
@@ -0,0 +1,431 @@
+// ===================================================
+//   WARNING: THIS IS A GENERATED FILE. DO NOT EDIT!
+// ===================================================
+
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/string.h>
+#include <smile/stringbuilder.h>
+#include <smile/numeric/float64.h>
+#include <smile/numeric/vector.h>
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/raw/smilebytearray.h>
+#include <smile/smiletypes/raw/smileinteger64array.h>
+#include <smile/smiletypes/raw/smilefloat64array.h>
+#include <smile/smiletypes/numeric/smilebyte.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/base.h>
+#include <smile/internal/staticstring.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+static Byte _arrayChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_FLOAT64ARRAY,
+	0, 0,
+	0, 0,
+};
+
+static Byte _arrayArrayChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_FLOAT64ARRAY,
+	SMILE_KIND_MASK, SMILE_KIND_FLOAT64ARRAY,
+};
+
+static Byte _gatherChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_FLOAT64ARRAY,
+	SMILE_KIND_MASK, SMILE_KIND_INTEGER64ARRAY,
+};
+
+STATIC_STRING(_lengthMismatchError, "Float64Array arguments must have the same length.");
+STATIC_STRING(_readOnlyError, "Float64Array is read-only.");
+STATIC_STRING(_outOfRangeError, "Index out of range.");
+
+/// <summary>
+/// Convert an unboxed numeric argument to the element type, the same way a C cast would.
+/// </summary>
+/// <returns>True if the argument was numeric, False if it was anything else.</returns>
+static Bool GetScalar(SmileArg arg, Float64 *result)
+{
+	switch (SMILE_KIND(arg.obj)) {
+		case SMILE_KIND_UNBOXED_BYTE: *result = (Float64)arg.unboxed.i8; return True;
+		case SMILE_KIND_UNBOXED_INTEGER16: *result = (Float64)arg.unboxed.i16; return True;
+		case SMILE_KIND_UNBOXED_INTEGER32: *result = (Float64)arg.unboxed.i32; return True;
+		case SMILE_KIND_UNBOXED_INTEGER64: *result = (Float64)arg.unboxed.i64; return True;
+		case SMILE_KIND_UNBOXED_FLOAT32: *result = (Float64)arg.unboxed.f32; return True;
+		case SMILE_KIND_UNBOXED_FLOAT64: *result = (Float64)arg.unboxed.f64; return True;
+		default: return False;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Generic type conversion
+
+SMILE_EXTERNAL_FUNCTION(ToBool)
+{
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_FLOAT64ARRAY)
+		return SmileUnboxedBool_From(((SmileFloat64Array)argv[0].obj)->length > 0);
+
+	return SmileUnboxedBool_From(True);
+}
+
+SMILE_EXTERNAL_FUNCTION(ToString)
+{
+	STATIC_STRING(arrayString, "Float64Array");
+	SmileFloat64Array array;
+	StringBuilder stringBuilder;
+	Int i;
+
+	if (SMILE_KIND(argv[0].obj) != SMILE_KIND_FLOAT64ARRAY)
+		return SmileArg_From((SmileObject)arrayString);
+
+	array = (SmileFloat64Array)argv[0].obj;
+	stringBuilder = StringBuilder_Create();
+
+	StringBuilder_AppendByte(stringBuilder, '[');
+	for (i = 0; i < array->length; i++) {
+		if (i > 0) StringBuilder_AppendByte(stringBuilder, ' ');
+		StringBuilder_AppendString(stringBuilder, Float64_ToStringEx(array->data[i], 0, 0, False));
+	}
+	StringBuilder_AppendByte(stringBuilder, ']');
+
+	return SmileArg_From((SmileObject)StringBuilder_ToString(stringBuilder));
+}
+
+SMILE_EXTERNAL_FUNCTION(ToList)
+{
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+	SmileList head, tail;
+	Int i;
+
+	LIST_INIT(head, tail);
+	for (i = 0; i < array->length; i++) {
+		LIST_APPEND(head, tail, SmileFloat64_Create(array->data[i]));
+	}
+
+	return SmileArg_From((SmileObject)head);
+}
+
+SMILE_EXTERNAL_FUNCTION(Hash)
+{
+	return SmileUnboxedInteger64_From(Smile_ApplyHashOracle((PtrInt)argv[0].obj));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Get/set members
+
+SMILE_EXTERNAL_FUNCTION(GetMember)
+{
+	STATIC_STRING(invalidIndexType, "Index to Float64Array.get-member must be of type Integer64.");
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+	Int64 index;
+
+	if (SMILE_KIND(argv[1].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, invalidIndexType);
+
+	index = argv[1].unboxed.i64;
+	if (index < 0 || index >= array->length)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _outOfRangeError);
+
+	return SmileUnboxedFloat64_From(array->data[(Int)index]);
+}
+
+SMILE_EXTERNAL_FUNCTION(SetMember)
+{
+	STATIC_STRING(invalidIndexType, "Index to Float64Array.set-member must be of type Integer64.");
+	STATIC_STRING(invalidValueType, "Value for Float64Array.set-member must be a number.");
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+	Int64 index;
+	Float64 value;
+
+	if (!(array->kind & SMILE_SECURITY_WRITABLE))
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _readOnlyError);
+	if (SMILE_KIND(argv[1].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, invalidIndexType);
+	if (!GetScalar(argv[2], &value))
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, invalidValueType);
+
+	index = argv[1].unboxed.i64;
+	if (index < 0 || index >= array->length)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _outOfRangeError);
+
+	array->data[(Int)index] = value;
+
+	return argv[2];
+}
+
+//-------------------------------------------------------------------------------------------------
+// Construction
+
+SMILE_EXTERNAL_FUNCTION(OfSize)
+{
+	STATIC_STRING(argumentError, "Float64Array.of-size accepts one Integer64 argument (and one optional numeric argument).");
+	STATIC_STRING(countError, "Float64Array.of-size count must not be negative.");
+
+	SmileUserObject base = (SmileUserObject)param;
+	Int i, j;
+	Int64 count;
+	Float64 value;
+	SmileFloat64Array array;
+
+	i = 0;
+	if (argv[i].obj == (SmileObject)base)
+		i++;
+
+	// Parse the Integer64 count.
+	if (i >= argc || SMILE_KIND(argv[i].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+	count = argv[i].unboxed.i64;
+	if (count < 0 || count > PtrIntMax)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, countError);
+	i++;
+
+	// Parse an optional fill value.
+	if (i < argc) {
+		if (!GetScalar(argv[i], &value))
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+	}
+	else value = 0;
+
+	// Create the array.
+	array = SmileFloat64Array_Create((Int)count, True);
+	if (value != 0) {
+		for (j = 0; j < array->length; j++)
+			array->data[j] = value;
+	}
+
+	return SmileArg_From((SmileObject)array);
+}
+
+SMILE_EXTERNAL_FUNCTION(View)
+{
+	STATIC_STRING(argumentError, "Float64Array.view accepts a ByteArray (and an optional Integer64 byte offset and Integer64 count).");
+
+	SmileUserObject base = (SmileUserObject)param;
+	SmileByteArray byteArray;
+	Int i;
+	Int64 offset, count;
+
+	i = 0;
+	if (argv[i].obj == (SmileObject)base)
+		i++;
+
+	if (i >= argc || SMILE_KIND(argv[i].obj) != SMILE_KIND_BYTEARRAY)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+	byteArray = (SmileByteArray)argv[i++].obj;
+
+	// Parse the optional offset, in bytes.
+	if (i < argc) {
+		if (SMILE_KIND(argv[i].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+		offset = argv[i++].unboxed.i64;
+	}
+	else offset = 0;
+
+	// Parse the optional count, in elements; by default, the view covers the rest of the ByteArray.
+	if (i < argc) {
+		if (SMILE_KIND(argv[i].obj) != SMILE_KIND_UNBOXED_INTEGER64)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+		count = argv[i++].unboxed.i64;
+	}
+	else count = offset >= 0 && offset <= byteArray->length ? (byteArray->length - offset) / (Int64)sizeof(Float64) : 0;
+
+	if (i < argc)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+
+	return SmileArg_From((SmileObject)SmileFloat64Array_CreateView(byteArray, (Int)offset, (Int)count));
+}
+
+SMILE_EXTERNAL_FUNCTION(Bytes)
+{
+	return SmileArg_From((SmileObject)SmileFloat64Array_ToByteArray((SmileFloat64Array)argv[0].obj));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Elementwise arithmetic
+
+typedef void (*VectorOp)(Float64 *dest, const Float64 *a, const Float64 *b, Int count);
+typedef void (*ScalarOp)(Float64 *dest, const Float64 *a, Float64 scalar, Int count);
+
+/// <summary>
+/// Apply an elementwise operation to an array and either another array of the same
+/// length or a scalar, producing a new array.
+/// </summary>
+static SmileArg Elementwise(SmileArg *argv, VectorOp vectorOp, ScalarOp scalarOp, String argumentError)
+{
+	SmileFloat64Array a = (SmileFloat64Array)argv[0].obj, b, result;
+	Float64 scalar;
+
+	if (SMILE_KIND(argv[1].obj) == SMILE_KIND_FLOAT64ARRAY && vectorOp != NULL) {
+		b = (SmileFloat64Array)argv[1].obj;
+		if (b->length != a->length)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, _lengthMismatchError);
+		result = SmileFloat64Array_Create(a->length, True);
+		vectorOp(result->data, a->data, b->data, a->length);
+	}
+	else if (GetScalar(argv[1], &scalar)) {
+		result = SmileFloat64Array_Create(a->length, True);
+		scalarOp(result->data, a->data, scalar, a->length);
+	}
+	else Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+
+	return SmileArg_From((SmileObject)result);
+}
+
+SMILE_EXTERNAL_FUNCTION(Plus)
+{
+	STATIC_STRING(argumentError, "The second argument to Float64Array.+ must be a Float64Array or a number.");
+	return Elementwise(argv, Float64Vector_Add, Float64Vector_AddScalar, argumentError);
+}
+
+SMILE_EXTERNAL_FUNCTION(Minus)
+{
+	STATIC_STRING(argumentError, "The second argument to Float64Array.- must be a Float64Array or a number.");
+	return Elementwise(argv, Float64Vector_Sub, Float64Vector_SubScalar, argumentError);
+}
+
+SMILE_EXTERNAL_FUNCTION(Star)
+{
+	STATIC_STRING(argumentError, "The second argument to Float64Array.* must be a Float64Array or a number.");
+	return Elementwise(argv, Float64Vector_Mul, Float64Vector_MulScalar, argumentError);
+}
+
+SMILE_EXTERNAL_FUNCTION(Scale)
+{
+	STATIC_STRING(argumentError, "The second argument to Float64Array.scale must be a number.");
+	return Elementwise(argv, NULL, Float64Vector_MulScalar, argumentError);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Reductions
+
+SMILE_EXTERNAL_FUNCTION(Sum)
+{
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+	return SmileUnboxedFloat64_From(Float64Vector_Sum(array->data, array->length));
+}
+
+SMILE_EXTERNAL_FUNCTION(Dot)
+{
+	SmileFloat64Array a = (SmileFloat64Array)argv[0].obj;
+	SmileFloat64Array b = (SmileFloat64Array)argv[1].obj;
+
+	if (b->length != a->length)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, _lengthMismatchError);
+
+	return SmileUnboxedFloat64_From(Float64Vector_Dot(a->data, b->data, a->length));
+}
+
+SMILE_EXTERNAL_FUNCTION(Min)
+{
+	STATIC_STRING(emptyError, "Cannot find the min of an empty Float64Array.");
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+
+	if (array->length <= 0)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, emptyError);
+
+	return SmileUnboxedFloat64_From(Float64Vector_Min(array->data, array->length));
+}
+
+SMILE_EXTERNAL_FUNCTION(Max)
+{
+	STATIC_STRING(emptyError, "Cannot find the max of an empty Float64Array.");
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+
+	if (array->length <= 0)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, emptyError);
+
+	return SmileUnboxedFloat64_From(Float64Vector_Max(array->data, array->length));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Masks and gathering
+
+SMILE_EXTERNAL_FUNCTION(Mask)
+{
+	STATIC_STRING(argumentError, "The second argument to a Float64Array comparison must be a number.");
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+	SmileByteArray mask;
+	Float64 scalar;
+
+	if (!GetScalar(argv[1], &scalar))
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, argumentError);
+
+	mask = SmileByteArray_Create((SmileObject)Smile_KnownBases.ByteArray, array->length, True);
+	Float64Vector_CompareScalar(mask->data, array->data, scalar, array->length, (Int)(PtrInt)param);
+
+	return SmileArg_From((SmileObject)mask);
+}
+
+SMILE_EXTERNAL_FUNCTION(Gather)
+{
+	SmileFloat64Array array = (SmileFloat64Array)argv[0].obj;
+	SmileInteger64Array indices = (SmileInteger64Array)argv[1].obj;
+	SmileFloat64Array result;
+	Int i;
+
+	// Check every index up front, so that the kernel doesn't have to.
+	for (i = 0; i < indices->length; i++) {
+		if ((UInt64)indices->data[i] >= (UInt64)array->length)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, _outOfRangeError);
+	}
+
+	result = SmileFloat64Array_Create(indices->length, True);
+	Float64Vector_Gather(result->data, array->data, indices->data, indices->length);
+
+	return SmileArg_From((SmileObject)result);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SmileFloat64Array_Setup(SmileUserObject base)
+{
+	SetupFunction("of-size", OfSize, (void *)base, "count value", 0, 0, 0, 0, NULL);
+	SetupFunction("view", View, (void *)base, "byte-array offset count", 0, 0, 0, 0, NULL);
+
+	SetupFunction("bool", ToBool, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("string", ToString, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("hash", Hash, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("list", ToList, NULL, "array", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _arrayChecks);
+	SetupFunction("bytes", Bytes, NULL, "array", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _arrayChecks);
+
+	SetupFunction("get-member", GetMember, NULL, "array index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("set-member", SetMember, NULL, "array index value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 3, 3, 3, _arrayChecks);
+
+	SetupFunction("+", Plus, NULL, "a b", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("-", Minus, NULL, "a b", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("*", Star, NULL, "a b", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("scale", Scale, NULL, "array factor", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+
+	SetupFunction("sum", Sum, NULL, "array", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _arrayChecks);
+	SetupFunction("dot", Dot, NULL, "a b", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayArrayChecks);
+	SetupFunction("min", Min, NULL, "array", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _arrayChecks);
+	SetupFunction("max", Max, NULL, "array", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _arrayChecks);
+
+	SetupFunction("mask-eq", Mask, (void *)(PtrInt)VECTOR_CMP_EQ, "array value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("mask-ne", Mask, (void *)(PtrInt)VECTOR_CMP_NE, "array value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("mask-lt", Mask, (void *)(PtrInt)VECTOR_CMP_LT, "array value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("mask-le", Mask, (void *)(PtrInt)VECTOR_CMP_LE, "array value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("mask-gt", Mask, (void *)(PtrInt)VECTOR_CMP_GT, "array value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+	SetupFunction("mask-ge", Mask, (void *)(PtrInt)VECTOR_CMP_GE, "array value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _arrayChecks);
+
+	SetupFunction("gather", Gather, NULL, "array indices", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _gatherChecks);
+}
@@ -0,0 +1,216 @@
+// ===================================================
+//   WARNING: THIS IS A GENERATED FILE. DO NOT EDIT!
+// ===================================================
+
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/numeric/real64.h>
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/raw/smilebytearray.h>
+#include <smile/smiletypes/raw/smileinteger32array.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/easyobject.h>
+#include <smile/internal/staticstring.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+SMILE_EASY_OBJECT_VTABLE(SmileInteger32Array);
+
+SMILE_EASY_OBJECT_NO_CALL(SmileInteger32Array, "An Integer32Array")
+SMILE_EASY_OBJECT_NO_SOURCE(SmileInteger32Array)
+SMILE_EASY_OBJECT_NO_UNBOX(SmileInteger32Array)
+
+SMILE_EASY_OBJECT_TOBOOL(SmileInteger32Array, True)
+SMILE_EASY_OBJECT_TOSTRING(SmileInteger32Array, String_Format("Integer32Array of %ld", (Int64)obj->length))
+
+static SmileInteger32Array SmileInteger32Array_CreateInternal(Int32 *data, Int length, SmileByteArray byteArray, Bool writable)
+{
+	SmileInteger32Array array;
+	STATIC_STRING(PrivateKey, "");
+
+	array = GC_MALLOC_STRUCT(struct SmileInteger32ArrayInt);
+	if (array == NULL) Smile_Abort_OutOfMemory();
+
+	array->base = (SmileObject)Smile_KnownBases.Integer32Array;
+	array->kind = writable
+		? (SMILE_KIND_INTEGER32ARRAY | SMILE_SECURITY_WRITABLE | SMILE_SECURITY_UNFROZEN)
+		: (SMILE_KIND_INTEGER32ARRAY | SMILE_SECURITY_READONLY);
+	array->vtable = SmileInteger32Array_VTable;
+	array->securityKey = writable ? NullObject : (SmileObject)PrivateKey;
+	array->length = length;
+	array->data = data;
+	array->byteArray = byteArray;
+
+	return array;
+}
+
+/// <summary>
+/// Create a new Integer32Array, with all elements zero.
+/// </summary>
+/// <param name="length">The number of elements in the array, which must be nonnegative.</param>
+/// <param name="writable">Whether Smile programs will see this array as writable or as read-only.</param>
+SmileInteger32Array SmileInteger32Array_Create(Int length, Bool writable)
+{
+	Int32 *data;
+
+	if (length < 0) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FromC("Cannot create a Integer32Array of negative size."));
+	}
+	if ((UInt)length > PtrIntMax / sizeof(Int32))
+		Smile_Abort_OutOfMemory();
+
+	// The elements contain no pointers, so the GC doesn't need to scan them.
+	if (length > 0) {
+		data = GC_MALLOC_RAW_ARRAY(Int32, length);
+		if (data == NULL) Smile_Abort_OutOfMemory();
+		MemSet(data, 0, length * sizeof(Int32));
+	}
+	else data = NULL;
+
+	return SmileInteger32Array_CreateInternal(data, length, NULL, writable);
+}
+
+/// <summary>
+/// Create a Integer32Array that reinterprets part of a ByteArray as Int32 elements, in the
+/// CPU's native byte order.  This does not copy the bytes:  Changes to either object are
+/// visible in the other.  The view is writable only if the ByteArray is writable.
+/// </summary>
+/// <param name="byteArray">The ByteArray to view.</param>
+/// <param name="offset">The byte offset of the first element, which must be a multiple of
+/// the element size.</param>
+/// <param name="length">The number of elements in the view.  The view must fit within
+/// the ByteArray.</param>
+SmileInteger32Array SmileInteger32Array_CreateView(SmileByteArray byteArray, Int offset, Int length)
+{
+	Bool writable;
+
+	if (offset < 0 || length < 0 || offset > byteArray->length
+		|| (UInt)length > (UInt)(byteArray->length - offset) / sizeof(Int32)) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_FromC("Integer32Array view does not fit within its ByteArray."));
+	}
+	if (((PtrInt)(byteArray->data + offset)) % sizeof(Int32) != 0) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_FromC("Integer32Array view must start on a multiple of the element size."));
+	}
+
+	writable = (byteArray->kind & SMILE_SECURITY_WRITABLE) != 0;
+
+	return SmileInteger32Array_CreateInternal(length > 0 ? (Int32 *)(byteArray->data + offset) : NULL,
+		length, byteArray, writable);
+}
+
+/// <summary>
+/// Get a ByteArray that shares this array's storage.  This does not copy the elements, and
+/// the ByteArray is writable only if this array is writable.
+/// </summary>
+SmileByteArray SmileInteger32Array_ToByteArray(SmileInteger32Array array)
+{
+	return SmileByteArray_CreateInternal((SmileObject)Smile_KnownBases.ByteArray,
+		(Byte *)array->data, array->length * sizeof(Int32), (array->kind & SMILE_SECURITY_WRITABLE) != 0);
+}
+
+static Bool SmileInteger32Array_SetSecurityKey(SmileInteger32Array self, SmileObject newSecurityKey, SmileObject oldSecurityKey)
+{
+	Bool isValidSecurityKey = self->securityKey->vtable->compareEqual(self->securityKey, (SmileUnboxedData) { 0 }, oldSecurityKey, (SmileUnboxedData) { 0 });
+	if (!isValidSecurityKey)
+		return False;
+
+	self->securityKey = newSecurityKey;
+	return True;
+}
+
+static Bool SmileInteger32Array_SetSecurity(SmileInteger32Array self, Int security, SmileObject securityKey)
+{
+	Bool isValidSecurityKey = self->securityKey->vtable->compareEqual(self->securityKey, (SmileUnboxedData) { 0 }, securityKey, (SmileUnboxedData) { 0 });
+	if (!isValidSecurityKey)
+		return False;
+
+	switch (security & SMILE_SECURITY_READWRITEAPPEND) {
+		case SMILE_SECURITY_READONLY:
+		case SMILE_SECURITY_WRITABLE:
+			self->kind = (self->kind & ~SMILE_SECURITY_READWRITEAPPEND) | (security & SMILE_SECURITY_READWRITEAPPEND);
+			return True;
+		default:
+			return False;
+	}
+}
+
+static UInt32 SmileInteger32Array_Hash(SmileInteger32Array self)
+{
+	return Smile_ApplyHashOracle((PtrInt)self);
+}
+
+static Bool SmileInteger32Array_CompareEqual(SmileInteger32Array self, SmileUnboxedData selfUnboxed, SmileObject other, SmileUnboxedData otherUnboxed)
+{
+	return ((SmileObject)self == other);
+}
+
+static Bool SmileInteger32Array_DeepEqual(SmileInteger32Array self, SmileUnboxedData selfUnboxed, SmileObject other, SmileUnboxedData otherUnboxed, PointerSet visitedPointers)
+{
+	SmileInteger32Array otherArray;
+	Int i;
+	UNUSED(visitedPointers);
+
+	if (SMILE_KIND(other) != SMILE_KIND_INTEGER32ARRAY) return False;
+	otherArray = (SmileInteger32Array)other;
+
+	if (self->length != otherArray->length) return False;
+
+	for (i = 0; i < self->length; i++) {
+		if (self->data[i] != otherArray->data[i])
+			return False;
+	}
+	return True;
+}
+
+static SmileObject SmileInteger32Array_GetProperty(SmileInteger32Array self, Symbol propertyName)
+{
+	if (propertyName == Smile_KnownSymbols.length) {
+		return (SmileObject)SmileInteger64_Create(self->length);
+	}
+	return self->base->vtable->getProperty(self->base, propertyName);
+}
+
+static void SmileInteger32Array_SetProperty(SmileInteger32Array self, Symbol propertyName, SmileObject value)
+{
+	Smile_ThrowException(Smile_KnownSymbols.object_security_error,
+		String_Format("Cannot set property \"%S\" on a Integer32Array.",
+			SymbolTable_GetName(Smile_SymbolTable, propertyName)));
+}
+
+static Bool SmileInteger32Array_HasProperty(SmileInteger32Array self, Symbol propertyName)
+{
+	UNUSED(self);
+	return (propertyName == Smile_KnownSymbols.length);
+}
+
+static SmileList SmileInteger32Array_GetPropertyNames(SmileInteger32Array self)
+{
+	SmileList head, tail;
+
+	LIST_INIT(head, tail);
+
+	UNUSED(self);
+
+	LIST_APPEND(head, tail, SmileSymbol_Create(Smile_KnownSymbols.length));
+
+	return head;
+}
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/smilecell.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/internal/staticstring.h>
+#include <smile/smiletypes/easyobject.h>
+#include <smile/env/gcstats.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+SMILE_EASY_OBJECT_VTABLE(SmileCell);
+
+SmileCell SmileCell_Create(SmileArg value)
+{
+	SmileCell smileCell = GC_MALLOC_STRUCT(struct SmileCellInt);
+	if (smileCell == NULL) Smile_Abort_OutOfMemory();
+
+	smileCell->base = (SmileObject)Smile_KnownBases.Primitive;
+	smileCell->kind = SMILE_KIND_CELL;
+	smileCell->vtable = SmileCell_VTable;
+	SmileCell_SetValue(smileCell, value);
+
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_CELL, sizeof(struct SmileCellInt));
+
+	return smileCell;
+}
+
+SMILE_EASY_OBJECT_READONLY_SECURITY(SmileCell)
+SMILE_EASY_OBJECT_NO_CALL(SmileCell, "A Cell object")
+SMILE_EASY_OBJECT_NO_SOURCE(SmileCell)
+SMILE_EASY_OBJECT_NO_PROPERTIES(SmileCell)
+SMILE_EASY_OBJECT_NO_UNBOX(SmileCell)
+
+SMILE_EASY_OBJECT_HASH(SmileCell, Smile_ApplyHashOracle((PtrInt)obj))
+SMILE_EASY_OBJECT_TOBOOL(SmileCell, True)
+SMILE_EASY_OBJECT_TOSTRING(SmileCell, String_FromC("cell"))
+
+static Bool SmileCell_CompareEqual(SmileCell a, SmileUnboxedData aData, SmileObject b, SmileUnboxedData bData)
+{
+	return (SmileObject)a == b;
+}
+
+static Bool SmileCell_DeepEqual(SmileCell a, SmileUnboxedData aData, SmileObject b, SmileUnboxedData bData, PointerSet visitedPointers)
+{
+	UNUSED(visitedPointers);
+
+	return (SmileObject)a == b;
+}
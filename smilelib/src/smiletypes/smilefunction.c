@@ -20,6 +20,7 @@
 #include <smile/smiletypes/smilelist.h>
 #include <smile/smiletypes/easyobject.h>
 #include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/env/gcstats.h>
 #include <smile/eval/bytecode.h>
 
 extern SmileVTable SmileUserFunction_NoArgs_VTable;
@@ -272,6 +273,7 @@ SmileFunction SmileFunction_CreateUserFunction(UserFunctionInfo userFunctionInfo
 	smileFunction = GC_MALLOC_STRUCT(struct SmileFunctionInt);
 	if (smileFunction == NULL)
 		Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_FUNCTION, sizeof(struct SmileFunctionInt));
 
 	smileFunction->kind = SMILE_KIND_FUNCTION;
 	smileFunction->vtable = GetUserFunctionVTableByFlags(userFunctionInfo->flags, userFunctionInfo->numArgs);
@@ -372,12 +374,21 @@ SmileFunction SmileFunction_CreateExternalFunction(ExternalFunction externalFunc
 	if (numArgsToTypeCheck == 0)
 		argCheckFlags &= ~ARG_CHECK_TYPES;
 
+	// Pure functions with a fully-typed signature may be called directly by the interpreter,
+	// bypassing the vtable (and its type-checking) entirely once the arguments have been checked.
+	argCheckFlags &= ~ARG_DIRECT_CALL;
+	if ((argCheckFlags & ARG_PURE) && (argCheckFlags & ARG_CHECK_TYPES)
+		&& !(argCheckFlags & (ARG_STATE_MACHINE | ARG_MODE_RAW | ARG_CHECK_MAX))
+		&& (argCheckFlags & (ARG_CHECK_MIN | ARG_CHECK_EXACT)))
+		argCheckFlags |= ARG_DIRECT_CALL;
+
 	smileFunction = GC_MALLOC_STRUCT(struct SmileFunctionInt);
 	if (smileFunction == NULL)
 		Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_FUNCTION, sizeof(struct SmileFunctionInt));
 
 	smileFunction->kind = SMILE_KIND_FUNCTION | SMILE_FLAG_EXTERNAL_FUNCTION;
-	smileFunction->vtable = GetExternalFunctionVTableByFlags(argCheckFlags);
+	smileFunction->vtable = GetExternalFunctionVTableByFlags(argCheckFlags & ~(ARG_PURE | ARG_DIRECT_CALL));
 	smileFunction->base = (SmileObject)Smile_KnownBases.Fn;
 
 	smileFunction->u.externalFunctionInfo.argNames = String_FromC(argNames);
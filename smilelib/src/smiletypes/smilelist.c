@@ -22,6 +22,7 @@
 #include <smile/smiletypes/smilelist.h>
 #include <smile/smiletypes/text/smilesymbol.h>
 #include <smile/stringbuilder.h>
+#include <smile/env/gcstats.h>
 
 extern SmileVTable SmileList_VTable_ReadOnly;
 extern SmileVTable SmileList_VTable_ReadWrite;
@@ -42,6 +43,7 @@ Inline SmileList Cons(SmileObject a, SmileObject d)
 	SmileList smileList = GC_MALLOC_STRUCT(struct SmileListInt);
 	if (smileList == NULL)
 		Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_LIST, sizeof(struct SmileListInt));
 	smileList->base = (SmileObject)Smile_KnownBases.List;
 	smileList->kind = SMILE_KIND_LIST | SMILE_SECURITY_WRITABLE | SMILE_SECURITY_UNFROZEN;
 	smileList->vtable = SmileList_VTable_ReadWrite;
@@ -19,7 +19,14 @@
 #include <smile/smiletypes/smileuserobject.h>
 #include <smile/smiletypes/smilelist.h>
 #include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/numeric/smilebyte.h>
+#include <smile/smiletypes/numeric/smileinteger16.h>
+#include <smile/smiletypes/numeric/smileinteger32.h>
 #include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilefloat32.h>
+#include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/numeric/smilereal32.h>
+#include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/range/smileinteger64range.h>
 #include <smile/smiletypes/smilefunction.h>
 #include <smile/eval/eval.h>
@@ -59,6 +66,12 @@ static Byte _combineChecks[] = {
 	SMILE_KIND_MASK & ~SMILE_KIND_LIST_BIT, SMILE_KIND_NULL,
 };
 
+static Byte _foldChecks[] = {
+	SMILE_KIND_MASK & ~SMILE_KIND_LIST_BIT, SMILE_KIND_NULL,
+	0, 0,
+	SMILE_KIND_MASK, SMILE_KIND_FUNCTION,
+};
+
 static Byte _nthChecks[] = {
 	SMILE_KIND_MASK & ~SMILE_KIND_LIST_BIT, SMILE_KIND_NULL,
 	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_INTEGER64,
@@ -1083,6 +1096,338 @@ SMILE_EXTERNAL_FUNCTION(IndexOf)
 
 //-------------------------------------------------------------------------------------------------
 
+typedef enum {
+	ReduceMode_Sum,
+	ReduceMode_Product,
+	ReduceMode_Min,
+	ReduceMode_Max,
+	ReduceMode_MinBy,
+	ReduceMode_MaxBy,
+	ReduceMode_Fold,
+} ReduceMode;
+
+typedef struct ReduceInfoStruct {
+	SmileList list;
+	SmileFunction function;
+	SmileArg acc;
+	SmileArg bestKey;
+	Byte mode;
+	Bool hasKey;
+} *ReduceInfo;
+
+#define REDUCE_NATIVE_LOOP(__type__, __kind__, __rawType__, __mathType__, __unboxed__) \
+	{ \
+		__rawType__ x = acc->unboxed.__unboxed__, y; \
+		for (; SMILE_KIND(list) == SMILE_KIND_LIST && SMILE_KIND(list->a) == (__kind__); list = LIST_REST(list)) { \
+			y = ((Smile##__type__)list->a)->value; \
+			switch (mode) { \
+				case ReduceMode_Sum: x = (__rawType__)((__mathType__)x + (__mathType__)y); break; \
+				case ReduceMode_Product: x = (__rawType__)((__mathType__)x * (__mathType__)y); break; \
+				case ReduceMode_Min: if (y < x) x = y; break; \
+				case ReduceMode_Max: if (y > x) x = y; break; \
+			} \
+		} \
+		*acc = SmileUnboxed##__type__##_From(x); \
+	}
+
+#define REDUCE_REAL_LOOP(__type__, __kind__, __rawType__, __unboxed__) \
+	{ \
+		__rawType__ x = acc->unboxed.__unboxed__, y; \
+		for (; SMILE_KIND(list) == SMILE_KIND_LIST && SMILE_KIND(list->a) == (__kind__); list = LIST_REST(list)) { \
+			y = ((Smile##__type__)list->a)->value; \
+			switch (mode) { \
+				case ReduceMode_Sum: x = __type__##_Add(x, y); break; \
+				case ReduceMode_Product: x = __type__##_Mul(x, y); break; \
+				case ReduceMode_Min: if (__type__##_Lt(y, x)) x = y; break; \
+				case ReduceMode_Max: if (__type__##_Gt(y, x)) x = y; break; \
+			} \
+		} \
+		*acc = SmileUnboxed##__type__##_From(x); \
+	}
+
+/// <summary>
+/// Fold as much of the list into the accumulator as possible without calling any user code.
+/// This runs until it reaches the end of the list, or an item that isn't the same type of
+/// number as the accumulator, and it uses the same arithmetic as the numeric types' own
+/// methods, so integers wrap on overflow exactly as '+' and '*' do.
+/// </summary>
+/// <returns>The rest of the list, starting at the first item that wasn't folded in.</returns>
+static SmileList ReduceNative(SmileList list, SmileArg *acc, Byte mode)
+{
+	switch (SMILE_KIND(acc->obj)) {
+		case SMILE_KIND_UNBOXED_BYTE:
+			REDUCE_NATIVE_LOOP(Byte, SMILE_KIND_BYTE, Byte, UInt32, i8);
+			break;
+		case SMILE_KIND_UNBOXED_INTEGER16:
+			REDUCE_NATIVE_LOOP(Integer16, SMILE_KIND_INTEGER16, Int16, UInt32, i16);
+			break;
+		case SMILE_KIND_UNBOXED_INTEGER32:
+			REDUCE_NATIVE_LOOP(Integer32, SMILE_KIND_INTEGER32, Int32, UInt32, i32);
+			break;
+		case SMILE_KIND_UNBOXED_INTEGER64:
+			REDUCE_NATIVE_LOOP(Integer64, SMILE_KIND_INTEGER64, Int64, UInt64, i64);
+			break;
+		case SMILE_KIND_UNBOXED_FLOAT32:
+			REDUCE_NATIVE_LOOP(Float32, SMILE_KIND_FLOAT32, Float32, Float32, f32);
+			break;
+		case SMILE_KIND_UNBOXED_FLOAT64:
+			REDUCE_NATIVE_LOOP(Float64, SMILE_KIND_FLOAT64, Float64, Float64, f64);
+			break;
+		case SMILE_KIND_UNBOXED_REAL32:
+			REDUCE_REAL_LOOP(Real32, SMILE_KIND_REAL32, Real32, r32);
+			break;
+		case SMILE_KIND_UNBOXED_REAL64:
+			REDUCE_REAL_LOOP(Real64, SMILE_KIND_REAL64, Real64, r64);
+			break;
+	}
+	return list;
+}
+
+#undef REDUCE_NATIVE_LOOP
+#undef REDUCE_REAL_LOOP
+
+static SmileFunction GetReduceMethod(SmileArg arg, Symbol methodName, const char *name)
+{
+	SmileFunction method = (SmileFunction)SMILE_VCALL1(SmileArg_Box(arg), getProperty, methodName);
+	if (SMILE_KIND(method) != SMILE_KIND_FUNCTION) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_Format("Cannot continue '%s': Object does not have an associated '%S' method.",
+				name, SymbolTable_GetName(Smile_SymbolTable, methodName)));
+	}
+	return method;
+}
+
+static Int ReduceStart(ClosureStateMachine closure)
+{
+	register ReduceInfo loopInfo = (ReduceInfo)closure->state;
+
+	//---------- begin first for-loop iteration ----------
+
+	// Fast path: Without a user function, run natively until we hit something we can't add or compare.
+	if (loopInfo->function == NULL && loopInfo->mode <= ReduceMode_Max)
+		loopInfo->list = ReduceNative(loopInfo->list, &loopInfo->acc, loopInfo->mode);
+
+	// Condition: If we've run out of list nodes, we're done.
+	if (SMILE_KIND(loopInfo->list) != SMILE_KIND_LIST) {
+		Closure_Push(closure, loopInfo->acc);
+		return -1;
+	}
+
+	// Body: Set up to call the user's function (or the accumulator's method) with the next list item.
+	switch (loopInfo->mode) {
+		case ReduceMode_Sum:
+			Closure_PushBoxed(closure, GetReduceMethod(loopInfo->acc, Smile_KnownSymbols.plus, "sum"));
+			Closure_Push(closure, loopInfo->acc);
+			Closure_UnboxAndPush(closure, loopInfo->list->a);
+			return 2;
+
+		case ReduceMode_Product:
+			Closure_PushBoxed(closure, GetReduceMethod(loopInfo->acc, Smile_KnownSymbols.star, "product"));
+			Closure_Push(closure, loopInfo->acc);
+			Closure_UnboxAndPush(closure, loopInfo->list->a);
+			return 2;
+
+		case ReduceMode_Min:
+		case ReduceMode_Max:
+			Closure_PushBoxed(closure, GetReduceMethod(SmileArg_Unbox(loopInfo->list->a), Smile_KnownSymbols.cmp,
+				loopInfo->mode == ReduceMode_Min ? "min" : "max"));
+			Closure_UnboxAndPush(closure, loopInfo->list->a);
+			Closure_Push(closure, loopInfo->acc);
+			return 2;
+
+		case ReduceMode_MinBy:
+		case ReduceMode_MaxBy:
+			Closure_PushBoxed(closure, loopInfo->function);
+			Closure_UnboxAndPush(closure, loopInfo->list->a);
+			return 1;
+
+		default:
+			Closure_PushBoxed(closure, loopInfo->function);
+			Closure_Push(closure, loopInfo->acc);
+			Closure_UnboxAndPush(closure, loopInfo->list->a);
+			return 2;
+	}
+}
+
+static Int ReduceBody(ClosureStateMachine closure)
+{
+	register ReduceInfo loopInfo = (ReduceInfo)closure->state;
+	Int cmp;
+
+	// Body: Fold the result of the call into the accumulator.
+	SmileArg fnResult = Closure_Pop(closure);
+
+	switch (loopInfo->mode) {
+		case ReduceMode_Min:
+		case ReduceMode_Max:
+			if (SMILE_KIND(fnResult.obj) != SMILE_KIND_UNBOXED_INTEGER64)
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+					String_Format("Cannot continue '%s': Comparison result must be an Integer64.",
+						loopInfo->mode == ReduceMode_Min ? "min" : "max"));
+			if (loopInfo->mode == ReduceMode_Min ? fnResult.unboxed.i64 < 0 : fnResult.unboxed.i64 > 0)
+				loopInfo->acc = SmileArg_Unbox(loopInfo->list->a);
+			break;
+
+		case ReduceMode_MinBy:
+		case ReduceMode_MaxBy:
+			if (!loopInfo->hasKey) {
+				loopInfo->bestKey = fnResult;
+				loopInfo->hasKey = True;
+				break;
+			}
+			if (!SmileArg_TryCompare(fnResult, loopInfo->bestKey, &cmp))
+				Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+					String_Format("Cannot continue '%s': Keys must be numbers, characters, or strings, all of the same type.",
+						loopInfo->mode == ReduceMode_MinBy ? "min-by" : "max-by"));
+			if (loopInfo->mode == ReduceMode_MinBy ? cmp < 0 : cmp > 0) {
+				loopInfo->bestKey = fnResult;
+				loopInfo->acc = SmileArg_Unbox(loopInfo->list->a);
+			}
+			break;
+
+		default:
+			loopInfo->acc = fnResult;
+			break;
+	}
+
+	// Next: Move the iterator to the next item.
+	loopInfo->list = LIST_REST(loopInfo->list);
+
+	//---------- end previous for-loop iteration ----------
+
+	return ReduceStart(closure);
+}
+
+static SmileArg BeginReduce(SmileList list, SmileFunction function, SmileArg acc, Byte mode)
+{
+	// We use Eval's state-machine construct to avoid recursing deeper on the C stack.
+	ClosureStateMachine closure = Eval_BeginStateMachine(ReduceStart, ReduceBody);
+	ReduceInfo reduceInfo = (ReduceInfo)closure->state;
+
+	reduceInfo->list = list;
+	reduceInfo->function = function;
+	reduceInfo->acc = acc;
+	reduceInfo->bestKey = SmileArg_From(NullObject);
+	reduceInfo->mode = mode;
+	reduceInfo->hasKey = False;
+
+	return (SmileArg){ NULL };	// We have to return something, but this value will be ignored.
+}
+
+/// <summary>
+/// Sum or multiply a list.  Lists of numbers that are all the same type are handled natively;
+/// anything else is folded together by calling the accumulator's '+' or '*' method.
+/// </summary>
+static SmileArg SumOrProduct(SmileList list, Byte mode)
+{
+	SmileArg acc;
+
+	// The sum of nothing is zero, and the product of nothing is one.
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return SmileUnboxedInteger64_From(mode == ReduceMode_Sum ? 0 : 1);
+
+	acc = SmileArg_Unbox(list->a);
+	list = ReduceNative(LIST_REST(list), &acc, mode);
+
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return acc;
+
+	return BeginReduce(list, NULL, acc, mode);
+}
+
+SMILE_EXTERNAL_FUNCTION(Sum)
+{
+	return SumOrProduct((SmileList)argv[0].obj, ReduceMode_Sum);
+}
+
+SMILE_EXTERNAL_FUNCTION(Product)
+{
+	return SumOrProduct((SmileList)argv[0].obj, ReduceMode_Product);
+}
+
+/// <summary>
+/// Find the least or greatest item in a list.  Numbers, characters, and strings are compared
+/// natively; anything else is compared by calling the item's 'cmp' method.
+/// </summary>
+static SmileArg MinOrMax(SmileList list, Byte mode)
+{
+	SmileArg best, item;
+	Int cmp;
+
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return SmileArg_From(NullObject);
+
+	best = SmileArg_Unbox(list->a);
+	list = ReduceNative(LIST_REST(list), &best, mode);
+
+	// Strings and characters don't go through ReduceNative(), but they can still be compared without calling 'cmp'.
+	for (; SMILE_KIND(list) == SMILE_KIND_LIST; list = LIST_REST(list)) {
+		item = SmileArg_Unbox(list->a);
+		if (!SmileArg_TryCompare(item, best, &cmp))
+			break;
+		if (mode == ReduceMode_Min ? cmp < 0 : cmp > 0)
+			best = item;
+	}
+
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return best;
+
+	return BeginReduce(list, NULL, best, mode);
+}
+
+SMILE_EXTERNAL_FUNCTION(Min)
+{
+	return MinOrMax((SmileList)argv[0].obj, ReduceMode_Min);
+}
+
+SMILE_EXTERNAL_FUNCTION(Max)
+{
+	return MinOrMax((SmileList)argv[0].obj, ReduceMode_Max);
+}
+
+SMILE_EXTERNAL_FUNCTION(MinBy)
+{
+	SmileList list = (SmileList)argv[0].obj;
+
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(list, (SmileFunction)argv[1].obj, SmileArg_Unbox(list->a), ReduceMode_MinBy);
+}
+
+SMILE_EXTERNAL_FUNCTION(MaxBy)
+{
+	SmileList list = (SmileList)argv[0].obj;
+
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return SmileArg_From(NullObject);
+
+	return BeginReduce(list, (SmileFunction)argv[1].obj, SmileArg_Unbox(list->a), ReduceMode_MaxBy);
+}
+
+SMILE_EXTERNAL_FUNCTION(Fold)
+{
+	if (SMILE_KIND(argv[0].obj) != SMILE_KIND_LIST)
+		return argv[1];
+
+	return BeginReduce((SmileList)argv[0].obj, (SmileFunction)argv[2].obj, argv[1], ReduceMode_Fold);
+}
+
+SMILE_EXTERNAL_FUNCTION(Reduce)
+{
+	SmileList list = (SmileList)argv[0].obj;
+
+	// Reducing starts with the first item, so an empty list has nothing to reduce.
+	if (SMILE_KIND(list) != SMILE_KIND_LIST)
+		return SmileArg_From(NullObject);
+	if (SMILE_KIND(list->d) != SMILE_KIND_LIST)
+		return SmileArg_Unbox(list->a);
+
+	return BeginReduce(LIST_REST(list), (SmileFunction)argv[1].obj, SmileArg_Unbox(list->a), ReduceMode_Fold);
+}
+
+//-------------------------------------------------------------------------------------------------
+
 typedef struct SortInfoStruct {
 	SmileFunction cmp;
 	InterruptibleListSortInfo actualSortInfo;
@@ -1611,14 +1956,14 @@ void SmileList_Setup(SmileUserObject base)
 	SetupFunction("append-list!", AppendListInPlace, NULL, "list lists...", ARG_CHECK_MIN | ARG_CHECK_TYPES, 1, 0, 1, _listChecks);
 	SetupSynonym("append-list!", "conc-list!");
 
-	SetupFunction("nth", Nth, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _nthChecks);
-	SetupFunction("nth-cell", NthCell, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _nthChecks);
-	SetupFunction("nth-reverse", NthReverse, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _nthChecks);
-	SetupFunction("nth-cell-reverse", NthCellReverse, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _nthChecks);
+	SetupFunction("nth", Nth, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _nthChecks);
+	SetupFunction("nth-cell", NthCell, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _nthChecks);
+	SetupFunction("nth-reverse", NthReverse, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _nthChecks);
+	SetupFunction("nth-cell-reverse", NthCellReverse, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _nthChecks);
 	SetupFunction("skip", Skip, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _nthChecks);
 	SetupFunction("take", Take, NULL, "list count", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _nthChecks);
 
-	SetupFunction("get-member", GetMember, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
+	SetupFunction("get-member", GetMember, NULL, "list index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
 
 	/*
 	SetupFunction("set-member", SetMember, NULL, "list index value", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 3, 3, 2, _joinChecks);
@@ -1636,8 +1981,8 @@ void SmileList_Setup(SmileUserObject base)
 	SetupFunction("where", Where, NULL, "list fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
 	SetupSynonym("where", "filter");
 
-	SetupFunction("empty?", Empty, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("null?", Empty, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
+	SetupFunction("empty?", Empty, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("null?", Empty, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
 
 	SetupFunction("any?", Any, NULL, "list fn", ARG_STATE_MACHINE, 0, 0, 0, NULL);
 	SetupFunction("contains?", Contains, NULL, "list fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _indexOfChecks);
@@ -1646,47 +1991,56 @@ void SmileList_Setup(SmileUserObject base)
 	SetupFunction("index-of", IndexOf, NULL, "list fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _indexOfChecks);
 	SetupFunction("count", Count, NULL, "list fn", ARG_STATE_MACHINE, 0, 0, 0, NULL);
 
+	SetupFunction("sum", Sum, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 1, 1, 1, _listChecks);
+	SetupFunction("product", Product, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 1, 1, 1, _listChecks);
+	SetupFunction("min", Min, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 1, 1, 1, _listChecks);
+	SetupFunction("max", Max, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 1, 1, 1, _listChecks);
+	SetupFunction("min-by", MinBy, NULL, "list fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+	SetupFunction("max-by", MaxBy, NULL, "list fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+	SetupFunction("fold", Fold, NULL, "list init fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 3, 3, 3, _foldChecks);
+	SetupFunction("reduce", Reduce, NULL, "list fn", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
+
 	SetupFunction("sort!", SortInPlace, NULL, "list fn", ARG_STATE_MACHINE, 0, 0, 0, NULL);
 	SetupFunction("sort", Sort, NULL, "list fn", ARG_STATE_MACHINE, 0, 0, 0, NULL);
 
-	SetupFunction("length", Length, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cycle?", HasCycle, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("well-formed?", IsWellFormed, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
+	SetupFunction("length", Length, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cycle?", HasCycle, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("well-formed?", IsWellFormed, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
 
-	SetupFunction("car", Car, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdr", Cdr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
+	SetupFunction("car", Car, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdr", Cdr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
 	SetupSynonym("cdr", "rest");
 
-	SetupFunction("caar", Caar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cadr", Cadr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdar", Cdar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cddr", Cddr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-
-	SetupFunction("caaar", Caaar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("caadr", Caadr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cadar", Cadar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("caddr", Caddr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdaar", Cdaar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdadr", Cdadr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cddar", Cddar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdddr", Cdddr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-
-	SetupFunction("caaaar", Cxr, (void *)0x00001111, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("caaadr", Cxr, (void *)0x00001112, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("caadar", Cxr, (void *)0x00001121, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("caaddr", Cxr, (void *)0x00001122, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cadaar", Cxr, (void *)0x00001211, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cadadr", Cxr, (void *)0x00001212, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("caddar", Cxr, (void *)0x00001221, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cadddr", Cxr, (void *)0x00001222, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdaaar", Cxr, (void *)0x00002111, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdaadr", Cxr, (void *)0x00002112, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdadar", Cxr, (void *)0x00002121, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdaddr", Cxr, (void *)0x00002122, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cddaar", Cxr, (void *)0x00002211, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cddadr", Cxr, (void *)0x00002212, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cdddar", Cxr, (void *)0x00002221, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
-	SetupFunction("cddddr", Cxr, (void *)0x00002222, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _listChecks);
+	SetupFunction("caar", Caar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cadr", Cadr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdar", Cdar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cddr", Cddr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+
+	SetupFunction("caaar", Caaar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("caadr", Caadr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cadar", Cadar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("caddr", Caddr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdaar", Cdaar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdadr", Cdadr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cddar", Cddar, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdddr", Cdddr, NULL, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+
+	SetupFunction("caaaar", Cxr, (void *)0x00001111, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("caaadr", Cxr, (void *)0x00001112, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("caadar", Cxr, (void *)0x00001121, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("caaddr", Cxr, (void *)0x00001122, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cadaar", Cxr, (void *)0x00001211, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cadadr", Cxr, (void *)0x00001212, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("caddar", Cxr, (void *)0x00001221, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cadddr", Cxr, (void *)0x00001222, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdaaar", Cxr, (void *)0x00002111, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdaadr", Cxr, (void *)0x00002112, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdadar", Cxr, (void *)0x00002121, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdaddr", Cxr, (void *)0x00002122, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cddaar", Cxr, (void *)0x00002211, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cddadr", Cxr, (void *)0x00002212, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cdddar", Cxr, (void *)0x00002221, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
+	SetupFunction("cddddr", Cxr, (void *)0x00002222, "list", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _listChecks);
 
 	SetupFunction("tail", Tail, NULL, "list", ARG_CHECK_MIN | ARG_CHECK_TYPES, 1, 0, 1, _listChecks);
 }
@@ -27,6 +27,7 @@
 #include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/numeric/smilefloat32.h>
 #include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
 #include <smile/smiletypes/text/smilechar.h>
 #include <smile/smiletypes/text/smileuni.h>
 #include <smile/smiletypes/text/smilesymbol.h>
@@ -88,6 +89,11 @@ next:
 				return False;
 			return True;
 
+		case SMILE_KIND_BIGINT:
+			if (!BigInt_Eq(((SmileBigInt)a)->value, ((SmileBigInt)b)->value))
+				return False;
+			return True;
+
 		case SMILE_KIND_BOOL:
 			if (((SmileBool)a)->value != ((SmileBool)b)->value)
 				return False;
@@ -163,6 +169,65 @@ Bool SmileArg_DeepCompare(SmileArg self, SmileArg other)
 	return result;
 }
 
+/// <summary>
+/// Compare two arguments natively, without calling any user code.  This only succeeds
+/// when both arguments are numbers of the same type, characters of the same type, or strings;
+/// anything else needs to be compared by calling its 'cmp' method.
+/// </summary>
+/// <param name="a">The first argument to compare.</param>
+/// <param name="b">The second argument to compare.</param>
+/// <param name="cmp">This will be set to a negative number if a &lt; b, zero if a == b, or a
+/// positive number if a &gt; b.  (Unordered floating-point values compare as equal.)</param>
+/// <returns>True if the arguments could be compared natively, False if not.</returns>
+Bool SmileArg_TryCompare(SmileArg a, SmileArg b, Int *cmp)
+{
+	Int kind = SMILE_KIND(a.obj);
+
+	if (SMILE_KIND(b.obj) != kind) {
+		*cmp = 0;
+		return False;
+	}
+
+	switch (kind) {
+		case SMILE_KIND_UNBOXED_BYTE:
+			*cmp = (Int)a.unboxed.i8 - (Int)b.unboxed.i8;
+			return True;
+		case SMILE_KIND_UNBOXED_INTEGER16:
+			*cmp = (Int)a.unboxed.i16 - (Int)b.unboxed.i16;
+			return True;
+		case SMILE_KIND_UNBOXED_INTEGER32:
+			*cmp = a.unboxed.i32 < b.unboxed.i32 ? -1 : a.unboxed.i32 > b.unboxed.i32 ? +1 : 0;
+			return True;
+		case SMILE_KIND_UNBOXED_INTEGER64:
+			*cmp = a.unboxed.i64 < b.unboxed.i64 ? -1 : a.unboxed.i64 > b.unboxed.i64 ? +1 : 0;
+			return True;
+		case SMILE_KIND_UNBOXED_FLOAT32:
+			*cmp = a.unboxed.f32 < b.unboxed.f32 ? -1 : a.unboxed.f32 > b.unboxed.f32 ? +1 : 0;
+			return True;
+		case SMILE_KIND_UNBOXED_FLOAT64:
+			*cmp = a.unboxed.f64 < b.unboxed.f64 ? -1 : a.unboxed.f64 > b.unboxed.f64 ? +1 : 0;
+			return True;
+		case SMILE_KIND_UNBOXED_REAL32:
+			*cmp = Real32_Lt(a.unboxed.r32, b.unboxed.r32) ? -1 : Real32_Gt(a.unboxed.r32, b.unboxed.r32) ? +1 : 0;
+			return True;
+		case SMILE_KIND_UNBOXED_REAL64:
+			*cmp = Real64_Lt(a.unboxed.r64, b.unboxed.r64) ? -1 : Real64_Gt(a.unboxed.r64, b.unboxed.r64) ? +1 : 0;
+			return True;
+		case SMILE_KIND_UNBOXED_CHAR:
+			*cmp = (Int)a.unboxed.ch - (Int)b.unboxed.ch;
+			return True;
+		case SMILE_KIND_UNBOXED_UNI:
+			*cmp = a.unboxed.uni < b.unboxed.uni ? -1 : a.unboxed.uni > b.unboxed.uni ? +1 : 0;
+			return True;
+		case SMILE_KIND_STRING:
+			*cmp = String_Compare((String)a.obj, (String)b.obj);
+			return True;
+		default:
+			*cmp = 0;
+			return False;
+	}
+}
+
 Bool SmileObject_CompareEqual(SmileObject self, SmileUnboxedData selfData, SmileObject other, SmileUnboxedData otherData)
 {
 	UNUSED(selfData);
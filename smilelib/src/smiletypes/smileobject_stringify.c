@@ -33,11 +33,16 @@
 #include <smile/smiletypes/numeric/smilereal64.h>
 #include <smile/smiletypes/numeric/smilefloat32.h>
 #include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/numeric/smilebigint.h>
 #include <smile/smiletypes/range/smileinteger64range.h>
 #include <smile/smiletypes/text/smilesymbol.h>
 #include <smile/smiletypes/text/smilechar.h>
 #include <smile/smiletypes/text/smileuni.h>
 #include <smile/smiletypes/raw/smilebytearray.h>
+#include <smile/smiletypes/raw/smileinteger32array.h>
+#include <smile/smiletypes/raw/smileinteger64array.h>
+#include <smile/smiletypes/raw/smilefloat32array.h>
+#include <smile/smiletypes/raw/smilefloat64array.h>
 #include <smile/smiletypes/smilehandle.h>
 #include <smile/internal/staticstring.h>
 #include <smile/numeric/float64.h>
@@ -260,6 +265,10 @@ static void StringifyRecursive(SmileObject obj, StringBuilder stringBuilder, Int
 		StringBuilder_AppendFormat(stringBuilder, "%ld", ((SmileInteger64)obj)->value);
 		return;
 
+	case SMILE_KIND_BIGINT:
+		StringBuilder_AppendString(stringBuilder, BigInt_ToString(((SmileBigInt)obj)->value, 10));
+		return;
+
 	case SMILE_KIND_REAL32:
 		StringBuilder_AppendFormat(stringBuilder, "%S", Real32_ToStringEx(((SmileReal32)obj)->value, 0, 0, False));
 		return;
@@ -269,11 +278,11 @@ static void StringifyRecursive(SmileObject obj, StringBuilder stringBuilder, Int
 		return;
 
 	case SMILE_KIND_FLOAT32:
-		StringBuilder_AppendFormat(stringBuilder, "%S", Float64_ToStringEx((double)((SmileFloat32)obj)->value, 0, 6, False));
+		StringBuilder_AppendString(stringBuilder, Float32_ToStringEx(((SmileFloat32)obj)->value, 0, 0, False));
 		return;
 
 	case SMILE_KIND_FLOAT64:
-		StringBuilder_AppendFormat(stringBuilder, "%S", Float64_ToStringEx(((SmileFloat64)obj)->value, 0, 15, False));
+		StringBuilder_AppendString(stringBuilder, Float64_ToStringEx(((SmileFloat64)obj)->value, 0, 0, False));
 		return;
 
 	case SMILE_KIND_CHAR:
@@ -292,6 +301,22 @@ static void StringifyRecursive(SmileObject obj, StringBuilder stringBuilder, Int
 		StringBuilder_AppendFormat(stringBuilder, "(ByteArray of %ld)", (Int64)((SmileByteArray)obj)->length);
 		return;
 
+	case SMILE_KIND_INTEGER32ARRAY:
+		StringBuilder_AppendFormat(stringBuilder, "(Integer32Array of %ld)", (Int64)((SmileInteger32Array)obj)->length);
+		return;
+
+	case SMILE_KIND_INTEGER64ARRAY:
+		StringBuilder_AppendFormat(stringBuilder, "(Integer64Array of %ld)", (Int64)((SmileInteger64Array)obj)->length);
+		return;
+
+	case SMILE_KIND_FLOAT32ARRAY:
+		StringBuilder_AppendFormat(stringBuilder, "(Float32Array of %ld)", (Int64)((SmileFloat32Array)obj)->length);
+		return;
+
+	case SMILE_KIND_FLOAT64ARRAY:
+		StringBuilder_AppendFormat(stringBuilder, "(Float64Array of %ld)", (Int64)((SmileFloat64Array)obj)->length);
+		return;
+
 	case SMILE_KIND_USEROBJECT:
 		{
 			SmileUserObject userObject = (SmileUserObject)obj;
@@ -0,0 +1,146 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/smiletypes/smileobject.h>
+#include <smile/smiletypes/smilepackedarg.h>
+#include <smile/env/env.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/numeric/smilebyte.h>
+#include <smile/smiletypes/numeric/smileinteger16.h>
+#include <smile/smiletypes/numeric/smileinteger32.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilefloat32.h>
+#include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/numeric/smilereal32.h>
+#include <smile/smiletypes/numeric/smilereal64.h>
+#include <smile/smiletypes/text/smilechar.h>
+#include <smile/smiletypes/text/smileuni.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+
+/// <summary>
+/// Pack an Int64 into a packed arg.  Values that fit in 48 signed bits are stored inline;
+/// larger values are boxed.
+/// </summary>
+/// <param name="value">The value to pack.</param>
+/// <returns>The packed form of that value.</returns>
+SmilePackedArg SmilePackedArg_FromInt64(Int64 value)
+{
+	if (value >= SMILE_PACKED_INT48_MIN && value <= SMILE_PACKED_INT48_MAX)
+		return (SMILE_PACKED_TAG_INT48 << SMILE_PACKED_TAG_SHIFT) | ((UInt64)value & 0x0000FFFFFFFFFFFFULL);
+
+	return SmilePackedArg_FromObject((SmileObject)SmileInteger64_Create(value));
+}
+
+/// <summary>
+/// Convert a SmileArg to its 8-byte packed form.  Unboxed values that fit in the packed encoding
+/// are stored inline; unboxed values that don't are boxed; and boxed objects are stored as pointers.
+/// </summary>
+/// <param name="arg">The argument to pack.</param>
+/// <returns>The packed form of that argument.</returns>
+SmilePackedArg SmilePackedArg_Pack(SmileArg arg)
+{
+	switch (SMILE_KIND(arg.obj)) {
+		case SMILE_KIND_UNBOXED_BYTE:
+			return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_BYTE, arg.unboxed.i8);
+		case SMILE_KIND_UNBOXED_INTEGER16:
+			return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_INTEGER16, (UInt16)arg.unboxed.i16);
+		case SMILE_KIND_UNBOXED_INTEGER32:
+			return SmilePackedArg_FromInt32(arg.unboxed.i32);
+		case SMILE_KIND_UNBOXED_INTEGER64:
+			return SmilePackedArg_FromInt64(arg.unboxed.i64);
+		case SMILE_KIND_UNBOXED_BOOL:
+			return SmilePackedArg_FromBool(arg.unboxed.b);
+		case SMILE_KIND_UNBOXED_FLOAT32:
+			{
+				union { Float32 f; UInt32 u; } bits;
+				bits.f = arg.unboxed.f32;
+				return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_FLOAT32, bits.u);
+			}
+		case SMILE_KIND_UNBOXED_FLOAT64:
+			return SmilePackedArg_FromFloat64(arg.unboxed.f64);
+		case SMILE_KIND_UNBOXED_SYMBOL:
+			return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_SYMBOL, (UInt32)arg.unboxed.symbol);
+		case SMILE_KIND_UNBOXED_REAL32:
+			return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_REAL32, arg.unboxed.r32.value);
+		case SMILE_KIND_UNBOXED_REAL64:
+			return SmilePackedArg_FromObject((SmileObject)SmileReal64_Create(arg.unboxed.r64));
+		case SMILE_KIND_UNBOXED_CHAR:
+			return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_CHAR, arg.unboxed.ch);
+		case SMILE_KIND_UNBOXED_UNI:
+			return SmilePackedArg_FromScalar(SMILE_KIND_UNBOXED_UNI, arg.unboxed.uni);
+		default:
+			return SmilePackedArg_FromObject(arg.obj);
+	}
+}
+
+/// <summary>
+/// Convert a packed arg back to a SmileArg.  Integer64 and Real64 values that had to be boxed
+/// to fit the packed encoding are returned unboxed, just as they were before they were packed.
+/// </summary>
+/// <param name="packed">The packed arg to convert.</param>
+/// <returns>The equivalent SmileArg.</returns>
+SmileArg SmilePackedArg_Unpack(SmilePackedArg packed)
+{
+	SmileObject obj;
+	UInt32 bits;
+
+	switch (SmilePackedArg_Tag(packed)) {
+		case 0:
+			obj = SmilePackedArg_GetObject(packed);
+			if (SMILE_KIND(obj) == SMILE_KIND_INTEGER64 || SMILE_KIND(obj) == SMILE_KIND_REAL64)
+				return SmileArg_Unbox(obj);
+			return SmileArg_From(obj);
+
+		case SMILE_PACKED_TAG_INT48:
+			return SmileUnboxedInteger64_From(SmilePackedArg_GetInt48(packed));
+
+		case SMILE_PACKED_TAG_SCALAR:
+			bits = SmilePackedArg_GetScalarBits(packed);
+			switch (SmilePackedArg_Kind(packed)) {
+				case SMILE_KIND_UNBOXED_BYTE:
+					return SmileUnboxedByte_From((Byte)bits);
+				case SMILE_KIND_UNBOXED_INTEGER16:
+					return SmileUnboxedInteger16_From((Int16)bits);
+				case SMILE_KIND_UNBOXED_INTEGER32:
+					return SmileUnboxedInteger32_From((Int32)bits);
+				case SMILE_KIND_UNBOXED_BOOL:
+					return SmileUnboxedBool_From((Bool)bits);
+				case SMILE_KIND_UNBOXED_FLOAT32:
+					{
+						union { Float32 f; UInt32 u; } fbits;
+						fbits.u = bits;
+						return SmileUnboxedFloat32_From(fbits.f);
+					}
+				case SMILE_KIND_UNBOXED_SYMBOL:
+					return SmileUnboxedSymbol_From((Symbol)bits);
+				case SMILE_KIND_UNBOXED_REAL32:
+					{
+						Real32 r32;
+						r32.value = bits;
+						return SmileUnboxedReal32_From(r32);
+					}
+				case SMILE_KIND_UNBOXED_CHAR:
+					return SmileUnboxedChar_From((Byte)bits);
+				case SMILE_KIND_UNBOXED_UNI:
+					return SmileUnboxedUni_From(bits);
+			}
+			return SmileArg_From(NullObject);
+
+		default:
+			return SmileUnboxedFloat64_From(SmilePackedArg_GetFloat64(packed));
+	}
+}
@@ -21,6 +21,7 @@
 #include <smile/smiletypes/smileuserobject.h>
 #include <smile/smiletypes/smilefunction.h>
 #include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/env/gcstats.h>
 
 extern SmileVTable SmileUserObject_VTable_ReadOnly;
 extern SmileVTable SmileUserObject_VTable_ReadWrite;
@@ -31,6 +32,7 @@ SmileUserObject SmileUserObject_CreateWithSize(SmileObject base, Symbol name, In
 {
 	SmileUserObject userObject = GC_MALLOC_STRUCT(struct SmileUserObjectInt);
 	if (userObject == NULL || initialSize >= Int32Max) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_USEROBJECT, sizeof(struct SmileUserObjectInt));
 
 	userObject->base = base;
 	userObject->kind = SMILE_KIND_USEROBJECT | SMILE_SECURITY_READWRITEAPPEND | SMILE_SECURITY_UNFROZEN;
@@ -309,42 +309,42 @@ void SmileChar_Setup(SmileUserObject base)
 	SetupFunction("string", ToString, NULL, "ch", ARG_CHECK_EXACT, 1, 1, 0, NULL);
 	SetupFunction("hash", Hash, NULL, "ch", ARG_CHECK_EXACT, 1, 1, 0, NULL);
 
-	SetupFunction("int64", ToInt64, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("int32", ToInt32, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("int16", ToInt16, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("byte", ToByte, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
+	SetupFunction("int64", ToInt64, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("int32", ToInt32, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("int16", ToInt16, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("byte", ToByte, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
 
-	SetupFunction("char", ToChar, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("uni", ToUni, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
+	SetupFunction("char", ToChar, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("uni", ToUni, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
 
-	SetupFunction("+", Plus, NULL, "ch other", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charComparisonChecks);
-	SetupFunction("-", Minus, NULL, "ch other", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charComparisonChecks);
+	SetupFunction("+", Plus, NULL, "ch other", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charComparisonChecks);
+	SetupFunction("-", Minus, NULL, "ch other", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charComparisonChecks);
 
-	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charComparisonChecks);
-	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charComparisonChecks);
-	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charChecks);
-	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charChecks);
-	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charChecks);
-	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charChecks);
+	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charComparisonChecks);
+	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charComparisonChecks);
+	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charChecks);
+	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charChecks);
+	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charChecks);
+	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charChecks);
 
-	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charChecks);
+	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charChecks);
 	SetupSynonym("compare", "cmp");
 
-	SetupFunction("lowercase", Lowercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("uppercase", Uppercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
+	SetupFunction("lowercase", Lowercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("uppercase", Uppercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
 	SetupSynonym("lowercase", "case-fold");
 	SetupSynonym("lowercase", "fold");
 
-	SetupFunction("whitespace?", IsWhitespace, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("alpha?", IsAlpha, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("lowercase?", IsLowercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("uppercase?", IsUppercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("alnum?", IsAlnum, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("digit?", IsDigit, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("hex?", IsHex, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
-	SetupFunction("octal?", IsOctal, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
+	SetupFunction("whitespace?", IsWhitespace, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("alpha?", IsAlpha, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("lowercase?", IsLowercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("uppercase?", IsUppercase, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("alnum?", IsAlnum, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("digit?", IsDigit, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("hex?", IsHex, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
+	SetupFunction("octal?", IsOctal, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
 
-	SetupFunction("c-ident?", IsCIdent, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _charChecks);
+	SetupFunction("c-ident?", IsCIdent, NULL, "ch", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _charChecks);
 
-	SetupFunction("range-to", RangeTo, NULL, "start end", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _charChecks);
+	SetupFunction("range-to", RangeTo, NULL, "start end", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _charChecks);
 }
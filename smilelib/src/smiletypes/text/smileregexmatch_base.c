@@ -452,7 +452,7 @@ SMILE_EXTERNAL_FUNCTION(Object)
 			index = StringIntDict_GetValue(&regexMatch->namedCaptures, key);
 			range = regexMatch->indexedCaptures + index;
 			value = String_Substring(regexMatch->input, range->start, range->length);
-			SmileUserObject_Set(obj, SymbolTable_GetSymbol(Smile_SymbolTable, key), value);
+			SmileUserObject_Set(obj, SymbolTable_GetCollectableSymbol(Smile_SymbolTable, key), value);
 		}
 	}
 
@@ -17,6 +17,9 @@
 
 #include <smile/string.h>
 #include <smile/stringbuilder.h>
+#include <smile/foldsearch.h>
+#include <smile/utf8.h>
+#include <smile/codepage.h>
 #include <smile/eval/eval.h>
 #include <smile/smiletypes/smileobject.h>
 #include <smile/smiletypes/smileuserobject.h>
@@ -34,10 +37,15 @@
 #include <smile/smiletypes/raw/smilebytearray.h>
 #include <smile/smiletypes/smilehandle.h>
 #include <smile/regex.h>
+#include <smile/crypto/base64.h>
+#include <smile/crypto/hex.h>
 #include <smile/internal/staticstring.h>
 
 SMILE_IGNORE_UNUSED_VARIABLES
 
+// Non-ASCII strings at least this long use a breadcrumb index to find code points by position.
+#define UNI_INDEX_MIN_LENGTH 1024
+
 extern SmileArg RegexReplaceStateMachine_Start(Regex regex, String input, SmileFunction function, Int startOffset, Int limit, Bool demoteMatchToString);
 
 static Byte _stringChecks[] = {
@@ -90,6 +98,13 @@ static Byte _hyphenizeChecks[] = {
 	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_BYTE,
 };
 
+static Byte _codecChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_STRING,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_SYMBOL,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_SYMBOL,
+	SMILE_KIND_MASK, SMILE_KIND_UNBOXED_SYMBOL,
+};
+
 static Byte _wildcardChecks[] = {
 	SMILE_KIND_MASK, SMILE_KIND_STRING,
 	SMILE_KIND_MASK, SMILE_KIND_STRING,
@@ -145,7 +160,7 @@ SMILE_EXTERNAL_FUNCTION(Hash)
 
 SMILE_EXTERNAL_FUNCTION(ToSymbol)
 {
-	Symbol symbol = SymbolTable_GetSymbol(Smile_SymbolTable, (String)argv[0].obj);
+	Symbol symbol = SymbolTable_GetCollectableSymbol(Smile_SymbolTable, (String)argv[0].obj);
 	return SmileUnboxedSymbol_From(symbol);
 }
 
@@ -503,6 +518,18 @@ SMILE_EXTERNAL_FUNCTION(IsEmpty)
 	return SmileUnboxedBool_From(result);
 }
 
+SMILE_EXTERNAL_FUNCTION(IsAscii)
+{
+	String str = (String)argv[0].obj;
+	return SmileUnboxedBool_From(String_IsAscii(str));
+}
+
+SMILE_EXTERNAL_FUNCTION(IsUtf8)
+{
+	String str = (String)argv[0].obj;
+	return SmileUnboxedBool_From(String_IsValidUtf8(str));
+}
+
 SMILE_EXTERNAL_FUNCTION(IsWhitespace)
 {
 	String str = (String)argv[0].obj;
@@ -794,6 +821,34 @@ Inline String DecodePatternWithoutRegex(SmileArg arg, const char *methodName, co
 	}
 }
 
+/// <summary>
+/// Decode a pattern for a case-insensitive method.  This accepts anything DecodePattern() does,
+/// and also a search already prepared by 'prepare-search~'.
+/// </summary>
+/// <returns>The prepared search for the pattern, or NULL if the pattern is a Regex.</returns>
+static FoldSearch DecodePatternI(SmileArg arg, String *pattern, Regex *regexPattern, const char *methodName, const char *paramName)
+{
+	FoldSearch search;
+
+	if (SMILE_KIND(arg.obj) == SMILE_KIND_HANDLE && ((SmileHandle)arg.obj)->handleKind == Smile_KnownSymbols.FoldSearch_) {
+		search = (FoldSearch)((SmileHandle)arg.obj)->ptr;
+		*pattern = search->pattern;
+		*regexPattern = NULL;
+		return search;
+	}
+
+	DecodePattern(arg, pattern, regexPattern, methodName, paramName);
+
+	return *pattern != NULL ? FoldSearch_Create(*pattern) : NULL;
+}
+
+SMILE_EXTERNAL_FUNCTION(PrepareSearchI)
+{
+	FoldSearch search = FoldSearch_Create((String)argv[0].obj);
+
+	return SmileArg_From((SmileObject)SmileHandle_Create((SmileObject)Smile_KnownBases.Handle, NULL, Smile_KnownSymbols.FoldSearch_, search));
+}
+
 SMILE_EXTERNAL_FUNCTION(StartsWith)
 {
 	String str = (String)argv[0].obj;
@@ -819,12 +874,13 @@ SMILE_EXTERNAL_FUNCTION(StartsWithI)
 	String str = (String)argv[0].obj;
 	String pattern;
 	Regex regexPattern;
+	FoldSearch search;
 	Bool result;
 
-	DecodePattern(argv[1], &pattern, &regexPattern, "starts-with~", "pattern");
+	search = DecodePatternI(argv[1], &pattern, &regexPattern, "starts-with~", "pattern");
 
-	if (pattern != NULL) {
-		result = String_StartsWithI(str, pattern);
+	if (search != NULL) {
+		result = FoldSearch_MatchesAt(search, str, 0);
 	}
 	else if (regexPattern != NULL) {
 		result = Regex_Test(Regex_AsCaseInsensitive(Regex_WithStartAnchor(regexPattern)), str, 0);
@@ -859,12 +915,13 @@ SMILE_EXTERNAL_FUNCTION(EndsWithI)
 	String str = (String)argv[0].obj;
 	String pattern;
 	Regex regexPattern;
+	FoldSearch search;
 	Bool result;
 
-	DecodePattern(argv[1], &pattern, &regexPattern, "ends-with~", "pattern");
+	search = DecodePatternI(argv[1], &pattern, &regexPattern, "ends-with~", "pattern");
 
-	if (pattern != NULL) {
-		result = String_EndsWithI(str, pattern);
+	if (search != NULL) {
+		result = FoldSearch_MatchesAt(search, str, String_Length(str) - search->length);
 	}
 	else if (regexPattern != NULL) {
 		result = Regex_Test(Regex_AsCaseInsensitive(Regex_WithEndAnchor(regexPattern)), str, 0);
@@ -899,12 +956,13 @@ SMILE_EXTERNAL_FUNCTION(ContainsI)
 	String str = (String)argv[0].obj;
 	String pattern;
 	Regex regexPattern;
+	FoldSearch search;
 	Bool result;
 
-	DecodePattern(argv[1], &pattern, &regexPattern, "contains~", "pattern");
+	search = DecodePatternI(argv[1], &pattern, &regexPattern, "contains~", "pattern");
 
-	if (pattern != NULL) {
-		result = String_ContainsI(str, pattern);
+	if (search != NULL) {
+		result = FoldSearch_Find(search, str, 0) >= 0;
 	}
 	else if (regexPattern != NULL) {
 		result = Regex_Test(Regex_AsCaseInsensitive(regexPattern), str, 0);
@@ -947,18 +1005,19 @@ SMILE_EXTERNAL_FUNCTION(IndexOfI)
 	String str = (String)argv[0].obj;
 	String pattern = NULL;
 	Regex regexPattern = NULL;
+	FoldSearch search;
 
 	Int64 startIndex = argc > 2 ? argv[2].unboxed.i64 : 0;
 	Int stringLength = String_Length(str);
 	Int result;
 
-	DecodePattern(argv[1], &pattern, &regexPattern, "index-of~", "pattern");
+	search = DecodePatternI(argv[1], &pattern, &regexPattern, "index-of~", "pattern");
 
 	if (startIndex < 0 || startIndex >= stringLength)
 		return SmileArg_From(NullObject);
 
-	if (pattern != NULL) {
-		result = String_IndexOfI(str, pattern, (Int)startIndex);
+	if (search != NULL) {
+		result = FoldSearch_Find(search, str, (Int)startIndex);
 		if (result < 0) return SmileArg_From(NullObject);
 	}
 	else {
@@ -990,15 +1049,20 @@ SMILE_EXTERNAL_FUNCTION(LastIndexOf)
 SMILE_EXTERNAL_FUNCTION(LastIndexOfI)
 {
 	String str = (String)argv[0].obj;
-	String pattern;
+	FoldSearch search;
 
 	Int64 startIndex = argc > 2 ? argv[2].unboxed.i64 : String_Length(str) - 1;
 	Int stringLength = String_Length(str);
 	Int result;
 
-	pattern = DecodePatternWithoutRegex(argv[1], "last-index-of~", "pattern");
+	if (SMILE_KIND(argv[1].obj) == SMILE_KIND_HANDLE && ((SmileHandle)argv[1].obj)->handleKind == Smile_KnownSymbols.FoldSearch_)
+		search = (FoldSearch)((SmileHandle)argv[1].obj)->ptr;
+	else
+		search = FoldSearch_Create(DecodePatternWithoutRegex(argv[1], "last-index-of~", "pattern"));
 
-	result = startIndex < stringLength ? String_LastIndexOfI(str, pattern, (Int)startIndex) : -1;
+	// This matches String_LastIndexOfI(), which treats 'startIndex' as the end of the last possible match.
+	result = startIndex < stringLength && startIndex >= search->length
+		? FoldSearch_FindLast(search, str, (Int)startIndex - search->length) : -1;
 	if (result < 0) return SmileArg_From(NullObject);
 
 	return SmileUnboxedInteger64_From(result);
@@ -1034,18 +1098,19 @@ SMILE_EXTERNAL_FUNCTION(CountOfI)
 	String str = (String)argv[0].obj;
 	String pattern = NULL;
 	Regex regexPattern = NULL;
+	FoldSearch search;
 
 	Int64 startIndex = argc > 2 ? argv[2].unboxed.i64 : 0;
 	Int stringLength = String_Length(str);
 	Int result;
 
-	DecodePattern(argv[1], &pattern, &regexPattern, "count-of~", "pattern");
+	search = DecodePatternI(argv[1], &pattern, &regexPattern, "count-of~", "pattern");
 
 	if (startIndex < 0 || startIndex >= stringLength)
 		return SmileArg_From(NullObject);
 
-	if (pattern != NULL) {
-		result = String_CountOf(str, pattern, (Int)startIndex);
+	if (search != NULL) {
+		result = FoldSearch_CountOf(search, str, (Int)startIndex);
 	}
 	else {
 		result = Regex_Count(Regex_AsCaseInsensitive(regexPattern), str, (Int)startIndex, 0);
@@ -1122,9 +1187,10 @@ SMILE_EXTERNAL_FUNCTION(ReplaceI)
 	String str = (String)argv[0].obj;
 	String pattern, replacement;
 	Regex regexPattern;
+	FoldSearch search;
 	STATIC_STRING(i, "i");
 
-	DecodePattern(argv[1], &pattern, &regexPattern, "replace~", "pattern");
+	search = DecodePatternI(argv[1], &pattern, &regexPattern, "replace~", "pattern");
 
 	if (SMILE_KIND(argv[2].obj) == SMILE_KIND_FUNCTION) {
 		Int64 limit;
@@ -1142,15 +1208,15 @@ SMILE_EXTERNAL_FUNCTION(ReplaceI)
 
 	replacement = DecodePatternWithoutRegex(argv[2], "replace~", "replacement");
 
-	if (pattern != NULL) {
+	if (search != NULL) {
 		if (argc > 3) {
 			Int64 limit = argv[3].unboxed.i64;
 			if (limit < 0) limit = 0;
 			if (limit > String_Length(str)) limit = String_Length(str);
-			str = String_ReplaceWithLimitI(str, pattern, replacement, (Int)limit);
+			str = FoldSearch_Replace(search, str, replacement, (Int)limit);
 		}
 		else {
-			str = String_ReplaceI(str, pattern, replacement);
+			str = FoldSearch_Replace(search, str, replacement, -1);
 		}
 	}
 	else if (regexPattern != NULL) {
@@ -1261,7 +1327,7 @@ SMILE_EXTERNAL_FUNCTION(UniAt)
 
 	src = text + (Int)index;
 
-	value = String_ExtractUnicodeCharacterInternal(&src, src + length);
+	value = String_ExtractUnicodeCharacterInternal(&src, text + length);
 	if (value < 0) value = 0xFFFD;
 	return SmileUnboxedUni_From(value);
 }
@@ -1281,7 +1347,7 @@ SMILE_EXTERNAL_FUNCTION(UniLengthAt)
 
 	start = src = text + (Int)index;
 
-	String_ExtractUnicodeCharacterInternal(&src, src + length);
+	String_ExtractUnicodeCharacterInternal(&src, text + length);
 	return SmileUnboxedInteger64_From(src - start);
 }
 
@@ -1298,10 +1364,75 @@ SMILE_EXTERNAL_FUNCTION(UniNext)
 
 	src = text + (Int)index;
 
-	String_ExtractUnicodeCharacterInternal(&src, src + length);
+	String_ExtractUnicodeCharacterInternal(&src, text + length);
 	return SmileUnboxedInteger64_From(src < text + length ? src - text : -1);
 }
 
+SMILE_EXTERNAL_FUNCTION(UniCount)
+{
+	String str = (String)argv[0].obj;
+	Int length = String_Length(str);
+
+	if (String_IsAscii(str))
+		return SmileUnboxedInteger64_From(length);
+	if (length >= UNI_INDEX_MIN_LENGTH)
+		return SmileUnboxedInteger64_From(Utf8Index_Get(str)->numCodePoints);
+
+	return SmileUnboxedInteger64_From(Utf8_CountCodePoints(String_GetBytes(str), length));
+}
+
+SMILE_EXTERNAL_FUNCTION(UniOffset)
+{
+	String str = (String)argv[0].obj;
+	Int64 index = argv[1].unboxed.i64;
+	Int length = String_Length(str);
+	Int offset;
+
+	STATIC_STRING(indexOutOfRangeError, "Index to 'uni-offset' is beyond the number of code points in the string.");
+
+	if (index < 0 || index > length)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, indexOutOfRangeError);
+
+	if (String_IsAscii(str))
+		offset = (Int)index;
+	else if (length >= UNI_INDEX_MIN_LENGTH)
+		offset = Utf8Index_GetByteOffset(Utf8Index_Get(str), (Int)index);
+	else
+		offset = Utf8_SkipCodePoints(String_GetBytes(str), length, 0, (Int)index);
+
+	if (offset < 0)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, indexOutOfRangeError);
+
+	return SmileUnboxedInteger64_From(offset);
+}
+
+SMILE_EXTERNAL_FUNCTION(UniIndex)
+{
+	String str = (String)argv[0].obj;
+	Int64 offset = argv[1].unboxed.i64;
+	Int length = String_Length(str);
+	Int index;
+
+	STATIC_STRING(offsetOutOfRangeError, "Offset to 'uni-index' is beyond the length of the string.");
+
+	if (offset < 0 || offset > length)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, offsetOutOfRangeError);
+
+	if (String_IsAscii(str))
+		index = (Int)offset;
+	else if (length >= UNI_INDEX_MIN_LENGTH)
+		index = Utf8Index_GetCodePointIndex(Utf8Index_Get(str), (Int)offset);
+	else if (offset == length)
+		index = Utf8_CountCodePoints(String_GetBytes(str), length);
+	else {
+		// The code point containing the byte is the last one that starts at or before it.
+		index = Utf8_CountCodePoints(String_GetBytes(str), (Int)offset + 1) - 1;
+		if (index < 0) index = 0;
+	}
+
+	return SmileUnboxedInteger64_From(index);
+}
+
 SMILE_EXTERNAL_FUNCTION(Substr)
 {
 	STATIC_STRING(indexTypeError, "Index to 'substr' must be an Integer or an IntegerRange.");
@@ -1392,6 +1523,13 @@ SMILE_EXTERNAL_FUNCTION(Chop)
 	return SmileArg_From((SmileObject)str);
 }
 
+SMILE_EXTERNAL_FUNCTION(Compact)
+{
+	// Large substrings share their parent's text; this makes an independent copy, so that a
+	// small piece of a large string can be kept without keeping the whole string alive.
+	return SmileArg_From((SmileObject)String_Compact((String)argv[0].obj));
+}
+
 SMILE_EXTERNAL_FUNCTION(ReplaceNewlines)
 {
 	String str = (String)argv[0].obj;
@@ -1449,6 +1587,101 @@ UnaryProxyFunction(RegexEscape, String_RegexEscape)
 
 UnaryProxyFunction(ByteArray, String_ToByteArray)
 
+SMILE_EXTERNAL_FUNCTION(EncodeCodePage)
+{
+	struct CodePageStruct codePage;
+
+	if (!CodePage_GetByName(&codePage, (String)argv[1].obj))
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_Format("Unknown code page \"%S\" passed to 'String.encode-code-page'.", (String)argv[1].obj));
+
+	return SmileArg_From((SmileObject)String_ToByteArray(String_ConvertUtf8ToKnownCodePage((String)argv[0].obj, codePage.id)));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+static struct {
+	Symbol urlSafe;
+	Symbol wrapLines;
+	Symbol noPadding;
+	Symbol lowercase;
+} _codecSymbols;
+
+// The 'lowercase option of hex-encode, which sits above the BASE64_* flags so they can share a parser.
+#define LOWERCASE_OPTION (1 << 8)
+
+/// <summary>
+/// Collect the option symbols passed to a base-64 or hex method (after the string itself)
+/// into a set of flags, complaining about any that the method doesn't know.
+/// </summary>
+static Int GetCodecOptions(Int argc, SmileArg *argv, Int allowedFlags, const char *methodName)
+{
+	Int flags = 0, flag, i;
+	Symbol symbol;
+
+	for (i = 1; i < argc; i++) {
+		symbol = argv[i].unboxed.symbol;
+		if (symbol == _codecSymbols.urlSafe)
+			flag = BASE64_URL_SAFE;
+		else if (symbol == _codecSymbols.wrapLines)
+			flag = BASE64_WRAP_LINES;
+		else if (symbol == _codecSymbols.noPadding)
+			flag = BASE64_NO_PADDING;
+		else if (symbol == _codecSymbols.lowercase)
+			flag = LOWERCASE_OPTION;
+		else flag = 0;
+
+		if (!(flag & allowedFlags)) {
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_Format("%s: Unknown option \"%S\"", methodName, SymbolTable_GetName(Smile_SymbolTable, symbol)));
+		}
+		flags |= flag;
+	}
+
+	return flags;
+}
+
+SMILE_EXTERNAL_FUNCTION(ToBase64)
+{
+	String str = (String)argv[0].obj;
+	Int flags = GetCodecOptions(argc, argv, BASE64_URL_SAFE | BASE64_WRAP_LINES | BASE64_NO_PADDING, "base64-encode");
+
+	return SmileArg_From((SmileObject)Base64Encode(String_GetBytes(str), String_Length(str), flags));
+}
+
+SMILE_EXTERNAL_FUNCTION(FromBase64)
+{
+	String str = (String)argv[0].obj;
+	Int flags = GetCodecOptions(argc, argv, BASE64_URL_SAFE, "base64-decode");
+	Byte *result;
+	Int length;
+
+	if ((result = Base64Decode(String_GetBytes(str), String_Length(str), flags, &length)) == NULL)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FromC("Invalid base-64 text passed to 'String.base64-decode'."));
+
+	return SmileArg_From((SmileObject)SmileByteArray_CreateInternal((SmileObject)Smile_KnownBases.ByteArray, result, length, True));
+}
+
+SMILE_EXTERNAL_FUNCTION(ToHex)
+{
+	String str = (String)argv[0].obj;
+	Int flags = GetCodecOptions(argc, argv, LOWERCASE_OPTION, "hex-encode");
+
+	return SmileArg_From((SmileObject)HexEncode(String_GetBytes(str), String_Length(str), (flags & LOWERCASE_OPTION) != 0));
+}
+
+SMILE_EXTERNAL_FUNCTION(FromHex)
+{
+	String str = (String)argv[0].obj;
+	Byte *result;
+	Int length;
+
+	if ((result = HexDecode(String_GetBytes(str), String_Length(str), &length)) == NULL)
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FromC("Invalid hex text passed to 'String.hex-decode'."));
+
+	return SmileArg_From((SmileObject)SmileByteArray_CreateInternal((SmileObject)Smile_KnownBases.ByteArray, result, length, True));
+}
+
 //-------------------------------------------------------------------------------------------------
 
 SMILE_EXTERNAL_FUNCTION(CamelCase)
@@ -2015,6 +2248,11 @@ void String_Setup(SmileUserObject base)
 	_wildcardMatchingSymbols.caseSensitive = SymbolTable_GetSymbolC(Smile_SymbolTable, "case-sensitive");
 	_wildcardMatchingSymbols.filenameMode = SymbolTable_GetSymbolC(Smile_SymbolTable, "filename-mode");
 
+	_codecSymbols.urlSafe = SymbolTable_GetSymbolC(Smile_SymbolTable, "url-safe");
+	_codecSymbols.wrapLines = SymbolTable_GetSymbolC(Smile_SymbolTable, "wrap-lines");
+	_codecSymbols.noPadding = SymbolTable_GetSymbolC(Smile_SymbolTable, "no-padding");
+	_codecSymbols.lowercase = SymbolTable_GetSymbolC(Smile_SymbolTable, "lowercase");
+
 	SetupFunction("bool", ToBool, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
 	SetupFunction("int", ToInt, NULL, "value", ARG_CHECK_EXACT, 1, 1, 0, NULL);
 	SetupFunction("string", ToString, NULL, "value", ARG_CHECK_MIN | ARG_CHECK_MAX, 1, 2, 0, NULL);
@@ -2036,13 +2274,14 @@ void String_Setup(SmileUserObject base)
 	SetupFunction("right", Right, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringNumberChecks);
 	SetupFunction("chip", Chip, NULL, "str count", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _stringNumberChecks);
 	SetupFunction("chop", Chop, NULL, "str count", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _stringNumberChecks);
-
-	SetupFunction("starts-with?", StartsWith, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
-	SetupFunction("starts-with~?", StartsWithI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
-	SetupFunction("ends-with?", EndsWith, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
-	SetupFunction("ends-with~?", EndsWithI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
-	SetupFunction("contains?", Contains, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
-	SetupFunction("contains~?", ContainsI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
+	SetupFunction("compact", Compact, NULL, "str", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
+
+	SetupFunction("starts-with?", StartsWith, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("starts-with~?", StartsWithI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("ends-with?", EndsWith, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("ends-with~?", EndsWithI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("contains?", Contains, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
+	SetupFunction("contains~?", ContainsI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _indexOfChecks);
 	SetupFunction("index-of", IndexOf, NULL, "str pattern", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 2, 3, 3, _indexOfChecks);
 	SetupFunction("index-of~", IndexOfI, NULL, "str pattern", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 2, 3, 3, _indexOfChecks);
 	SetupFunction("last-index-of", LastIndexOf, NULL, "str pattern", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 2, 3, 3, _indexOfChecks);
@@ -2050,6 +2289,8 @@ void String_Setup(SmileUserObject base)
 	SetupFunction("count-of", CountOf, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
 	SetupFunction("count-of~", CountOfI, NULL, "str pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _indexOfChecks);
 
+	SetupFunction("prepare-search~", PrepareSearchI, NULL, "pattern", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+
 	SetupFunction("split", Split, NULL, "str pattern limit", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 2, 3, 3, _indexOfChecks);
 
 	SetupFunction("replace", Replace, NULL, "str pattern replacement", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 3, 3, 3, _stringReplaceChecks);
@@ -2090,20 +2331,22 @@ void String_Setup(SmileUserObject base)
 	SetupFunction("hyphenize", Hyphenize, (void *)'-', "string", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hyphenizeChecks);
 	SetupFunction("underscorize", Hyphenize, (void *)'_', "string", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _hyphenizeChecks);
 
-	SetupFunction("empty?", IsEmpty, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("whitespace?", IsWhitespace, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("alpha?", IsAlpha, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("lowercase?", IsLowercase, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("uppercase?", IsUppercase, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("alnum?", IsAlnum, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("digits?", IsDigits, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("hex?", IsHex, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("octal?", IsOctal, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-
-	SetupFunction("c-ident?", IsCIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("ident?", IsIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("alpha-ident?", IsAlphaIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
-	SetupFunction("punct-ident?", IsPunctIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
+	SetupFunction("empty?", IsEmpty, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("ascii?", IsAscii, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("utf8?", IsUtf8, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("whitespace?", IsWhitespace, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("alpha?", IsAlpha, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("lowercase?", IsLowercase, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("uppercase?", IsUppercase, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("alnum?", IsAlnum, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("digits?", IsDigits, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("hex?", IsHex, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("octal?", IsOctal, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+
+	SetupFunction("c-ident?", IsCIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("ident?", IsIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("alpha-ident?", IsAlphaIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("punct-ident?", IsPunctIdent, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
 
 	SetupFunction("rot13", Rot13, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
 	SetupFunction("add-c-slashes", AddCSlashes, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
@@ -2113,32 +2356,39 @@ void String_Setup(SmileUserObject base)
 	SetupFunction("url-encode", UrlEncode, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
 	SetupFunction("url-query-encode", UrlQueryEncode, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
 	SetupFunction("url-decode", UrlDecode, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
+	SetupFunction("base64-encode", ToBase64, NULL, "string options", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 4, 4, _codecChecks);
+	SetupFunction("base64-decode", FromBase64, NULL, "string options", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _codecChecks);
+	SetupFunction("hex-encode", ToHex, NULL, "string options", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _codecChecks);
+	SetupFunction("hex-decode", FromHex, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _codecChecks);
 	SetupFunction("regex-escape", RegexEscape, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
 	SetupFunction("newlines-to-breaks", NewlinesToBreaks, NULL, "string break", ARG_CHECK_MIN | ARG_CHECK_MAX | ARG_CHECK_TYPES, 1, 2, 2, _stringChecks);
 
-	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringComparisonChecks);
-	SetupFunction("==~", EqI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringComparisonChecks);
-	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringComparisonChecks);
-	SetupFunction("!=~", NeI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringComparisonChecks);
-	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction("<~", LtI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction(">~", GtI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction("<=~", LeI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-	SetupFunction(">=~", GeI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
-
-	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
+	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringComparisonChecks);
+	SetupFunction("==~", EqI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringComparisonChecks);
+	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringComparisonChecks);
+	SetupFunction("!=~", NeI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringComparisonChecks);
+	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction("<~", LtI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction(">~", GtI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction("<=~", LeI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+	SetupFunction(">=~", GeI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
+
+	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
 	SetupSynonym("compare", "cmp");
-	SetupFunction("compare~", CompareI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
+	SetupFunction("compare~", CompareI, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringChecks);
 	SetupSynonym("compare~", "cmp~");
 
-	SetupFunction("get-member", GetMember, NULL, "str index", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringComparisonChecks);
+	SetupFunction("get-member", GetMember, NULL, "str index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringComparisonChecks);
 	SetupSynonym("get-member", "at");
 	SetupFunction("uni-at", UniAt, NULL, "str index", ARG_CHECK_MIN | ARG_CHECK_TYPES, 2, 2, 2, _stringNumberChecks);
 	SetupFunction("uni-length-at", UniLengthAt, NULL, "str index", ARG_CHECK_MIN | ARG_CHECK_TYPES, 2, 2, 2, _stringNumberChecks);
 	SetupFunction("uni-next", UniNext, NULL, "str index", ARG_CHECK_MIN | ARG_CHECK_TYPES, 2, 2, 2, _stringNumberChecks);
+	SetupFunction("uni-count", UniCount, NULL, "str", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _stringChecks);
+	SetupFunction("uni-offset", UniOffset, NULL, "str index", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringNumberChecks);
+	SetupFunction("uni-index", UniIndex, NULL, "str offset", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _stringNumberChecks);
 
 	SetupFunction("each", Each, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
 	SetupFunction("map", Map, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_STATE_MACHINE, 2, 2, 2, _eachChecks);
@@ -2146,6 +2396,7 @@ void String_Setup(SmileUserObject base)
 	SetupFunction("count", Count, NULL, "string", ARG_STATE_MACHINE, 0, 0, 0, NULL);
 
 	SetupFunction("byte-array", ByteArray, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
+	SetupFunction("encode-code-page", EncodeCodePage, NULL, "string code-page", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _stringChecks);
 
 	SetupFunction("split-command-line", SplitCommandLine, NULL, "string", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _stringChecks);
 	SetupFunction("wildcard-matches?", WildcardMatches, NULL, "string", ARG_CHECK_MIN | ARG_CHECK_TYPES, 2, 2, 3, _wildcardChecks);
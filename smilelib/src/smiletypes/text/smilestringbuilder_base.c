@@ -0,0 +1,496 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/gc.h>
+#include <smile/string.h>
+#include <smile/smiletypes/base.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilehandle.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/text/smilesymbol.h>
+#include <smile/internal/staticstring.h>
+
+SMILE_IGNORE_UNUSED_VARIABLES
+
+/// <summary>
+/// The private data behind a script-visible StringBuilder.
+///
+/// The text is accumulated directly inside a String-shaped buffer, so that 'to-string' can
+/// usually hand that buffer out as the resulting String without copying it.  Once it has been
+/// handed out, the buffer is marked as shared, and the next change to the builder copies the
+/// text into a fresh buffer first (copy-on-write), so the String that was handed out never changes.
+/// </summary>
+typedef struct StringBuilderDataStruct {
+	String buffer;		// The buffer, whose capacity is its String length (or NULL if nothing is allocated).
+	Int length;			// How many bytes of the buffer are in use.
+	Int capacity;		// How many bytes the buffer can hold.
+	Bool shared;		// Whether the buffer has been handed out as a String, and must not be modified.
+} *StringBuilderData;
+
+// The smallest buffer a builder allocates.
+#define MIN_CAPACITY 64
+
+static Byte _handleChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_HANDLE,
+};
+
+static Byte _appendChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_HANDLE,
+	0, 0,
+};
+
+static Byte _formatChecks[] = {
+	SMILE_KIND_MASK, SMILE_KIND_HANDLE,
+	SMILE_KIND_MASK, SMILE_KIND_STRING,
+	0, 0,
+};
+
+STATIC_STRING(_handleException, "First argument to 'StringBuilder.%s' must be a StringBuilder handle, not a '%S' handle.");
+STATIC_STRING(_formatCodeException, "Unknown format code '%%%c' passed to 'StringBuilder.append-format'.");
+STATIC_STRING(_formatCountException, "Format string passed to 'StringBuilder.append-format' needs more than the %d arguments given.");
+STATIC_STRING(_formatArgException, "Format code '%%%c' passed to 'StringBuilder.append-format' requires an integer argument.");
+
+//-------------------------------------------------------------------------------------------------
+// Buffer management
+
+/// <summary>
+/// Make sure the builder has room for at least 'extra' more bytes, in a buffer it owns.
+/// </summary>
+static Byte *Reserve(StringBuilderData data, Int extra)
+{
+	Int needed = data->length + extra;
+	Int newCapacity;
+	String newBuffer;
+
+	if (needed <= data->capacity && !data->shared)
+		return data->buffer->_opaque.text + data->length;
+
+	newCapacity = data->capacity < MIN_CAPACITY ? MIN_CAPACITY : data->capacity;
+	while (newCapacity < needed)
+		newCapacity *= 2;
+
+	newBuffer = String_CreateInternal(newCapacity);
+	if (data->length > 0)
+		MemCpy(newBuffer->_opaque.text, data->buffer->_opaque.text, data->length);
+
+	data->buffer = newBuffer;
+	data->capacity = newCapacity;
+	data->shared = False;
+
+	return newBuffer->_opaque.text + data->length;
+}
+
+Inline void AppendBytes(StringBuilderData data, const Byte *text, Int length)
+{
+	if (length <= 0) return;
+	MemCpy(Reserve(data, length), text, length);
+	data->length += length;
+}
+
+static void AppendUnicode(StringBuilderData data, UInt32 value)
+{
+	Byte *dest;
+
+	if (value < 0x80) {
+		dest = Reserve(data, 1);
+		dest[0] = (Byte)value;
+		data->length += 1;
+	}
+	else if (value < 0x800) {
+		dest = Reserve(data, 2);
+		dest[0] = (Byte)((value >> 6) | 0xC0);
+		dest[1] = (Byte)((value & 0x3F) | 0x80);
+		data->length += 2;
+	}
+	else if (value < 0x10000) {
+		dest = Reserve(data, 3);
+		dest[0] = (Byte)((value >> 12) | 0xE0);
+		dest[1] = (Byte)(((value >> 6) & 0x3F) | 0x80);
+		dest[2] = (Byte)((value & 0x3F) | 0x80);
+		data->length += 3;
+	}
+	else if (value < 0x110000) {
+		dest = Reserve(data, 4);
+		dest[0] = (Byte)((value >> 18) | 0xF0);
+		dest[1] = (Byte)(((value >> 12) & 0x3F) | 0x80);
+		dest[2] = (Byte)(((value >> 6) & 0x3F) | 0x80);
+		dest[3] = (Byte)((value & 0x3F) | 0x80);
+		data->length += 4;
+	}
+	else {
+		AppendUnicode(data, 0xFFFD);
+	}
+}
+
+/// <summary>
+/// Append any value to the builder, stringified the same way 'List.join' stringifies it:
+/// Strings are appended as-is, null appends nothing, and anything else is converted by
+/// its 'string' method.  Chars and Unis are appended directly, without allocating a String
+/// for them, and another StringBuilder appends its current content.
+/// </summary>
+static void AppendValue(StringBuilderData data, SmileArg arg)
+{
+	String piece;
+	SmileHandle handle;
+	StringBuilderData other;
+
+	switch (SMILE_KIND(arg.obj)) {
+		case SMILE_KIND_STRING:
+			piece = (String)arg.obj;
+			AppendBytes(data, String_GetBytes(piece), String_Length(piece));
+			return;
+
+		case SMILE_KIND_NULL:
+			return;
+
+		case SMILE_KIND_UNBOXED_CHAR:
+			*Reserve(data, 1) = arg.unboxed.ch;
+			data->length++;
+			return;
+
+		case SMILE_KIND_UNBOXED_UNI:
+			AppendUnicode(data, arg.unboxed.uni);
+			return;
+
+		case SMILE_KIND_HANDLE:
+			handle = (SmileHandle)arg.obj;
+			if (handle->handleKind == Smile_KnownSymbols.StringBuilder_) {
+				other = (StringBuilderData)handle->ptr;
+				if (other->length > 0) {
+					// Reserve first, since the other builder might be this same builder.
+					Reserve(data, other->length);
+					AppendBytes(data, other->buffer->_opaque.text, other->length);
+				}
+				return;
+			}
+			break;
+	}
+
+	piece = SMILE_VCALL1(arg.obj, toString, arg.unboxed);
+	AppendBytes(data, String_GetBytes(piece), String_Length(piece));
+}
+
+/// <summary>
+/// Get the builder's content as a String.  If most of the buffer is in use, the buffer itself
+/// becomes the String, and the builder will copy it before its next change; otherwise, the
+/// content is copied out, so that a short String doesn't pin down a much larger buffer.
+/// </summary>
+static String GetContent(StringBuilderData data)
+{
+	String result;
+
+	if (data->length <= 0)
+		return String_Empty;
+
+	if (data->length * 2 < data->capacity)
+		return String_Create(data->buffer->_opaque.text, data->length);
+
+	result = data->buffer;
+	result->_opaque.length = data->length;
+	result->_opaque.text[data->length] = '\0';
+	data->shared = True;
+	return result;
+}
+
+static StringBuilderData GetData(SmileArg arg, const char *methodName)
+{
+	SmileHandle handle = (SmileHandle)arg.obj;
+
+	if (handle->handleKind != Smile_KnownSymbols.StringBuilder_) {
+		Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+			String_FormatString(_handleException, methodName,
+				SymbolTable_GetName(Smile_SymbolTable, handle->handleKind)));
+	}
+
+	return (StringBuilderData)handle->ptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Virtual method overrides
+
+static Bool StringBuilder_ToBool(SmileHandle handle, SmileUnboxedData unboxedData)
+{
+	return ((StringBuilderData)handle->ptr)->length > 0;
+}
+
+static String StringBuilder_ToStringWrapper(SmileHandle handle, SmileUnboxedData unboxedData)
+{
+	return GetContent((StringBuilderData)handle->ptr);
+}
+
+static struct SmileHandleMethodsStruct StringBuilderMethods = {
+	.toBool = StringBuilder_ToBool,
+	.toString = StringBuilder_ToStringWrapper,
+};
+
+//-------------------------------------------------------------------------------------------------
+// Construction
+
+SMILE_EXTERNAL_FUNCTION(Of)
+{
+	StringBuilderData data;
+	SmileHandle handle;
+	Int argi;
+
+	data = GC_MALLOC_STRUCT(struct StringBuilderDataStruct);
+	if (data == NULL) Smile_Abort_OutOfMemory();
+	data->buffer = NULL;
+	data->length = 0;
+	data->capacity = 0;
+	data->shared = False;
+
+	argi = 0;
+	if (argi < argc && argv[argi].obj == param)
+		argi++;
+	for (; argi < argc; argi++)
+		AppendValue(data, argv[argi]);
+
+	handle = SmileHandle_Create((SmileObject)Smile_KnownBases.StringBuilder, &StringBuilderMethods, Smile_KnownSymbols.StringBuilder_, data);
+	return SmileArg_From((SmileObject)handle);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Generic type conversion
+
+SMILE_EXTERNAL_FUNCTION(ToBool)
+{
+	SmileHandle handle;
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_HANDLE) {
+		handle = (SmileHandle)argv[0].obj;
+		if (handle->handleKind == Smile_KnownSymbols.StringBuilder_)
+			return SmileUnboxedBool_From(((StringBuilderData)handle->ptr)->length > 0);
+	}
+
+	return SmileUnboxedBool_From(True);
+}
+
+SMILE_EXTERNAL_FUNCTION(ToInt)
+{
+	SmileHandle handle;
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_HANDLE) {
+		handle = (SmileHandle)argv[0].obj;
+		if (handle->handleKind == Smile_KnownSymbols.StringBuilder_)
+			return SmileUnboxedInteger64_From(((StringBuilderData)handle->ptr)->length);
+	}
+
+	return SmileUnboxedInteger64_From(0);
+}
+
+SMILE_EXTERNAL_FUNCTION(ToString)
+{
+	SmileHandle handle;
+	if (SMILE_KIND(argv[0].obj) == SMILE_KIND_HANDLE) {
+		handle = (SmileHandle)argv[0].obj;
+		if (handle->handleKind == Smile_KnownSymbols.StringBuilder_)
+			return SmileArg_From((SmileObject)GetContent((StringBuilderData)handle->ptr));
+	}
+
+	return SmileArg_From((SmileObject)SymbolTable_GetName(Smile_SymbolTable, Smile_KnownSymbols.StringBuilder_));
+}
+
+SMILE_EXTERNAL_FUNCTION(Hash)
+{
+	return SmileUnboxedInteger64_From(Smile_ApplyHashOracle((PtrInt)argv[0].obj));
+}
+
+//-------------------------------------------------------------------------------------------------
+// Building
+
+SMILE_EXTERNAL_FUNCTION(Append)
+{
+	StringBuilderData data = GetData(argv[0], "append");
+	Int i;
+
+	for (i = 1; i < argc; i++)
+		AppendValue(data, argv[i]);
+
+	return argv[0];
+}
+
+SMILE_EXTERNAL_FUNCTION(AppendLine)
+{
+	StringBuilderData data = GetData(argv[0], "append-line");
+	Int i;
+
+	for (i = 1; i < argc; i++)
+		AppendValue(data, argv[i]);
+
+	*Reserve(data, 1) = '\n';
+	data->length++;
+
+	return argv[0];
+}
+
+/// <summary>
+/// Convert an integer argument of 'append-format' to its digits in the given base.
+/// </summary>
+static String FormatInteger(SmileArg arg, Int numericBase, Byte code)
+{
+	Int64 value;
+
+	switch (SMILE_KIND(arg.obj)) {
+		case SMILE_KIND_UNBOXED_BYTE: value = arg.unboxed.i8; break;
+		case SMILE_KIND_UNBOXED_INTEGER16: value = arg.unboxed.i16; break;
+		case SMILE_KIND_UNBOXED_INTEGER32: value = arg.unboxed.i32; break;
+		case SMILE_KIND_UNBOXED_INTEGER64: value = arg.unboxed.i64; break;
+		default:
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error,
+				String_FormatString(_formatArgException, code));
+	}
+
+	return String_CreateFromInteger(value, numericBase, False);
+}
+
+/// <summary>
+/// Append text from a format string, in which "%s" is replaced by the next argument (stringified
+/// just as 'append' stringifies it), "%d", "%x", and "%X" are replaced by the next argument as an
+/// integer in decimal or hexadecimal, and "%%" stands for a literal '%'.  Like the C StringBuilder's
+/// format codes, each may have a width, which pads the value with spaces on the left (or on the right,
+/// if the width is preceded by '-'), or with zeros if the width starts with '0'.
+/// </summary>
+SMILE_EXTERNAL_FUNCTION(AppendFormat)
+{
+	StringBuilderData data = GetData(argv[0], "append-format");
+	String format, piece;
+	const Byte *text, *end, *start;
+	Byte *dest;
+	Int argi, width, length, padding, i;
+	Bool leftJustify, zeroPad;
+	Byte code;
+
+	format = (String)argv[1].obj;
+	text = String_GetBytes(format);
+	end = text + String_Length(format);
+	argi = 2;
+
+	while (text < end) {
+		// Copy the literal text up to the next format code in one piece.
+		for (start = text; text < end && *text != '%'; text++) ;
+		AppendBytes(data, start, text - start);
+		if (text++ >= end) break;
+
+		leftJustify = zeroPad = False;
+		if (text < end && *text == '-') leftJustify = True, text++;
+		if (text < end && *text == '0') zeroPad = !leftJustify, text++;
+		for (width = 0; text < end && *text >= '0' && *text <= '9'; text++) {
+			if (width < 0x10000) width = width * 10 + (*text - '0');
+		}
+
+		if (text >= end)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FromC("Format string passed to 'StringBuilder.append-format' ends in the middle of a format code."));
+		code = *text++;
+
+		if (code == '%') {
+			AppendBytes(data, text - 1, 1);
+			continue;
+		}
+		if (code != 's' && code != 'd' && code != 'x' && code != 'X')
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FormatString(_formatCodeException, code));
+		if (argi >= argc)
+			Smile_ThrowException(Smile_KnownSymbols.native_method_error, String_FormatString(_formatCountException, argc - 2));
+
+		if (code == 's' && width == 0) {
+			AppendValue(data, argv[argi++]);
+			continue;
+		}
+
+		if (code == 's') {
+			piece = SMILE_KIND(argv[argi].obj) == SMILE_KIND_STRING ? (String)argv[argi].obj
+				: SMILE_KIND(argv[argi].obj) == SMILE_KIND_NULL ? String_Empty
+				: SMILE_VCALL1(argv[argi].obj, toString, argv[argi].unboxed);
+			argi++;
+		}
+		else piece = FormatInteger(argv[argi++], code == 'd' ? 10 : 16, code);
+
+		// Widths count characters, not bytes, so skip the UTF-8 continuation bytes when measuring.
+		for (i = 0, length = 0; i < String_Length(piece); i++)
+			length += (String_GetBytes(piece)[i] & 0xC0) != 0x80;
+		padding = width > length ? width - length : 0;
+
+		if (zeroPad && padding > 0 && String_Length(piece) > 0 && String_GetBytes(piece)[0] == '-') {
+			// Zeros go between the sign and the digits.
+			AppendBytes(data, String_GetBytes(piece), 1);
+			piece = String_SubstringAt(piece, 1);
+		}
+		if (!leftJustify && padding > 0) {
+			dest = Reserve(data, padding);
+			MemSet(dest, zeroPad ? '0' : ' ', padding);
+			data->length += padding;
+		}
+		dest = Reserve(data, String_Length(piece));
+		AppendBytes(data, String_GetBytes(piece), String_Length(piece));
+		if (code == 'x') {
+			for (i = 0; i < String_Length(piece); i++)
+				if (dest[i] >= 'A' && dest[i] <= 'F') dest[i] += 'a' - 'A';
+		}
+		if (leftJustify && padding > 0) {
+			dest = Reserve(data, padding);
+			MemSet(dest, ' ', padding);
+			data->length += padding;
+		}
+	}
+
+	return argv[0];
+}
+
+SMILE_EXTERNAL_FUNCTION(Length)
+{
+	StringBuilderData data = GetData(argv[0], "length");
+	return SmileUnboxedInteger64_From(data->length);
+}
+
+SMILE_EXTERNAL_FUNCTION(Clear)
+{
+	StringBuilderData data = GetData(argv[0], "clear");
+
+	// A shared buffer belongs to the String that was handed out, so start over with a new one.
+	if (data->shared) {
+		data->buffer = NULL;
+		data->capacity = 0;
+		data->shared = False;
+	}
+	data->length = 0;
+
+	return argv[0];
+}
+
+SMILE_EXTERNAL_FUNCTION(GetString)
+{
+	StringBuilderData data = GetData(argv[0], "to-string");
+	return SmileArg_From((SmileObject)GetContent(data));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SmileStringBuilder_Setup(SmileUserObject base)
+{
+	SetupFunction("of", Of, base, "values", 0, 0, 0, 0, NULL);
+
+	SetupFunction("bool", ToBool, NULL, "builder", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("int", ToInt, NULL, "builder", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("string", ToString, NULL, "builder", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+	SetupFunction("hash", Hash, NULL, "builder", ARG_CHECK_EXACT, 1, 1, 0, NULL);
+
+	SetupFunction("append", Append, NULL, "builder values", ARG_CHECK_MIN | ARG_CHECK_TYPES, 1, 1, 2, _appendChecks);
+	SetupFunction("append-line", AppendLine, NULL, "builder values", ARG_CHECK_MIN | ARG_CHECK_TYPES, 1, 1, 2, _appendChecks);
+	SetupFunction("append-format", AppendFormat, NULL, "builder format args", ARG_CHECK_MIN | ARG_CHECK_TYPES, 2, 2, 3, _formatChecks);
+	SetupFunction("length", Length, NULL, "builder", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+	SetupFunction("clear", Clear, NULL, "builder", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+	SetupFunction("to-string", GetString, NULL, "builder", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _handleChecks);
+}
@@ -440,54 +440,54 @@ void SmileUni_Setup(SmileUserObject base)
 	SetupFunction("string", ToString, NULL, "uni", ARG_CHECK_EXACT, 1, 1, 0, NULL);
 	SetupFunction("hash", Hash, NULL, "uni", ARG_CHECK_EXACT, 1, 1, 0, NULL);
 
-	SetupFunction("int64", ToInt64, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("int32", ToInt32, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("int16", ToInt16, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("byte", ToByte, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("int64", ToInt64, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("int32", ToInt32, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("int16", ToInt16, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("byte", ToByte, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 
-	SetupFunction("char", ToChar, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("uni", ToUni, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("char", ToChar, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("uni", ToUni, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 
-	SetupFunction("+", Plus, NULL, "uni other", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniComparisonChecks);
-	SetupFunction("-", Minus, NULL, "uni other", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniComparisonChecks);
+	SetupFunction("+", Plus, NULL, "uni other", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniComparisonChecks);
+	SetupFunction("-", Minus, NULL, "uni other", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniComparisonChecks);
 
-	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniComparisonChecks);
-	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniComparisonChecks);
-	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniChecks);
-	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniChecks);
-	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniChecks);
-	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniChecks);
+	SetupFunction("==", Eq, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniComparisonChecks);
+	SetupFunction("!=", Ne, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniComparisonChecks);
+	SetupFunction("<", Lt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniChecks);
+	SetupFunction(">", Gt, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniChecks);
+	SetupFunction("<=", Le, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniChecks);
+	SetupFunction(">=", Ge, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniChecks);
 
-	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniChecks);
+	SetupFunction("compare", Compare, NULL, "x y", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniChecks);
 	SetupSynonym("compare", "cmp");
 
-	SetupFunction("category", Category, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("category", Category, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 
-	SetupFunction("lowercase", Lowercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("uppercase", Uppercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("titlecase", Titlecase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("case-fold", CaseFold, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("lowercase", Lowercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("uppercase", Uppercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("titlecase", Titlecase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("case-fold", CaseFold, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 	SetupSynonym("case-fold", "fold");
 
-	SetupFunction("letter?", IsLetter, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("cased-letter?", IsCasedLetter, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("letter?", IsLetter, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("cased-letter?", IsCasedLetter, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 	SetupSynonym("cased-letter?", "alpha?");
-	SetupFunction("number?", IsNumber, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("separator?", IsSeparator, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("number?", IsNumber, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("separator?", IsSeparator, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 	SetupSynonym("separator?", "sep?");
-	SetupFunction("symbol?", IsSymbol, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("punctuation?", IsPunctuation, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("symbol?", IsSymbol, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("punctuation?", IsPunctuation, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 	SetupSynonym("punctuation?", "punct?");
-	SetupFunction("other?", IsOther, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("other?", IsOther, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 
-	SetupFunction("lowercase?", IsLowercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("uppercase?", IsUppercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("titlecase?", IsTitlecase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
-	SetupFunction("digit?", IsDigit, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("lowercase?", IsLowercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("uppercase?", IsUppercase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("titlecase?", IsTitlecase, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
+	SetupFunction("digit?", IsDigit, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 
-	SetupFunction("letter-or-number?", IsLetterOrNumber, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("letter-or-number?", IsLetterOrNumber, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 	SetupSynonym("letter-or-number?", "alnum?");
-	SetupFunction("whitespace?", IsWhitespace, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 1, 1, 1, _uniChecks);
+	SetupFunction("whitespace?", IsWhitespace, NULL, "uni", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 1, 1, 1, _uniChecks);
 
-	SetupFunction("range-to", RangeTo, NULL, "start end", ARG_CHECK_EXACT | ARG_CHECK_TYPES, 2, 2, 2, _uniChecks);
+	SetupFunction("range-to", RangeTo, NULL, "start end", ARG_CHECK_EXACT | ARG_CHECK_TYPES | ARG_PURE, 2, 2, 2, _uniChecks);
 }
@@ -0,0 +1,579 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/types.h>
+#include <smile/mem.h>
+#include <smile/bytesearch.h>
+#include <smile/numeric/vector.h>
+
+#include <string.h>
+
+#if SMILE_CPU == SMILE_CPU_X64
+	#include <emmintrin.h>
+#endif
+#if VECTOR_HAS_AVX2
+	#include <immintrin.h>
+#endif
+
+// How many bytes of false-positive verification the SIMD filter may do, beyond twice the
+// number of bytes it has scanned, before it gives up and lets the two-way search finish.
+#define FILTER_SLACK 1024
+
+// The filters return this when they give up.
+#define FILTER_GAVE_UP -2
+
+//-------------------------------------------------------------------------------------------------
+//  Two-way search, in both directions.
+
+#define TWOWAY_NAME(__name__) Forward##__name__
+#define PAT(__i__) (pattern[(__i__)])
+#define TEXT(__j__) (text[(__j__)])
+#include "bytesearch_twoway.inc"
+#undef TEXT
+#undef PAT
+#undef TWOWAY_NAME
+
+#define TWOWAY_NAME(__name__) Reverse##__name__
+#define PAT(__i__) (pattern[m - 1 - (__i__)])
+#define TEXT(__j__) (text[n - 1 - (__j__)])
+#include "bytesearch_twoway.inc"
+#undef TEXT
+#undef PAT
+#undef TWOWAY_NAME
+
+//-------------------------------------------------------------------------------------------------
+//  Two-way search, in both directions, ignoring ASCII case in the text.  The pattern is already
+//  lowercase, so these share the factorizations above.
+
+/// <summary>
+/// Lowercase equivalents of each byte:  ASCII letters are lowercased, and everything else,
+/// including every non-ASCII byte, maps to itself.
+/// </summary>
+static const Byte _asciiLower[256] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+	0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+	0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+	0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+	0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+	0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+	0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+	0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+	0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+	0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+	0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF,
+};
+
+#define TWOWAY_SEARCH_ONLY
+
+#define TWOWAY_NAME(__name__) ForwardFolded##__name__
+#define PAT(__i__) (pattern[(__i__)])
+#define TEXT(__j__) (_asciiLower[text[(__j__)]])
+#include "bytesearch_twoway.inc"
+#undef TEXT
+#undef PAT
+#undef TWOWAY_NAME
+
+#define TWOWAY_NAME(__name__) ReverseFolded##__name__
+#define PAT(__i__) (pattern[m - 1 - (__i__)])
+#define TEXT(__j__) (_asciiLower[text[n - 1 - (__j__)]])
+#include "bytesearch_twoway.inc"
+#undef TEXT
+#undef PAT
+#undef TWOWAY_NAME
+
+#undef TWOWAY_SEARCH_ONLY
+
+/// <summary>
+/// Compare text against an already-lowercase pattern, ignoring the case of the text's ASCII letters.
+/// </summary>
+Inline Bool AsciiEqualsI(const Byte *text, const Byte *pattern, Int length)
+{
+	Int i;
+	for (i = 0; i < length; i++) {
+		if (_asciiLower[text[i]] != pattern[i])
+			return False;
+	}
+	return True;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  First-and-last-byte filters.
+//
+//  Each filter compares a block of starting positions at once against the pattern's first byte,
+//  and the same block shifted by (m - 1) against its last byte, and then verifies only the
+//  positions where both matched.  Each returns the first match at or after 'j', or -1, or
+//  FILTER_GAVE_UP (with *resume set) if it spent too long verifying false positives.
+//
+//  When 'fold' is set, the pattern is lowercase ASCII, and the text's ASCII letters match in
+//  either case:  Each byte of the text is ORed with 0x20 before comparing it against a letter,
+//  which matches exactly the two cases of that letter and nothing else.
+
+#define VERIFY(__pos__) \
+	(fold ? AsciiEqualsI(text + (__pos__) + 1, pattern + 1, m - 2) : !MemCmp(text + (__pos__) + 1, pattern + 1, m - 2))
+
+#define VERIFY_CANDIDATE(__pos__) \
+	if (VERIFY(__pos__)) \
+		return (__pos__); \
+	if ((work += m) > 2 * ((__pos__) - start) + FILTER_SLACK) { \
+		*resume = (__pos__) + 1; \
+		return FILTER_GAVE_UP; \
+	}
+
+/// <summary>
+/// Get the bit to OR into a text byte before comparing it to the given pattern byte:  0x20 for
+/// a lowercase letter when folding case, and zero otherwise.
+/// </summary>
+Inline Byte FoldBit(Byte ch, Bool fold)
+{
+	return fold && ch >= 'a' && ch <= 'z' ? 0x20 : 0x00;
+}
+
+/// <summary>
+/// Finish a filtered search one position at a time, for the last few positions that don't
+/// fill a whole block.
+/// </summary>
+static Int FilterTail(const Byte *pattern, Int m, const Byte *text, Int n, Int j, Bool fold)
+{
+	Byte first = pattern[0], last = pattern[m - 1];
+	Byte firstCase = FoldBit(first, fold), lastCase = FoldBit(last, fold);
+
+	for (; j <= n - m; j++) {
+		if ((text[j] | firstCase) == first && (text[j + m - 1] | lastCase) == last && VERIFY(j))
+			return j;
+	}
+	return -1;
+}
+
+#if SMILE_CPU == SMILE_CPU_X64
+
+static Int FilterSse2(const Byte *pattern, Int m, const Byte *text, Int n, Int j, Int *resume, Bool fold)
+{
+	__m128i first = _mm_set1_epi8((char)pattern[0]);
+	__m128i last = _mm_set1_epi8((char)pattern[m - 1]);
+	__m128i firstCase = _mm_set1_epi8((char)FoldBit(pattern[0], fold));
+	__m128i lastCase = _mm_set1_epi8((char)FoldBit(pattern[m - 1], fold));
+	Int start = j, work = 0;
+	UInt32 mask;
+
+	for (; j + 16 + m - 1 <= n; j += 16) {
+		__m128i a = _mm_or_si128(_mm_loadu_si128((const __m128i *)(text + j)), firstCase);
+		__m128i b = _mm_or_si128(_mm_loadu_si128((const __m128i *)(text + j + m - 1)), lastCase);
+		mask = (UInt32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+		while (mask) {
+			Int pos = j + (Int)UInt32_CountTrailingZeros(mask);
+			VERIFY_CANDIDATE(pos);
+			mask &= mask - 1;
+		}
+	}
+
+	return FilterTail(pattern, m, text, n, j, fold);
+}
+
+#else
+
+/// <summary>
+/// Set the high bit of every byte in 'v' that is zero (and possibly of a few bytes above a zero
+/// byte, which is harmless here, since every candidate is verified anyway).
+/// </summary>
+#define SWAR_ZERO_BYTES(__v__) (((__v__) - 0x0101010101010101ULL) & ~(__v__) & 0x8080808080808080ULL)
+
+static Int FilterSwar(const Byte *pattern, Int m, const Byte *text, Int n, Int j, Int *resume, Bool fold)
+{
+	UInt64 first = 0x0101010101010101ULL * pattern[0];
+	UInt64 last = 0x0101010101010101ULL * pattern[m - 1];
+	Byte firstCase = FoldBit(pattern[0], fold), lastCase = FoldBit(pattern[m - 1], fold);
+	UInt64 firstCases = 0x0101010101010101ULL * firstCase;
+	UInt64 lastCases = 0x0101010101010101ULL * lastCase;
+	Int start = j, work = 0, i;
+	UInt64 a, b, mask;
+
+	for (; j + 8 + m - 1 <= n; j += 8) {
+		MemCpy(&a, text + j, 8);
+		MemCpy(&b, text + j + m - 1, 8);
+		mask = SWAR_ZERO_BYTES((a | firstCases) ^ first) & SWAR_ZERO_BYTES((b | lastCases) ^ last);
+		if (!mask) continue;
+		for (i = 0; i < 8; i++) {
+			if ((text[j + i] | firstCase) == pattern[0] && (text[j + i + m - 1] | lastCase) == pattern[m - 1]) {
+				VERIFY_CANDIDATE(j + i);
+			}
+		}
+	}
+
+	return FilterTail(pattern, m, text, n, j, fold);
+}
+
+#endif
+
+#if VECTOR_HAS_AVX2
+
+__attribute__((target("avx2")))
+static Int FilterAvx2(const Byte *pattern, Int m, const Byte *text, Int n, Int j, Int *resume, Bool fold)
+{
+	__m256i first = _mm256_set1_epi8((char)pattern[0]);
+	__m256i last = _mm256_set1_epi8((char)pattern[m - 1]);
+	__m256i firstCase = _mm256_set1_epi8((char)FoldBit(pattern[0], fold));
+	__m256i lastCase = _mm256_set1_epi8((char)FoldBit(pattern[m - 1], fold));
+	Int start = j, work = 0;
+	UInt32 mask;
+
+	for (; j + 32 + m - 1 <= n; j += 32) {
+		__m256i a = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(text + j)), firstCase);
+		__m256i b = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(text + j + m - 1)), lastCase);
+		mask = (UInt32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+		while (mask) {
+			Int pos = j + (Int)UInt32_CountTrailingZeros(mask);
+			VERIFY_CANDIDATE(pos);
+			mask &= mask - 1;
+		}
+	}
+
+	return FilterTail(pattern, m, text, n, j, fold);
+}
+
+#endif
+
+/// <summary>
+/// Run whichever filter is fastest on this CPU.  (This follows the vector kernels' choice of
+/// instruction set, so Vector_SetIsa() can be used to test every filter on the same CPU.)
+/// </summary>
+static Int Filter(const Byte *pattern, Int m, const Byte *text, Int n, Int j, Int *resume, Bool fold)
+{
+#if VECTOR_HAS_AVX2
+	if (Vector_GetIsa() == VECTOR_ISA_AVX2)
+		return FilterAvx2(pattern, m, text, n, j, resume, fold);
+#endif
+#if SMILE_CPU == SMILE_CPU_X64
+	return FilterSse2(pattern, m, text, n, j, resume, fold);
+#else
+	return FilterSwar(pattern, m, text, n, j, resume, fold);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Prepared searches.
+
+/// <summary>
+/// Prepare a search pattern, so that it can be searched for repeatedly.
+/// </summary>
+/// <param name="search">The search to initialize.</param>
+/// <param name="pattern">The bytes to search for.  These are not copied, so they must not change
+/// while the search is in use.</param>
+/// <param name="length">The number of bytes in the pattern.</param>
+void ByteSearch_Init(ByteSearch search, const Byte *pattern, Int length)
+{
+	search->pattern = pattern;
+	search->length = length;
+
+	if (length >= 2) {
+		ForwardFactorize(pattern, length, &search->critical, &search->period, &search->periodic);
+		ReverseFactorize(pattern, length, &search->reverseCritical, &search->reversePeriod, &search->reversePeriodic);
+	}
+	else {
+		search->critical = search->reverseCritical = -1;
+		search->period = search->reversePeriod = 1;
+		search->periodic = search->reversePeriodic = True;
+	}
+}
+
+/// <summary>
+/// Search forward for the first instance of a prepared pattern.
+/// </summary>
+/// <param name="search">The prepared pattern to search for.</param>
+/// <param name="text">The text to search through.</param>
+/// <param name="textLength">The length of the text, in bytes.</param>
+/// <param name="start">The index within the text at which to start searching (usually zero).</param>
+/// <returns>The index of the first (leftmost) match at or after 'start', or -1 if there is none.</returns>
+Int ByteSearch_Find(const ByteSearch search, const Byte *text, Int textLength, Int start)
+{
+	Int m = search->length, result, resume;
+
+	if (start < 0) start = 0;
+	if (m > textLength - start) return -1;
+
+	if (m == 0) return start;
+	if (m == 1) return ByteSearch_IndexOfByte(text, textLength, search->pattern[0], start);
+
+	result = Filter(search->pattern, m, text, textLength, start, &resume, False);
+	if (result != FILTER_GAVE_UP)
+		return result;
+
+	return ForwardSearch(search->pattern, m, search->critical, search->period, search->periodic, text, textLength, resume);
+}
+
+/// <summary>
+/// Search backward for the last instance of a prepared pattern.
+/// </summary>
+/// <param name="search">The prepared pattern to search for.</param>
+/// <param name="text">The text to search through.</param>
+/// <param name="textLength">The length of the text, in bytes.</param>
+/// <param name="start">The greatest index within the text at which a match may begin.</param>
+/// <returns>The index of the last (rightmost) match at or before 'start', or -1 if there is none.</returns>
+Int ByteSearch_FindLast(const ByteSearch search, const Byte *text, Int textLength, Int start)
+{
+	Int m = search->length, n, result;
+
+	if (start < 0 || m > textLength) return -1;
+	if (start > textLength - m) start = textLength - m;
+
+	if (m == 0) return start;
+	if (m == 1) return ByteSearch_LastIndexOfByte(text, textLength, search->pattern[0], start);
+
+	// Search the reversed text that ends where the last possible match ends.
+	n = start + m;
+	result = ReverseSearch(search->pattern, m, search->reverseCritical, search->reversePeriod, search->reversePeriodic, text, n, 0);
+	return result >= 0 ? n - m - result : -1;
+}
+
+/// <summary>
+/// Search forward for the first instance of a prepared pattern, ignoring ASCII case.
+/// </summary>
+/// <param name="search">The prepared pattern to search for, which must already be lowercase ASCII.</param>
+/// <param name="text">The text to search through.  Its ASCII letters may be in either case; any
+/// non-ASCII bytes in it never match.</param>
+/// <param name="textLength">The length of the text, in bytes.</param>
+/// <param name="start">The index within the text at which to start searching (usually zero).</param>
+/// <returns>The index of the first (leftmost) match at or after 'start', or -1 if there is none.</returns>
+Int ByteSearch_FindAsciiI(const ByteSearch search, const Byte *text, Int textLength, Int start)
+{
+	Int m = search->length, result, resume;
+
+	if (start < 0) start = 0;
+	if (m > textLength - start) return -1;
+
+	if (m == 0) return start;
+
+	// A single byte can't have false positives to give up on, so this needs no special case.
+	result = Filter(search->pattern, m, text, textLength, start, &resume, True);
+	if (result != FILTER_GAVE_UP)
+		return result;
+
+	return ForwardFoldedSearch(search->pattern, m, search->critical, search->period, search->periodic, text, textLength, resume);
+}
+
+/// <summary>
+/// Search backward for the last instance of a prepared pattern, ignoring ASCII case.
+/// </summary>
+/// <param name="search">The prepared pattern to search for, which must already be lowercase ASCII.</param>
+/// <param name="text">The text to search through.</param>
+/// <param name="textLength">The length of the text, in bytes.</param>
+/// <param name="start">The greatest index within the text at which a match may begin.</param>
+/// <returns>The index of the last (rightmost) match at or before 'start', or -1 if there is none.</returns>
+Int ByteSearch_FindLastAsciiI(const ByteSearch search, const Byte *text, Int textLength, Int start)
+{
+	Int m = search->length, n, result;
+
+	if (start < 0 || m > textLength) return -1;
+	if (start > textLength - m) start = textLength - m;
+
+	if (m == 0) return start;
+
+	n = start + m;
+	result = ReverseFoldedSearch(search->pattern, m, search->reverseCritical, search->reversePeriod, search->reversePeriodic, text, n, 0);
+	return result >= 0 ? n - m - result : -1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  One-shot searches.
+
+/// <summary>
+/// Search forward through the given text for the given pattern.
+/// </summary>
+/// <param name="text">The text to search through.</param>
+/// <param name="textLength">The length of the text, in bytes.</param>
+/// <param name="pattern">The pattern to search for.</param>
+/// <param name="patternLength">The length of the pattern, in bytes.</param>
+/// <param name="start">The index within the text at which to start searching (usually zero).</param>
+/// <returns>The index of the first (leftmost) match at or after 'start', or -1 if there is none.</returns>
+Int ByteSearch_IndexOf(const Byte *text, Int textLength, const Byte *pattern, Int patternLength, Int start)
+{
+	Int result, resume, critical, period;
+	Bool periodic;
+
+	if (start < 0) start = 0;
+	if (patternLength > textLength - start) return -1;
+
+	if (patternLength == 0) return start;
+	if (patternLength == 1) return ByteSearch_IndexOfByte(text, textLength, pattern[0], start);
+
+	// Most searches never need the factorization, so only compute it if the filter gives up.
+	result = Filter(pattern, patternLength, text, textLength, start, &resume, False);
+	if (result != FILTER_GAVE_UP)
+		return result;
+
+	ForwardFactorize(pattern, patternLength, &critical, &period, &periodic);
+	return ForwardSearch(pattern, patternLength, critical, period, periodic, text, textLength, resume);
+}
+
+/// <summary>
+/// Search backward through the given text for the given pattern.
+/// </summary>
+/// <param name="text">The text to search through.</param>
+/// <param name="textLength">The length of the text, in bytes.</param>
+/// <param name="pattern">The pattern to search for.</param>
+/// <param name="patternLength">The length of the pattern, in bytes.</param>
+/// <param name="start">The greatest index within the text at which a match may begin.</param>
+/// <returns>The index of the last (rightmost) match at or before 'start', or -1 if there is none.</returns>
+Int ByteSearch_LastIndexOf(const Byte *text, Int textLength, const Byte *pattern, Int patternLength, Int start)
+{
+	Int m = patternLength, n, result, critical, period;
+	Bool periodic;
+
+	if (start < 0 || m > textLength) return -1;
+	if (start > textLength - m) start = textLength - m;
+
+	if (m == 0) return start;
+	if (m == 1) return ByteSearch_LastIndexOfByte(text, textLength, pattern[0], start);
+
+	n = start + m;
+	ReverseFactorize(pattern, m, &critical, &period, &periodic);
+	result = ReverseSearch(pattern, m, critical, period, periodic, text, n, 0);
+	return result >= 0 ? n - m - result : -1;
+}
+
+/// <summary>
+/// Search forward through the given text for the given byte.
+/// </summary>
+/// <returns>The index of the first instance of the byte at or after 'start', or -1 if there is none.</returns>
+Int ByteSearch_IndexOfByte(const Byte *text, Int textLength, Byte ch, Int start)
+{
+	const Byte *found;
+
+	if (start < 0) start = 0;
+	if (start >= textLength) return -1;
+
+	found = (const Byte *)memchr(text + start, ch, (size_t)(textLength - start));
+	return found != NULL ? (Int)(found - text) : -1;
+}
+
+/// <summary>
+/// Search backward through the given text for the given byte.
+/// </summary>
+/// <returns>The index of the last instance of the byte at or before 'start', or -1 if there is none.</returns>
+Int ByteSearch_LastIndexOfByte(const Byte *text, Int textLength, Byte ch, Int start)
+{
+	UInt64 pattern, word;
+
+	if (start >= textLength) start = textLength - 1;
+
+	// Skip eight bytes at a time while none of them can match.
+	pattern = 0x0101010101010101ULL * ch;
+	while (start >= 7) {
+		MemCpy(&word, text + start - 7, 8);
+		word ^= pattern;
+		if ((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL)
+			break;
+		start -= 8;
+	}
+
+	for (; start >= 0; start--) {
+		if (text[start] == ch)
+			return start;
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Search forward through the given text for any of the given bytes.
+/// </summary>
+/// <returns>The index of the first instance of any of the bytes at or after 'start', or -1 if there is none.</returns>
+Int ByteSearch_IndexOfAnyByte(const Byte *text, Int textLength, const Byte *chars, Int numChars, Int start)
+{
+	Byte table[256];
+	Int i;
+
+	if (start < 0) start = 0;
+	if (start >= textLength || numChars <= 0) return -1;
+
+	if (numChars == 1)
+		return ByteSearch_IndexOfByte(text, textLength, chars[0], start);
+
+	MemZero(table, sizeof(table));
+	for (i = 0; i < numChars; i++)
+		table[chars[i]] = 1;
+
+	for (; start < textLength; start++) {
+		if (table[text[start]])
+			return start;
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Search forward through the given text for the first non-ASCII byte (one with its high bit set).
+/// </summary>
+/// <returns>The index of the first non-ASCII byte at or after 'start', or 'textLength' if the rest
+/// of the text is all ASCII.</returns>
+Int ByteSearch_IndexOfNonAscii(const Byte *text, Int textLength, Int start)
+{
+	UInt64 word;
+
+	if (start < 0) start = 0;
+
+#if SMILE_CPU == SMILE_CPU_X64
+	for (; start + 16 <= textLength; start += 16) {
+		UInt32 mask = (UInt32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(text + start)));
+		if (mask)
+			return start + (Int)UInt32_CountTrailingZeros(mask);
+	}
+#endif
+
+	for (; start + 8 <= textLength; start += 8) {
+		MemCpy(&word, text + start, 8);
+		if (word & 0x8080808080808080ULL)
+			break;
+	}
+
+	for (; start < textLength; start++) {
+		if (text[start] & 0x80)
+			return start;
+	}
+
+	return textLength;
+}
+
+/// <summary>
+/// Search backward through the given text for the last non-ASCII byte (one with its high bit set).
+/// </summary>
+/// <returns>The index of the last non-ASCII byte at or before 'start', or -1 if the text up to and
+/// including 'start' is all ASCII.</returns>
+Int ByteSearch_LastIndexOfNonAscii(const Byte *text, Int textLength, Int start)
+{
+	UInt64 word;
+
+	if (start >= textLength) start = textLength - 1;
+
+	while (start >= 7) {
+		MemCpy(&word, text + start - 7, 8);
+		if (word & 0x8080808080808080ULL)
+			break;
+		start -= 8;
+	}
+
+	for (; start >= 0; start--) {
+		if (text[start] & 0x80)
+			return start;
+	}
+
+	return -1;
+}
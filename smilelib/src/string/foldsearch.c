@@ -0,0 +1,317 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/gc.h>
+#include <smile/string.h>
+#include <smile/stringbuilder.h>
+#include <smile/foldsearch.h>
+#include <smile/internal/unicode.h>
+
+// No code point case-folds to more than this many code points.
+#define MAX_FOLDED_LENGTH 3
+
+/// <summary>
+/// Case-fold one code point, using the full (not simple) case-folding rules.
+/// </summary>
+/// <param name="ch">The code point to fold.</param>
+/// <param name="buffer">A buffer that will receive the folded code points.</param>
+/// <returns>The number of code points written to the buffer.</returns>
+Inline Int FoldCodePoint(Int32 ch, Int32 *buffer)
+{
+	Int32 codePageIndex = (UInt32)ch >> 8;
+	Int32 folded;
+	const Int32 *values;
+	Int count, i;
+
+	if (codePageIndex >= UnicodeTables_CaseFoldingTableCount) {
+		buffer[0] = ch;
+		return 1;
+	}
+
+	folded = ch + UnicodeTables_CaseFoldingTable[codePageIndex][ch & 0xFF];
+	if (folded != 0) {
+		buffer[0] = folded;
+		return 1;
+	}
+
+	values = UnicodeTables_CaseFoldingTableFullExtended[codePageIndex][ch & 0xFF];
+	count = *values++;
+	for (i = 0; i < count; i++)
+		buffer[i] = values[i];
+	return count;
+}
+
+/// <summary>
+/// Read and case-fold the next character from the given text, treating malformed UTF-8 as
+/// U+FFFD, just as String_CompareRangeI() does.
+/// </summary>
+Inline Int ReadFolded(const Byte **ptr, const Byte *end, Int32 *buffer)
+{
+	const Byte *text = *ptr;
+	Byte b = *text;
+	Int32 ch;
+
+	if (b < 128) {
+		*ptr = text + 1;
+		buffer[0] = b + UnicodeTables_CaseFoldingTable[0][b];
+		return 1;
+	}
+
+	ch = String_ExtractUnicodeCharacterInternal(ptr, end);
+	if (ch < 0) ch = 0xFFFD;
+	return FoldCodePoint(ch, buffer);
+}
+
+/// <summary>
+/// Prepare a case-insensitive search pattern, so that it can be searched for repeatedly.
+/// </summary>
+/// <param name="pattern">The pattern to search for (NULL is treated as the empty string).</param>
+/// <returns>The prepared search.</returns>
+FoldSearch FoldSearch_Create(const String pattern)
+{
+	FoldSearch search;
+	const Byte *text, *ptr, *end;
+	Int32 *codePoints;
+	Int numCodePoints;
+
+	search = GC_MALLOC_STRUCT(struct FoldSearchStruct);
+	if (search == NULL) Smile_Abort_OutOfMemory();
+
+	search->pattern = pattern != NULL ? pattern : String_Empty;
+	search->length = String_Length(search->pattern);
+	search->folded = String_CaseFold(search->pattern);
+
+	text = String_GetBytes(search->pattern);
+	search->isAscii = ByteSearch_IndexOfNonAscii(text, search->length, 0) >= search->length;
+
+	// Decode the folded pattern as code points, for comparing against non-ASCII text.
+	codePoints = GC_MALLOC_RAW_ARRAY(Int32, search->length * MAX_FOLDED_LENGTH + 1);
+	if (codePoints == NULL) Smile_Abort_OutOfMemory();
+	numCodePoints = 0;
+	for (ptr = text, end = text + search->length; ptr < end; )
+		numCodePoints += ReadFolded(&ptr, end, codePoints + numCodePoints);
+	search->codePoints = codePoints;
+	search->numCodePoints = numCodePoints;
+
+	// ASCII folds to ASCII of the same length, so the folded bytes can be searched for directly.
+	if (search->isAscii)
+		ByteSearch_Init(&search->asciiSearch, String_GetBytes(search->folded), search->length);
+	else
+		ByteSearch_Init(&search->asciiSearch, NULL, 0);
+
+	return search;
+}
+
+/// <summary>
+/// Determine whether the bytes at the given text pointer case-fold to the same code points as the pattern.
+/// </summary>
+static Bool MatchesAt(const FoldSearch search, const Byte *text)
+{
+	const Byte *ptr = text, *end = text + search->length;
+	const Int32 *expected = search->codePoints;
+	const Int32 *expectedEnd = expected + search->numCodePoints;
+	Int32 folded[MAX_FOLDED_LENGTH];
+	Int count, i;
+
+	while (ptr < end) {
+		count = ReadFolded(&ptr, end, folded);
+		if (count > expectedEnd - expected)
+			return False;
+		for (i = 0; i < count; i++) {
+			if (*expected++ != folded[i])
+				return False;
+		}
+	}
+
+	return expected == expectedEnd;
+}
+
+/// <summary>
+/// Determine whether the prepared pattern matches the given string at the given index.
+/// </summary>
+/// <param name="search">The prepared pattern.</param>
+/// <param name="str">The string to test.</param>
+/// <param name="index">The byte index within the string at which the match must begin.</param>
+/// <returns>True if the pattern's length in bytes, starting at that index, matches the pattern
+/// case-insensitively; False if it does not (or if that runs past either end of the string).</returns>
+Bool FoldSearch_MatchesAt(const FoldSearch search, const String str, Int index)
+{
+	if (index < 0 || search->length > String_Length(str) - index)
+		return False;
+
+	return MatchesAt(search, String_GetBytes(str) + index);
+}
+
+/// <summary>
+/// Search forward through a string for the first case-insensitive match of a prepared pattern.
+/// </summary>
+/// <param name="search">The prepared pattern to search for.</param>
+/// <param name="str">The string to search through.</param>
+/// <param name="start">The byte index within the string at which to start searching (usually zero).</param>
+/// <returns>The index of the first (leftmost) match at or after 'start', or -1 if there is none.</returns>
+Int FoldSearch_Find(const FoldSearch search, const String str, Int start)
+{
+	const Byte *text = String_GetBytes(str);
+	Int n = String_Length(str), m = search->length;
+	Int nonAscii, runEnd, result;
+
+	if (start < 0) start = 0;
+	if (m > n - start) return -1;
+	if (m == 0) return start;
+
+	if (!search->isAscii) {
+		for (; start <= n - m; start++) {
+			if (MatchesAt(search, text + start))
+				return start;
+		}
+		return -1;
+	}
+
+	// An ASCII pattern is searched for with the SIMD search in each run of ASCII text.  Only
+	// the positions whose matches would overlap non-ASCII text need the slower comparison.
+	while (start <= n - m) {
+		nonAscii = ByteSearch_IndexOfNonAscii(text, n, start);
+
+		if (nonAscii - start >= m) {
+			result = ByteSearch_FindAsciiI(&search->asciiSearch, text, nonAscii, start);
+			if (result >= 0) return result;
+		}
+		if (nonAscii >= n) return -1;
+
+		for (runEnd = nonAscii + 1; runEnd < n && text[runEnd] >= 128; runEnd++) ;
+
+		if (start < nonAscii - m + 1)
+			start = nonAscii - m + 1;
+		for (; start < runEnd && start <= n - m; start++) {
+			if (MatchesAt(search, text + start))
+				return start;
+		}
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Search backward through a string for the last case-insensitive match of a prepared pattern.
+/// </summary>
+/// <param name="search">The prepared pattern to search for.</param>
+/// <param name="str">The string to search through.</param>
+/// <param name="start">The greatest byte index within the string at which a match may begin.</param>
+/// <returns>The index of the last (rightmost) match at or before 'start', or -1 if there is none.</returns>
+Int FoldSearch_FindLast(const FoldSearch search, const String str, Int start)
+{
+	const Byte *text = String_GetBytes(str);
+	Int n = String_Length(str), m = search->length;
+	Int end, nonAscii, runStart, result;
+
+	if (start < 0 || m > n) return -1;
+	if (start > n - m) start = n - m;
+	if (m == 0) return start;
+
+	if (!search->isAscii) {
+		for (; start >= 0; start--) {
+			if (MatchesAt(search, text + start))
+				return start;
+		}
+		return -1;
+	}
+
+	// The same as a forward search, but working backward from the end of the last possible match.
+	for (end = start + m; end >= m; ) {
+		nonAscii = ByteSearch_LastIndexOfNonAscii(text, end, end - 1);
+
+		if (end - (nonAscii + 1) >= m) {
+			result = ByteSearch_FindLastAsciiI(&search->asciiSearch, text + nonAscii + 1, end - (nonAscii + 1), end - m - (nonAscii + 1));
+			if (result >= 0) return result + nonAscii + 1;
+		}
+		if (nonAscii < 0) return -1;
+
+		for (runStart = nonAscii; runStart > 0 && text[runStart - 1] >= 128; runStart--) ;
+
+		for (start = (nonAscii < end - m ? nonAscii : end - m); start >= 0 && start > runStart - m; start--) {
+			if (MatchesAt(search, text + start))
+				return start;
+		}
+		end = runStart;
+	}
+
+	return -1;
+}
+
+/// <summary>
+/// Count the number of non-overlapping case-insensitive matches of a prepared pattern.
+/// </summary>
+/// <param name="search">The prepared pattern to search for.</param>
+/// <param name="str">The string to search through.</param>
+/// <param name="start">The byte index within the string at which to start searching (usually zero).</param>
+/// <returns>The number of matches found, scanning from left to right.  If the pattern is empty,
+/// this returns zero.</returns>
+Int FoldSearch_CountOf(const FoldSearch search, const String str, Int start)
+{
+	Int count = 0;
+
+	if (search->length == 0)
+		return 0;
+
+	while ((start = FoldSearch_Find(search, str, start)) >= 0) {
+		count++;
+		start += search->length;
+	}
+
+	return count;
+}
+
+/// <summary>
+/// Replace case-insensitive matches of a prepared pattern in a string with a replacement string
+/// (scanning from left to right).
+/// </summary>
+/// <param name="search">The prepared pattern to search for (if empty, 'str' is returned).</param>
+/// <param name="str">The string to search through (if NULL, an empty string is returned).</param>
+/// <param name="replacement">Replacement text for each match (if NULL, will be treated as empty).</param>
+/// <param name="limit">The maximum number of replacements to perform, or a negative number for no limit.</param>
+/// <returns>A new string where the matches have been replaced by the given replacement string.</returns>
+String FoldSearch_Replace(const FoldSearch search, const String str, const String replacement, Int limit)
+{
+	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	const Byte *text;
+	Int lastEnd, index;
+
+	if (String_IsNullOrEmpty(str)) return String_Empty;
+	if (search->length == 0) return str;
+
+	text = String_GetBytes(str);
+
+	INIT_INLINE_STRINGBUILDER(stringBuilder);
+
+	lastEnd = 0;
+	while (limit != 0 && (index = FoldSearch_Find(search, str, lastEnd)) >= 0) {
+		if (index > lastEnd) {
+			StringBuilder_Append(stringBuilder, text, lastEnd, index - lastEnd);
+		}
+		if (replacement != NULL) {
+			StringBuilder_AppendString(stringBuilder, replacement);
+		}
+		lastEnd = index + search->length;
+		if (limit > 0) limit--;
+	}
+
+	if (lastEnd < String_Length(str)) {
+		StringBuilder_Append(stringBuilder, text, lastEnd, String_Length(str) - lastEnd);
+	}
+
+	return StringBuilder_ToString(stringBuilder);
+}
@@ -24,1587 +24,90 @@
 
 #include <smile/internal/html.h>
 
+// The entity names are found with a two-level perfect hash:  The first hash picks a bucket, whose
+// seed makes the second hash put each of the bucket's names in its own slot.
+#define NUM_BUCKETS 64
+#define NUM_SLOTS 512
+#define MAX_NAME_LENGTH 8
+
+static const Byte _bucketSeeds[NUM_BUCKETS] = {
+	  3,   2,   7,   3,   3,   5,   1,   2,   2,   4,   2,   2,   4,   2,   5,   1,
+	  9,   2,   4,   5,   3,   3,   5,  11,   1,   1,   4,   3,   4,   4,   6,   1,
+	  3,   1,   1,   2,   2,   1,   3,   2,   4,   9,   1,   4,   3,   4,   2,   1,
+	  4,   3,   5,   5,   1,   1,  14,   4,  17,   3,   2,   4,   2,   1,   4,   3,
+};
+
+// One plus the index of each slot's entity in HtmlEntityTable, or zero for an empty slot.
+static const Byte _slots[NUM_SLOTS] = {
+	200,  55,   0,   0,  87,   0,  96,   0,   0,   0,   0,   0,   0,  36, 116,   0,
+	  0,   0,  70,   0,   0,  74, 217,   6, 121, 105, 225,   0,   0, 245,  62, 193,
+	  2,   0,   0, 109,   0, 160, 229,   0,   0,  90, 114,  93, 102,   0,   0,  82,
+	 15,   0,  44,   0,  10,  26,   0,   0, 151,  18,   0,   0,   0, 154,  72, 107,
+	120,   0, 100,   0,   4, 136,   0,  65,   0,   0,  20,   0, 190,   0,  61,   0,
+	125, 113,  31,   0,   0,   0,   0,   0,   0,   0,   0,   0, 145,   0, 128,   0,
+	248,   0,  23, 129,   0,   0, 223,   0,  48,  89,   0, 228,  78,  63,   0, 177,
+	  0,  86, 127,   0,   0,   0,   0, 192,   0, 149,   0, 208,   0, 194,   0,   0,
+	  0,   0,  77,  91, 219,  46,   0,  88,   0, 144,   0, 196, 158,  19,   0,   0,
+	167,   0,   0,  28,   0,   0,   0, 174,   0,   0,   0, 182,   0,   0, 189,   0,
+	  0,   0,   0, 150,  69, 103, 101, 157,   1,  79,  81, 232,  71, 227, 139, 180,
+	  0,   0,   0,  98,  22, 254,   0, 131, 163,   0, 203, 197, 148,   0,   0,  56,
+	  0, 137, 162,  58,   0,   0,   0, 212,   0,  30,  32,   0,   0,   0,   0, 191,
+	 35,   0,   0,   0,   0,  16, 213,   0, 119,   0, 140,   0,   0, 178, 195,   0,
+	106, 186,   8,   0, 230, 226,   0,   0,   0,   0, 253,   0, 202,   0, 235, 104,
+	  0,   0, 165,   0, 211,   0,   3,   0,  66,   0,   0, 142, 175,   0,   0, 171,
+	  0, 138, 250, 233, 204,  80,  14, 201, 240,  41,  75,   0,   0,   0, 133, 243,
+	 76,   0,   0,  84,  94, 118,   0,  21, 246,   0, 215,   0,   0, 159,   0,   0,
+	  9,   0,   0,  49, 221,   0,   5,  12,   0, 173,   0,   0, 188,   0,  60, 122,
+	247,  83, 185,   0,   0, 141,   0, 152,   0,  50,   0, 172,   0, 168,   0, 218,
+	  0,   0,   0,   0,   0, 183,   0, 239,  53,   0, 134,   7,   0,   0,   0,   0,
+	  0,   0,   0,   0, 224,   0,   0, 169,  11,   0,   0,   0,   0, 236,   0,   0,
+	 67,   0,   0,   0,   0,   0,   0, 181,   0,  59,   0,   0,   0,   0,   0,   0,
+	  0,   0, 164,   0,   0, 126,   0,  40,  34, 184, 216, 115, 112, 231,  39,   0,
+	  0,   0, 214,   0,   0,   0,   0, 108, 130,  45,   0, 241,   0,  25, 155,   0,
+	  0,  92,   0,   0, 124,  17, 110,   0,  54,   0,  47,  99,  85,  37,  57,   0,
+	  0,   0, 210, 170,   0, 207,   0, 111,   0,   0,  95, 153,   0, 166,   0,   0,
+	  0, 220, 244, 187, 146,   0,  27,   0,  52, 123,  13,   0, 179,   0,   0, 117,
+	  0,  73,  33, 252, 199,   0,  43, 206, 242,  68,   0,   0,   0, 251,  42,   0,
+	  0, 205,  97,   0, 198,   0,   0,   0,   0, 147, 222,   0, 209, 249,   0,   0,
+	  0, 156,   0,   0,  51,   0, 135, 237,  29,  64, 143,   0,   0, 234,   0, 238,
+	132,   0,   0, 176,   0,  38,   0,   0,   0,   0,   0,   0,   0,  24, 161,   0,
+};
+
+/// <summary>
+/// Hash an entity name, starting from the given seed (a 32-bit FNV-1a hash, with its high bits
+/// folded down into its low bits).
+/// </summary>
+Inline UInt32 HashName(const Byte *src, Int length, UInt32 seed)
+{
+	UInt32 hash = seed ^ (UInt32)length;
+
+	while (length-- > 0)
+		hash = (hash ^ *src++) * 0x01000193;
+
+	return hash ^ (hash >> 15);
+}
+
 /// <summary>
-/// Convert the given name to its HTML entity value.  This is AUTO-GENERATED, and uses an optimized
-/// decision tree that runs in O(n) time to convert the string as quickly as possible.
+/// Convert the given name to its HTML entity value.  This is AUTO-GENERATED, and uses a perfect
+/// hash of the entity names, so it runs in O(n) time with a single comparison against the table.
 /// </summary>
 /// <param name="name">The name of the HTML entity to look up.</param>
 /// <returns>The value for that entity, if it is an entity with a value, or -1 if there is no such entity.</returns>
 Int32 HtmlEntityNameToValue(const Byte *src, Int length)
 {
-	Byte ch;
+	const HtmlEntity *entity;
+	UInt32 seed;
+	Byte slot;
+
+	if (src == NULL || length <= 0 || length > MAX_NAME_LENGTH) return -1;
+
+	seed = _bucketSeeds[HashName(src, length, 0) % NUM_BUCKETS];
+	slot = _slots[HashName(src, length, seed) & (NUM_SLOTS - 1)];
+	if (slot == 0) return -1;
 
-	if (src == NULL) return -1;
+	entity = &HtmlEntityTable[slot - 1];
+	if (String_Length(entity->string) != length || MemCmp(String_GetBytes(entity->string), src, length))
+		return -1;
 
-	if (length-- <= 0) return -1;
-	switch (*src++) {
-		case 'A':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'E':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 198;
-					break;
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 193;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 194;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 192;
-					break;
-				case 'l':
-					if (length-- >= 0 && *src++ == 'p')
-						if (length-- >= 0 && *src++ == 'h')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 913;
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'n')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 197;
-					break;
-				case 't':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 195;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 196;
-					break;
-			}
-			break;
-		case 'B':
-			if (length-- >= 0 && *src++ == 'e')
-				if (length-- >= 0 && *src++ == 't')
-					if (length-- >= 0 && *src++ == 'a')
-						if (length <= 0) return 914;
-			break;
-		case 'C':
-			if (length-- <= 0) return -1;
-			if ((ch = *src++) == 'c') {
-				if (length-- >= 0 && *src++ == 'e')
-					if (length-- >= 0 && *src++ == 'd')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length <= 0) return 199;
-			}
-			else if (ch == 'h') {
-				if (length-- >= 0 && *src++ == 'i')
-					if (length <= 0) return 935;
-			}
-			break;
-		case 'D':
-			if (length-- <= 0) return -1;
-			if ((ch = *src++) == 'a') {
-				if (length-- >= 0 && *src++ == 'g')
-					if (length-- >= 0 && *src++ == 'g')
-						if (length-- >= 0 && *src++ == 'e')
-							if (length-- >= 0 && *src++ == 'r')
-								if (length <= 0) return 8225;
-			}
-			else if (ch == 'e') {
-				if (length-- >= 0 && *src++ == 'l')
-					if (length-- >= 0 && *src++ == 't')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 916;
-			}
-			break;
-		case 'E':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'T':
-					if (length-- >= 0 && *src++ == 'H')
-						if (length <= 0) return 208;
-					break;
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 201;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 202;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 200;
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 's')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 'n')
-										if (length <= 0) return 917;
-					break;
-				case 't':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length <= 0) return 919;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 203;
-					break;
-			}
-			break;
-		case 'G':
-			if (length-- >= 0 && *src++ == 'a')
-				if (length-- >= 0 && *src++ == 'm')
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 915;
-			break;
-		case 'I':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 205;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 206;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 204;
-					break;
-				case 'o':
-					if (length-- >= 0 && *src++ == 't')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 921;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 207;
-					break;
-			}
-			break;
-		case 'K':
-			if (length-- >= 0 && *src++ == 'a')
-				if (length-- >= 0 && *src++ == 'p')
-					if (length-- >= 0 && *src++ == 'p')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 922;
-			break;
-		case 'L':
-			if (length-- >= 0 && *src++ == 'a')
-				if (length-- >= 0 && *src++ == 'm')
-					if (length-- >= 0 && *src++ == 'b')
-						if (length-- >= 0 && *src++ == 'd')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 923;
-			break;
-		case 'M':
-			if (length-- >= 0 && *src++ == 'u')
-				if (length <= 0) return 924;
-			break;
-		case 'N':
-			if (length-- <= 0) return -1;
-			if ((ch = *src++) == 't') {
-				if (length-- >= 0 && *src++ == 'i')
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'd')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 209;
-			}
-			else if (ch == 'u') {
-				if (length <= 0) return 925;
-			}
-			break;
-		case 'O':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'E':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 338;
-					break;
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 211;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 212;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 210;
-					break;
-				case 'm':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'e') {
-						if (length-- >= 0 && *src++ == 'g')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 937;
-					}
-					else if (ch == 'i') {
-						if (length-- >= 0 && *src++ == 'c')
-							if (length-- >= 0 && *src++ == 'r')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 'n')
-										if (length <= 0) return 927;
-					}
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 's')
-								if (length-- >= 0 && *src++ == 'h')
-									if (length <= 0) return 216;
-					break;
-				case 't':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 213;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 214;
-					break;
-			}
-			break;
-		case 'P':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'h':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length <= 0) return 934;
-					break;
-				case 'i':
-					if (length <= 0) return 928;
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'm')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 8243;
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length <= 0) return 936;
-					break;
-			}
-			break;
-		case 'R':
-			if (length-- >= 0 && *src++ == 'h')
-				if (length-- >= 0 && *src++ == 'o')
-					if (length <= 0) return 929;
-			break;
-		case 'S':
-			if (length-- <= 0) return -1;
-			if ((ch = *src++) == 'c') {
-				if (length-- >= 0 && *src++ == 'a')
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'o')
-							if (length-- >= 0 && *src++ == 'n')
-								if (length <= 0) return 352;
-			}
-			else if (ch == 'i') {
-				if (length-- >= 0 && *src++ == 'g')
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 931;
-			}
-			break;
-		case 'T':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'H':
-					if (length-- >= 0 && *src++ == 'O')
-						if (length-- >= 0 && *src++ == 'R')
-							if (length-- >= 0 && *src++ == 'N')
-								if (length <= 0) return 222;
-					break;
-				case 'a':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length <= 0) return 932;
-					break;
-				case 'h':
-					if (length-- >= 0 && *src++ == 'e')
-						if (length-- >= 0 && *src++ == 't')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 920;
-					break;
-			}
-			break;
-		case 'U':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 218;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 219;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 217;
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 's')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 'n')
-										if (length <= 0) return 933;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 220;
-					break;
-			}
-			break;
-		case 'X':
-			if (length-- >= 0 && *src++ == 'i')
-				if (length <= 0) return 926;
-			break;
-		case 'Y':
-			if (length-- <= 0) return -1;
-			if ((ch = *src++) == 'a') {
-				if (length-- >= 0 && *src++ == 'c')
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 't')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 221;
-			}
-			else if (ch == 'u') {
-				if (length-- >= 0 && *src++ == 'm')
-					if (length-- >= 0 && *src++ == 'l')
-						if (length <= 0) return 376;
-			}
-			break;
-		case 'Z':
-			if (length-- >= 0 && *src++ == 'e')
-				if (length-- >= 0 && *src++ == 't')
-					if (length-- >= 0 && *src++ == 'a')
-						if (length <= 0) return 918;
-			break;
-		case 'a':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 225;
-					break;
-				case 'c':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'i') {
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 226;
-					}
-					else if (ch == 'u') {
-						if (length-- >= 0 && *src++ == 't')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 180;
-					}
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 230;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 224;
-					break;
-				case 'l':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'e') {
-						if (length-- >= 0 && *src++ == 'f')
-							if (length-- >= 0 && *src++ == 's')
-								if (length-- >= 0 && *src++ == 'y')
-									if (length-- >= 0 && *src++ == 'm')
-										if (length <= 0) return 8501;
-					}
-					else if (ch == 'p') {
-						if (length-- >= 0 && *src++ == 'h')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 945;
-					}
-					break;
-				case 'm':
-					if (length-- >= 0 && *src++ == 'p')
-						if (length <= 0) return 38;
-					break;
-				case 'n':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'd') {
-						if (length <= 0) return 8743;
-					}
-					else if (ch == 'g') {
-						if (length <= 0) return 8736;
-					}
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 'o')
-						if (length-- >= 0 && *src++ == 's')
-							if (length <= 0) return 39;
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'n')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 229;
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'y')
-						if (length-- >= 0 && *src++ == 'm')
-							if (length-- >= 0 && *src++ == 'p')
-								if (length <= 0) return 8776;
-					break;
-				case 't':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 227;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 228;
-					break;
-			}
-			break;
-		case 'b':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'd':
-					if (length-- >= 0 && *src++ == 'q')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length <= 0) return 8222;
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 't')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 946;
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'v')
-						if (length-- >= 0 && *src++ == 'b')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length-- >= 0 && *src++ == 'r')
-									if (length <= 0) return 166;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 8226;
-					break;
-			}
-			break;
-		case 'c':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'p')
-						if (length <= 0) return 8745;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'e')
-						if (length-- >= 0 && *src++ == 'd')
-							if (length-- >= 0 && *src++ == 'i')
-								if (length-- >= 0 && *src++ == 'l')
-									if (length <= 0) return 231;
-					break;
-				case 'e':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'd') {
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length <= 0) return 184;
-					}
-					else if (ch == 'n') {
-						if (length-- >= 0 && *src++ == 't')
-							if (length <= 0) return 162;
-					}
-					break;
-				case 'h':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length <= 0) return 967;
-					break;
-				case 'i':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'c')
-							if (length <= 0) return 710;
-					break;
-				case 'l':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 'b')
-							if (length-- >= 0 && *src++ == 's')
-								if (length <= 0) return 9827;
-					break;
-				case 'o':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'n') {
-						if (length-- >= 0 && *src++ == 'g')
-							if (length <= 0) return 8773;
-					}
-					else if (ch == 'p') {
-						if (length-- >= 0 && *src++ == 'y')
-							if (length <= 0) return 169;
-					}
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'r')
-								if (length <= 0) return 8629;
-					break;
-				case 'u':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'p') {
-						if (length <= 0) return 8746;
-					}
-					else if (ch == 'r') {
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length-- >= 0 && *src++ == 'n')
-									if (length <= 0) return 164;
-					}
-					break;
-			}
-			break;
-		case 'd':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'A':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8659;
-					break;
-				case 'a':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'g') {
-						if (length-- >= 0 && *src++ == 'g')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length-- >= 0 && *src++ == 'r')
-									if (length <= 0) return 8224;
-					}
-					else if (ch == 'r') {
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8595;
-					}
-					break;
-				case 'e':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'g') {
-						if (length <= 0) return 176;
-					}
-					else if (ch == 'l') {
-						if (length-- >= 0 && *src++ == 't')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 948;
-					}
-					break;
-				case 'i':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'a') {
-						if (length-- >= 0 && *src++ == 'm')
-							if (length-- >= 0 && *src++ == 's')
-								if (length <= 0) return 9830;
-					}
-					else if (ch == 'v') {
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 247;
-					}
-					break;
-			}
-			break;
-		case 'e':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 233;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 234;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 232;
-					break;
-				case 'm':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'p') {
-						if (length-- >= 0 && *src++ == 't')
-							if (length-- >= 0 && *src++ == 'y')
-								if (length <= 0) return 8709;
-					}
-					else if (ch == 's') {
-						if (length-- >= 0 && *src++ == 'p')
-							if (length <= 0) return 8195;
-					}
-					break;
-				case 'n':
-					if (length-- >= 0 && *src++ == 's')
-						if (length-- >= 0 && *src++ == 'p')
-							if (length <= 0) return 8194;
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 's')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 'n')
-										if (length <= 0) return 949;
-					break;
-				case 'q':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length <= 0) return 8801;
-					break;
-				case 't':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'a') {
-						if (length <= 0) return 951;
-					}
-					else if (ch == 'h') {
-						if (length <= 0) return 240;
-					}
-					break;
-				case 'u':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'm') {
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 235;
-					}
-					else if (ch == 'r') {
-						if (length-- >= 0 && *src++ == 'o')
-							if (length <= 0) return 8364;
-					}
-					break;
-				case 'x':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 's')
-							if (length-- >= 0 && *src++ == 't')
-								if (length <= 0) return 8707;
-					break;
-			}
-			break;
-		case 'f':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'n':
-					if (length-- >= 0 && *src++ == 'o')
-						if (length-- >= 0 && *src++ == 'f')
-							if (length <= 0) return 402;
-					break;
-				case 'o':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length-- >= 0 && *src++ == 'l')
-									if (length <= 0) return 8704;
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'a') {
-						if (length-- <= 0) return -1;
-						if ((ch = *src++) == 'c') {
-							if (length-- <= 0) return -1;
-							if ((ch = *src++) == '1') {
-								if (length-- <= 0) return -1;
-								if ((ch = *src++) == '2') {
-									if (length <= 0) return 189;
-								}
-								else if (ch == '4') {
-									if (length <= 0) return 188;
-								}
-							}
-							else if (ch == '3') {
-								if (length-- >= 0 && *src++ == '4')
-									if (length <= 0) return 190;
-							}
-						}
-						else if (ch == 's') {
-							if (length-- >= 0 && *src++ == 'l')
-								if (length <= 0) return 8260;
-						}
-					}
-					break;
-			}
-			break;
-		case 'g':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'm')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 947;
-					break;
-				case 'e':
-					if (length <= 0) return 8805;
-					break;
-				case 't':
-					if (length <= 0) return 62;
-					break;
-			}
-			break;
-		case 'h':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'A':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8660;
-					break;
-				case 'a':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8596;
-					break;
-				case 'e':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'a') {
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 's')
-									if (length <= 0) return 9829;
-					}
-					else if (ch == 'l') {
-						if (length-- >= 0 && *src++ == 'l')
-							if (length-- >= 0 && *src++ == 'i')
-								if (length-- >= 0 && *src++ == 'p')
-									if (length <= 0) return 8230;
-					}
-					break;
-			}
-			break;
-		case 'i':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 237;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 238;
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 'x')
-						if (length-- >= 0 && *src++ == 'c')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length <= 0) return 161;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 236;
-					break;
-				case 'm':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 'g')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 8465;
-					break;
-				case 'n':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'f') {
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'n')
-								if (length <= 0) return 8734;
-					}
-					else if (ch == 't') {
-						if (length <= 0) return 8747;
-					}
-					break;
-				case 'o':
-					if (length-- >= 0 && *src++ == 't')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 953;
-					break;
-				case 'q':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 'e')
-							if (length-- >= 0 && *src++ == 's')
-								if (length-- >= 0 && *src++ == 't')
-									if (length <= 0) return 191;
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'n')
-							if (length <= 0) return 8712;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 239;
-					break;
-			}
-			break;
-		case 'k':
-			if (length-- >= 0 && *src++ == 'a')
-				if (length-- >= 0 && *src++ == 'p')
-					if (length-- >= 0 && *src++ == 'p')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length <= 0) return 954;
-			break;
-		case 'l':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'A':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8656;
-					break;
-				case 'a':
-					if (length-- <= 0) return -1;
-					switch (*src++) {
-						case 'm':
-							if (length-- >= 0 && *src++ == 'b')
-								if (length-- >= 0 && *src++ == 'd')
-									if (length-- >= 0 && *src++ == 'a')
-										if (length <= 0) return 955;
-							break;
-						case 'n':
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 9001;
-							break;
-						case 'q':
-							if (length-- >= 0 && *src++ == 'u')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length <= 0) return 171;
-							break;
-						case 'r':
-							if (length-- >= 0 && *src++ == 'r')
-								if (length <= 0) return 8592;
-							break;
-					}
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'e')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length <= 0) return 8968;
-					break;
-				case 'd':
-					if (length-- >= 0 && *src++ == 'q')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length <= 0) return 8220;
-					break;
-				case 'e':
-					if (length <= 0) return 8804;
-					break;
-				case 'f':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'o')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length-- >= 0 && *src++ == 'r')
-									if (length <= 0) return 8970;
-					break;
-				case 'o':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'w') {
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 's')
-								if (length-- >= 0 && *src++ == 't')
-									if (length <= 0) return 8727;
-					}
-					else if (ch == 'z') {
-						if (length <= 0) return 9674;
-					}
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length <= 0) return 8206;
-					break;
-				case 's':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'a') {
-						if (length-- >= 0 && *src++ == 'q')
-							if (length-- >= 0 && *src++ == 'u')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length <= 0) return 8249;
-					}
-					else if (ch == 'q') {
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length <= 0) return 8216;
-					}
-					break;
-				case 't':
-					if (length <= 0) return 60;
-					break;
-			}
-			break;
-		case 'm':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 175;
-					break;
-				case 'd':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 's')
-							if (length-- >= 0 && *src++ == 'h')
-								if (length <= 0) return 8212;
-					break;
-				case 'i':
-					if (length-- <= 0) return -1;
-					switch (*src++) {
-						case 'c':
-							if (length-- >= 0 && *src++ == 'r')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length <= 0) return 181;
-							break;
-						case 'd':
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 't')
-										if (length <= 0) return 183;
-							break;
-						case 'n':
-							if (length-- >= 0 && *src++ == 'u')
-								if (length-- >= 0 && *src++ == 's')
-									if (length <= 0) return 8722;
-							break;
-					}
-					break;
-				case 'u':
-					if (length <= 0) return 956;
-					break;
-			}
-			break;
-		case 'n':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'b')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 8711;
-					break;
-				case 'b':
-					if (length-- >= 0 && *src++ == 's')
-						if (length-- >= 0 && *src++ == 'p')
-							if (length <= 0) return 160;
-					break;
-				case 'd':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 's')
-							if (length-- >= 0 && *src++ == 'h')
-								if (length <= 0) return 8211;
-					break;
-				case 'e':
-					if (length <= 0) return 8800;
-					break;
-				case 'i':
-					if (length <= 0) return 8715;
-					break;
-				case 'o':
-					if (length-- >= 0 && *src++ == 't') {
-						if (length <= 0) return 172;
-					}
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 'b')
-							if (length <= 0) return 8836;
-					break;
-				case 't':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 241;
-					break;
-				case 'u':
-					if (length <= 0) return 957;
-					break;
-			}
-			break;
-		case 'o':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 243;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 244;
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 339;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 242;
-					break;
-				case 'l':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'n')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 8254;
-					break;
-				case 'm':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'e') {
-						if (length-- >= 0 && *src++ == 'g')
-							if (length-- >= 0 && *src++ == 'a')
-								if (length <= 0) return 969;
-					}
-					else if (ch == 'i') {
-						if (length-- >= 0 && *src++ == 'c')
-							if (length-- >= 0 && *src++ == 'r')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 'n')
-										if (length <= 0) return 959;
-					}
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 's')
-								if (length <= 0) return 8853;
-					break;
-				case 'r':
-					if (length <= 0) return 8744;
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 's')
-								if (length-- >= 0 && *src++ == 'h')
-									if (length <= 0) return 248;
-					break;
-				case 't':
-					if (length-- >= 0 && *src++ == 'i') {
-						if (length-- <= 0) return -1;
-						if ((ch = *src++) == 'l') {
-							if (length-- >= 0 && *src++ == 'd')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 245;
-						}
-						else if (ch == 'm') {
-							if (length-- >= 0 && *src++ == 'e')
-								if (length-- >= 0 && *src++ == 's')
-									if (length <= 0) return 8855;
-						}
-					}
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 246;
-					break;
-			}
-			break;
-		case 'p':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'r') {
-						if (length-- <= 0) return -1;
-						if ((ch = *src++) == 'a') {
-							if (length <= 0) return 182;
-						}
-						else if (ch == 't') {
-							if (length <= 0) return 8706;
-						}
-					}
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 'r') {
-						if (length-- <= 0) return -1;
-						if ((ch = *src++) == 'm') {
-							if (length-- >= 0 && *src++ == 'i')
-								if (length-- >= 0 && *src++ == 'l')
-									if (length <= 0) return 8240;
-						}
-						else if (ch == 'p') {
-							if (length <= 0) return 8869;
-						}
-					}
-					break;
-				case 'h':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length <= 0) return 966;
-					break;
-				case 'i':
-					if (length <= 0) return 960;
-					break;
-				case 'l':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 's')
-							if (length-- >= 0 && *src++ == 'm')
-								if (length-- >= 0 && *src++ == 'n')
-									if (length <= 0) return 177;
-					break;
-				case 'o':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length-- >= 0 && *src++ == 'n')
-							if (length-- >= 0 && *src++ == 'd')
-								if (length <= 0) return 163;
-					break;
-				case 'r':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'i') {
-						if (length-- >= 0 && *src++ == 'm')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 8242;
-					}
-					else if (ch == 'o') {
-						if (length-- <= 0) return -1;
-						if ((ch = *src++) == 'd') {
-							if (length <= 0) return 8719;
-						}
-						else if (ch == 'p') {
-							if (length <= 0) return 8733;
-						}
-					}
-					break;
-				case 's':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length <= 0) return 968;
-					break;
-			}
-			break;
-		case 'q':
-			if (length-- >= 0 && *src++ == 'u')
-				if (length-- >= 0 && *src++ == 'o')
-					if (length-- >= 0 && *src++ == 't')
-						if (length <= 0) return 34;
-			break;
-		case 'r':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'A':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8658;
-					break;
-				case 'a':
-					if (length-- <= 0) return -1;
-					switch (*src++) {
-						case 'd':
-							if (length-- >= 0 && *src++ == 'i')
-								if (length-- >= 0 && *src++ == 'c')
-									if (length <= 0) return 8730;
-							break;
-						case 'n':
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 9002;
-							break;
-						case 'q':
-							if (length-- >= 0 && *src++ == 'u')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length <= 0) return 187;
-							break;
-						case 'r':
-							if (length-- >= 0 && *src++ == 'r')
-								if (length <= 0) return 8594;
-							break;
-					}
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'e')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'l')
-								if (length <= 0) return 8969;
-					break;
-				case 'd':
-					if (length-- >= 0 && *src++ == 'q')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length <= 0) return 8221;
-					break;
-				case 'e':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'a') {
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 8476;
-					}
-					else if (ch == 'g') {
-						if (length <= 0) return 174;
-					}
-					break;
-				case 'f':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'o')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length-- >= 0 && *src++ == 'r')
-									if (length <= 0) return 8971;
-					break;
-				case 'h':
-					if (length-- >= 0 && *src++ == 'o')
-						if (length <= 0) return 961;
-					break;
-				case 'l':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length <= 0) return 8207;
-					break;
-				case 's':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'a') {
-						if (length-- >= 0 && *src++ == 'q')
-							if (length-- >= 0 && *src++ == 'u')
-								if (length-- >= 0 && *src++ == 'o')
-									if (length <= 0) return 8250;
-					}
-					else if (ch == 'q') {
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length <= 0) return 8217;
-					}
-					break;
-			}
-			break;
-		case 's':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'b':
-					if (length-- >= 0 && *src++ == 'q')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length <= 0) return 8218;
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'o')
-								if (length-- >= 0 && *src++ == 'n')
-									if (length <= 0) return 353;
-					break;
-				case 'd':
-					if (length-- >= 0 && *src++ == 'o')
-						if (length-- >= 0 && *src++ == 't')
-							if (length <= 0) return 8901;
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 't')
-							if (length <= 0) return 167;
-					break;
-				case 'h':
-					if (length-- >= 0 && *src++ == 'y')
-						if (length <= 0) return 173;
-					break;
-				case 'i':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'g') {
-						if (length-- >= 0 && *src++ == 'm') {
-							if (length-- >= 0 && *src++ == 'a') {
-								if (length <= 0) return 963;
-							}
-						}
-					}
-					else if (ch == 'm') {
-						if (length <= 0) return 8764;
-					}
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 'd')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length-- >= 0 && *src++ == 's')
-									if (length <= 0) return 9824;
-					break;
-				case 'u':
-					if (length-- <= 0) return -1;
-					switch (*src++) {
-						case 'b':
-							if (length <= 0) return 8834;
-							break;
-						case 'm':
-							if (length <= 0) return 8721;
-							break;
-						case 'p':
-							if (length <= 0) return 8835;
-							break;
-					}
-					break;
-				case 'z':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'g')
-								if (length <= 0) return 223;
-					break;
-			}
-			break;
-		case 't':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'u')
-						if (length <= 0) return 964;
-					break;
-				case 'h':
-					if (length-- <= 0) return -1;
-					switch (*src++) {
-						case 'e':
-							if (length-- <= 0) return -1;
-							if ((ch = *src++) == 'r') {
-								if (length-- >= 0 && *src++ == 'e')
-									if (length-- >= 0 && *src++ == '4')
-										if (length <= 0) return 8756;
-							}
-							else if (ch == 't') {
-								if (length-- >= 0 && *src++ == 'a') {
-									if (length <= 0) return 952;
-								}
-							}
-							break;
-						case 'i':
-							if (length-- >= 0 && *src++ == 'n')
-								if (length-- >= 0 && *src++ == 's')
-									if (length-- >= 0 && *src++ == 'p')
-										if (length <= 0) return 8201;
-							break;
-						case 'o':
-							if (length-- >= 0 && *src++ == 'r')
-								if (length-- >= 0 && *src++ == 'n')
-									if (length <= 0) return 254;
-							break;
-					}
-					break;
-				case 'i':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'l') {
-						if (length-- >= 0 && *src++ == 'd')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 732;
-					}
-					else if (ch == 'm') {
-						if (length-- >= 0 && *src++ == 'e')
-							if (length-- >= 0 && *src++ == 's')
-								if (length <= 0) return 215;
-					}
-					break;
-				case 'r':
-					if (length-- >= 0 && *src++ == 'a')
-						if (length-- >= 0 && *src++ == 'd')
-							if (length-- >= 0 && *src++ == 'e')
-								if (length <= 0) return 8482;
-					break;
-			}
-			break;
-		case 'u':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'A':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8657;
-					break;
-				case 'a':
-					if (length-- <= 0) return -1;
-					if ((ch = *src++) == 'c') {
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 250;
-					}
-					else if (ch == 'r') {
-						if (length-- >= 0 && *src++ == 'r')
-							if (length <= 0) return 8593;
-					}
-					break;
-				case 'c':
-					if (length-- >= 0 && *src++ == 'i')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'c')
-								if (length <= 0) return 251;
-					break;
-				case 'g':
-					if (length-- >= 0 && *src++ == 'r')
-						if (length-- >= 0 && *src++ == 'a')
-							if (length-- >= 0 && *src++ == 'v')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 249;
-					break;
-				case 'm':
-					if (length-- >= 0 && *src++ == 'l')
-						if (length <= 0) return 168;
-					break;
-				case 'p':
-					if (length-- >= 0 && *src++ == 's') {
-						if (length-- >= 0 && *src++ == 'i') {
-							if (length-- <= 0) return -1;
-							if ((ch = *src++) == 'h') {
-								if (length <= 0) return 978;
-							}
-							else if (ch == 'l') {
-								if (length-- >= 0 && *src++ == 'o')
-									if (length-- >= 0 && *src++ == 'n')
-										if (length <= 0) return 965;
-							}
-						}
-					}
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 252;
-					break;
-			}
-			break;
-		case 'v':
-			if (length-- >= 0 && *src++ == 'e')
-				if (length-- >= 0 && *src++ == 'l')
-					if (length-- >= 0 && *src++ == 'l')
-						if (length-- >= 0 && *src++ == 'i')
-							if (length-- >= 0 && *src++ == 'p')
-								if (length <= 0) return 8942;
-			break;
-		case 'w':
-			if (length-- >= 0 && *src++ == 'e')
-				if (length-- >= 0 && *src++ == 'i')
-					if (length-- >= 0 && *src++ == 'e')
-						if (length-- >= 0 && *src++ == 'r')
-							if (length-- >= 0 && *src++ == 'p')
-								if (length <= 0) return 8472;
-			break;
-		case 'x':
-			if (length-- >= 0 && *src++ == 'i')
-				if (length <= 0) return 958;
-			break;
-		case 'y':
-			if (length-- <= 0) return -1;
-			switch (*src++) {
-				case 'a':
-					if (length-- >= 0 && *src++ == 'c')
-						if (length-- >= 0 && *src++ == 'u')
-							if (length-- >= 0 && *src++ == 't')
-								if (length-- >= 0 && *src++ == 'e')
-									if (length <= 0) return 253;
-					break;
-				case 'e':
-					if (length-- >= 0 && *src++ == 'n')
-						if (length <= 0) return 165;
-					break;
-				case 'u':
-					if (length-- >= 0 && *src++ == 'm')
-						if (length-- >= 0 && *src++ == 'l')
-							if (length <= 0) return 255;
-					break;
-			}
-			break;
-		case 'z':
-			if (length-- <= 0) return -1;
-			if ((ch = *src++) == 'e') {
-				if (length-- >= 0 && *src++ == 't')
-					if (length-- >= 0 && *src++ == 'a')
-						if (length <= 0) return 950;
-			}
-			else if (ch == 'w') {
-				if (length-- <= 0) return -1;
-				if ((ch = *src++) == 'j') {
-					if (length <= 0) return 8205;
-				}
-				else if (ch == 'n') {
-					if (length-- >= 0 && *src++ == 'j')
-						if (length <= 0) return 8204;
-				}
-			}
-			break;
-	}
-	return -1;
+	return (Int32)entity->value;
 }
@@ -0,0 +1,513 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/string.h>
+#include <smile/bytesearch.h>
+#include <smile/utf8.h>
+#include <smile/codepage.h>
+#include <smile/internal/unicode.h>
+
+typedef struct KnownCodePageStruct {
+	Int id;
+	const UInt16 *toUnicode;
+	const Byte **fromUnicode;
+	const Int *numFromUnicodeTables;
+} KnownCodePage;
+
+#define KNOWN_CODE_PAGE(__id__, __tableName__) \
+	{ __id__, UnicodeTables_##__tableName__##ToUnicodeTable, \
+		UnicodeTables_UnicodeTo##__tableName__##Table, &UnicodeTables_UnicodeTo##__tableName__##TableCount }
+
+// Every known code page leaves ASCII alone, so they can all use the fast ASCII paths.
+static const KnownCodePage _knownCodePages[] = {
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_1, Iso_8859_1),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_2, Iso_8859_2),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_3, Iso_8859_3),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_4, Iso_8859_4),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_5, Iso_8859_5),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_6, Iso_8859_6),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_7, Iso_8859_7),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_8, Iso_8859_8),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_9, Iso_8859_9),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_10, Iso_8859_10),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_11, Iso_8859_11),
+	// There is no such thing as ISO 8859-12.
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_13, Iso_8859_13),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_14, Iso_8859_14),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_15, Iso_8859_15),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_ISO_8859_16, Iso_8859_16),
+
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_CP437, Cp437),
+
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1250, Windows1250),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1251, Windows1251),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1252, Windows1252),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1253, Windows1253),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1254, Windows1254),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1255, Windows1255),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1256, Windows1256),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1257, Windows1257),
+	KNOWN_CODE_PAGE(LEGACY_CODE_PAGE_WIN1258, Windows1258),
+};
+
+/// <summary>
+/// Describe a code page given only its conversion tables.
+/// </summary>
+/// <param name="codePage">The code-page description to fill in.</param>
+/// <param name="toUnicode">A 256-entry table describing the resulting Unicode code point for each byte
+/// in the code page (may be NULL if you only need to convert to the code page).</param>
+/// <param name="fromUnicode">A pointer to a table of pointers to 256-byte tables that describe how to
+/// convert each Unicode code point (may be NULL if you only need to convert from the code page).</param>
+/// <param name="numFromUnicodeTables">The number of 256-byte tables described.</param>
+void CodePage_Init(CodePage codePage, const UInt16 *toUnicode, const Byte **fromUnicode, Int numFromUnicodeTables)
+{
+	Int i;
+
+	codePage->id = 0;
+	codePage->toUnicode = toUnicode;
+	codePage->fromUnicode = fromUnicode;
+	codePage->numFromUnicodeTables = numFromUnicodeTables;
+
+	// Find out whether the tables leave ASCII alone, and if they do, ASCII can be copied in bulk.
+	codePage->isAsciiCompatible = True;
+	for (i = 0; i < 128; i++) {
+		if ((toUnicode != NULL && toUnicode[i] != i)
+			|| (fromUnicode != NULL && numFromUnicodeTables > 0 && fromUnicode[0][i] != i)) {
+			codePage->isAsciiCompatible = False;
+			break;
+		}
+	}
+}
+
+/// <summary>
+/// Describe one of the known legacy code pages.
+/// </summary>
+/// <param name="codePage">The code-page description to fill in.</param>
+/// <param name="legacyCodePageID">The ID of the known legacy code page (one of the LEGACY_CODE_PAGE_* values).</param>
+/// <returns>True if that code page is known, or False if it is not (in which case 'codePage' is left untouched).</returns>
+Bool CodePage_Get(CodePage codePage, Int legacyCodePageID)
+{
+	const KnownCodePage *known;
+
+	for (known = _knownCodePages; known < _knownCodePages + sizeof(_knownCodePages) / sizeof(KnownCodePage); known++) {
+		if (known->id == legacyCodePageID) {
+			codePage->id = known->id;
+			codePage->toUnicode = known->toUnicode;
+			codePage->fromUnicode = known->fromUnicode;
+			codePage->numFromUnicodeTables = *known->numFromUnicodeTables;
+			codePage->isAsciiCompatible = True;
+			return True;
+		}
+	}
+
+	return False;
+}
+
+/// <summary>
+/// Describe one of the known legacy code pages, by name.  Names are case-insensitive, and any
+/// hyphens, underscores, and spaces within them are ignored.  This accepts "iso-8859-N" and
+/// "latin-1", "windows-125N" and "cp125N", and "cp437" and "ibm437".
+/// </summary>
+/// <param name="codePage">The code-page description to fill in.</param>
+/// <param name="name">The name of the code page.</param>
+/// <returns>True if that code page is known, or False if it is not (in which case 'codePage' is left untouched).</returns>
+Bool CodePage_GetByName(CodePage codePage, const String name)
+{
+	Byte buffer[32];
+	const Byte *text, *digits;
+	Int length, i, dest, number;
+	Bool isIso;
+
+	if (name == NULL) return False;
+
+	// Reduce the name to lowercase letters and digits.
+	text = String_GetBytes(name);
+	length = String_Length(name);
+	for (i = 0, dest = 0; i < length; i++) {
+		Byte ch = text[i];
+		if (ch == '-' || ch == '_' || ch == ' ') continue;
+		if (dest >= 31) return False;
+		buffer[dest++] = (ch >= 'A' && ch <= 'Z') ? ch + 32 : ch;
+	}
+	buffer[dest] = '\0';
+
+	if (dest == 6 && !MemCmp(buffer, "latin1", 6))
+		return CodePage_Get(codePage, LEGACY_CODE_PAGE_ISO_8859_1);
+
+	isIso = False;
+	if (dest > 7 && !MemCmp(buffer, "iso8859", 7))
+		digits = buffer + 7, isIso = True;
+	else if (dest > 7 && !MemCmp(buffer, "windows", 7))
+		digits = buffer + 7;
+	else if (dest > 3 && !MemCmp(buffer, "ibm", 3))
+		digits = buffer + 3;
+	else if (dest > 2 && !MemCmp(buffer, "cp", 2))
+		digits = buffer + 2;
+	else return False;
+
+	// Whatever follows the prefix must be the code page's number, which is also its ID.
+	if (*digits == '0') return False;
+	for (number = 0; *digits >= '0' && *digits <= '9' && number < 100000; digits++)
+		number = number * 10 + (*digits - '0');
+	if (*digits != '\0') return False;
+
+	// The ISO 8859 parts are numbered 1-16, which don't overlap the others' numbers.
+	if (isIso != (number < 100)) return False;
+
+	return CodePage_Get(codePage, number);
+}
+
+/// <summary>
+/// Calculate how many bytes of UTF-8 it takes to encode one code point from a code page.
+/// </summary>
+Inline Int Utf8LengthOf(UInt16 value)
+{
+	return value < 0x80 ? 1 : value < 0x800 ? 2 : 3;
+}
+
+/// <summary>
+/// Write one code point from a code page as UTF-8.
+/// </summary>
+/// <returns>The next byte to write after it.</returns>
+Inline Byte *WriteUtf8(Byte *dest, UInt16 value)
+{
+	if (value < 0x80) {
+		*dest++ = (Byte)value;
+	}
+	else if (value < 0x800) {
+		*dest++ = (Byte)((value >> 6) | 0xC0);
+		*dest++ = (Byte)((value & 0x3F) | 0x80);
+	}
+	else {
+		*dest++ = (Byte)((value >> 12) | 0xE0);
+		*dest++ = (Byte)(((value >> 6) & 0x3F) | 0x80);
+		*dest++ = (Byte)((value & 0x3F) | 0x80);
+	}
+	return dest;
+}
+
+/// <summary>
+/// Calculate exactly how many bytes of UTF-8 CodePage_DecodeToUtf8() will produce for the given text.
+/// </summary>
+/// <param name="codePage">The code page the text is encoded in.</param>
+/// <param name="src">The text, encoded in that code page.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <returns>The length of the text once it is converted to UTF-8, in bytes.</returns>
+Int CodePage_MeasureUtf8(const CodePage codePage, const Byte *src, Int length)
+{
+	const UInt16 *toUnicode = codePage->toUnicode;
+	Int size = 0, i = 0;
+
+	if (!codePage->isAsciiCompatible) {
+		for (i = 0; i < length; i++)
+			size += Utf8LengthOf(toUnicode[src[i]]);
+		return size;
+	}
+
+	for (;;) {
+		// ASCII stays one byte each.
+		Int nonAscii = ByteSearch_IndexOfNonAscii(src, length, i);
+		size += nonAscii - i;
+		if ((i = nonAscii) >= length) break;
+
+		do {
+			size += Utf8LengthOf(toUnicode[src[i++]]);
+		} while (i < length && src[i] >= 0x80);
+	}
+
+	return size;
+}
+
+/// <summary>
+/// Convert text from a code page to UTF-8.  Every byte converts on its own, so a large file may be
+/// converted a chunk at a time, with no state carried from one chunk to the next.
+/// </summary>
+/// <param name="codePage">The code page the text is encoded in.</param>
+/// <param name="src">The text, encoded in that code page.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <param name="dest">The buffer to write the UTF-8 into.  This must have room for at least as many
+/// bytes as CodePage_MeasureUtf8() says (or 3 * length, which is always enough).</param>
+/// <returns>The number of bytes of UTF-8 written.</returns>
+Int CodePage_DecodeToUtf8(const CodePage codePage, const Byte *src, Int length, Byte *dest)
+{
+	const UInt16 *toUnicode = codePage->toUnicode;
+	Byte *start = dest;
+	Int i = 0;
+
+	if (!codePage->isAsciiCompatible) {
+		for (i = 0; i < length; i++)
+			dest = WriteUtf8(dest, toUnicode[src[i]]);
+		return dest - start;
+	}
+
+	for (;;) {
+		// Copy any run of ASCII straight through.
+		Int nonAscii = ByteSearch_IndexOfNonAscii(src, length, i);
+		MemCpy(dest, src + i, nonAscii - i);
+		dest += nonAscii - i;
+		if ((i = nonAscii) >= length) break;
+
+		// Then look up everything up to the next ASCII byte.
+		do {
+			dest = WriteUtf8(dest, toUnicode[src[i++]]);
+		} while (i < length && src[i] >= 0x80);
+	}
+
+	return dest - start;
+}
+
+/// <summary>
+/// Find how many bytes at the end of the given UTF-8 text are the start of a code point that is cut
+/// off by the end of the text.
+/// </summary>
+static Int IncompleteTailLength(const Byte *src, Int length)
+{
+	Int i, needed;
+	Byte b;
+
+	for (i = length - 1; i >= 0 && i >= length - 3; i--) {
+		b = src[i];
+		if ((b & 0xC0) == 0x80) continue;
+
+		needed = b >= 0xF0 ? 4 : b >= 0xE0 ? 3 : b >= 0xC0 ? 2 : 1;
+		return length - i < needed ? length - i : 0;
+	}
+
+	return 0;
+}
+
+/// <summary>
+/// Convert UTF-8 text to a code page.  Code points that the code page can't represent (and malformed
+/// UTF-8) become '?'.
+///
+/// A large file may be converted a chunk at a time:  Pass False for 'isFinal' for every chunk but
+/// the last, and any code point cut off at the end of a chunk will be left unconsumed, so that it
+/// can be passed again at the start of the next chunk.
+/// </summary>
+/// <param name="codePage">The code page to convert the text to.</param>
+/// <param name="src">The UTF-8 text to convert.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <param name="dest">The buffer to write the converted text into.  Each code point becomes one
+/// byte, so this must have room for at least 'length' bytes.</param>
+/// <param name="isFinal">True if this is the end of the text, or False if more text follows.</param>
+/// <param name="consumed">If not NULL, this will be set to how many bytes of the text were converted
+/// (always 'length' if 'isFinal' is True).</param>
+/// <returns>The number of bytes written.</returns>
+Int CodePage_EncodeFromUtf8(const CodePage codePage, const Byte *src, Int length, Byte *dest, Bool isFinal, Int *consumed)
+{
+	const Byte **fromUnicode = codePage->fromUnicode;
+	Int numFromUnicodeTables = codePage->numFromUnicodeTables;
+	const Byte *ptr;
+	Byte *start = dest;
+	Int32 value;
+	Int i = 0;
+
+	if (!isFinal)
+		length -= IncompleteTailLength(src, length);
+
+	while (i < length) {
+		if (codePage->isAsciiCompatible) {
+			// Copy any run of ASCII straight through.
+			Int nonAscii = ByteSearch_IndexOfNonAscii(src, length, i);
+			MemCpy(dest, src + i, nonAscii - i);
+			dest += nonAscii - i;
+			if ((i = nonAscii) >= length) break;
+		}
+		else if (src[i] < 0x80) {
+			*dest++ = fromUnicode[0][src[i++]];
+			continue;
+		}
+
+		ptr = src + i;
+		value = String_ExtractUnicodeCharacterInternal(&ptr, src + length);
+		i = ptr - src;
+		if (value < 0) value = 0xFFFD;
+
+		*dest++ = (value >> 8) < numFromUnicodeTables ? fromUnicode[value >> 8][value & 0xFF] : '?';
+	}
+
+	if (consumed != NULL)
+		*consumed = length;
+
+	return dest - start;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Clip a substring range to the string, the same way for each of the conversions below.
+/// </summary>
+/// <returns>True if there is anything left in the range, or False if it is empty.</returns>
+static Bool ClipRange(const String str, Int *start, Int *length)
+{
+	Int strLength = String_Length(str);
+
+	if (*start < 0) {
+		*length += *start;
+		*start = 0;
+	}
+
+	if (*length <= 0 || *start >= strLength)
+		return False;
+
+	if (*length > strLength - *start)
+		*length = strLength - *start;
+
+	return *length > 0;
+}
+
+/// <summary>
+/// Determine whether a substring range is valid UTF-8, using what is already known about the
+/// whole string if that's enough to tell.
+/// </summary>
+static Bool IsRangeValidUtf8(const String str, const Byte *text, Int start, Int length)
+{
+	// A range of valid UTF-8 is valid too, as long as it doesn't cut any code point in half.
+	if (String_IsValidUtf8(str))
+		return (text[start] & 0xC0) != 0x80
+			&& (start + length >= String_Length(str) || (text[start + length] & 0xC0) != 0x80);
+
+	return Utf8_FindInvalid(text + start, length, 0) >= length;
+}
+
+/// <summary>
+/// Convert a substring within a string from UTF-8 encoding to that of the given code page.
+/// </summary>
+static String ConvertUtf8ToCodePageRange(const String str, Int start, Int length, const CodePage codePage)
+{
+	const Byte *text;
+	String resultStr;
+	Int size, written;
+
+	if (!ClipRange(str, &start, &length))
+		return String_Empty;
+
+	text = String_GetBytes(str);
+
+	// Every code point becomes one byte, so valid UTF-8 can be sized exactly.  Malformed UTF-8
+	// may become fewer bytes than that, so it gets one conservative allocation instead.
+	size = IsRangeValidUtf8(str, text, start, length) ? Utf8_CountCodePoints(text + start, length) : length;
+
+	resultStr = String_CreateInternal(size);
+	written = CodePage_EncodeFromUtf8(codePage, text + start, length, resultStr->_opaque.text, True, NULL);
+	resultStr->_opaque.text[written] = '\0';
+	resultStr->_opaque.length = written;
+
+	return resultStr;
+}
+
+/// <summary>
+/// Convert a substring within a string from the given code page to UTF-8.
+/// </summary>
+static String ConvertCodePageToUtf8Range(const String str, Int start, Int length, const CodePage codePage)
+{
+	const Byte *text;
+	String resultStr;
+	Int size;
+
+	if (!ClipRange(str, &start, &length))
+		return String_Empty;
+
+	text = String_GetBytes(str);
+
+	size = CodePage_MeasureUtf8(codePage, text + start, length);
+	if (size == length && codePage->isAsciiCompatible
+		&& ByteSearch_IndexOfNonAscii(text, start + length, start) >= start + length)
+		return String_Substring(str, start, length);	// Pure ASCII converts to itself.
+
+	resultStr = String_CreateInternal(size);
+	CodePage_DecodeToUtf8(codePage, text + start, length, resultStr->_opaque.text);
+	resultStr->_opaque.text[size] = '\0';
+
+	return resultStr;
+}
+
+/// <summary>
+/// Convert a substring within a string from UTF-8 encoding to that described by the given legacy code-page tables.
+/// </summary>
+/// <param name="str">The string whose substring you would like to convert to a code page.</param>
+/// <param name="start">The start of the substring within that string.</param>
+/// <param name="length">The length of the substring within that string.</param>
+/// <param name="utf8ToCodePageTables">A pointer to a table of pointers to 256-byte tables that describe how to
+/// convert each Unicode code point.</param>
+/// <param name="numTables">The number of 256-byte tables described.</param>
+/// <returns>The given substring, converted to that code page.</returns>
+String String_ConvertUtf8ToCodePageRange(const String str, Int start, Int length, const Byte **utf8ToCodePageTables, Int numTables)
+{
+	struct CodePageStruct codePage;
+
+	if (str == NULL || String_Length(str) <= 0) return str;
+
+	CodePage_Init(&codePage, NULL, utf8ToCodePageTables, numTables);
+	return ConvertUtf8ToCodePageRange(str, start, length, &codePage);
+}
+
+/// <summary>
+/// Convert a substring within a string from a specific legacy code-page encoding to standard UTF-8.
+/// </summary>
+/// <param name="str">The string whose substring you would like to convert to UTF-8.</param>
+/// <param name="start">The start of the substring within that string.</param>
+/// <param name="length">The length of the substring within that string.</param>
+/// <param name="codePageToUtf8Table">A 256-entry table describing the resulting Unicode code point for each byte in the string.</param>
+/// <returns>The given substring, converted to UTF-8.</returns>
+String String_ConvertCodePageToUtf8Range(const String str, Int start, Int length, const UInt16 *codePageToUtf8Table)
+{
+	struct CodePageStruct codePage;
+
+	if (str == NULL || String_Length(str) <= 0) return str;
+
+	CodePage_Init(&codePage, codePageToUtf8Table, NULL, 0);
+	return ConvertCodePageToUtf8Range(str, start, length, &codePage);
+}
+
+/// <summary>
+/// Convert a substring within a string from UTF-8 encoding to that described by the given legacy code page.
+/// </summary>
+/// <param name="str">The string whose substring you would like to convert to a code page.</param>
+/// <param name="start">The start of the substring within that string.</param>
+/// <param name="length">The length of the substring within that string.</param>
+/// <param name="legacyCodePageID">The ID of the known legacy code-page.  If the code page is unknown, this will return the empty string.</param>
+/// <returns>The given substring, converted to that code page.</returns>
+String String_ConvertUtf8ToKnownCodePageRange(const String str, Int start, Int length, Int legacyCodePageID)
+{
+	struct CodePageStruct codePage;
+
+	if (!CodePage_Get(&codePage, legacyCodePageID))
+		return String_Empty;
+	if (str == NULL || String_Length(str) <= 0) return str;
+
+	return ConvertUtf8ToCodePageRange(str, start, length, &codePage);
+}
+
+/// <summary>
+/// Convert a substring within a string from a specific legacy code-page encoding to standard UTF-8.
+/// </summary>
+/// <param name="str">The string whose substring you would like to convert to UTF-8.</param>
+/// <param name="start">The start of the substring within that string.</param>
+/// <param name="length">The length of the substring within that string.</param>
+/// <param name="legacyCodePageID">The ID of the known legacy code-page.  If the code page is unknown, this will return the empty string.</param>
+/// <returns>The given substring, converted to UTF-8.</returns>
+String String_ConvertKnownCodePageToUtf8Range(const String str, Int start, Int length, Int legacyCodePageID)
+{
+	struct CodePageStruct codePage;
+
+	if (!CodePage_Get(&codePage, legacyCodePageID))
+		return String_Empty;
+	if (str == NULL || String_Length(str) <= 0) return str;
+
+	return ConvertCodePageToUtf8Range(str, start, length, &codePage);
+}
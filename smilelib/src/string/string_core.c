@@ -19,11 +19,18 @@
 #include <smile/mem.h>
 #include <smile/string.h>
 #include <smile/stringbuilder.h>
+#include <smile/bytesearch.h>
+#include <smile/utf8.h>
+#include <smile/env/gcstats.h>
 #include <smile/internal/types.h>
 
 // How big the text[] array is in the String's _opaque struct.
 #define STRING_TEXT_PADDING 65536
 
+// Substrings at least this long, of strings at least this long, are slices rather than copies.
+#define STRING_SLICE_MIN_LENGTH 64
+#define STRING_SLICE_MIN_PARENT_LENGTH 1024
+
 /// <summary>
 /// Construct a new String instance containing the given substring of text,
 /// starting at the given start index, going for the given length.
@@ -51,8 +58,9 @@ String String_Create(const Byte *text, Int length)
 
 	str = (String)GC_MALLOC_ATOMIC(sizeof(struct StringStruct) - STRING_TEXT_PADDING + length + 1);
 	if (str == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_STRING, sizeof(struct StringStruct) - STRING_TEXT_PADDING + length + 1);
 
-	str->kind = SMILE_KIND_STRING;
+	str->kind = SMILE_KIND_STRING | SMILE_FLAG_STRING_UNSCANNED;
 	str->vtable = (SmileVTable)&String_VTableData;
 	str->base = (SmileObject)&String_BaseObjectStruct;
 	str->_opaque.length = length;
@@ -79,8 +87,9 @@ String String_CreateInternal(Int length)
 
 	str = (String)GC_MALLOC_ATOMIC(sizeof(struct StringStruct) - STRING_TEXT_PADDING + length + 1);
 	if (str == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_STRING, sizeof(struct StringStruct) - STRING_TEXT_PADDING + length + 1);
 
-	str->kind = SMILE_KIND_STRING;
+	str->kind = SMILE_KIND_STRING | SMILE_FLAG_STRING_UNSCANNED;
 	str->vtable = (SmileVTable)&String_VTableData;
 	str->base = (SmileObject)&String_BaseObjectStruct;
 	str->_opaque.length = length;
@@ -372,13 +381,121 @@ Int String_CompareRange(const String a, Int astart, Int alength, const String b,
 	return 0;
 }
 
+/// <summary>
+/// Construct a slice that refers to the given range of a string's text without copying it.
+/// The range must lie within the string.
+/// </summary>
+static String String_CreateSlice(const String str, Int start, Int length)
+{
+	struct StringSliceStruct *slice;
+
+	// Slices are allocated as ordinary (not atomic) objects, so that the GC will trace the
+	// reference to the parent and keep its text alive for as long as the slice exists.
+	slice = GC_MALLOC_STRUCT(struct StringSliceStruct);
+	if (slice == NULL) Smile_Abort_OutOfMemory();
+	GCSTATS_RECORD_ALLOCATION(SMILE_KIND_STRING, sizeof(struct StringSliceStruct));
+
+	// Any part of an ASCII string is ASCII; but a part of valid UTF-8 may not be valid itself.
+	slice->kind = (str->kind & SMILE_FLAG_STRING_ASCII)
+		? SMILE_KIND_STRING | SMILE_FLAG_STRING_SLICE | SMILE_FLAG_STRING_SCANNED | SMILE_FLAG_STRING_ASCII | SMILE_FLAG_STRING_UTF8
+		: SMILE_KIND_STRING | SMILE_FLAG_STRING_SLICE | SMILE_FLAG_STRING_UNSCANNED;
+	slice->vtable = (SmileVTable)&String_VTableData;
+	slice->base = (SmileObject)&String_BaseObjectStruct;
+	slice->_opaque.length = length;
+	slice->_opaque.text = String_GetBytes(str) + start;
+	slice->_opaque.parent = String_IsSlice(str) ? ((struct StringSliceStruct *)str)->_opaque.parent : str;
+
+	return (String)slice;
+}
+
+/// <summary>
+/// Extract the given range of a string, either by copying it, or, if the range and the string
+/// are both large, by creating a slice that refers to the string's text.  The range must be
+/// nonempty and lie within the string.
+/// </summary>
+Inline String String_Extract(const String str, Int start, Int length)
+{
+	if (length >= STRING_SLICE_MIN_LENGTH && String_Length(str) >= STRING_SLICE_MIN_PARENT_LENGTH)
+		return String_CreateSlice(str, start, length);
+
+	return String_Create(String_GetBytes(str) + start, length);
+}
+
+/// <summary>
+/// Make a flat (non-slice) copy of a string, if it is a slice.  A slice keeps all of its parent
+/// string's text alive, so a small slice of a large string that will be kept for a long time
+/// should be compacted, so that the rest of the parent's text can be collected.
+/// </summary>
+/// <param name="str">The string to compact.</param>
+/// <returns>The string itself, if it is not a slice; or a flat copy of it, if it is.</returns>
+String String_Compact(const String str)
+{
+	if (!String_IsSlice(str))
+		return str;
+
+	return String_Create(String_GetBytes(str), String_Length(str));
+}
+
+/// <summary>
+/// Get a nul-terminated copy of a slice's text, for String_ToC().  If the slice runs to the
+/// end of its parent, the parent's nul terminator serves.  Otherwise, the slice is repointed
+/// at a flat copy of its text (which doesn't change its content, only where that content is
+/// stored), so that the copy is made at most once per slice.
+/// </summary>
+/// <param name="str">The slice to obtain the text of.</param>
+/// <returns>The slice's text, nul-terminated.</returns>
+const char *String_SliceToC(const String str)
+{
+	struct StringSliceStruct *slice = (struct StringSliceStruct *)str;
+	String parent = slice->_opaque.parent;
+	String copy;
+
+	if (slice->_opaque.text + slice->_opaque.length == String_GetBytes(parent) + String_Length(parent))
+		return (const char *)slice->_opaque.text;
+
+	copy = String_Create(slice->_opaque.text, slice->_opaque.length);
+	slice->_opaque.text = String_GetBytes(copy);
+	slice->_opaque.parent = copy;
+
+	return (const char *)slice->_opaque.text;
+}
+
+/// <summary>
+/// Scan a string's text to find out whether it is ASCII and whether it is valid UTF-8.  Strings
+/// on the heap record the result in their kind, so that each is scanned at most once; strings in
+/// static (readonly) memory can't, but they're short, and are simply scanned again each time.
+/// </summary>
+/// <param name="str">The string to scan.</param>
+/// <returns>The string's SMILE_FLAG_STRING_ASCII and SMILE_FLAG_STRING_UTF8 flags, along with
+/// SMILE_FLAG_STRING_SCANNED.</returns>
+UInt32 String_ScanText(const String str)
+{
+	const Byte *text = String_GetBytes(str);
+	Int length = String_Length(str);
+	Int nonAscii;
+	UInt32 flags;
+
+	nonAscii = ByteSearch_IndexOfNonAscii(text, length, 0);
+	if (nonAscii >= length)
+		flags = SMILE_FLAG_STRING_SCANNED | SMILE_FLAG_STRING_ASCII | SMILE_FLAG_STRING_UTF8;
+	else if (Utf8_FindInvalid(text, length, nonAscii) >= length)
+		flags = SMILE_FLAG_STRING_SCANNED | SMILE_FLAG_STRING_UTF8;
+	else
+		flags = SMILE_FLAG_STRING_SCANNED;
+
+	if (str->kind & SMILE_FLAG_STRING_UNSCANNED)
+		str->kind = (str->kind & ~SMILE_FLAG_STRING_UNSCANNED) | flags;
+
+	return flags;
+}
+
 /// <summary>
 /// Extract a substring from the given string that starts at the given index and continues
 /// to the end of the string.
 /// </summary>
 /// <param name="str">The string from which a substring will be extracted.</param>
 /// <param name="start">The starting offset within the string.  If this lies outside the string, it will be clipped to the string.</param>
-/// <returns>The extracted (copied) substring.</returns>
+/// <returns>The extracted substring (which may be a slice of the original string, if it is large).</returns>
 String String_SubstringAt(const String str, Int start)
 {
 	if (start < 0) {
@@ -387,7 +504,7 @@ String String_SubstringAt(const String str, Int start)
 	if (start >= String_Length(str))
 		return String_Empty;
 
-	return String_Create(String_GetBytes(str) + start, String_Length(str) - start);
+	return String_Extract(str, start, String_Length(str) - start);
 }
 
 /// <summary>
@@ -397,7 +514,7 @@ String String_SubstringAt(const String str, Int start)
 /// <param name="str">The string from which a substring will be extracted.</param>
 /// <param name="start">The starting offset within the string.  If this lies outside the string, it will be clipped to the string.</param>
 /// <param name="length">The number of bytes to copy from the string.  If this lies outside the string, it will be clipped to the string.</param>
-/// <returns>The extracted (copied) substring.</returns>
+/// <returns>The extracted substring (which may be a slice of the original string, if it is large).</returns>
 String String_Substring(const String str, Int start, Int length)
 {
 	if (start < 0) {
@@ -410,7 +527,7 @@ String String_Substring(const String str, Int start, Int length)
 		length = String_Length(str) - start;
 	}
 
-	return String_Create(String_GetBytes(str) + start, length);
+	return String_Extract(str, start, length);
 }
 
 /// <summary>
@@ -610,17 +727,7 @@ static Bool IsMatch(const Byte *text, const Byte *pattern, Int start, Int length
 /// string matches, this returns -1.</returns>
 Int String_IndexOf(const String str, const String pattern, Int start)
 {
-	Int end;
-
-	if (String_Length(pattern) > String_Length(str)) return -1;
-
-	if (start < 0) start = 0;
-
-	for (end = String_Length(str) - String_Length(pattern); start <= end; start++) {
-		if (IsMatch(String_GetBytes(str), String_GetBytes(pattern), start, String_Length(pattern)))
-			return start;
-	}
-	return -1;
+	return ByteSearch_IndexOf(String_GetBytes(str), String_Length(str), String_GetBytes(pattern), String_Length(pattern), start);
 }
 
 /// <summary>
@@ -634,24 +741,11 @@ Int String_IndexOf(const String str, const String pattern, Int start)
 /// string matches, this returns -1.</returns>
 Int String_LastIndexOf(const String str, const String pattern, Int start)
 {
-	Int slength, plength;
-
-	slength = String_Length(str);
-	plength = String_Length(pattern);
+	Int plength = String_Length(pattern);
 
-	if (plength > slength || start < plength) return -1;
+	if (start < plength) return -1;
 
-	start -= plength;
-	if (start >= slength - plength)
-	{
-		start = slength - plength;
-	}
-	for (; start >= 0; start--)
-	{
-		if (IsMatch(String_GetBytes(str), String_GetBytes(pattern), start, plength))
-			return start;
-	}
-	return -1;
+	return ByteSearch_LastIndexOf(String_GetBytes(str), String_Length(str), String_GetBytes(pattern), plength, start - plength);
 }
 
 /// <summary>
@@ -714,18 +808,7 @@ Bool String_EndsWith(const String str, const String pattern)
 /// string matches, this returns -1.</returns>
 Int String_IndexOfChar(const String str, Byte ch, Int start)
 {
-	const Byte *text;
-	Int end;
-
-	text = String_GetBytes(str);
-
-	for (end = String_Length(str); start < end; start++)
-	{
-		if (text[start] == ch)
-			return start;
-	}
-
-	return -1;
+	return ByteSearch_IndexOfByte(String_GetBytes(str), String_Length(str), ch, start);
 }
 
 /// <summary>
@@ -738,18 +821,7 @@ Int String_IndexOfChar(const String str, Byte ch, Int start)
 /// string matches, this returns -1.</returns>
 Int String_LastIndexOfChar(const String str, Byte ch, Int start)
 {
-	const Byte *text = String_GetBytes(str);
-
-	if (start >= String_Length(str) - 1)
-		start = String_Length(str) - 1;
-
-	for (; start >= 0; start--)
-	{
-		if (text[start] == ch)
-			return start;
-	}
-
-	return -1;
+	return ByteSearch_LastIndexOfByte(String_GetBytes(str), String_Length(str), ch, start);
 }
 
 /// <summary>
@@ -763,23 +835,7 @@ Int String_LastIndexOfChar(const String str, Byte ch, Int start)
 /// string matches any of the characters, this returns -1.</returns>
 Int String_IndexOfAnyChar(const String str, const Byte *chars, Int numChars, Int start)
 {
-	const Byte *text;
-	Byte ch;
-	Int end, i;
-
-	if (start < 0) start = 0;
-
-	text = String_GetBytes(str);
-
-	for (end = String_Length(str); start < end; start++) {
-		ch = text[start];
-		for (i = 0; i < numChars; i++) {
-			if (ch == chars[i])
-				return start;
-		}
-	}
-
-	return -1;
+	return ByteSearch_IndexOfAnyByte(String_GetBytes(str), String_Length(str), chars, numChars, start);
 }
 
 /// <summary>
@@ -792,6 +848,7 @@ Int String_IndexOfAnyChar(const String str, const Byte *chars, Int numChars, Int
 String String_Replace(const String str, const String pattern, const String replacement)
 {
 	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	struct ByteSearchStruct search;
 	String r;
 	const Byte *text, *patText, *repText;
 	Int lastEnd, index, patLength, repLength;
@@ -807,15 +864,16 @@ String String_Replace(const String str, const String pattern, const String repla
 	repLength = String_Length(r);
 
 	INIT_INLINE_STRINGBUILDER(stringBuilder);
+	ByteSearch_Init(&search, patText, patLength);
 
 	lastEnd = 0;
 	index = 0;
-	while ((index = String_IndexOf(str, pattern, index)) >= 0) {
+	while ((index = ByteSearch_Find(&search, text, String_Length(str), index)) >= 0) {
 		if (index > lastEnd) {
 			StringBuilder_Append(stringBuilder, text, lastEnd, index - lastEnd);
 		}
 		StringBuilder_Append(stringBuilder, repText, 0, repLength);
-		lastEnd = (index += String_Length(pattern));
+		lastEnd = (index += patLength);
 	}
 
 	if (lastEnd < String_Length(str)) {
@@ -837,6 +895,7 @@ String String_Replace(const String str, const String pattern, const String repla
 String String_ReplaceWithLimit(const String str, const String pattern, const String replacement, Int limit)
 {
 	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	struct ByteSearchStruct search;
 	String r;
 	const Byte *text, *patText, *repText;
 	Int lastEnd, index, patLength, repLength;
@@ -852,15 +911,16 @@ String String_ReplaceWithLimit(const String str, const String pattern, const Str
 	repLength = String_Length(r);
 
 	INIT_INLINE_STRINGBUILDER(stringBuilder);
+	ByteSearch_Init(&search, patText, patLength);
 
 	lastEnd = 0;
 	index = 0;
-	while (limit > 0 && (index = String_IndexOf(str, pattern, index)) >= 0) {
+	while (limit > 0 && (index = ByteSearch_Find(&search, text, String_Length(str), index)) >= 0) {
 		if (index > lastEnd) {
 			StringBuilder_Append(stringBuilder, text, lastEnd, index - lastEnd);
 		}
 		StringBuilder_Append(stringBuilder, repText, 0, repLength);
-		lastEnd = (index += String_Length(pattern));
+		lastEnd = (index += patLength);
 		limit--;
 	}
 
@@ -18,6 +18,7 @@
 #include <smile/gc.h>
 #include <smile/string.h>
 #include <smile/stringbuilder.h>
+#include <smile/bytesearch.h>
 #include <smile/internal/staticstring.h>
 #include <smile/smiletypes/smilelist.h>
 
@@ -36,6 +37,7 @@ STATIC_STRING(CommaSpace, ", ");
 Int String_SplitWithOptions(const String str, const String pattern, Int limit, Int options, String **pieces)
 {
 	struct ArrayStruct a;
+	struct ByteSearchStruct search;
 	Array array = &a;
 	Int startIndex, splitIndex, len;
 
@@ -46,7 +48,8 @@ Int String_SplitWithOptions(const String str, const String pattern, Int limit, I
 	startIndex = 0;
 
 	if (!String_IsNullOrEmpty(pattern)) {
-		while (limit > 0 && (splitIndex = String_IndexOf(str, pattern, startIndex)) >= 0) {
+		ByteSearch_Init(&search, String_GetBytes(pattern), String_Length(pattern));
+		while (limit > 0 && (splitIndex = ByteSearch_Find(&search, String_GetBytes(str), String_Length(str), startIndex)) >= 0) {
 			if (splitIndex == startIndex) {
 				if (!(options & StringSplitOptions_RemoveEmptyEntries)) {
 					*((String *)Array_Push(array)) = String_Empty;
@@ -102,6 +105,7 @@ Int String_SplitWithOptions(const String str, const String pattern, Int limit, I
 /// or the empty string, this will return zero.</returns>
 Int String_CountOf(const String str, const String pattern, Int start)
 {
+	struct ByteSearchStruct search;
 	Int index, patternLength;
 	Int count;
 	
@@ -112,7 +116,8 @@ Int String_CountOf(const String str, const String pattern, Int start)
 	count = 0;
 	index = start;
 
-	while ((index = String_IndexOf(str, pattern, index)) >= 0) {
+	ByteSearch_Init(&search, String_GetBytes(pattern), patternLength);
+	while ((index = ByteSearch_Find(&search, String_GetBytes(str), String_Length(str), index)) >= 0) {
 		count++;
 		index += patternLength;
 	}
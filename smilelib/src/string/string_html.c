@@ -20,46 +20,274 @@
 #include <smile/stringbuilder.h>
 #include <smile/internal/html.h>
 
+#include <string.h>
+
+#if SMILE_CPU == SMILE_CPU_X64
+	#include <emmintrin.h>
+#endif
+
+// Which of the encoders must escape each byte.
+#define HTML_ESCAPE 1
+#define URL_ESCAPE 2
+#define URL_QUERY_ESCAPE 4
+
+static const Byte _escapeTable[256] = {
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 2, 1, 6, 2, 6, 7, 2, 2, 2, 2, 2, 2, 0, 0, 2,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 1, 6, 1, 6,
+	2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+	6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+};
+
+static const char _hexDigits[] = "0123456789ABCDEF";
+
+//-------------------------------------------------------------------------------------------------
+//  Scanning for bytes that need escaping.
+
+/// <summary>
+/// Find the next byte that HTML-encoding must escape.
+/// </summary>
+/// <param name="text">The text to search.</param>
+/// <param name="start">Where to start searching.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="nonAscii">Whether bytes outside the ASCII range must be escaped too.</param>
+/// <returns>The index of the next byte to escape, or 'length' if there are none.</returns>
+static Int FindHtmlEscape(const Byte *text, Int start, Int length, Bool nonAscii)
+{
+#if SMILE_CPU == SMILE_CPU_X64
+	__m128i amp = _mm_set1_epi8('&'), lt = _mm_set1_epi8('<'), gt = _mm_set1_epi8('>'), quot = _mm_set1_epi8('\"');
+	__m128i v;
+	UInt32 mask;
+
+	for (; start + 16 <= length; start += 16) {
+		v = _mm_loadu_si128((const __m128i *)(text + start));
+		mask = (UInt32)_mm_movemask_epi8(_mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(v, amp), _mm_cmpeq_epi8(v, lt)),
+			_mm_or_si128(_mm_cmpeq_epi8(v, gt), _mm_cmpeq_epi8(v, quot))));
+		if (nonAscii)
+			mask |= (UInt32)_mm_movemask_epi8(v);
+		if (mask)
+			return start + UInt32_CountTrailingZeros(mask);
+	}
+#endif
+
+	for (; start < length; start++) {
+		if ((_escapeTable[text[start]] & HTML_ESCAPE) || (nonAscii && text[start] >= 128))
+			return start;
+	}
+	return length;
+}
+
+#if SMILE_CPU == SMILE_CPU_X64
+Inline __m128i InRange(__m128i v, char low, char high)
+{
+	// Bytes above 127 compare as negative, so they are never in range.
+	return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(high + 1)));
+}
+#endif
+
+/// <summary>
+/// Find the next byte that URL-encoding must escape.
+/// </summary>
+/// <param name="text">The text to search.</param>
+/// <param name="start">Where to start searching.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="flag">URL_ESCAPE or URL_QUERY_ESCAPE, for which kind of URL-encoding.</param>
+/// <returns>The index of the next byte to escape, or 'length' if there are none.</returns>
+static Int FindUrlEscape(const Byte *text, Int start, Int length, Byte flag)
+{
+	Int i;
+
+#if SMILE_CPU == SMILE_CPU_X64
+	// Letters, digits, '-', '.', and '_' are never escaped, and they make up most of most URLs, so
+	// any block of just those can be skipped without looking up each of its bytes.
+	__m128i v, safe;
+
+	for (; start + 16 <= length; start += 16) {
+		v = _mm_loadu_si128((const __m128i *)(text + start));
+		safe = _mm_or_si128(_mm_or_si128(InRange(v, '0', '9'), InRange(v, 'A', 'Z')),
+			_mm_or_si128(InRange(v, 'a', 'z'), InRange(v, '-', '.')));
+		safe = _mm_or_si128(safe, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+		if (_mm_movemask_epi8(safe) != 0xFFFF) {
+			for (i = start; i < start + 16; i++) {
+				if (_escapeTable[text[i]] & flag)
+					return i;
+			}
+		}
+	}
+#endif
+
+	for (i = start; i < length; i++) {
+		if (_escapeTable[text[i]] & flag)
+			return i;
+	}
+	return length;
+}
+
+/// <summary>
+/// Copy bytes to the output, if there is an output; either way, count them.
+/// </summary>
+Inline Int Emit(Byte *dest, Int size, const void *src, Int count)
+{
+	if (dest != NULL)
+		MemCpy(dest + size, src, count);
+	return size + count;
+}
+
+/// <summary>
+/// Create a string of exactly the given size, and fill it in using the given text-converting
+/// function (one that measures its output when its destination is NULL).
+/// </summary>
+#define CREATE_CONVERTED_STRING(__result__, __size__, __convert__) \
+	{ \
+		Byte *__dest__; \
+		(__result__) = String_CreateInternal(__size__); \
+		__dest__ = (Byte *)String_GetBytes(__result__); \
+		__convert__; \
+		__dest__[__size__] = '\0'; \
+	}
+
+/// <summary>
+/// Create a string from the output of the given decoding function.  Decoding never makes text
+/// longer, so the function decodes in a single pass into a scratch buffer as long as its input,
+/// and only the result is copied into an exactly-sized string.
+/// </summary>
+#define DECODE_TO_STRING(__result__, __length__, __size__, __convert__) \
+	{ \
+		Byte __localBuffer__[256]; \
+		Byte *__buffer__ = (__length__) <= 256 ? __localBuffer__ : GC_MALLOC_BYTES(__length__); \
+		if (__buffer__ == NULL) Smile_Abort_OutOfMemory(); \
+		(__size__) = __convert__; \
+		(__result__) = String_Create(__buffer__, __size__); \
+	}
+
+//-------------------------------------------------------------------------------------------------
+//  HTML encoding.
+
+/// <summary>
+/// Get the named entity for one of the four characters that HTML-encoding always escapes.
+/// </summary>
+Inline const char *GetHtmlEscape(Byte ch, Int *length)
+{
+	switch (ch) {
+		case '&': *length = 5; return "&amp;";
+		case '<': *length = 4; return "&lt;";
+		case '>': *length = 4; return "&gt;";
+		default: *length = 6; return "&quot;";
+	}
+}
+
+/// <summary>
+/// HTML-encode text, copying each run of text that needs no escaping in bulk.
+/// </summary>
+/// <param name="text">The text to encode.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="dest">Where to write the encoded text, or NULL to just measure it.</param>
+/// <returns>The length of the encoded text.</returns>
+static Int HtmlEncodeInto(const Byte *text, Int length, Byte *dest)
+{
+	Int i, next, size, escapeLength;
+	const char *escape;
+
+	for (i = 0, size = 0; ; i = next + 1) {
+		next = FindHtmlEscape(text, i, length, False);
+		size = Emit(dest, size, text + i, next - i);
+		if (next >= length) break;
+
+		escape = GetHtmlEscape(text[next], &escapeLength);
+		size = Emit(dest, size, escape, escapeLength);
+	}
+
+	return size;
+}
+
 /// <summary>
 /// Perform limited HTML-encoding on a string.  This will replace each of the four
 /// most special HTML characters, &lt;, &gt;, &amp;, and &quot, and encode them as &amp;lt;,
 /// &amp;gt;, &amp;amp;, and &amp;quot; respectively.
 /// </summary>
 /// <param name="str">The string to HTML-encode.</param>
-/// <returns>The resulting HTML-safe string.</returns>
+/// <returns>The resulting HTML-safe string (the original string, if nothing needed encoding).</returns>
 String String_HtmlEncode(const String str)
 {
-	StringBuilder stringBuilder;
-	Int i, length;
 	const Byte *text;
-	Byte ch;
-	
+	Int length, size;
+	String result;
+
+	if (String_IsNullOrEmpty(str)) return str;
+
 	length = String_Length(str);
 	text = String_GetBytes(str);
-	stringBuilder = StringBuilder_CreateWithSize(length + (length >> 2));
 
-	for (i = 0; i < length; i++) {
-		ch = text[i];
-		switch (ch) {
-			case '&':
-				StringBuilder_AppendC(stringBuilder, "&amp;", 0, 5);
-				break;
-			case '<':
-				StringBuilder_AppendC(stringBuilder, "&lt;", 0, 4);
-				break;
-			case '>':
-				StringBuilder_AppendC(stringBuilder, "&gt;", 0, 4);
-				break;
-			case '\"':
-				StringBuilder_AppendC(stringBuilder, "&quot;", 0, 6);
-				break;
-			default:
-				StringBuilder_AppendByte(stringBuilder, ch);
-				break;
+	// Every escape makes the text longer, so if it's no longer, there was nothing to escape.
+	size = HtmlEncodeInto(text, length, NULL);
+	if (size == length) return str;
+
+	CREATE_CONVERTED_STRING(result, size, HtmlEncodeInto(text, length, __dest__));
+	return result;
+}
+
+/// <summary>
+/// HTML-encode text to pure ASCII, copying each run of text that needs no escaping in bulk.
+/// </summary>
+/// <param name="text">The text to encode.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="dest">Where to write the encoded text, or NULL to just measure it.</param>
+/// <returns>The length of the encoded text.</returns>
+static Int HtmlEncodeToAsciiInto(const Byte *text, Int length, Byte *dest)
+{
+	Int i, next, size, escapeLength;
+	const char *escape;
+	const Byte *ptr;
+	String htmlEntityName;
+	Byte digits[16];
+	Int32 code;
+	Int numDigits;
+
+	for (i = 0, size = 0; ; i = next) {
+		next = FindHtmlEscape(text, i, length, True);
+		size = Emit(dest, size, text + i, next - i);
+		if (next >= length) break;
+
+		if (text[next] < 128) {
+			escape = GetHtmlEscape(text[next++], &escapeLength);
+			size = Emit(dest, size, escape, escapeLength);
+			continue;
+		}
+
+		ptr = text + next;
+		code = String_ExtractUnicodeCharacterInternal(&ptr, text + length);
+		next = ptr - text;
+		if (code < 0) code = 0xFFFD;
+
+		if (code < 10000 && (htmlEntityName = HtmlEntityValueToName(code)) != NULL) {
+			size = Emit(dest, size, "&", 1);
+			size = Emit(dest, size, String_GetBytes(htmlEntityName), String_Length(htmlEntityName));
+			size = Emit(dest, size, ";", 1);
+		}
+		else {
+			numDigits = 0;
+			do {
+				digits[sizeof(digits) - ++numDigits] = (Byte)('0' + code % 10);
+			} while ((code /= 10) > 0);
+			size = Emit(dest, size, "&#", 2);
+			size = Emit(dest, size, digits + sizeof(digits) - numDigits, numDigits);
+			size = Emit(dest, size, ";", 1);
 		}
 	}
 
-	return StringBuilder_ToString(stringBuilder);
+	return size;
 }
 
 /// <summary>
@@ -71,61 +299,29 @@ String String_HtmlEncode(const String str)
 /// </summary>
 /// <param name="str">The string to HTML-encode.</param>
 /// <returns>The resulting HTML-safe string, which will only consist of ASCII code values
-/// in the range of 0 to 127.</returns>
+/// in the range of 0 to 127 (the original string, if nothing needed encoding).</returns>
 String String_HtmlEncodeToAscii(const String str)
 {
-	StringBuilder stringBuilder;
-	Int i, length;
 	const Byte *text;
-	Byte ch;
-	Int32 code;
-	String htmlEntityName;
-	
-	length = String_Length(str);
-	text = String_GetBytes(str);
-
-	stringBuilder = StringBuilder_CreateWithSize(length + (length >> 2));
+	Int length, size;
+	String result;
 
-	for (i = 0; i < length; ) {
-		ch = text[i];
-		if (ch < 128) {
-			switch (ch) {
-			case '&':
-				StringBuilder_AppendC(stringBuilder, "&amp;", 0, 5);
-				break;
-			case '<':
-				StringBuilder_AppendC(stringBuilder, "&lt;", 0, 4);
-				break;
-			case '>':
-				StringBuilder_AppendC(stringBuilder, "&gt;", 0, 4);
-				break;
-			case '\"':
-				StringBuilder_AppendC(stringBuilder, "&quot;", 0, 6);
-				break;
-			default:
-				StringBuilder_AppendByte(stringBuilder, ch);
-				break;
-			}
-			i++;
-			continue;
-		}
+	if (String_IsNullOrEmpty(str)) return str;
 
-		code = String_ExtractUnicodeCharacter(str, &i);
-		if (code < 0) code = 0xFFFD;
+	length = String_Length(str);
+	text = String_GetBytes(str);
 
-		if (code < 10000 && (htmlEntityName = HtmlEntityValueToName(code)) != NULL) {
-			StringBuilder_AppendByte(stringBuilder, '&');
-			StringBuilder_AppendString(stringBuilder, htmlEntityName);
-			StringBuilder_AppendByte(stringBuilder, ';');
-		}
-		else {
-			StringBuilder_AppendFormat(stringBuilder, "&#%u;", code);
-		}
-	}
+	// Every escape makes the text longer, so if it's no longer, there was nothing to escape.
+	size = HtmlEncodeToAsciiInto(text, length, NULL);
+	if (size == length) return str;
 
-	return StringBuilder_ToString(stringBuilder);
+	CREATE_CONVERTED_STRING(result, size, HtmlEncodeToAsciiInto(text, length, __dest__));
+	return result;
 }
 
+//-------------------------------------------------------------------------------------------------
+//  HTML decoding.
+
 Inline Int32 ParseHtmlNamedEntity(const Byte *text, Int length, Int *index)
 {
 	Int start, i;
@@ -239,6 +435,73 @@ Inline Int32 ParseHtmlEntity(const Byte *text, Int length, Int *index)
 	}
 }
 
+/// <summary>
+/// Write a code point as UTF-8, the same way StringBuilder_AppendUnicode() does (including
+/// writing U+FFFD for anything that isn't a legal code point).
+/// </summary>
+/// <returns>The number of bytes written.</returns>
+Inline Int WriteUnicode(Byte *dest, UInt32 value)
+{
+	if (value >= 0x110000) value = 0xFFFD;
+
+	if (value < 0x80) {
+		dest[0] = (Byte)value;
+		return 1;
+	}
+	else if (value < 0x800) {
+		dest[0] = (Byte)((value >> 6) | 0xC0);
+		dest[1] = (Byte)((value & 0x3F) | 0x80);
+		return 2;
+	}
+	else if (value < 0x10000) {
+		dest[0] = (Byte)((value >> 12) | 0xE0);
+		dest[1] = (Byte)(((value >> 6) & 0x3F) | 0x80);
+		dest[2] = (Byte)((value & 0x3F) | 0x80);
+		return 3;
+	}
+	else {
+		dest[0] = (Byte)((value >> 18) | 0xF0);
+		dest[1] = (Byte)(((value >> 12) & 0x3F) | 0x80);
+		dest[2] = (Byte)(((value >> 6) & 0x3F) | 0x80);
+		dest[3] = (Byte)((value & 0x3F) | 0x80);
+		return 4;
+	}
+}
+
+/// <summary>
+/// Find the next instance of a byte in the given text.
+/// </summary>
+/// <returns>The index of that byte, or 'length' if it isn't there.</returns>
+Inline Int FindByte(const Byte *text, Int start, Int length, Byte ch)
+{
+	const Byte *found = start < length ? (const Byte *)memchr(text + start, ch, (size_t)(length - start)) : NULL;
+	return found != NULL ? found - text : length;
+}
+
+/// <summary>
+/// HTML-decode text, copying each run of text between entities in bulk.
+/// </summary>
+/// <param name="text">The text to decode.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="dest">Where to write the decoded text, which must have room for 'length' bytes.</param>
+/// <returns>The length of the decoded text.</returns>
+static Int HtmlDecodeInto(const Byte *text, Int length, Byte *dest)
+{
+	Int i, next, size;
+	Int32 uch;
+
+	for (i = 0, size = 0; ; i = next) {
+		next = FindByte(text, i, length, '&');
+		size = Emit(dest, size, text + i, next - i);
+		if (next >= length) break;
+
+		uch = ParseHtmlEntity(text, length, &next);
+		size += WriteUnicode(dest + size, (UInt32)uch);
+	}
+
+	return size;
+}
+
 /// <summary>
 /// Perform HTML-decoding on a string.  This will decode each of the four
 /// unsafe HTML characters, &lt;, &gt;, &amp;, and &quot, as well as apostrophe ('),
@@ -246,49 +509,76 @@ Inline Int32 ParseHtmlEntity(const Byte *text, Int length, Int *index)
 /// replacing them with their UTF-8-encoded Unicode code points.
 /// </summary>
 /// <param name="str">The string to HTML-decode.</param>
-/// <returns>The resulting decoded string.</returns>
+/// <returns>The resulting decoded string (the original string, if there was nothing to decode).</returns>
 String String_HtmlDecode(const String str)
 {
-	StringBuilder result;
-	Int i, length, start;
 	const Byte *text;
-	Byte ch;
-	Int32 uch;
+	Int length, size;
+	String result;
 
 	if (String_IsNullOrEmpty(str)) return str;
 
-	result = NULL;
 	length = String_Length(str);
 	text = String_GetBytes(str);
 
-	for (i = 0; i < length; ) {
-		// Copy non-escaped characters.
-		start = i;
-		ch = '\0';
-		while (i < length && (ch = text[i]) != '&') i++;
-
-		// If there are any non-escaped characters, copy them to the output.
-		if (i > start) {
-			// If the non-escaped content is the whole string, then just return it verbatim.
-			if (i == length && start == 0)
-				return str;
-
-			// Copy the non-escaped part to the StringBuilder.
-			if (result == NULL)
-				result = StringBuilder_CreateWithSize(length);
-			StringBuilder_Append(result, text, start, i - start);
-		}
+	if (FindByte(text, 0, length, '&') >= length)
+		return str;
 
-		// If we reached a '&', process the character escape (or degenerate form).
-		if (ch == '&') {
-			uch = ParseHtmlEntity(text, length, &i);
-			if (result == NULL)
-				result = StringBuilder_CreateWithSize(length);
-			StringBuilder_AppendUnicode(result, uch);
-		}
+	DECODE_TO_STRING(result, length, size, HtmlDecodeInto(text, length, __buffer__));
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  URL encoding and decoding.
+
+/// <summary>
+/// URL-encode text, copying each run of text that needs no escaping in bulk.
+/// </summary>
+/// <param name="text">The text to encode.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="dest">Where to write the encoded text, or NULL to just measure it.</param>
+/// <param name="flag">URL_ESCAPE or URL_QUERY_ESCAPE, for which kind of URL-encoding.</param>
+/// <returns>The length of the encoded text.</returns>
+static Int UrlEncodeInto(const Byte *text, Int length, Byte *dest, Byte flag)
+{
+	Int i, next, size;
+	Byte escape[3];
+
+	escape[0] = '%';
+
+	for (i = 0, size = 0; ; i = next + 1) {
+		next = FindUrlEscape(text, i, length, flag);
+		size = Emit(dest, size, text + i, next - i);
+		if (next >= length) break;
+
+		escape[1] = _hexDigits[text[next] >> 4];
+		escape[2] = _hexDigits[text[next] & 0xF];
+		size = Emit(dest, size, escape, 3);
 	}
 
-	return StringBuilder_ToString(result);
+	return size;
+}
+
+/// <summary>
+/// URL-encode a string, escaping the bytes that the given kind of URL-encoding escapes.
+/// </summary>
+static String UrlEncode(const String str, Byte flag)
+{
+	const Byte *text;
+	Int length, size;
+	String result;
+
+	if (String_IsNullOrEmpty(str)) return str;
+
+	length = String_Length(str);
+	text = String_GetBytes(str);
+
+	// Every escape makes the text longer, so if it's no longer, there was nothing to escape.
+	size = UrlEncodeInto(text, length, NULL, flag);
+	if (size == length) return str;
+
+	CREATE_CONVERTED_STRING(result, size, UrlEncodeInto(text, length, __dest__, flag));
+	return result;
 }
 
 /// <summary>
@@ -299,37 +589,10 @@ String String_HtmlDecode(const String str)
 ///        !  *  '  ;  :  @  &  =  +  $  ,  /  ?  #  %  (  )  [  ]
 /// </summary>
 /// <param name="str">The string to URL-encode.</param>
-/// <returns>The resulting encoded string.</returns>
+/// <returns>The resulting encoded string (the original string, if nothing needed encoding).</returns>
 String String_UrlEncode(const String str)
 {
-	Byte ch;
-	StringBuilder stringBuilder;
-	const Byte *text;
-	Int i, length;
-
-	length = String_Length(str);
-	text = String_GetBytes(str);
-	stringBuilder = StringBuilder_CreateWithSize(length * 2);
-
-	for (i = 0; i < length; i++) {
-		switch (ch = text[i]) {
-			default:
-				if (ch <= 32 || ch >= 127)
-					goto encode;
-				StringBuilder_AppendByte(stringBuilder, ch);
-				break;
-
-			case '!': case '*': case '\'': case ';': case ':':
-			case '@': case '&': case '=': case '+': case '$':
-			case ',': case '/': case '?': case '#': case '%':
-			case '(': case ')': case '[': case ']':
-			encode:
-				StringBuilder_AppendFormat(stringBuilder, "%%%02X", (UInt)ch);
-				break;
-		}
-	}
-
-	return StringBuilder_ToString(stringBuilder);
+	return UrlEncode(str, URL_ESCAPE);
 }
 
 /// <summary>
@@ -341,34 +604,10 @@ String String_UrlEncode(const String str)
 /// and the five special characters in this set:   &  =  ?  #  %
 /// </summary>
 /// <param name="str">The string to URL-query-encode.</param>
-/// <returns>The resulting encoded string.</returns>
+/// <returns>The resulting encoded string (the original string, if nothing needed encoding).</returns>
 String String_UrlQueryEncode(const String str)
 {
-	Byte ch;
-	StringBuilder stringBuilder;
-	const Byte *text;
-	Int i, length;
-
-	length = String_Length(str);
-	text = String_GetBytes(str);
-	stringBuilder = StringBuilder_CreateWithSize(length * 2);
-
-	for (i = 0; i < length; i++) {
-		switch (ch = text[i]) {
-			default:
-				if (ch <= 32 || ch >= 127)
-					goto encode;
-				StringBuilder_AppendByte(stringBuilder, ch);
-				break;
-
-			case '&': case '=': case '?': case '#': case '%':
-			encode :
-				StringBuilder_AppendFormat(stringBuilder, "%%%02X", (UInt)ch);
-				   break;
-		}
-	}
-
-	return StringBuilder_ToString(stringBuilder);
+	return UrlEncode(str, URL_QUERY_ESCAPE);
 }
 
 Inline Byte DecodeHex(Byte ch)
@@ -419,38 +658,56 @@ Inline Bool IsHex(Byte ch)
 	}
 }
 
+/// <summary>
+/// URL-decode text, copying each run of text between escapes in bulk.
+/// </summary>
+/// <param name="text">The text to decode.</param>
+/// <param name="length">The length of the text.</param>
+/// <param name="dest">Where to write the decoded text, which must have room for 'length' bytes.</param>
+/// <returns>The length of the decoded text.</returns>
+static Int UrlDecodeInto(const Byte *text, Int length, Byte *dest)
+{
+	Int i, next, size;
+	Byte c1, c2, value;
+
+	for (i = 0, size = 0; ; i = next + 1) {
+		next = FindByte(text, i, length, '%');
+		size = Emit(dest, size, text + i, next - i);
+		if (next >= length) break;
+
+		if (next + 2 < length && IsHex(c1 = text[next + 1]) && IsHex(c2 = text[next + 2])) {
+			value = (DecodeHex(c1) << 4) | DecodeHex(c2);
+			size = Emit(dest, size, &value, 1);
+			next += 2;
+		}
+		else {
+			size = Emit(dest, size, "%", 1);
+		}
+	}
+
+	return size;
+}
+
 /// <summary>
 /// Perform URL-decoding on a string, decoding any characters encoded using the "%XX"
 /// form as replacement 8-bit character values.
 /// </summary>
 /// <param name="str">The string to URL-decode.</param>
-/// <returns>The resulting decoded string.</returns>
+/// <returns>The resulting decoded string (the original string, if there was nothing to decode).</returns>
 String String_UrlDecode(const String str)
 {
-	Byte ch, c1, c2, value;
-	StringBuilder stringBuilder;
 	const Byte *text;
-	Int i, length, start;
+	Int length, size;
+	String result;
+
+	if (String_IsNullOrEmpty(str)) return str;
 
 	length = String_Length(str);
 	text = String_GetBytes(str);
-	stringBuilder = StringBuilder_CreateWithSize(length);
 
-	for (i = 0; i < length; i++) {
-		start = i;
-		while (i < length && (ch = text[i]) != '%') i++;
-		if (i > start) {
-			StringBuilder_Append(stringBuilder, text, start, i - start);
-		}
-		if (i + 2 < length && IsHex(c1 = text[i + 1]) && IsHex(c2 = text[i + 2])) {
-			value = (DecodeHex(c1) << 4) | DecodeHex(c2);
-			StringBuilder_AppendByte(stringBuilder, value);
-			i += 2;
-		}
-		else if (i < length) {
-			StringBuilder_AppendByte(stringBuilder, '%');
-		}
-	}
+	if (FindByte(text, 0, length, '%') >= length)
+		return str;
 
-	return StringBuilder_ToString(stringBuilder);
+	DECODE_TO_STRING(result, length, size, UrlDecodeInto(text, length, __buffer__));
+	return result;
 }
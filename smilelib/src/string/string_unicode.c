@@ -18,8 +18,13 @@
 #include <smile/gc.h>
 #include <smile/string.h>
 #include <smile/stringbuilder.h>
+#include <smile/foldsearch.h>
 #include <smile/internal/unicode.h>
 
+#if SMILE_CPU == SMILE_CPU_X64
+	#include <emmintrin.h>
+#endif
+
 static Byte GetCombiningClass(UInt32 ch);
 static void SortCombiningCharacters(UInt32 *buffer, UInt32 *temp, Int start, Int length);
 
@@ -47,6 +52,96 @@ static const Int32 _identityTable[] =
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 };
 
+/// <summary>
+/// How a conversion changes ASCII:  Every byte from 'first' through 'last' has 'delta' added to
+/// it, and every other ASCII byte is left alone.  These must agree with the ASCII page of each
+/// conversion's Unicode table; they exist so that ASCII can be found and converted in bulk.
+/// </summary>
+typedef struct AsciiMappingStruct {
+	Byte first, last;
+	SByte delta;
+} AsciiMapping;
+
+static const AsciiMapping _asciiToLower = { 'A', 'Z', 'a' - 'A' };
+static const AsciiMapping _asciiToUpper = { 'a', 'z', 'A' - 'a' };
+static const AsciiMapping _asciiUnchanged = { 1, 0, 0 };
+
+/// <summary>
+/// Search forward through ASCII text for the first byte that the given mapping would change,
+/// or the first non-ASCII byte, whichever comes first.
+/// </summary>
+/// <returns>The index of that byte, or 'end' if there is none.</returns>
+static Int FindAsciiChange(const Byte *text, Int start, Int end, const AsciiMapping *mapping)
+{
+	Byte ch;
+
+#if SMILE_CPU == SMILE_CPU_X64
+	// ASCII bytes are all positive as signed bytes, and non-ASCII bytes are all negative, so one
+	// signed range check finds the bytes to change, and the sign bits find the non-ASCII bytes.
+	__m128i below = _mm_set1_epi8((char)(mapping->first - 1));
+	__m128i above = _mm_set1_epi8((char)(mapping->last + 1));
+	__m128i x, inRange;
+	UInt32 mask;
+
+	for (; start + 16 <= end; start += 16) {
+		x = _mm_loadu_si128((const __m128i *)(text + start));
+		inRange = _mm_and_si128(_mm_cmpgt_epi8(x, below), _mm_cmplt_epi8(x, above));
+		mask = (UInt32)_mm_movemask_epi8(_mm_or_si128(inRange, x));
+		if (mask)
+			return start + (Int)UInt32_CountTrailingZeros(mask);
+	}
+#endif
+
+	for (; start < end; start++) {
+		ch = text[start];
+		if (ch >= 128 || (ch >= mapping->first && ch <= mapping->last))
+			return start;
+	}
+
+	return end;
+}
+
+/// <summary>
+/// Apply the given mapping, in place, to a run of ASCII text.
+/// </summary>
+static void MapAscii(Byte *text, Int length, const AsciiMapping *mapping)
+{
+	Int i = 0;
+	Byte ch;
+
+	if (mapping->delta == 0) return;
+
+#if SMILE_CPU == SMILE_CPU_X64
+	{
+		__m128i below = _mm_set1_epi8((char)(mapping->first - 1));
+		__m128i above = _mm_set1_epi8((char)(mapping->last + 1));
+		__m128i delta = _mm_set1_epi8((char)mapping->delta);
+		__m128i x, inRange;
+
+		for (; i + 16 <= length; i += 16) {
+			x = _mm_loadu_si128((const __m128i *)(text + i));
+			inRange = _mm_and_si128(_mm_cmpgt_epi8(x, below), _mm_cmplt_epi8(x, above));
+			_mm_storeu_si128((__m128i *)(text + i), _mm_add_epi8(x, _mm_and_si128(inRange, delta)));
+		}
+	}
+#endif
+
+	for (; i < length; i++) {
+		ch = text[i];
+		if (ch >= mapping->first && ch <= mapping->last)
+			text[i] = (Byte)(ch + mapping->delta);
+	}
+}
+
+/// <summary>
+/// Return a range of a string that a conversion left unchanged:  The string itself, if the
+/// range covers all of it, so that converting already-converted text doesn't allocate.
+/// </summary>
+Inline String UnchangedRange(const String str, Int start, Int length)
+{
+	return start == 0 && length == String_Length(str) ? (String)str : String_Substring(str, start, length);
+}
+
 /// <summary>
 /// Read from the string at the given index, extracting a complete Unicode character (code point)
 /// that has been encoded in UTF-8 form.
@@ -403,28 +498,58 @@ UInt32 Uni_CaseFold(UInt32 codePoint)
 		UnicodeTables_CaseFoldingTableCount);
 }
 
+/// <summary>
+/// Search forward through a range of text for the first code point that a case conversion
+/// would change.
+/// </summary>
+/// <returns>The byte index of that code point, or 'end' if the conversion changes nothing.</returns>
+static Int FindFirstCaseChange(const Byte *text, Int start, Int end, const AsciiMapping *asciiMapping, const Int32 **caseTable, Int32 caseTableCount)
+{
+	const Byte *ptr;
+	Int32 code, codePageIndex;
+
+	for (;;) {
+		start = FindAsciiChange(text, start, end, asciiMapping);
+		if (start >= end || text[start] < 128)
+			return start;
+
+		// Malformed UTF-8 will be replaced, so it counts as a change.
+		ptr = text + start;
+		code = String_ExtractUnicodeCharacterInternal(&ptr, text + end);
+		if (code < 0)
+			return start;
+
+		codePageIndex = code >> 8;
+		if (codePageIndex < caseTableCount && caseTable[codePageIndex][code & 0xFF] != 0)
+			return start;
+
+		start = ptr - text;
+	}
+}
+
 /// <summary>
 /// Shared case-conversion function, using a common lookup-table structure shared by all of the case-conversion functions.
 /// </summary>
 /// <param name="str">The string whose substring you would like to convert.</param>
 /// <param name="start">The start of the substring within that string.</param>
 /// <param name="length">The length of the substring within that string.</param>
+/// <param name="asciiMapping">How this conversion changes ASCII, which must agree with the caseTable.</param>
 /// <param name="caseTable">A pointer to the caseTable, which is itself pointers to 256-character tables containing code-point deltas.
 /// A delta which results in a code point of zero will be looked up against the extended table, as it converts to multiple characters.</param>
 /// <param name="caseTableExtended">A pointer to the caseTableExtended, which is similar to the caseTable, but which contains sequences
 /// of code points for each converted code point instead of individual code points.  Only used if the code point delta in the caseTable results
 /// in a zero.</param>
 /// <param name="caseTableCount">The number of pointers to 256-code-point tables found within the caseTable/castTableExtended pointer tables.</param>
-/// <returns>The case-converted string.</returns>
-static String ConvertCase(const String str, Int start, Int length, const Int32 **caseTable, const Int32 ***caseTableExtended, Int32 caseTableCount)
+/// <returns>The case-converted string (or the original string, if converting it would change nothing).</returns>
+static String ConvertCase(const String str, Int start, Int length, const AsciiMapping *asciiMapping,
+	const Int32 **caseTable, const Int32 ***caseTableExtended, Int32 caseTableCount)
 {
 	struct StringBuilderInt sb;
 	StringBuilder stringBuilder;
 	Int32 code, codePageIndex, newCodeValue, numCodeValues;
-	const Int32 *zeroCodePage, *codePage, *codeValues;
+	const Int32 *codePage, *codeValues;
 	const Int32 **extendedCodePage;
-	Int i;
-	Byte ch;
+	Int i, end, runEnd, oldLength;
 	const Byte *text;
 
 	if (String_IsNullOrEmpty(str)) return (String)str;
@@ -443,19 +568,30 @@ static String ConvertCase(const String str, Int start, Int length, const Int32 *
 		length = String_Length(str) - start;
 	}
 
+	text = String_GetBytes(str);
+	end = start + length;
+
+	// Most text is already in the requested form, or at least starts with a long run that is,
+	// and that run can be found much faster than it can be converted.
+	i = FindFirstCaseChange(text, start, end, asciiMapping, caseTable, caseTableCount);
+	if (i >= end)
+		return UnchangedRange(str, start, length);
+
 	stringBuilder = (StringBuilder)&sb;
-	StringBuilder_InitWithSize(stringBuilder, String_Length(str) * 5 / 4);
+	StringBuilder_InitWithSize(stringBuilder, length * 5 / 4);
 
-	zeroCodePage = caseTable[0];
+	StringBuilder_Append(stringBuilder, text, start, i - start);
 
-	text = String_GetBytes(str);
-	for (i = start; i < start + length; )
+	while (i < end)
 	{
-		ch = text[i];
-		if (ch < 128)
+		if (text[i] < 128)
 		{
-			i++;
-			StringBuilder_AppendByte(stringBuilder, (Byte)(ch + zeroCodePage[ch]));
+			// Copy the whole run of ASCII at once, and then convert it in place.
+			runEnd = ByteSearch_IndexOfNonAscii(text, end, i);
+			oldLength = sb.length;
+			StringBuilder_Append(stringBuilder, text, i, runEnd - i);
+			MapAscii(sb.text + oldLength, runEnd - i, asciiMapping);
+			i = runEnd;
 		}
 		else
 		{
@@ -494,7 +630,7 @@ static String ConvertCase(const String str, Int start, Int length, const Int32 *
 /// <returns>The whole string, with the given substring converted to lowercase.</returns>
 String String_ToLowerRange(const String str, Int start, Int length)
 {
-	return ConvertCase(str, start, length,
+	return ConvertCase(str, start, length, &_asciiToLower,
 		UnicodeTables_LowercaseTable,
 		UnicodeTables_LowercaseTableFullExtended,
 		UnicodeTables_LowercaseTableCount);
@@ -510,7 +646,7 @@ String String_ToLowerRange(const String str, Int start, Int length)
 /// <returns>The whole string, with the given substring converted to titlecase.</returns>
 String String_ToTitleRange(const String str, Int start, Int length)
 {
-	return ConvertCase(str, start, length,
+	return ConvertCase(str, start, length, &_asciiToUpper,
 		UnicodeTables_TitlecaseTable,
 		UnicodeTables_TitlecaseTableFullExtended,
 		UnicodeTables_TitlecaseTableCount);
@@ -526,7 +662,7 @@ String String_ToTitleRange(const String str, Int start, Int length)
 /// <returns>The whole string, with the given substring converted to uppercase.</returns>
 String String_ToUpperRange(const String str, Int start, Int length)
 {
-	return ConvertCase(str, start, length,
+	return ConvertCase(str, start, length, &_asciiToUpper,
 		UnicodeTables_UppercaseTable,
 		UnicodeTables_UppercaseTableFullExtended,
 		UnicodeTables_UppercaseTableCount);
@@ -542,7 +678,7 @@ String String_ToUpperRange(const String str, Int start, Int length)
 /// <returns>The whole string, with the given substring case-folded.</returns>
 String String_CaseFoldRange(const String str, Int start, Int length)
 {
-	return ConvertCase(str, start, length,
+	return ConvertCase(str, start, length, &_asciiToLower,
 		UnicodeTables_CaseFoldingTable,
 		UnicodeTables_CaseFoldingTableFullExtended,
 		UnicodeTables_CaseFoldingTableCount);
@@ -558,12 +694,50 @@ String String_CaseFoldRange(const String str, Int start, Int length)
 /// <returns>The whole string, with the given substring case-folded.</returns>
 String String_DecomposeRange(const String str, Int start, Int length)
 {
-	return ConvertCase(str, start, length,
+	return ConvertCase(str, start, length, &_asciiUnchanged,
 		UnicodeTables_DecompositionTable,
 		UnicodeTables_DecompositionTableExtended,
 		UnicodeTables_DecompositionTableCount);
 }
 
+/// <summary>
+/// Search forward through a range of text for the first place that composing it might change it.
+/// Only the code points marked in the compose quick-check table can ever be merged into the
+/// code point before them, so a range without any of those (or any malformed UTF-8) is already
+/// as composed as it can be.
+/// </summary>
+/// <returns>The byte index of the code point just before the first one that may be merged into
+/// it (or just before the first malformed code point), or 'end' if composing the range would
+/// change nothing.</returns>
+static Int FindFirstComposition(const Byte *text, Int start, Int end)
+{
+	const Byte *ptr;
+	Int32 code, codePageIndex;
+	Int prev = start, next;
+
+	for (;;) {
+		next = ByteSearch_IndexOfNonAscii(text, end, start);
+		if (next >= end)
+			return end;
+		if (next > start)
+			prev = next - 1;
+		start = next;
+
+		ptr = text + start;
+		code = String_ExtractUnicodeCharacterInternal(&ptr, text + end);
+		if (code < 0)
+			return prev;
+
+		codePageIndex = code >> 8;
+		if (codePageIndex < UnicodeTables_ComposeQuickCheckTableCount
+			&& UnicodeTables_ComposeQuickCheckTable[codePageIndex][code & 0xFF])
+			return prev;
+
+		prev = start;
+		start = ptr - text;
+	}
+}
+
 /// <summary>
 /// Extract a substring from the given string, and then compose any decomposed characters in
 /// it so that all combining diacritics and compound characters are joined to result in as few
@@ -572,7 +746,8 @@ String String_DecomposeRange(const String str, Int start, Int length)
 /// <param name="str">The string whose substring you would like to compose.</param>
 /// <param name="start">The start of the substring within that string.</param>
 /// <param name="length">The length of the substring within that string.</param>
-/// <returns>The whole string, with the given substring composed.</returns>
+/// <returns>The whole string, with the given substring composed (or the original string, if
+/// composing it would change nothing).</returns>
 String String_ComposeRange(const String str, Int start, Int length)
 {
 	Int i;
@@ -599,11 +774,17 @@ String String_ComposeRange(const String str, Int start, Int length)
 	if (length > strLength - start)
 		length = strLength - start;
 
+	// Most text is already composed, and anything before the first possible composition can
+	// be copied as-is.
+	i = FindFirstComposition(text, start, start + length);
+	if (i >= start + length)
+		return UnchangedRange(str, start, length);
+
 	stringBuilder = StringBuilder_CreateWithSize(length * 5 / 4);
+	StringBuilder_Append(stringBuilder, text, start, i - start);
 
 	// These four variables will act like a shift register.
 	a = 0, b = -1, c = -1, d = -1;
-	i = start;
 
 	// Loop until the shift register becomes empty.  We prepopulate it with a zero value
 	// that it will lose on the first shift; after that, it will be populated by incoming codes.
@@ -658,19 +839,59 @@ String String_ComposeRange(const String str, Int start, Int length)
 	return StringBuilder_ToString(stringBuilder);
 }
 
+/// <summary>
+/// Search forward through a range of text for the first run of combining characters that is
+/// not already in canonical order.
+/// </summary>
+/// <returns>The byte index of the start of that run (or of the first malformed code point, or of
+/// the run containing it), or 'end' if normalizing the range would change nothing.</returns>
+static Int FindFirstMisordering(const Byte *text, Int start, Int end)
+{
+	const Byte *ptr;
+	Int32 code;
+	Byte canonicalCombiningClass, lastCombiningClass = 0;
+	Int runStart = start, next;
+
+	for (;;) {
+		next = ByteSearch_IndexOfNonAscii(text, end, start);
+		if (next >= end)
+			return end;
+		if (next > start)
+			lastCombiningClass = 0;
+		start = next;
+
+		ptr = text + start;
+		code = String_ExtractUnicodeCharacterInternal(&ptr, text + end);
+		if (code < 0)
+			return lastCombiningClass != 0 ? runStart : start;
+
+		canonicalCombiningClass = GetCombiningClass(code);
+		if (canonicalCombiningClass != 0) {
+			if (lastCombiningClass == 0)
+				runStart = start;
+			else if (canonicalCombiningClass < lastCombiningClass)
+				return runStart;
+		}
+		lastCombiningClass = canonicalCombiningClass;
+
+		start = ptr - text;
+	}
+}
+
 /// <summary>
 /// Normalize a substring within a string, so that its combining characters are in canonical order.
 /// </summary>
 /// <param name="str">The string whose substring you would like to normalize.</param>
 /// <param name="start">The start of the substring within that string.</param>
 /// <param name="length">The length of the substring within that string.</param>
-/// <returns>The whole string, with the given substring normalized.</returns>
+/// <returns>The whole string, with the given substring normalized (or the original string, if
+/// it is already normalized).</returns>
 String String_NormalizeRange(const String str, Int start, Int length)
 {
 #	define INITIAL_HOLDING_LENGTH 20
 
 	StringBuilder stringBuilder;
-	Int i, j, lasti, strLength, codePageIndex, hdest;
+	Int i, j, lasti, end, runEnd, strLength, codePageIndex, hdest;
 	const Byte *text;
 	Int32 ch;
 	Byte b;
@@ -697,8 +918,17 @@ String String_NormalizeRange(const String str, Int start, Int length)
 	if (length > strLength - start)
 		length = strLength - start;
 
+	end = start + length;
+
+	// Most text has no combining characters out of order, and anything before the first ones
+	// that are can be copied as-is.
+	i = FindFirstMisordering(text, start, end);
+	if (i >= end)
+		return UnchangedRange(str, start, length);
+
 	// This will hold the entire string, after we've normalized it.
 	stringBuilder = StringBuilder_CreateWithSize(length * 5 / 4);
+	StringBuilder_Append(stringBuilder, text, start, i - start);
 
 	// This smallish buffer will hold each completely-composed character as we find it (and its friends) in the string.
 	// If we run out of space in the buffer, we'll allocate a bigger one from the heap, but nearly everything should be
@@ -706,14 +936,14 @@ String String_NormalizeRange(const String str, Int start, Int length)
 	holding = initialHolding;
 	holdingLength = INITIAL_HOLDING_LENGTH;
 
-	i = 0;
-	while (i < length) {
+	while (i < end) {
 		// Read the next (full) character into 'ch'.
 		b = text[i];
 		if (b < 128) {
 			// Plain ASCII is copied to the output verbatim.
-			StringBuilder_AppendByte(stringBuilder, b);
-			i++;
+			runEnd = ByteSearch_IndexOfNonAscii(text, end, i);
+			StringBuilder_Append(stringBuilder, text, i, runEnd - i);
+			i = runEnd;
 			continue;
 		}
 		else {
@@ -739,7 +969,7 @@ String String_NormalizeRange(const String str, Int start, Int length)
 			hdest = 0;
 			holding[hdest++] = ch;
 			lasti = i;
-			while (i < strLength) {
+			while (i < end) {
 				lasti = i;
 				b = text[i];
 				if (b < 128) {
@@ -767,7 +997,10 @@ String String_NormalizeRange(const String str, Int start, Int length)
 
 				holding[hdest++] = ch;
 			}
-			i = lasti;
+
+			// If we stopped at a start character, it still needs to be output.
+			if (canonicalCombiningClass == 0)
+				i = lasti;
 
 			// Only bother with sorting if we found more than one of these things.
 			if (hdest > 1) {
@@ -924,261 +1157,6 @@ static void SortCombiningCharacters(UInt32 *buffer, UInt32 *temp, Int start, Int
 	MemCpy((UInt32 *)buffer + start, (UInt32 *)temp + start, sizeof(UInt32) * length);
 }
 
-/// <summary>
-/// Convert a substring within a string from UTF-8 encoding to that described by the given legacy code-page tables.
-/// </summary>
-/// <param name="str">The string whose substring you would like to convert to a code page.</param>
-/// <param name="start">The start of the substring within that string.</param>
-/// <param name="length">The length of the substring within that string.</param>
-/// <param name="utf8ToCodePageTables">A pointer to a table of pointers to 256-byte tables that describe how to
-/// convert each Unicode code point.</param>
-/// <param name="numTables">The number of 256-byte tables described.</param>
-/// <returns>The whole string, with the given substring converted to that code page.</returns>
-String String_ConvertUtf8ToCodePageRange(const String str, Int start, Int length, const Byte **utf8ToCodePageTables, Int numTables)
-{
-	Int strLength, src, dest;
-	Int32 value, codePage;
-	const Byte *text;
-	Byte ch;
-	String resultStr;
-	Byte *newText;
-
-	if (str == NULL || (strLength = String_Length(str)) <= 0) return str;
-	text = String_GetBytes(str);
-
-	if (start < 0) {
-		length += start;
-		start = 0;
-	}
-
-	if (length <= 0 || start >= strLength)
-		return String_Empty;
-
-	if (length > strLength - start)
-	{
-		length = strLength - start;
-	}
-
-	if (length <= 0) return String_Empty;
-
-	resultStr = String_CreateInternal(length);
-	newText = resultStr->_opaque.text;
-
-	src = start;
-	dest = 0;
-
-	while (src < length)
-	{
-		ch = text[src];
-		if (ch <= 127) {
-			src++;
-			ch = utf8ToCodePageTables[0][ch & 0xFF];
-		}
-		else {
-			value = String_ExtractUnicodeCharacter(str, &src);
-			if (value < 0) value = 0xFFFD;
-			codePage = value >> 8;
-			ch = codePage < numTables ? utf8ToCodePageTables[codePage][value & 0xFF] : '?';
-		}
-		newText[dest++] = ch;
-	}
-
-	newText[dest] = '\0';
-
-	resultStr->_opaque.length = dest;		// TODO: Find a better way to do this that's just as fast but wastes less memory.
-
-	return resultStr;
-}
-
-/// <summary>
-/// Convert a substring within a string from a specific legacy code-page encoding to standard UTF-8.
-/// </summary>
-/// <param name="str">The string whose substring you would like to convert to UTF-8.</param>
-/// <param name="start">The start of the substring within that string.</param>
-/// <param name="length">The length of the substring within that string.</param>
-/// <param name="codePageToUtf8Table">A 256-entry table describing the resulting Unicode code point for each byte in the string.</param>
-/// <returns>The whole string, with the given substring converted to UTF-8.</returns>
-String String_ConvertCodePageToUtf8Range(const String str, Int start, Int length, const UInt16 *codePageToUtf8Table)
-{
-	StringBuilder stringBuilder;
-	Int strLength, src;
-	UInt16 value;
-	const Byte *text;
-	Byte ch;
-
-	if (str == NULL || (strLength = String_Length(str)) <= 0) return str;
-	text = String_GetBytes(str);
-
-	if (start < 0) {
-		length += start;
-		start = 0;
-	}
-
-	if (length <= 0 || start >= strLength)
-		return String_Empty;
-
-	if (length > strLength - start)
-	{
-		length = strLength - start;
-	}
-
-	if (length <= 0) return String_Empty;
-
-	stringBuilder = StringBuilder_CreateWithSize(length);
-	src = 0;
-
-	while (src < strLength)
-	{
-		ch = text[src++];
-		value = codePageToUtf8Table[ch];
-		StringBuilder_AppendUnicode(stringBuilder, (UInt32)value);
-	}
-
-	return StringBuilder_ToString(stringBuilder);
-}
-
-/// <summary>
-/// Convert a substring within a string from UTF-8 encoding to that described by the given legacy code page.
-/// </summary>
-/// <param name="str">The string whose substring you would like to convert to a code page.</param>
-/// <param name="start">The start of the substring within that string.</param>
-/// <param name="length">The length of the substring within that string.</param>
-/// <param name="legacyCodePageID">The ID of the known legacy code-page.  If the code page is unknown, this will return the empty string.</param>
-/// <returns>The whole string, with the given substring converted to that code page.</returns>
-String String_ConvertUtf8ToKnownCodePageRange(const String str, Int start, Int length, Int legacyCodePageID)
-{
-	switch (legacyCodePageID) {
-
-		case LEGACY_CODE_PAGE_ISO_8859_1:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_1Table, UnicodeTables_UnicodeToIso_8859_1TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_2:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_2Table, UnicodeTables_UnicodeToIso_8859_2TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_3:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_3Table, UnicodeTables_UnicodeToIso_8859_3TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_4:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_4Table, UnicodeTables_UnicodeToIso_8859_4TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_5:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_5Table, UnicodeTables_UnicodeToIso_8859_5TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_6:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_6Table, UnicodeTables_UnicodeToIso_8859_6TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_7:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_7Table, UnicodeTables_UnicodeToIso_8859_7TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_8:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_8Table, UnicodeTables_UnicodeToIso_8859_8TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_9:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_9Table, UnicodeTables_UnicodeToIso_8859_9TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_10:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_10Table, UnicodeTables_UnicodeToIso_8859_10TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_11:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_11Table, UnicodeTables_UnicodeToIso_8859_11TableCount);
-		// There is no such thing as ISO 8859-12.
-		case LEGACY_CODE_PAGE_ISO_8859_13:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_13Table, UnicodeTables_UnicodeToIso_8859_13TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_14:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_14Table, UnicodeTables_UnicodeToIso_8859_14TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_15:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_15Table, UnicodeTables_UnicodeToIso_8859_15TableCount);
-		case LEGACY_CODE_PAGE_ISO_8859_16:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToIso_8859_16Table, UnicodeTables_UnicodeToIso_8859_16TableCount);
-
-		case LEGACY_CODE_PAGE_CP437:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToCp437Table, UnicodeTables_UnicodeToCp437TableCount);
-
-		case LEGACY_CODE_PAGE_WIN1250:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1250Table, UnicodeTables_UnicodeToWindows1250TableCount);
-		case LEGACY_CODE_PAGE_WIN1251:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1251Table, UnicodeTables_UnicodeToWindows1251TableCount);
-		case LEGACY_CODE_PAGE_WIN1252:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1252Table, UnicodeTables_UnicodeToWindows1252TableCount);
-		case LEGACY_CODE_PAGE_WIN1253:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1253Table, UnicodeTables_UnicodeToWindows1253TableCount);
-		case LEGACY_CODE_PAGE_WIN1254:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1254Table, UnicodeTables_UnicodeToWindows1254TableCount);
-		case LEGACY_CODE_PAGE_WIN1255:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1255Table, UnicodeTables_UnicodeToWindows1255TableCount);
-		case LEGACY_CODE_PAGE_WIN1256:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1256Table, UnicodeTables_UnicodeToWindows1256TableCount);
-		case LEGACY_CODE_PAGE_WIN1257:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1257Table, UnicodeTables_UnicodeToWindows1257TableCount);
-		case LEGACY_CODE_PAGE_WIN1258:
-			return String_ConvertUtf8ToCodePageRange(str, start, length, UnicodeTables_UnicodeToWindows1258Table, UnicodeTables_UnicodeToWindows1258TableCount);
-
-		default:
-			return String_Empty;
-	}
-}
-
-/// <summary>
-/// Convert a substring within a string from a specific legacy code-page encoding to standard UTF-8.
-/// </summary>
-/// <param name="str">The string whose substring you would like to convert to UTF-8.</param>
-/// <param name="start">The start of the substring within that string.</param>
-/// <param name="length">The length of the substring within that string.</param>
-/// <param name="legacyCodePageID">The ID of the known legacy code-page.  If the code page is unknown, this will return the empty string.</param>
-/// <returns>The whole string, with the given substring converted to UTF-8.</returns>
-String String_ConvertKnownCodePageToUtf8Range(const String str, Int start, Int length, Int legacyCodePageID)
-{
-	switch (legacyCodePageID) {
-
-		case LEGACY_CODE_PAGE_ISO_8859_1:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_1ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_2:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_2ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_3:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_3ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_4:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_4ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_5:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_5ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_6:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_6ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_7:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_7ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_8:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_8ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_9:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_9ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_10:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_10ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_11:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_11ToUnicodeTable);
-		// There is no such thing as ISO 8859-12.
-		case LEGACY_CODE_PAGE_ISO_8859_13:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_13ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_14:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_14ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_15:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_15ToUnicodeTable);
-		case LEGACY_CODE_PAGE_ISO_8859_16:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Iso_8859_16ToUnicodeTable);
-
-		case LEGACY_CODE_PAGE_CP437:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Cp437ToUnicodeTable);
-
-		case LEGACY_CODE_PAGE_WIN1250:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1250ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1251:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1251ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1252:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1252ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1253:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1253ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1254:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1254ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1255:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1255ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1256:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1256ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1257:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1257ToUnicodeTable);
-		case LEGACY_CODE_PAGE_WIN1258:
-			return String_ConvertCodePageToUtf8Range(str, start, length, UnicodeTables_Windows1258ToUnicodeTable);
-
-		default:
-			return String_Empty;
-	}
-}
-
 /// <summary>
 /// Search through a given string for the first index of a given substring, case-insensitive.
 /// </summary>
@@ -1188,20 +1166,10 @@ String String_ConvertKnownCodePageToUtf8Range(const String str, Int start, Int l
 /// <returns>The zero-based index of the first match, or -1 if no match is found.</returns>
 Int String_IndexOfI(const String str, const String pattern, Int start)
 {
-	Int end, slength, plength;
-	Bool usedSlowConversion;
-
-	slength = String_Length(str);
-	plength = String_Length(pattern);
-
 	if (start < 0) start = 0;
+	if (String_Length(pattern) > String_Length(str) - start) return -1;
 
-	for (end = slength - plength; start <= end; start++)
-	{
-		if (String_CompareRangeI(pattern, 0, plength, str, start, plength, &usedSlowConversion) == 0)
-			return start;
-	}
-	return -1;
+	return FoldSearch_Find(FoldSearch_Create(pattern), str, start);
 }
 
 /// <summary>
@@ -1215,25 +1183,11 @@ Int String_IndexOfI(const String str, const String pattern, Int start)
 /// string matches, this returns -1.</returns>
 Int String_LastIndexOfI(const String str, const String pattern, Int start)
 {
-	Bool usedSlowConversion;
-	Int slength, plength;
+	Int plength = String_Length(pattern);
 
-	slength = String_Length(str);
-	plength = String_Length(pattern);
+	if (plength > String_Length(str) || start < plength) return -1;
 
-	if (plength > slength || start < plength) return -1;
-
-	start -= plength;
-	if (start >= slength - plength)
-	{
-		start = slength - plength;
-	}
-	for (; start >= 0; start--)
-	{
-		if (String_CompareRangeI(pattern, 0, plength, str, start, plength, &usedSlowConversion) == 0)
-			return start;
-	}
-	return -1;
+	return FoldSearch_FindLast(FoldSearch_Create(pattern), str, start - plength);
 }
 
 /// <summary>
@@ -1247,22 +1201,10 @@ Int String_LastIndexOfI(const String str, const String pattern, Int start)
 /// or the empty string, this will return zero.</returns>
 Int String_CountOfI(const String str, const String pattern, Int start)
 {
-	Int index, patternLength;
-	Int count;
-
 	if (String_IsNullOrEmpty(pattern) || String_IsNullOrEmpty(str))
 		return 0;
 
-	patternLength = String_Length(pattern);
-	count = 0;
-	index = start;
-
-	while ((index = String_IndexOfI(str, pattern, index)) >= 0) {
-		count++;
-		index += patternLength;
-	}
-
-	return count;
+	return FoldSearch_CountOf(FoldSearch_Create(pattern), str, start);
 }
 
 /// <summary>
@@ -1314,38 +1256,10 @@ Bool String_EndsWithI(const String str, const String pattern)
 /// <returns>A new string where all instances of the pattern have been replaced by the given replacement string.</returns>
 String String_ReplaceI(const String str, const String pattern, const String replacement)
 {
-	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
-	String r;
-	const Byte *text, *patText, *repText;
-	Int lastEnd, index, patLength, repLength;
-
 	if (String_IsNullOrEmpty(str)) return String_Empty;
 	if (String_IsNullOrEmpty(pattern)) return str;
 
-	text = String_GetBytes(str);
-	patText = String_GetBytes(pattern);
-	patLength = String_Length(pattern);
-	r = (replacement != NULL ? replacement : String_Empty);
-	repText = String_GetBytes(r);
-	repLength = String_Length(r);
-
-	INIT_INLINE_STRINGBUILDER(stringBuilder);
-
-	lastEnd = 0;
-	index = 0;
-	while ((index = String_IndexOfI(str, pattern, index)) >= 0) {
-		if (index > lastEnd) {
-			StringBuilder_Append(stringBuilder, text, lastEnd, index - lastEnd);
-		}
-		StringBuilder_Append(stringBuilder, repText, 0, repLength);
-		lastEnd = (index += String_Length(pattern));
-	}
-
-	if (lastEnd < String_Length(str)) {
-		StringBuilder_Append(stringBuilder, text, lastEnd, String_Length(str) - lastEnd);
-	}
-
-	return StringBuilder_ToString(stringBuilder);
+	return FoldSearch_Replace(FoldSearch_Create(pattern), str, replacement, -1);
 }
 
 /// <summary>
@@ -1359,37 +1273,8 @@ String String_ReplaceI(const String str, const String pattern, const String repl
 /// <returns>A new string where at most 'limit' instances of the pattern have been replaced by the given replacement string.</returns>
 String String_ReplaceWithLimitI(const String str, const String pattern, const String replacement, Int limit)
 {
-	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
-	String r;
-	const Byte *text, *patText, *repText;
-	Int lastEnd, index, patLength, repLength;
-
 	if (String_IsNullOrEmpty(str)) return String_Empty;
 	if (String_IsNullOrEmpty(pattern)) return str;
 
-	text = String_GetBytes(str);
-	patText = String_GetBytes(pattern);
-	patLength = String_Length(pattern);
-	r = (replacement != NULL ? replacement : String_Empty);
-	repText = String_GetBytes(r);
-	repLength = String_Length(r);
-
-	INIT_INLINE_STRINGBUILDER(stringBuilder);
-
-	lastEnd = 0;
-	index = 0;
-	while (limit > 0 && (index = String_IndexOfI(str, pattern, index)) >= 0) {
-		if (index > lastEnd) {
-			StringBuilder_Append(stringBuilder, text, lastEnd, index - lastEnd);
-		}
-		StringBuilder_Append(stringBuilder, repText, 0, repLength);
-		lastEnd = (index += String_Length(pattern));
-		limit--;
-	}
-
-	if (lastEnd < String_Length(str)) {
-		StringBuilder_Append(stringBuilder, text, lastEnd, String_Length(str) - lastEnd);
-	}
-
-	return StringBuilder_ToString(stringBuilder);
+	return FoldSearch_Replace(FoldSearch_Create(pattern), str, replacement, limit > 0 ? limit : 0);
 }
@@ -0,0 +1,466 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include <smile/gc.h>
+#include <smile/mem.h>
+#include <smile/string.h>
+#include <smile/utf8.h>
+#include <smile/numeric/vector.h>
+
+#if SMILE_CPU == SMILE_CPU_X64
+	#include <emmintrin.h>
+#endif
+#if VECTOR_HAS_AVX2
+	#include <immintrin.h>
+#endif
+
+// How many recently-used indexes Utf8Index_Get() keeps.  This must be a power of two.
+#define UTF8INDEX_CACHE_SIZE 16
+
+/// <summary>
+/// Count the bits that are set in a 32-bit value.
+/// </summary>
+Inline Int PopCount32(UInt32 value)
+{
+	value = value - ((value >> 1) & 0x55555555);
+	value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+	return (Int)((((value + (value >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Validation.
+
+/// <summary>
+/// Find the first invalid UTF-8 sequence, one code point at a time, skipping over ASCII eight
+/// bytes at a time.
+/// </summary>
+/// <param name="text">The text to validate.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <param name="i">Where to start validating, which must be the start of a code point.</param>
+/// <returns>The index of the first byte of the first invalid sequence, or 'length' if the
+/// text is valid.</returns>
+static Int FindInvalidScalar(const Byte *text, Int length, Int i)
+{
+	UInt64 word;
+	Byte b, c;
+
+	for (;;) {
+		while (i + 8 <= length) {
+			MemCpy(&word, text + i, 8);
+			if (word & 0x8080808080808080ULL)
+				break;
+			i += 8;
+		}
+		while (i < length && text[i] < 0x80)
+			i++;
+		if (i >= length)
+			return length;
+
+		b = text[i];
+		if (b < 0xC2) {
+			// Stray continuation bytes, and overlong encodings of ASCII.
+			return i;
+		}
+		else if (b < 0xE0) {
+			if (i + 1 >= length || (text[i + 1] & 0xC0) != 0x80) return i;
+			i += 2;
+		}
+		else if (b < 0xF0) {
+			if (i + 2 >= length) return i;
+			c = text[i + 1];
+			if ((c & 0xC0) != 0x80 || (text[i + 2] & 0xC0) != 0x80) return i;
+			if (b == 0xE0 && c < 0xA0) return i;		// Overlong.
+			if (b == 0xED && c >= 0xA0) return i;		// Surrogate.
+			i += 3;
+		}
+		else if (b < 0xF5) {
+			if (i + 3 >= length) return i;
+			c = text[i + 1];
+			if ((c & 0xC0) != 0x80 || (text[i + 2] & 0xC0) != 0x80 || (text[i + 3] & 0xC0) != 0x80) return i;
+			if (b == 0xF0 && c < 0x90) return i;		// Overlong.
+			if (b == 0xF4 && c >= 0x90) return i;		// Above U+10FFFF.
+			i += 4;
+		}
+		else {
+			return i;
+		}
+	}
+}
+
+#if VECTOR_HAS_AVX2
+
+// The error classes of the Keiser-Lemire lookup algorithm.  Each byte pair's three table
+// lookups are ANDed together, and any bit that survives is an error (except TWO_CONTS, which
+// is only an error where the pair isn't the tail of a three- or four-byte sequence).
+#define TOO_SHORT		(1 << 0)	// A lead byte followed by a lead byte or ASCII.
+#define TOO_LONG		(1 << 1)	// ASCII followed by a continuation byte.
+#define OVERLONG_3		(1 << 2)	// E0 80..9F.
+#define TOO_LARGE		(1 << 3)	// F4 90..BF, or F5..FF.
+#define SURROGATE		(1 << 4)	// ED A0..BF.
+#define OVERLONG_2		(1 << 5)	// C0..C1 followed by a continuation byte.
+#define TOO_LARGE_1000	(1 << 6)	// F5..FF 80..8F.
+#define OVERLONG_4		(1 << 6)	// F0 80..8F.
+#define TWO_CONTS		(1 << 7)	// Two continuation bytes in a row.
+#define CARRY			(TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+#define LANE2(...) __VA_ARGS__, __VA_ARGS__
+
+/// <summary>
+/// Check one 32-byte block of text, given the block before it, and return the error bits.
+/// </summary>
+__attribute__((target("avx2")))
+Inline __m256i CheckBlockAvx2(__m256i input, __m256i previous)
+{
+	const __m256i byte1High = _mm256_setr_epi8(LANE2(
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+	));
+	const __m256i byte1Low = _mm256_setr_epi8(LANE2(
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000
+	));
+	const __m256i byte2High = _mm256_setr_epi8(LANE2(
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		(char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+		(char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+		(char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+		(char)(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+	));
+	const __m256i lowNybble = _mm256_set1_epi8(0x0F);
+
+	// The previous one, two, and three bytes for each byte of the input.
+	__m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+	__m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+	__m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+	__m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+	__m256i special = _mm256_and_si256(
+		_mm256_and_si256(
+			_mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNybble)),
+			_mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, lowNybble))),
+		_mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNybble)));
+
+	// Bytes two or three after an E0..FF or F0..FF lead must be continuations.
+	__m256i must23 = _mm256_or_si256(
+		_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+		_mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+	__m256i must23At80 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+
+	return _mm256_xor_si256(must23At80, special);
+}
+
+/// <summary>
+/// Find out whether the last bytes of a block start a sequence that runs past its end.
+/// </summary>
+__attribute__((target("avx2")))
+Inline __m256i IsIncompleteAvx2(__m256i input)
+{
+	const __m256i maxValue = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		(char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+	return _mm256_subs_epu8(input, maxValue);
+}
+
+/// <summary>
+/// Validate 32 bytes at a time with the Keiser-Lemire lookup algorithm, which classifies every
+/// pair of adjacent bytes with three table lookups.  Blocks of pure ASCII are skipped.  This
+/// only finds which block the first error is in; the scalar validator then finds exactly where.
+/// </summary>
+__attribute__((target("avx2")))
+static Int FindInvalidAvx2(const Byte *text, Int length, Int start)
+{
+	__m256i previous = _mm256_setzero_si256();
+	__m256i incomplete = _mm256_setzero_si256();
+	__m256i error = _mm256_setzero_si256();
+	__m256i input;
+	Byte tail[32];
+	Int j, k;
+
+	for (j = start; j + 32 <= length; j += 32) {
+		input = _mm256_loadu_si256((const __m256i *)(text + j));
+		if (!_mm256_movemask_epi8(input)) {
+			error = incomplete;
+			incomplete = _mm256_setzero_si256();
+		}
+		else {
+			error = CheckBlockAvx2(input, previous);
+			incomplete = IsIncompleteAvx2(input);
+		}
+		if (!_mm256_testz_si256(error, error))
+			goto found;
+		previous = input;
+	}
+
+	// The tail is padded with ASCII, which also catches any sequence left unfinished at the end.
+	MemSet(tail, 0, 32);
+	MemCpy(tail, text + j, length - j);
+	input = _mm256_loadu_si256((const __m256i *)tail);
+	error = _mm256_or_si256(CheckBlockAvx2(input, previous), IsIncompleteAvx2(input));
+	if (_mm256_testz_si256(error, error))
+		return length;
+
+found:
+	// The error is in this block, or in a sequence that began at most three bytes before it.
+	for (k = j - 1; k > start && k > j - 4 && (text[k] & 0xC0) == 0x80; k--) ;
+	if (k < start) k = start;
+	return FindInvalidScalar(text, length, k);
+}
+
+#endif
+
+/// <summary>
+/// Find the first invalid UTF-8 sequence in the given text.
+/// </summary>
+/// <param name="text">The text to validate.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <param name="start">Where to start validating, which must be the start of a code point
+/// (usually zero).</param>
+/// <returns>The index of the first byte of the first invalid sequence at or after 'start',
+/// or 'length' if the text is valid from 'start' onward.</returns>
+Int Utf8_FindInvalid(const Byte *text, Int length, Int start)
+{
+	if (start < 0) start = 0;
+	if (start >= length) return length;
+
+#if VECTOR_HAS_AVX2
+	if (length - start >= 64 && Vector_GetIsa() == VECTOR_ISA_AVX2)
+		return FindInvalidAvx2(text, length, start);
+#endif
+
+	return FindInvalidScalar(text, length, start);
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Code-point counting.
+
+/// <summary>
+/// Count the lead bytes (the bytes that are not continuation bytes) in the given text.
+/// </summary>
+static Int CountLeadBytes(const Byte *text, Int length)
+{
+	Int count = 0, i = 0;
+	UInt64 word, continuations;
+
+#if SMILE_CPU == SMILE_CPU_X64
+	// Continuation bytes are 0x80..0xBF, which are exactly the signed bytes below -64.
+	const __m128i lowestLead = _mm_set1_epi8(-65);
+	for (; i + 16 <= length; i += 16) {
+		__m128i input = _mm_loadu_si128((const __m128i *)(text + i));
+		count += PopCount32((UInt32)_mm_movemask_epi8(_mm_cmpgt_epi8(input, lowestLead)));
+	}
+#endif
+
+	for (; i + 8 <= length; i += 8) {
+		MemCpy(&word, text + i, 8);
+		continuations = word & ~(word << 1) & 0x8080808080808080ULL;
+		count += 8 - (Int)((((continuations >> 7) * 0x0101010101010101ULL) >> 56) & 0xFF);
+	}
+
+	for (; i < length; i++)
+		count += (text[i] & 0xC0) != 0x80;
+
+	return count;
+}
+
+/// <summary>
+/// Count the code points in the given UTF-8 text.  This counts lead bytes (every byte that is
+/// not a continuation byte), which is exact for valid UTF-8; in malformed text, each stray
+/// continuation byte is considered part of the code point before it.
+/// </summary>
+/// <param name="text">The text to count the code points of.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <returns>The number of code points in the text.</returns>
+Int Utf8_CountCodePoints(const Byte *text, Int length)
+{
+	return CountLeadBytes(text, length);
+}
+
+/// <summary>
+/// Find the code point that lies the given number of code points after a starting position.
+/// </summary>
+/// <param name="text">The UTF-8 text to move through.</param>
+/// <param name="length">The length of the text, in bytes.</param>
+/// <param name="start">The byte offset to start from.</param>
+/// <param name="count">How many code points to skip over.</param>
+/// <returns>The byte offset of the first byte of the resulting code point, or 'length' if that
+/// is exactly the end of the text, or -1 if the text has fewer than 'count' code points.</returns>
+Int Utf8_SkipCodePoints(const Byte *text, Int length, Int start, Int count)
+{
+	Int i = start, n;
+
+	if (start < 0 || start > length || count < 0) return -1;
+
+	// Skip whole chunks while the code point is beyond them.
+	while (i + 64 <= length && count > 64) {
+		n = CountLeadBytes(text + i, 64);
+		if (n >= count) break;
+		count -= n;
+		i += 64;
+	}
+
+	for (; i < length; i++) {
+		if ((text[i] & 0xC0) != 0x80) {
+			if (count == 0) return i;
+			count--;
+		}
+	}
+
+	return count == 0 ? length : -1;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Breadcrumb indexes.
+
+/// <summary>
+/// Build a breadcrumb index for the given string, which records where every UTF8INDEX_STRIDE'th
+/// code point begins.  This takes a single pass over the string.
+/// </summary>
+/// <param name="str">The string to index.</param>
+/// <returns>The new index.</returns>
+Utf8Index Utf8Index_Create(const String str)
+{
+	const Byte *text = String_GetBytes(str);
+	Int length = String_Length(str);
+	Utf8Index index;
+	Int *offsets;
+	Int numOffsets, seen, next, i, j, n, blockLength;
+
+	index = GC_MALLOC_STRUCT(struct Utf8IndexStruct);
+	if (index == NULL) Smile_Abort_OutOfMemory();
+
+	offsets = GC_MALLOC_RAW_ARRAY(Int, length / UTF8INDEX_STRIDE + 1);
+	if (offsets == NULL) Smile_Abort_OutOfMemory();
+
+	offsets[0] = 0;
+	numOffsets = 1;
+	seen = 0;
+	next = UTF8INDEX_STRIDE;
+
+	// Blocks are exactly one stride long, so at most one breadcrumb falls in each block.
+	for (i = 0; i < length; i += blockLength) {
+		blockLength = length - i < UTF8INDEX_STRIDE ? length - i : UTF8INDEX_STRIDE;
+		n = CountLeadBytes(text + i, blockLength);
+		if (seen + n > next) {
+			for (j = i; ; j++) {
+				if ((text[j] & 0xC0) != 0x80 && seen++ == next)
+					break;
+			}
+			offsets[numOffsets++] = j;
+			seen = next + 1;
+			n = CountLeadBytes(text + j + 1, i + blockLength - (j + 1));
+			next += UTF8INDEX_STRIDE;
+		}
+		seen += n;
+	}
+
+	index->str = str;
+	index->numCodePoints = seen;
+	index->offsets = offsets;
+	index->numOffsets = numOffsets;
+	return index;
+}
+
+/// <summary>
+/// Get a breadcrumb index for the given string, reusing a recently-built index if the same
+/// string has been indexed lately.  This is what makes repeated code-point indexing into the
+/// same long string cheap, without storing an index inside every string.
+/// </summary>
+/// <param name="str">The string to index.</param>
+/// <returns>An index for the string.</returns>
+Utf8Index Utf8Index_Get(const String str)
+{
+	static Utf8Index cache[UTF8INDEX_CACHE_SIZE];
+	Utf8Index *slot;
+
+	slot = &cache[(((PtrInt)str >> 4) ^ ((PtrInt)str >> 12)) & (UTF8INDEX_CACHE_SIZE - 1)];
+	if (*slot == NULL || (*slot)->str != str)
+		*slot = Utf8Index_Create(str);
+
+	return *slot;
+}
+
+/// <summary>
+/// Find where a code point begins, by its position in the indexed string.
+/// </summary>
+/// <param name="index">The index of the string.</param>
+/// <param name="codePointIndex">The position of the code point, counting from zero.</param>
+/// <returns>The byte offset of the code point, or the length of the string if the position
+/// is exactly the number of code points, or -1 if the position is out of range.</returns>
+Int Utf8Index_GetByteOffset(const Utf8Index index, Int codePointIndex)
+{
+	if (codePointIndex < 0 || codePointIndex > index->numCodePoints)
+		return -1;
+	if (codePointIndex == index->numCodePoints)
+		return String_Length(index->str);
+
+	return Utf8_SkipCodePoints(String_GetBytes(index->str), String_Length(index->str),
+		index->offsets[codePointIndex / UTF8INDEX_STRIDE], codePointIndex % UTF8INDEX_STRIDE);
+}
+
+/// <summary>
+/// Find which code point contains the byte at the given offset in the indexed string.
+/// </summary>
+/// <param name="index">The index of the string.</param>
+/// <param name="byteOffset">The byte offset within the string.</param>
+/// <returns>The position of the code point containing that byte (counting from zero), or the
+/// number of code points if the offset is the length of the string, or -1 if the offset is
+/// out of range.</returns>
+Int Utf8Index_GetCodePointIndex(const Utf8Index index, Int byteOffset)
+{
+	const Byte *text = String_GetBytes(index->str);
+	Int length = String_Length(index->str);
+	Int lo, hi, mid, result;
+
+	if (byteOffset < 0 || byteOffset > length)
+		return -1;
+	if (byteOffset == length)
+		return index->numCodePoints;
+
+	// Find the last breadcrumb at or before the offset.
+	lo = 0;
+	hi = index->numOffsets - 1;
+	while (lo < hi) {
+		mid = (lo + hi + 1) >> 1;
+		if (index->offsets[mid] <= byteOffset)
+			lo = mid;
+		else hi = mid - 1;
+	}
+
+	// A stray continuation byte before the first code point belongs to the first code point.
+	result = lo * UTF8INDEX_STRIDE + CountLeadBytes(text + index->offsets[lo], byteOffset + 1 - index->offsets[lo]) - 1;
+	return result >= 0 ? result : 0;
+}
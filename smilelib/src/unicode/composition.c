@@ -194,7 +194,7 @@ Int32 Unicode_Compose(Int32 a, Int32 b, Int32 c, Int32 d)
 		case 0x323: return (0x1E32 | TWO_POINTS);
 		case 0x327: return (0x136 | TWO_POINTS);
 		case 0x331: return (0x1E34 | TWO_POINTS);
-		default: return (0x212A | ONE_POINT);
+		default: return NO_MATCH;
 		}
 	case 0x4C:
 		switch (b) {
@@ -943,7 +943,7 @@ Int32 Unicode_Compose(Int32 a, Int32 b, Int32 c, Int32 d)
 			default: return (0x1F69 | TWO_POINTS);
 			}
 		case 0x345: return (0x1FFC | TWO_POINTS);
-		default: return (0x2126 | ONE_POINT);
+		default: return NO_MATCH;
 		}
 	case 0x3B1:
 		switch (b) {
@@ -1055,7 +1055,7 @@ Int32 Unicode_Compose(Int32 a, Int32 b, Int32 c, Int32 d)
 			default: return (0x1F31 | TWO_POINTS);
 			}
 		case 0x342: return (0x1FD6 | TWO_POINTS);
-		default: return (0x1FBE | ONE_POINT);
+		default: return NO_MATCH;
 		}
 	case 0x3BF:
 		switch (b) {
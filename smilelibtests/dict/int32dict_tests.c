@@ -486,4 +486,42 @@ START_TEST(GetAllReturnsEverything)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  Garbage-collection tests.
+
+static Int32Dict CreateDictOfFreshStrings(Int count)
+{
+	Int32Dict dict = Int32Dict_Create();
+	Int i;
+	for (i = 0; i < count; i++) {
+		Int32Dict_Add(dict, (Int32)i, String_Format("value %d", i));
+	}
+	return dict;
+}
+
+static void ChurnTheHeap(void)
+{
+	Int i;
+	for (i = 0; i < 20000; i++) {
+		String_Format("garbage %d", i);
+	}
+}
+
+START_TEST(ValuesReachableOnlyThroughTheDictSurviveCollection)
+{
+	Int32Dict dict = CreateDictOfFreshStrings(1000);
+	Int i;
+
+	GC_gcollect();
+	ChurnTheHeap();
+	GC_gcollect();
+
+	ASSERT(Int32Dict_Count(dict) == 1000);
+	for (i = 0; i < 1000; i++) {
+		String value = (String)Int32Dict_GetValue(dict, (Int32)i);
+		ASSERT(String_Equals(value, String_Format("value %d", i)));
+	}
+}
+END_TEST
+
 #include "int32dict_tests.generated.inc"
@@ -176,4 +176,45 @@ START_TEST(GetKeysReturnsEverything)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  Garbage-collection tests.
+
+static PointerSet CreateSetOfFreshStrings(Int count)
+{
+	PointerSet pointerSet = PointerSet_Create();
+	Int i;
+	for (i = 0; i < count; i++) {
+		PointerSet_Add(pointerSet, String_Format("key %d", i));
+	}
+	return pointerSet;
+}
+
+static void ChurnTheHeap(void)
+{
+	Int i;
+	for (i = 0; i < 20000; i++) {
+		String_Format("garbage %d", i);
+	}
+}
+
+START_TEST(KeysReachableOnlyThroughTheSetSurviveCollection)
+{
+	PointerSet pointerSet = CreateSetOfFreshStrings(1000);
+	void **keys;
+	Int i;
+
+	GC_gcollect();
+	ChurnTheHeap();
+	GC_gcollect();
+
+	ASSERT(PointerSet_Count(pointerSet) == 1000);
+	keys = PointerSet_GetAll(pointerSet);
+	for (i = 0; i < 1000; i++) {
+		String key = (String)keys[i];
+		ASSERT(String_StartsWithC(key, "key "));
+		ASSERT(String_Length(key) >= 5 && String_Length(key) <= 7);
+	}
+}
+END_TEST
+
 #include "pointerset_tests.generated.inc"
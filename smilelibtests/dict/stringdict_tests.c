@@ -454,4 +454,43 @@ START_TEST(GetAllReturnsEverything)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  Garbage-collection tests.
+
+static StringDict CreateDictOfFreshStrings(Int count)
+{
+	StringDict dict = StringDict_Create();
+	Int i;
+	for (i = 0; i < count; i++) {
+		StringDict_Add(dict, String_Format("key %d", i), String_Format("value %d", i));
+	}
+	return dict;
+}
+
+static void ChurnTheHeap(void)
+{
+	Int i;
+	for (i = 0; i < 20000; i++) {
+		String_Format("garbage %d", i);
+	}
+}
+
+START_TEST(KeysAndValuesReachableOnlyThroughTheDictSurviveCollection)
+{
+	StringDict dict = CreateDictOfFreshStrings(1000);
+	Int i;
+
+	GC_gcollect();
+	ChurnTheHeap();
+	GC_gcollect();
+
+	ASSERT(StringDict_Count(dict) == 1000);
+	for (i = 0; i < 1000; i++) {
+		String value = (String)StringDict_GetValue(dict, String_Format("key %d", i));
+		ASSERT(value != NULL);
+		ASSERT(String_Equals(value, String_Format("value %d", i)));
+	}
+}
+END_TEST
+
 #include "stringdict_tests.generated.inc"
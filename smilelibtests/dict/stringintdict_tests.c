@@ -454,4 +454,42 @@ START_TEST(GetAllReturnsEverything)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  Garbage-collection tests.
+
+static StringIntDict CreateDictOfFreshStrings(Int count)
+{
+	StringIntDict dict = StringIntDict_Create();
+	Int i;
+	for (i = 0; i < count; i++) {
+		StringIntDict_Add(dict, String_Format("key %d", i), i);
+	}
+	return dict;
+}
+
+static void ChurnTheHeap(void)
+{
+	Int i;
+	for (i = 0; i < 20000; i++) {
+		String_Format("garbage %d", i);
+	}
+}
+
+START_TEST(KeysReachableOnlyThroughTheDictSurviveCollection)
+{
+	StringIntDict dict = CreateDictOfFreshStrings(1000);
+	Int i, value;
+
+	GC_gcollect();
+	ChurnTheHeap();
+	GC_gcollect();
+
+	ASSERT(StringIntDict_Count(dict) == 1000);
+	for (i = 0; i < 1000; i++) {
+		ASSERT(StringIntDict_TryGetValue(dict, String_Format("key %d", i), &value));
+		ASSERT(value == i);
+	}
+}
+END_TEST
+
 #include "stringintdict_tests.generated.inc"
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+
+TEST_SUITE(GcStatsTests)
+
+START_TEST(AllocationsAreNotCountedWhenDisabled)
+{
+	struct GcStatsStruct before, after;
+
+	GcStats_Enable(False);
+	GcStats_Get(&before);
+
+	SmileList_Cons(NullObject, NullObject);
+	String_FromC("not counted");
+
+	GcStats_Get(&after);
+
+	ASSERT(after.allocationCounts[SMILE_KIND_LIST] == before.allocationCounts[SMILE_KIND_LIST]);
+	ASSERT(after.allocationCounts[SMILE_KIND_STRING] == before.allocationCounts[SMILE_KIND_STRING]);
+}
+END_TEST
+
+START_TEST(AllocationsAreCountedByKind)
+{
+	struct GcStatsStruct stats;
+	Int i;
+
+	GcStats_Enable(True);
+	GcStats_Reset();
+
+	for (i = 0; i < 10; i++)
+		SmileList_Cons(NullObject, NullObject);
+	String_FromC("counted");
+	SmileInteger64_Create(12345);
+
+	GcStats_Get(&stats);
+	GcStats_Enable(False);
+
+	ASSERT(stats.allocationCounts[SMILE_KIND_LIST] == 10);
+	ASSERT(stats.allocationBytes[SMILE_KIND_LIST] == 10 * sizeof(struct SmileListInt));
+	ASSERT(stats.allocationCounts[SMILE_KIND_STRING] == 1);
+	ASSERT(stats.allocationCounts[SMILE_KIND_INTEGER64] == 1);
+	ASSERT(stats.totalAllocationCount == 12);
+}
+END_TEST
+
+START_TEST(CollectionsAreCounted)
+{
+	struct GcStatsStruct stats;
+
+	GcStats_Enable(True);
+	GcStats_Reset();
+
+	GcStats_Collect();
+	GcStats_Collect();
+
+	GcStats_Get(&stats);
+	GcStats_Enable(False);
+
+	ASSERT(stats.numCollections == 2);
+	ASSERT(stats.numTimedCollections == 2);
+	ASSERT(stats.maxPauseTicks <= stats.totalPauseTicks);
+	ASSERT(stats.heapSize > 0);
+	ASSERT(stats.liveBytes <= stats.heapSize);
+}
+END_TEST
+
+#include "gcstats_tests.generated.inc"
@@ -0,0 +1,242 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilecell.h>
+#include <smile/smiletypes/smilehandle.h>
+#include <smile/env/weakref.h>
+#include <smile/eval/closure.h>
+
+TEST_SUITE(HeapCensusTests)
+
+//-------------------------------------------------------------------------------------------------
+//  Helper functions.
+
+static void SetupGlobals(void)
+{
+	if (Smile_GetGlobalClosureInfo() == NULL)
+		Smile_SetGlobalClosureInfo(ClosureInfo_Create(NULL, CLOSURE_KIND_GLOBAL));
+}
+
+static SmileUserObject CreatePoints(const char *className, Int count, SmileList *list)
+{
+	SmileUserObject pointBase = SmileUserObject_Create((SmileObject)Smile_KnownBases.Object,
+		SymbolTable_GetSymbolC(Smile_SymbolTable, className));
+	SmileList head = NullList;
+	Int i;
+
+	for (i = 0; i < count; i++) {
+		SmileUserObject point = SmileUserObject_Create((SmileObject)pointBase, 0);
+		head = SmileList_Cons((SmileObject)point, (SmileObject)head);
+	}
+
+	*list = head;
+	return pointBase;
+}
+
+static SmileList CreateList(Int count)
+{
+	SmileList head = NullList;
+	Int i;
+
+	for (i = 0; i < count; i++) {
+		head = SmileList_Cons((SmileObject)NullObject, (SmileObject)head);
+	}
+
+	return head;
+}
+
+static HeapCensusRetainer FindRetainer(HeapCensus census, const char *path)
+{
+	Int i;
+
+	for (i = 0; i < census->numRetainers; i++) {
+		if (String_EqualsC(census->retainers[i].path, path))
+			return &census->retainers[i];
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Tests.
+
+START_TEST(ObjectsAreGroupedByNamedBase)
+{
+	HeapCensus census;
+	HeapCensusGroup group;
+	SmileList points;
+
+	SetupGlobals();
+	CreatePoints("census-point", 100, &points);
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-points"), (SmileObject)points);
+
+	census = HeapCensus_Take(HEAPCENSUS_DEFAULT_RETAINERS);
+
+	group = HeapCensus_FindGroup(census, String_FromC("Object:census-point"));
+	ASSERT(group != NULL);
+	ASSERT(group->count == 101);
+	ASSERT(group->shallowBytes >= 101 * sizeof(struct SmileUserObjectInt));
+
+	group = HeapCensus_FindGroup(census, String_FromC("List"));
+	ASSERT(group != NULL);
+	ASSERT(group->count >= 100);
+
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-points"));
+}
+END_TEST
+
+START_TEST(ALongListIsReportedAsASingleRetainer)
+{
+	HeapCensus census;
+	HeapCensusRetainer retainer;
+	SmileList points;
+	Int i;
+
+	SetupGlobals();
+	CreatePoints("census-point-2", 200, &points);
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-list"), (SmileObject)points);
+
+	census = HeapCensus_Take(100000);
+
+	// The first cell retains the whole list, all of the points in it, and (since nothing else
+	// refers to it) their shared base.
+	retainer = FindRetainer(census, "<globals>.census-list");
+	ASSERT(retainer != NULL);
+	ASSERT(String_EqualsC(retainer->name, "List"));
+	ASSERT(retainer->retainedCount == 401);
+	ASSERT(retainer->retainedBytes >= 200 * (sizeof(struct SmileListInt) + sizeof(struct SmileUserObjectInt)));
+
+	// None of the other cells are reported separately.
+	for (i = 0; i < census->numRetainers; i++) {
+		if (&census->retainers[i] == retainer) continue;
+		ASSERT(!(String_EqualsC(census->retainers[i].name, "List")
+			&& String_StartsWithC(census->retainers[i].path, "<globals>.census-list")));
+	}
+
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-list"));
+}
+END_TEST
+
+START_TEST(SharedObjectsAreNotRetainedByEitherReferrer)
+{
+	HeapCensus census;
+	HeapCensusRetainer a, b;
+	SmileUserObject holderA, holderB;
+	SmileList points;
+
+	SetupGlobals();
+	CreatePoints("census-point-3", 50, &points);
+
+	holderA = SmileUserObject_Create((SmileObject)Smile_KnownBases.Object, 0);
+	holderB = SmileUserObject_Create((SmileObject)Smile_KnownBases.Object, 0);
+	SmileUserObject_SetC(holderA, "items", (SmileObject)points);
+	SmileUserObject_SetC(holderB, "items", (SmileObject)points);
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-a"), (SmileObject)holderA);
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-b"), (SmileObject)holderB);
+
+	census = HeapCensus_Take(100000);
+
+	a = FindRetainer(census, "<globals>.census-a");
+	b = FindRetainer(census, "<globals>.census-b");
+	ASSERT(a != NULL && b != NULL);
+	ASSERT(a->retainedCount == 1);
+	ASSERT(b->retainedCount == 1);
+
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-a"));
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-b"));
+}
+END_TEST
+
+START_TEST(ObjectsAreRetainedThroughCells)
+{
+	HeapCensus census;
+	HeapCensusRetainer retainer;
+	SmileCell cell;
+
+	// This is how a closure holds a mutable captured variable.
+	SetupGlobals();
+	cell = SmileCell_Create(SmileArg_From((SmileObject)CreateList(20000)));
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-cell"), (SmileObject)cell);
+
+	census = HeapCensus_Take(100000);
+
+	retainer = FindRetainer(census, "<globals>.census-cell");
+	ASSERT(retainer != NULL);
+	ASSERT(String_EqualsC(retainer->name, "Cell"));
+	ASSERT(retainer->retainedCount == 20001);
+	ASSERT(retainer->retainedBytes >= 20000 * sizeof(struct SmileListInt));
+
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-cell"));
+}
+END_TEST
+
+START_TEST(ValuesAreRetainedThroughWeakMapsButKeysAreNot)
+{
+	HeapCensus census;
+	HeapCensusRetainer retainer;
+	SmileUserObject key;
+	WeakMap weakMap;
+	SmileHandle handle;
+
+	SetupGlobals();
+	key = SmileUserObject_Create((SmileObject)Smile_KnownBases.Object, 0);
+	weakMap = WeakMap_Create(16);
+	WeakMap_Set(weakMap, (SmileObject)key, (SmileObject)CreateList(1000));
+	handle = SmileHandle_Create((SmileObject)Smile_KnownBases.WeakMap, NULL, Smile_KnownSymbols.WeakMap_, weakMap);
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-map"), (SmileObject)handle);
+	Smile_SetGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-key"), (SmileObject)key);
+
+	census = HeapCensus_Take(100000);
+
+	retainer = FindRetainer(census, "<globals>.census-map");
+	ASSERT(retainer != NULL);
+	ASSERT(String_EqualsC(retainer->name, "Handle"));
+	ASSERT(retainer->retainedCount == 1001);
+
+	retainer = FindRetainer(census, "<globals>.census-key");
+	ASSERT(retainer != NULL);
+	ASSERT(retainer->retainedCount == 1);
+
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-map"));
+	Smile_DeleteGlobalVariable(SymbolTable_GetSymbolC(Smile_SymbolTable, "census-key"));
+}
+END_TEST
+
+START_TEST(CensusTextIsSortedByGroupName)
+{
+	HeapCensus census;
+	String text;
+	Int i;
+
+	census = HeapCensus_Take(HEAPCENSUS_DEFAULT_RETAINERS);
+
+	ASSERT(census->totalCount > 0);
+	ASSERT(census->numRetainers <= HEAPCENSUS_DEFAULT_RETAINERS);
+	for (i = 1; i < census->numGroups; i++) {
+		ASSERT(String_Compare(census->groups[i - 1].name, census->groups[i].name) < 0);
+	}
+
+	text = HeapCensus_ToString(census);
+	ASSERT(String_StartsWithC(text, "# Smile heap census v1\ntotal\t"));
+	ASSERT(String_Contains(text, String_FromC("\ngroup\tString\t")));
+}
+END_TEST
+
+#include "heapcensus_tests.generated.inc"
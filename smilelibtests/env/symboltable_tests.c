@@ -311,6 +311,122 @@ START_TEST(CanExamineASymbolTableWithoutAlteringItC)
 }
 END_TEST
 
+START_TEST(UnmarkedCollectableSymbolsAreReclaimedBySweeps)
+{
+	SymbolTable symbolTable;
+	Symbol soup, nuts, banana, cherry;
+
+	symbolTable = SymbolTable_Create();
+
+	soup = SymbolTable_GetSymbolC(symbolTable, "soup");
+	nuts = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("nuts"));
+	banana = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("banana"));
+	cherry = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("cherry"));
+
+	ASSERT(!SymbolTable_IsCollectable(symbolTable, soup));
+	ASSERT(SymbolTable_IsCollectable(symbolTable, nuts));
+	ASSERT(((struct SymbolTableInt *)symbolTable)->numCollectable == 3);
+
+	SymbolTable_BeginSweep(symbolTable);
+	SymbolTable_MarkSymbol(symbolTable, banana);
+	ASSERT(SymbolTable_EndSweep(symbolTable) == 2);
+
+	ASSERT(((struct SymbolTableInt *)symbolTable)->numCollectable == 1);
+	ASSERT(SymbolTable_GetName(symbolTable, nuts) == NULL);
+	ASSERT(SymbolTable_GetName(symbolTable, cherry) == NULL);
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "nuts") == 0);
+	ASSERT_STRING(SymbolTable_GetName(symbolTable, banana), "banana", 6);
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "banana") == banana);
+	ASSERT_STRING(SymbolTable_GetName(symbolTable, soup), "soup", 4);
+
+	// Nothing marks anything this time, so the last one goes too, but the permanent symbol stays.
+	SymbolTable_BeginSweep(symbolTable);
+	ASSERT(SymbolTable_EndSweep(symbolTable) == 1);
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "banana") == 0);
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "soup") == soup);
+}
+END_TEST
+
+START_TEST(LookingUpACollectableSymbolPinsIt)
+{
+	SymbolTable symbolTable;
+	Symbol nuts, banana;
+
+	symbolTable = SymbolTable_Create();
+
+	nuts = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("nuts"));
+	banana = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("banana"));
+
+	// Neither the no-create lookups nor collectable lookups pin; only ordinary lookups do.
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "nuts") == nuts);
+	ASSERT(SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("nuts")) == nuts);
+	ASSERT(SymbolTable_IsCollectable(symbolTable, nuts));
+
+	ASSERT(SymbolTable_GetSymbolC(symbolTable, "nuts") == nuts);
+	ASSERT(!SymbolTable_IsCollectable(symbolTable, nuts));
+	ASSERT(SymbolTable_GetSymbol(symbolTable, String_FromC("banana")) == banana);
+	ASSERT(!SymbolTable_IsCollectable(symbolTable, banana));
+
+	SymbolTable_BeginSweep(symbolTable);
+	ASSERT(SymbolTable_EndSweep(symbolTable) == 0);
+	ASSERT_STRING(SymbolTable_GetName(symbolTable, nuts), "nuts", 4);
+	ASSERT_STRING(SymbolTable_GetName(symbolTable, banana), "banana", 6);
+}
+END_TEST
+
+START_TEST(ReclaimedSymbolIdsAreReused)
+{
+	SymbolTable symbolTable;
+	Symbol nuts, banana, cherry;
+	Int count;
+
+	symbolTable = SymbolTable_Create();
+
+	nuts = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("nuts"));
+	count = ((struct SymbolTableInt *)symbolTable)->count;
+
+	SymbolTable_BeginSweep(symbolTable);
+	ASSERT(SymbolTable_EndSweep(symbolTable) == 1);
+
+	banana = SymbolTable_GetSymbolC(symbolTable, "banana");
+	ASSERT(banana == nuts);
+	ASSERT(!SymbolTable_IsCollectable(symbolTable, banana));
+	ASSERT_STRING(SymbolTable_GetName(symbolTable, banana), "banana", 6);
+
+	cherry = SymbolTable_GetCollectableSymbol(symbolTable, String_FromC("cherry"));
+	ASSERT(cherry != banana);
+	ASSERT(((struct SymbolTableInt *)symbolTable)->count == count + 1);
+}
+END_TEST
+
+START_TEST(ManyCollectableSymbolsRequestASweep)
+{
+	SymbolTable symbolTable;
+	Symbol symbol;
+	Int i;
+
+	symbolTable = SymbolTable_Create();
+
+	for (i = 0; i < SYMBOLTABLE_MIN_SWEEP_THRESHOLD; i++) {
+		ASSERT(!SymbolTable_NeedsSweep(symbolTable));
+		SymbolTable_GetCollectableSymbol(symbolTable, String_Format("sym%d", (int)i));
+	}
+	ASSERT(SymbolTable_NeedsSweep(symbolTable));
+
+	// Keep half of them; afterward, it takes twice the survivors to request another sweep.
+	SymbolTable_BeginSweep(symbolTable);
+	for (i = 0; i < SYMBOLTABLE_MIN_SWEEP_THRESHOLD; i += 2) {
+		symbol = SymbolTable_GetSymbolNoCreate(symbolTable, String_Format("sym%d", (int)i));
+		SymbolTable_MarkSymbol(symbolTable, symbol);
+	}
+	ASSERT(SymbolTable_EndSweep(symbolTable) == SYMBOLTABLE_MIN_SWEEP_THRESHOLD / 2);
+	ASSERT(!SymbolTable_NeedsSweep(symbolTable));
+	ASSERT(((struct SymbolTableInt *)symbolTable)->numCollectable == SYMBOLTABLE_MIN_SWEEP_THRESHOLD / 2);
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "sym2") != 0);
+	ASSERT(SymbolTable_GetSymbolNoCreateC(symbolTable, "sym3") == 0);
+}
+END_TEST
+
 START_TEST(SymbolTablePerformanceTest)
 {
 	SymbolTable symbolTable;
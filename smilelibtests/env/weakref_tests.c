@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/env/weakref.h>
+#include <smile/smiletypes/smilelist.h>
+#include <smile/smiletypes/smileuserobject.h>
+#include <smile/smiletypes/smilefunction.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/internal/staticstring.h>
+
+TEST_SUITE(WeakRefTests)
+
+//-------------------------------------------------------------------------------------------------
+//  Helper functions.
+//
+//  Because the collector scans the C stack conservatively, a stray copy of a pointer can keep any
+//  one object alive; so these tests create their garbage in separate functions, create a lot of it,
+//  and only require that most of it be collected.
+
+#define NUM_GARBAGE 1000
+
+STATIC_STRING(_staticString, "I live in the data segment.");
+
+static SmileObject CreateObject(void)
+{
+	return (SmileObject)SmileUserObject_Create((SmileObject)Smile_KnownBases.Object, 0);
+}
+
+static WeakRef *CreateWeakRefsToGarbage(void)
+{
+	WeakRef *weakRefs = GC_MALLOC(sizeof(WeakRef) * NUM_GARBAGE);
+	Int i;
+
+	for (i = 0; i < NUM_GARBAGE; i++)
+		weakRefs[i] = WeakRef_Create(CreateObject());
+
+	return weakRefs;
+}
+
+static void AddGarbageKeys(WeakMap weakMap)
+{
+	Int i;
+
+	for (i = 0; i < NUM_GARBAGE; i++)
+		WeakMap_Set(weakMap, CreateObject(), (SmileObject)SmileInteger64_Create(i));
+}
+
+static void RegisterGarbageCallbacks(SmileFunction fn)
+{
+	Int i;
+
+	for (i = 0; i < NUM_GARBAGE; i++)
+		OnCollect_Register(CreateObject(), fn);
+}
+
+SMILE_EXTERNAL_FUNCTION(DoNothing)
+{
+	return SmileArg_From(NullObject);
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Weak reference tests.
+
+START_TEST(WeakRefsToLiveObjectsSurviveCollection)
+{
+	SmileObject obj = CreateObject();
+	SmileList holder = SmileList_Cons(obj, NullObject);
+	WeakRef weakRef = WeakRef_Create(obj);
+
+	GC_gcollect();
+
+	ASSERT(WeakRef_Get(weakRef) == holder->a);
+}
+END_TEST
+
+START_TEST(WeakRefsToDeadObjectsAreCleared)
+{
+	WeakRef *weakRefs = CreateWeakRefsToGarbage();
+	Int i, numCleared = 0;
+
+	GC_gcollect();
+
+	for (i = 0; i < NUM_GARBAGE; i++) {
+		if (WeakRef_Get(weakRefs[i]) == NULL)
+			numCleared++;
+	}
+	ASSERT(numCleared > NUM_GARBAGE / 2);
+}
+END_TEST
+
+START_TEST(WeakRefsToStaticObjectsAreNeverCleared)
+{
+	WeakRef weakRef = WeakRef_Create((SmileObject)_staticString);
+
+	ASSERT(!Weak_IsCollectable((SmileObject)_staticString));
+
+	GC_gcollect();
+
+	ASSERT(WeakRef_Get(weakRef) == (SmileObject)_staticString);
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Weak map tests.
+
+START_TEST(WeakMapsStoreAndRemoveEntriesByIdentity)
+{
+	WeakMap weakMap = WeakMap_Create(0);
+	SmileObject keys[100];
+	SmileObject value;
+	Int i;
+
+	for (i = 0; i < 100; i++) {
+		keys[i] = CreateObject();
+		WeakMap_Set(weakMap, keys[i], (SmileObject)SmileInteger64_Create(i));
+	}
+	WeakMap_Set(weakMap, keys[7], (SmileObject)SmileInteger64_Create(700));
+
+	ASSERT(WeakMap_Count(weakMap) == 100);
+	for (i = 0; i < 100; i++) {
+		ASSERT(WeakMap_TryGetValue(weakMap, keys[i], &value));
+		ASSERT(((SmileInteger64)value)->value == (i == 7 ? 700 : i));
+	}
+	ASSERT(!WeakMap_TryGetValue(weakMap, CreateObject(), &value));
+
+	ASSERT(WeakMap_Remove(weakMap, keys[3]));
+	ASSERT(!WeakMap_Remove(weakMap, keys[3]));
+	ASSERT(!WeakMap_TryGetValue(weakMap, keys[3], &value));
+	ASSERT(WeakMap_Count(weakMap) == 99);
+
+	WeakMap_Clear(weakMap);
+	ASSERT(WeakMap_Count(weakMap) == 0);
+	ASSERT(!WeakMap_TryGetValue(weakMap, keys[0], &value));
+}
+END_TEST
+
+START_TEST(WeakMapsDropEntriesWhoseKeysAreCollected)
+{
+	WeakMap weakMap = WeakMap_Create(0);
+	SmileObject liveKey = CreateObject();
+	SmileList holder = SmileList_Cons(liveKey, NullObject);
+	SmileObject value;
+
+	WeakMap_Set(weakMap, liveKey, (SmileObject)SmileInteger64_Create(-1));
+	AddGarbageKeys(weakMap);
+
+	GC_gcollect();
+
+	ASSERT(WeakMap_Count(weakMap) < NUM_GARBAGE / 2);
+	ASSERT(WeakMap_TryGetValue(weakMap, holder->a, &value));
+	ASSERT(((SmileInteger64)value)->value == -1);
+
+	// The map must still work correctly after reusing the expired slots.
+	AddGarbageKeys(weakMap);
+	ASSERT(WeakMap_TryGetValue(weakMap, holder->a, &value));
+	ASSERT(((SmileInteger64)value)->value == -1);
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Collection callback tests.
+
+START_TEST(OnCollectCallbacksAreQueuedUntilDequeued)
+{
+	SmileFunction fn = SmileFunction_CreateExternalFunction(DoNothing, NULL, "do-nothing", "obj", 0, 1, 1, 0, NULL);
+	OnCollectRecord record;
+	Int numCalled = 0;
+
+	while (OnCollect_Dequeue() != NULL) ;
+
+	RegisterGarbageCallbacks(fn);
+
+	GC_gcollect();
+
+	ASSERT(OnCollect_NumPending() > NUM_GARBAGE / 2);
+
+	while ((record = OnCollect_Dequeue()) != NULL) {
+		ASSERT(record->fn == fn);
+		ASSERT(record->obj != NULL && SMILE_KIND(record->obj) == SMILE_KIND_USEROBJECT);
+		numCalled++;
+	}
+
+	ASSERT(numCalled > NUM_GARBAGE / 2);
+	ASSERT(OnCollect_NumPending() == 0);
+}
+END_TEST
+
+START_TEST(OnCollectRefusesObjectsThatCannotBeCollected)
+{
+	SmileFunction fn = SmileFunction_CreateExternalFunction(DoNothing, NULL, "do-nothing", "obj", 0, 1, 1, 0, NULL);
+
+	ASSERT(!OnCollect_Register((SmileObject)_staticString, fn));
+	ASSERT(OnCollect_Register(CreateObject(), fn));
+}
+END_TEST
+
+#include "weakref_tests.generated.inc"
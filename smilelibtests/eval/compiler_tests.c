@@ -347,7 +347,8 @@ START_TEST(CanCompileWritesToMembers)
 		"2: \tLdX     `gb (%hd)\t; test.sm:1\n"
 		"3: \tLdNull\t; test.sm:1\n"
 		"4: \tStMember\t; test.sm:1\n"
-		"5: \tRet\n",
+		"5: \tPop1\t; test.sm:1\n"
+		"6: \tRet\n",
 		SymbolTable_GetSymbolC(Smile_SymbolTable, "ga"),
 		SymbolTable_GetSymbolC(Smile_SymbolTable, "gb")
 	);
@@ -455,7 +456,8 @@ START_TEST(CanCompileMutationsOfMembers)
 		"6: \tBinary  `+ (%hd)\t; test.sm:1\n"
 		"7: \tLdNull\t; test.sm:1\n"
 		"8: \tStMember\t; test.sm:1\n"
-		"9: \tRet\n",
+		"9: \tPop1\t; test.sm:1\n"
+		"10: \tRet\n",
 		SymbolTable_GetSymbolC(Smile_SymbolTable, "ga"),
 		SymbolTable_GetSymbolC(Smile_SymbolTable, "gb"),
 		SymbolTable_GetSymbolC(Smile_SymbolTable, "+")
@@ -1367,7 +1369,7 @@ START_TEST(CanCompileATillLoopToEscapeNestedFunctions)
 
 		"2: \tBf      >L5\t; test.sm:4\n"
 
-		"3: \tLdLoc1  ` (1)\t; test.sm:4\n"
+		"3: \tLdLoc1  `found-even (0)\t; test.sm:4\n"
 		"4: \tTillEsc 1\t; test.sm:4\n"
 
 		"5: \tLdNull\t; test.sm:4\n"
@@ -1063,4 +1063,603 @@ START_TEST(TillLoopEscapesRestoreTheStackState)
 }
 END_TEST
 
+START_TEST(CanIterateRangesWithInlinedLoops)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var y = 0\n"
+		"1..10 each |x| y += x * x\n"
+		"10..1 each |x| y = y * 2 + x\n"
+		"y\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 403457);
+}
+END_TEST
+
+START_TEST(CanProjectRangesWithInlinedLoops)
+{
+	static Int64 expectedResult[] = { 50, 40, 30, 20, 10 };
+	Int i;
+	SmileList list;
+
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"5..1 map |x| x * 10\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_LIST);
+
+	for (i = 0, list = (SmileList)result->value; SMILE_KIND(list) == SMILE_KIND_LIST; list = LIST_REST(list), i++) {
+		ASSERT(SMILE_KIND(list->a) == SMILE_KIND_INTEGER64);
+		ASSERT(((SmileInteger64)list->a)->value == expectedResult[i]);
+	}
+	ASSERT(i == 5);
+}
+END_TEST
+
+START_TEST(InlinedLoopsFallBackWhenTheMethodIsReplaced)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var g = |r| r map |x| x + 1\n"
+		"var a = [g `[1 2]]\n"
+		"List.map = |self f| 99\n"
+		"[g `[1 2]] + a.a\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 101);
+}
+END_TEST
+
+START_TEST(InlinedLoopsChooseTheLoopThatMatchesTheReceiversKind)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var total = 0\n"
+		"var g = |r| r each |x| total += x\n"
+		"[g `[1 2 3]]\n"
+		"[g 10..12]\n"
+		"[g null]\n"
+		"total\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 39);
+}
+END_TEST
+
+START_TEST(ManyInlinedLoopsCanShareOneFunction)
+{
+	// Each inlined loop adds a constant to the object table, so this is enough loops to make
+	// the table grow while earlier constants (like the quoted list) are still in use.
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var f = |l| {\n"
+		"\tvar y = 0\n"
+		"\tvar a = l map |x| x + 1\n"
+		"\tvar q = `[100 200]\n"
+		"\tvar b = a map |x| x * 10\n"
+		"\ta each |x| y += x\n"
+		"\tb each |x| y += x\n"
+		"\tvar c = b map |x| x + 2\n"
+		"\tvar d = c map |x| x + 3\n"
+		"\td each |x| y += x\n"
+		"\t1..3 each |x| y += x * 1000\n"
+		"\tq each |x| y += x * 10000\n"
+		"\tvar e = q map |x| x + 1\n"
+		"\te each |x| y += x * 1000000\n"
+		"\ty\n"
+		"}\n"
+		"[f `[1 2 3]]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	// a = [2 3 4], b = [20 30 40], d = [25 35 45], e = [101 201]:
+	//   9 + 90 + 105 + 6000 + 3000000 + 302000000.
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 305006204);
+}
+END_TEST
+
+START_TEST(CanInlineCallsToSmallConstFunctions)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"const add = |a b| a + b\n"
+		"[add [add 1 2] [|x| x * 10 4]]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 43);
+}
+END_TEST
+
+START_TEST(ClosuresShareCapturedVariablesThatChange)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var make-counter = |start| {\n"
+		"\tvar n = start\n"
+		"\tvar get = || n\n"
+		"\tvar bump = |by| n += by\n"
+		"\t[bump 1]\n"
+		"\t[bump 2]\n"
+		"\t[get] * 100 + start\n"
+		"}\n"
+		"[make-counter 10]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 1310);
+}
+END_TEST
+
+START_TEST(ClosuresCanCaptureManyVariables)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var f = |a b c d e f| {\n"
+		"\tvar inner = |x| a + b*10 + c*100 + d*1000 + e*10000 + f*100000 + x\n"
+		"\t[inner 0]\n"
+		"}\n"
+		"[f 1 2 3 4 5 6]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 654321);
+}
+END_TEST
+
+START_TEST(ClosuresCanCaptureVariablesFromDeeplyNestedFunctions)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var f = |a| {\n"
+		"\tvar b = a * 2\n"
+		"\t|c| {\n"
+		"\t\tvar d = c + 1\n"
+		"\t\t|e| a * 1000 + b * 100 + d * 10 + e\n"
+		"\t}\n"
+		"}\n"
+		"[[[f 1] 2] 3]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 1233);
+}
+END_TEST
+
+START_TEST(ClosuresCanCallThemselvesRecursively)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var f = || {\n"
+		"\tvar fact\n"
+		"\tfact = |n| if n < 2 then 1 else n * [fact (n - 1)]\n"
+		"\t[fact 10]\n"
+		"}\n"
+		"[f]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 3628800);
+}
+END_TEST
+
+START_TEST(ClosuresCanAssignCapturedArguments)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var f = |a| {\n"
+		"\tvar g = || a = a + 1\n"
+		"\t[g]\n"
+		"\t[g]\n"
+		"\ta\n"
+		"}\n"
+		"[f 10]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 12);
+}
+END_TEST
+
+START_TEST(ValuesReachableOnlyThroughClosureVariablesSurviveCollection)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var make = |n| {\n"
+		"\tvar xs = 1..n map |x| x * 2\n"
+		"\tvar s = 1..n map |x| [x.string]\n"
+		"\t|| {\n"
+		"\t\tvar t = 0\n"
+		"\t\txs each |x| t += x\n"
+		"\t\ts each |x| t += [Integer64.parse x]\n"
+		"\t\tt\n"
+		"\t}\n"
+		"}\n"
+		"var g = [make 1000]\n"
+		"[Gc.collect]\n"
+		"var i = 0\n"
+		"while i < 20000 do { [List.of i i i] i += 1 }\n"
+		"[Gc.collect]\n"
+		"[g]\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 1501500);
+}
+END_TEST
+
+START_TEST(WeakRefsAndWeakMapsCanBeUsedFromScripts)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var obj = new Object { x: 5 }\n"
+		"var r = [WeakRef.of obj]\n"
+		"var m = [WeakMap.of]\n"
+		"[m.set obj 42]\n"
+		"var got = [r.get]\n"
+		"var b = [m.get obj]\n"
+		"var c = [m.count]\n"
+		"var d = [m.has? obj]\n"
+		"[m.remove obj]\n"
+		"got.x * 1000 + b + c * 100 + (if d then 10000 else 0) + [m.count] * 100000 + (if [r.alive?] then 1000000 else 0)\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 1015142);
+}
+END_TEST
+
+START_TEST(WeakRefsExpireWhenTheirTargetsAreCollected)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var make-refs = |n| {\n"
+		"\tvar refs = []\n"
+		"\tvar i = 0\n"
+		"\twhile i < n do {\n"
+		"\t\trefs = [List.cons [WeakRef.of (new Object { x: i })] refs]\n"
+		"\t\ti += 1\n"
+		"\t}\n"
+		"\trefs\n"
+		"}\n"
+		"var refs = [make-refs 100]\n"
+		"[Gc.collect]\n"
+		"var dead = 0\n"
+		"refs each |r| if not [r.alive?] then dead += 1\n"
+		"dead >= 90\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_BOOL);
+	ASSERT(((SmileBool)result->value)->value);
+}
+END_TEST
+
+START_TEST(GcCollectRunsOnCollectCallbacks)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var collected = 0\n"
+		"var watch = |n| {\n"
+		"\tvar i = 0\n"
+		"\twhile i < n do {\n"
+		"\t\t[Gc.on-collect (new Object { x: i }) |o| collected += o.x + 1]\n"
+		"\t\ti += 1\n"
+		"\t}\n"
+		"}\n"
+		"[watch 100]\n"
+		"var i = 0\n"
+		"while collected < 5050 and i < 100 do {\n"
+		"\t[Gc.collect]\n"
+		"\ti += 1\n"
+		"}\n"
+		"collected\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 5050);
+}
+END_TEST
+
+START_TEST(OnCollectCallbacksRunAtSafePoints)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var collected = 0\n"
+		"var watch = |n| {\n"
+		"\tvar i = 0\n"
+		"\twhile i < n do {\n"
+		"\t\t[Gc.on-collect (new Object { x: i }) |o| collected += 1]\n"
+		"\t\ti += 1\n"
+		"\t}\n"
+		"}\n"
+		"[watch 100]\n"
+		"var i = 0\n"
+		"while collected == 0 and i < 1000000 do {\n"
+		"\t[List.of i i i i]\n"
+		"\ti += 1\n"
+		"}\n"
+		"collected > 0\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_BOOL);
+	ASSERT(((SmileBool)result->value)->value);
+}
+END_TEST
+
+START_TEST(UnreachableRuntimeSymbolsCanBeCollected)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var keep = [\"kept-symbol\".symbol]\n"
+		"var o = new Object { }\n"
+		"[Object.set-property o [\"prop-key\".symbol] 12]\n"
+		"var syms = []\n"
+		"var i = 0\n"
+		"while i < 1000 do {\n"
+		"\tsyms = [List.cons [(\"tmp-\" + [i.string]).symbol] syms]\n"
+		"\ti += 1\n"
+		"}\n"
+		"[Gc.collect-symbols]\n"
+		"syms = null\n"
+		"var n = [Gc.collect-symbols]\n"
+		"n >= 990 and [\"kept-symbol\".symbol] == keep and [Object.get-property o [\"prop-key\".symbol]] == 12\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_BOOL);
+	ASSERT(((SmileBool)result->value)->value);
+}
+END_TEST
+
+START_TEST(RuntimeSymbolsSurviveAutomaticSweepsWhileInUse)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var held = 1..40000 map |i| {\n"
+		"\t[(\"junk-\" + [i.string]).symbol]\n"
+		"\tvar k = 0\n"
+		"\twhile k < 1 do k += 1\n"
+		"\t[(\"held-\" + [i.string]).symbol]\n"
+		"}\n"
+		"var ok = 0\n"
+		"var j = 1\n"
+		"held each |s| {\n"
+		"\tif [s.string] == \"held-\" + [j.string] then ok += 1\n"
+		"\tj += 1\n"
+		"}\n"
+		"ok == 40000 and [Gc.collectable-symbols] < 80000\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_BOOL);
+	ASSERT(((SmileBool)result->value)->value);
+}
+END_TEST
+
+START_TEST(PureBuiltinsProduceCorrectResults)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var l = [List.of 1 2 3]\n"
+		"var n = 0\n"
+		"if \"abc\" < \"abd\" and [l.length] == 3 and not [l.empty?] and 'x' > 'a' then\n"
+		"\tn = [l.length] * 10 + 7 - 1\n"
+		"n\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == 36);
+}
+END_TEST
+
+START_TEST(PureBuiltinsStillReportArgumentTypeMismatches)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var x = 1\n"
+		"x + \"abc\"\n"
+	);
+
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_EXCEPTION);
+}
+END_TEST
+
+START_TEST(ListReductionsWrapLikeIntegerArithmetic)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var big = `[0x7FFFFFFFFFFFFFFF 1]\n"
+		"[big.sum]\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_INTEGER64);
+	ASSERT(((SmileInteger64)result->value)->value == Int64Min);
+
+	globalFunctionInfo = Compile(
+		"var a = `[2 3 7], b = `[3 1 4 1 5], c = `[]\n"
+		"[List.of [a.product] [b.min] [b.max] [c.sum] [c.product] [c.min] === null] join \" \"\n"
+	);
+	result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "42 1 5 0 1 true", 15);
+}
+END_TEST
+
+START_TEST(ListReductionsFallBackToMethodsForOtherTypes)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var a = `[\"foo\" \"bar\" \"baz\"], b = `[\"pear\" \"apple\" \"fig\"]\n"
+		"[List.of [a.sum] [b.min] [b.max]] join \" \"\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "foobarbaz apple pear", 20);
+}
+END_TEST
+
+START_TEST(CanFoldAndReduceListsWithUserFunctions)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var words = `[\"pear\" \"apple\" \"fig\"], nums = `[1 2 3 4], empty = `[]\n"
+		"[List.of\n"
+		"\t[nums.fold 10 |a b| a * b]\n"
+		"\t[nums.reduce |a b| a - b]\n"
+		"\t[words.min-by |w| w.length]\n"
+		"\t[words.max-by |w| w.length]\n"
+		"\t[empty.reduce |a b| a + b] === null\n"
+		"\t[empty.fold 7 |a b| a + b]\n"
+		"] join \" \"\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "240 -8 fig apple true 7", 23);
+}
+END_TEST
+
+START_TEST(RangeReductionsMatchIteratedArithmetic)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"[List.of\n"
+		"\t[(1..100 step 3).sum]\n"
+		"\t[(100..1 step -7).min]\n"
+		"\t[(1..100 step 7).max]\n"
+		"\t[(1..20).product]\n"
+		"\t[(0x7FFFFFFFFFFFFFF0..0x7FFFFFFFFFFFFFFF).sum]\n"
+		"\t[(1..10).fold 0 |a b| a + b * b]\n"
+		"\t[(1..10).min-by |x| (x - 4) * (x - 4)]\n"
+		"] join \" \"\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "1717 2 99 2432902008176640000 -136 385 4", 40);
+}
+END_TEST
+
+START_TEST(ByteArrayReductionsWidenToInteger64)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var b = [ByteArray.of-size 300 7x]\n"
+		"b:10 = 250x\n"
+		"b:20 = 1x\n"
+		"[List.of [b.sum] [b.min] [b.max] [b.fold 0 |a x| a + 1]] join \" \"\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "2337 1 250 300", 14);
+}
+END_TEST
+
+START_TEST(PreparedCaseInsensitiveSearchesCanBeReused)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var p = [\"ERROR\".prepare-search~]\n"
+		"var a = \"warning: Error in line 3\"\n"
+		"var b = \"all clear\"\n"
+		"[List.of [a.index-of~ p] [b.index-of~ p] [a.contains~? p] [b.contains~? p] [\"error error\".count-of~ p] [a.replace~ p \"fault\"]] join \" \"\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "9  true false 2 warning: fault in line 3", 40);
+}
+END_TEST
+
+START_TEST(StringBuildersAppendWithoutRecopying)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var sb = [StringBuilder.of]\n"
+		"var i = 0\n"
+		"while i < 1000 do {\n"
+		"\t[sb.append \"ab\" i]\n"
+		"\ti = i + 1\n"
+		"}\n"
+		"var first = [sb.to-string]\n"
+		"[sb.append-line \"!\"]\n"
+		"var second = [sb.to-string]\n"
+		"[List.of first.length second.length [sb.length] [first.substring 0 8] [second.substring 4885 7]] join \" \"\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value, "4890 4892 4892 ab0ab1ab ab999!\n", 31);
+}
+END_TEST
+
+START_TEST(StringBuildersCanGenerateHtml)
+{
+	UserFunctionInfo globalFunctionInfo = Compile(
+		"var names = [List.of \"x\" \"y\" \"\xE2\x98\xBA\"]\n"
+		"var sb = [StringBuilder.of \"<ul>\"]\n"
+		"var i = 1\n"
+		"while i <= 3 do {\n"
+		"\t[sb.append-format \"<li id=\\\"%02d\\\">%s</li>\" i names:(i - 1)]\n"
+		"\ti = i + 1\n"
+		"}\n"
+		"[[sb.append \"</ul>\" null].append-format \"%%%-4s|%5x|%X\" \"ok\" 255 255]\n"
+		"[sb.to-string]\n"
+	);
+	EvalResult result = Eval_Run(globalFunctionInfo);
+
+	ASSERT(result->evalResultKind == EVAL_RESULT_VALUE);
+	ASSERT(SMILE_KIND(result->value) == SMILE_KIND_STRING);
+	ASSERT_STRING((String)result->value,
+		"<ul><li id=\"01\">x</li><li id=\"02\">y</li><li id=\"03\">\xE2\x98\xBA</li></ul>%ok  |   ff|FF", 79);
+}
+END_TEST
+
 #include "eval_tests.generated.inc"
@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/env/env.h>
+#include <smile/smiletypes/smilepackedarg.h>
+#include <smile/smiletypes/smilebool.h>
+#include <smile/smiletypes/numeric/smileinteger32.h>
+#include <smile/smiletypes/numeric/smileinteger64.h>
+#include <smile/smiletypes/numeric/smilefloat64.h>
+#include <smile/smiletypes/text/smilechar.h>
+#include <smile/smiletypes/text/smileuni.h>
+
+TEST_SUITE(PackedArgTests)
+
+START_TEST(PackedArgsAreEightBytes)
+{
+	ASSERT(sizeof(SmilePackedArg) == 8);
+}
+END_TEST
+
+START_TEST(SmallScalarsRoundTripInline)
+{
+	SmilePackedArg packed;
+	SmileArg arg;
+
+	packed = SmilePackedArg_Pack(SmileUnboxedInteger32_From(-12345));
+	ASSERT(SmilePackedArg_IsScalar(packed));
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_UNBOXED_INTEGER32);
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_INTEGER32);
+	ASSERT(arg.unboxed.i32 == -12345);
+
+	packed = SmilePackedArg_Pack(SmileUnboxedBool_From(True));
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_UNBOXED_BOOL);
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_BOOL);
+	ASSERT(arg.unboxed.b == True);
+
+	packed = SmilePackedArg_Pack(SmileUnboxedChar_From('x'));
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_UNBOXED_CHAR);
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_CHAR);
+	ASSERT(arg.unboxed.ch == 'x');
+
+	packed = SmilePackedArg_Pack(SmileUnboxedUni_From(0x1F600));
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_UNBOXED_UNI);
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_UNI);
+	ASSERT(arg.unboxed.uni == 0x1F600);
+}
+END_TEST
+
+START_TEST(Integer64sFitInlineOnlyWithin48Bits)
+{
+	SmilePackedArg packed;
+	SmileArg arg;
+
+	packed = SmilePackedArg_Pack(SmileUnboxedInteger64_From(-((Int64)1 << 47)));
+	ASSERT(SmilePackedArg_IsInt48(packed));
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_UNBOXED_INTEGER64);
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_INTEGER64);
+	ASSERT(arg.unboxed.i64 == -((Int64)1 << 47));
+
+	packed = SmilePackedArg_Pack(SmileUnboxedInteger64_From((Int64)1 << 47));
+	ASSERT(SmilePackedArg_IsObject(packed));
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_INTEGER64);
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_INTEGER64);
+	ASSERT(arg.unboxed.i64 == (Int64)1 << 47);
+}
+END_TEST
+
+START_TEST(Float64sRoundTripIncludingSpecialValues)
+{
+	static const Float64 values[] = { 0.0, -0.0, 1.5, -1.0e300, 4.9e-324, 1.0 / 0.0, -1.0 / 0.0 };
+	SmilePackedArg packed;
+	SmileArg arg;
+	Int i;
+
+	for (i = 0; i < sizeof(values) / sizeof(Float64); i++) {
+		packed = SmilePackedArg_Pack(SmileUnboxedFloat64_From(values[i]));
+		ASSERT(SmilePackedArg_IsFloat64(packed));
+		ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_UNBOXED_FLOAT64);
+		arg = SmilePackedArg_Unpack(packed);
+		ASSERT(SMILE_KIND(arg.obj) == SMILE_KIND_UNBOXED_FLOAT64);
+		ASSERT(MemCmp(&arg.unboxed.f64, &values[i], sizeof(Float64)) == 0);
+	}
+
+	packed = SmilePackedArg_FromFloat64(0.0 / 0.0);
+	ASSERT(SmilePackedArg_IsFloat64(packed));
+	ASSERT(SmilePackedArg_GetFloat64(packed) != SmilePackedArg_GetFloat64(packed));
+}
+END_TEST
+
+START_TEST(ObjectsArePackedAsPlainPointers)
+{
+	SmileObject obj = (SmileObject)String_FromC("hello");
+	SmilePackedArg packed = SmilePackedArg_Pack(SmileArg_From(obj));
+	SmileArg arg;
+
+	ASSERT(SmilePackedArg_IsObject(packed));
+	ASSERT(packed == (SmilePackedArg)(PtrInt)obj);
+	ASSERT(SMILE_PACKED_KIND(packed) == SMILE_KIND_STRING);
+
+	arg = SmilePackedArg_Unpack(packed);
+	ASSERT(arg.obj == obj);
+}
+END_TEST
+
+#include "packedarg_tests.generated.inc"
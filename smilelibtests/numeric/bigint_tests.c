@@ -0,0 +1,348 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/numeric/bigint.h>
+#include <smile/parsing/lexer.h>
+
+TEST_SUITE(BigIntTests)
+
+//-------------------------------------------------------------------------------------------------
+//  Helper functions and macros.
+
+#define BI(__n__) BigInt_FromInt64(__n__)
+
+static BigInt B(const char *text)
+{
+	BigInt result;
+	if (!BigInt_TryParse((const Byte *)text, StrLen(text), 10, &result))
+		return NULL;
+	return result;
+}
+
+static Bool StrEq(BigInt x, const char *text)
+{
+	return String_EqualsC(BigInt_ToString(x, 10), text);
+}
+
+/// <summary>
+/// Make a "random" BigInt with exactly the given number of limbs, using a simple LCG so
+/// that the tests are repeatable.
+/// </summary>
+static BigInt MakeBig(Int numLimbs, UInt32 seed, Bool negative)
+{
+	BigInt result = BigInt_Zero;
+	UInt32 state = seed;
+	Int i;
+
+	for (i = 0; i < numLimbs; i++) {
+		state = state * 1664525 + 1013904223;
+		result = BigInt_Add(BigInt_ShiftLeft(result, 32), BigInt_FromUInt64(state | (i == 0 ? 0x80000000 : 0)));
+	}
+
+	return negative ? BigInt_Neg(result) : result;
+}
+
+/// <summary>
+/// Multiply the slow way, by shift-and-add, for checking the fast multiplication algorithms.
+/// </summary>
+static BigInt SlowMul(BigInt a, BigInt b)
+{
+	BigInt result = BigInt_Zero;
+	BigInt absB = BigInt_Abs(b);
+	Int64 bits = BigInt_BitLength(absB), i;
+
+	for (i = bits - 1; i >= 0; i--) {
+		result = BigInt_ShiftLeft(result, 1);
+		if (BigInt_IsOdd(BigInt_ShiftRight(absB, i)))
+			result = BigInt_Add(result, BigInt_Abs(a));
+	}
+
+	return (BigInt_IsNeg(a) != BigInt_IsNeg(b)) ? BigInt_Neg(result) : result;
+}
+
+static Lexer SetupLexer(const char *string)
+{
+	String source = String_FromC(string);
+	Lexer lexer = Lexer_Create(source, 0, String_Length(source), GetTestScriptName(), 1, 1, False);
+	lexer->symbolTable = Smile_SymbolTable;
+	return lexer;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Conversion tests.
+
+START_TEST(CanConvertSmallIntegers)
+{
+	ASSERT(BigInt_IsZero(BI(0)));
+	ASSERT(StrEq(BI(0), "0"));
+	ASSERT(StrEq(BI(1), "1"));
+	ASSERT(StrEq(BI(-1), "-1"));
+	ASSERT(StrEq(BI(Int64Max), "9223372036854775807"));
+	ASSERT(StrEq(BI(Int64Min), "-9223372036854775808"));
+	ASSERT(BigInt_ToInt64(BI(Int64Min)) == Int64Min);
+	ASSERT(BigInt_ToInt64(BI(-12345)) == -12345);
+	ASSERT(BigInt_FitsInInt64(BI(Int64Max)));
+	ASSERT(!BigInt_FitsInInt64(BigInt_Add(BI(Int64Max), BI(1))));
+	ASSERT(!BigInt_FitsInInt64(BigInt_Sub(BI(Int64Min), BI(1))));
+}
+END_TEST
+
+START_TEST(CanParseAndFormatInAnyRadix)
+{
+	BigInt x;
+
+	ASSERT(StrEq(B("123456789012345678901234567890"), "123456789012345678901234567890"));
+	ASSERT(StrEq(B("  -000123  "), "-123"));
+	ASSERT(StrEq(B("+1_000_000"), "1000000"));
+	ASSERT(B("") == NULL);
+	ASSERT(B("-") == NULL);
+	ASSERT(B("12a") == NULL);
+
+	ASSERT(BigInt_TryParse((const Byte *)"ffffffffffffffffffff", 20, 16, &x));
+	ASSERT(String_EqualsC(BigInt_ToString(x, 16), "ffffffffffffffffffff"));
+	ASSERT(StrEq(x, "1208925819614629174706175"));
+	ASSERT(String_EqualsC(BigInt_ToString(BI(-255), 2), "-11111111"));
+	ASSERT(String_EqualsC(BigInt_ToString(BI(35), 36), "z"));
+	ASSERT(BigInt_ToString(BI(1), 1) == NULL);
+	ASSERT(BigInt_ToString(BI(1), 37) == NULL);
+}
+END_TEST
+
+START_TEST(RadixConversionRoundTripsAcrossThresholds)
+{
+	Int sizes[] = { 1, 2, BIGINT_RADIX_CONVERSION_THRESHOLD - 1, BIGINT_RADIX_CONVERSION_THRESHOLD + 1, 100, 333 };
+	Int radixes[] = { 10, 16, 7, 36 };
+	Int i, j;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(Int); i++) {
+		for (j = 0; j < sizeof(radixes) / sizeof(Int); j++) {
+			BigInt x = MakeBig(sizes[i], (UInt32)(i * 31 + j), (i & 1) != 0), y;
+			String text = BigInt_ToString(x, radixes[j]);
+			ASSERT(BigInt_TryParse(String_GetBytes(text), String_Length(text), radixes[j], &y));
+			ASSERT(BigInt_Eq(x, y));
+		}
+	}
+}
+END_TEST
+
+START_TEST(CanConvertToAndFromFloat64)
+{
+	BigInt x;
+
+	ASSERT(BigInt_FromFloat64(1e30, &x));
+	ASSERT(StrEq(x, "1000000000000000019884624838656"));
+	ASSERT(BigInt_ToFloat64(x) == 1e30);
+	ASSERT(BigInt_FromFloat64(-2.75, &x));
+	ASSERT(StrEq(x, "-2"));
+	ASSERT(!BigInt_FromFloat64(1.0 / 0.0, &x));
+
+	// 2^53 + 1 must round to even, not truncate or round up.
+	ASSERT(BigInt_ToFloat64(BigInt_Add(BigInt_ShiftLeft(BI(1), 53), BI(1))) == 9007199254740992.0);
+	ASSERT(BigInt_ToFloat64(BigInt_Add(BigInt_ShiftLeft(BI(1), 53), BI(3))) == 9007199254740996.0);
+}
+END_TEST
+
+START_TEST(CanConvertToAndFromReal64)
+{
+	BigInt x;
+
+	ASSERT(BigInt_FromReal64(Real64_ParseC("123456789e20"), &x));
+	ASSERT(StrEq(x, "12345678900000000000000000000"));
+	ASSERT(BigInt_FromReal64(Real64_ParseC("-12.9"), &x));
+	ASSERT(StrEq(x, "-12"));
+	ASSERT(Real64_Eq(BigInt_ToReal64(BI(-579)), Real64_FromInt64(-579)));
+	ASSERT(Real64_Eq(BigInt_ToReal64(B("12345678900000000000000000000")), Real64_ParseC("123456789e20")));
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Arithmetic tests.
+
+START_TEST(CanAddAndSubtract)
+{
+	BigInt big = B("340282366920938463463374607431768211456");	// 2^128
+
+	ASSERT(StrEq(BigInt_Add(big, BI(-1)), "340282366920938463463374607431768211455"));
+	ASSERT(StrEq(BigInt_Sub(BI(1), big), "-340282366920938463463374607431768211455"));
+	ASSERT(BigInt_IsZero(BigInt_Sub(big, big)));
+	ASSERT(StrEq(BigInt_Add(BI(Int64Max), BI(Int64Max)), "18446744073709551614"));
+	ASSERT(BigInt_Compare(BI(-5), BI(3)) < 0);
+	ASSERT(BigInt_Compare(big, BI(Int64Max)) > 0);
+	ASSERT(BigInt_Compare(BigInt_Neg(big), BI(Int64Min)) < 0);
+}
+END_TEST
+
+START_TEST(MultiplicationAgreesAcrossAlgorithms)
+{
+	Int sizes[] = { 1, 3, BIGINT_KARATSUBA_THRESHOLD - 1, BIGINT_KARATSUBA_THRESHOLD, 97, BIGINT_TOOM3_THRESHOLD, 401 };
+	Int i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(Int); i++) {
+		BigInt a = MakeBig(sizes[i], (UInt32)i + 1, False);
+		BigInt b = MakeBig(sizes[i], (UInt32)i + 100, (i & 1) != 0);
+		BigInt c = MakeBig(sizes[i] / 3 + 1, (UInt32)i + 200, False);
+		ASSERT(BigInt_Eq(BigInt_Mul(a, b), SlowMul(a, b)));
+		ASSERT(BigInt_Eq(BigInt_Mul(a, c), SlowMul(a, c)));
+	}
+}
+END_TEST
+
+START_TEST(MultiplicationIsDistributive)
+{
+	BigInt a = MakeBig(700, 1, False), b = MakeBig(650, 2, True), c = MakeBig(620, 3, False);
+
+	ASSERT(BigInt_Eq(BigInt_Mul(a, BigInt_Add(b, c)), BigInt_Add(BigInt_Mul(a, b), BigInt_Mul(a, c))));
+	ASSERT(BigInt_Eq(BigInt_Mul(a, b), BigInt_Mul(b, a)));
+}
+END_TEST
+
+START_TEST(DivisionSatisfiesTheDivisionIdentity)
+{
+	Int sizes[][2] = {
+		{ 1, 1 }, { 5, 1 }, { 5, 2 }, { 40, 17 },
+		{ 3 * BIGINT_BURNIKEL_ZIEGLER_THRESHOLD, BIGINT_BURNIKEL_ZIEGLER_THRESHOLD },
+		{ 400, 130 }, { 700, 300 },
+	};
+	Int i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		BigInt a = MakeBig(sizes[i][0], (UInt32)i + 7, (i & 1) != 0);
+		BigInt b = MakeBig(sizes[i][1], (UInt32)i + 70, (i & 2) != 0);
+		BigInt q, r;
+
+		ASSERT(BigInt_DivRem(a, b, &q, &r));
+		ASSERT(BigInt_Eq(BigInt_Add(BigInt_Mul(q, b), r), a));
+		ASSERT(BigInt_Compare(BigInt_Abs(r), BigInt_Abs(b)) < 0);
+		ASSERT(BigInt_IsZero(r) || BigInt_IsNeg(r) == BigInt_IsNeg(a));
+
+		ASSERT(BigInt_DivMod(a, b, &q, &r));
+		ASSERT(BigInt_Eq(BigInt_Add(BigInt_Mul(q, b), r), a));
+		ASSERT(BigInt_IsZero(r) || BigInt_IsNeg(r) == BigInt_IsNeg(b));
+	}
+}
+END_TEST
+
+START_TEST(DivisionRoundsCorrectly)
+{
+	BigInt q, r;
+
+	ASSERT(BigInt_DivRem(BI(-7), BI(2), &q, &r));
+	ASSERT(BigInt_ToInt64(q) == -3 && BigInt_ToInt64(r) == -1);
+	ASSERT(BigInt_DivMod(BI(-7), BI(2), &q, &r));
+	ASSERT(BigInt_ToInt64(q) == -4 && BigInt_ToInt64(r) == 1);
+	ASSERT(BigInt_DivMod(BI(7), BI(-2), &q, &r));
+	ASSERT(BigInt_ToInt64(q) == -4 && BigInt_ToInt64(r) == -1);
+	ASSERT(!BigInt_DivRem(BI(7), BigInt_Zero, &q, &r));
+	ASSERT(!BigInt_DivMod(BI(7), BigInt_Zero, &q, &r));
+}
+END_TEST
+
+START_TEST(CanShift)
+{
+	ASSERT(StrEq(BigInt_ShiftLeft(BI(3), 100), "3802951800684688204490109616128"));
+	ASSERT(StrEq(BigInt_ShiftRight(BigInt_ShiftLeft(BI(3), 100), 99), "6"));
+	ASSERT(StrEq(BigInt_ShiftRight(BI(-1), 10), "-1"));
+	ASSERT(StrEq(BigInt_ShiftRight(BI(-5), 1), "-3"));
+	ASSERT(StrEq(BigInt_ShiftLeft(BI(12), -2), "3"));
+	ASSERT(BigInt_BitLength(BigInt_ShiftLeft(BI(1), 1000)) == 1001);
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Number-theory tests.
+
+START_TEST(CanRaiseToPowers)
+{
+	ASSERT(StrEq(BigInt_Pow(BI(2), 100), "1267650600228229401496703205376"));
+	ASSERT(StrEq(BigInt_Pow(BI(-3), 41), "-36472996377170786403"));
+	ASSERT(StrEq(BigInt_Pow(BI(12345), 0), "1"));
+}
+END_TEST
+
+START_TEST(CanComputeModularPowers)
+{
+	BigInt result;
+	BigInt p = B("170141183460469231731687303715884105727");	// 2^127 - 1, a Mersenne prime.
+
+	// Fermat's little theorem:  a^(p-1) = 1 (mod p).
+	ASSERT(BigInt_ModPow(BI(3), BigInt_Sub(p, BI(1)), p, &result));
+	ASSERT(StrEq(result, "1"));
+	ASSERT(BigInt_ModPow(BI(4), BI(13), BI(497), &result));
+	ASSERT(StrEq(result, "445"));
+	ASSERT(!BigInt_ModPow(BI(4), BI(13), BigInt_Zero, &result));
+	ASSERT(!BigInt_ModPow(BI(4), BI(-1), BI(7), &result));
+}
+END_TEST
+
+START_TEST(CanComputeGcds)
+{
+	BigInt a = BigInt_Mul(MakeBig(30, 1, False), B("1000000007"));
+	BigInt b = BigInt_Mul(MakeBig(20, 2, True), B("1000000007"));
+	BigInt g = BigInt_Gcd(a, b), q, r;
+
+	ASSERT(StrEq(BigInt_Gcd(BI(-48), BI(180)), "12"));
+	ASSERT(StrEq(BigInt_Gcd(BI(0), BI(-5)), "5"));
+	ASSERT(BigInt_DivRem(g, B("1000000007"), &q, &r));
+	ASSERT(BigInt_IsZero(r));
+	ASSERT(BigInt_DivRem(a, g, &q, &r) && BigInt_IsZero(r));
+	ASSERT(BigInt_DivRem(b, g, &q, &r) && BigInt_IsZero(r));
+}
+END_TEST
+
+START_TEST(CanComputeSquareRoots)
+{
+	BigInt x = MakeBig(80, 5, False), s;
+
+	ASSERT(BigInt_Sqrt(BI(0), &s) && BigInt_IsZero(s));
+	ASSERT(BigInt_Sqrt(BI(99), &s) && StrEq(s, "9"));
+	ASSERT(BigInt_Sqrt(BigInt_Mul(x, x), &s) && BigInt_Eq(s, x));
+	ASSERT(BigInt_Sqrt(BigInt_Sub(BigInt_Mul(x, x), BI(1)), &s) && BigInt_Eq(s, BigInt_Sub(x, BI(1))));
+	ASSERT(!BigInt_Sqrt(BI(-4), &s));
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Lexer tests.
+
+START_TEST(LexerRecognizesBigIntLiterals)
+{
+	Lexer lexer = SetupLexer("  123n  100000000000000000000000000n  0xFFFFFFFFFFFFFFFFFFn  0777n  1N  ");
+
+	ASSERT(Lexer_Next(lexer) == TOKEN_BIGINT);
+	ASSERT(StrEq((BigInt)lexer->token->data.ptr, "123"));
+	ASSERT(Lexer_Next(lexer) == TOKEN_BIGINT);
+	ASSERT(StrEq((BigInt)lexer->token->data.ptr, "100000000000000000000000000"));
+	ASSERT(Lexer_Next(lexer) == TOKEN_BIGINT);
+	ASSERT(StrEq((BigInt)lexer->token->data.ptr, "4722366482869645213695"));
+	ASSERT(Lexer_Next(lexer) == TOKEN_BIGINT);
+	ASSERT(StrEq((BigInt)lexer->token->data.ptr, "511"));
+	ASSERT(Lexer_Next(lexer) == TOKEN_BIGINT);
+	ASSERT(StrEq((BigInt)lexer->token->data.ptr, "1"));
+	ASSERT(Lexer_Next(lexer) == TOKEN_EOI);
+}
+END_TEST
+
+START_TEST(LexerStillRejectsOverflowedInt64Literals)
+{
+	Lexer lexer = SetupLexer("  100000000000000000000000000  ");
+	ASSERT(Lexer_Next(lexer) == TOKEN_ERROR);
+}
+END_TEST
+
+#include "bigint_tests.generated.inc"
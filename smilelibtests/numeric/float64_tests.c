@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/numeric/float64.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+
+TEST_SUITE(Float64Tests)
+
+//-------------------------------------------------------------------------------------------------
+//  Helper functions.
+
+static UInt64 _lcgState;
+
+static UInt64 NextRandom(void)
+{
+	_lcgState = _lcgState * 6364136223846793005ULL + 1442695040888963407ULL;
+	return _lcgState ^ (_lcgState >> 29);
+}
+
+static Float64 BitsToFloat64(UInt64 bits)
+{
+	return *(Float64 *)&bits;
+}
+
+static Float32 BitsToFloat32(UInt32 bits)
+{
+	return *(Float32 *)&bits;
+}
+
+/// <summary>
+/// Turn 0.digits * 10^decimalPoint into a C-library-parseable string.
+/// </summary>
+static void MakeScientific(char *dest, const Byte *digits, Int length, Int decimalPoint)
+{
+	MemCpy(dest, "0.", 2);
+	MemCpy(dest + 2, digits, length);
+	sprintf(dest + 2 + length, "e%d", (int)decimalPoint);
+}
+
+/// <summary>
+/// Check that the shortest digits for a Float64 round-trip through strtod(), and that neither
+/// of the two nearest candidates with one fewer digit also round-trips.
+/// </summary>
+static Bool CheckFloat64RoundTrip(Float64 value)
+{
+	Byte digits[32], shorter[32];
+	char text[64];
+	Int length, decimalPoint, i;
+
+	length = Float64_ToShortestDigits(value, digits, &decimalPoint);
+	if (length < 1 || length > FLOAT64_MAX_SHORTEST_DIGITS || digits[length - 1] == '0')
+		return False;
+
+	MakeScientific(text, digits, length, decimalPoint);
+	if (strtod(text, NULL) != value)
+		return False;
+
+	if (length > 1) {
+		// Truncated (rounded down) to one fewer digit.
+		MakeScientific(text, digits, length - 1, decimalPoint);
+		if (strtod(text, NULL) == value)
+			return False;
+
+		// Rounded up to one fewer digit.
+		MemCpy(shorter, digits, length - 1);
+		for (i = length - 2; i >= 0 && shorter[i] == '9'; i--)
+			shorter[i] = '0';
+		if (i >= 0) {
+			shorter[i]++;
+			MakeScientific(text, shorter, length - 1, decimalPoint);
+		}
+		else MakeScientific(text, (const Byte *)"1", 1, decimalPoint + 1);
+		if (strtod(text, NULL) == value)
+			return False;
+	}
+
+	return True;
+}
+
+static Bool CheckFloat32RoundTrip(Float32 value)
+{
+	Byte digits[32];
+	char text[64];
+	Int length, decimalPoint;
+
+	length = Float32_ToShortestDigits(value, digits, &decimalPoint);
+	if (length < 1 || length > FLOAT32_MAX_SHORTEST_DIGITS || digits[length - 1] == '0')
+		return False;
+
+	MakeScientific(text, digits, length, decimalPoint);
+	if (strtof(text, NULL) != value)
+		return False;
+
+	if (length > 1) {
+		MakeScientific(text, digits, length - 1, decimalPoint);
+		if (strtof(text, NULL) == value)
+			return False;
+	}
+
+	return True;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Shortest-digit tests.
+
+START_TEST(ShortestDigitsForSimpleValues)
+{
+	Byte digits[32];
+	Int length, decimalPoint;
+
+	length = Float64_ToShortestDigits(0.1, digits, &decimalPoint);
+	ASSERT(length == 1 && digits[0] == '1' && decimalPoint == 0);
+
+	length = Float64_ToShortestDigits(123456.789, digits, &decimalPoint);
+	ASSERT(length == 9 && !MemCmp(digits, "123456789", 9) && decimalPoint == 6);
+
+	length = Float64_ToShortestDigits(1.0 / 3.0, digits, &decimalPoint);
+	ASSERT(length == 16 && !MemCmp(digits, "3333333333333333", 16) && decimalPoint == 0);
+
+	length = Float32_ToShortestDigits(0.1f, digits, &decimalPoint);
+	ASSERT(length == 1 && digits[0] == '1' && decimalPoint == 0);
+}
+END_TEST
+
+START_TEST(ShortestDigitsForExtremeValues)
+{
+	ASSERT(CheckFloat64RoundTrip(BitsToFloat64(1)));						// Smallest subnormal.
+	ASSERT(CheckFloat64RoundTrip(BitsToFloat64(0x000FFFFFFFFFFFFFULL)));	// Largest subnormal.
+	ASSERT(CheckFloat64RoundTrip(BitsToFloat64(0x0010000000000000ULL)));	// Smallest normal.
+	ASSERT(CheckFloat64RoundTrip(BitsToFloat64(0x7FEFFFFFFFFFFFFFULL)));	// Largest normal.
+	ASSERT(CheckFloat64RoundTrip(9007199254740992.0));
+	ASSERT(CheckFloat64RoundTrip(9007199254740994.0));
+	ASSERT(CheckFloat64RoundTrip(5e-324));
+	ASSERT(CheckFloat64RoundTrip(1e23));
+	ASSERT(CheckFloat32RoundTrip(BitsToFloat32(1)));
+	ASSERT(CheckFloat32RoundTrip(BitsToFloat32(0x7F7FFFFF)));
+	ASSERT(CheckFloat32RoundTrip(16777216.0f));
+}
+END_TEST
+
+START_TEST(ShortestDigitsRoundTripThroughStrtodForRandomFloat64s)
+{
+	Int i, numTested = 0;
+
+	_lcgState = 12345;
+	for (i = 0; i < 200000; i++) {
+		Float64 value = BitsToFloat64(NextRandom() & 0x7FFFFFFFFFFFFFFFULL);
+		if (value == 0.0 || Float64_GetKind(value) != FLOAT_KIND_POS_NUM) continue;
+		ASSERT(CheckFloat64RoundTrip(value));
+		numTested++;
+	}
+	ASSERT(numTested > 190000);
+
+	// Also check "ordinary" values with short decimal forms.
+	for (i = 0; i < 100000; i++) {
+		Float64 value = (Float64)(NextRandom() % 100000000) / 100.0;
+		if (value == 0.0) continue;
+		ASSERT(CheckFloat64RoundTrip(value));
+	}
+}
+END_TEST
+
+START_TEST(ShortestDigitsRoundTripThroughStrtofForRandomFloat32s)
+{
+	Int i;
+
+	_lcgState = 67890;
+	for (i = 0; i < 200000; i++) {
+		Float32 value = BitsToFloat32((UInt32)NextRandom() & 0x7FFFFFFF);
+		if (value == 0.0f || Float32_GetKind(value) != FLOAT_KIND_POS_NUM) continue;
+		ASSERT(CheckFloat32RoundTrip(value));
+	}
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  String-formatting tests.
+
+START_TEST(ToStringUsesShortestRoundTripForm)
+{
+	ASSERT_STRING(Float64_ToStringEx(0.1, 0, 0, False), "0.1", 3);
+	ASSERT_STRING(Float64_ToStringEx(-2.5, 0, 0, False), "-2.5", 4);
+	ASSERT_STRING(Float64_ToStringEx(2.5, 0, 0, True), "+2.5", 4);
+	ASSERT_STRING(Float64_ToStringEx(123456.789, 0, 0, False), "123456.789", 10);
+	ASSERT_STRING(Float64_ToStringEx(100.0, 0, 0, False), "100.0", 5);
+	ASSERT_STRING(Float64_ToStringEx(0.0001, 0, 0, False), "0.0001", 6);
+	ASSERT_STRING(Float64_ToStringEx(1e300, 0, 0, False), "1e+300", 6);
+	ASSERT_STRING(Float64_ToStringEx(1.5e-7, 0, 0, False), "1.5e-7", 6);
+	ASSERT_STRING(Float64_ToStringEx(-0.0, 0, 0, True), "-0.0", 4);
+	ASSERT_STRING(Float64_ToStringEx(1.7976931348623157e308, 0, 0, False), "1.7976931348623157e+308", 23);
+	ASSERT_STRING(Float64_ToStringEx(5e-324, 0, 0, False), "5e-324", 6);
+
+	ASSERT_STRING(Float32_ToStringEx(0.1f, 0, 0, False), "0.1", 3);
+	ASSERT_STRING(Float32_ToStringEx(3.4028235e38f, 0, 0, False), "3.4028235e+38", 13);
+	ASSERT_STRING(Float32_ToStringEx(1.0f / 3.0f, 0, 0, False), "0.33333334", 10);
+}
+END_TEST
+
+START_TEST(ToFixedStringPadsAndRounds)
+{
+	ASSERT_STRING(Float64_ToFixedString(12.5, 4, 0, False), "0012.5", 6);
+	ASSERT_STRING(Float64_ToFixedString(0.001, 0, 0, False), "0.001", 5);
+	ASSERT_STRING(Float64_ToFixedString(2.675, 0, 2, False), "2.67", 4);		// 2.675 is really 2.67499999...
+	ASSERT_STRING(Float64_ToFixedString(0.125, 0, 2, False), "0.12", 4);		// Exact ties round to even.
+	ASSERT_STRING(Float64_ToFixedString(0.375, 0, 2, False), "0.38", 4);
+	ASSERT_STRING(Float64_ToFixedString(9.999, 0, 2, False), "10.0", 4);
+	ASSERT_STRING(Float64_ToFixedString(0.0004, 0, 2, False), "0.0", 3);
+	ASSERT_STRING(Float64_ToFixedString(1e21, 0, 0, False), "1000000000000000000000.0", 24);
+	ASSERT_STRING(Float64_ToFixedString(1.0 / 0.0, 0, 0, False), "inf", 3);
+}
+END_TEST
+
+START_TEST(ToExpStringRoundsSignificantDigits)
+{
+	ASSERT_STRING(Float64_ToExpString(123456.789, 0, False), "1.23456789e+5", 13);
+	ASSERT_STRING(Float64_ToExpString(123456.789, 2, False), "1.23e+5", 7);
+	ASSERT_STRING(Float64_ToExpString(999999.0, 2, False), "1e+6", 4);
+	ASSERT_STRING(Float64_ToExpString(-0.00125, 1, False), "-1.3e-3", 7);	// 0.00125 is really 0.00125000000000000002...
+	ASSERT_STRING(Float64_ToExpString(0.0, 0, False), "0e+0", 4);
+}
+END_TEST
+
+START_TEST(ToStringOutputParsesBackExactly)
+{
+	Int i;
+
+	_lcgState = 24680;
+	for (i = 0; i < 50000; i++) {
+		Float64 value = BitsToFloat64(NextRandom());
+		Int kind = Float64_GetKind(value);
+		String str;
+
+		if (kind != FLOAT_KIND_POS_NUM && kind != FLOAT_KIND_NEG_NUM) continue;
+
+		str = Float64_ToStringEx(value, 0, 0, False);
+		ASSERT(strtod(String_ToC(str), NULL) == value);
+	}
+}
+END_TEST
+
+#include "float64_tests.generated.inc"
@@ -1040,4 +1040,139 @@ START_TEST(CanDetermineOrderabilityReal64)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  Differential tests of the binary-integer fast paths against the full BID implementation.
+
+extern Real64 __bid64_add(Real64 a, Real64 b);
+extern Real64 __bid64_sub(Real64 a, Real64 b);
+extern Real64 __bid64_mul(Real64 a, Real64 b);
+extern int __bid64_quiet_equal(Real64 a, Real64 b);
+extern int __bid64_quiet_not_equal(Real64 a, Real64 b);
+extern int __bid64_quiet_less(Real64 a, Real64 b);
+extern int __bid64_quiet_greater(Real64 a, Real64 b);
+extern int __bid64_quiet_less_equal(Real64 a, Real64 b);
+extern int __bid64_quiet_greater_equal(Real64 a, Real64 b);
+
+static UInt64 _lcgState;
+
+static UInt64 NextRandom(void)
+{
+	_lcgState = _lcgState * 6364136223846793005ULL + 1442695040888963407ULL;
+	return _lcgState ^ (_lcgState >> 29);
+}
+
+static const UInt64 _specialReal64s[] = {
+	0x31C0000000000000ULL, 0xB1C0000000000000ULL,		// +0, -0
+	0x0000000000000000ULL, 0x5FE0000000000000ULL,		// 0 at the smallest and largest exponents
+	0x7800000000000000ULL, 0xF800000000000000ULL,		// +Inf, -Inf
+	0x7C00000000000000ULL, 0xFC00000000000000ULL,		// +QNaN, -QNaN
+	0x7E00000000000000ULL,								// SNaN
+	0x6C7386F26FC0FFFFULL, 0xEC7386F26FC0FFFFULL,		// +/-9999999999999999 (large encoding)
+	0x6C70000000000000ULL,								// 2^53 (large encoding)
+	0x001FFFFFFFFFFFFFULL, 0x5FFFFFFFFFFFFFFFULL,		// Tiny and huge small-encoded values
+	0x0000000000000001ULL, 0x5FE0000000000001ULL,
+};
+
+/// <summary>
+/// Make a random Real64, weighted toward the short coefficients and nearby exponents that
+/// real programs use, but including everything else often enough to check the fallbacks.
+/// </summary>
+static Real64 RandomReal64(void)
+{
+	static const UInt64 powersOfTen[] = {
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+		100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+		10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	};
+	UInt64 coefficient, sign, r;
+	Int32 exponent, digits;
+	Real64 result;
+
+	r = NextRandom();
+	if (r % 16 == 0) {
+		result.value = _specialReal64s[(r >> 8) % (sizeof(_specialReal64s) / sizeof(UInt64))];
+		return result;
+	}
+
+	digits = (r >> 8) % 4 != 0 ? 1 + (Int32)((r >> 12) % 6) : 1 + (Int32)((r >> 12) % 16);
+	coefficient = NextRandom() % powersOfTen[digits];
+	exponent = (r >> 20) % 8 != 0 ? 398 - (Int32)((r >> 24) % 9) : (Int32)((r >> 24) % 768);
+	sign = (r >> 40) & 1 ? 0x8000000000000000ULL : 0;
+
+	if (coefficient < (1ULL << 53))
+		result.value = sign | ((UInt64)exponent << 53) | coefficient;
+	else
+		result.value = sign | 0x6000000000000000ULL | ((UInt64)exponent << 51) | (coefficient & 0x0007FFFFFFFFFFFFULL);
+
+	return result;
+}
+
+#define CHECK_SAME_RESULT(__fast__, __bid__, __a__, __b__) \
+	do { \
+		Real64 fastResult, bidResult; \
+		UInt32 fastFlags, bidFlags; \
+		Real_SetFlags(0); \
+		fastResult = __fast__(__a__, __b__); \
+		fastFlags = Real_GetFlags(); \
+		Real_SetFlags(0); \
+		bidResult = __bid__(__a__, __b__); \
+		bidFlags = Real_GetFlags(); \
+		ASSERT(fastResult.value == bidResult.value && fastFlags == bidFlags); \
+	} while (0)
+
+#define CHECK_SAME_COMPARISON(__fast__, __bid__, __a__, __b__) \
+	ASSERT(!__fast__(__a__, __b__) == !__bid__(__a__, __b__))
+
+START_TEST(FastPathsAreBitIdenticalToTheBidLibrary)
+{
+	Real64 a, b;
+	UInt32 mode;
+	Int i;
+
+	_lcgState = 20250101;
+
+	for (mode = 0; mode < 5; mode++) {
+		Real_SetRoundingMode(mode);
+
+		for (i = 0; i < 200000; i++) {
+			a = RandomReal64();
+			b = RandomReal64();
+
+			CHECK_SAME_RESULT(Real64_Add, __bid64_add, a, b);
+			CHECK_SAME_RESULT(Real64_Sub, __bid64_sub, a, b);
+			CHECK_SAME_RESULT(Real64_Mul, __bid64_mul, a, b);
+
+			CHECK_SAME_COMPARISON(Real64_Eq, __bid64_quiet_equal, a, b);
+			CHECK_SAME_COMPARISON(Real64_Ne, __bid64_quiet_not_equal, a, b);
+			CHECK_SAME_COMPARISON(Real64_Lt, __bid64_quiet_less, a, b);
+			CHECK_SAME_COMPARISON(Real64_Gt, __bid64_quiet_greater, a, b);
+			CHECK_SAME_COMPARISON(Real64_Le, __bid64_quiet_less_equal, a, b);
+			CHECK_SAME_COMPARISON(Real64_Ge, __bid64_quiet_greater_equal, a, b);
+		}
+	}
+
+	Real_SetRoundingMode(0);
+	Real_SetFlags(0);
+}
+END_TEST
+
+START_TEST(FastPathsHandleMoneyArithmetic)
+{
+	Real64 total = Real64_Zero, price;
+	Int i;
+
+	// Sum 10000 prices of $19.99; every step should stay exact.
+	price = Real64_Parse(String_FromC("19.99"));
+	for (i = 0; i < 10000; i++)
+		total = Real64_Add(total, price);
+
+	// The results should keep the cents, exactly as a decimal type should.
+	ASSERT(total.value == Real64_Parse(String_FromC("199900.00")).value);
+	ASSERT(Real64_Mul(price, Real64_Parse(String_FromC("1.5"))).value == Real64_Parse(String_FromC("29.985")).value);
+	ASSERT(Real64_Sub(price, Real64_Parse(String_FromC("20.00"))).value == Real64_Parse(String_FromC("-0.01")).value);
+	ASSERT(Real64_Lt(Real64_Parse(String_FromC("19.9")), price));
+	ASSERT(Real64_Gt(Real64_Parse(String_FromC("20")), price));
+}
+END_TEST
+
 #include "real64_tests.generated.inc"
@@ -0,0 +1,292 @@
+//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+
+#include <smile/numeric/vector.h>
+#include <smile/smiletypes/raw/smilebytearray.h>
+#include <smile/smiletypes/raw/smileinteger32array.h>
+#include <smile/smiletypes/raw/smileinteger64array.h>
+#include <smile/smiletypes/raw/smilefloat32array.h>
+#include <smile/smiletypes/raw/smilefloat64array.h>
+
+#include <math.h>
+
+TEST_SUITE(VectorTests)
+
+//-------------------------------------------------------------------------------------------------
+//  Helper functions.
+
+static UInt64 _lcgState;
+
+static UInt64 NextRandom(void)
+{
+	_lcgState = _lcgState * 6364136223846793005ULL + 1442695040888963407ULL;
+	return _lcgState ^ (_lcgState >> 29);
+}
+
+static void FillInt32(Int32 *dest, Int count)
+{
+	Int i;
+	for (i = 0; i < count; i++)
+		dest[i] = (Int32)NextRandom();
+}
+
+static void FillFloat64(Float64 *dest, Int count)
+{
+	Int i;
+	for (i = 0; i < count; i++)
+		dest[i] = (Float64)(Int64)(NextRandom() % 2000001) / 1000.0 - 1000.0;
+}
+
+/// <summary>
+/// Run every Float64 kernel over the given input, and fold all of the results into one
+/// array of bits, so that two instruction sets can be compared exactly.
+/// </summary>
+static void RunFloat64Kernels(UInt64 *results, const Float64 *a, const Float64 *b, Float64 *scratch, Byte *mask, Int count)
+{
+	Int i;
+
+	Float64Vector_Add(scratch, a, b, count);
+	Float64Vector_Mul(scratch, scratch, b, count);
+	Float64Vector_SubScalar(scratch, scratch, 0.1, count);
+	for (i = 0; i < count; i++)
+		results[i] = *(UInt64 *)&scratch[i];
+
+	Float64Vector_CompareScalar(mask, a, 0.0, count, VECTOR_CMP_LT);
+	for (i = 0; i < count; i++)
+		results[i] ^= (UInt64)mask[i] << 63;
+
+	scratch[0] = Float64Vector_Sum(a, count);
+	scratch[1] = Float64Vector_Dot(a, b, count);
+	scratch[2] = count > 0 ? Float64Vector_Min(a, count) : 0.0;
+	scratch[3] = count > 0 ? Float64Vector_Max(a, count) : 0.0;
+	for (i = 0; i < 4; i++)
+		results[count + i] = *(UInt64 *)&scratch[i];
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Kernel tests.
+
+START_TEST(IntegerKernelsMatchScalarLoops)
+{
+	Int32 a[67], b[67], dest[67];
+	Int64 indices[67];
+	Byte mask[67];
+	Int count, i;
+
+	_lcgState = 12345;
+
+	// Every length from 0 to 67 exercises the vector body and every possible tail.
+	for (count = 0; count <= 67; count++) {
+		Int64 sum = 0, dot = 0;
+		Int32 min = Int32Max, max = Int32Min;
+
+		FillInt32(a, count);
+		FillInt32(b, count);
+
+		Int32Vector_Add(dest, a, b, count);
+		for (i = 0; i < count; i++)
+			ASSERT(dest[i] == (Int32)((UInt32)a[i] + (UInt32)b[i]));
+
+		Int32Vector_Mul(dest, a, b, count);
+		for (i = 0; i < count; i++)
+			ASSERT(dest[i] == (Int32)((UInt32)a[i] * (UInt32)b[i]));
+
+		Int32Vector_SubScalar(dest, a, 17, count);
+		for (i = 0; i < count; i++)
+			ASSERT(dest[i] == (Int32)((UInt32)a[i] - 17));
+
+		for (i = 0; i < count; i++) {
+			sum += a[i];
+			dot += (Int64)a[i] * b[i];
+			if (a[i] < min) min = a[i];
+			if (a[i] > max) max = a[i];
+		}
+		ASSERT(Int32Vector_Sum(a, count) == sum);
+		ASSERT(Int32Vector_Dot(a, b, count) == dot);
+		if (count > 0) {
+			ASSERT(Int32Vector_Min(a, count) == min);
+			ASSERT(Int32Vector_Max(a, count) == max);
+		}
+
+		Int32Vector_CompareScalar(mask, a, 0, count, VECTOR_CMP_GE);
+		for (i = 0; i < count; i++)
+			ASSERT(mask[i] == (a[i] >= 0));
+
+		for (i = 0; i < count; i++)
+			indices[i] = (Int64)(NextRandom() % (UInt64)count);
+		Int32Vector_Gather(dest, a, indices, count);
+		for (i = 0; i < count; i++)
+			ASSERT(dest[i] == a[indices[i]]);
+	}
+}
+END_TEST
+
+START_TEST(IntegerArithmeticWraps)
+{
+	Int64 a[3] = { Int64Max, Int64Min, -1 };
+	Int64 b[3] = { 1, -1, Int64Min };
+	Int64 dest[3];
+
+	Int64Vector_Add(dest, a, b, 3);
+	ASSERT(dest[0] == Int64Min && dest[1] == Int64Max && dest[2] == Int64Max);
+
+	Int64Vector_MulScalar(dest, a, 2, 3);
+	ASSERT(dest[0] == -2 && dest[1] == 0 && dest[2] == -2);
+
+	ASSERT(Int64Vector_Sum(a, 3) == -2);
+}
+END_TEST
+
+START_TEST(FloatMinAndMaxSkipNaNs)
+{
+	Float32 a[11] = { 3.0f, 0.0f, -2.5f, 7.0f, 1.0f, 0.0f, 0.0f, 0.0f, 9.5f, -4.0f, 2.0f };
+	Float64 b[5] = { 0.0, 1.5, -3.0, 2.0, 0.0 };
+
+	a[1] = (Float32)NAN;
+	b[0] = NAN;
+	b[4] = NAN;
+
+	ASSERT(Float32Vector_Min(a, 11) == -4.0f);
+	ASSERT(Float32Vector_Max(a, 11) == 9.5f);
+	ASSERT(Float64Vector_Min(b, 5) == -3.0);
+	ASSERT(Float64Vector_Max(b, 5) == 2.0);
+}
+END_TEST
+
+START_TEST(FloatReductionsUseEightLanes)
+{
+	Float32 a[10] = { 1e8f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, -1e8f, 1.0f };
+	Float32 b[1] = { 4097.0f };
+
+	// Elements 0 and 8 land in the same lane, so they cancel before the lanes are combined.
+	ASSERT(Float32Vector_Sum(a, 10) == 8.0);
+
+	// Float32 products are computed in Float64, so they don't round:  4097^2 needs 25 bits.
+	ASSERT(Float32Vector_Dot(b, b, 1) == 16785409.0);
+}
+END_TEST
+
+START_TEST(InstructionSetsGiveIdenticalResults)
+{
+	Float64 a[131], b[131], scratch[131];
+	Byte mask[131];
+	UInt64 portable[135], avx2[135];
+	Int32 ia[131], ib[131];
+	Int originalIsa = Vector_GetIsa();
+	Int count;
+
+	ASSERT(Vector_SetIsa(VECTOR_ISA_PORTABLE));
+	ASSERT(Vector_GetIsa() == VECTOR_ISA_PORTABLE);
+
+	// If this CPU can't do AVX2, there's nothing more to compare.
+	if (!Vector_SetIsa(VECTOR_ISA_AVX2)) {
+		Vector_SetIsa(originalIsa);
+		return;
+	}
+
+	_lcgState = 67890;
+
+	for (count = 0; count <= 131; count++) {
+		FillFloat64(a, count);
+		FillFloat64(b, count);
+
+		Vector_SetIsa(VECTOR_ISA_PORTABLE);
+		RunFloat64Kernels(portable, a, b, scratch, mask, count);
+		Vector_SetIsa(VECTOR_ISA_AVX2);
+		RunFloat64Kernels(avx2, a, b, scratch, mask, count);
+		ASSERT(!MemCmp(portable, avx2, (count + 4) * sizeof(UInt64)));
+
+		FillInt32(ia, count);
+		FillInt32(ib, count);
+
+		Vector_SetIsa(VECTOR_ISA_PORTABLE);
+		portable[0] = (UInt64)Int32Vector_Dot(ia, ib, count);
+		Vector_SetIsa(VECTOR_ISA_AVX2);
+		avx2[0] = (UInt64)Int32Vector_Dot(ia, ib, count);
+		ASSERT(portable[0] == avx2[0]);
+	}
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Typed-array tests.
+
+START_TEST(CreatedArraysAreZeroed)
+{
+	SmileFloat64Array array = SmileFloat64Array_Create(100, True);
+	Int i;
+
+	ASSERT(SMILE_KIND(array) == SMILE_KIND_FLOAT64ARRAY);
+	ASSERT(array->length == 100);
+	ASSERT(array->byteArray == NULL);
+	ASSERT(array->kind & SMILE_SECURITY_WRITABLE);
+	for (i = 0; i < 100; i++)
+		ASSERT(array->data[i] == 0.0);
+
+	ASSERT(SmileInteger32Array_Create(0, True)->length == 0);
+}
+END_TEST
+
+START_TEST(ViewsShareStorageWithTheirByteArray)
+{
+	SmileByteArray byteArray = SmileByteArray_Create((SmileObject)Smile_KnownBases.ByteArray, 20, True);
+	SmileInteger32Array view;
+	SmileByteArray bytes;
+
+	MemSet(byteArray->data, 0, 20);
+
+	// Skip the first four bytes; the view covers the remaining four Int32s.
+	view = SmileInteger32Array_CreateView(byteArray, 4, 4);
+	ASSERT(view->length == 4);
+	ASSERT(view->byteArray == byteArray);
+	ASSERT((Byte *)view->data == byteArray->data + 4);
+	ASSERT(view->kind & SMILE_SECURITY_WRITABLE);
+
+	view->data[1] = 0x01020304;
+	ASSERT(*(Int32 *)(byteArray->data + 8) == 0x01020304);
+
+	*(Int32 *)(byteArray->data + 16) = -12345;
+	ASSERT(view->data[3] == -12345);
+
+	// And going the other way shares storage too.
+	bytes = SmileInteger32Array_ToByteArray(view);
+	ASSERT(bytes->length == 16);
+	ASSERT(bytes->data == (Byte *)view->data);
+}
+END_TEST
+
+START_TEST(ViewsOfReadOnlyBytesAreReadOnly)
+{
+	SmileByteArray byteArray = String_ToByteArray(String_FromC("0123456789ABCDEF"));
+	SmileInteger64Array view;
+	SmileFloat32Array floats;
+
+	view = SmileInteger64Array_CreateView(byteArray, 0, 2);
+	ASSERT(view->length == 2);
+	ASSERT(!(view->kind & SMILE_SECURITY_WRITABLE));
+	ASSERT(!MemCmp(view->data, "0123456789ABCDEF", 16));
+
+	floats = SmileFloat32Array_CreateView(byteArray, 0, 4);
+	ASSERT(!(SmileFloat32Array_ToByteArray(floats)->kind & SMILE_SECURITY_WRITABLE));
+}
+END_TEST
+
+#include "vector_tests.generated.inc"
@@ -0,0 +1,267 @@
+﻿//---------------------------------------------------------------------------------------
+//  Smile Programming Language Interpreter (Unit Tests)
+//  Copyright 2004-2019 Sean Werkema
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//---------------------------------------------------------------------------------------
+
+#include "../stdafx.h"
+#include <smile/crypto/base64.h>
+#include <smile/crypto/hex.h>
+#include <smile/numeric/vector.h>
+
+TEST_SUITE(StringCodecTests)
+
+static UInt32 _codecLcgState;
+
+static void FillWithRandomBytes(Byte *buffer, Int length)
+{
+	Int i;
+	for (i = 0; i < length; i++) {
+		_codecLcgState = _codecLcgState * 1103515245 + 12345;
+		buffer[i] = (Byte)(_codecLcgState >> 16);
+	}
+}
+
+static Bool DecodesTo(const char *text, Int flags, const char *expectedResult, Int expectedLength)
+{
+	Int length;
+	Byte *result = Base64Decode((const Byte *)text, StrLen(text), flags, &length);
+	return result != NULL && length == expectedLength && !MemCmp(result, expectedResult, length);
+}
+
+static Bool IsInvalidBase64(const char *text)
+{
+	Int length;
+	return Base64Decode((const Byte *)text, StrLen(text), 0, &length) == NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+//  Base-64 Encoding Tests.
+
+START_TEST(Base64EncodeShouldEncodeTheRfc4648TestVectors)
+{
+	ASSERT_STRING(Base64Encode((const Byte *)"", 0, 0), NULL, 0);
+	ASSERT_STRING(Base64Encode((const Byte *)"f", 1, 0), "Zg==", 4);
+	ASSERT_STRING(Base64Encode((const Byte *)"fo", 2, 0), "Zm8=", 4);
+	ASSERT_STRING(Base64Encode((const Byte *)"foo", 3, 0), "Zm9v", 4);
+	ASSERT_STRING(Base64Encode((const Byte *)"foob", 4, 0), "Zm9vYg==", 8);
+	ASSERT_STRING(Base64Encode((const Byte *)"fooba", 5, 0), "Zm9vYmE=", 8);
+	ASSERT_STRING(Base64Encode((const Byte *)"foobar", 6, 0), "Zm9vYmFy", 8);
+}
+END_TEST
+
+START_TEST(Base64EncodeShouldSupportTheUrlSafeAlphabetAndNoPadding)
+{
+	ASSERT_STRING(Base64Encode((const Byte *)"\xFB\xFF\xBF", 3, 0), "+/+/", 4);
+	ASSERT_STRING(Base64Encode((const Byte *)"\xFB\xFF\xBF", 3, BASE64_URL_SAFE), "-_-_", 4);
+	ASSERT_STRING(Base64Encode((const Byte *)"\xFB\xFF", 2, BASE64_URL_SAFE | BASE64_NO_PADDING), "-_8", 3);
+	ASSERT_STRING(Base64Encode((const Byte *)"f", 1, BASE64_NO_PADDING), "Zg", 2);
+}
+END_TEST
+
+START_TEST(Base64EncodeShouldWrapLines)
+{
+	Byte buffer[60];
+	String result;
+
+	MemSet(buffer, 0, 60);
+	result = Base64Encode(buffer, 60, BASE64_WRAP_LINES);
+
+	ASSERT(String_Length(result) == 80 + 2);
+	ASSERT(String_GetBytes(result)[72] == '\n');
+	ASSERT(String_GetBytes(result)[81] == '\n');
+	ASSERT(String_Length(result) == Base64_GetEncodedLength(60, BASE64_WRAP_LINES));
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Base-64 Decoding Tests.
+
+START_TEST(Base64DecodeShouldDecodeTheRfc4648TestVectors)
+{
+	ASSERT(DecodesTo("", 0, "", 0));
+	ASSERT(DecodesTo("Zg==", 0, "f", 1));
+	ASSERT(DecodesTo("Zm8=", 0, "fo", 2));
+	ASSERT(DecodesTo("Zm9v", 0, "foo", 3));
+	ASSERT(DecodesTo("Zm9vYg==", 0, "foob", 4));
+	ASSERT(DecodesTo("Zm9vYmE=", 0, "fooba", 5));
+	ASSERT(DecodesTo("Zm9vYmFy", 0, "foobar", 6));
+}
+END_TEST
+
+START_TEST(Base64DecodeShouldIgnoreWhitespaceAndAllowMissingPadding)
+{
+	ASSERT(DecodesTo(" Zm9v\r\nYmE= \n", 0, "fooba", 5));
+	ASSERT(DecodesTo("Zm9vYmE", 0, "fooba", 5));
+	ASSERT(DecodesTo("Zm9vYg", 0, "foob", 4));
+	ASSERT(DecodesTo("-_8", BASE64_URL_SAFE, "\xFB\xFF", 2));
+}
+END_TEST
+
+START_TEST(Base64DecodeShouldRejectInvalidText)
+{
+	ASSERT(IsInvalidBase64("Zm9v*"));
+	ASSERT(IsInvalidBase64("Z"));
+	ASSERT(IsInvalidBase64("Zg="));
+	ASSERT(IsInvalidBase64("Zg==="));
+	ASSERT(IsInvalidBase64("=Zm9"));
+	ASSERT(IsInvalidBase64("Zg==Zg=="));
+	ASSERT(IsInvalidBase64("-_8"));
+}
+END_TEST
+
+static Bool Base64RoundTripsThroughEveryLength(void)
+{
+	Byte buffer[300];
+	Byte *decoded;
+	String encoded;
+	Int length, decodedLength, flags;
+
+	for (length = 0; length < 300; length++) {
+		FillWithRandomBytes(buffer, length);
+		for (flags = 0; flags < 8; flags++) {
+			encoded = Base64Encode(buffer, length, flags);
+			if (String_Length(encoded) != Base64_GetEncodedLength(length, flags))
+				return False;
+
+			decoded = Base64Decode(String_GetBytes(encoded), String_Length(encoded), flags, &decodedLength);
+			if (decoded == NULL || decodedLength != length || MemCmp(decoded, buffer, length))
+				return False;
+		}
+	}
+	return True;
+}
+
+START_TEST(Base64ShouldRoundTripWithEveryInstructionSet)
+{
+	Int originalIsa = Vector_GetIsa();
+
+	_codecLcgState = 12345;
+
+	Vector_SetIsa(VECTOR_ISA_PORTABLE);
+	ASSERT(Base64RoundTripsThroughEveryLength());
+
+	if (Vector_SetIsa(VECTOR_ISA_AVX2)) {
+		ASSERT(Base64RoundTripsThroughEveryLength());
+	}
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+START_TEST(Base64StreamingShouldMatchWholeBufferResults)
+{
+	Byte buffer[1000], decoded[1000];
+	char encoded[1500];
+	Base64Context context;
+	String expectedResult;
+	Int i, chunk, size, decodedSize;
+
+	_codecLcgState = 67890;
+	FillWithRandomBytes(buffer, 1000);
+	expectedResult = Base64Encode(buffer, 1000, BASE64_WRAP_LINES);
+
+	// Encode in chunks of every size from 1 to 13 bytes.
+	Base64_EncodeInit(&context, BASE64_WRAP_LINES);
+	for (i = 0, size = 0, chunk = 1; i < 1000; i += chunk, chunk = chunk % 13 + 1) {
+		if (chunk > 1000 - i) chunk = 1000 - i;
+		size += Base64_EncodeUpdate(&context, buffer + i, chunk, (Byte *)encoded + size);
+	}
+	size += Base64_EncodeFinish(&context, (Byte *)encoded + size);
+	ASSERT_STRING(String_Create((Byte *)encoded, size), String_ToC(expectedResult), String_Length(expectedResult));
+
+	// Decode in chunks of every size from 1 to 17 characters.
+	Base64_DecodeInit(&context, 0);
+	for (i = 0, decodedSize = 0, chunk = 1; i < size; i += chunk, chunk = chunk % 17 + 1) {
+		if (chunk > size - i) chunk = size - i;
+		decodedSize += Base64_DecodeUpdate(&context, (Byte *)encoded + i, chunk, decoded + decodedSize);
+	}
+	decodedSize += Base64_DecodeFinish(&context, decoded + decodedSize);
+	ASSERT(decodedSize == 1000);
+	ASSERT(!MemCmp(decoded, buffer, 1000));
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Hexadecimal Tests.
+
+START_TEST(HexEncodeShouldEncodeInEitherCase)
+{
+	ASSERT_STRING(HexEncode((const Byte *)"", 0, False), NULL, 0);
+	ASSERT_STRING(HexEncode((const Byte *)"\x00\x1F\xA5\xFF", 4, False), "001FA5FF", 8);
+	ASSERT_STRING(HexEncode((const Byte *)"\x00\x1F\xA5\xFF", 4, True), "001fa5ff", 8);
+}
+END_TEST
+
+START_TEST(HexDecodeShouldDecodeEitherCaseAndIgnoreWhitespace)
+{
+	Int length;
+	Byte *result;
+
+	result = HexDecode((const Byte *)"001fA5Ff", 8, &length);
+	ASSERT(result != NULL && length == 4 && !MemCmp(result, "\x00\x1F\xA5\xFF", 4));
+
+	result = HexDecode((const Byte *)"00 1F\r\nA 5", 10, &length);
+	ASSERT(result != NULL && length == 3 && !MemCmp(result, "\x00\x1F\xA5", 3));
+
+	ASSERT(HexDecode((const Byte *)"001", 3, &length) == NULL);
+	ASSERT(HexDecode((const Byte *)"0g", 2, &length) == NULL);
+}
+END_TEST
+
+static Bool HexRoundTripsThroughEveryLength(void)
+{
+	Byte buffer[300], decoded[300];
+	Byte *result;
+	String encoded;
+	HexContext context;
+	Int length, resultLength, size, split;
+
+	for (length = 0; length < 300; length++) {
+		FillWithRandomBytes(buffer, length);
+		encoded = HexEncode(buffer, length, length & 1);
+
+		result = HexDecode(String_GetBytes(encoded), String_Length(encoded), &resultLength);
+		if (result == NULL || resultLength != length || MemCmp(result, buffer, length))
+			return False;
+
+		// Split the digits at an odd position, so a byte gets cut in half.
+		split = length > 0 ? (length * 2 / 3) | 1 : 0;
+		Hex_DecodeInit(&context);
+		size = Hex_DecodeUpdate(&context, String_GetBytes(encoded), split, decoded);
+		size += Hex_DecodeUpdate(&context, String_GetBytes(encoded) + split, String_Length(encoded) - split, decoded + size);
+		if (!Hex_DecodeFinish(&context) || size != length || MemCmp(decoded, buffer, length))
+			return False;
+	}
+	return True;
+}
+
+START_TEST(HexShouldRoundTripWithEveryInstructionSet)
+{
+	Int originalIsa = Vector_GetIsa();
+
+	_codecLcgState = 24680;
+
+	Vector_SetIsa(VECTOR_ISA_PORTABLE);
+	ASSERT(HexRoundTripsThroughEveryLength());
+
+	if (Vector_SetIsa(VECTOR_ISA_AVX2)) {
+		ASSERT(HexRoundTripsThroughEveryLength());
+	}
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+#include "stringcodec_tests.generated.inc"
@@ -16,6 +16,8 @@
 //---------------------------------------------------------------------------------------
 
 #include "../stdafx.h"
+#include <smile/bytesearch.h>
+#include <smile/numeric/vector.h>
 
 TEST_SUITE(StringCoreTests)
 
@@ -762,6 +764,83 @@ START_TEST(SubstringExtractsNothingAtOrAfterTheEndOfTheString)
 }
 END_TEST
 
+static String MakeDigitString(Int repeatCount)
+{
+	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	Int i;
+
+	INIT_INLINE_STRINGBUILDER(stringBuilder);
+	for (i = 0; i < repeatCount; i++)
+		StringBuilder_AppendC(stringBuilder, "0123456789", 0, 10);
+	return StringBuilder_ToString(stringBuilder);
+}
+
+START_TEST(LargeSubstringsAreSlicesOfTheirParent)
+{
+	String parent = MakeDigitString(200);
+	String slice = String_Substring(parent, 105, 500);
+	String copy = String_Create(String_GetBytes(parent) + 105, 500);
+
+	ASSERT(String_IsSlice(slice));
+	ASSERT(!String_IsSlice(parent));
+	ASSERT(String_GetBytes(slice) == String_GetBytes(parent) + 105);
+	ASSERT(String_Length(slice) == 500);
+	ASSERT(String_At(slice, 0) == '5');
+
+	ASSERT(String_Equals(slice, copy));
+	ASSERT(String_Hash(slice) == String_Hash(copy));
+	ASSERT(String_IndexOf(slice, String_FromC("901"), 0) == 4);
+	ASSERT(String_Length(String_Concat(slice, slice)) == 1000);
+
+	// Asking for a C string gives a nul-terminated copy, and leaves the parent alone.
+	ASSERT(String_ToC(slice)[500] == '\0');
+	ASSERT(String_ToC(slice) != (const char *)String_GetBytes(parent) + 105);
+	ASSERT_STRING(slice, (const char *)String_GetBytes(copy), 500);
+	ASSERT(String_GetBytes(parent)[605] == '5');
+}
+END_TEST
+
+START_TEST(SlicesOfSlicesReferToTheOriginalText)
+{
+	String parent = MakeDigitString(200);
+	String outer = String_SubstringAt(parent, 100);
+	String inner = String_Substring(outer, 50, 100);
+
+	ASSERT(String_IsSlice(inner));
+	ASSERT(((struct StringSliceStruct *)inner)->_opaque.parent == parent);
+	ASSERT(String_GetBytes(inner) == String_GetBytes(parent) + 150);
+
+	// A slice that runs to the end of its parent can use the parent's nul terminator.
+	ASSERT(String_ToC(outer) == (const char *)String_GetBytes(parent) + 100);
+	ASSERT_STRING(outer, (const char *)String_GetBytes(parent) + 100, 1900);
+}
+END_TEST
+
+START_TEST(SmallSubstringsAndSubstringsOfSmallStringsAreCopied)
+{
+	String large = MakeDigitString(200);
+	String small = MakeDigitString(20);
+
+	ASSERT(!String_IsSlice(String_Substring(large, 10, 20)));
+	ASSERT(!String_IsSlice(String_Substring(small, 10, 150)));
+	ASSERT_STRING(String_Substring(large, 10, 20), "01234567890123456789", 20);
+}
+END_TEST
+
+START_TEST(CompactCopiesSlicesButNotFlatStrings)
+{
+	String parent = MakeDigitString(200);
+	String slice = String_Substring(parent, 3, 100);
+	String compacted = String_Compact(slice);
+
+	ASSERT(String_Compact(parent) == parent);
+	ASSERT(!String_IsSlice(compacted));
+	ASSERT(String_GetBytes(compacted) != String_GetBytes(slice));
+	ASSERT(String_Equals(compacted, slice));
+	ASSERT(String_GetBytes(compacted)[100] == '\0');
+}
+END_TEST
+
 START_TEST(AtExtractsIndividualCharacters)
 {
 	String str = String_FromC("This is a test.");
@@ -1010,6 +1089,114 @@ START_TEST(LastIndexOfFindsTheEmptyStringEverywhere)
 }
 END_TEST
 
+static UInt32 _searchLcgState;
+
+static Int NaiveIndexOf(const Byte *text, Int n, const Byte *pattern, Int m, Int start)
+{
+	Int i;
+	for (i = start; i + m <= n; i++) {
+		if (!MemCmp(text + i, pattern, m))
+			return i;
+	}
+	return -1;
+}
+
+static Int NaiveLastIndexOf(const Byte *text, Int n, const Byte *pattern, Int m, Int start)
+{
+	Int i;
+	for (i = (start < n - m ? start : n - m); i >= 0; i--) {
+		if (!MemCmp(text + i, pattern, m))
+			return i;
+	}
+	return -1;
+}
+
+static void FillFromAlphabet(Byte *buffer, Int length, const char *alphabet, Int alphabetLength)
+{
+	Int i;
+	for (i = 0; i < length; i++) {
+		_searchLcgState = _searchLcgState * 1103515245 + 12345;
+		buffer[i] = (Byte)alphabet[(_searchLcgState >> 16) % alphabetLength];
+	}
+}
+
+static Bool SearchesMatchNaiveSearch(const char *alphabet, Int alphabetLength)
+{
+	Byte text[700], pattern[40];
+	Int n, m, start, trial;
+
+	for (trial = 0; trial < 200; trial++) {
+		n = 50 + trial * 3;
+		m = 1 + trial % 40;
+		FillFromAlphabet(text, n, alphabet, alphabetLength);
+		FillFromAlphabet(pattern, m, alphabet, alphabetLength);
+
+		// Plant a copy of the pattern in the text, most of the time.
+		if (trial % 4 != 0)
+			MemCpy(text + (trial * 7) % (n - m), pattern, m);
+
+		for (start = 0; start <= n; start += 1 + start / 8) {
+			if (ByteSearch_IndexOf(text, n, pattern, m, start) != NaiveIndexOf(text, n, pattern, m, start))
+				return False;
+			if (ByteSearch_LastIndexOf(text, n, pattern, m, start) != NaiveLastIndexOf(text, n, pattern, m, start))
+				return False;
+		}
+	}
+	return True;
+}
+
+START_TEST(SubstringSearchesMatchANaiveSearch)
+{
+	Int originalIsa = Vector_GetIsa();
+
+	_searchLcgState = 12345;
+
+	Vector_SetIsa(VECTOR_ISA_PORTABLE);
+	ASSERT(SearchesMatchNaiveSearch("ab", 2));
+	ASSERT(SearchesMatchNaiveSearch("abc", 3));
+	ASSERT(SearchesMatchNaiveSearch("abcdefghijklmnopqrstuvwxyz", 26));
+
+	if (Vector_SetIsa(VECTOR_ISA_AVX2)) {
+		ASSERT(SearchesMatchNaiveSearch("ab", 2));
+		ASSERT(SearchesMatchNaiveSearch("abc", 3));
+		ASSERT(SearchesMatchNaiveSearch("abcdefghijklmnopqrstuvwxyz", 26));
+	}
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+START_TEST(SubstringSearchesHandlePathologicalPatterns)
+{
+	// These would take quadratic time in a naive search; the filter has to give up and
+	// let the two-way search finish the job.
+	String text = String_CreateRepeat('a', 100000);
+	String ending = String_Concat(String_CreateRepeat('a', 999), String_FromC("b"));
+	String found = String_Concat(text, ending);
+	String pairs = String_Repeat(String_FromC("ab"), 50000);
+
+	ASSERT(String_IndexOf(text, ending, 0) == -1);
+	ASSERT(String_LastIndexOf(text, String_Concat(String_FromC("b"), String_CreateRepeat('a', 999)), 100000) == -1);
+	ASSERT(String_IndexOf(found, ending, 0) == 100000);
+	ASSERT(String_LastIndexOf(found, String_CreateRepeat('a', 1000), String_Length(found)) == 99999);
+	ASSERT(String_IndexOf(found, String_CreateRepeat('a', 1000), 50000) == 50000);
+
+	ASSERT(String_IndexOf(pairs, String_Concat(String_Repeat(String_FromC("ab"), 500), String_FromC("c")), 0) == -1);
+	ASSERT(String_IndexOf(pairs, String_Repeat(String_FromC("ab"), 500), 1001) == 1002);
+	ASSERT(String_LastIndexOf(pairs, String_Repeat(String_FromC("ba"), 500), 100000) == 100000 - 1001);
+}
+END_TEST
+
+START_TEST(ReplaceAndSplitUsePreparedSearches)
+{
+	String str = String_FromC("abababab-abab-ab");
+
+	ASSERT_STRING(String_Replace(str, String_FromC("abab"), String_FromC("X")), "XX-X-ab", 7);
+	ASSERT(String_CountOf(str, String_FromC("abab"), 0) == 3);
+	ASSERT(String_CountOf(str, String_FromC("ab"), 0) == 7);
+}
+END_TEST
+
 START_TEST(ContainsFindsContentWhenItExists)
 {
 	String str1 = String_FromC("This is a test of the emergency broadcasting system.");
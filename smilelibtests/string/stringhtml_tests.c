@@ -42,6 +42,22 @@ START_TEST(HtmlEncodeShouldOnlyChangeTheFourDangerousCharacters)
 }
 END_TEST
 
+START_TEST(HtmlEncodeShouldReturnSafeStringsUnchanged)
+{
+	String str = String_FromC("This is a long test that contains nothing dangerous at all.");
+	ASSERT(String_HtmlEncode(str) == str);
+	ASSERT(String_HtmlDecode(str) == str);
+}
+END_TEST
+
+START_TEST(HtmlEncodeShouldEncodeDangerousCharactersAnywhereInLongStrings)
+{
+	String str = String_FromC("This is a long test, with <tags> & \"quotes\" past the first few blocks.");
+	const char *expectedResult = "This is a long test, with &lt;tags&gt; &amp; &quot;quotes&quot; past the first few blocks.";
+	ASSERT_STRING(String_HtmlEncode(str), expectedResult, StrLen(expectedResult));
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  HTML-Encoding-to-ASCII Tests.
 
@@ -65,6 +81,14 @@ START_TEST(HtmlEncodeToAsciiShouldEncodeAllNonAsciiCharacters)
 }
 END_TEST
 
+START_TEST(HtmlEncodeToAsciiShouldEncodeNonAsciiCharactersAnywhereInLongStrings)
+{
+	String str = String_FromC("This is a long test, with \xC2\xA0nonbreaking spaces and \xE2\x82\xAC signs past the first block.");
+	const char *expectedResult = "This is a long test, with &nbsp;nonbreaking spaces and &euro; signs past the first block.";
+	ASSERT_STRING(String_HtmlEncodeToAscii(str), expectedResult, StrLen(expectedResult));
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  HTML-Decoding Tests.
 
@@ -98,6 +122,15 @@ START_TEST(HtmlDecodeShouldDecodeNamedNonLatin1EntitiesToUtf8)
 }
 END_TEST
 
+START_TEST(HtmlDecodeShouldDecodeEntitiesWhoseNamesOverlapOtherEntities)
+{
+	String str = String_FromC("&sup;&sup1;&sup2;&sup3;&sube;&supe;&sigma;&sigmaf;&ordf;&ordm;&theta;&thetasym;&pi;&piv;&not;&notin;");
+	const char *expectedResult = "\xE2\x8A\x83\xC2\xB9\xC2\xB2\xC2\xB3\xE2\x8A\x86\xE2\x8A\x87\xCF\x83\xCF\x82"
+		"\xC2\xAA\xC2\xBA\xCE\xB8\xCF\x91\xCF\x80\xCF\x96\xC2\xAC\xE2\x88\x89";
+	ASSERT_STRING(String_HtmlDecode(str), expectedResult, 36);
+}
+END_TEST
+
 START_TEST(HtmlDecodeShouldDecodeNumericLatin1EntitiesToUtf8)
 {
 	ASSERT_STRING(String_HtmlDecode(String_FromC("&#160;This &#193;is &#189; a &#225;test.&#255;&#222;")), "\xC2\xA0This \xC3\x81is \xC2\xBD a \xC3\xA1test.\xC3\xBF\xC3\x9E", 28);
@@ -182,6 +215,25 @@ START_TEST(UrlEncodeShouldEncodeNonAsciiCharacters)
 }
 END_TEST
 
+START_TEST(UrlEncodeShouldReturnSafeStringsUnchanged)
+{
+	String str = String_FromC("This-is_a.long-test-that-contains-nothing-dangerous-at-all.");
+	ASSERT(String_UrlEncode(str) == str);
+	ASSERT(String_UrlQueryEncode(str) == str);
+	ASSERT(String_UrlDecode(str) == str);
+}
+END_TEST
+
+START_TEST(UrlEncodeShouldEncodeDangerousCharactersAnywhereInLongStrings)
+{
+	String str = String_FromC("ThisIsALongTestWithNoSpacesUntilHere: a/b?c=d&e#f");
+	const char *expectedResult = "ThisIsALongTestWithNoSpacesUntilHere%3A%20a%2Fb%3Fc%3Dd%26e%23f";
+	ASSERT_STRING(String_UrlEncode(str), expectedResult, StrLen(expectedResult));
+	expectedResult = "ThisIsALongTestWithNoSpacesUntilHere:%20a/b%3Fc%3Dd%26e%23f";
+	ASSERT_STRING(String_UrlQueryEncode(str), expectedResult, StrLen(expectedResult));
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  URL-Query-Encoding Tests.
 //
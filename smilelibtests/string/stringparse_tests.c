@@ -17,6 +17,12 @@
 
 #include "../stdafx.h"
 
+#include <smile/numeric/float64.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
 TEST_SUITE(StringParseTests)
 
 //-------------------------------------------------------------------------------------------------
@@ -408,12 +414,8 @@ START_TEST(ShouldParseNegativeExponents)
 }
 END_TEST
 
-// TODO: Mandate all strings parse perfectly to the nearest IEEE 754 value.  This is HARD.
-//       See David M. Gay's dtoa.c library for a possible future enhancement.
-
 // All of these numbers come from articles on http://www.exploringbinary.com .
-// Big shout-out to Rick Regan for discovering all these useful test cases
-// (even if we don't pass them all within 0 ULPs yet).
+// Big shout-out to Rick Regan for discovering all these useful test cases.
 START_TEST(CertainProblematicNumbersParseExactly)
 {
 	Float64 result;
@@ -446,24 +448,138 @@ START_TEST(CertainProblematicNumbersParseExactly)
 END_TEST
 
 // All of these numbers come from articles on http://www.exploringbinary.com .
-// Big shout-out to Rick Regan for discovering all these useful test cases
-// (even if we don't pass them all within 0 ULPs yet).
-START_TEST(VeryProblematicNumbersParseWithinOneOrTwoUlps)
+START_TEST(VeryProblematicNumbersParseExactly)
 {
 	Float64 result;
 	Bool parsed;
 
 	parsed = String_ParseFloat(String_FromC(".00000'00000'00000'00000'14159'26535'89793'23"), 10, &result);
-	ASSERT(parsed == True && BinaryDiff(result, 0x3b9abf0026c70bbdULL) <= 1);
+	ASSERT(parsed == True && BinaryDiff(result, 0x3b9abf0026c70bbdULL) == 0);
 
 	parsed = String_ParseFloat(String_FromC("6.92949'56446'00919'5e15"), 10, &result);
-	ASSERT(parsed == True && BinaryDiff(result, 0x43389e56ee5e7a58ULL) <= 1);
+	ASSERT(parsed == True && BinaryDiff(result, 0x43389e56ee5e7a58ULL) == 0);
 
 	parsed = String_ParseFloat(String_FromC("30'078'505'129'381'147'446'200"), 10, &result);
-	ASSERT(parsed == True && BinaryDiff(result, 0x44997a3c7271b021ULL) <= 1);
+	ASSERT(parsed == True && BinaryDiff(result, 0x44997a3c7271b021ULL) == 0);
 
 	parsed = String_ParseFloat(String_FromC("2.22507'38585'07201'2e-308"), 10, &result);
-	ASSERT(parsed == True && BinaryDiff(result, 0x0010000000000000ULL) <= 2);
+	ASSERT(parsed == True && BinaryDiff(result, 0x0010000000000000ULL) == 0);
+
+	// The infamous value that hung both PHP and Java.
+	parsed = String_ParseFloat(String_FromC("2.2250738585072011e-308"), 10, &result);
+	ASSERT(parsed == True && BinaryDiff(result, 0x000fffffffffffffULL) == 0);
+}
+END_TEST
+
+START_TEST(HalfwayCasesRoundToEvenUnlessAnyLaterDigitIsNonzero)
+{
+	Float64 result;
+
+	// 2^53 + 1 is exactly halfway between 2^53 and 2^53 + 2.
+	ASSERT(String_ParseFloat(String_FromC("9007199254740993"), 10, &result) == True && result == 9007199254740992.0);
+	ASSERT(String_ParseFloat(String_FromC("9007199254740993.00000000000000000000000000000000000000001"), 10, &result) == True
+		&& result == 9007199254740994.0);
+	ASSERT(String_ParseFloat(String_FromC("9007199254740995"), 10, &result) == True && result == 9007199254740996.0);
+
+	// Halfway between 1 and the next float up:  1 + 2^-53, to all 53 of its digits, and then some.
+	ASSERT(String_ParseFloat(String_FromC("1.00000000000000011102230246251565404236316680908203125"), 10, &result) == True
+		&& result == 1.0);
+	ASSERT(String_ParseFloat(String_FromC("1.00000000000000011102230246251565404236316680908203125000000000000000001"), 10, &result) == True
+		&& result == 1.0000000000000002);
+	ASSERT(String_ParseFloat(String_FromC("1.00000000000000011102230246251565404236316680908203124999999999999999999"), 10, &result) == True
+		&& result == 1.0);
+}
+END_TEST
+
+START_TEST(ExtremeDecimalFloatsUnderflowAndOverflowCorrectly)
+{
+	Float64 result;
+
+	ASSERT(String_ParseFloat(String_FromC("4.9406564584124654e-324"), 10, &result) == True && BinaryDiff(result, 1) == 0);
+	ASSERT(String_ParseFloat(String_FromC("2.4703282292062328e-324"), 10, &result) == True && BinaryDiff(result, 1) == 0);
+	ASSERT(String_ParseFloat(String_FromC("2.4703282292062327e-324"), 10, &result) == True && result == 0.0);
+	ASSERT(String_ParseFloat(String_FromC("1e-400"), 10, &result) == True && result == 0.0);
+	ASSERT(String_ParseFloat(String_FromC("1.7976931348623157e308"), 10, &result) == True
+		&& BinaryDiff(result, 0x7fefffffffffffffULL) == 0);
+	ASSERT(String_ParseFloat(String_FromC("1.7976931348623158e308"), 10, &result) == True
+		&& BinaryDiff(result, 0x7fefffffffffffffULL) == 0);
+	ASSERT(String_ParseFloat(String_FromC("1.7976931348623159e308"), 10, &result) == True && result == HUGE_VAL);
+	ASSERT(String_ParseFloat(String_FromC("-1e400"), 10, &result) == True && result == -HUGE_VAL);
+	ASSERT(String_ParseFloat(String_FromC("0.000000000000000000000000000000000000000000000000001e400"), 10, &result) == True
+		&& result == 1e349 / 1e100);
+	ASSERT(String_ParseFloat(String_FromC("0e999999999999"), 10, &result) == True && result == 0.0);
+}
+END_TEST
+
+static UInt64 _lcgState;
+
+static UInt64 NextRandom(void)
+{
+	_lcgState = _lcgState * 6364136223846793005ULL + 1442695040888963407ULL;
+	return _lcgState ^ (_lcgState >> 29);
+}
+
+START_TEST(RandomDecimalFloatsParseTheSameAsStrtod)
+{
+	char buffer[64];
+	Float64 value, result;
+	Float64Mash mash;
+	Int i, digits;
+
+	_lcgState = 13579;
+	for (i = 0; i < 100000; i++) {
+		mash.i = (Int64)(NextRandom() & 0x7FFFFFFFFFFFFFFFULL);
+		value = mash.r;
+		if (Float64_GetKind(value) != FLOAT_KIND_POS_NUM) continue;
+
+		// Try every precision, so that we get shortest forms, and not-quite-shortest forms,
+		// and forms with far more digits than necessary.
+		digits = 1 + (Int)(NextRandom() % 25);
+		sprintf(buffer, "%.*e", (int)digits, value);
+		ASSERT(String_ParseFloat(String_FromC(buffer), 10, &result) == True);
+		ASSERT(result == strtod(buffer, NULL));
+	}
+}
+END_TEST
+
+START_TEST(ShortestFloatStringsRoundTripThroughParseFloat)
+{
+	Float64 result;
+	Float64Mash mash;
+	Int i;
+
+	_lcgState = 97531;
+	for (i = 0; i < 100000; i++) {
+		mash.i = (Int64)NextRandom();
+		if (Float64_GetKind(mash.r) != FLOAT_KIND_POS_NUM && Float64_GetKind(mash.r) != FLOAT_KIND_NEG_NUM) continue;
+
+		ASSERT(String_ParseFloat(Float64_ToStringEx(mash.r, 0, 0, False), 10, &result) == True);
+		ASSERT(result == mash.r);
+	}
+}
+END_TEST
+
+START_TEST(CanParseAMillionDecimalFloatsQuickly)
+{
+	String *strings;
+	Float64 result, sum = 0.0, expectedSum = 0.0;
+	Int i;
+
+	// The fast paths should handle all of these; this ought to take well under a second.
+	strings = GC_MALLOC_STRUCT_ARRAY(String, 1000000);
+	_lcgState = 8675309;
+	for (i = 0; i < 1000000; i++) {
+		Float64 value = (Float64)(NextRandom() % 1000000000000ULL) / 1000000.0;
+		strings[i] = Float64_ToStringEx(value, 0, 0, False);
+		expectedSum += value;
+	}
+
+	for (i = 0; i < 1000000; i++) {
+		ASSERT(String_ParseFloat(strings[i], 10, &result) == True);
+		sum += result;
+	}
+
+	ASSERT(sum == expectedSum);
 }
 END_TEST
 
@@ -16,6 +16,10 @@
 //---------------------------------------------------------------------------------------
 
 #include "../stdafx.h"
+#include <smile/foldsearch.h>
+#include <smile/codepage.h>
+#include <smile/numeric/vector.h>
+#include <smile/utf8.h>
 
 TEST_SUITE(StringUnicodeTests)
 
@@ -315,6 +319,101 @@ START_TEST(LastIndexOfIFindsSubsequentMatches)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  Prepared Case-Insensitive Search Tests
+
+static Int NaiveIndexOfI(const String str, const String pattern, Int start)
+{
+	Bool usedSlowConversion;
+	Int plength = String_Length(pattern);
+
+	for (; start <= String_Length(str) - plength; start++) {
+		if (String_CompareRangeI(pattern, 0, plength, str, start, plength, &usedSlowConversion) == 0)
+			return start;
+	}
+	return -1;
+}
+
+static Int NaiveLastIndexOfI(const String str, const String pattern, Int start)
+{
+	Bool usedSlowConversion;
+	Int plength = String_Length(pattern);
+
+	if (start > String_Length(str) - plength) start = String_Length(str) - plength;
+	for (; start >= 0; start--) {
+		if (String_CompareRangeI(pattern, 0, plength, str, start, plength, &usedSlowConversion) == 0)
+			return start;
+	}
+	return -1;
+}
+
+START_TEST(FoldSearchMatchesTheCaseInsensitiveComparison)
+{
+	// A mix of ASCII, two-byte letters, and characters that fold to more than one character.
+	static const char *pieces[] = { "a", "B", "s", "S", "k", "\xC3\x9F", "\xC3\xA9", "\xC3\x89", "\xE2\x84\xAA", "ss", "-", "\xEF\xAC\x83", "ffi" };
+	static const char *patterns[] = { "ab", "SS", "ss", "\xC3\x9F", "k", "abs", "\xC3\xA9S", "FFI", "\xC3\x89-", "s-a", "bab-ss" };
+	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	UInt32 lcg = 4321;
+	const char *piece;
+	String str, pattern;
+	FoldSearch search;
+	Int trial, i, start, isa;
+	Int originalIsa = Vector_GetIsa();
+
+	// Run every search with each SIMD filter this CPU supports.
+	for (trial = 0; trial < 120; trial++) {
+		isa = trial < 60 ? VECTOR_ISA_PORTABLE : VECTOR_ISA_AVX2;
+		if (!Vector_SetIsa(isa)) break;
+
+		INIT_INLINE_STRINGBUILDER(stringBuilder);
+		for (i = 0; i < 40 + trial; i++) {
+			lcg = lcg * 1103515245 + 12345;
+			// Most texts are plain ASCII, so that both paths of the search get exercised.
+			piece = pieces[(lcg >> 16) % (trial % 3 == 0 ? 13 : 5)];
+			StringBuilder_AppendC(stringBuilder, piece, 0, StrLen(piece));
+		}
+		str = StringBuilder_ToString(stringBuilder);
+
+		for (i = 0; i < sizeof(patterns) / sizeof(const char *); i++) {
+			pattern = String_FromC(patterns[i]);
+			search = FoldSearch_Create(pattern);
+			for (start = 0; start <= String_Length(str); start += 7) {
+				ASSERT(FoldSearch_Find(search, str, start) == NaiveIndexOfI(str, pattern, start));
+				ASSERT(FoldSearch_FindLast(search, str, start) == NaiveLastIndexOfI(str, pattern, start));
+			}
+		}
+	}
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+START_TEST(FoldSearchCanBeReusedAcrossStrings)
+{
+	FoldSearch search = FoldSearch_Create(String_FromC("ErRoR"));
+
+	ASSERT(FoldSearch_Find(search, String_FromC("no problems here"), 0) == -1);
+	ASSERT(FoldSearch_Find(search, String_FromC("ERROR: disk full"), 0) == 0);
+	ASSERT(FoldSearch_Find(search, String_FromC("caf\xC3\xA9 error"), 0) == 6);
+	ASSERT(FoldSearch_CountOf(search, String_FromC("error Error ERROR errror"), 0) == 3);
+	ASSERT_STRING(FoldSearch_Replace(search, String_FromC("error Error ERROR"), String_FromC("ok"), -1), "ok ok ok", 8);
+	ASSERT_STRING(FoldSearch_Replace(search, String_FromC("error Error ERROR"), String_FromC("ok"), 2), "ok ok ERROR", 11);
+	ASSERT(FoldSearch_MatchesAt(search, String_FromC("An Error"), 3));
+	ASSERT(!FoldSearch_MatchesAt(search, String_FromC("An Error"), 4));
+}
+END_TEST
+
+START_TEST(CountOfIAndReplaceIIgnoreCase)
+{
+	String str = String_FromC("Stra\xC3\x9F" "e, STRASSE, strasse");
+
+	ASSERT(String_CountOfI(str, String_FromC("strasse"), 0) == 3);
+	ASSERT(String_CountOfI(str, String_FromC("STRA\xC3\x9F" "E"), 0) == 3);
+	ASSERT_STRING(String_ReplaceI(str, String_FromC("strasse"), String_FromC("road")), "road, road, road", 16);
+	ASSERT_STRING(String_ReplaceWithLimitI(str, String_FromC("strasse"), String_FromC("road"), 1), "road, STRASSE, strasse", 22);
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  Case-Insensitive Contains Tests
 
@@ -636,6 +735,16 @@ START_TEST(ComposeIgnoresNonAccentedUnicodeCharacters)
 }
 END_TEST
 
+START_TEST(ComposeLeavesLettersWithSingletonEquivalentsAlone)
+{
+	// 'K', Omega, and iota are what the Kelvin sign, the Ohm sign, and the Greek prosgegrammeni
+	// decompose to, but those are never composed back again.
+	ASSERT_STRING(String_Compose(String_FromC("OK")), "OK", 2);
+	ASSERT_STRING(String_Compose(String_FromC("\xCE\xA9 \xCE\xB9")), "\xCE\xA9 \xCE\xB9", 5);
+	ASSERT_STRING(String_Compose(String_FromC("K\xCC\x81")), "\xE1\xB8\xB0", 3);
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  Unicode Combining-Character Normalization Tests
 
@@ -708,6 +817,65 @@ START_TEST(NormalizeSortsManyDiacriticsCorrectly)
 }
 END_TEST
 
+START_TEST(NormalizeSortsDiacriticsAtTheEndOfTheString)
+{
+	ASSERT_STRING(String_Normalize(String_FromC("x\xCC\xA3\xCC\x87")), "x\xCC\xA3\xCC\x87", 5);
+	ASSERT_STRING(String_Normalize(String_FromC("x\xCC\x87\xCC\xA3")), "x\xCC\xA3\xCC\x87", 5);
+}
+END_TEST
+
+START_TEST(NormalizeRangeNormalizesOnlyThatRange)
+{
+	String str = String_FromC("x\xCC\x87\xCC\xA3, y\xCC\x87\xCC\xA3.");
+
+	ASSERT_STRING(String_NormalizeRange(str, 7, 6), "y\xCC\xA3\xCC\x87.", 6);
+	ASSERT_STRING(String_NormalizeRange(str, 5, 2), ", ", 2);
+}
+END_TEST
+
+//-------------------------------------------------------------------------------------------------
+//  Unchanged-Text Tests
+
+START_TEST(ConversionsReturnTheOriginalStringWhenTheyChangeNothing)
+{
+	String lower = String_FromC("pack my box with five doz\xC3\xA9n liquor jugs.");
+	String upper = String_FromC("PACK MY BOX WITH FIVE DOZ\xC3\x89N LIQUOR JUGS.");
+	String normalized = String_FromC("trouve\xCC\x81, x\xCC\xA3\xCC\x87, and tr\xC3\x97uv\xC3\xB0.");
+
+	ASSERT(String_ToLower(lower) == lower);
+	ASSERT(String_CaseFold(lower) == lower);
+	ASSERT(String_ToUpper(upper) == upper);
+	ASSERT(String_ToTitle(upper) == upper);
+	ASSERT(String_Decompose(normalized) == normalized);
+	ASSERT(String_Normalize(normalized) == normalized);
+	ASSERT(String_Compose(upper) == upper);
+
+	ASSERT(String_ToLower(upper) != upper);
+	ASSERT(String_Decompose(lower) != lower);
+	ASSERT(String_Compose(normalized) != normalized);
+}
+END_TEST
+
+START_TEST(ConversionsOnlyConvertTheTextThatNeedsIt)
+{
+	// Long enough that the ASCII runs are found and converted in bulk, with changes near both ends.
+	ASSERT_STRING(String_ToLower(String_FromC("pack my box with five dozen liquor jugs, PACK MY BOX WITH FIVE DOZ\xC3\x89N LIQUOR JUGS.")),
+		"pack my box with five dozen liquor jugs, pack my box with five doz\xC3\xA9n liquor jugs.", 82);
+	ASSERT_STRING(String_ToUpper(String_FromC("PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS, pack my box with five doz\xC3\xA9n liquor jugs.")),
+		"PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS, PACK MY BOX WITH FIVE DOZ\xC3\x89N LIQUOR JUGS.", 82);
+	ASSERT_STRING(String_ToUpper(String_FromC("\xC3\xA9 pack my box with five dozen liquor jugs")),
+		"\xC3\x89 PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS", 42);
+	ASSERT_STRING(String_Compose(String_FromC("Pack my box with five dozen liquor jugs, trouve\xCC\x81.")),
+		"Pack my box with five dozen liquor jugs, trouv\xC3\xA9.", 49);
+	ASSERT_STRING(String_Normalize(String_FromC("Pack my box with five dozen liquor jugs, x\xCC\x87\xCC\xA3 at the end.")),
+		"Pack my box with five dozen liquor jugs, x\xCC\xA3\xCC\x87 at the end.", 58);
+
+	// Ranges that need no conversion are just extracted.
+	ASSERT_STRING(String_ToLowerRange(String_FromC("PACK my box"), 5, 6), "my box", 6);
+	ASSERT_STRING(String_ComposeRange(String_FromC("trouve\xCC\x81."), 0, 5), "trouv", 5);
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  Unicode Character-Extraction Tests.
 
@@ -748,6 +916,215 @@ START_TEST(ExtractUnicodeCharacterInternalCorrectlyRecognizesUtf8Sequences)
 }
 END_TEST
 
+//-------------------------------------------------------------------------------------------------
+//  UTF-8 Validation and Code-Point Indexing Tests.
+
+typedef struct {
+	const char *text;
+	Int length;
+	Int invalidAt;
+} Utf8ValidationCase;
+
+static const Utf8ValidationCase _utf8ValidationCases[] = {
+	{ "", 0, 0 },
+	{ "abc", 3, 3 },
+	{ "\xC3\xA9", 2, 2 },
+	{ "\xE2\x82\xAC", 3, 3 },
+	{ "\xF0\x9F\x98\x80", 4, 4 },
+	{ "\xED\x9F\xBF", 3, 3 },				// U+D7FF, just below the surrogates.
+	{ "\xEE\x80\x80", 3, 3 },				// U+E000, just above the surrogates.
+	{ "\xF4\x8F\xBF\xBF", 4, 4 },			// U+10FFFF.
+	{ "\x80", 1, 0 },						// Stray continuation byte.
+	{ "a\xBF", 2, 1 },
+	{ "\xC3\xA9\xA9", 3, 2 },				// One continuation byte too many.
+	{ "\xC0\xAF", 2, 0 },					// Overlong ASCII.
+	{ "\xC1\xBF", 2, 0 },
+	{ "\xC3", 1, 0 },						// Truncated sequences.
+	{ "\xE2\x82", 2, 0 },
+	{ "\xF0\x9F\x98", 3, 0 },
+	{ "\xC3(", 2, 0 },
+	{ "\xE2(\xAC", 3, 0 },
+	{ "\xF0\x9F(\x80", 4, 0 },
+	{ "\xE0\x80\x80", 3, 0 },				// Overlong three-byte form.
+	{ "\xE0\x9F\xBF", 3, 0 },
+	{ "\xED\xA0\x80", 3, 0 },				// Surrogates.
+	{ "\xED\xBF\xBF", 3, 0 },
+	{ "\xF0\x80\x80\x80", 4, 0 },			// Overlong four-byte form.
+	{ "\xF0\x8F\xBF\xBF", 4, 0 },
+	{ "\xF4\x90\x80\x80", 4, 0 },			// Above U+10FFFF.
+	{ "\xF5\x80\x80\x80", 4, 0 },
+	{ "\xFF", 1, 0 },
+	{ "ab\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xE2\x82", 13, 11 },
+};
+
+static Bool Utf8ValidationCasesPass(void)
+{
+	Byte buffer[256];
+	const Utf8ValidationCase *testCase;
+	Int i, position, length;
+
+	// Each case is tried at every position in a run of ASCII, so that it straddles
+	// every possible boundary between the vector blocks.
+	for (i = 0; i < sizeof(_utf8ValidationCases) / sizeof(Utf8ValidationCase); i++) {
+		testCase = &_utf8ValidationCases[i];
+		for (position = 0; position < 100; position++) {
+			MemSet(buffer, 'x', sizeof(buffer));
+			MemCpy(buffer + position, testCase->text, testCase->length);
+
+			length = position + testCase->length;
+			if (Utf8_FindInvalid(buffer, length, 0) != position + testCase->invalidAt)
+				return False;
+
+			length = sizeof(buffer);
+			if (Utf8_FindInvalid(buffer, length, 0)
+				!= (testCase->invalidAt < testCase->length ? position + testCase->invalidAt : length))
+				return False;
+		}
+	}
+
+	return True;
+}
+
+START_TEST(Utf8ValidationAcceptsValidTextAndFindsMalformedSequences)
+{
+	Int originalIsa = Vector_GetIsa();
+
+	Vector_SetIsa(VECTOR_ISA_PORTABLE);
+	ASSERT(Utf8ValidationCasesPass());
+
+	if (Vector_SetIsa(VECTOR_ISA_AVX2))
+		ASSERT(Utf8ValidationCasesPass());
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+START_TEST(Utf8ValidationIsTheSameForEveryInstructionSet)
+{
+	static const char *pieces[] = {
+		"a", "bcd", " ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF",
+		"\x80", "\xC3", "\xE0\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xFF",
+	};
+	Byte buffer[1024];
+	Int originalIsa = Vector_GetIsa();
+	Int trial, length, pieceLength, portable;
+	UInt32 lcg = 12345;
+	const char *piece;
+
+	if (!Vector_SetIsa(VECTOR_ISA_AVX2))
+		return;
+
+	for (trial = 0; trial < 2000; trial++) {
+		// Most texts are valid, with an occasional malformed piece somewhere in them.
+		for (length = 0; ; length += pieceLength) {
+			lcg = lcg * 1103515245 + 12345;
+			piece = pieces[(lcg >> 16) % ((lcg >> 8) % 97 == 0 ? 13 : 7)];
+			pieceLength = StrLen(piece);
+			if (length + pieceLength > (Int)(trial % 300) + 1)
+				break;
+			MemCpy(buffer + length, piece, pieceLength);
+		}
+
+		Vector_SetIsa(VECTOR_ISA_PORTABLE);
+		portable = Utf8_FindInvalid(buffer, length, 0);
+		Vector_SetIsa(VECTOR_ISA_AVX2);
+		ASSERT(Utf8_FindInvalid(buffer, length, 0) == portable);
+	}
+
+	Vector_SetIsa(originalIsa);
+}
+END_TEST
+
+START_TEST(StringsRememberWhetherTheyAreAsciiOrUtf8)
+{
+	String ascii = String_FromC("This is a test.");
+	String utf8 = String_FromC("Voil\xC3\xA0 un test.");
+	String invalid = String_FromC("Voil\xE0 un test.");
+	String longAscii = String_CreateRepeat('a', 2000);
+
+	ASSERT(!(ascii->kind & SMILE_FLAG_STRING_SCANNED));
+	ASSERT(String_IsAscii(ascii));
+	ASSERT(ascii->kind & SMILE_FLAG_STRING_SCANNED);
+	ASSERT(String_IsValidUtf8(ascii));
+
+	ASSERT(!String_IsAscii(utf8));
+	ASSERT(String_IsValidUtf8(utf8));
+
+	ASSERT(!String_IsAscii(invalid));
+	ASSERT(!String_IsValidUtf8(invalid));
+	ASSERT(!(invalid->kind & SMILE_FLAG_STRING_UTF8));
+
+	ASSERT(String_IsAscii(String_Empty));
+	ASSERT(String_IsValidUtf8(String_Empty));
+
+	// Slices of an ASCII string know that they're ASCII without scanning.
+	ASSERT(String_IsAscii(longAscii));
+	ASSERT(String_SubstringAt(longAscii, 100)->kind & SMILE_FLAG_STRING_ASCII);
+}
+END_TEST
+
+START_TEST(CodePointCountingMatchesDecoding)
+{
+	String str = String_FromC("a\xCC\x80 biento\xCC\x82t. \xC3\xA0 bient\xC3\xB4t. \xF0\x9F\x98\x80\xE2\x82\xAC");
+
+	ASSERT(Utf8_CountCodePoints(String_GetBytes(str), String_Length(str)) == 26);
+	ASSERT(Utf8_SkipCodePoints(String_GetBytes(str), String_Length(str), 0, 1) == 1);
+	ASSERT(Utf8_SkipCodePoints(String_GetBytes(str), String_Length(str), 0, 2) == 3);
+	ASSERT(Utf8_SkipCodePoints(String_GetBytes(str), String_Length(str), 0, 25) == String_Length(str) - 3);
+	ASSERT(Utf8_SkipCodePoints(String_GetBytes(str), String_Length(str), 0, 26) == String_Length(str));
+	ASSERT(Utf8_SkipCodePoints(String_GetBytes(str), String_Length(str), 0, 27) == -1);
+}
+END_TEST
+
+START_TEST(CodePointIndexesFindEveryCodePoint)
+{
+	static const char *pieces[] = { "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "bcdefgh" };
+	DECLARE_INLINE_STRINGBUILDER(stringBuilder, 256);
+	String str;
+	Utf8Index index;
+	Int *offsets;
+	Int i, numCodePoints, offset, length;
+	UInt32 lcg = 54321;
+	const Byte *text;
+
+	INIT_INLINE_STRINGBUILDER(stringBuilder);
+	for (i = 0; i < 5000; i++) {
+		lcg = lcg * 1103515245 + 12345;
+		StringBuilder_AppendC(stringBuilder, pieces[(lcg >> 16) % 5], 0, StrLen(pieces[(lcg >> 16) % 5]));
+	}
+	str = StringBuilder_ToString(stringBuilder);
+	text = String_GetBytes(str);
+	length = String_Length(str);
+
+	// Find every code point the slow way, one character at a time.
+	offsets = GC_MALLOC_RAW_ARRAY(Int, length + 1);
+	for (numCodePoints = 0, offset = 0; offset < length; numCodePoints++) {
+		offsets[numCodePoints] = offset;
+		String_ExtractUnicodeCharacter(str, &offset);
+	}
+	offsets[numCodePoints] = length;
+
+	index = Utf8Index_Create(str);
+	ASSERT(index->numCodePoints == numCodePoints);
+	ASSERT(index->numOffsets == (numCodePoints - 1) / UTF8INDEX_STRIDE + 1);
+	ASSERT(Utf8_CountCodePoints(text, length) == numCodePoints);
+
+	for (i = 0; i <= numCodePoints; i++) {
+		ASSERT(Utf8Index_GetByteOffset(index, i) == offsets[i]);
+	}
+	ASSERT(Utf8Index_GetByteOffset(index, -1) == -1);
+	ASSERT(Utf8Index_GetByteOffset(index, numCodePoints + 1) == -1);
+
+	for (i = 0, offset = 0; offset <= length; offset++) {
+		if (offset == offsets[i + 1]) i++;
+		ASSERT(Utf8Index_GetCodePointIndex(index, offset) == i);
+	}
+	ASSERT(Utf8Index_GetCodePointIndex(index, length + 1) == -1);
+
+	ASSERT(Utf8Index_Get(str) == Utf8Index_Get(str));
+}
+END_TEST
+
 //-------------------------------------------------------------------------------------------------
 //  Unicode Code-Page Conversion Tests
 
@@ -800,4 +1177,104 @@ START_TEST(ConvertingToAnUnknownCodePageResultsInEmptyString)
 }
 END_TEST
 
+START_TEST(ConvertingARangeConvertsOnlyThatRange)
+{
+	String str = String_FromC("<\xE0 bient\xF4t.>");
+	ASSERT_STRING(String_ConvertKnownCodePageToUtf8Range(str, 1, 10, LEGACY_CODE_PAGE_ISO_8859_1), "\xC3\xA0 bient\xC3\xB4t.", 12);
+
+	str = String_FromC("<\xC3\xA0 bient\xC3\xB4t.>");
+	ASSERT_STRING(String_ConvertUtf8ToKnownCodePageRange(str, 1, 12, LEGACY_CODE_PAGE_ISO_8859_1), "\xE0 bient\xF4t.", 10);
+	ASSERT_STRING(String_ConvertUtf8ToKnownCodePageRange(str, 3, 7, LEGACY_CODE_PAGE_ISO_8859_1), " bient?", 7);
+}
+END_TEST
+
+START_TEST(ConvertingMalformedUtf8ToACodePageProducesQuestionMarks)
+{
+	String str = String_Create((const Byte *)"a\xFF\x80" "b\xC3", 5);
+	ASSERT_STRING(String_ConvertUtf8ToKnownCodePage(str, LEGACY_CODE_PAGE_WIN1252), "a??b?", 5);
+}
+END_TEST
+
+START_TEST(EveryKnownCodePageRoundTripsThroughUtf8)
+{
+	static const Int codePageIDs[] = {
+		1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 14, 15, 16, 437, 1250, 1251, 1252, 1253, 1254, 1255, 1256, 1257, 1258,
+	};
+	struct CodePageStruct codePage;
+	Byte bytes[512];
+	String str, utf8, roundTrip;
+	const Byte *roundTripBytes;
+	Int i, j;
+
+	// Every byte value, once on its own, and once next to a run of ASCII.
+	for (i = 0; i < 256; i++) {
+		bytes[i] = (Byte)i;
+		bytes[256 + i] = (i & 1) ? (Byte)(255 - i) : 'x';
+	}
+	str = String_Create(bytes, 512);
+
+	for (j = 0; j < sizeof(codePageIDs) / sizeof(Int); j++) {
+		ASSERT(CodePage_Get(&codePage, codePageIDs[j]));
+
+		utf8 = String_ConvertKnownCodePageToUtf8(str, codePageIDs[j]);
+		ASSERT(String_Length(utf8) == CodePage_MeasureUtf8(&codePage, bytes, 512));
+		ASSERT(Utf8_IsValid(String_GetBytes(utf8), String_Length(utf8)));
+
+		// Bytes that the code page doesn't define decode to U+FFFD, which comes back as '?'.
+		roundTrip = String_ConvertUtf8ToKnownCodePage(utf8, codePageIDs[j]);
+		roundTripBytes = String_GetBytes(roundTrip);
+		ASSERT(String_Length(roundTrip) == 512);
+		for (i = 0; i < 512; i++) {
+			ASSERT(roundTripBytes[i] == bytes[i]
+				|| (roundTripBytes[i] == '?' && codePage.toUnicode[bytes[i]] == 0xFFFD));
+		}
+	}
+}
+END_TEST
+
+START_TEST(ConvertingToACodePageInChunksCarriesSplitCodePointsOver)
+{
+	const char *text = "\xC5\xA0\xC3\xA0 \xE2\x80\x9C\x62ient\xC3\xB4t.\xE2\x80\x9D \xF0\x9F\x98\x80!";
+	const Byte *src = (const Byte *)text;
+	Int length = StrLen(text);
+	struct CodePageStruct codePage;
+	Byte expected[64], dest[64];
+	Int expectedLength, written, consumed, split;
+
+	ASSERT(CodePage_Get(&codePage, LEGACY_CODE_PAGE_WIN1252));
+	expectedLength = CodePage_EncodeFromUtf8(&codePage, src, length, expected, True, NULL);
+	ASSERT(expectedLength == 16);
+	ASSERT(!MemCmp(expected, "\x8A\xE0 \x93\x62ient\xF4t.\x94 ?!", 16));
+
+	// Split the text at every possible point, and convert it in two chunks.
+	for (split = 0; split <= length; split++) {
+		written = CodePage_EncodeFromUtf8(&codePage, src, split, dest, False, &consumed);
+		ASSERT(consumed <= split && consumed >= split - 3);
+		written += CodePage_EncodeFromUtf8(&codePage, src + consumed, length - consumed, dest + written, True, &consumed);
+		ASSERT(written == expectedLength);
+		ASSERT(!MemCmp(dest, expected, expectedLength));
+	}
+}
+END_TEST
+
+START_TEST(CodePagesCanBeFoundByName)
+{
+	struct CodePageStruct codePage;
+
+	ASSERT(CodePage_GetByName(&codePage, String_FromC("ISO-8859-15")) && codePage.id == LEGACY_CODE_PAGE_ISO_8859_15);
+	ASSERT(CodePage_GetByName(&codePage, String_FromC("iso_8859_2")) && codePage.id == LEGACY_CODE_PAGE_ISO_8859_2);
+	ASSERT(CodePage_GetByName(&codePage, String_FromC("Latin-1")) && codePage.id == LEGACY_CODE_PAGE_ISO_8859_1);
+	ASSERT(CodePage_GetByName(&codePage, String_FromC("windows-1252")) && codePage.id == LEGACY_CODE_PAGE_WIN1252);
+	ASSERT(CodePage_GetByName(&codePage, String_FromC("CP1251")) && codePage.id == LEGACY_CODE_PAGE_WIN1251);
+	ASSERT(CodePage_GetByName(&codePage, String_FromC("ibm437")) && codePage.id == LEGACY_CODE_PAGE_CP437);
+
+	ASSERT(!CodePage_GetByName(&codePage, String_FromC("iso-8859-12")));
+	ASSERT(!CodePage_GetByName(&codePage, String_FromC("iso-8859-1252")));
+	ASSERT(!CodePage_GetByName(&codePage, String_FromC("windows-1")));
+	ASSERT(!CodePage_GetByName(&codePage, String_FromC("windows-01252")));
+	ASSERT(!CodePage_GetByName(&codePage, String_FromC("utf-8")));
+	ASSERT(!CodePage_GetByName(&codePage, String_Empty));
+}
+END_TEST
+
 #include "stringunicode_tests.generated.inc"
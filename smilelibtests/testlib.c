@@ -79,7 +79,7 @@ const char *TestStringInternal(String str, const char *expectedString, Int expec
 		return buffer;
 	}
 
-	if (String_GetBytes(str)[expectedLength] != '\0') {
+	if (String_ToC(str)[expectedLength] != '\0') {
 		sprintf(buffer, "%s: actual string is missing '\\0' after end", message);
 		return buffer;
 	}
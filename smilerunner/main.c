@@ -36,6 +36,7 @@ typedef struct CommandLineArgsStruct {
 	Bool printLineInLoop;		// -p
 	Bool outputResult;			// -o
 	Bool warningsAsErrors;		// --warnings-as-errors
+	Bool gcStats;				// --gc-stats
 	SmileList globalDefinitions, globalDefinitionsTail;		// -Dfoo=bar
 	SmileList scriptArgs, scriptArgsTail;					// -- ...args...
 } *CommandLineArgs;
@@ -108,6 +109,7 @@ static void PrintHelp()
 		"  \033[0;1;36m-v --verbose   \033[0;37mDisplay additional version and/or debugging information\n"
 		"  \033[0;1;36m--warnings-as-errors\n"
 		"                 \033[0;37mTreat any warnings found the same as errors, and abort\n"
+		"  \033[0;1;36m--gc-stats     \033[0;37mPrint allocation and garbage-collection statistics on exit\n"
 		"\n"
 		"\033[0;37;1mControl options:\033[0;37m\n"
 		"  \033[0;1;36m--             \033[0;37mTreat subsequent arguments as program name/args\n"
@@ -223,6 +225,7 @@ static CommandLineArgs CommandLineArgs_Create(void)
 	options->printLineInLoop = False;
 	options->outputResult = False;
 	options->warningsAsErrors = False;
+	options->gcStats = False;
 
 	options->globalDefinitions = options->globalDefinitionsTail = NullList;
 	options->scriptArgs = options->scriptArgsTail = NullList;
@@ -247,6 +250,12 @@ static CommandLineArgs ParseCommandLine(int argc, const char **argv)
 			if (argv[i][0] == '-') {
 				if (argv[i][1] == '-') {
 					switch (argv[i][2]) {
+						case 'g':
+							if (!strcmp(argv[i] + 2, "gc-stats")) {
+								options->gcStats = True;
+							}
+							else goto unknownArgument;
+							break;
 						case 'h':
 							if (!strcmp(argv[i] + 2, "help")) {
 								PrintHelp();
@@ -397,6 +406,7 @@ static String LoadFile(String filename)
 {
 	FILE *fp;
 	StringBuilder stringBuilder;
+	String text;
 	Byte *buffer;
 	size_t readLength;
 
@@ -419,7 +429,14 @@ static String LoadFile(String filename)
 
 	fclose(fp);
 
-	return StringBuilder_ToString(stringBuilder);
+	text = StringBuilder_ToString(stringBuilder);
+	if (!String_IsValidUtf8(text)) {
+		Error("smile", 0, "\"%s\" is not valid UTF-8 (at byte %ld).", String_ToC(filename),
+			(long)Utf8_FindInvalid(String_GetBytes(text), String_Length(text), 0));
+		return NULL;
+	}
+
+	return text;
 }
 
 static ClosureInfo SetupGlobalClosureInfo(CommandLineArgs options)
@@ -638,6 +655,8 @@ static int SmileMain(int argc, const char **argv)
 			Verbose("Quiet: true");
 		if (options->warningsAsErrors)
 			Verbose("Warnings as errors: true");
+		if (options->gcStats)
+			Verbose("GC statistics: true");
 		if (options->checkOnly)
 			Verbose("Check only: true");
 		if (options->showRawForm)
@@ -676,6 +695,10 @@ static int SmileMain(int argc, const char **argv)
 		scriptName = options->scriptName;
 	}
 
+	// If they asked for GC statistics, start counting before we parse anything.
+	if (options->gcStats)
+		GcStats_Enable(True);
+
 	// Now parse and evaluate the program!
 	if (options->checkOnly || options->showRawForm) {
 		exitCode = ParseOnly(options, script, scriptName, 1);
@@ -695,6 +718,17 @@ static int SmileMain(int argc, const char **argv)
 		fflush(stdout);
 	}
 
+	// If they asked for GC statistics, report them now.
+	if (options->gcStats) {
+		struct GcStatsStruct stats;
+		String report;
+
+		GcStats_Get(&stats);
+		report = GcStats_ToString(&stats);
+		fwrite(String_GetBytes(report), 1, String_Length(report), stderr);
+		fflush(stderr);
+	}
+
 	// And we're done.
 	Smile_End();
 
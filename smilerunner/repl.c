@@ -405,6 +405,21 @@ static Int ProcessCommand(String input, Int lineNumber, ParseScope globalScope,
 				return ProcessedCommand;
 			}
 
+			// "census", optionally with a filename.
+			if (String_StartsWithC(input, "census")
+				&& (String_Length(input) == 6 || String_At(input, 6) == ' ')) {
+				String filename = String_Trim(String_SubstringAt(input, 6));
+				HeapCensus census = HeapCensus_Take(HEAPCENSUS_DEFAULT_RETAINERS);
+				if (String_IsNullOrEmpty(filename))
+					printf("%s\n", String_ToC(HeapCensus_ToString(census)));
+				else if (HeapCensus_WriteToFile(census, filename))
+					printf("Wrote heap census of %lu objects (%lu bytes) to \"%s\".\n\n",
+						(unsigned long)census->totalCount, (unsigned long)census->totalBytes, String_ToC(filename));
+				else
+					printf("Error: Cannot write to \"%s\".\n\n", String_ToC(filename));
+				return ProcessedCommand;
+			}
+
 			// "cls" and "clear".
 			if (String_StartsWithC(input, "cls")
 				&& (String_Length(input) == 3 || String_At(input, 3) == ' ')) {
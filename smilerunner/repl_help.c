@@ -212,10 +212,10 @@ void ShowHelp(String commandLine)
 			"manipulating, running, testing, and debugging Smile programs.\n"
 			"\n"
 			"\033[1mCommands:\033[0m\n"
-			"\033[1;36m  cd        cls       exit  location  run\033[0m\n"
+			"\033[1;36m  cd        closures  eval  loc       quit\033[0m\n"
+			"\033[1;36m  census    cls       exit  location  run\033[0m\n"
 			"\033[1;36m  clear     continue  go    ls\033[0m\n"
 			"\033[1;36m  closure   dir       help  pwd\033[0m\n"
-			"\033[1;36m  closures  eval      loc   quit\033[0m\n"
 			"\n"
 			"For help on any specific command, type \"\033[1;36mhelp \033[0;36m[command]\033[0m\".\n"
 			"\n"
@@ -235,6 +235,23 @@ void ShowHelp(String commandLine)
 			"\n"
 		);
 	}
+	else if (String_EqualsC(input, "census")) {
+		printf_styled(
+			"\033[0;1;37mUsage: \033[1;33mcensus \033[0;36m[filename]\033[0m\n"
+			"\n"
+			"Take a census of the heap:  Find every object reachable from the\n"
+			"roots (globals, modules, known objects, symbols, and the current\n"
+			"closures), and show how many objects of each kind (or of each\n"
+			"named base object) there are, how many bytes they use, and how\n"
+			"many bytes they keep alive.  The objects that individually keep\n"
+			"the most memory alive are listed last, as \"retainers.\"\n"
+			"\n"
+			"If a filename is given, the census is written to that file\n"
+			"instead.  The format is plain tab-separated text, sorted so that\n"
+			"two censuses taken at different times can be compared with diff.\n"
+			"\n"
+		);
+	}
 	else if (String_EqualsC(input, "clear") || String_EqualsC(input, "cls")) {
 		printf_styled(
 			"\033[0;1;37mUsage: \033[1;33m%s\033[0m\n"
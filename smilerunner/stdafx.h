@@ -29,5 +29,6 @@
 #include <smile/parsing/lexer.h>
 #include <smile/parsing/parser.h>
 #include <smile/eval/eval.h>
+#include <smile/utf8.h>
 
 #endif
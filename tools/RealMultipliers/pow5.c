@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <string.h>
+
+//  Generates the 128-bit powers of five used by the Eisel-Lemire fast path in
+//  smilelib/src/string/string_parsefloat.c, as string_parsefloat_pow5.generated.inc.
+//
+//  Each entry is 5^q, normalized so that its most-significant bit is bit 127 of the
+//  pair (hi, lo).  Positive powers are truncated; negative powers are the reciprocal
+//  2^b / 5^-q, rounded up, so that the fast path's error is always one-sided.
+
+#if defined(_MSC_VER)
+	#include <mpir.h>
+#elif defined(__GNUC__)
+	#include <gmp.h>
+#endif
+
+#define SMALLEST_POWER_OF_FIVE	-342
+#define LARGEST_POWER_OF_FIVE	308
+
+static void PrintEntry(mpz_t value)
+{
+	mpz_t hi, lo;
+
+	mpz_init(hi);
+	mpz_init(lo);
+
+	mpz_tdiv_q_2exp(hi, value, 64);
+	mpz_tdiv_r_2exp(lo, value, 64);
+
+	gmp_printf("\t0x%016ZXULL, 0x%016ZXULL,\n", hi, lo);
+
+	mpz_clear(hi);
+	mpz_clear(lo);
+}
+
+int main(int argc, char **argv)
+{
+	mpz_t power5, value, limit;
+	unsigned long z;
+	int q;
+
+	mpz_init(power5);
+	mpz_init(value);
+	mpz_init(limit);
+	mpz_setbit(limit, 128);
+
+	printf("// This file was automatically generated.  Do not edit!\n\n");
+	printf("#define SMALLEST_POWER_OF_FIVE %d\n", SMALLEST_POWER_OF_FIVE);
+	printf("#define LARGEST_POWER_OF_FIVE %d\n\n", LARGEST_POWER_OF_FIVE);
+	printf("static const UInt64 _powersOfFive128[] = {\n");
+
+	for (q = SMALLEST_POWER_OF_FIVE; q < 0; q++) {
+		mpz_ui_pow_ui(power5, 5, -q);
+		z = mpz_sizeinbase(power5, 2);
+		if (mpz_popcount(power5) == 1) z--;
+
+		mpz_set_ui(value, 0);
+		if (q >= -27) {
+			mpz_setbit(value, z + 127);
+			mpz_fdiv_q(value, value, power5);
+			mpz_add_ui(value, value, 1);
+		}
+		else {
+			mpz_setbit(value, 2 * z + 128);
+			mpz_fdiv_q(value, value, power5);
+			mpz_add_ui(value, value, 1);
+			while (mpz_cmp(value, limit) >= 0)
+				mpz_fdiv_q_2exp(value, value, 1);
+		}
+		PrintEntry(value);
+	}
+
+	for (q = 0; q <= LARGEST_POWER_OF_FIVE; q++) {
+		mpz_ui_pow_ui(value, 5, q);
+		while (mpz_sizeinbase(value, 2) < 128)
+			mpz_mul_2exp(value, value, 1);
+		while (mpz_cmp(value, limit) >= 0)
+			mpz_fdiv_q_2exp(value, value, 1);
+		PrintEntry(value);
+	}
+
+	printf("};\n");
+
+	mpz_clear(power5);
+	mpz_clear(value);
+	mpz_clear(limit);
+
+	return 0;
+}